@@ -58,6 +58,19 @@ class StateAugmentedLagrangianInterface {
   virtual ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the constraint's penalty quadratic approximation to the state-only entries (f, dfdx, dfdxx) of the caller-owned
+   * approximation. The default implementation adds the result of getQuadraticApproximation(); derived classes may override it to
+   * avoid the temporary approximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    const auto penaltyApproximation = getQuadraticApproximation(time, state, multiplier, preComp);
+    approximation.f += penaltyApproximation.f;
+    approximation.dfdx += penaltyApproximation.dfdx;
+    approximation.dfdxx += penaltyApproximation.dfdxx;
+  }
+
   /** Update Lagrange/penalty multipliers and the penalty function value. */
   virtual std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& constraint,
                                                            const Multiplier& multiplier) const = 0;
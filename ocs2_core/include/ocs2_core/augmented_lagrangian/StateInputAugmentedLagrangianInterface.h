@@ -59,6 +59,15 @@ class StateInputAugmentedLagrangianInterface {
                                                                          const Multiplier& lagrangian,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the constraint's penalty quadratic approximation to the caller-owned approximation. The default implementation adds the
+   * result of getQuadraticApproximation(); derived classes may override it to avoid the temporary approximation.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const Multiplier& lagrangian,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    approximation += getQuadraticApproximation(time, state, input, lagrangian, preComp);
+  }
+
   /** Update Lagrange/penalty multipliers and the penalty function value. */
   virtual std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const vector_t& constraint, const Multiplier& lagrangian) const = 0;
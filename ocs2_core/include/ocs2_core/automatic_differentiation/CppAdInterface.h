@@ -165,6 +165,9 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /** Size of the parameter vector p */
+  size_t getParameterDim() const { return parameterDim_; }
+
  private:
   /**
    * Defines library folder names
@@ -58,6 +58,14 @@ class StateConstraintCollection : public Collection<StateConstraint> {
   /** Get an array of all constraints. If a term is inactive, the corresponding element is a vector of size zero. */
   virtual vector_array_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const;
 
+  /**
+   * Writes the values of the active constraints, stacked in the order of the terms, into stackedValue. Unlike getValue(), it does not
+   * allocate an array of terms, e.g. it can write into a segment of a preallocated buffer.
+   * @throws std::runtime_error if the size of stackedValue differs from getNumConstraints(time).
+   */
+  virtual void getStackedValue(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                               Eigen::Ref<vector_t> stackedValue) const;
+
   /** Get the constraint linear approximation */
   virtual VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
                                                                    const PreComputation& preComp) const;
@@ -66,6 +66,15 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const PreComputation& /* preComputation */) const override;
 
+  /** Size of the parameter vector returned by getParameters(). Requires initialize() to be called before. */
+  size_t getNumParameters() const;
+
+  /** Records the CppAD constraint function on the active tape, e.g. to trace it together with other terms of a node. */
+  ad_vector_t traceConstraintFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                                      const ad_vector_t& parameters) const {
+    return constraintFunction(time, state, input, parameters);
+  }
+
  protected:
   StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs);
 
@@ -54,6 +54,25 @@ class ControllerBase {
    */
   virtual vector_t computeInput(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * @brief Computes the control commands of a batch of states at a given time.
+   * The default implementation calls computeInput for each state. Controllers override it to evaluate the time dependent part of the
+   * policy only once for the whole batch.
+   *
+   * @param [in] t: Current time.
+   * @param [in] states: Current states, one state per column.
+   * @param [out] inputs: Current inputs, one input per column.
+   */
+  virtual void computeInputBatch(scalar_t t, const matrix_t& states, matrix_t& inputs) {
+    for (int i = 0; i < states.cols(); i++) {
+      const vector_t input = computeInput(t, states.col(i));
+      if (i == 0) {
+        inputs.resize(input.size(), states.cols());
+      }
+      inputs.col(i) = input;
+    }
+  }
+
   /**
    * @brief Merges this controller with another controller that comes active later in time
    * This method is typically used to merge controllers from multiple time partitions.
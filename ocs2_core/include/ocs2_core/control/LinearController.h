@@ -79,6 +79,8 @@ class LinearController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  void computeInputBatch(scalar_t t, const matrix_t& states, matrix_t& inputs) override;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
@@ -53,6 +53,10 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Add cost term quadratic approximation without constructing a temporary approximation */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation&, ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
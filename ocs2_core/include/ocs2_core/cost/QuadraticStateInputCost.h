@@ -58,6 +58,11 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Add cost term quadratic approximation without constructing a temporary approximation */
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                        ScalarFunctionQuadraticApproximation& approximation) const final;
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
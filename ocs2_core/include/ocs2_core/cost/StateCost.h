@@ -56,6 +56,21 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the state-only entries (f, dfdx, dfdxx) of the caller-owned approximation. The
+   * default implementation adds the result of getQuadraticApproximation(). Terms that only touch a few entries should override this
+   * method to write into the relevant entries directly and avoid the temporary approximation.
+   *
+   * @param [in, out] approximation: The approximation to which the term is added. It must be sized (nx).
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    const auto termApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    approximation.f += termApproximation.f;
+    approximation.dfdx += termApproximation.dfdx;
+    approximation.dfdxx += termApproximation.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
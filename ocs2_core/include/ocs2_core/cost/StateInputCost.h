@@ -56,6 +56,19 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to the caller-owned approximation. The default implementation adds the result of
+   * getQuadraticApproximation(). Terms that only touch a few entries (e.g. diagonal or block-sparse terms) should override this
+   * method to write into the relevant entries directly and avoid the temporary approximation.
+   *
+   * @param [in, out] approximation: The approximation to which the term is added. It must be sized (nx, nu).
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& approximation) const {
+    approximation += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -46,7 +46,7 @@ namespace ocs2 {
  */
 class StateInputCostCollection : public Collection<StateInputCost> {
  public:
-  StateInputCostCollection() = default;
+  StateInputCostCollection() : Collection<StateInputCost>("StateInputCost/") {}
   ~StateInputCostCollection() override = default;
   StateInputCostCollection* clone() const override;
 
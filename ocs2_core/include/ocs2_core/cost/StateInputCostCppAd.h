@@ -69,6 +69,14 @@ class StateInputCostCppAd : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
 
+  /** Size of the parameter vector returned by getParameters(). Requires initialize() to be called before. */
+  size_t getNumParameters() const;
+
+  /** Records the CppAD cost function on the active tape, e.g. to trace it together with other terms of a node. */
+  ad_scalar_t traceCostFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input, const ad_vector_t& parameters) const {
+    return costFunction(time, state, input, parameters);
+  }
+
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
 
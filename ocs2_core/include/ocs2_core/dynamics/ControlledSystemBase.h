@@ -112,6 +112,19 @@ class ControlledSystemBase : public OdeBase {
    */
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the flow map of a batch of states and inputs with the same time.
+   *
+   * @note The default implementation calls computeFlowMap(t, x, u) for each column. Systems can override it with a structure-of-arrays
+   *       implementation. This interface is used by BatchRollout.
+   *
+   * @param [in] t: The current time.
+   * @param [in] states: The current states, one state per column.
+   * @param [in] inputs: The current inputs, one input per column.
+   * @param [out] stateDerivatives: The state time derivatives, one per column.
+   */
+  virtual void computeFlowMapBatch(scalar_t t, const matrix_t& states, const matrix_t& inputs, matrix_t& stateDerivatives);
+
   /**
    * State map at the transition time
    *
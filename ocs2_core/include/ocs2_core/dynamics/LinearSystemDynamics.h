@@ -52,6 +52,8 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
+  void computeFlowMapBatch(scalar_t t, const matrix_t& states, const matrix_t& inputs, matrix_t& stateDerivatives) override;
+
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation&) override;
 
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
@@ -85,6 +85,14 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   /** @note: Requires guard surfaces linear approximation to be called before */
   vector_t guardSurfacesDerivativeTime(scalar_t t, const vector_t& x, const vector_t& u) final;
 
+  /** Records the CppAD flow map on the active tape, e.g. to trace it together with other terms of a node. */
+  ad_vector_t traceFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input, const ad_vector_t& parameters) const {
+    return systemFlowMap(time, state, input, parameters);
+  }
+
+  /** Size of the flow map parameter vector. */
+  size_t getFlowMapParameterDim() const { return getNumFlowMapParameters(); }
+
  protected:
   /** Copy constructor */
   SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs);
@@ -69,8 +69,8 @@ class IntegratorBase {
    * @param [in] finalTime: Final time.
    * @param [in] dt: Time step.
    */
-  void integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
-                      scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max());
+  virtual void integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                              scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max());
 
   /**
    * Adaptive time integration based on start time and final time.
@@ -84,9 +84,9 @@ class IntegratorBase {
    * @param [in] AbsTol: The absolute tolerance error for ode solver.
    * @param [in] RelTol: The relative tolerance error for ode solver.
    */
-  void integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
-                         scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
-                         int maxNumSteps = std::numeric_limits<int>::max());
+  virtual void integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                                 scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                                 int maxNumSteps = std::numeric_limits<int>::max());
 
   /**
    * Output integration based on a given time trajectory.
@@ -100,10 +100,10 @@ class IntegratorBase {
    * @param [in] AbsTol: The absolute tolerance error for ode solver.
    * @param [in] RelTol: The relative tolerance error for ode solver.
    */
-  void integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
-                      typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
-                      scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
-                      int maxNumSteps = std::numeric_limits<int>::max());
+  virtual void integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                              typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                              scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                              int maxNumSteps = std::numeric_limits<int>::max());
 
  protected:
   /** Copy constructor */
@@ -111,6 +111,20 @@ class IntegratorBase {
 
   system_func_t systemFunction(OdeBase& system, int maxNumSteps) const;
 
+  /**
+   * Evaluates the system flow map and checks the maximum number of function calls.
+   *
+   * @param [in] system: System dynamics
+   * @param [in] maxNumSteps: Maximum number of function calls.
+   * @param [in] x: Current state.
+   * @param [out] dxdt: Current state time derivative.
+   * @param [in] t: Current time.
+   */
+  static void computeFlowMap(OdeBase& system, int maxNumSteps, const vector_t& x, vector_t& dxdt, scalar_t t);
+
+  /** Gets the event handler which is called after every observation. */
+  SystemEventHandler& getEventHandler() { return *eventHandlerPtr_; }
+
   virtual void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
                                  scalar_t finalTime, scalar_t dt) = 0;
 
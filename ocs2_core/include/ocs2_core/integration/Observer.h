@@ -58,6 +58,12 @@ class Observer {
    */
   void observe(const vector_t& state, scalar_t time);
 
+  /**
+   * Reserves memory in the containers for a number of upcoming observations.
+   * @param [in] numObservations: Number of observations that will be added.
+   */
+  void reserve(size_t numObservations);
+
  private:
   scalar_array_t* timeTrajectoryPtr_;
   vector_array_t* stateTrajectoryPtr_;
@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/integration/IntegratorBase.h>
+
+namespace ocs2 {
+
+/**
+ * Explicit fixed time-step Runge-Kutta integrator which does not depend on boost::odeint.
+ *
+ * The integrator calls the OdeBase and Observer directly instead of through std::function, it reserves the observed trajectories
+ * based on the known number of steps, and it reuses the stage buffers between steps and calls. The adaptive and times integration
+ * take steps of size dtInitial and shorten the step before the final time or an observation time. The error tolerances AbsTol and
+ * RelTol of the adaptive and times integration are ignored, since the step size is not adapted.
+ *
+ * A continuous extension of the Runge-Kutta scheme provides the dense output within the last step, which StateTriggeredRollout uses
+ * to locate the events.
+ */
+class RungeKuttaFixedStep : public IntegratorBase {
+ public:
+  /** Explicit Runge-Kutta schemes */
+  enum class Scheme { EULER, MIDPOINT, RK4 };
+
+  /**
+   * Constructor
+   * @param [in] scheme: Runge-Kutta scheme.
+   * @param [in] eventHandlerPtr: The integration event handler.
+   */
+  explicit RungeKuttaFixedStep(Scheme scheme, std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr);
+
+  ~RungeKuttaFixedStep() override = default;
+
+  void integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                      scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /** Integrates with steps of size dtInitial, AbsTol and RelTol are ignored. */
+  void integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                         scalar_t dtInitial = 0.01, scalar_t /*AbsTol*/ = 1e-6, scalar_t /*RelTol*/ = 1e-3,
+                         int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /** Integrates with steps of size at most dtInitial between the observation times, AbsTol and RelTol are ignored. */
+  void integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                      typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                      scalar_t dtInitial = 0.01, scalar_t /*AbsTol*/ = 1e-6, scalar_t /*RelTol*/ = 1e-3,
+                      int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /**
+   * Dense output within the last step taken by the integrator.
+   *
+   * @param [in] time: Query time between the start and end time of the last step.
+   * @param [out] state: Interpolated state at the query time.
+   */
+  void getDenseOutput(scalar_t time, vector_t& state) const;
+
+  /** Start and end time of the last step taken by the integrator, i.e., the interval of the dense output. */
+  std::pair<scalar_t, scalar_t> getLastStepInterval() const { return {tPrevious_, t_}; }
+
+ private:
+  void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                         scalar_t finalTime, scalar_t dt) override;
+
+  void runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                            scalar_t finalTime, scalar_t dtInitial, scalar_t /*AbsTol*/, scalar_t /*RelTol*/) override;
+
+  void runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                         typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                         scalar_t dtInitial, scalar_t /*AbsTol*/, scalar_t /*RelTol*/) override;
+
+  template <typename SystemFunc, typename ObserverFunc>
+  void integrateConstImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                          scalar_t dt);
+
+  template <typename SystemFunc, typename ObserverFunc>
+  void integrateAdaptiveImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState, scalar_t startTime,
+                             scalar_t finalTime, scalar_t dt);
+
+  template <typename SystemFunc, typename ObserverFunc>
+  void integrateTimesImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState,
+                          typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                          scalar_t dt);
+
+  /**
+   * Integrates from the current time to finalTime with steps of size dt. The last step is shortened to end at finalTime.
+   * If observeSteps is true, the state at the start of each step is observed.
+   */
+  template <typename SystemFunc, typename ObserverFunc>
+  void integrateInterval(SystemFunc& system, ObserverFunc& observer, scalar_t finalTime, scalar_t dt, bool observeSteps);
+
+  /** Takes one step of size dt from the current state. */
+  template <typename SystemFunc>
+  void step(SystemFunc& system, scalar_t dt);
+
+  /** Number of steps in the interval, see integrateInterval */
+  static size_t getNumSteps(scalar_t startTime, scalar_t finalTime, scalar_t dt);
+
+  /** Butcher tableau with the coefficients of the continuous extension: b_i(theta) = sum_p bDense(i, p) * theta^(p+1) */
+  struct Tableau {
+    matrix_t a;
+    vector_t b;
+    vector_t c;
+    matrix_t bDense;
+  };
+  static Tableau getTableau(Scheme scheme);
+
+  const Tableau tableau_;
+
+  // Current state and time, and the state, time and step size at the start of the last step
+  vector_t x_;
+  scalar_t t_ = 0.0;
+  vector_t xPrevious_;
+  scalar_t tPrevious_ = 0.0;
+  scalar_t dtPrevious_ = 0.0;
+
+  // Stage buffers
+  vector_array_t k_;
+  vector_t xStage_;
+};
+
+}  // namespace ocs2
@@ -76,4 +76,55 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Computes the discretized dynamics with a fixed number of Runge-Kutta 4th order substeps of duration dt / numSubsteps.
+ * Returns x_{k+1}
+ */
+vector_t rk4SubstepDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  size_t numSubsteps);
+
+/**
+ * Creates a linear approximation of the discretized dynamics with a fixed number of Runge-Kutta 4th order substeps of duration
+ * dt / numSubsteps. The sensitivities of the substeps are chained.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation rk4SubstepSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                      const vector_t& u, scalar_t dt, size_t numSubsteps);
+
+/**
+ * Computes the discretized dynamics. Uses Runge-Kutta 4th order substeps where the interval is stiff: the number of substeps is chosen
+ * such that the step size times the estimated spectral radius of dfdx at the start of the interval is at most one, which keeps RK4 well
+ * inside its stability region. Non-stiff intervals take a single step, identical to rk4Discretization.
+ * Returns x_{k+1}
+ */
+vector_t rk4AdaptiveDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses Runge-Kutta 4th order substeps where the interval is stiff, see
+ * rk4AdaptiveDiscretization. The linearization at the start of the interval, which determines the number of substeps, is reused as the
+ * first stage of the first substep.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation rk4AdaptiveSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                       const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses the implicit midpoint rule, x_{k+1} = x_{k} + dt * f(t + dt/2, (x_{k} + x_{k+1})/2, u_{k}),
+ * which is A-stable and suited for stiff dynamics. The implicit equation is solved with Newton's method, starting from an explicit
+ * Euler prediction of the midpoint. Throws std::runtime_error if Newton's method does not converge.
+ * Returns x_{k+1}
+ */
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the implicit midpoint rule, see implicitMidpointDiscretization.
+ * The sensitivities follow from the implicit function theorem and reuse the Jacobian and its factorization of the last Newton iteration.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt);
+
 }  // namespace ocs2
\ No newline at end of file
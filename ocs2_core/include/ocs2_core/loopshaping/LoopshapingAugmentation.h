@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/loopshaping/LoopshapingDefinition.h>
+
+namespace ocs2 {
+namespace loopshaping_augmentation {
+
+/**
+ * Kernels that map the approximations of a system function to the augmented system. The augmented state is [x_system; x_filter].
+ *
+ * In the eliminate pattern the system input is u_system = C * x_filter + D * u, such that the derivatives of the augmented function are
+ * T^T * (...) * T with T = [I, 0, 0; 0, C, D]. The kernels form the nonzero blocks of these products directly from the filter matrices,
+ * without building T or any other dense temporary. Diagonal filters are applied as row and column scalings.
+ */
+
+/**
+ * Computes the Jacobian of a vector function of the augmented system for the eliminate pattern.
+ *
+ * @param [in] loopshapingDefinition : The loopshaping definition.
+ * @param [in] dfdx_system : Jacobian w.r.t. the system state.
+ * @param [in] dfdu_system : Jacobian w.r.t. the system input.
+ * @param [out] dfdx : Jacobian w.r.t. the augmented state.
+ * @param [out] dfdu : Jacobian w.r.t. the augmented input.
+ */
+void eliminatePatternJacobian(const LoopshapingDefinition& loopshapingDefinition, const matrix_t& dfdx_system, const matrix_t& dfdu_system,
+                              matrix_t& dfdx, matrix_t& dfdu);
+
+/**
+ * Computes the Hessians of a scalar function of the augmented system for the eliminate pattern.
+ *
+ * @param [in] loopshapingDefinition : The loopshaping definition.
+ * @param [in] dfdxx_system : Second derivative w.r.t. the system state.
+ * @param [in] dfdux_system : Second derivative w.r.t. the system input and system state.
+ * @param [in] dfduu_system : Second derivative w.r.t. the system input.
+ * @param [out] dfdxx : Second derivative w.r.t. the augmented state.
+ * @param [out] dfdux : Second derivative w.r.t. the augmented input and augmented state.
+ * @param [out] dfduu : Second derivative w.r.t. the augmented input.
+ * @param [in, out] workspace : Buffer for dfduu_system * [C, D]. Only used for non-diagonal filters, pass the same buffer for repeated
+ * calls to avoid reallocation.
+ */
+void eliminatePatternHessian(const LoopshapingDefinition& loopshapingDefinition, const matrix_t& dfdxx_system, const matrix_t& dfdux_system,
+                             const matrix_t& dfduu_system, matrix_t& dfdxx, matrix_t& dfdux, matrix_t& dfduu, matrix_t& workspace);
+
+/**
+ * Computes the quadratic approximation of a scalar function of the augmented system for the eliminate pattern.
+ *
+ * @param [in] loopshapingDefinition : The loopshaping definition.
+ * @param [in] L_system : Quadratic approximation w.r.t. the system state and input.
+ * @param [out] L : Quadratic approximation w.r.t. the augmented state and input. The value L.f is not modified.
+ */
+void eliminatePatternQuadraticApproximation(const LoopshapingDefinition& loopshapingDefinition,
+                                            const ScalarFunctionQuadraticApproximation& L_system, ScalarFunctionQuadraticApproximation& L);
+
+/**
+ * Computes the quadratic approximation of a scalar function of the augmented system for the output pattern. The function does not
+ * depend on the filter state, only the filter blocks are set to zero.
+ *
+ * @param [in] L_system : Quadratic approximation w.r.t. the system state and input. The input derivatives are moved from.
+ * @param [in] filterStateDim : Dimension of the filter state.
+ * @param [out] L : Quadratic approximation w.r.t. the augmented state and input. The value L.f is not modified.
+ */
+void outputPatternQuadraticApproximation(ScalarFunctionQuadraticApproximation& L_system, size_t filterStateDim,
+                                         ScalarFunctionQuadraticApproximation& L);
+
+}  // namespace loopshaping_augmentation
+}  // namespace ocs2
@@ -69,7 +69,18 @@ class LoopshapingDefinition {
   scalar_t loopshapingCost(const vector_t& filteredInput) const { return 0.5 * filteredInput.dot(R_ * filteredInput); }
 
   /** Get the quadratic cost matrix for the filtered inputs */
-  matrix_t& costMatrix() { return R_; }
+  const matrix_t& costMatrix() const { return R_; }
+
+  /** Set the quadratic cost matrix for the filtered inputs */
+  void setCostMatrix(matrix_t costMatrix);
+
+  /**
+   * Hessians of the cost on the filtered inputs for the outputpattern, where the filtered input is C * x_filter + D * u.
+   * These are constant and precomputed whenever the cost matrix is set. Empty for the eliminatepattern.
+   */
+  const matrix_t& getCostMatrixCC() const { return CtRC_; }  // C' * R * C
+  const matrix_t& getCostMatrixDC() const { return DtRC_; }  // D' * R * C
+  const matrix_t& getCostMatrixDD() const { return DtRD_; }  // D' * R * D
 
   /** Display details of the LoopshapingDefinition  */
   void print() const;
@@ -148,6 +159,7 @@ class LoopshapingDefinition {
   LoopshapingType loopshapingType_;
   bool diagonal_;
   matrix_t R_;
+  matrix_t CtRC_, DtRC_, DtRD_;
 };
 
 }  // namespace ocs2
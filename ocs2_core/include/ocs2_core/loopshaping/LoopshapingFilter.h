@@ -52,6 +52,9 @@ class Filter {
   const matrix_t& getC() const { return C_; }
   const matrix_t& getD() const { return D_; }
 
+  /// Get the output matrices [C, D], mapping the stacked filter state and input to the filter output
+  const matrix_t& getCD() const { return CD_; }
+
   /// Get the diagonal of the filter matrices
   const diag_matrix_t& getAdiag() const { return a_; }
   const diag_matrix_t& getBdiag() const { return b_; }
@@ -73,6 +76,7 @@ class Filter {
   void checkSize() const;
 
   matrix_t A_, B_, C_, D_;
+  matrix_t CD_;
   diag_matrix_t a_, b_, c_, d_;
   matrix_t diagCC_, diagDC_, diagDD_;
   size_t numStates_ = 0;
@@ -48,6 +48,8 @@ class LoopshapingStateConstraint final : public StateConstraintCollection {
   LoopshapingStateConstraint* clone() const override { return new LoopshapingStateConstraint(*this); }
 
   vector_array_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const override;
+  void getStackedValue(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                       Eigen::Ref<vector_t> stackedValue) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
                                                            const PreComputation& preComp) const override;
 
@@ -42,6 +42,8 @@ class LoopshapingStateInputConstraint : public StateInputConstraintCollection {
   ~LoopshapingStateInputConstraint() override = default;
 
   vector_array_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override;
+  void getStackedValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                       Eigen::Ref<vector_t> stackedValue) const override;
 
  protected:
   LoopshapingStateInputConstraint(const StateInputConstraintCollection& systemConstraint,
@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_map>
 #include <vector>
 
+#include "ocs2_core/misc/Profiler.h"
+
 namespace ocs2 {
 
 /**
@@ -97,14 +99,35 @@ class Collection {
    */
   bool getTermIndex(const std::string& name, size_t& index) const;
 
+  /** Returns the names of the terms, ordered by their index. */
+  std::vector<std::string> getTermNames() const;
+
+  /**
+   * Sets the prefix of the profiling zone names of the terms, the zone of a term is named profilingPrefix + name. Collections which
+   * are used for different purposes, e.g. the cost and the soft constraints of an OptimalControlProblem, need different prefixes,
+   * otherwise terms with the same name are recorded in the same zone.
+   */
+  void setProfilingPrefix(std::string profilingPrefix);
+
  protected:
+  /**
+   * Constructor
+   * @param profilingPrefix: Prefix of the profiling zone names of the terms, the zone of a term is named profilingPrefix + name.
+   */
+  explicit Collection(std::string profilingPrefix) : profilingPrefix_(std::move(profilingPrefix)) {}
+
   /** Copy constructor */
   Collection(const Collection& other);
 
   //! Contains all terms in the order they were added
   std::vector<std::unique_ptr<T>> terms_;
 
+  //! Profiling zone of each term, see profiler::ScopedZone
+  std::vector<profiler::zone_id_t> termZoneIds_;
+
  private:
+  std::string profilingPrefix_;
+
   //! Lookup from cost term name to index in the cost term vector
   std::unordered_map<std::string, size_t> termNameMap_;
 };
@@ -115,6 +138,7 @@ class Collection {
 template <typename T>
 void Collection<T>::clear() {
   terms_.clear();
+  termZoneIds_.clear();
   termNameMap_.clear();
 }
 
@@ -127,6 +151,7 @@ void Collection<T>::add(std::string name, std::unique_ptr<T> term) {
   auto info = termNameMap_.emplace(std::move(name), nextIndex);
   if (info.second) {
     terms_.push_back(std::move(term));
+    termZoneIds_.push_back(profiler::registerZone(profilingPrefix_ + info.first->first));
   } else {
     throw std::runtime_error(std::string("[Collection::add] Term with name \"") + info.first->first + "\" already exists");
   }
@@ -160,6 +185,7 @@ std::unique_ptr<T> Collection<T>::extract(const std::string& name) {
   auto term = (std::move(terms_[termInd]));
   // remove the term
   terms_.erase(terms_.begin() + termInd);
+  termZoneIds_.erase(termZoneIds_.begin() + termInd);
 
   return term;
 }
@@ -180,7 +206,8 @@ Derived& Collection<T>::get(const std::string& name) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 template <typename T>
-Collection<T>::Collection(const Collection& other) : termNameMap_(other.termNameMap_) {
+Collection<T>::Collection(const Collection& other)
+    : termZoneIds_(other.termZoneIds_), profilingPrefix_(other.profilingPrefix_), termNameMap_(other.termNameMap_) {
   // Loop through all terms and clone. The name map can be copied directly because the order stays the same.
   terms_.reserve(other.terms_.size());
   for (const auto& term : other.terms_) {
@@ -203,6 +230,29 @@ bool Collection<T>::getTermIndex(const std::string& name, size_t& index) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+std::vector<std::string> Collection<T>::getTermNames() const {
+  std::vector<std::string> names(termNameMap_.size());
+  for (const auto& nameIndex : termNameMap_) {
+    names[nameIndex.second] = nameIndex.first;
+  }
+  return names;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+void Collection<T>::setProfilingPrefix(std::string profilingPrefix) {
+  profilingPrefix_ = std::move(profilingPrefix);
+  for (const auto& nameIndex : termNameMap_) {
+    termZoneIds_[nameIndex.second] = profiler::registerZone(profilingPrefix_ + nameIndex.first);
+  }
+}
+
 /**
  * Helper function for merging two vectors by moving objects.
  * @param v1 : vector to move objects to
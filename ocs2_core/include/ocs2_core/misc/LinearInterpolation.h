@@ -53,6 +53,61 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * A lookup table for timeSegment() over a fixed time array. The time span of the array is divided in uniform buckets which store the
+ * first index of the bucket, such that a query costs O(1) for time arrays without strong clustering. The result is identical to
+ * timeSegment(), including the handling of duplicate event times.
+ *
+ * @note The time array is referenced, not copied. It should outlive the table and should not be modified after construction.
+ */
+class TimeSegmentTable {
+ public:
+  /** Default constructor, the table is empty and timeSegment() behaves as for an empty time array. */
+  TimeSegmentTable() = default;
+
+  /**
+   * Constructor
+   * @param [in] timeArray: The sorted interpolation time array.
+   * @param [in] numBuckets: The number of buckets. If 0, one bucket per time point is used.
+   */
+  explicit TimeSegmentTable(const std::vector<scalar_t>& timeArray, size_t numBuckets = 0);
+
+  /** Same as LinearInterpolation::timeSegment(enquiryTime, timeArray) */
+  index_alpha_t timeSegment(scalar_t enquiryTime) const;
+
+ private:
+  const std::vector<scalar_t>* timeArrayPtr_ = nullptr;
+  scalar_t startTime_ = 0.0;
+  scalar_t inverseBucketLength_ = 0.0;
+  std::vector<int> bucketStartIndices_;
+};
+
+/**
+ * A cursor for timeSegment() queries which are (mostly) monotone in time, e.g. the steps of an integrator or the nodes of a solver grid.
+ * The search starts from the interval of the previous query, which makes a query O(1) when the enquiry time moves by a few intervals.
+ * Other queries are still correct and fall back to a binary search. The result is identical to timeSegment(), including the handling of duplicate event times.
+ *
+ * @note The time array is referenced, not copied. It should outlive the cursor.
+ */
+class TimeSegmentCursor {
+ public:
+  /** Default constructor, timeSegment() behaves as for an empty time array. */
+  TimeSegmentCursor() = default;
+
+  /**
+   * Constructor
+   * @param [in] timeArray: The sorted interpolation time array.
+   */
+  explicit TimeSegmentCursor(const std::vector<scalar_t>& timeArray) : timeArrayPtr_(&timeArray) {}
+
+  /** Same as LinearInterpolation::timeSegment(enquiryTime, timeArray) */
+  index_alpha_t timeSegment(scalar_t enquiryTime);
+
+ private:
+  const std::vector<scalar_t>* timeArrayPtr_ = nullptr;
+  int index_ = 0;  // The result of lookup::findIndexInTimeArray for the previous query
+};
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
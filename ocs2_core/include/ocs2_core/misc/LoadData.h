@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace loadData {
 
+/**
+ * Gets the parsed content of a file with INFO format (refer to https://www.boost.org/doc/libs/1_65_1/doc/html/property_tree.html).
+ * The parsed files are cached. A file is parsed again only if it is replaced or modified, i.e., if its size or modification time changes.
+ * This function is thread-safe.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @return The parsed file. Throws boost::property_tree::info_parser_error if the file can not be read or parsed.
+ */
+std::shared_ptr<const boost::property_tree::ptree> getPropertyTree(const std::string& filename);
+
+/** Clears the cache of getPropertyTree(), all files are parsed again on their next use. */
+void clearPropertyTreeCache();
+
 /**
  * Print settings option
  *
@@ -102,55 +116,45 @@ inline void loadPtreeValue(const boost::property_tree::ptree& pt, T& value, cons
  */
 template <typename cpp_data_t>
 inline void loadCppDataType(const std::string& filename, const std::string& dataName, cpp_data_t& value) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
-
-  value = pt.get<cpp_data_t>(dataName);
+  value = getPropertyTree(filename)->get<cpp_data_t>(dataName);
 }
 
 /**
- * An auxiliary function which loads an Eigen matrix from a file. The file uses property tree data structure with INFO format (refer to
- * www.goo.gl/fV3yWA).
- *
- * It has the following format:	<br>
- * matrixName	<br>
- * {	<br>
- *   scaling 1e+0				<br>
- *   (0,0) value    ; M(0,0)	<br>
- *   (1,0) value    ; M(1,0)	<br>
- *   (0,1) value    ; M(0,1)	<br>
- *   (1,1) value    ; M(1,1)	<br>
- * } 	<br>
- *
- * If a value for a specific element is not defined it will set by default to zero.
+ * Loads an Eigen matrix from a property tree with the format of loadEigenMatrix(filename, matrixName, matrix). The elements of the
+ * matrix are looked up in the subtree of the matrix, which is searched only once.
  *
- * @param [in] filename: File name which contains the configuration data.
- * @param [in] matrixName: The key name assigned to the matrix in the config file.
+ * @param [in] pt: Fully initialized tree object.
+ * @param [in] matrixName: The key name assigned to the matrix in the tree.
  * @param [out] matrix: The loaded matrix, must have desired size.
+ * @return false if none of the elements is defined, the matrix is then filled with the default value.
  */
 template <typename Derived>
-inline void loadEigenMatrix(const std::string& filename, const std::string& matrixName, Eigen::MatrixBase<Derived>& matrix) {
+inline bool loadEigenMatrix(const boost::property_tree::ptree& pt, const std::string& matrixName, Eigen::MatrixBase<Derived>& matrix) {
   using scalar_t = typename Eigen::MatrixBase<Derived>::Scalar;
 
-  size_t rows = matrix.rows();
-  size_t cols = matrix.cols();
+  const size_t rows = matrix.rows();
+  const size_t cols = matrix.cols();
 
   if (rows == 0 || cols == 0) {
     throw std::runtime_error("[loadEigenMatrix] Loading empty matrix \"" + matrixName + "\" is not allowed.");
   }
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto matrixTreeOptional = pt.get_child_optional(matrixName);
+  if (!matrixTreeOptional) {
+    matrix.setZero();
+    return false;
+  }
+  const auto& matrixTree = *matrixTreeOptional;
 
-  const scalar_t scaling = pt.get<scalar_t>(matrixName + ".scaling", 1.0);
-  const scalar_t defaultValue = pt.get<scalar_t>(matrixName + ".default", 0.0);
+  const scalar_t scaling = matrixTree.get<scalar_t>("scaling", 1.0);
+  const scalar_t defaultValue = matrixTree.get<scalar_t>("default", 0.0);
 
   size_t numFailed = 0;
   for (size_t i = 0; i < rows; i++) {
     for (size_t j = 0; j < cols; j++) {
       scalar_t aij;
       try {
-        aij = pt.get<scalar_t>(matrixName + "." + "(" + std::to_string(i) + "," + std::to_string(j) + ")");
+        aij = matrixTree.get<scalar_t>("(" + std::to_string(i) + "," + std::to_string(j) + ")");
       } catch (const std::exception&) {
         aij = defaultValue;
         numFailed++;
@@ -160,17 +164,52 @@ inline void loadEigenMatrix(const std::string& filename, const std::string& matr
   }
 
   if (numFailed == matrix.size()) {
-    throw std::runtime_error("[loadEigenMatrix] Could not load matrix \"" + matrixName + "\" from file \"" + filename + "\".");
+    return false;
   } else if (numFailed > 0) {
     std::cerr << "WARNING: Loaded at least one default value in matrix: \"" + matrixName + "\"\n";
   }
+  return true;
 }
 
-template <typename T>
-inline void loadStdVector(const std::string& filename, const std::string& topicName, std::vector<T>& loadVector, bool verbose = true) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+/**
+ * An auxiliary function which loads an Eigen matrix from a file. The file uses property tree data structure with INFO format (refer to
+ * www.goo.gl/fV3yWA).
+ *
+ * It has the following format:	<br>
+ * matrixName	<br>
+ * {	<br>
+ *   scaling 1e+0				<br>
+ *   (0,0) value    ; M(0,0)	<br>
+ *   (1,0) value    ; M(1,0)	<br>
+ *   (0,1) value    ; M(0,1)	<br>
+ *   (1,1) value    ; M(1,1)	<br>
+ * } 	<br>
+ *
+ * If a value for a specific element is not defined it will set by default to zero.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] matrixName: The key name assigned to the matrix in the config file.
+ * @param [out] matrix: The loaded matrix, must have desired size.
+ */
+template <typename Derived>
+inline void loadEigenMatrix(const std::string& filename, const std::string& matrixName, Eigen::MatrixBase<Derived>& matrix) {
+  const auto ptPtr = getPropertyTree(filename);
+  if (!loadEigenMatrix(*ptPtr, matrixName, matrix)) {
+    throw std::runtime_error("[loadEigenMatrix] Could not load matrix \"" + matrixName + "\" from file \"" + filename + "\".");
+  }
+}
 
+/**
+ * Loads a std::vector from a property tree with the format of loadStdVector(filename, topicName, loadVector, verbose).
+ *
+ * @param [in] pt: Fully initialized tree object.
+ * @param [in] topicName: The key name assigned to the vector in the tree.
+ * @param [out] loadVector: The loaded vector, unchanged if the tree does not contain any element.
+ * @param [in] verbose: Whether or not to print the loaded vector.
+ */
+template <typename T>
+inline void loadStdVector(const boost::property_tree::ptree& pt, const std::string& topicName, std::vector<T>& loadVector,
+                          bool verbose = true) {
   std::vector<T> backup;
   backup.swap(loadVector);
   loadVector.clear();
@@ -202,5 +241,82 @@ inline void loadStdVector(const std::string& filename, const std::string& topicN
   }
 }
 
+template <typename T>
+inline void loadStdVector(const std::string& filename, const std::string& topicName, std::vector<T>& loadVector, bool verbose = true) {
+  loadStdVector(*getPropertyTree(filename), topicName, loadVector, verbose);
+}
+
+/**
+ * Loads several fields of a configuration file which is parsed at most once. The field names are relative to the optional prefix, e.g.,
+ *
+ *   loadData::ConfigLoader loader(taskFile, "model_settings", verbose);
+ *   loader.load("positionErrorGain", positionErrorGain).load("phaseTransitionStanceTime", phaseTransitionStanceTime);
+ *
+ * has the same effect and printout as loadPtreeValue() on the fields "model_settings.positionErrorGain" and
+ * "model_settings.phaseTransitionStanceTime".
+ */
+class ConfigLoader {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] filename: File name which contains the configuration data.
+   * @param [in] prefix: The prefix of all field names, e.g., the name of the settings block. No prefix if empty.
+   * @param [in] verbose: Whether or not to print the loaded values.
+   * @param [in] printWidth: The aligned printout width.
+   */
+  explicit ConfigLoader(const std::string& filename, std::string prefix = "", bool verbose = false, long printWidth = 80)
+      : filename_(filename),
+        prefix_(std::move(prefix)),
+        verbose_(verbose),
+        printWidth_(printWidth),
+        ptPtr_(loadData::getPropertyTree(filename)) {}
+
+  /** Loads an optional field, the value is unchanged if the field is missing. Same as loadPtreeValue(). */
+  template <typename T>
+  ConfigLoader& load(const std::string& name, T& value) {
+    loadPtreeValue(*ptPtr_, value, getPath(name), verbose_, printWidth_);
+    return *this;
+  }
+
+  /** Loads a required field, throws boost::property_tree::ptree_bad_path if the field is missing. Same as loadCppDataType(). */
+  template <typename T>
+  ConfigLoader& loadRequired(const std::string& name, T& value) {
+    value = ptPtr_->get<T>(getPath(name));
+    if (verbose_) {
+      printValue(std::cerr, value, name.substr(name.find_last_of('.') + 1), true, printWidth_);
+    }
+    return *this;
+  }
+
+  /** Loads an Eigen matrix, throws if none of its elements is defined. Same as loadEigenMatrix(). */
+  template <typename Derived>
+  ConfigLoader& loadMatrix(const std::string& name, Eigen::MatrixBase<Derived>& matrix) {
+    if (!loadEigenMatrix(*ptPtr_, getPath(name), matrix)) {
+      throw std::runtime_error("[ConfigLoader] Could not load matrix \"" + getPath(name) + "\" from file \"" + filename_ + "\".");
+    }
+    return *this;
+  }
+
+  /** Loads a std::vector, the vector is unchanged if it has no elements. Same as loadStdVector(). */
+  template <typename T>
+  ConfigLoader& loadVector(const std::string& name, std::vector<T>& vector) {
+    loadStdVector(*ptPtr_, getPath(name), vector, verbose_);
+    return *this;
+  }
+
+  /** Gets the parsed configuration file. */
+  const boost::property_tree::ptree& getPropertyTree() const { return *ptPtr_; }
+
+ private:
+  std::string getPath(const std::string& name) const { return prefix_.empty() ? name : prefix_ + "." + name; }
+
+  std::string filename_;
+  std::string prefix_;
+  bool verbose_;
+  long printWidth_;
+  std::shared_ptr<const boost::property_tree::ptree> ptPtr_;
+};
+
 }  // namespace loadData
 }  // namespace ocs2
@@ -91,6 +91,43 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ * Same as findIndexInTimeArray, but the search starts from a guess of the index. The array is walked linearly for a few elements from
+ * the guess and bisected beyond that, which makes it O(1) for monotone sequences of queries and O(log n) in the worst case.
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param indexGuess : initial guess of the index, clamped to [0, size(timeArray)]
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int indexGuess) {
+  constexpr int maxNumSteps = 8;
+  const auto size = static_cast<int>(timeArray.size());
+  int index = std::min(std::max(indexGuess, 0), size);
+
+  // Same result as std::lower_bound: the first index with time <= timeArray[index]
+  if (index > 0 && time <= timeArray[index - 1]) {
+    const int walkEnd = std::max(index - maxNumSteps, 0);
+    while (index > walkEnd && time <= timeArray[index - 1]) {
+      --index;
+    }
+    if (index == walkEnd && index > 0 && time <= timeArray[index - 1]) {
+      index = static_cast<int>(std::lower_bound(timeArray.begin(), timeArray.begin() + index, time) - timeArray.begin());
+    }
+  } else {
+    const int walkEnd = std::min(index + maxNumSteps, size);
+    while (index < walkEnd && timeArray[index] < time) {
+      ++index;
+    }
+    if (index == walkEnd && index < size && timeArray[index] < time) {
+      index = static_cast<int>(std::lower_bound(timeArray.begin() + index, timeArray.end(), time) - timeArray.begin());
+    }
+  }
+  return index;
+}
+
 /**
  *  Find interval into a sorted time Array
  *
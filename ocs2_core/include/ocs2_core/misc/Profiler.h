@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+namespace profiler {
+
+/** Identifier of a named profiling zone, see registerZone(). */
+using zone_id_t = uint32_t;
+
+/** Statistics of a zone over all threads. The durations are in milliseconds. */
+struct ZoneStatistics {
+  std::string name;
+  size_t count = 0;
+  scalar_t total = 0.0;
+  scalar_t mean = 0.0;
+  scalar_t median = 0.0;
+  scalar_t percentile90 = 0.0;
+  scalar_t percentile99 = 0.0;
+  scalar_t max = 0.0;
+};
+
+/**
+ * Registers a zone name and returns its identifier. Registering the same name twice returns the same identifier.
+ * This function locks a mutex. Register the zones once, e.g. in a constructor or through OCS2_PROFILE_ZONE, and not in hot loops.
+ */
+zone_id_t registerZone(const std::string& name);
+
+/** Gets the name of a registered zone. */
+std::string getZoneName(zone_id_t zoneId);
+
+/** Enables or disables the recording of zones. The profiler is disabled by default. */
+void setEnabled(bool enabled);
+
+/** Whether the recording of zones is enabled. */
+bool isEnabled();
+
+/**
+ * Sets the capacity of the event buffer of each thread (default 2^16 events, 24 bytes each). Events beyond the capacity are dropped, see
+ * getNumDroppedEvents(). The capacity applies to the buffers allocated after the next clear() and to the threads which record their first
+ * event afterwards.
+ */
+void setEventsPerThread(size_t numEvents);
+
+/** Gets the capacity of the event buffer of each thread. */
+size_t getEventsPerThread();
+
+/**
+ * Clears the recorded events of all threads. A buffer is only allocated by the first event its thread records, and clear() releases the
+ * buffers while the profiler is disabled, such that no memory is held when profiling is off.
+ * @note Should not be called while zones are recorded, e.g. call it between two MPC iterations.
+ */
+void clear();
+
+/** Number of events which were not recorded since the buffer of their thread was full. */
+size_t getNumDroppedEvents();
+
+/** Gets the statistics of the recorded zones, sorted by total time in descending order. */
+std::vector<ZoneStatistics> getStatistics();
+
+/** Gets a printable table of getStatistics(). */
+std::string getSummary();
+
+/**
+ * Writes the recorded events in the Chrome trace event format (JSON), which can be opened in chrome://tracing or ui.perfetto.dev.
+ * Each thread which recorded a zone is shown as its own track.
+ */
+void writeChromeTrace(std::ostream& stream);
+
+/** Writes the Chrome trace to a file, see writeChromeTrace(std::ostream&). */
+void writeChromeTrace(const std::string& filePath);
+
+namespace detail {
+extern std::atomic_bool enabled;
+
+/** Steady clock time in nanoseconds. */
+int64_t now();
+
+/** Appends an event to the buffer of the calling thread. Lock-free, except for the first event of a thread. */
+void record(zone_id_t zoneId, int64_t startTime, int64_t endTime);
+}  // namespace detail
+
+/**
+ * Records the lifetime of the object as an event of a zone. When the profiler is disabled, the cost is a single relaxed atomic load.
+ *
+ * Example:
+ * static const auto zoneId = profiler::registerZone("MySolver::solve");
+ * profiler::ScopedZone zone(zoneId);
+ */
+class ScopedZone {
+ public:
+  explicit ScopedZone(zone_id_t zoneId)
+      : zoneId_(zoneId), startTime_(detail::enabled.load(std::memory_order_relaxed) ? detail::now() : -1) {}
+
+  ~ScopedZone() {
+    if (startTime_ >= 0) {
+      detail::record(zoneId_, startTime_, detail::now());
+    }
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+ private:
+  const zone_id_t zoneId_;
+  const int64_t startTime_;
+};
+
+}  // namespace profiler
+}  // namespace ocs2
+
+#define OCS2_PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define OCS2_PROFILE_CONCATENATE(a, b) OCS2_PROFILE_CONCATENATE_IMPL(a, b)
+
+/** Records the enclosing scope as a zone with a constant name. The zone is registered once, at the first pass. */
+#define OCS2_PROFILE_ZONE(name)                                                                                             \
+  static const ::ocs2::profiler::zone_id_t OCS2_PROFILE_CONCATENATE(ocs2ProfileZoneId_, __LINE__) =                        \
+      ::ocs2::profiler::registerZone(name);                                                                                 \
+  const ::ocs2::profiler::ScopedZone OCS2_PROFILE_CONCATENATE(ocs2ProfileZone_, __LINE__)(                                  \
+      OCS2_PROFILE_CONCATENATE(ocs2ProfileZoneId_, __LINE__))
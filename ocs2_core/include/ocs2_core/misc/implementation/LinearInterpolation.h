@@ -66,13 +66,11 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Computes the interval index and interpolation coefficient from the interval found by lookup::findIntervalInTimeArray.
+ * The time array should have at least two elements.
+ */
+inline index_alpha_t timeSegmentFromInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +102,80 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  return timeSegmentFromInterval(lookup::findIntervalInTimeArray(timeArray, enquiryTime), enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline TimeSegmentTable::TimeSegmentTable(const std::vector<scalar_t>& timeArray, size_t numBuckets) : timeArrayPtr_(&timeArray) {
+  if (timeArray.size() <= 1) {
+    return;
+  }
+
+  if (numBuckets == 0) {
+    numBuckets = timeArray.size();
+  }
+  startTime_ = timeArray.front();
+  const scalar_t timeSpan = timeArray.back() - timeArray.front();
+  inverseBucketLength_ = (timeSpan > 0.0) ? static_cast<scalar_t>(numBuckets) / timeSpan : 0.0;
+
+  // first index with bucketStartTime <= timeArray[index], filled in a single pass
+  bucketStartIndices_.resize(numBuckets);
+  int index = 0;
+  for (size_t b = 0; b < numBuckets; ++b) {
+    const scalar_t bucketStartTime = (b == 0) ? startTime_ : startTime_ + static_cast<scalar_t>(b) * timeSpan / numBuckets;
+    index = lookup::findIndexInTimeArray(timeArray, bucketStartTime, index);
+    bucketStartIndices_[b] = index;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t TimeSegmentTable::timeSegment(scalar_t enquiryTime) const {
+  if (timeArrayPtr_ == nullptr || timeArrayPtr_->size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+  const auto& timeArray = *timeArrayPtr_;
+
+  int index;
+  if (enquiryTime <= startTime_) {
+    index = 0;
+  } else if (enquiryTime > timeArray.back()) {
+    index = static_cast<int>(timeArray.size());
+  } else {
+    const auto lastBucket = static_cast<int>(bucketStartIndices_.size()) - 1;
+    const int bucket = std::min(static_cast<int>((enquiryTime - startTime_) * inverseBucketLength_), lastBucket);
+    // The search corrects for the rounding of the bucket boundaries
+    index = lookup::findIndexInTimeArray(timeArray, enquiryTime, bucketStartIndices_[bucket]);
+  }
+
+  return timeSegmentFromInterval(index - 1, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t TimeSegmentCursor::timeSegment(scalar_t enquiryTime) {
+  if (timeArrayPtr_ == nullptr || timeArrayPtr_->size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+  const auto& timeArray = *timeArrayPtr_;
+
+  index_ = lookup::findIndexInTimeArray(timeArray, enquiryTime, index_);
+  return timeSegmentFromInterval(index_ - 1, enquiryTime, timeArray);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -103,6 +103,30 @@ class MultidimensionalPenalty final {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
                                                                  const vector_t* l = nullptr) const;
 
+  /**
+   * Adds the scaled penalty cost quadratic approximation to the given approximation. Unlike getQuadraticApproximation, this
+   * method does not construct a temporary approximation.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint linear approximation.
+   * @param [in] scale: The scaling factor of the penalty cost.
+   * @param [in, out] approximation: The approximation to which the penalty cost is added. It must have the dimensions of h.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionLinearApproximation& h, scalar_t scale,
+                                        ScalarFunctionQuadraticApproximation& approximation, const vector_t* l = nullptr) const;
+
+  /**
+   * Adds the scaled penalty cost quadratic approximation to the given approximation. Unlike getQuadraticApproximation, this
+   * method does not construct a temporary approximation.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: The constraint quadratic approximation.
+   * @param [in] scale: The scaling factor of the penalty cost.
+   * @param [in, out] approximation: The approximation to which the penalty cost is added. It must have the dimensions of h.
+   */
+  void accumulateQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h, scalar_t scale,
+                                        ScalarFunctionQuadraticApproximation& approximation, const vector_t* l = nullptr) const;
+
   /**
    * Updates the Lagrange multipliers.
    *
@@ -46,8 +46,8 @@ struct TargetTrajectories {
   bool empty() const { return timeTrajectory.empty() || stateTrajectory.empty(); }
   size_t size() const { return timeTrajectory.size(); }
 
-  bool operator==(const TargetTrajectories& other);
-  bool operator!=(const TargetTrajectories& other) { return !(*this == other); }
+  bool operator==(const TargetTrajectories& other) const;
+  bool operator!=(const TargetTrajectories& other) const { return !(*this == other); }
 
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
@@ -58,6 +58,18 @@ struct TargetTrajectories {
 };
 
 void swap(TargetTrajectories& lh, TargetTrajectories& rh);
+
+/**
+ * Samples the target trajectories on a time grid, e.g. the node times of a solver. The result is exact at the sampled times, so it can
+ * replace the original target trajectories when the costs are only evaluated at these times. The lookups then search the short time grid
+ * instead of the full target trajectories, and hit the samples without interpolation error.
+ *
+ * @param [in] targetTrajectories : The target trajectories to sample.
+ * @param [in] timeGrid : The non-decreasing sample times.
+ * @param [out] sampledTargetTrajectories : The sampled target trajectories. Its memory is reused between calls.
+ */
+void sampleTargetTrajectories(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid,
+                              TargetTrajectories& sampledTargetTrajectories);
 std::ostream& operator<<(std::ostream& out, const TargetTrajectories& targetTrajectories);
 
 }  // namespace ocs2
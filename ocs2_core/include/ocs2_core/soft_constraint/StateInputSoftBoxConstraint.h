@@ -93,6 +93,10 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& /* targetTrajectories */, const PreComputation& preComp,
+                                        ScalarFunctionQuadraticApproximation& approximation) const override;
+
  private:
   StateInputSoftBoxConstraint(const StateInputSoftBoxConstraint& other) = default;
 
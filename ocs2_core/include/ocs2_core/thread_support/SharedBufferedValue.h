@@ -0,0 +1,134 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/**
+ * Wraps a value with a thread-safe buffer, like BufferedValue, but the values are held as reference-counted immutable snapshots.
+ * Setting a snapshot and moving the buffer to the active value are pointer swaps, independent of the size of the value.
+ *
+ * The active value can be shared with other readers through getSnapshot(). Modifying the active value through getMutable() is
+ * copy-on-write: the value is copied first if it is shared or if it was provided as an external snapshot.
+ *
+ * As for BufferedValue, the active value is not protected by a mutex, so only one thread should access/modify the active value.
+ * The snapshots returned by getSnapshot() are immutable and can be read from any thread.
+ *
+ * @tparam T : wrapped type
+ */
+template <typename T>
+class SharedBufferedValue {
+ public:
+  /**
+   * Constructor initializes with a given value and an empty buffer.
+   * @param value
+   */
+  explicit SharedBufferedValue(T value) : activeValue_(makeOwned(std::move(value))) {}
+
+  /** Read the currently active value. */
+  const T& get() const { return *activeValue_.ptr; }
+
+  /** Returns a reference-counted snapshot of the currently active value. The snapshot is not affected by getMutable(). */
+  std::shared_ptr<const T> getSnapshot() const { return activeValue_.ptr; }
+
+  /** Read/write the currently active value. Copies the active value if it is shared with any snapshot. */
+  T& getMutable() {
+    if (activeValue_.ownedPtr == nullptr || activeValue_.ptr.use_count() > 1) {
+      activeValue_ = makeOwned(T(*activeValue_.ptr));
+    }
+    return *activeValue_.ownedPtr;
+  }
+
+  /** Copy a new value into the buffer. */
+  void setBuffer(const T& value) { swapBuffer(makeOwned(T(value))); }
+
+  /** Move a new value into the buffer. */
+  void setBuffer(T&& value) { swapBuffer(makeOwned(std::move(value))); }
+
+  /** Set an immutable snapshot to the buffer. No copy is made. */
+  void setBuffer(std::shared_ptr<const T> valuePtr) {
+    if (valuePtr == nullptr) {
+      throw std::runtime_error("[SharedBufferedValue] The snapshot cannot be a nullptr!");
+    }
+    swapBuffer({std::move(valuePtr), nullptr});
+  }
+
+  /**
+   * Replaces the active value with the value in the buffer.
+   * The active value is not mutex protected so this method is NOT thread-safe w.r.t. get()
+   * The buffer is mutex protected, so this method is thread-safe w.r.t. setBuffer()
+   * @return True: the active value was updated, False: the active value was not updated.
+   */
+  bool updateFromBuffer() {
+    Value updatedValue;
+    {
+      std::lock_guard<std::mutex> lock(bufferMutex_);
+      std::swap(updatedValue, buffer_);
+    }
+
+    if (updatedValue.ptr != nullptr) {
+      // The previous active value is released here, outside the lock.
+      std::swap(activeValue_, updatedValue);
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+ private:
+  struct Value {
+    std::shared_ptr<const T> ptr;
+    T* ownedPtr = nullptr;  // Non-const alias of ptr if the value was allocated by this class, nullptr for external snapshots.
+  };
+
+  static Value makeOwned(T&& value) {
+    auto ownedPtr = std::make_shared<T>(std::move(value));
+    T* rawPtr = ownedPtr.get();
+    return {std::move(ownedPtr), rawPtr};
+  }
+
+  void swapBuffer(Value value) {
+    {
+      std::lock_guard<std::mutex> lock(bufferMutex_);
+      std::swap(value, buffer_);
+    }
+    // The replaced buffer is released here, outside the lock.
+  }
+
+  Value activeValue_;
+  std::mutex bufferMutex_;
+  Value buffer_;
+};
+
+}  // namespace ocs2
@@ -100,6 +100,26 @@ ScalarFunctionQuadraticApproximation StateAugmentedLagrangian::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateAugmentedLagrangian::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
+                                                                const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& approximation) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp), multiplier.penalty,
+                                                approximation, &multiplier.lagrangian);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, preComp), multiplier.penalty,
+                                                approximation, &multiplier.lagrangian);
+      break;
+    default:
+      throw std::runtime_error("[StateAugmentedLagrangian] Unknown constraint Order");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -82,6 +82,27 @@ vector_array_t StateConstraintCollection::getValue(scalar_t time, const vector_t
   return constraintValues;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateConstraintCollection::getStackedValue(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                                                Eigen::Ref<vector_t> stackedValue) const {
+  Eigen::Index row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (this->terms_[i]->isActive(time)) {
+      const vector_t termValue = this->terms_[i]->getValue(time, state, preComp);
+      if (row + termValue.size() > stackedValue.size()) {
+        throw std::runtime_error("[StateConstraintCollection::getStackedValue] The active constraints do not fit into stackedValue!");
+      }
+      stackedValue.segment(row, termValue.size()) = termValue;
+      row += termValue.size();
+    }
+  }  // end of i loop
+  if (row != stackedValue.size()) {
+    throw std::runtime_error("[StateConstraintCollection::getStackedValue] The active constraints do not fill stackedValue!");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
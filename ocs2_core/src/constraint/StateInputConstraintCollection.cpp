@@ -78,12 +78,35 @@ vector_array_t StateInputConstraintCollection::getValue(scalar_t time, const vec
   vector_array_t constraintValues(this->terms_.size());
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
+      profiler::ScopedZone zone(this->termZoneIds_[i]);
       constraintValues[i] = this->terms_[i]->getValue(time, state, input, preComp);
     }
   }  // end of i loop
   return constraintValues;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::getStackedValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                                      const PreComputation& preComp, Eigen::Ref<vector_t> stackedValue) const {
+  Eigen::Index row = 0;
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (this->terms_[i]->isActive(time)) {
+      profiler::ScopedZone zone(this->termZoneIds_[i]);
+      const vector_t termValue = this->terms_[i]->getValue(time, state, input, preComp);
+      if (row + termValue.size() > stackedValue.size()) {
+        throw std::runtime_error("[StateInputConstraintCollection::getStackedValue] The active constraints do not fit into stackedValue!");
+      }
+      stackedValue.segment(row, termValue.size()) = termValue;
+      row += termValue.size();
+    }
+  }  // end of i loop
+  if (row != stackedValue.size()) {
+    throw std::runtime_error("[StateInputConstraintCollection::getStackedValue] The active constraints do not fill stackedValue!");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -94,9 +117,10 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
 
   // append linearApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    if (this->terms_[t]->isActive(time)) {
+      profiler::ScopedZone zone(this->termZoneIds_[t]);
+      const auto constraintTermApproximation = this->terms_[t]->getLinearApproximation(time, state, input, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
       linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
@@ -126,9 +150,10 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
 
   // append quadraticApproximation of each constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
+  for (size_t t = 0; t < this->terms_.size(); ++t) {
+    if (this->terms_[t]->isActive(time)) {
+      profiler::ScopedZone zone(this->termZoneIds_[t]);
+      auto constraintTermApproximation = this->terms_[t]->getQuadraticApproximation(time, state, input, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
       quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
@@ -65,6 +65,16 @@ void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, siz
 StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs)
     : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t StateInputConstraintCppAd::getNumParameters() const {
+  if (adInterfacePtr_ == nullptr) {
+    throw std::runtime_error("[StateInputConstraintCppAd] The CppAD interface is not initialized.");
+  }
+  return adInterfacePtr_->getParameterDim();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
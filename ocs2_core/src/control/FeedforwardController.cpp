@@ -90,6 +90,14 @@ vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
   return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::computeInputBatch(scalar_t t, const matrix_t& states, matrix_t& inputs) {
+  const vector_t uff = LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
+  inputs = uff.replicate(1, states.cols());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -86,6 +86,19 @@ vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
   return uff;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInputBatch(scalar_t t, const matrix_t& states, matrix_t& inputs) {
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+
+  const vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
+  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+
+  inputs.noalias() = k * states;
+  inputs.colwise() += uff;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -67,6 +67,19 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                          const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                          ScalarFunctionQuadraticApproximation& approximation) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+
+  approximation.f += 0.5 * xDeviation.dot(Q_ * xDeviation);
+  approximation.dfdx.noalias() += Q_ * xDeviation;
+  approximation.dfdxx += Q_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
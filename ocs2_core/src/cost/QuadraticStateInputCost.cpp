@@ -96,6 +96,29 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                               ScalarFunctionQuadraticApproximation& approximation) const {
+  vector_t stateDeviation, inputDeviation;
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+
+  approximation.f += 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
+  approximation.dfdx.noalias() += Q_ * stateDeviation;
+  approximation.dfdu.noalias() += R_ * inputDeviation;
+  approximation.dfdxx += Q_;
+  approximation.dfduu += R_;
+
+  if (P_.size() > 0) {
+    approximation.f += inputDeviation.dot(P_ * stateDeviation);
+    approximation.dfdx.noalias() += P_.transpose() * inputDeviation;
+    approximation.dfdu.noalias() += P_ * stateDeviation;
+    approximation.dfdux += P_;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
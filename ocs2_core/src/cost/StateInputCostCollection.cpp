@@ -51,9 +51,10 @@ scalar_t StateInputCostCollection::getValue(scalar_t time, const vector_t& state
   scalar_t cost = 0.0;
 
   // accumulate cost terms
-  for (const auto& costTerm : this->terms_) {
-    if (costTerm->isActive(time)) {
-      cost += costTerm->getValue(time, state, input, targetTrajectories, preComp);
+  for (size_t i = 0; i < this->terms_.size(); ++i) {
+    if (this->terms_[i]->isActive(time)) {
+      profiler::ScopedZone zone(this->termZoneIds_[i]);
+      cost += this->terms_[i]->getValue(time, state, input, targetTrajectories, preComp);
     }
   }
 
@@ -67,21 +68,14 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
                                                                                          const vector_t& input,
                                                                                          const TargetTrajectories& targetTrajectories,
                                                                                          const PreComputation& preComp) const {
-  const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
-                                        [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
-
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
-  }
-
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
-    if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  // Accumulate the active terms in place.
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  for (size_t i = 0; i < terms_.size(); ++i) {
+    if (terms_[i]->isActive(time)) {
+      profiler::ScopedZone zone(termZoneIds_[i]);
+      terms_[i]->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
     }
-  });
+  }
 
   return cost;
 }
@@ -59,6 +59,16 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
 StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
     : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t StateInputCostCppAd::getNumParameters() const {
+  if (adInterfacePtr_ == nullptr) {
+    throw std::runtime_error("[StateInputCostCppAd] The CppAD interface is not initialized.");
+  }
+  return adInterfacePtr_->getParameterDim();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
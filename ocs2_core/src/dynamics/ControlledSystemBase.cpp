@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
 
+#include <ocs2_core/misc/Profiler.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -59,10 +61,23 @@ vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x) {
 /******************************************************************************************************/
 vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u) {
   assert(preCompPtr_ != nullptr);
-  preCompPtr_->request(Request::Dynamics, t, x, u);
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request(Dynamics)");
+    preCompPtr_->request(Request::Dynamics, t, x, u);
+  }
   return computeFlowMap(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapBatch(scalar_t t, const matrix_t& states, const matrix_t& inputs, matrix_t& stateDerivatives) {
+  stateDerivatives.resize(states.rows(), states.cols());
+  for (int i = 0; i < states.cols(); i++) {
+    stateDerivatives.col(i) = computeFlowMap(t, states.col(i), inputs.col(i));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
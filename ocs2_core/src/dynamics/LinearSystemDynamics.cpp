@@ -57,6 +57,14 @@ vector_t LinearSystemDynamics::computeFlowMap(scalar_t t, const vector_t& x, con
   return f;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::computeFlowMapBatch(scalar_t /*t*/, const matrix_t& states, const matrix_t& inputs, matrix_t& stateDerivatives) {
+  stateDerivatives.noalias() = A_ * states;
+  stateDerivatives.noalias() += B_ * inputs;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
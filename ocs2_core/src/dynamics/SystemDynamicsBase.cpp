@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 
+#include <ocs2_core/misc/Profiler.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -46,7 +48,10 @@ SystemDynamicsBase::SystemDynamicsBase(const SystemDynamicsBase& other) : Contro
 /******************************************************************************************************/
 VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   assert(preCompPtr_ != nullptr);
-  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request(Dynamics + Approximation)");
+    preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  }
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
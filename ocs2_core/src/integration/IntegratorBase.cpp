@@ -45,16 +45,21 @@ IntegratorBase::IntegratorBase(std::shared_ptr<SystemEventHandler> eventHandlerP
 /******************************************************************************************************/
 /******************************************************************************************************/
 IntegratorBase::system_func_t IntegratorBase::systemFunction(OdeBase& system, int maxNumSteps) const {
-  return [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
-    dxdt = system.computeFlowMap(t, x);
-    // max number of function calls
-    if (system.incrementNumFunctionCalls() > maxNumSteps) {
-      std::stringstream msg;
-      msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
-          << x.transpose() << "]\n";
-      throw std::runtime_error(msg.str());
-    }
-  };
+  return [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) { computeFlowMap(system, maxNumSteps, x, dxdt, t); };
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::computeFlowMap(OdeBase& system, int maxNumSteps, const vector_t& x, vector_t& dxdt, scalar_t t) {
+  dxdt = system.computeFlowMap(t, x);
+  // max number of function calls
+  if (system.incrementNumFunctionCalls() > maxNumSteps) {
+    std::stringstream msg;
+    msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
+        << x.transpose() << "]\n";
+    throw std::runtime_error(msg.str());
+  }
 }
 
 /******************************************************************************************************/
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/integration/Observer.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -50,4 +52,23 @@ void Observer::observe(const vector_t& state, scalar_t time) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Observer::reserve(size_t numObservations) {
+  // grow geometrically, such that repeated calls do not reallocate for every segment
+  auto reserveContainer = [numObservations](auto& container) {
+    const auto requiredCapacity = container.size() + numObservations;
+    if (container.capacity() < requiredCapacity) {
+      container.reserve(std::max(requiredCapacity, 2 * container.capacity()));
+    }
+  };
+  if (stateTrajectoryPtr_ != nullptr) {
+    reserveContainer(*stateTrajectoryPtr_);
+  }
+  if (timeTrajectoryPtr_ != nullptr) {
+    reserveContainer(*timeTrajectoryPtr_);
+  }
+}
+
 }  // namespace ocs2
@@ -0,0 +1,283 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/integration/RungeKuttaFixedStep.h>
+
+#include <cmath>
+#include <iterator>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RungeKuttaFixedStep::RungeKuttaFixedStep(Scheme scheme, std::shared_ptr<SystemEventHandler> eventHandlerPtr)
+    : IntegratorBase(std::move(eventHandlerPtr)), tableau_(getTableau(scheme)), k_(tableau_.c.size()) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto RungeKuttaFixedStep::getTableau(Scheme scheme) -> Tableau {
+  Tableau tableau;
+  switch (scheme) {
+    case Scheme::EULER: {
+      tableau.a = matrix_t::Zero(1, 1);
+      tableau.c = vector_t::Zero(1);
+      tableau.bDense = matrix_t::Ones(1, 1);
+      break;
+    }
+    case Scheme::MIDPOINT: {
+      tableau.a = matrix_t::Zero(2, 2);
+      tableau.a(1, 0) = 0.5;
+      tableau.c = (vector_t(2) << 0.0, 0.5).finished();
+      tableau.bDense = (matrix_t(2, 2) << 1.0, -1.0,  // clang-format off
+                                          0.0,  1.0).finished();  // clang-format on
+      break;
+    }
+    case Scheme::RK4: {
+      tableau.a = matrix_t::Zero(4, 4);
+      tableau.a(1, 0) = 0.5;
+      tableau.a(2, 1) = 0.5;
+      tableau.a(3, 2) = 1.0;
+      tableau.c = (vector_t(4) << 0.0, 0.5, 0.5, 1.0).finished();
+      tableau.bDense = (matrix_t(4, 3) << 1.0, -1.5,  2.0 / 3.0,  // clang-format off
+                                          0.0,  1.0, -2.0 / 3.0,
+                                          0.0,  1.0, -2.0 / 3.0,
+                                          0.0, -0.5,  2.0 / 3.0).finished();  // clang-format on
+      break;
+    }
+    default:
+      throw std::runtime_error("[RungeKuttaFixedStep] Unknown scheme.");
+  }
+  tableau.b = tableau.bDense.rowwise().sum();
+  return tableau;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                         scalar_t finalTime, scalar_t dt, int maxNumSteps) {
+  auto systemFunc = [&](const vector_t& x, vector_t& dxdt, scalar_t t) { computeFlowMap(system, maxNumSteps, x, dxdt, t); };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    getEventHandler().handleEvent(system, t, x);
+  };
+  observer.reserve(static_cast<size_t>(std::max(0.0, std::floor((finalTime - startTime) / dt + 0.1))) + 1);
+  integrateConstImpl(systemFunc, observerFunc, initialState, startTime, finalTime, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                            scalar_t finalTime, scalar_t dtInitial, scalar_t /*AbsTol*/, scalar_t /*RelTol*/,
+                                            int maxNumSteps) {
+  auto systemFunc = [&](const vector_t& x, vector_t& dxdt, scalar_t t) { computeFlowMap(system, maxNumSteps, x, dxdt, t); };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    getEventHandler().handleEvent(system, t, x);
+  };
+  observer.reserve(getNumSteps(startTime, finalTime, dtInitial) + 1);
+  integrateAdaptiveImpl(systemFunc, observerFunc, initialState, startTime, finalTime, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                                         typename scalar_array_t::const_iterator beginTimeItr,
+                                         typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial, scalar_t /*AbsTol*/,
+                                         scalar_t /*RelTol*/, int maxNumSteps) {
+  auto systemFunc = [&](const vector_t& x, vector_t& dxdt, scalar_t t) { computeFlowMap(system, maxNumSteps, x, dxdt, t); };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    getEventHandler().handleEvent(system, t, x);
+  };
+  observer.reserve(std::distance(beginTimeItr, endTimeItr));
+  integrateTimesImpl(systemFunc, observerFunc, initialState, beginTimeItr, endTimeItr, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::getDenseOutput(scalar_t time, vector_t& state) const {
+  if (dtPrevious_ == 0.0) {
+    throw std::runtime_error("[RungeKuttaFixedStep] Dense output is only available after a step has been taken.");
+  }
+
+  const scalar_t theta = (time - tPrevious_) / dtPrevious_;
+  state = xPrevious_;
+  for (int i = 0; i < tableau_.bDense.rows(); ++i) {
+    scalar_t b_i = 0.0;
+    scalar_t thetaPower = theta;
+    for (int p = 0; p < tableau_.bDense.cols(); ++p) {
+      b_i += tableau_.bDense(i, p) * thetaPower;
+      thetaPower *= theta;
+    }
+    state.noalias() += (dtPrevious_ * b_i) * k_[i];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  integrateConstImpl(system, observer, initialState, startTime, finalTime, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                               scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t /*AbsTol*/,
+                                               scalar_t /*RelTol*/) {
+  integrateAdaptiveImpl(system, observer, initialState, startTime, finalTime, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RungeKuttaFixedStep::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            typename scalar_array_t::const_iterator beginTimeItr,
+                                            typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial,
+                                            scalar_t /*AbsTol*/, scalar_t /*RelTol*/) {
+  integrateTimesImpl(system, observer, initialState, beginTimeItr, endTimeItr, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+void RungeKuttaFixedStep::integrateConstImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState, scalar_t startTime,
+                                             scalar_t finalTime, scalar_t dt) {
+  // Same time grid as integrate_const of boost::odeint: N steps such that N * dt <= finalTime - startTime + 0.1 * dt.
+  const auto numSteps = static_cast<size_t>(std::max(0.0, std::floor((finalTime - startTime) / dt + 0.1)));
+
+  x_ = initialState;
+  t_ = startTime;
+  for (size_t i = 0; i < numSteps; ++i) {
+    observer(x_, t_);
+    step(system, dt);
+    t_ = startTime + (i + 1) * dt;
+  }
+  observer(x_, t_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+void RungeKuttaFixedStep::integrateAdaptiveImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState,
+                                                scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  x_ = initialState;
+  t_ = startTime;
+  integrateInterval(system, observer, finalTime, dt, true);
+  observer(x_, t_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+void RungeKuttaFixedStep::integrateTimesImpl(SystemFunc& system, ObserverFunc& observer, const vector_t& initialState,
+                                             typename scalar_array_t::const_iterator beginTimeItr,
+                                             typename scalar_array_t::const_iterator endTimeItr, scalar_t dt) {
+  if (beginTimeItr == endTimeItr) {
+    return;
+  }
+
+  x_ = initialState;
+  t_ = *beginTimeItr;
+  observer(x_, t_);
+  for (auto timeItr = std::next(beginTimeItr); timeItr != endTimeItr; ++timeItr) {
+    integrateInterval(system, observer, *timeItr, dt, false);
+    observer(x_, t_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+void RungeKuttaFixedStep::integrateInterval(SystemFunc& system, ObserverFunc& observer, scalar_t finalTime, scalar_t dt,
+                                            bool observeSteps) {
+  const scalar_t startTime = t_;
+  const scalar_t signedDt = std::copysign(std::abs(dt), finalTime - startTime);
+  const size_t numSteps = getNumSteps(startTime, finalTime, dt);
+  for (size_t i = 0; i < numSteps; ++i) {
+    if (observeSteps) {
+      observer(x_, t_);
+    }
+    const scalar_t nextTime = (i + 1 < numSteps) ? startTime + (i + 1) * signedDt : finalTime;
+    step(system, nextTime - t_);
+    t_ = nextTime;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc>
+void RungeKuttaFixedStep::step(SystemFunc& system, scalar_t dt) {
+  const int numStages = tableau_.c.size();
+  for (int i = 0; i < numStages; ++i) {
+    if (i == 0) {
+      system(x_, k_[0], t_);
+    } else {
+      xStage_ = x_;
+      for (int j = 0; j < i; ++j) {
+        if (tableau_.a(i, j) != 0.0) {
+          xStage_.noalias() += (dt * tableau_.a(i, j)) * k_[j];
+        }
+      }
+      system(xStage_, k_[i], t_ + tableau_.c(i) * dt);
+    }
+  }
+
+  xPrevious_ = x_;
+  tPrevious_ = t_;
+  for (int i = 0; i < numStages; ++i) {
+    x_.noalias() += (dt * tableau_.b(i)) * k_[i];
+  }
+  dtPrevious_ = dt;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t RungeKuttaFixedStep::getNumSteps(scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  // A last step shorter than a small fraction of dt is merged into the previous step.
+  constexpr scalar_t mergeTolerance = 1e-6;
+  const scalar_t numStepsReal = std::abs((finalTime - startTime) / dt);
+  return static_cast<size_t>(std::ceil(numStepsReal - mergeTolerance));
+}
+
+}  // namespace ocs2
@@ -46,6 +46,10 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
       return rk2Discretization;
     case SensitivityIntegratorType::RK4:
       return rk4Discretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointDiscretization;
+    case SensitivityIntegratorType::RK4_ADAPTIVE:
+      return rk4AdaptiveDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -62,6 +66,10 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
       return rk2SensitivityDiscretization;
     case SensitivityIntegratorType::RK4:
       return rk4SensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointSensitivityDiscretization;
+    case SensitivityIntegratorType::RK4_ADAPTIVE:
+      return rk4AdaptiveSensitivityDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -74,7 +82,11 @@ namespace sensitivity_integrator {
 /******************************************************************************************************/
 std::string toString(SensitivityIntegratorType integratorType) {
   static const std::unordered_map<SensitivityIntegratorType, std::string> integratorMap = {
-      {SensitivityIntegratorType::EULER, "EULER"}, {SensitivityIntegratorType::RK2, "RK2"}, {SensitivityIntegratorType::RK4, "RK4"}};
+      {SensitivityIntegratorType::EULER, "EULER"},
+      {SensitivityIntegratorType::RK2, "RK2"},
+      {SensitivityIntegratorType::RK4, "RK4"},
+      {SensitivityIntegratorType::IMPLICIT_MIDPOINT, "IMPLICIT_MIDPOINT"},
+      {SensitivityIntegratorType::RK4_ADAPTIVE, "RK4_ADAPTIVE"}};
 
   return integratorMap.at(integratorType);
 }
@@ -84,7 +96,11 @@ std::string toString(SensitivityIntegratorType integratorType) {
 /******************************************************************************************************/
 SensitivityIntegratorType fromString(const std::string& name) {
   static const std::unordered_map<std::string, SensitivityIntegratorType> integratorMap = {
-      {"EULER", SensitivityIntegratorType::EULER}, {"RK2", SensitivityIntegratorType::RK2}, {"RK4", SensitivityIntegratorType::RK4}};
+      {"EULER", SensitivityIntegratorType::EULER},
+      {"RK2", SensitivityIntegratorType::RK2},
+      {"RK4", SensitivityIntegratorType::RK4},
+      {"IMPLICIT_MIDPOINT", SensitivityIntegratorType::IMPLICIT_MIDPOINT},
+      {"RK4_ADAPTIVE", SensitivityIntegratorType::RK4_ADAPTIVE}};
 
   return integratorMap.at(name);
 }
@@ -29,8 +29,178 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 namespace ocs2 {
 
+namespace {
+
+constexpr scalar_t rk4StepLimit = 1.0;         // |dt * lambda| resolved by RK4, its stability boundary is at 2.79 (real) and 2.83 (imag)
+constexpr size_t maxNumRk4Substeps = 16;       // limits the cost of very stiff intervals
+constexpr size_t maxNumNewtonIterations = 10;  // of the implicit midpoint rule
+constexpr scalar_t newtonTolerance = 1e-10;    // relative to the state
+
+/** Runge-Kutta 4th order step with the given first stage k1 = f(t, x, u) */
+vector_t rk4Step(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, const vector_t& k1) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+  const scalar_t dt_third = dt / 3.0;
+
+  // System evaluations
+  vector_t tmp = x + dt_halve * k1;
+  const vector_t k2 = system.computeFlowMap(t + dt_halve, tmp, u);
+  tmp = x + dt_halve * k2;
+  const vector_t k3 = system.computeFlowMap(t + dt_halve, tmp, u);
+  tmp = x + dt * k3;
+  const vector_t k4 = system.computeFlowMap(t + dt, tmp, u);
+
+  tmp = x + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
+  return tmp;
+}
+
+/** Runge-Kutta 4th order sensitivity step with the given linear approximation of the first stage k1 at (t, x, u) */
+VectorFunctionLinearApproximation rk4SensitivityStep(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                     scalar_t dt, VectorFunctionLinearApproximation k1) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t dt_sixth = dt / 6.0;
+  const scalar_t dt_third = dt / 3.0;
+
+  // System evaluations
+  vector_t tmpV = x + dt_halve * k1.f;
+  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
+  tmpV = x + dt_halve * k2.f;
+  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, tmpV, u);
+  tmpV = x + dt * k3.f;
+  VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, tmpV, u);
+
+  // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
+  // Re-use memory from k.dfdu as dkduk
+  // dk1duk = k1.dfdu
+  k2.dfdu.noalias() += dt_halve * k2.dfdx * k1.dfdu;
+  k3.dfdu.noalias() += dt_halve * k3.dfdx * k2.dfdu;
+  k4.dfdu.noalias() += dt * k4.dfdx * k3.dfdu;
+
+  // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
+  // Re-use memory from k.dfdx as dkdxk
+  // dk1dxk = k1.dfdx;
+  matrix_t tmp = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  k2.dfdx += tmp;
+  tmp.noalias() = dt_halve * k3.dfdx * k2.dfdx;
+  k3.dfdx += tmp;
+  tmp.noalias() = dt * k4.dfdx * k3.dfdx;
+  k4.dfdx += tmp;
+
+  // Assemble discrete approximation
+  // Re-use k1 to collect the result
+  k1.dfdx = dt_sixth * k1.dfdx + dt_third * k2.dfdx + dt_third * k3.dfdx + dt_sixth * k4.dfdx;
+  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  k1.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
+  k1.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
+  return k1;
+}
+
+/** Chains numSubsteps RK4 steps, the first one uses the given first stage k1 = f(t, x, u) */
+vector_t rk4Substeps(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, size_t numSubsteps,
+                     const vector_t& k1) {
+  const scalar_t substep = dt / numSubsteps;
+  vector_t xNext = rk4Step(system, t, x, u, substep, k1);
+  for (size_t i = 1; i < numSubsteps; ++i) {
+    const scalar_t ti = t + i * substep;
+    const vector_t ki = system.computeFlowMap(ti, xNext, u);
+    xNext = rk4Step(system, ti, xNext, u, substep, ki);
+  }
+  return xNext;
+}
+
+/** Chains numSubsteps RK4 sensitivity steps, the first one uses the given linear approximation of the first stage k1 at (t, x, u) */
+VectorFunctionLinearApproximation rk4SensitivitySubsteps(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                         scalar_t dt, size_t numSubsteps, VectorFunctionLinearApproximation k1) {
+  const scalar_t substep = dt / numSubsteps;
+  VectorFunctionLinearApproximation result = rk4SensitivityStep(system, t, x, u, substep, std::move(k1));
+  matrix_t tmp;
+  for (size_t i = 1; i < numSubsteps; ++i) {
+    const scalar_t ti = t + i * substep;
+    auto ki = system.linearApproximation(ti, result.f, u);
+    auto step = rk4SensitivityStep(system, ti, result.f, u, substep, std::move(ki));
+
+    // Chain rule: A = A_{i} * A, B = A_{i} * B + B_{i}
+    tmp.noalias() = step.dfdx * result.dfdx;
+    result.dfdx.swap(tmp);
+    step.dfdu.noalias() += step.dfdx * result.dfdu;
+    result.dfdu.swap(step.dfdu);
+    result.f.swap(step.f);
+  }
+  return result;
+}
+
+/** Number of RK4 substeps such that the substep times the spectral radius of dfdx stays below rk4StepLimit */
+size_t getNumRk4Substeps(const matrix_t& dfdx, scalar_t dt) {
+  if (dfdx.size() == 0) {
+    return 1;
+  }
+
+  // Power iteration, the spectral radius is estimated from the growth over the second half of the iterations.
+  constexpr size_t numIterations = 8;
+  vector_t v = vector_t::Ones(dfdx.cols()).normalized();
+  vector_t w;
+  scalar_t logGrowth = 0.0;
+  for (size_t i = 0; i < numIterations; ++i) {
+    w.noalias() = dfdx * v;
+    const scalar_t norm = w.norm();
+    if (norm <= std::numeric_limits<scalar_t>::min()) {
+      return 1;
+    }
+    if (i >= numIterations / 2) {
+      logGrowth += std::log(norm);
+    }
+    v = w / norm;
+  }
+  const scalar_t spectralRadius = std::exp(logGrowth / (numIterations - numIterations / 2));
+
+  const scalar_t numSubsteps = std::ceil(dt * spectralRadius / rk4StepLimit);
+  return std::max<size_t>(1, std::min<scalar_t>(numSubsteps, maxNumRk4Substeps));
+}
+
+/**
+ * Solves the implicit midpoint rule for the midpoint x_{m} = x + dt/2 * f(t + dt/2, x_{m}, u) with Newton's method.
+ * The linear approximation and the factorization of the Newton system (I - dt/2 * dfdx) of the last iteration are returned.
+ * Throws if Newton's method does not converge in maxNumNewtonIterations iterations.
+ */
+vector_t solveImplicitMidpoint(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                               VectorFunctionLinearApproximation& midpointApproximation, Eigen::PartialPivLU<matrix_t>& newtonSystem) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t midpointTime = t + dt_halve;
+
+  // Explicit Euler prediction of the midpoint
+  vector_t midpoint = system.computeFlowMap(t, x, u);
+  midpoint = x + dt_halve * midpoint;
+
+  matrix_t jacobian;
+  vector_t residual, newtonStep;
+  for (size_t i = 0; i < maxNumNewtonIterations; ++i) {
+    midpointApproximation = system.linearApproximation(midpointTime, midpoint, u);
+    residual = midpoint - x - dt_halve * midpointApproximation.f;
+    jacobian = -dt_halve * midpointApproximation.dfdx;
+    jacobian.diagonal().array() += 1.0;  // plus Identity()
+    newtonSystem.compute(jacobian);
+    newtonStep = newtonSystem.solve(residual);
+    midpoint -= newtonStep;
+    if (newtonStep.lpNorm<Eigen::Infinity>() <= newtonTolerance * (1.0 + midpoint.lpNorm<Eigen::Infinity>())) {
+      return midpoint;
+    }
+  }
+
+  throw std::runtime_error("[implicitMidpointDiscretization] Newton's method did not converge in " +
+                           std::to_string(maxNumNewtonIterations) + " iterations at time " + std::to_string(t) +
+                           ". Reduce the time step or use another integrator.");
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -107,21 +277,8 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
-  const scalar_t dt_halve = dt / 2.0;
-  const scalar_t dt_sixth = dt / 6.0;
-  const scalar_t dt_third = dt / 3.0;
-
-  // System evaluations
   const vector_t k1 = system.computeFlowMap(t, x, u);
-  vector_t tmp = x + dt_halve * k1;
-  const vector_t k2 = system.computeFlowMap(t + dt_halve, tmp, u);
-  tmp = x + dt_halve * k2;
-  const vector_t k3 = system.computeFlowMap(t + dt_halve, tmp, u);
-  tmp = x + dt * k3;
-  const vector_t k4 = system.computeFlowMap(t + dt, tmp, u);
-
-  tmp = x + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
-  return tmp;
+  return rk4Step(system, t, x, u, dt, k1);
 }
 
 /******************************************************************************************************/
@@ -129,43 +286,78 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
-  const scalar_t dt_halve = dt / 2.0;
-  const scalar_t dt_sixth = dt / 6.0;
-  const scalar_t dt_third = dt / 3.0;
+  return rk4SensitivityStep(system, t, x, u, dt, system.linearApproximation(t, x, u));
+}
 
-  // System evaluations
-  VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  vector_t tmpV = x + dt_halve * k1.f;
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt_halve * k2.f;
-  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt * k3.f;
-  VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, tmpV, u);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t rk4SubstepDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  size_t numSubsteps) {
+  const vector_t k1 = system.computeFlowMap(t, x, u);
+  return rk4Substeps(system, t, x, u, dt, std::max<size_t>(numSubsteps, 1), k1);
+}
 
-  // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
-  // Re-use memory from k.dfdu as dkduk
-  // dk1duk = k1.dfdu
-  k2.dfdu.noalias() += dt_halve * k2.dfdx * k1.dfdu;
-  k3.dfdu.noalias() += dt_halve * k3.dfdx * k2.dfdu;
-  k4.dfdu.noalias() += dt * k4.dfdx * k3.dfdu;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation rk4SubstepSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                      const vector_t& u, scalar_t dt, size_t numSubsteps) {
+  return rk4SensitivitySubsteps(system, t, x, u, dt, std::max<size_t>(numSubsteps, 1), system.linearApproximation(t, x, u));
+}
 
-  // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
-  // Re-use memory from k.dfdx as dkdxk
-  // dk1dxk = k1.dfdx;
-  matrix_t tmp = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
-  k2.dfdx += tmp;
-  tmp.noalias() = dt_halve * k3.dfdx * k2.dfdx;
-  k3.dfdx += tmp;
-  tmp.noalias() = dt * k4.dfdx * k3.dfdx;
-  k4.dfdx += tmp;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t rk4AdaptiveDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  // The linearization determines the number of substeps, such that the discretization is identical to its sensitivity version.
+  const auto k1 = system.linearApproximation(t, x, u);
+  return rk4Substeps(system, t, x, u, dt, getNumRk4Substeps(k1.dfdx, dt), k1.f);
+}
 
-  // Assemble discrete approximation
-  // Re-use k1 to collect the result
-  k1.dfdx = dt_sixth * k1.dfdx + dt_third * k2.dfdx + dt_third * k3.dfdx + dt_sixth * k4.dfdx;
-  k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
-  k1.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
-  k1.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
-  return k1;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation rk4AdaptiveSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                       const vector_t& u, scalar_t dt) {
+  auto k1 = system.linearApproximation(t, x, u);
+  const size_t numSubsteps = getNumRk4Substeps(k1.dfdx, dt);
+  return rk4SensitivitySubsteps(system, t, x, u, dt, numSubsteps, std::move(k1));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  VectorFunctionLinearApproximation midpointApproximation;
+  Eigen::PartialPivLU<matrix_t> newtonSystem;
+  const vector_t midpoint = solveImplicitMidpoint(system, t, x, u, dt, midpointApproximation, newtonSystem);
+
+  // x_{k+1} = 2 * x_{m} - x_{k}
+  vector_t tmp = 2.0 * midpoint - x;
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt) {
+  VectorFunctionLinearApproximation midpointApproximation;
+  Eigen::PartialPivLU<matrix_t> newtonSystem;
+  const vector_t midpoint = solveImplicitMidpoint(system, t, x, u, dt, midpointApproximation, newtonSystem);
+
+  // x_{k+1} = 2 * x_{m} - x_{k}, with (I - dt/2 * dfdx) * dx_{m} = dx_{k} + dt/2 * dfdu * du_{k}
+  // A_{k} = 2 * (I - dt/2 * dfdx)^{-1} - I
+  // B_{k} = dt * (I - dt/2 * dfdx)^{-1} * dfdu
+  // Re-use midpointApproximation to collect the result
+  midpointApproximation.dfdx = newtonSystem.inverse();
+  midpointApproximation.dfdx *= 2.0;
+  midpointApproximation.dfdx.diagonal().array() -= 1.0;  // minus Identity()
+  const matrix_t scaledDfdu = dt * midpointApproximation.dfdu;
+  midpointApproximation.dfdu = newtonSystem.solve(scaledDfdu);
+  midpointApproximation.f = 2.0 * midpoint - x;
+  return midpointApproximation;
 }
 
 }  // namespace ocs2
\ No newline at end of file
@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/loopshaping/LoopshapingAugmentation.h"
+
+namespace ocs2 {
+namespace loopshaping_augmentation {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eliminatePatternJacobian(const LoopshapingDefinition& loopshapingDefinition, const matrix_t& dfdx_system, const matrix_t& dfdu_system,
+                              matrix_t& dfdx, matrix_t& dfdu) {
+  const auto& s_filter = loopshapingDefinition.getInputFilter();
+  const auto sysStateDim = dfdx_system.cols();
+  const auto filtStateDim = s_filter.getNumStates();
+
+  dfdx.resize(dfdx_system.rows(), sysStateDim + filtStateDim);
+  dfdx.leftCols(sysStateDim) = dfdx_system;
+  if (loopshapingDefinition.isDiagonal()) {
+    dfdx.rightCols(filtStateDim).noalias() = dfdu_system * s_filter.getCdiag();
+    dfdu.noalias() = dfdu_system * s_filter.getDdiag();
+  } else {
+    dfdx.rightCols(filtStateDim).noalias() = dfdu_system * s_filter.getC();
+    dfdu.noalias() = dfdu_system * s_filter.getD();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eliminatePatternHessian(const LoopshapingDefinition& loopshapingDefinition, const matrix_t& dfdxx_system, const matrix_t& dfdux_system,
+                             const matrix_t& dfduu_system, matrix_t& dfdxx, matrix_t& dfdux, matrix_t& dfduu, matrix_t& workspace) {
+  const auto& s_filter = loopshapingDefinition.getInputFilter();
+  const auto sysStateDim = dfdxx_system.rows();
+  const auto filtStateDim = s_filter.getNumStates();
+  const auto inputDim = s_filter.getNumInputs();
+  const auto stateDim = sysStateDim + filtStateDim;
+
+  dfdxx.resize(stateDim, stateDim);
+  dfdux.resize(inputDim, stateDim);
+  dfdxx.topLeftCorner(sysStateDim, sysStateDim) = dfdxx_system;
+
+  if (loopshapingDefinition.isDiagonal()) {
+    // Products with diagonal matrices are evaluated coefficient-wise, without temporaries.
+    const auto& C = s_filter.getCdiag();
+    const auto& D = s_filter.getDdiag();
+    dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = C * dfdux_system;
+    dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = C * dfduu_system * C;
+    dfdux.leftCols(sysStateDim).noalias() = D * dfdux_system;
+    dfdux.rightCols(filtStateDim).noalias() = D * dfduu_system * C;
+    dfduu.noalias() = D * dfduu_system * D;
+  } else {
+    // dfduu_system * [C, D] is shared by all blocks that involve the filter.
+    const auto& C = s_filter.getC();
+    const auto& D = s_filter.getD();
+    workspace.noalias() = dfduu_system * s_filter.getCD();
+    dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = C.transpose() * dfdux_system;
+    dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = C.transpose() * workspace.leftCols(filtStateDim);
+    dfdux.leftCols(sysStateDim).noalias() = D.transpose() * dfdux_system;
+    dfdux.rightCols(filtStateDim).noalias() = D.transpose() * workspace.leftCols(filtStateDim);
+    dfduu.noalias() = D.transpose() * workspace.rightCols(inputDim);
+  }
+
+  dfdxx.topRightCorner(sysStateDim, filtStateDim).noalias() = dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eliminatePatternQuadraticApproximation(const LoopshapingDefinition& loopshapingDefinition,
+                                            const ScalarFunctionQuadraticApproximation& L_system, ScalarFunctionQuadraticApproximation& L) {
+  const auto& s_filter = loopshapingDefinition.getInputFilter();
+  const auto sysStateDim = L_system.dfdx.rows();
+  const auto filtStateDim = s_filter.getNumStates();
+
+  // dfdx & dfdu
+  L.dfdx.resize(sysStateDim + filtStateDim);
+  L.dfdx.head(sysStateDim) = L_system.dfdx;
+  if (loopshapingDefinition.isDiagonal()) {
+    L.dfdx.tail(filtStateDim).noalias() = s_filter.getCdiag() * L_system.dfdu;
+    L.dfdu.noalias() = s_filter.getDdiag() * L_system.dfdu;
+  } else {
+    L.dfdx.tail(filtStateDim).noalias() = s_filter.getC().transpose() * L_system.dfdu;
+    L.dfdu.noalias() = s_filter.getD().transpose() * L_system.dfdu;
+  }
+
+  // dfdxx, dfdux & dfduu
+  matrix_t workspace;
+  eliminatePatternHessian(loopshapingDefinition, L_system.dfdxx, L_system.dfdux, L_system.dfduu, L.dfdxx, L.dfdux, L.dfduu, workspace);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void outputPatternQuadraticApproximation(ScalarFunctionQuadraticApproximation& L_system, size_t filterStateDim,
+                                         ScalarFunctionQuadraticApproximation& L) {
+  const auto sysStateDim = L_system.dfdx.rows();
+  const auto stateDim = sysStateDim + filterStateDim;
+  const auto inputDim = L_system.dfdu.rows();
+
+  L.dfdx.resize(stateDim);
+  L.dfdx.head(sysStateDim) = L_system.dfdx;
+  L.dfdx.tail(filterStateDim).setZero();
+
+  L.dfdxx.resize(stateDim, stateDim);
+  L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
+  L.dfdxx.topRightCorner(sysStateDim, filterStateDim).setZero();
+  L.dfdxx.bottomRows(filterStateDim).setZero();
+
+  L.dfdu = std::move(L_system.dfdu);
+  L.dfduu = std::move(L_system.dfduu);
+
+  L.dfdux.resize(inputDim, stateDim);
+  L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
+  L.dfdux.rightCols(filterStateDim).setZero();
+}
+
+}  // namespace loopshaping_augmentation
+}  // namespace ocs2
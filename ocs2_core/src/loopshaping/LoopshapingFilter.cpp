@@ -54,6 +54,9 @@ Filter::Filter(matrix_t A, matrix_t B, matrix_t C, matrix_t D)
       numOutputs_(C_.rows()) {
   checkSize();
 
+  CD_.resize(numOutputs_, numStates_ + numInputs_);
+  CD_ << C_, D_;
+
   // precompute row + column scaling
   diagCC_ = c_ * matrix_t::Ones(c_.cols(), c_.rows()) * c_;
   diagDC_ = d_ * matrix_t::Ones(d_.cols(), c_.rows()) * c_;
@@ -142,8 +142,8 @@ Filter readMIMOFilter(const boost::property_tree::ptree& pt, std::string filterN
 
 std::shared_ptr<LoopshapingDefinition> load(const std::string& settingsFile) {
   // Read from settings File
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(settingsFile, pt);
+  const auto ptPtr = loadData::getPropertyTree(settingsFile);
+  const auto& pt = *ptPtr;
   Filter r_filter = loopshaping_property_tree::readMIMOFilter(pt, "r_filter");
   Filter s_filter = loopshaping_property_tree::readMIMOFilter(pt, "s_inv_filter", /*invert=*/true);
 
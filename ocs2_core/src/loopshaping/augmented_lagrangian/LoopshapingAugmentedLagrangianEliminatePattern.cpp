@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/augmented_lagrangian/LoopshapingAugmentedLagrangianEliminatePattern.h>
 
@@ -38,74 +39,19 @@ ScalarFunctionQuadraticApproximation LoopshapingAugmentedLagrangianEliminatePatt
     return ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
   }
 
-  const bool isDiagonal = loopshapingDefinition_->isDiagonal();
-  const auto& s_filter = loopshapingDefinition_->getInputFilter();
   const auto& preCompLS = cast<LoopshapingPreComputation>(preComp);
   const auto& x_system = preCompLS.getSystemState();
   const auto& u_system = preCompLS.getSystemInput();
-  const auto& x_filter = preCompLS.getFilterState();
   const auto& preComp_system = preCompLS.getSystemPreComputation();
-  const auto stateDim = x.rows();
-  const auto inputDim = u.rows();
-  const auto sysStateDim = x_system.rows();
-  const auto filtStateDim = x_filter.rows();
 
-  auto L_system =
+  const auto L_system =
       LoopshapingStateInputAugmentedLagrangian::getQuadraticApproximation(t, x_system, u_system, termsMultiplier, preComp_system);
 
   ScalarFunctionQuadraticApproximation L;
+  L.f = L_system.f;
+  loopshaping_augmentation::eliminatePatternQuadraticApproximation(*loopshapingDefinition_, L_system, L);
 
-  // f
-  L.f = std::move(L_system.f);
-
-  if (isDiagonal) {
-    // dfdx
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
-    L.dfdx.tail(filtStateDim) = s_filter.getCdiag().diagonal().cwiseProduct(L_system.dfdu);
-
-    // dfdxx
-    L.dfdxx.resize(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = s_filter.getCdiag() * L_system.dfdux;
-    L.dfdxx.topRightCorner(sysStateDim, filtStateDim) = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getScalingCdiagCdiag().cwiseProduct(L_system.dfduu);
-
-    // dfdu & dfduu
-    L.dfdu = s_filter.getDdiag().diagonal().cwiseProduct(L_system.dfdu);
-    L.dfduu = s_filter.getScalingDdiagDdiag().cwiseProduct(L_system.dfduu);
-
-    // dfdux
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim).noalias() = s_filter.getDdiag() * L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim) = s_filter.getScalingDdiagCdiag().cwiseProduct(L_system.dfduu);
-
-    return L;
-  } else {
-    // dfdx
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
-    L.dfdx.tail(filtStateDim).noalias() = s_filter.getC().transpose() * L_system.dfdu;
-
-    // dfdxx
-    L.dfdxx.resize(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim) = s_filter.getC().transpose() * L_system.dfdux;
-    L.dfdxx.topRightCorner(sysStateDim, filtStateDim).noalias() = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
-    matrix_t dfduu_C = L_system.dfduu * s_filter.getC();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = s_filter.getC().transpose() * dfduu_C;
-
-    // dfdu & dfduu
-    L.dfdu.noalias() = s_filter.getD().transpose() * L_system.dfdu;
-    L.dfduu.noalias() = s_filter.getD().transpose() * L_system.dfduu * s_filter.getD();
-
-    // dfdux
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim).noalias() = s_filter.getD().transpose() * L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim).noalias() = s_filter.getD().transpose() * dfduu_C;
-
-    return L;
-  }
+  return L;
 }
 
 }  // namespace ocs2
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/augmented_lagrangian/LoopshapingAugmentedLagrangianOutputPattern.h>
 
@@ -38,16 +39,11 @@ ScalarFunctionQuadraticApproximation LoopshapingAugmentedLagrangianOutputPattern
     return ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
   }
 
-  const bool isDiagonal = loopshapingDefinition_->isDiagonal();
-  const auto& r_filter = loopshapingDefinition_->getInputFilter();
   const auto& preCompLS = cast<LoopshapingPreComputation>(preComp);
   const auto& x_system = preCompLS.getSystemState();
   const auto& u_system = preCompLS.getSystemInput();
   const auto& x_filter = preCompLS.getFilterState();
   const auto& preComp_system = preCompLS.getSystemPreComputation();
-  const auto stateDim = x.rows();
-  const auto inputDim = u.rows();
-  const auto sysStateDim = x_system.rows();
   const auto filtStateDim = x_filter.rows();
 
   // Not const, so we can move
@@ -56,19 +52,7 @@ ScalarFunctionQuadraticApproximation LoopshapingAugmentedLagrangianOutputPattern
 
   ScalarFunctionQuadraticApproximation L;
   L.f = std::move(L_system.f);
-
-  L.dfdx.setZero(stateDim);
-  L.dfdx.head(sysStateDim) = L_system.dfdx;
-
-  L.dfdxx.setZero(stateDim, stateDim);
-  L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-
-  L.dfdu = std::move(L_system.dfdu);
-  L.dfduu = std::move(L_system.dfduu);
-
-  L.dfdux.resize(inputDim, stateDim);
-  L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
-  L.dfdux.rightCols(filtStateDim).setZero();
+  loopshaping_augmentation::outputPatternQuadraticApproximation(L_system, filtStateDim, L);
 
   return L;
 }
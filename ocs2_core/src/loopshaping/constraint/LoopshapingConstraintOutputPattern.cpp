@@ -103,8 +103,10 @@ VectorFunctionQuadraticApproximation LoopshapingConstraintOutputPattern::getQuad
   h.dfduu.resize(numConstraints);
   h.dfdux.resize(numConstraints);
   for (size_t i = 0; i < numConstraints; i++) {
-    h.dfdxx[i].setZero(stateDim, stateDim);
+    h.dfdxx[i].resize(stateDim, stateDim);
     h.dfdxx[i].topLeftCorner(sysStateDim, sysStateDim) = h_system.dfdxx[i];
+    h.dfdxx[i].topRightCorner(sysStateDim, filtStateDim).setZero();
+    h.dfdxx[i].bottomRows(filtStateDim).setZero();
 
     h.dfduu[i] = std::move(h_system.dfduu[i]);
 
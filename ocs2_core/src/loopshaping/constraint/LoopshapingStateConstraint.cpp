@@ -50,6 +50,23 @@ vector_array_t LoopshapingStateConstraint::getValue(scalar_t t, const vector_t&
   return StateConstraintCollection::getValue(t, x_system, preComp_system);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LoopshapingStateConstraint::getStackedValue(scalar_t t, const vector_t& x, const PreComputation& preComp,
+                                                 Eigen::Ref<vector_t> stackedValue) const {
+  if (this->empty()) {
+    StateConstraintCollection::getStackedValue(t, x, preComp, stackedValue);
+    return;
+  }
+
+  const LoopshapingPreComputation& preCompLS = cast<LoopshapingPreComputation>(preComp);
+  const auto& x_system = preCompLS.getSystemState();
+  const auto& preComp_system = preCompLS.getSystemPreComputation();
+
+  StateConstraintCollection::getStackedValue(t, x_system, preComp_system, stackedValue);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -52,4 +52,22 @@ vector_array_t LoopshapingStateInputConstraint::getValue(scalar_t t, const vecto
   return StateInputConstraintCollection::getValue(t, x_system, u_system, preComp_system);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LoopshapingStateInputConstraint::getStackedValue(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                                                      Eigen::Ref<vector_t> stackedValue) const {
+  if (this->empty()) {
+    StateInputConstraintCollection::getStackedValue(t, x, u, preComp, stackedValue);
+    return;
+  }
+
+  const LoopshapingPreComputation& preCompLS = cast<LoopshapingPreComputation>(preComp);
+  const auto& x_system = preCompLS.getSystemState();
+  const auto& u_system = preCompLS.getSystemInput();
+  const auto& preComp_system = preCompLS.getSystemPreComputation();
+
+  StateInputConstraintCollection::getStackedValue(t, x_system, u_system, preComp_system, stackedValue);
+}
+
 }  // namespace ocs2
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/cost/LoopshapingCostEliminatePattern.h>
 
@@ -38,79 +39,26 @@ ScalarFunctionQuadraticApproximation LoopshapingCostEliminatePattern::getQuadrat
     return ScalarFunctionQuadraticApproximation::Zero(x.rows(), u.rows());
   }
 
-  const bool isDiagonal = loopshapingDefinition_->isDiagonal();
-  const auto& s_filter = loopshapingDefinition_->getInputFilter();
   const auto& preCompLS = cast<LoopshapingPreComputation>(preComp);
   const auto& x_system = preCompLS.getSystemState();
   const auto& u_system = preCompLS.getSystemInput();
-  const auto& x_filter = preCompLS.getFilterState();
   const auto& u_filter = preCompLS.getFilteredInput();
-  const auto stateDim = x.rows();
-  const auto inputDim = u.rows();
-  const auto sysStateDim = x_system.rows();
-  const auto filtStateDim = x_filter.rows();
 
   const auto& Rfilter = loopshapingDefinition_->costMatrix();
-  vector_t Ru_filter = Rfilter * u_filter;
+  const vector_t Ru_filter = Rfilter * u_filter;
 
   const auto L_system =
       StateInputCostCollection::getQuadraticApproximation(t, x_system, u_system, targetTrajectories, preCompLS.getSystemPreComputation());
 
   ScalarFunctionQuadraticApproximation L;
-
-  // f
   L.f = L_system.f + 0.5 * u_filter.dot(Ru_filter);
+  loopshaping_augmentation::eliminatePatternQuadraticApproximation(*loopshapingDefinition_, L_system, L);
 
-  if (isDiagonal) {
-    // dfdx
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
-    L.dfdx.tail(filtStateDim) = s_filter.getCdiag().diagonal().cwiseProduct(L_system.dfdu);
-
-    // dfdxx
-    L.dfdxx.resize(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = s_filter.getCdiag() * L_system.dfdux;
-    L.dfdxx.topRightCorner(sysStateDim, filtStateDim) = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getScalingCdiagCdiag().cwiseProduct(L_system.dfduu);
-
-    // dfdu & dfduu
-    L.dfdu = Ru_filter + s_filter.getDdiag().diagonal().cwiseProduct(L_system.dfdu);
-    L.dfduu = Rfilter + s_filter.getScalingDdiagDdiag().cwiseProduct(L_system.dfduu);
-
-    // dfdux
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim).noalias() = s_filter.getDdiag() * L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim) = s_filter.getScalingDdiagCdiag().cwiseProduct(L_system.dfduu);
-
-    return L;
-  } else {
-    // dfdx
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
-    L.dfdx.tail(filtStateDim).noalias() = s_filter.getC().transpose() * L_system.dfdu;
+  // The filtered input is the input of the augmented system
+  L.dfdu += Ru_filter;
+  L.dfduu += Rfilter;
 
-    // dfdxx
-    L.dfdxx.resize(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim) = s_filter.getC().transpose() * L_system.dfdux;
-    L.dfdxx.topRightCorner(sysStateDim, filtStateDim).noalias() = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
-    const matrix_t dfduu_C = L_system.dfduu * s_filter.getC();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = s_filter.getC().transpose() * dfduu_C;
-
-    // dfdu & dfduu
-    L.dfdu = std::move(Ru_filter);
-    L.dfdu.noalias() += s_filter.getD().transpose() * L_system.dfdu;
-    L.dfduu = Rfilter;
-    L.dfduu.noalias() += s_filter.getD().transpose() * L_system.dfduu * s_filter.getD();
-
-    // dfdux
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim).noalias() = s_filter.getD().transpose() * L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim).noalias() = s_filter.getD().transpose() * dfduu_C;
-
-    return L;
-  }
+  return L;
 }
 
 }  // namespace ocs2
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/cost/LoopshapingCostOutputPattern.h>
 
@@ -47,9 +48,6 @@ ScalarFunctionQuadraticApproximation LoopshapingCostOutputPattern::getQuadraticA
   const auto& u_system = preCompLS.getSystemInput();
   const auto& x_filter = preCompLS.getFilterState();
   const auto& u_filter = preCompLS.getFilteredInput();
-  const auto stateDim = x.rows();
-  const auto inputDim = u.rows();
-  const auto sysStateDim = x_system.rows();
   const auto filtStateDim = x_filter.rows();
 
   const auto& Rfilter = loopshapingDefinition_->costMatrix();
@@ -61,45 +59,21 @@ ScalarFunctionQuadraticApproximation LoopshapingCostOutputPattern::getQuadraticA
 
   ScalarFunctionQuadraticApproximation L;
   L.f = L_system.f + 0.5 * u_filter.dot(Ru_filter);
+  loopshaping_augmentation::outputPatternQuadraticApproximation(L_system, filtStateDim, L);
 
+  // Cost on the filtered input. The Hessians are constant and precomputed in the loopshaping definition.
   if (isDiagonal) {
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
-    L.dfdx.tail(filtStateDim) = r_filter.getCdiag().diagonal().cwiseProduct(Ru_filter);
-
-    L.dfdxx.setZero(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = r_filter.getScalingCdiagCdiag().cwiseProduct(Rfilter);
-
-    L.dfdu = L_system.dfdu + r_filter.getDdiag().diagonal().cwiseProduct(Ru_filter);
-    L.dfduu = L_system.dfduu + r_filter.getScalingDdiagDdiag().cwiseProduct(Rfilter);
-
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim) = r_filter.getScalingDdiagCdiag().cwiseProduct(Rfilter);
-
-    return L;
+    L.dfdx.tail(filtStateDim).noalias() = r_filter.getCdiag() * Ru_filter;
+    L.dfdu.noalias() += r_filter.getDdiag() * Ru_filter;
   } else {
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
     L.dfdx.tail(filtStateDim).noalias() = r_filter.getC().transpose() * Ru_filter;
-
-    L.dfdxx.setZero(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    const matrix_t dfduu_C = Rfilter * r_filter.getC();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = r_filter.getC().transpose() * dfduu_C;
-
-    L.dfdu = std::move(L_system.dfdu);
     L.dfdu.noalias() += r_filter.getD().transpose() * Ru_filter;
-    L.dfduu = std::move(L_system.dfduu);
-    L.dfduu.noalias() += r_filter.getD().transpose() * Rfilter * r_filter.getD();
-
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim).noalias() = r_filter.getD().transpose() * dfduu_C;
-
-    return L;
   }
+  L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = loopshapingDefinition_->getCostMatrixCC();
+  L.dfduu += loopshapingDefinition_->getCostMatrixDD();
+  L.dfdux.rightCols(filtStateDim) = loopshapingDefinition_->getCostMatrixDC();
+
+  return L;
 }
 
 }  // namespace ocs2
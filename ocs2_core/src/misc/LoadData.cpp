@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/LoadData.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include <sys/stat.h>
+
+namespace ocs2 {
+namespace loadData {
+
+namespace {
+
+/** Identifies the version of a file, the file is parsed again if any of them changes */
+struct FileStamp {
+  dev_t device;
+  ino_t inode;
+  off_t size;
+  timespec modificationTime;
+
+  bool operator==(const FileStamp& other) const {
+    return device == other.device && inode == other.inode && size == other.size &&
+           modificationTime.tv_sec == other.modificationTime.tv_sec && modificationTime.tv_nsec == other.modificationTime.tv_nsec;
+  }
+};
+
+bool getFileStamp(const std::string& filename, FileStamp& stamp) {
+  struct stat status;
+  if (stat(filename.c_str(), &status) != 0) {
+    return false;
+  }
+  stamp = {status.st_dev, status.st_ino, status.st_size, status.st_mtim};
+  return true;
+}
+
+struct CachedPropertyTree {
+  FileStamp stamp;
+  std::shared_ptr<const boost::property_tree::ptree> ptPtr;
+};
+
+std::mutex& getCacheMutex() {
+  static std::mutex cacheMutex;
+  return cacheMutex;
+}
+
+std::unordered_map<std::string, CachedPropertyTree>& getCache() {
+  static std::unordered_map<std::string, CachedPropertyTree> cache;
+  return cache;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const boost::property_tree::ptree> getPropertyTree(const std::string& filename) {
+  FileStamp stamp;
+  if (!getFileStamp(filename, stamp)) {
+    // not cached, read_info reports the error
+    auto ptPtr = std::make_shared<boost::property_tree::ptree>();
+    boost::property_tree::read_info(filename, *ptPtr);
+    return ptPtr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    const auto it = getCache().find(filename);
+    if (it != getCache().end() && it->second.stamp == stamp) {
+      return it->second.ptPtr;
+    }
+  }
+
+  // the file is parsed without holding the lock, such that different files can be parsed concurrently
+  auto ptPtr = std::make_shared<boost::property_tree::ptree>();
+  boost::property_tree::read_info(filename, *ptPtr);
+
+  // the file might have been modified while it was parsed, then it is parsed again on the next call
+  FileStamp stampAfterRead;
+  if (getFileStamp(filename, stampAfterRead) && stampAfterRead == stamp) {
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    getCache()[filename] = {stamp, ptPtr};
+  }
+  return ptPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clearPropertyTreeCache() {
+  std::lock_guard<std::mutex> lock(getCacheMutex());
+  getCache().clear();
+}
+
+}  // namespace loadData
+}  // namespace ocs2
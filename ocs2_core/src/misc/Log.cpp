@@ -83,8 +83,8 @@ SeverityLevel fromString(const std::string& severity) {
 /******************************************************************************************************/
 Settings loadSettings(const std::string& fileName, const std::string& fieldName) {
   Settings settings;
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::getPropertyTree(fileName);
+  const auto& pt = *ptPtr;
 
   loadData::loadPtreeValue(pt, settings.useConsole, fieldName + ".useConsole", false);
 
@@ -0,0 +1,390 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace ocs2 {
+namespace profiler {
+
+namespace {
+
+/**
+ * Number of events per thread, see setEventsPerThread(). A buffer is allocated at the first event recorded after its creation or after
+ * clear(), and it is not reallocated afterwards, such that it can be read while other threads record.
+ */
+std::atomic<size_t> eventsPerThread{size_t(1) << 16};
+
+struct ZoneEvent {
+  zone_id_t zoneId;
+  int64_t startTime;  // [ns]
+  int64_t endTime;    // [ns]
+};
+
+/** Events of a single thread. Only the owning thread writes, the size is published with release semantics. */
+struct ThreadBuffer {
+  explicit ThreadBuffer(size_t threadIndexArg) : threadIndex(threadIndexArg) {}
+
+  const size_t threadIndex;
+  std::vector<ZoneEvent> events;
+  std::atomic<size_t> size{0};
+  std::atomic<size_t> numDropped{0};
+  bool isFinished = false;  // guarded by the registry mutex
+};
+
+struct Registry {
+  std::mutex mutex;
+  size_t numThreads = 0;
+  std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+  std::vector<std::string> zoneNames;
+  std::unordered_map<std::string, zone_id_t> zoneIds;
+};
+
+/** The registry is never destroyed, since threads may record events during static destruction. */
+Registry& getRegistry() {
+  static auto* registryPtr = new Registry;
+  return *registryPtr;
+}
+
+/** The buffer of the calling thread. Trivially destructible, such that it can be read while the thread_local objects are destroyed. */
+thread_local ThreadBuffer* threadBufferPtr = nullptr;
+thread_local bool isThreadExiting = false;
+
+/**
+ * Shrinks the buffer of the thread to its recorded events when the thread exits. The events are kept until clear(), such that the events
+ * of finished threads can be exported. Events recorded after this point, e.g. by other thread_local destructors, are ignored.
+ */
+struct ThreadExitHandler {
+  ~ThreadExitHandler() {
+    isThreadExiting = true;
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    threadBufferPtr->events.resize(threadBufferPtr->size.load(std::memory_order_relaxed));
+    threadBufferPtr->events.shrink_to_fit();
+    threadBufferPtr->isFinished = true;
+    threadBufferPtr = nullptr;
+  }
+};
+
+/** Gets the buffer of the calling thread. Returns nullptr if the thread is exiting. */
+ThreadBuffer* getThreadBuffer() {
+  if (threadBufferPtr == nullptr && !isThreadExiting) {
+    auto& registry = getRegistry();
+    {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.threadBuffers.emplace_back(new ThreadBuffer(registry.numThreads++));
+      threadBufferPtr = registry.threadBuffers.back().get();
+    }
+    thread_local ThreadExitHandler exitHandler;
+    (void)exitHandler;
+  }
+  return threadBufferPtr;
+}
+
+/** Allocates the events of the buffer of the calling thread. */
+void allocateEvents(ThreadBuffer& threadBuffer) {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  threadBuffer.events.resize(eventsPerThread.load(std::memory_order_relaxed));
+}
+
+/** Calls f(threadIndex, event) for all recorded events. The registry mutex should be locked. */
+template <typename Function>
+void forEachEvent(const Registry& registry, Function f) {
+  for (const auto& threadBufferPtr : registry.threadBuffers) {
+    const size_t size = threadBufferPtr->size.load(std::memory_order_acquire);
+    for (size_t i = 0; i < size; ++i) {
+      f(threadBufferPtr->threadIndex, threadBufferPtr->events[i]);
+    }
+  }
+}
+
+/** Nearest-rank percentile of sorted durations, p in [0, 1]. */
+scalar_t percentile(const std::vector<int64_t>& sortedDurations, scalar_t p) {
+  const auto rank = static_cast<size_t>(std::ceil(p * static_cast<scalar_t>(sortedDurations.size())));
+  return 1e-6 * static_cast<scalar_t>(sortedDurations[std::min(std::max(rank, size_t(1)), sortedDurations.size()) - 1]);
+}
+
+std::string escapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+}  // unnamed namespace
+
+namespace detail {
+std::atomic_bool enabled{false};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void record(zone_id_t zoneId, int64_t startTime, int64_t endTime) {
+  auto* threadBufferPtr = getThreadBuffer();
+  if (threadBufferPtr == nullptr) {
+    return;
+  }
+  auto& threadBuffer = *threadBufferPtr;
+  if (threadBuffer.events.empty()) {
+    allocateEvents(threadBuffer);
+  }
+  const size_t size = threadBuffer.size.load(std::memory_order_relaxed);
+  if (size < threadBuffer.events.size()) {
+    threadBuffer.events[size] = {zoneId, startTime, endTime};
+    threadBuffer.size.store(size + 1, std::memory_order_release);
+  } else {
+    threadBuffer.numDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+}  // namespace detail
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+zone_id_t registerZone(const std::string& name) {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto result = registry.zoneIds.emplace(name, static_cast<zone_id_t>(registry.zoneNames.size()));
+  if (result.second) {
+    registry.zoneNames.push_back(name);
+  }
+  return result.first->second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getZoneName(zone_id_t zoneId) {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (zoneId >= registry.zoneNames.size()) {
+    throw std::runtime_error("[profiler::getZoneName] Zone " + std::to_string(zoneId) + " is not registered!");
+  }
+  return registry.zoneNames[zoneId];
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEnabled(bool enabled) {
+  detail::enabled.store(enabled);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEventsPerThread(size_t numEvents) {
+  if (numEvents == 0) {
+    throw std::runtime_error("[profiler::setEventsPerThread] The number of events per thread should be positive!");
+  }
+  eventsPerThread.store(numEvents, std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getEventsPerThread() {
+  return eventsPerThread.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clear() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  // The buffers of finished threads are released
+  registry.threadBuffers.erase(
+      std::remove_if(registry.threadBuffers.begin(), registry.threadBuffers.end(),
+                     [](const std::unique_ptr<ThreadBuffer>& threadBufferPtr) { return threadBufferPtr->isFinished; }),
+      registry.threadBuffers.end());
+  // The events are released while the profiler is disabled, or reallocated by the next event if the number of events per thread changed
+  const bool keepEvents = detail::enabled.load(std::memory_order_relaxed);
+  const size_t numEvents = eventsPerThread.load(std::memory_order_relaxed);
+  for (auto& threadBufferPtr : registry.threadBuffers) {
+    threadBufferPtr->size.store(0, std::memory_order_release);
+    threadBufferPtr->numDropped.store(0, std::memory_order_relaxed);
+    if (!keepEvents || threadBufferPtr->events.size() != numEvents) {
+      std::vector<ZoneEvent>().swap(threadBufferPtr->events);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getNumDroppedEvents() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  size_t numDropped = 0;
+  for (const auto& threadBufferPtr : registry.threadBuffers) {
+    numDropped += threadBufferPtr->numDropped.load(std::memory_order_relaxed);
+  }
+  return numDropped;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ZoneStatistics> getStatistics() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::vector<std::vector<int64_t>> durations(registry.zoneNames.size());
+  forEachEvent(registry, [&](size_t, const ZoneEvent& event) { durations[event.zoneId].push_back(event.endTime - event.startTime); });
+
+  std::vector<ZoneStatistics> statistics;
+  for (size_t zoneId = 0; zoneId < durations.size(); ++zoneId) {
+    auto& zoneDurations = durations[zoneId];
+    if (zoneDurations.empty()) {
+      continue;
+    }
+    std::sort(zoneDurations.begin(), zoneDurations.end());
+
+    ZoneStatistics zoneStatistics;
+    zoneStatistics.name = registry.zoneNames[zoneId];
+    zoneStatistics.count = zoneDurations.size();
+    int64_t total = 0;
+    for (const auto duration : zoneDurations) {
+      total += duration;
+    }
+    zoneStatistics.total = 1e-6 * static_cast<scalar_t>(total);
+    zoneStatistics.mean = zoneStatistics.total / static_cast<scalar_t>(zoneStatistics.count);
+    zoneStatistics.median = percentile(zoneDurations, 0.5);
+    zoneStatistics.percentile90 = percentile(zoneDurations, 0.9);
+    zoneStatistics.percentile99 = percentile(zoneDurations, 0.99);
+    zoneStatistics.max = 1e-6 * static_cast<scalar_t>(zoneDurations.back());
+    statistics.push_back(std::move(zoneStatistics));
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const ZoneStatistics& lhs, const ZoneStatistics& rhs) { return lhs.total > rhs.total; });
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getSummary() {
+  const auto statistics = getStatistics();
+
+  size_t nameWidth = 4;
+  for (const auto& zoneStatistics : statistics) {
+    nameWidth = std::max(nameWidth, zoneStatistics.name.size());
+  }
+
+  std::ostringstream summary;
+  summary << std::left << std::setw(nameWidth) << "zone" << std::right << std::setw(10) << "count" << std::setw(12) << "total"
+          << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12)
+          << "max"
+          << "  [ms]\n";
+  summary << std::fixed << std::setprecision(4);
+  for (const auto& zoneStatistics : statistics) {
+    summary << std::left << std::setw(nameWidth) << zoneStatistics.name << std::right << std::setw(10) << zoneStatistics.count
+            << std::setw(12) << zoneStatistics.total << std::setw(12) << zoneStatistics.mean << std::setw(12) << zoneStatistics.median
+            << std::setw(12) << zoneStatistics.percentile90 << std::setw(12) << zoneStatistics.percentile99 << std::setw(12)
+            << zoneStatistics.max << "\n";
+  }
+  const auto numDropped = getNumDroppedEvents();
+  if (numDropped > 0) {
+    summary << "dropped events: " << numDropped << "\n";
+  }
+  return summary.str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(std::ostream& stream) {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  // Timestamps are relative to the first event
+  int64_t firstTime = std::numeric_limits<int64_t>::max();
+  forEachEvent(registry, [&](size_t, const ZoneEvent& event) { firstTime = std::min(firstTime, event.startTime); });
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool isFirst = true;
+  const auto precision = stream.precision(3);
+  const auto flags = stream.setf(std::ios::fixed, std::ios::floatfield);
+  forEachEvent(registry, [&](size_t threadIndex, const ZoneEvent& event) {
+    stream << (isFirst ? "\n" : ",\n");
+    stream << "{\"name\":\"" << escapeJson(registry.zoneNames[event.zoneId]) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadIndex
+           << ",\"ts\":" << 1e-3 * static_cast<scalar_t>(event.startTime - firstTime)
+           << ",\"dur\":" << 1e-3 * static_cast<scalar_t>(event.endTime - event.startTime) << "}";
+    isFirst = false;
+  });
+  stream << "\n]}\n";
+  stream.precision(precision);
+  stream.flags(flags);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(const std::string& filePath) {
+  std::ofstream file(filePath);
+  if (!file) {
+    throw std::runtime_error("[profiler::writeChromeTrace] Could not open file: " + filePath);
+  }
+  writeChromeTrace(file);
+}
+
+}  // namespace profiler
+}  // namespace ocs2
@@ -65,7 +65,7 @@ void TargetTrajectories::clear() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
-bool TargetTrajectories::operator==(const TargetTrajectories& other) {
+bool TargetTrajectories::operator==(const TargetTrajectories& other) const {
   return this->timeTrajectory == other.timeTrajectory && this->stateTrajectory == other.stateTrajectory &&
          this->inputTrajectory == other.inputTrajectory;
 }
@@ -103,6 +103,29 @@ void swap(TargetTrajectories& lh, TargetTrajectories& rh) {
   lh.inputTrajectory.swap(rh.inputTrajectory);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void sampleTargetTrajectories(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid,
+                              TargetTrajectories& sampledTargetTrajectories) {
+  if (targetTrajectories.empty()) {
+    throw std::runtime_error("[sampleTargetTrajectories] TargetTrajectories is empty!");
+  }
+
+  const bool hasInput = !targetTrajectories.inputTrajectory.empty();
+  sampledTargetTrajectories.timeTrajectory = timeGrid;
+  sampledTargetTrajectories.stateTrajectory.resize(timeGrid.size());
+  sampledTargetTrajectories.inputTrajectory.resize(hasInput ? timeGrid.size() : 0);
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor(targetTrajectories.timeTrajectory);
+  for (size_t i = 0; i < timeGrid.size(); i++) {
+    const auto indexAlpha = timeSegmentCursor.timeSegment(timeGrid[i]);
+    sampledTargetTrajectories.stateTrajectory[i] = LinearInterpolation::interpolate(indexAlpha, targetTrajectories.stateTrajectory);
+    if (hasInput) {
+      sampledTargetTrajectories.inputTrajectory[i] = LinearInterpolation::interpolate(indexAlpha, targetTrajectories.inputTrajectory);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
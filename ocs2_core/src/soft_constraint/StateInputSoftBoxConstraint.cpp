@@ -100,15 +100,25 @@ scalar_t StateInputSoftBoxConstraint::getValue(scalar_t time, const vector_t& st
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation StateInputSoftBoxConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                             const vector_t& input,
-                                                                                            const TargetTrajectories&,
+                                                                                            const TargetTrajectories& targetTrajectories,
                                                                                             const PreComputation& preComp) const {
   auto cost = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
-  fillQuadraticApproximation(time, state, stateBoxConstraints_, cost.f, cost.dfdx, cost.dfdxx);
-  fillQuadraticApproximation(time, input, inputBoxConstraints_, cost.f, cost.dfdu, cost.dfduu);
-  cost.f += offset_;
+  accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputSoftBoxConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                   const TargetTrajectories&, const PreComputation& preComp,
+                                                                   ScalarFunctionQuadraticApproximation& approximation) const {
+  // Only the diagonal entries of the constrained indices are touched.
+  fillQuadraticApproximation(time, state, stateBoxConstraints_, approximation.f, approximation.dfdx, approximation.dfdxx);
+  fillQuadraticApproximation(time, input, inputBoxConstraints_, approximation.f, approximation.dfdu, approximation.dfduu);
+  approximation.f += offset_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -88,4 +88,22 @@ ScalarFunctionQuadraticApproximation StateSoftConstraint::getQuadraticApproximat
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateSoftConstraint::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories&,
+                                                           const PreComputation& preComp,
+                                                           ScalarFunctionQuadraticApproximation& approximation) const {
+  switch (constraintPtr_->getOrder()) {
+    case ConstraintOrder::Linear:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getLinearApproximation(time, state, preComp), 1.0, approximation);
+      break;
+    case ConstraintOrder::Quadratic:
+      penalty_.accumulateQuadraticApproximation(time, constraintPtr_->getQuadraticApproximation(time, state, preComp), 1.0, approximation);
+      break;
+    default:
+      throw std::runtime_error("[StateSoftConstraint] Unknown constraint Order");
+  }
+}
+
 }  // namespace ocs2
@@ -148,6 +148,28 @@ TEST(TestConstraintCollection, getValue) {
   EXPECT_TRUE(constraintValues[1].isApprox(expectedValue));
 }
 
+TEST(TestConstraintCollection, getStackedValue) {
+  ocs2::StateInputConstraintCollection constraintCollection;
+  constraintCollection.add("Constraint1", std::make_unique<TestDummyConstraint>());
+  constraintCollection.add("Constraint2", std::make_unique<TestDummyConstraint>());
+  constraintCollection.get<TestDummyConstraint>("Constraint1").setActivity(false);
+  constraintCollection.add("Constraint3", std::make_unique<TestDummyConstraint>());
+
+  const double t = 0.0;
+  const ocs2::vector_t x = ocs2::vector_t::Zero(3);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(2);
+
+  // The active terms are written into a segment of a larger buffer
+  ocs2::vector_t buffer = ocs2::vector_t::Constant(6, -1.0);
+  constraintCollection.getStackedValue(t, x, u, ocs2::PreComputation(), buffer.segment(1, 4));
+  const ocs2::vector_t expectedBuffer = (ocs2::vector_t(6) << -1.0, 1.0, 2.0, 1.0, 2.0, -1.0).finished();
+  EXPECT_TRUE(buffer.isApprox(expectedBuffer));
+
+  // The size has to match the active constraints
+  EXPECT_THROW(constraintCollection.getStackedValue(t, x, u, ocs2::PreComputation(), buffer.segment(0, 3)), std::runtime_error);
+  EXPECT_THROW(constraintCollection.getStackedValue(t, x, u, ocs2::PreComputation(), buffer.segment(0, 5)), std::runtime_error);
+}
+
 TEST(TestConstraintCollection, getLinearApproximation) {
   using collection_t = ocs2::StateInputConstraintCollection;
   collection_t constraintCollection;
@@ -29,8 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCostCollection.h>
 #include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/penalties/Penalties.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 
 class SimpleQuadraticCost final : public ocs2::StateInputCost {
  public:
@@ -154,6 +158,127 @@ TEST_F(StateInputCost_TestFixture, canClone) {
   EXPECT_NEAR(cost, expectedCost, 1e-6);
 }
 
+TEST_F(StateInputCost_TestFixture, profilingZonesPerCollection) {
+  std::unique_ptr<ocs2::StateInputCostCollection> softConstraintCollection(costCollection.clone());
+  softConstraintCollection->setProfilingPrefix("softConstraint/");
+  std::unique_ptr<ocs2::StateInputCostCollection> softConstraintCollectionCopy(softConstraintCollection->clone());
+
+  ocs2::profiler::clear();
+  ocs2::profiler::setEnabled(true);
+  costCollection.getValue(t, x, u, targetTrajectories, {});
+  softConstraintCollection->getValue(t, x, u, targetTrajectories, {});
+  softConstraintCollectionCopy->getValue(t, x, u, targetTrajectories, {});
+  ocs2::profiler::setEnabled(false);
+
+  size_t costCount = 0;
+  size_t softConstraintCount = 0;
+  for (const auto& zoneStatistics : ocs2::profiler::getStatistics()) {
+    if (zoneStatistics.name == "StateInputCost/Simple quadratic cost") {
+      costCount = zoneStatistics.count;
+    } else if (zoneStatistics.name == "softConstraint/Simple quadratic cost") {
+      softConstraintCount = zoneStatistics.count;
+    }
+  }
+  ocs2::profiler::clear();
+  EXPECT_EQ(costCount, 1);
+  EXPECT_EQ(softConstraintCount, 2);
+}
+
+class RandomLinearConstraint final : public ocs2::StateInputConstraint {
+ public:
+  RandomLinearConstraint(size_t numConstraints, size_t stateDim, size_t inputDim)
+      : ocs2::StateInputConstraint(ocs2::ConstraintOrder::Linear),
+        linearApproximation_(ocs2::VectorFunctionLinearApproximation::Zero(numConstraints, stateDim, inputDim)) {
+    linearApproximation_.f.setRandom();
+    linearApproximation_.dfdx.setRandom();
+    linearApproximation_.dfdu.setRandom();
+  }
+  ~RandomLinearConstraint() override = default;
+  RandomLinearConstraint* clone() const override { return new RandomLinearConstraint(*this); }
+
+  size_t getNumConstraints(ocs2::scalar_t time) const override { return linearApproximation_.f.size(); }
+  ocs2::vector_t getValue(ocs2::scalar_t time, const ocs2::vector_t& state, const ocs2::vector_t& input,
+                          const ocs2::PreComputation&) const override {
+    return linearApproximation_.f;
+  }
+  ocs2::VectorFunctionLinearApproximation getLinearApproximation(ocs2::scalar_t time, const ocs2::vector_t& state,
+                                                                 const ocs2::vector_t& input, const ocs2::PreComputation&) const override {
+    return linearApproximation_;
+  }
+
+ private:
+  ocs2::VectorFunctionLinearApproximation linearApproximation_;
+};
+
+/** Collection with terms that override accumulateQuadraticApproximation and a term that uses the default implementation. */
+class AccumulateCost_TestFixture : public ::testing::Test {
+ public:
+  const size_t STATE_DIM = 24;
+  const size_t INPUT_DIM = 12;
+
+  AccumulateCost_TestFixture() {
+    ocs2::matrix_t Q = ocs2::matrix_t::Random(STATE_DIM, STATE_DIM);
+    ocs2::matrix_t R = ocs2::matrix_t::Random(INPUT_DIM, INPUT_DIM);
+    ocs2::matrix_t P = ocs2::matrix_t::Random(INPUT_DIM, STATE_DIM);
+    Q = (Q + Q.transpose()).eval();
+    R = (R + R.transpose()).eval();
+
+    x = ocs2::vector_t::Random(STATE_DIM);
+    u = ocs2::vector_t::Random(INPUT_DIM);
+    t = 0.0;
+    targetTrajectories = ocs2::TargetTrajectories({t}, {ocs2::vector_t::Random(STATE_DIM)}, {ocs2::vector_t::Random(INPUT_DIM)});
+
+    std::vector<ocs2::StateInputSoftBoxConstraint::BoxConstraint> stateBoxConstraints(STATE_DIM / 2);
+    for (size_t i = 0; i < stateBoxConstraints.size(); ++i) {
+      stateBoxConstraints[i].index = 2 * i;
+      stateBoxConstraints[i].lowerBound = -0.5;
+      stateBoxConstraints[i].upperBound = 0.5;
+      stateBoxConstraints[i].penaltyPtr.reset(new ocs2::RelaxedBarrierPenalty({0.1, 0.1}));
+    }
+    std::vector<ocs2::StateInputSoftBoxConstraint::BoxConstraint> inputBoxConstraints(1);
+    inputBoxConstraints[0].index = INPUT_DIM - 1;
+    inputBoxConstraints[0].lowerBound = -0.2;
+    inputBoxConstraints[0].penaltyPtr.reset(new ocs2::RelaxedBarrierPenalty({0.1, 0.1}));
+
+    costCollection.add("quadratic", std::make_unique<ocs2::QuadraticStateInputCost>(Q, R, P));
+    costCollection.add("soft constraint",
+                       std::make_unique<ocs2::StateInputSoftConstraint>(std::make_unique<RandomLinearConstraint>(6, STATE_DIM, INPUT_DIM),
+                                                                        std::make_unique<ocs2::RelaxedBarrierPenalty>(
+                                                                            ocs2::RelaxedBarrierPenalty::Config{1.0, 0.1})));
+    costCollection.add("box constraint",
+                       std::make_unique<ocs2::StateInputSoftBoxConstraint>(std::move(stateBoxConstraints), std::move(inputBoxConstraints)));
+    costCollection.add("default accumulate", std::make_unique<SimpleQuadraticCost>(Q, R));
+  }
+
+  /** Sums the approximations returned by getQuadraticApproximation, i.e., the reference without accumulation in place. */
+  ocs2::ScalarFunctionQuadraticApproximation getSumOfTermApproximations() {
+    auto sum = ocs2::ScalarFunctionQuadraticApproximation::Zero(STATE_DIM, INPUT_DIM);
+    for (const auto& name : {"quadratic", "soft constraint", "box constraint", "default accumulate"}) {
+      sum += costCollection.get(name).getQuadraticApproximation(t, x, u, targetTrajectories, {});
+    }
+    return sum;
+  }
+
+  ocs2::TargetTrajectories targetTrajectories;
+  ocs2::StateInputCostCollection costCollection;
+
+  ocs2::vector_t x;
+  ocs2::vector_t u;
+  ocs2::scalar_t t;
+};
+
+TEST_F(AccumulateCost_TestFixture, accumulateEqualsSumOfApproximations) {
+  const auto expected = getSumOfTermApproximations();
+  const auto cost = costCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  EXPECT_NEAR(cost.f, expected.f, 1e-9);
+  EXPECT_NEAR(cost.f, costCollection.getValue(t, x, u, targetTrajectories, {}), 1e-9);
+  EXPECT_TRUE(cost.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(cost.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(cost.dfdxx.isApprox(expected.dfdxx));
+  EXPECT_TRUE(cost.dfduu.isApprox(expected.dfduu));
+  EXPECT_TRUE(cost.dfdux.isApprox(expected.dfdux));
+}
+
 class SimpleQuadraticFinalCost final : public ocs2::StateCost {
  public:
   SimpleQuadraticFinalCost(ocs2::matrix_t Q) : Q_(std::move(Q)) {}
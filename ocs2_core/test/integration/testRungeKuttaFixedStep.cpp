@@ -0,0 +1,152 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/RungeKuttaFixedStep.h>
+
+using namespace ocs2;
+
+namespace {
+
+class LinearSystem final : public OdeBase {
+ public:
+  ~LinearSystem() override = default;
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override {
+    const matrix_t A = (matrix_t(2, 2) << -2, -1,  // clang-format off
+                                           1,  0).finished();  // clang-format on
+    const vector_t B = (vector_t(2) << 1, 0).finished();
+    return A * x + B * std::sin(t);
+  }
+};
+
+const std::vector<std::pair<IntegratorType, IntegratorType>> fixedStepAndBoostTypes{
+    {IntegratorType::EULER_OCS2, IntegratorType::EULER}, {IntegratorType::RK4_OCS2, IntegratorType::RK4}};
+
+}  // namespace
+
+TEST(RungeKuttaFixedStepTest, IntegrateConstCompareWithBoost) {
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 5.0;
+  const scalar_t dt = 0.01;
+  const vector_t x0 = (vector_t(2) << 1.0, -1.0).finished();
+  LinearSystem sys;
+
+  for (const auto& types : fixedStepAndBoostTypes) {
+    scalar_array_t tTraj, tTraj_boost;
+    vector_array_t xTraj, xTraj_boost;
+    Observer observer(&xTraj, &tTraj);
+    Observer observer_boost(&xTraj_boost, &tTraj_boost);
+    newIntegrator(types.first)->integrateConst(sys, observer, x0, t0, t1, dt);
+    newIntegrator(types.second)->integrateConst(sys, observer_boost, x0, t0, t1, dt);
+
+    ASSERT_EQ(tTraj.size(), tTraj_boost.size());
+    for (size_t i = 0; i < tTraj.size(); i++) {
+      EXPECT_NEAR(tTraj[i], tTraj_boost[i], 1e-9);
+      EXPECT_TRUE(xTraj[i].isApprox(xTraj_boost[i], 1e-9));
+    }
+  }
+}
+
+TEST(RungeKuttaFixedStepTest, IntegrateAdaptiveCompareWithBoost) {
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 5.005;  // not a multiple of dt
+  const scalar_t dt = 0.01;
+  const vector_t x0 = (vector_t(2) << 1.0, -1.0).finished();
+  LinearSystem sys;
+
+  for (const auto& types : fixedStepAndBoostTypes) {
+    scalar_array_t tTraj, tTraj_boost;
+    vector_array_t xTraj, xTraj_boost;
+    Observer observer(&xTraj, &tTraj);
+    Observer observer_boost(&xTraj_boost, &tTraj_boost);
+    newIntegrator(types.first)->integrateAdaptive(sys, observer, x0, t0, t1, dt);
+    newIntegrator(types.second)->integrateAdaptive(sys, observer_boost, x0, t0, t1, dt);
+
+    ASSERT_EQ(tTraj.size(), tTraj_boost.size());
+    EXPECT_DOUBLE_EQ(tTraj.back(), t1);
+    for (size_t i = 0; i < tTraj.size(); i++) {
+      EXPECT_NEAR(tTraj[i], tTraj_boost[i], 1e-9);
+      EXPECT_TRUE(xTraj[i].isApprox(xTraj_boost[i], 1e-9));
+    }
+  }
+}
+
+TEST(RungeKuttaFixedStepTest, IntegrateTimes) {
+  const scalar_t dt = 0.01;
+  const vector_t x0 = (vector_t(2) << 1.0, -1.0).finished();
+  const scalar_array_t times{0.0, 0.5, 1.234, 2.0, 3.0};
+  LinearSystem sys;
+
+  vector_array_t xTraj, xTraj_reference;
+  Observer observer(&xTraj);
+  Observer observer_reference(&xTraj_reference);
+  newIntegrator(IntegratorType::RK4_OCS2)->integrateTimes(sys, observer, x0, times.begin(), times.end(), dt);
+  newIntegrator(IntegratorType::ODE45)->integrateTimes(sys, observer_reference, x0, times.begin(), times.end(), dt, 1e-12, 1e-12);
+
+  ASSERT_EQ(xTraj.size(), times.size());
+  for (size_t i = 0; i < times.size(); i++) {
+    EXPECT_TRUE(xTraj[i].isApprox(xTraj_reference[i], 1e-6));
+  }
+}
+
+TEST(RungeKuttaFixedStepTest, DenseOutput) {
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 1.0;
+  const scalar_t dt = 0.05;
+  const vector_t x0 = (vector_t(2) << 1.0, -1.0).finished();
+  LinearSystem sys;
+
+  RungeKuttaFixedStep integrator(RungeKuttaFixedStep::Scheme::RK4);
+  EXPECT_ANY_THROW({
+    vector_t x;
+    integrator.getDenseOutput(0.0, x);
+  });
+
+  vector_array_t xTraj;
+  Observer observer(&xTraj);
+  integrator.integrateAdaptive(sys, observer, x0, t0, t1, dt);
+
+  // End points of the last step
+  vector_t x;
+  integrator.getDenseOutput(t1, x);
+  EXPECT_TRUE(x.isApprox(xTraj.back(), 1e-12));
+  integrator.getDenseOutput(t1 - dt, x);
+  EXPECT_TRUE(x.isApprox(xTraj[xTraj.size() - 2], 1e-12));
+
+  // Inside the last step, compared with an accurate solution
+  const scalar_t tQuery = t1 - 0.3 * dt;
+  integrator.getDenseOutput(tQuery, x);
+  vector_array_t xTraj_reference;
+  Observer observer_reference(&xTraj_reference);
+  const scalar_array_t times{t0, tQuery};
+  newIntegrator(IntegratorType::ODE45)->integrateTimes(sys, observer_reference, x0, times.begin(), times.end(), dt, 1e-12, 1e-12);
+  EXPECT_TRUE(x.isApprox(xTraj_reference.back(), 1e-6));
+}
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/Integrator.h"
 #include "ocs2_core/integration/SensitivityIntegrator.h"
+#include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
@@ -210,3 +211,222 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
 }
+
+namespace {
+/** Linear spring-damper with a stiff contact spring, x = [position, velocity], counts the evaluations of its linear approximation */
+class StiffSystem final : public ocs2::SystemDynamicsBase {
+ public:
+  StiffSystem() {
+    A_ << 0.0, 1.0,  // clang-format off
+         -1e4, -20.0;  // clang-format on
+    B_ << 0.0, 1.0;
+  }
+  StiffSystem* clone() const override { return new StiffSystem(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    return A_ * x + B_ * u;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation&) override {
+    ++numLinearApproximations;
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = A_ * x + B_ * u;
+    approximation.dfdx = A_;
+    approximation.dfdu = B_;
+    return approximation;
+  }
+
+  size_t numLinearApproximations = 0;
+
+ private:
+  Eigen::Matrix2d A_;
+  Eigen::Vector2d B_;
+};
+
+/** Van der Pol oscillator, x = [position, velocity], stiff for a large mu */
+class VanDerPol final : public ocs2::SystemDynamicsBase {
+ public:
+  explicit VanDerPol(ocs2::scalar_t mu) : mu_(mu) {}
+  VanDerPol* clone() const override { return new VanDerPol(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    ocs2::vector_t dxdt(2);
+    dxdt << x(1), mu_ * (1.0 - x(0) * x(0)) * x(1) - x(0) + u(0);
+    return dxdt;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx.resize(2, 2);
+    approximation.dfdx << 0.0, 1.0, -2.0 * mu_ * x(0) * x(1) - 1.0, mu_ * (1.0 - x(0) * x(0));
+    approximation.dfdu.resize(2, 1);
+    approximation.dfdu << 0.0, 1.0;
+    return approximation;
+  }
+
+ private:
+  ocs2::scalar_t mu_;
+};
+
+/** Cubic decay dx/dt = -k * x^3 + u, Newton's method converges slowly from an explicit Euler prediction far off the solution */
+class CubicDecay final : public ocs2::SystemDynamicsBase {
+ public:
+  explicit CubicDecay(ocs2::scalar_t k) : k_(k) {}
+  CubicDecay* clone() const override { return new CubicDecay(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    return -k_ * x.array().cube().matrix() + u;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx = -3.0 * k_ * x.array().square().matrix().asDiagonal();
+    approximation.dfdu = ocs2::matrix_t::Identity(1, 1);
+    return approximation;
+  }
+
+ private:
+  ocs2::scalar_t k_;
+};
+}  // namespace
+
+TEST(test_sensitivity_integrator, implicitMidpointLinear) {
+  auto system = getSystem();
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t dt = 0.1;
+
+  // For linear dynamics the implicit midpoint rule is the Cayley transform
+  const auto continuous = system->linearApproximation(t, x, u, ocs2::PreComputation());
+  const ocs2::matrix_t I = ocs2::matrix_t::Identity(2, 2);
+  const ocs2::matrix_t implicitPart = (I - 0.5 * dt * continuous.dfdx).inverse();
+  const ocs2::matrix_t A = implicitPart * (I + 0.5 * dt * continuous.dfdx);
+  const ocs2::matrix_t B = dt * implicitPart * continuous.dfdu;
+
+  const auto type = ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT;
+  const auto forwardDynamics = ocs2::selectDynamicsDiscretization(type)(*system, t, x, u, dt);
+  const auto linearizedDynamics = ocs2::selectDynamicsSensitivityDiscretization(type)(*system, t, x, u, dt);
+  EXPECT_TRUE(forwardDynamics.isApprox(A * x + B * u));
+  EXPECT_TRUE(linearizedDynamics.f.isApprox(A * x + B * u));
+  EXPECT_TRUE(linearizedDynamics.dfdx.isApprox(A));
+  EXPECT_TRUE(linearizedDynamics.dfdu.isApprox(B));
+}
+
+TEST(test_sensitivity_integrator, implicitMidpointNonlinear) {
+  VanDerPol system(10.0);
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 1.5, -0.5).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 0.3).finished();
+  const ocs2::scalar_t dt = 0.05;
+
+  const auto linearizedDynamics = ocs2::implicitMidpointSensitivityDiscretization(system, t, x, u, dt);
+  const ocs2::vector_t forwardDynamics = ocs2::implicitMidpointDiscretization(system, t, x, u, dt);
+  EXPECT_TRUE(linearizedDynamics.f.isApprox(forwardDynamics));
+
+  // The implicit equation is satisfied
+  const ocs2::vector_t midpoint = 0.5 * (x + forwardDynamics);
+  EXPECT_TRUE(forwardDynamics.isApprox(x + dt * system.computeFlowMap(t + 0.5 * dt, midpoint, u, ocs2::PreComputation())));
+
+  // Sensitivities against central finite differences
+  const ocs2::scalar_t eps = 1e-6;
+  auto discretization = [&](const ocs2::vector_t& xk, const ocs2::vector_t& uk) {
+    return ocs2::implicitMidpointDiscretization(system, t, xk, uk, dt);
+  };
+  ocs2::matrix_t A(2, 2), B(2, 1);
+  for (int i = 0; i < 2; ++i) {
+    const ocs2::vector_t dx = eps * ocs2::vector_t::Unit(2, i);
+    A.col(i) = (discretization(x + dx, u) - discretization(x - dx, u)) / (2.0 * eps);
+  }
+  const ocs2::vector_t du = eps * ocs2::vector_t::Ones(1);
+  B.col(0) = (discretization(x, u + du) - discretization(x, u - du)) / (2.0 * eps);
+  EXPECT_TRUE(linearizedDynamics.dfdx.isApprox(A, 1e-6));
+  EXPECT_TRUE(linearizedDynamics.dfdu.isApprox(B, 1e-6));
+}
+
+TEST(test_sensitivity_integrator, implicitMidpointNotConverged) {
+  // The explicit Euler prediction lands far from the midpoint and Newton's method runs out of iterations
+  CubicDecay system(1e6);
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(1);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+  const ocs2::scalar_t dt = 1.0;
+
+  EXPECT_THROW(ocs2::implicitMidpointDiscretization(system, t, x, u, dt), std::runtime_error);
+  EXPECT_THROW(ocs2::implicitMidpointSensitivityDiscretization(system, t, x, u, dt), std::runtime_error);
+}
+
+TEST(test_sensitivity_integrator, rk4AdaptiveNonStiff) {
+  auto system = getSystem();
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t dt = 0.1;
+
+  // A single step, identical to RK4
+  const auto rk4 = ocs2::rk4SensitivityDiscretization(*system, t, x, u, dt);
+  const auto adaptive = ocs2::rk4AdaptiveSensitivityDiscretization(*system, t, x, u, dt);
+  EXPECT_TRUE(adaptive.f.isApprox(rk4.f));
+  EXPECT_TRUE(adaptive.dfdx.isApprox(rk4.dfdx));
+  EXPECT_TRUE(adaptive.dfdu.isApprox(rk4.dfdu));
+  EXPECT_TRUE(ocs2::rk4AdaptiveDiscretization(*system, t, x, u, dt).isApprox(rk4.f));
+}
+
+TEST(test_sensitivity_integrator, rk4Substeps) {
+  VanDerPol system(1.0);
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 1.5, -0.5).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 0.3).finished();
+  const ocs2::scalar_t dt = 0.1;
+
+  // Two substeps are the composition of two RK4 steps
+  const auto first = ocs2::rk4SensitivityDiscretization(system, t, x, u, 0.5 * dt);
+  const auto second = ocs2::rk4SensitivityDiscretization(system, t + 0.5 * dt, first.f, u, 0.5 * dt);
+  const auto substeps = ocs2::rk4SubstepSensitivityDiscretization(system, t, x, u, dt, 2);
+  EXPECT_TRUE(substeps.f.isApprox(second.f));
+  EXPECT_TRUE(substeps.dfdx.isApprox(second.dfdx * first.dfdx));
+  EXPECT_TRUE(substeps.dfdu.isApprox(second.dfdx * first.dfdu + second.dfdu));
+  EXPECT_TRUE(ocs2::rk4SubstepDiscretization(system, t, x, u, dt, 2).isApprox(second.f));
+}
+
+/** Accuracy versus cost of the discretizations for a stiff system, the reference is RK4 with a small step. */
+TEST(test_sensitivity_integrator, stiffSystem) {
+  StiffSystem system;
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.01, 0.0).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 1.0).finished();
+
+  using ocs2::SensitivityIntegratorType;
+  const std::vector<SensitivityIntegratorType> types{SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2,
+                                                     SensitivityIntegratorType::RK4, SensitivityIntegratorType::IMPLICIT_MIDPOINT,
+                                                     SensitivityIntegratorType::RK4_ADAPTIVE};
+  std::cerr << "[test_sensitivity_integrator] Stiff system, error of A_k and number of linearizations per interval:\n";
+  for (const ocs2::scalar_t dt : {0.001, 0.005, 0.02, 0.05}) {
+    const auto reference = ocs2::rk4SubstepSensitivityDiscretization(system, t, x, u, dt, 1000);
+    std::cerr << "\tdt = " << dt;
+    for (const auto type : types) {
+      system.numLinearApproximations = 0;
+      const auto linearizedDynamics = ocs2::selectDynamicsSensitivityDiscretization(type)(system, t, x, u, dt);
+      const ocs2::scalar_t error = (linearizedDynamics.dfdx - reference.dfdx).lpNorm<Eigen::Infinity>();
+      std::cerr << "\t" << ocs2::sensitivity_integrator::toString(type) << ": " << error << " (" << system.numLinearApproximations << ")";
+
+      if (type == SensitivityIntegratorType::RK4_ADAPTIVE) {
+        // The substeps keep RK4 accurate
+        EXPECT_LT(error, 1e-2 * reference.dfdx.lpNorm<Eigen::Infinity>());
+      } else if (type == SensitivityIntegratorType::IMPLICIT_MIDPOINT) {
+        // A-stable, the discrete system does not grow
+        EXPECT_LE(linearizedDynamics.dfdx.eigenvalues().cwiseAbs().maxCoeff(), 1.0);
+      }
+    }
+    std::cerr << "\n";
+  }
+
+  // RK4 is unstable for the largest step
+  const auto rk4 = ocs2::rk4SensitivityDiscretization(system, t, x, u, 0.05);
+  EXPECT_GT(rk4.dfdx.eigenvalues().cwiseAbs().maxCoeff(), 1.0);
+}
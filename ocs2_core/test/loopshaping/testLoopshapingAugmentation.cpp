@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
+
+#include "testLoopshapingConfigurations.h"
+
+using namespace ocs2;
+
+namespace {
+
+ScalarFunctionQuadraticApproximation getRandomSystemApproximation(size_t stateDim, size_t inputDim) {
+  ScalarFunctionQuadraticApproximation L;
+  L.f = 1.0;
+  L.dfdx.setRandom(stateDim);
+  L.dfdu.setRandom(inputDim);
+  const matrix_t H = matrix_t::Random(stateDim + inputDim, stateDim + inputDim);
+  const matrix_t HtH = H.transpose() * H;
+  L.dfdxx = HtH.topLeftCorner(stateDim, stateDim);
+  L.dfdux = HtH.bottomLeftCorner(inputDim, stateDim);
+  L.dfduu = HtH.bottomRightCorner(inputDim, inputDim);
+  return L;
+}
+
+/** Reference implementation with the dense map T from the augmented state and input to the system state and input. */
+ScalarFunctionQuadraticApproximation denseEliminatePatternApproximation(const LoopshapingDefinition& loopshapingDefinition,
+                                                                        const ScalarFunctionQuadraticApproximation& L_system) {
+  const auto& filter = loopshapingDefinition.getInputFilter();
+  const size_t sysStateDim = L_system.dfdx.rows();
+  const size_t sysInputDim = L_system.dfdu.rows();
+  const size_t stateDim = sysStateDim + filter.getNumStates();
+  const size_t inputDim = filter.getNumInputs();
+
+  // [x_system; u_system] = T * [x; u]
+  matrix_t T = matrix_t::Zero(sysStateDim + sysInputDim, stateDim + inputDim);
+  T.topLeftCorner(sysStateDim, sysStateDim).setIdentity();
+  T.bottomRightCorner(sysInputDim, filter.getNumStates() + inputDim) = filter.getCD();
+
+  vector_t g_system(sysStateDim + sysInputDim);
+  g_system << L_system.dfdx, L_system.dfdu;
+  matrix_t H_system(sysStateDim + sysInputDim, sysStateDim + sysInputDim);
+  H_system << L_system.dfdxx, L_system.dfdux.transpose(), L_system.dfdux, L_system.dfduu;
+
+  const vector_t g = T.transpose() * g_system;
+  const matrix_t H = T.transpose() * H_system * T;
+
+  ScalarFunctionQuadraticApproximation L;
+  L.f = L_system.f;
+  L.dfdx = g.head(stateDim);
+  L.dfdu = g.tail(inputDim);
+  L.dfdxx = H.topLeftCorner(stateDim, stateDim);
+  L.dfdux = H.bottomLeftCorner(inputDim, stateDim);
+  L.dfduu = H.bottomRightCorner(inputDim, inputDim);
+  return L;
+}
+
+}  // namespace
+
+TEST(testLoopshapingAugmentation, eliminatePatternEqualToDense) {
+  for (const auto config : configNames) {
+    const auto loopshapingDefinition = loopshaping_property_tree::load(getAbsolutePathToConfigurationFile(config));
+    if (loopshapingDefinition->getType() != LoopshapingType::eliminatepattern) {
+      continue;
+    }
+    const auto L_system = getRandomSystemApproximation(3, loopshapingDefinition->getInputFilter().getNumOutputs());
+
+    ScalarFunctionQuadraticApproximation L;
+    L.f = L_system.f;
+    loopshaping_augmentation::eliminatePatternQuadraticApproximation(*loopshapingDefinition, L_system, L);
+    const auto L_dense = denseEliminatePatternApproximation(*loopshapingDefinition, L_system);
+
+    EXPECT_TRUE(L.dfdx.isApprox(L_dense.dfdx));
+    EXPECT_TRUE(L.dfdu.isApprox(L_dense.dfdu));
+    EXPECT_TRUE(L.dfdxx.isApprox(L_dense.dfdxx));
+    EXPECT_TRUE(L.dfdux.isApprox(L_dense.dfdux));
+    EXPECT_TRUE(L.dfduu.isApprox(L_dense.dfduu));
+  }
+}
+
+TEST(testLoopshapingAugmentation, outputPatternCostMatrices) {
+  for (const auto config : configNames) {
+    const auto loopshapingDefinition = loopshaping_property_tree::load(getAbsolutePathToConfigurationFile(config));
+    if (loopshapingDefinition->getType() != LoopshapingType::outputpattern) {
+      continue;
+    }
+    const auto& filter = loopshapingDefinition->getInputFilter();
+    const matrix_t R = matrix_t::Identity(filter.getNumOutputs(), filter.getNumOutputs()) +
+                       matrix_t::Constant(filter.getNumOutputs(), filter.getNumOutputs(), 0.5);
+    loopshapingDefinition->setCostMatrix(R);
+
+    EXPECT_TRUE(loopshapingDefinition->getCostMatrixCC().isApprox(filter.getC().transpose() * R * filter.getC()));
+    EXPECT_TRUE(loopshapingDefinition->getCostMatrixDC().isApprox(filter.getD().transpose() * R * filter.getC()));
+    EXPECT_TRUE(loopshapingDefinition->getCostMatrixDD().isApprox(filter.getD().transpose() * R * filter.getD()));
+  }
+}
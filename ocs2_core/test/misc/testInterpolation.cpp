@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
+#include <random>
 
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <Eigen/Dense>
@@ -132,3 +134,75 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+namespace {
+/** A solver-like time grid: random steps with duplicated event times. */
+std::vector<double> getTimeGridWithEvents(size_t numSteps, std::mt19937& generator) {
+  std::uniform_real_distribution<double> stepDistribution(0.001, 0.02);
+  std::bernoulli_distribution eventDistribution(0.1);
+  std::vector<double> time{0.0};
+  for (size_t i = 1; i < numSteps; i++) {
+    if (eventDistribution(generator)) {
+      time.push_back(time.back());
+    }
+    time.push_back(time.back() + stepDistribution(generator));
+  }
+  return time;
+}
+}  // namespace
+
+TEST(testLinearInterpolation, testTimeSegmentLookupEquivalence) {
+  std::mt19937 generator(0);
+  auto expectEqual = [](const ocs2::LinearInterpolation::index_alpha_t& lhs, const ocs2::LinearInterpolation::index_alpha_t& rhs) {
+    ASSERT_EQ(lhs.first, rhs.first);
+    ASSERT_EQ(lhs.second, rhs.second);
+  };
+
+  std::vector<std::vector<double>> timeArrays = {{}, {1.0}, {1.0, 1.0}, {0.0, 1.0, 1.0, 2.0}, {0.0, 0.0, 0.0, 1.0, 1.0}};
+  for (size_t numSteps : {2, 10, 100, 1000}) {
+    timeArrays.push_back(getTimeGridWithEvents(numSteps, generator));
+  }
+
+  for (const auto& time : timeArrays) {
+    // Queries: every time point, midpoints, and random times before, inside and after the array
+    std::vector<double> queries;
+    const double startTime = time.empty() ? 0.0 : time.front();
+    const double finalTime = time.empty() ? 1.0 : time.back();
+    for (size_t i = 0; i < time.size(); i++) {
+      queries.push_back(time[i]);
+      if (i + 1 < time.size()) {
+        queries.push_back(0.5 * (time[i] + time[i + 1]));
+      }
+    }
+    std::uniform_real_distribution<double> queryDistribution(startTime - 0.1, finalTime + 0.1);
+    for (size_t i = 0; i < 100; i++) {
+      queries.push_back(queryDistribution(generator));
+    }
+
+    // Random order
+    for (size_t numBuckets : {0, 1, 3, 1000}) {
+      const ocs2::LinearInterpolation::TimeSegmentTable table(time, numBuckets);
+      ocs2::LinearInterpolation::TimeSegmentCursor cursor(time);
+      for (const auto query : queries) {
+        const auto expected = ocs2::LinearInterpolation::timeSegment(query, time);
+        expectEqual(table.timeSegment(query), expected);
+        expectEqual(cursor.timeSegment(query), expected);
+      }
+    }
+
+    // Monotone order, forward and backward
+    std::sort(queries.begin(), queries.end());
+    ocs2::LinearInterpolation::TimeSegmentCursor forwardCursor(time);
+    for (auto it = queries.begin(); it != queries.end(); ++it) {
+      expectEqual(forwardCursor.timeSegment(*it), ocs2::LinearInterpolation::timeSegment(*it, time));
+    }
+    ocs2::LinearInterpolation::TimeSegmentCursor backwardCursor(time);
+    for (auto it = queries.rbegin(); it != queries.rend(); ++it) {
+      expectEqual(backwardCursor.timeSegment(*it), ocs2::LinearInterpolation::timeSegment(*it, time));
+    }
+  }
+
+  // Default constructed table
+  const ocs2::LinearInterpolation::TimeSegmentTable emptyTable;
+  expectEqual(emptyTable.timeSegment(1.0), ocs2::LinearInterpolation::timeSegment(1.0, {}));
+}
@@ -4,8 +4,11 @@
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
 
+#include <fstream>
+
 #include <boost/filesystem.hpp>
 
 namespace {
@@ -54,4 +57,65 @@ TEST(testLoadPair, loadStringSizePair) {
   EXPECT_EQ(loadVector[0].second, 2);
   EXPECT_EQ(loadVector[1].first, "s3");
   EXPECT_EQ(loadVector[1].second, 4);
-}
\ No newline at end of file
+}
+class testPropertyTreeCache : public ::testing::Test {
+ protected:
+  testPropertyTreeCache()
+      : filename_((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%%%%%.info")).string()) {
+    writeFile("settings\n{\n  value 1.0\n}\n");
+  }
+
+  ~testPropertyTreeCache() override { boost::filesystem::remove(filename_); }
+
+  void writeFile(const std::string& content) const {
+    std::ofstream file(filename_);
+    file << content;
+  }
+
+  const std::string filename_;
+};
+
+TEST_F(testPropertyTreeCache, parsedOnce) {
+  const auto ptPtr = ocs2::loadData::getPropertyTree(filename_);
+  EXPECT_EQ(ocs2::loadData::getPropertyTree(filename_), ptPtr);
+  EXPECT_DOUBLE_EQ(ptPtr->get<double>("settings.value"), 1.0);
+
+  ocs2::loadData::clearPropertyTreeCache();
+  EXPECT_NE(ocs2::loadData::getPropertyTree(filename_), ptPtr);
+}
+
+TEST_F(testPropertyTreeCache, modifiedFile) {
+  double value = 0.0;
+  ocs2::loadData::loadCppDataType(filename_, "settings.value", value);
+  EXPECT_DOUBLE_EQ(value, 1.0);
+
+  writeFile("settings\n{\n  value 2.5\n  other 3\n}\n");
+  ocs2::loadData::loadCppDataType(filename_, "settings.value", value);
+  EXPECT_DOUBLE_EQ(value, 2.5);
+
+  boost::filesystem::remove(filename_);
+  EXPECT_THROW(ocs2::loadData::getPropertyTree(filename_), boost::property_tree::info_parser_error);
+}
+
+TEST_F(testPropertyTreeCache, configLoader) {
+  writeFile(
+      "settings\n{\n  value 2.5\n  flag true\n  vector\n  {\n    [0] 1\n    [1] 2\n  }\n"
+      "  matrix\n  {\n    scaling 2.0\n    (0,0) 1.0\n    (1,1) 3.0\n  }\n}\n");
+
+  double value = 0.0;
+  bool flag = false;
+  int missing = -1;
+  std::vector<int> vector;
+  Eigen::Matrix2d matrix;
+  ocs2::loadData::ConfigLoader loader(filename_, "settings");
+  loader.load("value", value).load("flag", flag).load("missing", missing).loadVector("vector", vector).loadMatrix("matrix", matrix);
+
+  EXPECT_DOUBLE_EQ(value, 2.5);
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(missing, -1);
+  EXPECT_EQ(vector, std::vector<int>({1, 2}));
+  EXPECT_TRUE(matrix.isApprox((Eigen::Matrix2d() << 2.0, 0.0, 0.0, 6.0).finished()));
+
+  EXPECT_THROW(loader.loadRequired("missing", missing), boost::property_tree::ptree_bad_path);
+  EXPECT_ANY_THROW(loader.loadMatrix("missing", matrix));
+}
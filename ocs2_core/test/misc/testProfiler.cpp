@@ -0,0 +1,202 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/Profiler.h>
+
+using namespace ocs2;
+
+namespace {
+const profiler::ZoneStatistics* findZone(const std::vector<profiler::ZoneStatistics>& statistics, const std::string& name) {
+  for (const auto& zoneStatistics : statistics) {
+    if (zoneStatistics.name == name) {
+      return &zoneStatistics;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+class TestProfiler : public testing::Test {
+ protected:
+  TestProfiler() {
+    profiler::clear();
+    profiler::setEnabled(true);
+  }
+  ~TestProfiler() override {
+    profiler::setEnabled(false);
+    profiler::clear();
+  }
+};
+
+TEST_F(TestProfiler, registerZone) {
+  const auto zoneA = profiler::registerZone("TestProfiler::a");
+  const auto zoneB = profiler::registerZone("TestProfiler::b");
+  EXPECT_NE(zoneA, zoneB);
+  EXPECT_EQ(profiler::registerZone("TestProfiler::a"), zoneA);
+  EXPECT_EQ(profiler::getZoneName(zoneB), "TestProfiler::b");
+}
+
+TEST_F(TestProfiler, disabled) {
+  profiler::setEnabled(false);
+  for (int i = 0; i < 10; ++i) {
+    OCS2_PROFILE_ZONE("TestProfiler::disabled");
+  }
+  EXPECT_EQ(findZone(profiler::getStatistics(), "TestProfiler::disabled"), nullptr);
+}
+
+TEST_F(TestProfiler, statistics) {
+  const auto zoneId = profiler::registerZone("TestProfiler::sleep");
+  for (int i = 1; i <= 10; ++i) {
+    profiler::ScopedZone zone(zoneId);
+    std::this_thread::sleep_for(std::chrono::milliseconds(i));
+  }
+
+  const auto statistics = profiler::getStatistics();
+  const auto* zoneStatisticsPtr = findZone(statistics, "TestProfiler::sleep");
+  ASSERT_NE(zoneStatisticsPtr, nullptr);
+  EXPECT_EQ(zoneStatisticsPtr->count, 10);
+  EXPECT_GE(zoneStatisticsPtr->max, 10.0);
+  EXPECT_GE(zoneStatisticsPtr->total, 55.0);
+  EXPECT_LE(zoneStatisticsPtr->median, zoneStatisticsPtr->percentile90);
+  EXPECT_LE(zoneStatisticsPtr->percentile90, zoneStatisticsPtr->percentile99);
+  EXPECT_LE(zoneStatisticsPtr->percentile99, zoneStatisticsPtr->max);
+  // nearest rank: the median of 1..10 ms is the 5th sample
+  EXPECT_GE(zoneStatisticsPtr->median, 5.0);
+  EXPECT_LT(zoneStatisticsPtr->median, 6.0);
+
+  profiler::clear();
+  EXPECT_EQ(findZone(profiler::getStatistics(), "TestProfiler::sleep"), nullptr);
+}
+
+TEST_F(TestProfiler, multipleThreads) {
+  constexpr int numThreads = 4;
+  constexpr int numZonesPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < numZonesPerThread; ++j) {
+        OCS2_PROFILE_ZONE("TestProfiler::thread");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The events of finished threads are kept
+  auto statistics = profiler::getStatistics();
+  const auto* zoneStatisticsPtr = findZone(statistics, "TestProfiler::thread");
+  ASSERT_NE(zoneStatisticsPtr, nullptr);
+  EXPECT_EQ(zoneStatisticsPtr->count, numThreads * numZonesPerThread);
+  EXPECT_EQ(profiler::getNumDroppedEvents(), 0);
+
+  // The buffers of finished threads are released by clear()
+  profiler::clear();
+  EXPECT_EQ(findZone(profiler::getStatistics(), "TestProfiler::thread"), nullptr);
+  std::thread([]() { OCS2_PROFILE_ZONE("TestProfiler::thread"); }).join();
+  statistics = profiler::getStatistics();
+  zoneStatisticsPtr = findZone(statistics, "TestProfiler::thread");
+  ASSERT_NE(zoneStatisticsPtr, nullptr);
+  EXPECT_EQ(zoneStatisticsPtr->count, 1);
+}
+
+TEST_F(TestProfiler, eventsPerThread) {
+  const size_t defaultEventsPerThread = profiler::getEventsPerThread();
+  EXPECT_THROW(profiler::setEventsPerThread(0), std::runtime_error);
+
+  // The new capacity applies after clear()
+  profiler::setEventsPerThread(10);
+  profiler::clear();
+  for (int i = 0; i < 15; ++i) {
+    OCS2_PROFILE_ZONE("TestProfiler::capacity");
+  }
+  const auto statistics = profiler::getStatistics();
+  const auto* zoneStatisticsPtr = findZone(statistics, "TestProfiler::capacity");
+  ASSERT_NE(zoneStatisticsPtr, nullptr);
+  EXPECT_EQ(zoneStatisticsPtr->count, 10);
+  EXPECT_EQ(profiler::getNumDroppedEvents(), 5);
+
+  // The buffers are released while the profiler is disabled and reallocated by the next event
+  profiler::setEventsPerThread(defaultEventsPerThread);
+  profiler::setEnabled(false);
+  profiler::clear();
+  profiler::setEnabled(true);
+  for (int i = 0; i < 15; ++i) {
+    OCS2_PROFILE_ZONE("TestProfiler::capacity");
+  }
+  EXPECT_EQ(findZone(profiler::getStatistics(), "TestProfiler::capacity")->count, 15);
+  EXPECT_EQ(profiler::getNumDroppedEvents(), 0);
+}
+
+TEST_F(TestProfiler, chromeTrace) {
+  {
+    OCS2_PROFILE_ZONE("TestProfiler::\"outer\"");
+    OCS2_PROFILE_ZONE("TestProfiler::inner");
+  }
+
+  std::stringstream trace;
+  profiler::writeChromeTrace(trace);
+  const std::string traceString = trace.str();
+  EXPECT_EQ(traceString.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+  EXPECT_NE(traceString.find("\"name\":\"TestProfiler::\\\"outer\\\"\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(traceString.find("\"name\":\"TestProfiler::inner\""), std::string::npos);
+  EXPECT_NE(profiler::getSummary().find("TestProfiler::inner"), std::string::npos);
+}
+
+TEST_F(TestProfiler, overhead) {
+  constexpr int numZones = 100000;
+  const auto zoneId = profiler::registerZone("TestProfiler::overhead");
+
+  benchmark::RepeatedTimer disabledTimer;
+  profiler::setEnabled(false);
+  disabledTimer.startTimer();
+  for (int i = 0; i < numZones; ++i) {
+    profiler::ScopedZone zone(zoneId);
+  }
+  disabledTimer.endTimer();
+
+  benchmark::RepeatedTimer enabledTimer;
+  profiler::setEnabled(true);
+  enabledTimer.startTimer();
+  for (int i = 0; i < numZones; ++i) {
+    profiler::ScopedZone zone(zoneId);
+  }
+  enabledTimer.endTimer();
+
+  std::cout << "[TestProfiler] zone overhead, disabled: " << 1e6 * disabledTimer.getTotalInMilliseconds() / numZones
+            << " [ns], enabled: " << 1e6 * enabledTimer.getTotalInMilliseconds() / numZones << " [ns]\n";
+}
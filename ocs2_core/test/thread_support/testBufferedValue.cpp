@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <ocs2_core/thread_support/BufferedValue.h>
+#include <ocs2_core/thread_support/SharedBufferedValue.h>
 
 TEST(testBufferedValue, basicSetGet) {
   // initialize
@@ -68,4 +69,51 @@ TEST(testBufferedValue, moveCount) {
   const bool isUpdated = bufferedValue.updateFromBuffer();
   ASSERT_TRUE(isUpdated);
   ASSERT_EQ(bufferedValue.get().getCount(), 2);
-}
\ No newline at end of file
+}
+TEST(testSharedBufferedValue, basicSetGet) {
+  // initialize
+  const std::string initialValue{"init"};
+  ocs2::SharedBufferedValue<std::string> bufferedValue(initialValue);
+  ASSERT_EQ(bufferedValue.get(), initialValue);
+
+  // set buffer with copy
+  const std::string updatedValue{"update"};
+  bufferedValue.setBuffer(updatedValue);
+  ASSERT_EQ(bufferedValue.get(), initialValue);
+  ASSERT_TRUE(bufferedValue.updateFromBuffer());
+  ASSERT_EQ(bufferedValue.get(), updatedValue);
+  ASSERT_FALSE(bufferedValue.updateFromBuffer());
+
+  // set buffer with a snapshot: no copy is made
+  const auto snapshot = std::make_shared<const std::string>("snapshot");
+  bufferedValue.setBuffer(snapshot);
+  ASSERT_TRUE(bufferedValue.updateFromBuffer());
+  ASSERT_EQ(&bufferedValue.get(), snapshot.get());
+
+  ASSERT_THROW(bufferedValue.setBuffer(std::shared_ptr<const std::string>(nullptr)), std::runtime_error);
+}
+
+TEST(testSharedBufferedValue, copyOnWrite) {
+  ocs2::SharedBufferedValue<std::string> bufferedValue(std::string("init"));
+
+  // an unshared value is modified in place
+  const auto* initialAddress = &bufferedValue.get();
+  bufferedValue.getMutable() += "_modified";
+  ASSERT_EQ(&bufferedValue.get(), initialAddress);
+
+  // a shared value is copied before it is modified
+  const auto snapshot = bufferedValue.getSnapshot();
+  bufferedValue.getMutable() += "_again";
+  ASSERT_NE(&bufferedValue.get(), snapshot.get());
+  ASSERT_EQ(*snapshot, "init_modified");
+  ASSERT_EQ(bufferedValue.get(), "init_modified_again");
+
+  // an external snapshot is never modified, even when it is not shared anymore
+  auto externalSnapshot = std::make_shared<const std::string>("external");
+  const auto* externalAddress = externalSnapshot.get();
+  bufferedValue.setBuffer(std::move(externalSnapshot));
+  bufferedValue.updateFromBuffer();
+  bufferedValue.getMutable() += "_modified";
+  ASSERT_NE(&bufferedValue.get(), externalAddress);
+  ASSERT_EQ(bufferedValue.get(), "external_modified");
+}
@@ -29,10 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/DualSolution.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -80,6 +84,32 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
                            PrimalSolution& primalSolution);
 
+/**
+ * Forward integrate the system dynamics with given controller in time partitions which are integrated in parallel. Each partition
+ * starts from the nominal state at its initial time. Then, in a serial pass, a partition is integrated again from the final state of
+ * the previous partition if the defect between the two states is larger than defectTolerance. Smaller defects are accepted.
+ *
+ * The partition boundaries are picked from the nominal time trajectory while avoiding the event times. Therefore, fewer partitions
+ * than requested can be used. With a single partition, this is equivalent to rolloutTrajectory.
+ *
+ * @note The mode schedule is not modified by the partitions, hence this should only be used with time-triggered rollouts.
+ *
+ * @param [in] threadPool: The thread pool.
+ * @param [in] rolloutRefStock: An array of references to the rollout. Each partition uses its own rollout instance.
+ * @param [in] nominalPrimalSolution: The nominal primal solution which provides the initial states of the partitions.
+ * @param [in] initTime: The initial time.
+ * @param [in] initState: The initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in] numPartitions: The number of partitions. It is limited by the size of rolloutRefStock.
+ * @param [in] defectTolerance: The maximum accepted defect (infinity norm) at the partition boundaries.
+ * @param [in, out] primalSolution: The resulting primal solution. The same requirements as rolloutTrajectory apply.
+ *
+ * @return average time step.
+ */
+scalar_t rolloutTrajectoryInPartitions(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                                       const PrimalSolution& nominalPrimalSolution, scalar_t initTime, const vector_t& initState,
+                                       scalar_t finalTime, size_t numPartitions, scalar_t defectTolerance, PrimalSolution& primalSolution);
+
 /**
  * Projects the unconstrained LQ coefficients to constrained ones.
  *
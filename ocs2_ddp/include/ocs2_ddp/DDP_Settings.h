@@ -68,6 +68,14 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /**
+   * Number of time partitions of the forward rollout of the initial controller and the zero step length of the line-search. The
+   * partitions start from the nominal trajectory and are integrated in parallel. Use 1 for serial rollouts. Requires a time-triggered
+   * rollout.
+   */
+  size_t numRolloutPartitions_ = 1;
+  /** The maximum accepted defect (infinity norm) at the partition boundaries. Partitions with a larger defect are integrated again. */
+  scalar_t rolloutPartitionDefectTolerance_ = 1e-6;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -103,6 +111,13 @@ struct Settings {
 
   /** If true, terms of the Riccati equation will be pre-computed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
+  /**
+   * If true, the value function of the previous iteration is cached in a packed format which only stores the upper triangular part of
+   * the Hessian. The LQ data of the backward pass is then not cached either but reused by the next iteration.
+   */
+  bool compactValueFunctionCache_ = false;
+  /** If true, the compact value function cache stores the derivatives in single precision. */
+  bool singlePrecisionValueFunctionCache_ = false;
 
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
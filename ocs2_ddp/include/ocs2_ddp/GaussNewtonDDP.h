@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/DDP_Data.h"
 #include "ocs2_ddp/DDP_Settings.h"
+#include "ocs2_ddp/PackedValueFunctionTrajectory.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 #include "ocs2_ddp/search_strategy/SearchStrategyBase.h"
 
@@ -227,9 +228,13 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] state: Current state
    * @return ScalarFunctionQuadraticApproximation
    */
-  ScalarFunctionQuadraticApproximation getValueFunctionFromCache(scalar_t time, const vector_t& state) const {
-    return getValueFunctionImpl(time, state, cachedPrimalData_.primalSolution, cachedDualData_.valueFunctionTrajectory);
-  }
+  ScalarFunctionQuadraticApproximation getValueFunctionFromCache(scalar_t time, const vector_t& state) const;
+
+  /**
+   * Swaps the nominal primal and dual data with the cached ones. If ddpSettings_.compactValueFunctionCache_ is set, only the value
+   * function is cached in the packed format and the remaining dual data buffers stay with the nominal data.
+   */
+  void swapNominalDataWithCache();
 
   /**
    * Forward integrate the system dynamics with the controller in inputPrimalSolution. In general, it uses the given
@@ -382,6 +387,8 @@ class GaussNewtonDDP : public SolverBase {
   // constructed and solved before terminating run()
   DualDataContainer cachedDualData_;
   PrimalDataContainer cachedPrimalData_;
+  // with compactValueFunctionCache_, cachedDualData_ only holds the dual solution and the cached value function is stored here
+  PackedValueFunctionTrajectory cachedPackedValueFunctionTrajectory_;
 
   struct ConstraintPenaltyCoefficients {
     scalar_t penaltyTol = 1e-3;
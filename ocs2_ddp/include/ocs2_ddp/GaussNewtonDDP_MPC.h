@@ -73,6 +73,8 @@ class GaussNewtonDDP_MPC final : public MPC_BASE {
   const GaussNewtonDDP* getSolverPtr() const override { return ddpPtr_.get(); }
 
  private:
+  using MPC_BASE::calculateController;
+
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
       ddpPtr_->reset();
@@ -80,6 +82,10 @@ class GaussNewtonDDP_MPC final : public MPC_BASE {
     ddpPtr_->run(initTime, initState, finalTime);
   }
 
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& initialGuess) override {
+    ddpPtr_->run(initTime, initState, finalTime, initialGuess);
+  }
+
   std::unique_ptr<GaussNewtonDDP> ddpPtr_;
 };
 
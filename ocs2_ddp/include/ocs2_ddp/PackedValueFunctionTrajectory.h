@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+/**
+ * Compact storage of a value function trajectory. The data of all nodes is kept in one contiguous buffer where each node stores
+ * [dfdx, the upper triangular part of dfdxx in column-major order]. The constant term f is always stored in double precision while the
+ * derivatives can optionally be stored in single precision.
+ *
+ * Repacking a trajectory of the same size reuses the buffers, i.e. it does not allocate memory.
+ */
+class PackedValueFunctionTrajectory {
+ public:
+  /**
+   * Constructor
+   * @param [in] singlePrecision: Whether to store dfdx and dfdxx in single precision.
+   */
+  explicit PackedValueFunctionTrajectory(bool singlePrecision = false) : singlePrecision_(singlePrecision) {}
+
+  /** Packs the value function trajectory. The dfdxx of each node is assumed to be symmetric. */
+  void pack(const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory);
+
+  /** Unpacks the value function of the given node. */
+  void unpack(size_t index, ScalarFunctionQuadraticApproximation& valueFunction) const;
+
+  /**
+   * Linearly interpolates the value function with the same conventions as LinearInterpolation::interpolate, i.e. it snaps to the
+   * closest node if the state dimensions of the neighboring nodes are different.
+   *
+   * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair.
+   * @param [out] valueFunction: The interpolated value function.
+   */
+  void interpolate(LinearInterpolation::index_alpha_t indexAlpha, ScalarFunctionQuadraticApproximation& valueFunction) const;
+
+  /** Number of nodes. */
+  size_t size() const { return f_.size(); }
+
+  /** Whether the trajectory is empty. */
+  bool empty() const { return f_.empty(); }
+
+  /** Removes all nodes. The allocated memory is kept for the next call to pack. */
+  void clear();
+
+  /** Whether the derivatives are stored in single precision. */
+  bool isSinglePrecision() const { return singlePrecision_; }
+
+  /** Allocated memory in bytes. */
+  size_t memoryInBytes() const;
+
+  /** Number of packed coefficients of a node with the given state dimension. */
+  static size_t numPackedCoefficients(size_t stateDim) { return stateDim + stateDim * (stateDim + 1) / 2; }
+
+ private:
+  template <typename T>
+  void packImpl(const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory, std::vector<T>& buffer);
+
+  template <typename T>
+  void interpolateImpl(LinearInterpolation::index_alpha_t indexAlpha, const std::vector<T>& buffer,
+                       ScalarFunctionQuadraticApproximation& valueFunction) const;
+
+  bool singlePrecision_;
+  scalar_array_t f_;
+  std::vector<int> stateDims_;
+  std::vector<size_t> offsets_;
+  std::vector<double> doubleBuffer_;
+  std::vector<float> floatBuffer_;
+};
+
+}  // namespace ocs2
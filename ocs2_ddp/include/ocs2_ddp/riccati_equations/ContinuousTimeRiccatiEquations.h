@@ -237,6 +237,7 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;  // The integrator steps monotonically backward in time
 
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
@@ -59,12 +59,14 @@ class LineSearchStrategy final : public SearchStrategyBase {
    * @param [in] threadPoolRef: A reference to the thread pool instance.
    * @param [in] rolloutRefStock: An array of references to the rollout.
    * @param [in] optimalControlProblemRef: An array of references to the optimal control problem.
+   * @param [in] nominalPrimalSolutionRef: A reference to the nominal primal solution of the solver. It provides the initial states of
+   * the rollout partitions.
    * @param [in] meritFunc: the merit function which gets the PerformanceIndex and returns the merit function value.
    */
   LineSearchStrategy(search_strategy::Settings baseSettings, line_search::Settings settings, ThreadPool& threadPoolRef,
                      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
                      std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRef,
-                     std::function<scalar_t(const PerformanceIndex&)> meritFunc);
+                     const PrimalSolution& nominalPrimalSolutionRef, std::function<scalar_t(const PerformanceIndex&)> meritFunc);
 
   ~LineSearchStrategy() override = default;
   LineSearchStrategy(const LineSearchStrategy&) = delete;
@@ -114,6 +116,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<search_strategy::Solution> workersSolution_;
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
+  const PrimalSolution& nominalPrimalSolutionRef_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
 
   // input
@@ -72,6 +72,10 @@ struct Settings {
   scalar_t minRelCost = 1e-3;
   /** This value determines the tolerance of constraint's ISE (Integral of Square Error). */
   scalar_t constraintTolerance = 1e-3;
+  /** Number of parallel time partitions of the rollout with zero step length, see ddp::Settings::numRolloutPartitions_. */
+  size_t numRolloutPartitions = 1;
+  /** The maximum accepted defect at the partition boundaries, see ddp::Settings::rolloutPartitionDefectTolerance_. */
+  scalar_t rolloutPartitionDefectTolerance = 1e-6;
 };  // end of Settings
 
 }  // namespace search_strategy
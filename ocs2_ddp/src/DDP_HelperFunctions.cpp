@@ -30,11 +30,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <iterator>
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Numerics.h>
+#include <ocs2_core/misc/Profiler.h>
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
@@ -56,6 +61,17 @@ void copySegment(const LinearInterpolation::index_alpha_t& indexAlpha0, const Li
     outputTrajectory.back() = LinearInterpolation::interpolate(indexAlpha1, inputTrajectory);
   }
 }
+
+struct RolloutPartition {
+  scalar_t initTime;
+  scalar_t finalTime;
+  vector_t initState;
+  ModeSchedule modeSchedule;
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+};
 }  // unnamed namespace
 
 /******************************************************************************************************/
@@ -76,7 +92,10 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
   constexpr auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
   for (size_t k = 0; k < tTrajectory.size(); k++) {
     // intermediate time cost and constraints
-    problem.preComputationPtr->request(request, tTrajectory[k], xTrajectory[k], uTrajectory[k]);
+    {
+      OCS2_PROFILE_ZONE("PreComputation::request");
+      problem.preComputationPtr->request(request, tTrajectory[k], xTrajectory[k], uTrajectory[k]);
+    }
     problemMetrics.intermediates.push_back(
         computeIntermediateMetrics(problem, tTrajectory[k], xTrajectory[k], uTrajectory[k], dualSolution.intermediates[k]));
 
@@ -137,6 +156,107 @@ scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector
   return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t rolloutTrajectoryInPartitions(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                                       const PrimalSolution& nominalPrimalSolution, scalar_t initTime, const vector_t& initState,
+                                       scalar_t finalTime, size_t numPartitions, scalar_t defectTolerance, PrimalSolution& primalSolution) {
+  const auto& nominalTimeTrajectory = nominalPrimalSolution.timeTrajectory_;
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  numPartitions = std::min(numPartitions, rolloutRefStock.size());
+
+  // partition boundaries on the nominal time trajectory
+  std::vector<RolloutPartition> partitions(1);
+  partitions.front().initTime = initTime;
+  partitions.front().initState = initState;
+  for (size_t p = 1; p < numPartitions; p++) {
+    const scalar_t desiredTime = initTime + static_cast<scalar_t>(p) * (finalTime - initTime) / static_cast<scalar_t>(numPartitions);
+    const auto timeItr = std::lower_bound(nominalTimeTrajectory.cbegin(), nominalTimeTrajectory.cend(), desiredTime);
+    if (timeItr == nominalTimeTrajectory.cend() || *timeItr >= finalTime) {
+      break;
+    }
+    const bool isEventTime =
+        std::any_of(eventTimes.cbegin(), eventTimes.cend(), [&](scalar_t te) { return numerics::almost_eq(te, *timeItr); });
+    if (isEventTime || *timeItr <= partitions.back().initTime) {
+      continue;
+    }
+    partitions.emplace_back();
+    partitions.back().initTime = *timeItr;
+    partitions.back().initState = nominalPrimalSolution.stateTrajectory_[std::distance(nominalTimeTrajectory.cbegin(), timeItr)];
+  }
+  for (size_t p = 0; p < partitions.size(); p++) {
+    partitions[p].finalTime = (p + 1 < partitions.size()) ? partitions[p + 1].initTime : finalTime;
+  }
+
+  if (partitions.size() == 1) {
+    return rolloutTrajectory(rolloutRefStock.front(), initTime, initState, finalTime, primalSolution);
+  }
+
+  auto rolloutPartition = [&](RolloutBase& rollout, RolloutPartition& partition) {
+    partition.modeSchedule = primalSolution.modeSchedule_;
+    const auto xCurrent = rollout.run(partition.initTime, partition.initState, partition.finalTime, primalSolution.controllerPtr_.get(),
+                                      partition.modeSchedule, partition.timeTrajectory, partition.postEventIndices,
+                                      partition.stateTrajectory, partition.inputTrajectory);
+    if (!xCurrent.allFinite()) {
+      throw std::runtime_error("[rolloutTrajectoryInPartitions] System became unstable during the rollout!");
+    }
+  };
+
+  // integrate the partitions in parallel. The exceptions are rethrown after all tasks have finished.
+  std::atomic_size_t nextPartition{0};
+  std::vector<std::exception_ptr> partitionExceptions(partitions.size());
+  auto task = [&](int) {
+    size_t p;
+    while ((p = nextPartition++) < partitions.size()) {
+      try {
+        rolloutPartition(rolloutRefStock[p], partitions[p]);
+      } catch (...) {
+        partitionExceptions[p] = std::current_exception();
+      }
+    }
+  };
+  threadPool.runParallel(task, partitions.size());
+  for (const auto& exceptionPtr : partitionExceptions) {
+    if (exceptionPtr != nullptr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+
+  // close the defects serially
+  for (size_t p = 1; p < partitions.size(); p++) {
+    const vector_t& previousFinalState = partitions[p - 1].stateTrajectory.back();
+    if ((previousFinalState - partitions[p].initState).lpNorm<Eigen::Infinity>() > defectTolerance) {
+      partitions[p].initState = previousFinalState;
+      rolloutPartition(rolloutRefStock.front(), partitions[p]);
+    }
+  }
+
+  // concatenate the partitions. The initial point of a partition is dropped, since it is the final point of the previous one.
+  auto& timeTrajectory = primalSolution.timeTrajectory_;
+  auto& postEventIndices = primalSolution.postEventIndices_;
+  auto& stateTrajectory = primalSolution.stateTrajectory_;
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  timeTrajectory.clear();
+  postEventIndices.clear();
+  stateTrajectory.clear();
+  inputTrajectory.clear();
+  for (size_t p = 0; p < partitions.size(); p++) {
+    const size_t firstIndex = (p == 0) ? 0 : 1;
+    const size_t offset = timeTrajectory.size() - firstIndex;
+    auto& partition = partitions[p];
+    for (const auto index : partition.postEventIndices) {
+      postEventIndices.push_back(offset + index);
+    }
+    timeTrajectory.insert(timeTrajectory.end(), partition.timeTrajectory.begin() + firstIndex, partition.timeTrajectory.end());
+    std::move(partition.stateTrajectory.begin() + firstIndex, partition.stateTrajectory.end(), std::back_inserter(stateTrajectory));
+    std::move(partition.inputTrajectory.begin() + firstIndex, partition.inputTrajectory.end(), std::back_inserter(inputTrajectory));
+  }
+
+  // average time step
+  return (finalTime - initTime) / static_cast<scalar_t>(timeTrajectory.size());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
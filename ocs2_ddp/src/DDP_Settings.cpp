@@ -53,8 +53,8 @@ Algorithm fromAlgorithmName(std::string name) {
 }
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   Settings settings;
 
@@ -69,6 +69,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.numRolloutPartitions_, fieldName + ".numRolloutPartitions", verbose);
+  loadData::loadPtreeValue(pt, settings.rolloutPartitionDefectTolerance_, fieldName + ".rolloutPartitionDefectTolerance", verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -91,6 +93,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.compactValueFunctionCache_, fieldName + ".compactValueFunctionCache", verbose);
+  loadData::loadPtreeValue(pt, settings.singlePrecisionValueFunctionCache_, fieldName + ".singlePrecisionValueFunctionCache", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
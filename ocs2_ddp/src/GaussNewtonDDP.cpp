@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Profiler.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -48,6 +49,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Changes the expansion point of the value function by deltaX. */
+void recenterValueFunction(const vector_t& deltaX, ScalarFunctionQuadraticApproximation& valueFunction) {
+  const vector_t SmDeltaX = valueFunction.dfdxx * deltaX;
+  valueFunction.f += deltaX.dot(0.5 * SmDeltaX + valueFunction.dfdx);
+  valueFunction.dfdx += SmDeltaX;  // Adapt dfdx after f!
+}
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -74,6 +84,10 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         "method!");
   }
 
+  if (ddpSettings_.numRolloutPartitions_ > 1 && dynamic_cast<const TimeTriggeredRollout*>(&rollout) == nullptr) {
+    throw std::runtime_error("[GaussNewtonDDP] Rollout partitioning (numRolloutPartitions > 1) requires a TimeTriggeredRollout!");
+  }
+
   // initializer Rollout
   initializerRolloutPtr_.reset(new InitializerRollout(initializer, rollout.settings()));
 
@@ -92,6 +106,8 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
     s.debugPrintRollout = ddpSettings_.debugPrintRollout_;
     s.minRelCost = ddpSettings_.minRelCost_;
     s.constraintTolerance = ddpSettings_.constraintTolerance_;
+    s.numRolloutPartitions = ddpSettings_.numRolloutPartitions_;
+    s.rolloutPartitionDefectTolerance = ddpSettings_.rolloutPartitionDefectTolerance_;
     return s;
   }();
   auto meritFunc = [this](const PerformanceIndex& p) { return calculateRolloutMerit(p); };
@@ -104,7 +120,8 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         problemRefStock.emplace_back(optimalControlProblemStock_[i]);
       }  // end of i loop
       searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, threadPool_,
-                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
+                                                      std::move(rolloutRefStock), std::move(problemRefStock),
+                                                      nominalPrimalData_.primalSolution, meritFunc));
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
@@ -120,6 +137,8 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
   optimizedPrimalSolution_.controllerPtr_.reset(new LinearController);
   nominalPrimalData_.primalSolution.controllerPtr_.reset(new LinearController);
   cachedPrimalData_.primalSolution.controllerPtr_.reset(new LinearController);
+
+  cachedPackedValueFunctionTrajectory_ = PackedValueFunctionTrajectory(ddpSettings_.singlePrecisionValueFunctionCache_);
 }
 
 /******************************************************************************************************/
@@ -178,6 +197,7 @@ void GaussNewtonDDP::reset() {
   nominalPrimalData_.clear();
   cachedDualData_.clear();
   cachedPrimalData_.clear();
+  cachedPackedValueFunctionTrajectory_.clear();
 
   // optimized data
   optimizedDualSolution_.clear();
@@ -278,14 +298,44 @@ ScalarFunctionQuadraticApproximation GaussNewtonDDP::getValueFunctionImpl(
 
   // Re-center around query state
   const vector_t xNominal = LinearInterpolation::interpolate(indexAlpha, primalSolution.stateTrajectory_);
-  const vector_t deltaX = state - xNominal;
-  const vector_t SmDeltaX = valueFunction.dfdxx * deltaX;
-  valueFunction.f += deltaX.dot(0.5 * SmDeltaX + valueFunction.dfdx);
-  valueFunction.dfdx += SmDeltaX;  // Adapt dfdx after f!
+  recenterValueFunction(state - xNominal, valueFunction);
 
   return valueFunction;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation GaussNewtonDDP::getValueFunctionFromCache(scalar_t time, const vector_t& state) const {
+  if (!ddpSettings_.compactValueFunctionCache_) {
+    return getValueFunctionImpl(time, state, cachedPrimalData_.primalSolution, cachedDualData_.valueFunctionTrajectory);
+  }
+
+  ScalarFunctionQuadraticApproximation valueFunction;
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, cachedPrimalData_.primalSolution.timeTrajectory_);
+  cachedPackedValueFunctionTrajectory_.interpolate(indexAlpha, valueFunction);
+
+  // Re-center around query state
+  const vector_t xNominal = LinearInterpolation::interpolate(indexAlpha, cachedPrimalData_.primalSolution.stateTrajectory_);
+  recenterValueFunction(state - xNominal, valueFunction);
+
+  return valueFunction;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::swapNominalDataWithCache() {
+  nominalPrimalData_.swap(cachedPrimalData_);
+  if (ddpSettings_.compactValueFunctionCache_) {
+    // only the value function is read from the cache
+    cachedPackedValueFunctionTrajectory_.pack(nominalDualData_.valueFunctionTrajectory);
+    nominalDualData_.dualSolution.swap(cachedDualData_.dualSolution);
+  } else {
+    nominalDualData_.swap(cachedDualData_);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -375,6 +425,7 @@ vector_t GaussNewtonDDP::getStateInputEqualityConstraintLagrangianImpl(scalar_t
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool GaussNewtonDDP::rolloutInitialController(PrimalSolution& inputPrimalSolution, PrimalSolution& outputPrimalSolution) {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::rolloutInitialController");
   if (inputPrimalSolution.controllerPtr_->empty()) {
     return false;
   }
@@ -397,7 +448,18 @@ bool GaussNewtonDDP::rolloutInitialController(PrimalSolution& inputPrimalSolutio
       std::cerr << "\twill use controller for t = [" << initTime_ << ", " << finalTime << "]\n";
     }
     outputPrimalSolution.controllerPtr_.swap(inputPrimalSolution.controllerPtr_);
-    std::ignore = rolloutTrajectory(*dynamicsForwardRolloutPtrStock_[0], initTime_, initState_, finalTime, outputPrimalSolution);
+    if (ddpSettings_.numRolloutPartitions_ > 1) {
+      // the partitions start from the trajectory of the inputPrimalSolution
+      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
+      for (auto& rolloutPtr : dynamicsForwardRolloutPtrStock_) {
+        rolloutRefStock.emplace_back(*rolloutPtr);
+      }
+      std::ignore = rolloutTrajectoryInPartitions(threadPool_, rolloutRefStock, inputPrimalSolution, initTime_, initState_, finalTime,
+                                                  ddpSettings_.numRolloutPartitions_, ddpSettings_.rolloutPartitionDefectTolerance_,
+                                                  outputPrimalSolution);
+    } else {
+      std::ignore = rolloutTrajectory(*dynamicsForwardRolloutPtrStock_[0], initTime_, initState_, finalTime, outputPrimalSolution);
+    }
     return true;
 
   } else {
@@ -439,6 +501,7 @@ bool GaussNewtonDDP::extractInitialTrajectories(PrimalSolution& inputPrimalSolut
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::rolloutInitializer(PrimalSolution& primalSolution) {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::rolloutInitializer");
   // create alias
   auto& modeSchedule = primalSolution.modeSchedule_;
   auto& timeTrajectory = primalSolution.timeTrajectory_;
@@ -514,9 +577,9 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::solveSequentialRiccatiEquations");
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
-  nominalDualData_.valueFunctionTrajectory.clear();
   nominalDualData_.valueFunctionTrajectory.resize(outputN);
 
   // the last index of the partition is excluded, namely [first, last), so the value function approximation of the end point of the end
@@ -586,9 +649,10 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::calculateController() {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::calculateController");
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
-  unoptimizedController_.clear();
+  // the arrays are not cleared in order to reuse the memory of the gains and biases
   unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
   unoptimizedController_.gainArray_.resize(N);
   unoptimizedController_.biasArray_.resize(N);
@@ -645,6 +709,7 @@ void GaussNewtonDDP::calculateController() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::approximateOptimalControlProblem");
   /*
    * compute and augment the LQ approximation of intermediate times
    */
@@ -901,6 +966,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::takePrimalDualStep");
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
   scalar_t avgTimeStep;
@@ -978,6 +1044,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_PROFILE_ZONE("GaussNewtonDDP::runImpl");
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ " + ddp::toAlgorithmName(ddpSettings_.algorithm_) + " solver is initialized ++++++++++++++";
@@ -1007,8 +1074,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   }
 
   // swap primal and dual data to cache
-  nominalDualData_.swap(cachedDualData_);
-  nominalPrimalData_.swap(cachedPrimalData_);
+  swapNominalDataWithCache();
 
   // optimized --> nominal: initializes the nominal primal and dual solutions based on the optimized ones
   initializationTimer_.startTimer();
@@ -1077,8 +1143,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
       updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE);
 
       // optimized --> nominal: use the optimized solution as the nominal for the next iteration
-      nominalDualData_.swap(cachedDualData_);
-      nominalPrimalData_.swap(cachedPrimalData_);
+      swapNominalDataWithCache();
       optimizedDualSolution_.swap(nominalDualData_.dualSolution);
       optimizedPrimalSolution_.swap(nominalPrimalData_.primalSolution);
       optimizedProblemMetrics_.swap(nominalPrimalData_.problemMetrics);
@@ -0,0 +1,183 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ddp/PackedValueFunctionTrajectory.h"
+
+namespace ocs2 {
+
+namespace {
+
+/**
+ * Sets (or adds, if accumulate is true) the weighted dfdx and the upper triangular part of the weighted dfdxx of a packed node. The
+ * outputs should already have the size of the node.
+ */
+template <typename T>
+void weightedPackedNode(const T* data, int stateDim, scalar_t weight, bool accumulate, vector_t& dfdx, matrix_t& dfdxx) {
+  using const_map_t = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>;
+  if (accumulate) {
+    dfdx.noalias() += weight * const_map_t(data, stateDim).template cast<scalar_t>();
+  } else {
+    dfdx.noalias() = weight * const_map_t(data, stateDim).template cast<scalar_t>();
+  }
+  data += stateDim;
+  for (int col = 0; col < stateDim; col++) {
+    if (accumulate) {
+      dfdxx.col(col).head(col + 1).noalias() += weight * const_map_t(data, col + 1).template cast<scalar_t>();
+    } else {
+      dfdxx.col(col).head(col + 1).noalias() = weight * const_map_t(data, col + 1).template cast<scalar_t>();
+    }
+    data += col + 1;
+  }
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PackedValueFunctionTrajectory::pack(const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory) {
+  if (singlePrecision_) {
+    packImpl(valueFunctionTrajectory, floatBuffer_);
+  } else {
+    packImpl(valueFunctionTrajectory, doubleBuffer_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PackedValueFunctionTrajectory::unpack(size_t index, ScalarFunctionQuadraticApproximation& valueFunction) const {
+  if (index >= size()) {
+    throw std::runtime_error("[PackedValueFunctionTrajectory] Index " + std::to_string(index) + " is out of range.");
+  }
+  interpolate({static_cast<int>(index), 1.0}, valueFunction);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PackedValueFunctionTrajectory::interpolate(LinearInterpolation::index_alpha_t indexAlpha,
+                                                ScalarFunctionQuadraticApproximation& valueFunction) const {
+  if (empty()) {
+    throw std::runtime_error("[PackedValueFunctionTrajectory] The trajectory is empty.");
+  }
+  if (singlePrecision_) {
+    interpolateImpl(indexAlpha, floatBuffer_, valueFunction);
+  } else {
+    interpolateImpl(indexAlpha, doubleBuffer_, valueFunction);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PackedValueFunctionTrajectory::clear() {
+  f_.clear();
+  stateDims_.clear();
+  offsets_.clear();
+  doubleBuffer_.clear();
+  floatBuffer_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t PackedValueFunctionTrajectory::memoryInBytes() const {
+  return f_.capacity() * sizeof(scalar_t) + stateDims_.capacity() * sizeof(int) + offsets_.capacity() * sizeof(size_t) +
+         doubleBuffer_.capacity() * sizeof(double) + floatBuffer_.capacity() * sizeof(float);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+void PackedValueFunctionTrajectory::packImpl(const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory,
+                                             std::vector<T>& buffer) {
+  const size_t N = valueFunctionTrajectory.size();
+  f_.resize(N);
+  stateDims_.resize(N);
+  offsets_.resize(N + 1);
+
+  offsets_.front() = 0;
+  for (size_t k = 0; k < N; k++) {
+    stateDims_[k] = valueFunctionTrajectory[k].dfdx.size();
+    offsets_[k + 1] = offsets_[k] + numPackedCoefficients(stateDims_[k]);
+  }
+  buffer.resize(offsets_.back());
+
+  for (size_t k = 0; k < N; k++) {
+    const auto& valueFunction = valueFunctionTrajectory[k];
+    const int stateDim = stateDims_[k];
+    f_[k] = valueFunction.f;
+    T* data = buffer.data() + offsets_[k];
+    for (int i = 0; i < stateDim; i++) {
+      *data++ = static_cast<T>(valueFunction.dfdx(i));
+    }
+    for (int col = 0; col < stateDim; col++) {
+      for (int row = 0; row <= col; row++) {
+        *data++ = static_cast<T>(valueFunction.dfdxx(row, col));
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+void PackedValueFunctionTrajectory::interpolateImpl(LinearInterpolation::index_alpha_t indexAlpha, const std::vector<T>& buffer,
+                                                    ScalarFunctionQuadraticApproximation& valueFunction) const {
+  if (size() == 1) {
+    indexAlpha = {0, 1.0};
+  }
+  const size_t lhsIndex = indexAlpha.first;
+  const scalar_t alpha = indexAlpha.second;
+  const size_t rhsIndex = (alpha < 1.0) ? lhsIndex + 1 : lhsIndex;
+
+  // f is always interpolated, the derivatives snap to the closest node if the state dimensions are different
+  valueFunction.f = alpha * f_[lhsIndex] + (1.0 - alpha) * f_[rhsIndex];
+  const bool isSameSize = stateDims_[lhsIndex] == stateDims_[rhsIndex];
+  const size_t snapIndex = (alpha > 0.5) ? lhsIndex : rhsIndex;
+
+  const int stateDim = stateDims_[isSameSize ? lhsIndex : snapIndex];
+  // resizing to the same size does not allocate
+  valueFunction.dfdx.resize(stateDim);
+  valueFunction.dfdxx.resize(stateDim, stateDim);
+  if (!isSameSize || rhsIndex == lhsIndex) {
+    const size_t index = isSameSize ? lhsIndex : snapIndex;
+    weightedPackedNode(buffer.data() + offsets_[index], stateDim, 1.0, false, valueFunction.dfdx, valueFunction.dfdxx);
+  } else {
+    weightedPackedNode(buffer.data() + offsets_[lhsIndex], stateDim, alpha, false, valueFunction.dfdx, valueFunction.dfdxx);
+    weightedPackedNode(buffer.data() + offsets_[rhsIndex], stateDim, 1.0 - alpha, true, valueFunction.dfdx, valueFunction.dfdxx);
+  }
+  auto& dfdxx = valueFunction.dfdxx;
+  dfdxx.triangularView<Eigen::StrictlyLower>() = dfdxx.triangularView<Eigen::StrictlyUpper>().transpose();
+}
+
+}  // namespace ocs2
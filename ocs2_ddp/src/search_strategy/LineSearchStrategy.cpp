@@ -45,6 +45,7 @@ namespace ocs2 {
 LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, line_search::Settings settings, ThreadPool& threadPoolRef,
                                        std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
                                        std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
+                                       const PrimalSolution& nominalPrimalSolutionRef,
                                        std::function<scalar_t(const PerformanceIndex&)> meritFunc)
     : SearchStrategyBase(std::move(baseSettings)),
       settings_(std::move(settings)),
@@ -53,6 +54,7 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
       workersSolution_(threadPoolRef.numThreads() + 1),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
+      nominalPrimalSolutionRef_(nominalPrimalSolutionRef),
       meritFunc_(std::move(meritFunc)) {
   // infeasible learning rate adjustment scheme
   if (!numerics::almost_ge(settings_.maxStepLength, settings_.minStepLength)) {
@@ -92,8 +94,17 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  if (stepLength == 0.0 && baseSettings_.numRolloutPartitions > 1) {
+    // The controller with zero step length tracks the nominal trajectory, therefore the partitions start close to the rollout.
+    // This rollout is performed before the line-search workers start, hence all rollout instances are available.
+    solution.avgTimeStep = rolloutTrajectoryInPartitions(
+        threadPoolRef_, rolloutRefStock_, nominalPrimalSolutionRef_, lineSearchInputRef_.timePeriodPtr->first,
+        *lineSearchInputRef_.initStatePtr, lineSearchInputRef_.timePeriodPtr->second, baseSettings_.numRolloutPartitions,
+        baseSettings_.rolloutPartitionDefectTolerance, solution.primalSolution);
+  } else {
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  }
 
   // adjust dual solution only if it is required
   const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
@@ -65,8 +65,8 @@ Type fromString(std::string name) {
 namespace line_search {
 
 Settings load(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
   if (verbose) {
     std::cerr << " #### LINE_SEARCH Settings: {\n";
   }
@@ -99,8 +99,8 @@ Settings load(const std::string& filename, const std::string& fieldName, bool ve
 namespace levenberg_marquardt {
 
 Settings load(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
   if (verbose) {
     std::cerr << " #### LEVENBERG_MARQUARDT Settings: {\n";
   }
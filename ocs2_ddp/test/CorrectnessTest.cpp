@@ -282,6 +282,26 @@ TEST_P(DDPCorrectness, TestILQR) {
   correctnessTest(ddpSettings, performanceIndex, solution);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(DDPCorrectness, TestSLQCompactValueFunctionCache) {
+  // settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, getNumThreads(), getSearchStrategy());
+  ddpSettings.compactValueFunctionCache_ = true;
+  ddpSettings.singlePrecisionValueFunctionCache_ = true;
+
+  // ddp
+  ocs2::SLQ ddp(ddpSettings, *rolloutPtr, *problemPtr, *operatingPointsPtr);
+
+  ddp.getReferenceManager().setTargetTrajectories(targetTrajectories);
+  ddp.run(startTime, initState, finalTime);
+  const auto performanceIndex = ddp.getPerformanceIndeces();
+  const auto solution = ddp.primalSolution(finalTime);
+
+  correctnessTest(ddpSettings, performanceIndex, solution);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
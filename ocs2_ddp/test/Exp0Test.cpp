@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP0.h>
 
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
 
@@ -294,6 +295,79 @@ TEST_F(Exp0, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_compactValueFunctionCache) {
+  // ddp settings
+  constexpr size_t numThreads = 3;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+  auto packedDdpSettings = ddpSettings;
+  packedDdpSettings.compactValueFunctionCache_ = true;
+  auto floatDdpSettings = packedDdpSettings;
+  floatDdpSettings.singlePrecisionValueFunctionCache_ = true;
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ocs2::SLQ packedDdp(packedDdpSettings, rollout, problem, *initializerPtr);
+  packedDdp.setReferenceManager(referenceManagerPtr);
+  ocs2::SLQ floatDdp(floatDdpSettings, rollout, problem, *initializerPtr);
+  floatDdp.setReferenceManager(referenceManagerPtr);
+
+  // run all twice, the second run starts from the cached solution of the first one
+  for (int i = 0; i < 2; i++) {
+    ddp.run(startTime, initState, finalTime);
+    packedDdp.run(startTime, initState, finalTime);
+    floatDdp.run(startTime, initState, finalTime);
+    // packing in double precision is lossless
+    EXPECT_NEAR(packedDdp.getPerformanceIndeces().cost, ddp.getPerformanceIndeces().cost, 1e-9);
+    performanceIndexTest(floatDdpSettings, floatDdp.getPerformanceIndeces());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, mpc_warm_start) {
+  // ddp settings
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = finalTime - startTime;
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // converged solution without an initial guess
+  ocs2::GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, *initializerPtr);
+  mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  mpc.run(startTime, initState);
+  const size_t numIterations = mpc.getSolverPtr()->getIterationsLog().size();
+  const auto solution = mpc.getSolverPtr()->primalSolution(finalTime);
+
+  // a new MPC warm-started from the converged solution starts at the optimum
+  ocs2::GaussNewtonDDP_MPC warmStartedMpc(mpcSettings, ddpSettings, rollout, problem, *initializerPtr);
+  warmStartedMpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  warmStartedMpc.run(startTime, initState, solution);
+  const auto& iterationsLog = warmStartedMpc.getSolverPtr()->getIterationsLog();
+  ASSERT_FALSE(iterationsLog.empty());
+  EXPECT_LT(iterationsLog.size(), numIterations);
+  EXPECT_NEAR(iterationsLog.front().cost, expectedCost, 10.0 * minRelCost);
+  performanceIndexTest(ddpSettings, warmStartedMpc.getSolverPtr()->getPerformanceIndeces());
+
+  // with coldStart_ the initial guess is ignored
+  mpcSettings.coldStart_ = true;
+  ocs2::GaussNewtonDDP_MPC coldStartedMpc(mpcSettings, ddpSettings, rollout, problem, *initializerPtr);
+  coldStartedMpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  coldStartedMpc.run(startTime, initState, solution);
+  EXPECT_EQ(coldStartedMpc.getSolverPtr()->getIterationsLog().size(), numIterations);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -259,6 +259,53 @@ TEST_P(Exp1, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, SLQ_rolloutPartitions) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 4, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.numRolloutPartitions_ = 4;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // run ddp, the second run starts from the rollout of the previous controller
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, ILQR_compactValueFunctionCache) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.compactValueFunctionCache_ = true;
+  ddpSettings.singlePrecisionValueFunctionCache_ = true;
+
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // run ddp, the second run starts from the cached solution of the first one
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
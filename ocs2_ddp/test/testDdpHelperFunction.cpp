@@ -31,6 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_oc/test/EXP1.h>
+
 #include <ocs2_ddp/DDP_HelperFunctions.h>
 
 using namespace ocs2;
@@ -99,3 +102,60 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(rolloutTrajectoryInPartitions, compareWithSerial) {
+  constexpr size_t numPartitions = 4;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 3.0;
+  const vector_t initState = (vector_t(2) << 2.0, 3.0).finished();
+  const scalar_array_t eventTimes{0.2262, 1.0176};
+  const std::vector<size_t> modeSequence{0, 1, 2};
+  auto referenceManagerPtr = getExp1ReferenceManager(eventTimes, modeSequence);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.integratorType = IntegratorType::RK4_OCS2;
+  rolloutSettings.timeStep = 1e-2;
+  EXP1_System systemDynamics(referenceManagerPtr);
+  std::vector<std::unique_ptr<RolloutBase>> rolloutPtrs;
+  std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
+  for (size_t i = 0; i < numPartitions; ++i) {
+    rolloutPtrs.emplace_back(new TimeTriggeredRollout(systemDynamics, rolloutSettings));
+    rolloutRefStock.emplace_back(*rolloutPtrs.back());
+  }
+  ThreadPool threadPool(numPartitions - 1);
+
+  // stabilizing controller
+  const scalar_array_t timeStamps{initTime, finalTime};
+  const vector_array_t biasArray(2, vector_t::Ones(1));
+  const matrix_array_t gainArray(2, (matrix_t(1, 2) << -1.0, -1.0).finished());
+
+  PrimalSolution serialSolution;
+  serialSolution.modeSchedule_ = referenceManagerPtr->getModeSchedule();
+  serialSolution.controllerPtr_.reset(new LinearController(timeStamps, biasArray, gainArray));
+  rolloutTrajectory(rolloutRefStock.front(), initTime, initState, finalTime, serialSolution);
+
+  // The nominal trajectory is the serial rollout: the partitions are consistent.
+  PrimalSolution partitionedSolution;
+  partitionedSolution.modeSchedule_ = serialSolution.modeSchedule_;
+  partitionedSolution.controllerPtr_.reset(serialSolution.controllerPtr_->clone());
+  rolloutTrajectoryInPartitions(threadPool, rolloutRefStock, serialSolution, initTime, initState, finalTime, numPartitions, 1e-9,
+                                partitionedSolution);
+  ASSERT_EQ(partitionedSolution.timeTrajectory_.size(), partitionedSolution.stateTrajectory_.size());
+  ASSERT_EQ(partitionedSolution.timeTrajectory_.size(), partitionedSolution.inputTrajectory_.size());
+  EXPECT_EQ(partitionedSolution.postEventIndices_.size(), serialSolution.postEventIndices_.size());
+  for (const auto index : partitionedSolution.postEventIndices_) {
+    EXPECT_NEAR(partitionedSolution.timeTrajectory_[index - 1], partitionedSolution.timeTrajectory_[index], 1e-6);
+  }
+  EXPECT_TRUE(std::is_sorted(partitionedSolution.timeTrajectory_.begin(), partitionedSolution.timeTrajectory_.end()));
+  EXPECT_DOUBLE_EQ(partitionedSolution.timeTrajectory_.back(), finalTime);
+  EXPECT_TRUE(partitionedSolution.stateTrajectory_.back().isApprox(serialSolution.stateTrajectory_.back(), 1e-6));
+
+  // A perturbed nominal trajectory: the defects are closed by the serial pass.
+  PrimalSolution perturbedSolution = serialSolution;
+  for (auto& x : perturbedSolution.stateTrajectory_) {
+    x.array() += 0.1;
+  }
+  rolloutTrajectoryInPartitions(threadPool, rolloutRefStock, perturbedSolution, initTime, initState, finalTime, numPartitions, 1e-9,
+                                partitionedSolution);
+  EXPECT_TRUE(partitionedSolution.stateTrajectory_.back().isApprox(serialSolution.stateTrajectory_.back(), 1e-6));
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include <ocs2_ddp/PackedValueFunctionTrajectory.h>
+
+using namespace ocs2;
+
+namespace {
+
+std::vector<ScalarFunctionQuadraticApproximation> getRandomValueFunctionTrajectory(size_t numNodes, int stateDim) {
+  std::vector<ScalarFunctionQuadraticApproximation> valueFunctionTrajectory(numNodes);
+  for (auto& valueFunction : valueFunctionTrajectory) {
+    valueFunction.f = vector_t::Random(1)(0);
+    valueFunction.dfdx = vector_t::Random(stateDim);
+    const matrix_t A = matrix_t::Random(stateDim, stateDim);
+    valueFunction.dfdxx = A * A.transpose();
+  }
+  return valueFunctionTrajectory;
+}
+
+ScalarFunctionQuadraticApproximation interpolateDense(LinearInterpolation::index_alpha_t indexAlpha,
+                                                      const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory) {
+  using Array = std::vector<ScalarFunctionQuadraticApproximation>;
+  ScalarFunctionQuadraticApproximation valueFunction;
+  valueFunction.f = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                     +[](const Array& vec, size_t ind) -> const scalar_t& { return vec[ind].f; });
+  valueFunction.dfdx = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                        +[](const Array& vec, size_t ind) -> const vector_t& { return vec[ind].dfdx; });
+  valueFunction.dfdxx = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                         +[](const Array& vec, size_t ind) -> const matrix_t& { return vec[ind].dfdxx; });
+  return valueFunction;
+}
+
+size_t denseMemoryInBytes(const std::vector<ScalarFunctionQuadraticApproximation>& valueFunctionTrajectory) {
+  size_t memory = valueFunctionTrajectory.capacity() * sizeof(ScalarFunctionQuadraticApproximation);
+  for (const auto& valueFunction : valueFunctionTrajectory) {
+    memory += (valueFunction.dfdx.size() + valueFunction.dfdxx.size()) * sizeof(scalar_t);
+  }
+  return memory;
+}
+
+}  // namespace
+
+TEST(PackedValueFunctionTrajectory, unpack) {
+  const auto valueFunctionTrajectory = getRandomValueFunctionTrajectory(10, 6);
+
+  PackedValueFunctionTrajectory packed;
+  packed.pack(valueFunctionTrajectory);
+  ASSERT_EQ(packed.size(), valueFunctionTrajectory.size());
+
+  ScalarFunctionQuadraticApproximation valueFunction;
+  for (size_t k = 0; k < valueFunctionTrajectory.size(); k++) {
+    packed.unpack(k, valueFunction);
+    EXPECT_DOUBLE_EQ(valueFunction.f, valueFunctionTrajectory[k].f);
+    EXPECT_TRUE(valueFunction.dfdx == valueFunctionTrajectory[k].dfdx);
+    EXPECT_TRUE(valueFunction.dfdxx == valueFunctionTrajectory[k].dfdxx);
+  }
+  EXPECT_ANY_THROW(packed.unpack(valueFunctionTrajectory.size(), valueFunction));
+}
+
+TEST(PackedValueFunctionTrajectory, interpolate) {
+  const scalar_array_t timeTrajectory{0.0, 0.1, 0.2, 0.2, 0.35, 0.5};
+  auto valueFunctionTrajectory = getRandomValueFunctionTrajectory(timeTrajectory.size(), 4);
+  // change of the state dimension at the event time
+  valueFunctionTrajectory[3].dfdx = vector_t::Random(3);
+  valueFunctionTrajectory[3].dfdxx = matrix_t::Identity(3, 3);
+
+  PackedValueFunctionTrajectory packed;
+  packed.pack(valueFunctionTrajectory);
+
+  ScalarFunctionQuadraticApproximation valueFunction;
+  for (const scalar_t time : {-0.1, 0.0, 0.05, 0.1, 0.15, 0.2, 0.25, 0.4, 0.5, 0.6}) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory);
+    const auto expected = interpolateDense(indexAlpha, valueFunctionTrajectory);
+    packed.interpolate(indexAlpha, valueFunction);
+    EXPECT_NEAR(valueFunction.f, expected.f, 1e-12) << "time: " << time;
+    EXPECT_TRUE(valueFunction.dfdx.isApprox(expected.dfdx)) << "time: " << time;
+    EXPECT_TRUE(valueFunction.dfdxx.isApprox(expected.dfdxx)) << "time: " << time;
+  }
+}
+
+TEST(PackedValueFunctionTrajectory, singlePrecision) {
+  const auto valueFunctionTrajectory = getRandomValueFunctionTrajectory(10, 6);
+  const scalar_t tol = 1e-6;
+
+  PackedValueFunctionTrajectory packed(true);
+  packed.pack(valueFunctionTrajectory);
+  ASSERT_TRUE(packed.isSinglePrecision());
+
+  ScalarFunctionQuadraticApproximation valueFunction;
+  for (size_t k = 0; k < valueFunctionTrajectory.size(); k++) {
+    packed.unpack(k, valueFunction);
+    EXPECT_DOUBLE_EQ(valueFunction.f, valueFunctionTrajectory[k].f);
+    EXPECT_TRUE(valueFunction.dfdx.isApprox(valueFunctionTrajectory[k].dfdx, tol));
+    EXPECT_TRUE(valueFunction.dfdxx.isApprox(valueFunctionTrajectory[k].dfdxx, tol));
+    EXPECT_TRUE(valueFunction.dfdxx.isApprox(valueFunction.dfdxx.transpose()));
+  }
+}
+
+TEST(PackedValueFunctionTrajectory, memory) {
+  const auto valueFunctionTrajectory = getRandomValueFunctionTrajectory(50, 12);
+
+  PackedValueFunctionTrajectory packedDouble(false);
+  packedDouble.pack(valueFunctionTrajectory);
+  PackedValueFunctionTrajectory packedFloat(true);
+  packedFloat.pack(valueFunctionTrajectory);
+
+  const size_t denseMemory = denseMemoryInBytes(valueFunctionTrajectory);
+  EXPECT_LT(packedDouble.memoryInBytes(), denseMemory);
+  EXPECT_LT(packedFloat.memoryInBytes(), packedDouble.memoryInBytes());
+
+  // repacking a trajectory of the same size reuses the buffers
+  const size_t packedMemory = packedDouble.memoryInBytes();
+  packedDouble.clear();
+  packedDouble.pack(valueFunctionTrajectory);
+  EXPECT_EQ(packedDouble.memoryInBytes(), packedMemory);
+}
@@ -51,6 +51,29 @@ namespace ipm {
 void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const vector_t& dual,
                              const VectorFunctionLinearApproximation& ineqConstraints, ScalarFunctionQuadraticApproximation& lagrangian);
 
+/** The temporaries of condenseIneqConstraints(). Keep one per thread to condense the nodes without memory allocation. */
+struct CondensingWorkspace {
+  vector_t linearCoeff;     // (dual * f - barrierParam) / slack - dual
+  vector_t quadraticCoeff;  // dual / slack
+  matrix_t scaledDfdx;      // diag(quadraticCoeff) * dfdx
+  matrix_t scaledDfdu;      // diag(quadraticCoeff) * dfdu
+};
+
+/**
+ * Same as condenseIneqConstraints() above with the temporaries in a workspace. The dual feasibility and the condensing terms of the
+ * gradient are added with a single product.
+ *
+ * @param[in] barrierParam : The barrier parameter of the interior point method.
+ * @param[in] slack : The slack variable associated with the inequality constraints.
+ * @param[in] dual : The dual variable associated with the inequality constraints.
+ * @param[in] ineqConstraints : Linear approximation of the inequality constraints.
+ * @param[in, out] lagrangian : Quadratic approximation of the Lagrangian.
+ * @param[in, out] workspace : The temporaries. Their memory is reused if the sizes do not change.
+ */
+void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const vector_t& dual,
+                             const VectorFunctionLinearApproximation& ineqConstraints, ScalarFunctionQuadraticApproximation& lagrangian,
+                             CondensingWorkspace& workspace);
+
 /**
  * Computes the SSE of the residual in the perturbed complementary slackness.
  *
@@ -110,6 +133,31 @@ vector_t retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, con
  */
 scalar_t fractionToBoundaryStepSize(const vector_t& v, const vector_t& dv, scalar_t marginRate = 0.995);
 
+/** The maximum step sizes of the slack (primal) and dual variables given by the fraction-to-boundary rule. */
+struct StepSizes {
+  scalar_t primal = 1.0;
+  scalar_t dual = 1.0;
+};
+
+/**
+ * Retrieves the Newton directions of the slack and dual variables of inequality constraints, and reduces the maximum step sizes of the
+ * fraction-to-boundary rule in the same pass over the constraints. The directions are written in place.
+ *
+ * @param[in] ineqConstraints : Linear approximation of the inequality constraints.
+ * @param[in] dx : Newton direction of the state.
+ * @param[in] duPtr : Newton direction of the input. Pass nullptr for state-only inequality constraints.
+ * @param[in] barrierParam : The barrier parameter of the interior point method.
+ * @param[in] slack : The slack variable associated with the inequality constraints.
+ * @param[in] dual : The dual variable associated with the inequality constraints.
+ * @param[in] marginRate : Margin rate of the fraction-to-boundary rule, see fractionToBoundaryStepSize().
+ * @param[out] slackDirection : Newton direction of the slack variable.
+ * @param[out] dualDirection : Newton direction of the dual variable.
+ * @param[in, out] stepSizes : Reduced to the step sizes of these constraints if they are smaller.
+ */
+void retrieveSlackDualDirections(const VectorFunctionLinearApproximation& ineqConstraints, const vector_t& dx, const vector_t* duPtr,
+                                 scalar_t barrierParam, const vector_t& slack, const vector_t& dual, scalar_t marginRate,
+                                 vector_t& slackDirection, vector_t& dualDirection, StepSizes& stepSizes);
+
 /**
  * Convert the optimized slack or dual trajectories as a DualSolution.
  *
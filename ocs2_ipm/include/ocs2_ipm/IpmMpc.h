@@ -57,6 +57,8 @@ class IpmMpc final : public MPC_BASE {
   const IpmSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
  protected:
+  using MPC_BASE::calculateController;
+
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
       solverPtr_->reset();
@@ -64,6 +66,10 @@ class IpmMpc final : public MPC_BASE {
     solverPtr_->run(initTime, initState, finalTime);
   }
 
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& initialGuess) override {
+    solverPtr_->run(initTime, initState, finalTime, initialGuess);
+  }
+
  private:
   std::unique_ptr<IpmSolver> solverPtr_;
 };
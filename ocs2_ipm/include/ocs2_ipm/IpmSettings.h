@@ -87,6 +87,10 @@ struct Settings {
       0.995;  // Margin of the fraction-to-boundary-rule for the step size selection. Correcponds to `tau_min` option of IPOPT.
   bool usePrimalStepSizeForDual = true;  // If true, the primal step size is also used as the dual step size.
 
+  // Samples the target trajectories on the node times once per solve, so the costs look up their targets on the short time grid. This
+  // is exact as long as the costs only query the target at the node times, which holds for the costs evaluated by this solver.
+  bool sampleTargetTrajectories = false;
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
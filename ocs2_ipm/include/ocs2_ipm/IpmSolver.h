@@ -32,10 +32,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/CacheLinePadded.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
+#include <ocs2_oc/oc_data/PrimalSolutionPool.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -43,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterface.h>
 
+#include "ocs2_ipm/IpmHelpers.h"
 #include "ocs2_ipm/IpmSettings.h"
 #include "ocs2_ipm/IpmSolverStatus.h"
 
@@ -63,9 +66,11 @@ class IpmSolver : public SolverBase {
 
   void reset() override;
 
-  scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); };
+  scalar_t getFinalTime() const override { return primalSolutionPtr_->timeTrajectory_.back(); };
 
-  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = *primalSolutionPtr_; }
+
+  std::shared_ptr<const PrimalSolution> getPrimalSolutionSnapshot(scalar_t finalTime) const override { return primalSolutionPtr_; }
 
   const DualSolution* getDualSolution() const override { return &dualIneqTrajectory_; }
 
@@ -101,12 +106,15 @@ class IpmSolver : public SolverBase {
   }
 
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {
-    // Copy all except the controller
-    primalSolution_.timeTrajectory_ = primalSolution.timeTrajectory_;
-    primalSolution_.stateTrajectory_ = primalSolution.stateTrajectory_;
-    primalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
-    primalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
-    primalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+    // Copy all except the controller. The last solution might be shared as a snapshot, therefore it is replaced and not modified.
+    auto primalSolutionPtr = primalSolutionPool_.acquire();
+    primalSolutionPtr->timeTrajectory_ = primalSolution.timeTrajectory_;
+    primalSolutionPtr->stateTrajectory_ = primalSolution.stateTrajectory_;
+    primalSolutionPtr->inputTrajectory_ = primalSolution.inputTrajectory_;
+    primalSolutionPtr->postEventIndices_ = primalSolution.postEventIndices_;
+    primalSolutionPtr->modeSchedule_ = primalSolution.modeSchedule_;
+    primalSolutionPtr->controllerPtr_.reset();
+    primalSolutionPtr_ = std::move(primalSolutionPtr);
     runImpl(initTime, initState, finalTime);
   }
 
@@ -155,9 +163,9 @@ class IpmSolver : public SolverBase {
     scalar_t maxPrimalStepSize;
     scalar_t maxDualStepSize;
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                       const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
-                                       const vector_array_t& dualStateInputIneq);
+  const OcpSubproblemSolution& getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
+                                              const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
+                                              const vector_array_t& dualStateInputIneq);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
@@ -189,6 +197,7 @@ class IpmSolver : public SolverBase {
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
+  TargetTrajectories sampledTargetTrajectories_;  // see Settings::sampleTargetTrajectories
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
 
@@ -198,8 +207,10 @@ class IpmSolver : public SolverBase {
   // Threading
   ThreadPool threadPool_;
 
-  // Solution
-  PrimalSolution primalSolution_;
+  // Solution. It is an immutable snapshot once the run is over, the next run writes to a recycled one of the pool.
+  std::shared_ptr<PrimalSolution> primalSolutionPtr_{std::make_shared<PrimalSolution>()};
+  PrimalSolutionPool primalSolutionPool_;
+  PrimalSolution warmStartSolution_;  // trajectory spread of the last solution
   vector_array_t costateTrajectory_;
   vector_array_t projectionMultiplierTrajectory_;
   DualSolution slackIneqTrajectory_;
@@ -215,6 +226,10 @@ class IpmSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<ipm::CondensingWorkspace> condensingWorkspaces_;  // one per worker
+
+  // Solution of the QP subproblem. Kept between iterations to reuse the buffers.
+  OcpSubproblemSolution subproblemSolution_;
 
   // Constraint terms size
   std::vector<multiple_shooting::ConstraintsSize> constraintsSize_;
@@ -225,7 +240,7 @@ class IpmSolver : public SolverBase {
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
-  // The ProblemMetrics associated to primalSolution_
+  // The ProblemMetrics associated to primalSolutionPtr_
   ProblemMetrics problemMetrics_;
 
   // Benchmarking
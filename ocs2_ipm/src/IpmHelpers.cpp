@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ipm/IpmHelpers.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace ocs2 {
@@ -36,6 +37,13 @@ namespace ipm {
 
 void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const vector_t& dual,
                              const VectorFunctionLinearApproximation& ineqConstraint, ScalarFunctionQuadraticApproximation& lagrangian) {
+  CondensingWorkspace workspace;
+  condenseIneqConstraints(barrierParam, slack, dual, ineqConstraint, lagrangian, workspace);
+}
+
+void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const vector_t& dual,
+                             const VectorFunctionLinearApproximation& ineqConstraint, ScalarFunctionQuadraticApproximation& lagrangian,
+                             CondensingWorkspace& workspace) {
   assert(barrierParam > 0.0);
   const size_t nc = ineqConstraint.f.size();
   const size_t nu = ineqConstraint.dfdu.cols();
@@ -44,26 +52,20 @@ void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const
     return;
   }
 
-  // dual feasibilities
-  lagrangian.dfdx.noalias() -= ineqConstraint.dfdx.transpose() * dual;
-  if (ineqConstraint.dfdu.cols() > 0) {
-    lagrangian.dfdu.noalias() -= ineqConstraint.dfdu.transpose() * dual;
-  }
-
-  // coefficients for condensing
-  const vector_t condensingLinearCoeff = (dual.array() * ineqConstraint.f.array() - barrierParam) / slack.array();
-  const vector_t condensingQuadraticCoeff = dual.cwiseQuotient(slack);
+  // coefficients for condensing, the linear one includes the dual feasibilities
+  workspace.linearCoeff = ((dual.array() * ineqConstraint.f.array() - barrierParam) / slack.array() - dual.array()).matrix();
+  workspace.quadraticCoeff = dual.cwiseQuotient(slack);
 
   // condensing
-  lagrangian.dfdx.noalias() += ineqConstraint.dfdx.transpose() * condensingLinearCoeff;
-  const matrix_t condensingQuadraticCoeff_dfdx = condensingQuadraticCoeff.asDiagonal() * ineqConstraint.dfdx;
-  lagrangian.dfdxx.noalias() += ineqConstraint.dfdx.transpose() * condensingQuadraticCoeff_dfdx;
+  lagrangian.dfdx.noalias() += ineqConstraint.dfdx.transpose() * workspace.linearCoeff;
+  workspace.scaledDfdx.noalias() = workspace.quadraticCoeff.asDiagonal() * ineqConstraint.dfdx;
+  lagrangian.dfdxx.noalias() += ineqConstraint.dfdx.transpose() * workspace.scaledDfdx;
 
   if (nu > 0) {
-    lagrangian.dfdu.noalias() += ineqConstraint.dfdu.transpose() * condensingLinearCoeff;
-    const matrix_t condensingQuadraticCoeff_dfdu = condensingQuadraticCoeff.asDiagonal() * ineqConstraint.dfdu;
-    lagrangian.dfduu.noalias() += ineqConstraint.dfdu.transpose() * condensingQuadraticCoeff_dfdu;
-    lagrangian.dfdux.noalias() += ineqConstraint.dfdu.transpose() * condensingQuadraticCoeff_dfdx;
+    lagrangian.dfdu.noalias() += ineqConstraint.dfdu.transpose() * workspace.linearCoeff;
+    workspace.scaledDfdu.noalias() = workspace.quadraticCoeff.asDiagonal() * ineqConstraint.dfdu;
+    lagrangian.dfduu.noalias() += ineqConstraint.dfdu.transpose() * workspace.scaledDfdu;
+    lagrangian.dfdux.noalias() += ineqConstraint.dfdu.transpose() * workspace.scaledDfdx;
   }
 }
 
@@ -108,11 +110,44 @@ scalar_t fractionToBoundaryStepSize(const vector_t& v, const vector_t& dv, scala
     return 1.0;
   }
 
-  const vector_t invFractionToBoundary = (-1.0 / marginRate) * dv.cwiseQuotient(v);
-  const auto alpha = invFractionToBoundary.maxCoeff();
+  const scalar_t alpha = ((-1.0 / marginRate) * dv.array() / v.array()).maxCoeff();
   return alpha > 0.0 ? std::min(1.0 / alpha, 1.0) : 1.0;
 }
 
+void retrieveSlackDualDirections(const VectorFunctionLinearApproximation& ineqConstraints, const vector_t& dx, const vector_t* duPtr,
+                                 scalar_t barrierParam, const vector_t& slack, const vector_t& dual, scalar_t marginRate,
+                                 vector_t& slackDirection, vector_t& dualDirection, StepSizes& stepSizes) {
+  assert(barrierParam > 0.0);
+  assert(marginRate > 0.0);
+  assert(marginRate <= 1.0);
+  const size_t nc = ineqConstraints.f.size();
+  if (nc == 0) {
+    slackDirection.resize(0);
+    dualDirection.resize(0);
+    return;
+  }
+
+  slackDirection = ineqConstraints.f - slack;
+  slackDirection.noalias() += ineqConstraints.dfdx * dx;
+  if (duPtr != nullptr) {
+    slackDirection.noalias() += ineqConstraints.dfdu * (*duPtr);
+  }
+
+  // dual directions and the inverse of the fraction-to-boundary step sizes in one pass
+  dualDirection.resize(nc);
+  scalar_t primalAlpha = 0.0;
+  scalar_t dualAlpha = 0.0;
+  for (size_t i = 0; i < nc; i++) {
+    dualDirection(i) = (barrierParam - dual(i) * (slack(i) + slackDirection(i))) / slack(i);
+    primalAlpha = std::max(primalAlpha, -slackDirection(i) / slack(i));
+    dualAlpha = std::max(dualAlpha, -dualDirection(i) / dual(i));
+  }
+  primalAlpha /= marginRate;
+  dualAlpha /= marginRate;
+  stepSizes.primal = std::min(stepSizes.primal, primalAlpha > 0.0 ? 1.0 / primalAlpha : 1.0);
+  stepSizes.dual = std::min(stepSizes.dual, dualAlpha > 0.0 ? 1.0 / dualAlpha : 1.0);
+}
+
 namespace {
 MultiplierCollection toMultiplierCollection(const multiple_shooting::ConstraintsSize constraintsSize, const vector_t& stateIneq) {
   MultiplierCollection multiplierCollection;
@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Profiler.h>
+
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
@@ -78,6 +80,7 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  condensingWorkspaces_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -97,7 +100,8 @@ IpmSolver::~IpmSolver() {
 
 void IpmSolver::reset() {
   // Clear solution
-  primalSolution_ = PrimalSolution();
+  primalSolutionPtr_ = std::make_shared<PrimalSolution>();
+  warmStartSolution_.clear();
   costateTrajectory_.clear();
   projectionMultiplierTrajectory_.clear();
   slackIneqTrajectory_.clear();
@@ -157,7 +161,7 @@ ScalarFunctionQuadraticApproximation IpmSolver::getValueFunction(scalar_t time,
     throw std::runtime_error("[IpmSolver] Value function is empty! Is createValueFunction true and did the solver run?");
   } else {
     // Interpolation
-    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolutionPtr_->timeTrajectory_);
 
     ScalarFunctionQuadraticApproximation valueFunction;
     using T = std::vector<ocs2::ScalarFunctionQuadraticApproximation>;
@@ -176,9 +180,9 @@ ScalarFunctionQuadraticApproximation IpmSolver::getValueFunction(scalar_t time,
 vector_t IpmSolver::getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const {
   if (settings_.computeLagrangeMultipliers && !projectionMultiplierTrajectory_.empty()) {
     using T = std::vector<multiple_shooting::ProjectionMultiplierCoefficients>;
-    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolutionPtr_->timeTrajectory_);
 
-    const auto nominalState = LinearInterpolation::interpolate(indexAlpha, primalSolution_.stateTrajectory_);
+    const auto nominalState = LinearInterpolation::interpolate(indexAlpha, primalSolutionPtr_->stateTrajectory_);
     const auto sensitivityWrtState = LinearInterpolation::interpolate(
         indexAlpha, projectionMultiplierCoefficients_, [](const T& v, size_t ind) -> const matrix_t& { return v[ind].dfdx; });
 
@@ -201,6 +205,7 @@ MultiplierCollection IpmSolver::getIntermediateDualSolution(scalar_t time) const
 }
 
 void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_PROFILE_ZONE("IpmSolver::runImpl");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ IPM solver is initialized ++++++++++++++";
@@ -212,22 +217,28 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
 
   // Initialize references
+  const TargetTrajectories* targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
+  if (settings_.sampleTargetTrajectories) {
+    sampleTargetTrajectories(*targetTrajectoriesPtr, toNodeTime(timeDiscretization), sampledTargetTrajectories_);
+    targetTrajectoriesPtr = &sampledTargetTrajectories_;
+  }
   for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.targetTrajectoriesPtr = targetTrajectoriesPtr;
   }
 
   // old and new mode schedules for the trajectory spreading
-  const auto oldModeSchedule = primalSolution_.modeSchedule_;
+  const auto oldModeSchedule = primalSolutionPtr_->modeSchedule_;
   const auto& newModeSchedule = this->getReferenceManager().getModeSchedule();
 
   initializationTimer_.startTimer();
-  // Initialize the state and input
-  if (!primalSolution_.timeTrajectory_.empty()) {
-    std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution_);
+  // Initialize the state and input. The last solution might be shared as a snapshot, therefore it is spread to a copy.
+  if (!primalSolutionPtr_->timeTrajectory_.empty()) {
+    std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, *primalSolutionPtr_, warmStartSolution_);
+  } else {
+    warmStartSolution_.clear();
   }
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, warmStartSolution_, *initializerPtr_, x, u);
 
   // Initialize the slack and dual variables of the interior point method
   if (!slackIneqTrajectory_.timeTrajectory.empty()) {
@@ -267,7 +278,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution =
+    const auto& deltaSolution =
         getOCPSolution(delta_x0, barrierParam, slackStateIneq, dualStateIneq, slackStateInputIneq, dualStateInputIneq);
     extractValueFunction(timeDiscretization, x, lmd, deltaSolution.deltaXSol);
     solveQpTimer_.endTimer();
@@ -295,7 +306,9 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 
   computeControllerTimer_.startTimer();
-  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  auto primalSolutionPtr = primalSolutionPool_.acquire();
+  *primalSolutionPtr = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  primalSolutionPtr_ = std::move(primalSolutionPtr);
   costateTrajectory_ = std::move(lmd);
   projectionMultiplierTrajectory_ = std::move(nu);
   slackIneqTrajectory_ = ipm::toDualSolution(timeDiscretization, constraintsSize_, slackStateIneq, slackStateInputIneq);
@@ -322,11 +335,11 @@ void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& ti
 
   // Determine till when to use the previous solution
   const auto interpolateTill =
-      primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : primalSolution_.timeTrajectory_.back();
+      warmStartSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : warmStartSolution_.timeTrajectory_.back();
 
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateTill) {
-    costateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, costateTrajectory_));
+    costateTrajectory.push_back(LinearInterpolation::interpolate(initTime, warmStartSolution_.timeTrajectory_, costateTrajectory_));
   } else {
     costateTrajectory.push_back(vector_t::Zero(stateTrajectory[0].size()));
   }
@@ -334,7 +347,7 @@ void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& ti
   for (int i = 1; i < stateTrajectory.size(); i++) {
     const auto time = getIntervalEnd(timeDiscretization[i]);
     if (time < interpolateTill) {  // interpolate previous solution
-      costateTrajectory.push_back(LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, costateTrajectory_));
+      costateTrajectory.push_back(LinearInterpolation::interpolate(time, warmStartSolution_.timeTrajectory_, costateTrajectory_));
     } else {  // Initialize with zero
       costateTrajectory.push_back(vector_t::Zero(stateTrajectory[i].size()));
     }
@@ -349,17 +362,17 @@ void IpmSolver::initializeProjectionMultiplierTrajectory(const std::vector<Annot
   const auto& ocpDefinition = ocpDefinitions_[0];
 
   // Determine till when to use the previous solution
-  const auto interpolateTill =
-      primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : *std::prev(primalSolution_.timeTrajectory_.end(), 2);
+  const auto& previousTime = warmStartSolution_.timeTrajectory_;
+  const auto interpolateTill = previousTime.size() < 2 ? timeDiscretization.front().time : *std::prev(previousTime.end(), 2);
 
   // @todo Fix this using trajectory spreading
   auto interpolateProjectionMultiplierTrajectory = [&](scalar_t time) -> vector_t {
     const size_t numConstraints = ocpDefinition.equalityConstraintPtr->getNumConstraints(time);
-    const size_t index = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_).first;
+    const size_t index = LinearInterpolation::timeSegment(time, warmStartSolution_.timeTrajectory_).first;
     if (projectionMultiplierTrajectory_.size() > index + 1) {
       if (projectionMultiplierTrajectory_[index].size() == numConstraints &&
           projectionMultiplierTrajectory_[index].size() == projectionMultiplierTrajectory_[index + 1].size()) {
-        return LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, projectionMultiplierTrajectory_);
+        return LinearInterpolation::interpolate(time, warmStartSolution_.timeTrajectory_, projectionMultiplierTrajectory_);
       }
     }
     if (projectionMultiplierTrajectory_.size() > index) {
@@ -467,12 +480,13 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
   }
 }
 
-IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam,
-                                                           const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
-                                                           const vector_array_t& slackStateInputIneq,
-                                                           const vector_array_t& dualStateInputIneq) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+const IpmSolver::OcpSubproblemSolution& IpmSolver::getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam,
+                                                                  const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
+                                                                  const vector_array_t& slackStateInputIneq,
+                                                                  const vector_array_t& dualStateInputIneq) {
+  OCS2_PROFILE_ZONE("IpmSolver::getOCPSolution");
+  // Solve the QP. The solution of the previous iteration is overwritten to reuse its memory.
+  auto& solution = subproblemSolution_;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
   hpipm_status status;
@@ -507,30 +521,22 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   deltaSlackStateInputIneq.resize(N);
   deltaDualStateInputIneq.resize(N);
 
-  scalar_array_t primalStepSizes(settings_.nThreads, 1.0);
-  scalar_array_t dualStepSizes(settings_.nThreads, 1.0);
+  std::vector<CacheLinePadded<ipm::StepSizes>> stepSizes(settings_.nThreads);  // one per worker
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
+    OCS2_PROFILE_ZONE("IpmSolver::getOCPSolution(worker)");
     // Get worker specific resources
     vector_t tmp;  // 1 temporary for re-use for projection.
 
     int i = timeIndex++;
     while (i < N) {
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      deltaSlackStateInputIneq[i] =
-          ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
-      deltaDualStateInputIneq[i] =
-          ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
-      primalStepSizes[workerId] = std::min(
-          {primalStepSizes[workerId],
-           ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin),
-           ipm::fractionToBoundaryStepSize(slackStateInputIneq[i], deltaSlackStateInputIneq[i], settings_.fractionToBoundaryMargin)});
-      dualStepSizes[workerId] = std::min(
-          {dualStepSizes[workerId],
-           ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i], settings_.fractionToBoundaryMargin),
-           ipm::fractionToBoundaryStepSize(dualStateInputIneq[i], deltaDualStateInputIneq[i], settings_.fractionToBoundaryMargin)});
+      ipm::retrieveSlackDualDirections(stateIneqConstraints_[i], deltaXSol[i], nullptr, barrierParam, slackStateIneq[i], dualStateIneq[i],
+                                       settings_.fractionToBoundaryMargin, deltaSlackStateIneq[i], deltaDualStateIneq[i],
+                                       stepSizes[workerId].value);
+      ipm::retrieveSlackDualDirections(stateInputIneqConstraints_[i], deltaXSol[i], &deltaUSol[i], barrierParam, slackStateInputIneq[i],
+                                       dualStateInputIneq[i], settings_.fractionToBoundaryMargin, deltaSlackStateInputIneq[i],
+                                       deltaDualStateInputIneq[i], stepSizes[workerId].value);
 
       // Extract Newton directions of the costate
       if (settings_.computeLagrangeMultipliers) {
@@ -549,19 +555,17 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
         tmp.noalias() = constraintsProjection_[i].dfdu * deltaUSol[i];
         deltaUSol[i] = tmp + constraintsProjection_[i].f;
         deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
+      } else {
+        deltaNuSol[i].resize(0);
       }
 
       i = timeIndex++;
     }
 
     if (i == N) {  // Only one worker will execute this
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      primalStepSizes[workerId] =
-          std::min(primalStepSizes[workerId],
-                   ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
-      dualStepSizes[workerId] = std::min(dualStepSizes[workerId], ipm::fractionToBoundaryStepSize(dualStateIneq[i], deltaDualStateIneq[i],
-                                                                                                  settings_.fractionToBoundaryMargin));
+      ipm::retrieveSlackDualDirections(stateIneqConstraints_[i], deltaXSol[i], nullptr, barrierParam, slackStateIneq[i], dualStateIneq[i],
+                                       settings_.fractionToBoundaryMargin, deltaSlackStateIneq[i], deltaDualStateIneq[i],
+                                       stepSizes[workerId].value);
       // Extract Newton directions of the costate
       if (settings_.computeLagrangeMultipliers) {
         deltaLmdSol[0] = valueFunction_[0].dfdx;
@@ -571,14 +575,19 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   };
   runParallel(std::move(parallelTask));
 
-  solution.maxPrimalStepSize = *std::min_element(primalStepSizes.begin(), primalStepSizes.end());
-  solution.maxDualStepSize = *std::min_element(dualStepSizes.begin(), dualStepSizes.end());
+  solution.maxPrimalStepSize = 1.0;
+  solution.maxDualStepSize = 1.0;
+  for (const auto& workerStepSizes : stepSizes) {
+    solution.maxPrimalStepSize = std::min(solution.maxPrimalStepSize, workerStepSizes.value.primal);
+    solution.maxDualStepSize = std::min(solution.maxDualStepSize, workerStepSizes.value.dual);
+  }
 
   return solution;
 }
 
 void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
                                      const vector_array_t& deltaXSol) {
+  OCS2_PROFILE_ZONE("IpmSolver::extractValueFunction");
   if (settings_.createValueFunction) {
     // Correct for linearization state. Naive value function of hpipm is already extracted and stored in valueFunction_ in getOCPSolution().
     for (int i = 0; i < time.size(); ++i) {
@@ -608,6 +617,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
                                                      const vector_array_t& nu, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                      const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                                      const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_PROFILE_ZONE("IpmSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -624,8 +634,10 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
+    OCS2_PROFILE_ZONE("IpmSolver::setupQuadraticSubproblem(worker)");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+    ipm::CondensingWorkspace& condensingWorkspace = condensingWorkspaces_[workerId];
 
     int i = timeIndex++;
     while (i < N) {
@@ -647,7 +659,8 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
           lagrangian_[i] = std::move(result.cost);
         }
 
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i],
+                                     condensingWorkspace);
         performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
         performance[workerId].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
@@ -678,9 +691,10 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
           lagrangian_[i] = std::move(result.cost);
         }
 
-        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
+        ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i],
+                                     condensingWorkspace);
         ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
-                                     lagrangian_[i]);
+                                     lagrangian_[i], condensingWorkspace);
         performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
         performance[workerId].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
@@ -704,7 +718,8 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
       } else {
         lagrangian_[i] = std::move(result.cost);
       }
-      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
+      ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N],
+                                   condensingWorkspace);
       performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
       performance[workerId].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
     }
@@ -726,6 +741,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                                const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_PROFILE_ZONE("IpmSolver::computePerformance");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
   metrics.resize(N + 1);
@@ -733,6 +749,7 @@ PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>&
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
+    OCS2_PROFILE_ZONE("IpmSolver::computePerformance(worker)");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
@@ -781,6 +798,7 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
                                         const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                         vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_PROFILE_ZONE("IpmSolver::takePrimalStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -885,6 +903,7 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
 
 void IpmSolver::takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd,
                              vector_array_t& nu, vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const {
+  OCS2_PROFILE_ZONE("IpmSolver::takeDualStep");
   if (settings_.computeLagrangeMultipliers) {
     multiple_shooting::incrementTrajectory(lmd, subproblemSolution.deltaLmdSol, stepInfo.primalStepSize, lmd);
     multiple_shooting::incrementTrajectory(nu, subproblemSolution.deltaNuSol, stepInfo.primalStepSize, nu);
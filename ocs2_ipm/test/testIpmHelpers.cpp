@@ -0,0 +1,131 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_ipm/IpmHelpers.h"
+
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+using namespace ocs2;
+
+namespace {
+constexpr scalar_t barrierParam = 0.1;
+constexpr scalar_t marginRate = 0.995;
+constexpr scalar_t tol = 1e-12;
+
+vector_t getRandomPositiveVector(int n) {
+  return vector_t::Random(n).cwiseAbs() + vector_t::Constant(n, 0.01);
+}
+}  // namespace
+
+TEST(testIpmHelpers, condenseIneqConstraints) {
+  constexpr int nx = 8;
+  constexpr int nu = 4;
+  constexpr int nc = 12;
+  ipm::CondensingWorkspace workspace;  // reused for nodes of different sizes
+
+  for (const int numInputs : {nu, 0, nu}) {
+    const auto ineqConstraints = getRandomConstraints(nx, numInputs, nc);
+    const vector_t slack = getRandomPositiveVector(nc);
+    const vector_t dual = getRandomPositiveVector(nc);
+    const auto lagrangian = getRandomCost(nx, numInputs);
+
+    // dual feasibilities and condensing terms
+    const vector_t linearCoeff = ((dual.array() * ineqConstraints.f.array() - barrierParam) / slack.array() - dual.array()).matrix();
+    const matrix_t quadraticCoeff = dual.cwiseQuotient(slack).asDiagonal();
+    auto expected = lagrangian;
+    expected.dfdx += ineqConstraints.dfdx.transpose() * linearCoeff;
+    expected.dfdxx += ineqConstraints.dfdx.transpose() * quadraticCoeff * ineqConstraints.dfdx;
+    if (numInputs > 0) {
+      expected.dfdu += ineqConstraints.dfdu.transpose() * linearCoeff;
+      expected.dfduu += ineqConstraints.dfdu.transpose() * quadraticCoeff * ineqConstraints.dfdu;
+      expected.dfdux += ineqConstraints.dfdu.transpose() * quadraticCoeff * ineqConstraints.dfdx;
+    }
+
+    auto condensed = lagrangian;
+    ipm::condenseIneqConstraints(barrierParam, slack, dual, ineqConstraints, condensed, workspace);
+    auto condensedWithoutWorkspace = lagrangian;
+    ipm::condenseIneqConstraints(barrierParam, slack, dual, ineqConstraints, condensedWithoutWorkspace);
+
+    for (const auto& result : {condensed, condensedWithoutWorkspace}) {
+      EXPECT_TRUE(result.dfdx.isApprox(expected.dfdx, tol));
+      EXPECT_TRUE(result.dfdxx.isApprox(expected.dfdxx, tol));
+      if (numInputs > 0) {
+        EXPECT_TRUE(result.dfdu.isApprox(expected.dfdu, tol));
+        EXPECT_TRUE(result.dfduu.isApprox(expected.dfduu, tol));
+        EXPECT_TRUE(result.dfdux.isApprox(expected.dfdux, tol));
+      }
+    }
+  }
+}
+
+TEST(testIpmHelpers, retrieveSlackDualDirections) {
+  constexpr int nx = 8;
+  constexpr int nu = 4;
+  constexpr int nc = 12;
+  const auto stateInputIneqConstraints = getRandomConstraints(nx, nu, nc);
+  const auto stateIneqConstraints = getRandomConstraints(nx, 0, nc);
+  const vector_t dx = vector_t::Random(nx);
+  const vector_t du = vector_t::Random(nu);
+  const vector_t slack = getRandomPositiveVector(nc);
+  const vector_t dual = getRandomPositiveVector(nc);
+
+  const vector_t expectedSlackDirection = ipm::retrieveSlackDirection(stateInputIneqConstraints, dx, du, barrierParam, slack);
+  const vector_t expectedDualDirection = ipm::retrieveDualDirection(barrierParam, slack, dual, expectedSlackDirection);
+  const vector_t expectedStateSlackDirection = ipm::retrieveSlackDirection(stateIneqConstraints, dx, barrierParam, slack);
+  const vector_t expectedStateDualDirection = ipm::retrieveDualDirection(barrierParam, slack, dual, expectedStateSlackDirection);
+  const scalar_t expectedPrimalStepSize = std::min(ipm::fractionToBoundaryStepSize(slack, expectedSlackDirection, marginRate),
+                                                   ipm::fractionToBoundaryStepSize(slack, expectedStateSlackDirection, marginRate));
+  const scalar_t expectedDualStepSize = std::min(ipm::fractionToBoundaryStepSize(dual, expectedDualDirection, marginRate),
+                                                 ipm::fractionToBoundaryStepSize(dual, expectedStateDualDirection, marginRate));
+
+  vector_t slackDirection, dualDirection, stateSlackDirection, stateDualDirection;
+  ipm::StepSizes stepSizes;
+  ipm::retrieveSlackDualDirections(stateInputIneqConstraints, dx, &du, barrierParam, slack, dual, marginRate, slackDirection,
+                                   dualDirection, stepSizes);
+  ipm::retrieveSlackDualDirections(stateIneqConstraints, dx, nullptr, barrierParam, slack, dual, marginRate, stateSlackDirection,
+                                   stateDualDirection, stepSizes);
+
+  EXPECT_TRUE(slackDirection.isApprox(expectedSlackDirection, tol));
+  EXPECT_TRUE(dualDirection.isApprox(expectedDualDirection, tol));
+  EXPECT_TRUE(stateSlackDirection.isApprox(expectedStateSlackDirection, tol));
+  EXPECT_TRUE(stateDualDirection.isApprox(expectedStateDualDirection, tol));
+  EXPECT_NEAR(stepSizes.primal, expectedPrimalStepSize, tol);
+  EXPECT_NEAR(stepSizes.dual, expectedDualStepSize, tol);
+
+  // no constraints leave the step sizes unchanged
+  const auto emptyConstraints = getRandomConstraints(nx, nu, 0);
+  ipm::retrieveSlackDualDirections(emptyConstraints, dx, &du, barrierParam, vector_t(), vector_t(), marginRate, slackDirection,
+                                   dualDirection, stepSizes);
+  EXPECT_EQ(slackDirection.size(), 0);
+  EXPECT_EQ(dualDirection.size(), 0);
+  EXPECT_NEAR(stepSizes.primal, expectedPrimalStepSize, tol);
+  EXPECT_NEAR(stepSizes.dual, expectedDualStepSize, tol);
+}
@@ -67,6 +67,17 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Runs MPC for the given state and time, warm-started from the given primal solution instead of the last solution of this instance.
+   * This is used when several MPC instances solve the same problem, see MPC_Pipeline_Interface. If coldStart_ is set, the initial
+   * guess is ignored.
+   *
+   * @param [in] currentTime: The given time.
+   * @param [in] currentState: The given state.
+   * @param [in] initialGuess: The primal solution to warm-start from, e.g. the latest solution of another MPC instance.
+   */
+  bool run(scalar_t currentTime, const vector_t& currentState, const PrimalSolution& initialGuess);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,10 +100,27 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Solves the optimal control problem for the given state and time period ([initTime,finalTime]), warm-started from the given
+   * initial guess. The default implementation ignores the initial guess and calls calculateController() above.
+   *
+   * @param [out] initTime: Initial time. This value can be adjusted by the optimizer.
+   * @param [in] initState: Initial state.
+   * @param [in] finalTime: Final time. This value can be adjusted by the optimizer.
+   * @param [in] initialGuess: The primal solution to warm-start from.
+   */
+  virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                   const PrimalSolution& /*initialGuess*/) {
+    calculateController(initTime, initState, finalTime);
+  }
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
  private:
+  /** Implements run(). If initialGuessPtr is not a nullptr, the solver is warm-started from it. */
+  bool runImpl(scalar_t currentTime, const vector_t& currentState, const PrimalSolution* initialGuessPtr);
+
   bool initRun_ = true;
   const mpc::Settings mpcSettings_;
 
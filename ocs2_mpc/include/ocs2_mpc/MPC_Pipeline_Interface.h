@@ -0,0 +1,134 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MRT_BASE.h"
+
+namespace ocs2 {
+
+/**
+ * A pipelined, ROS independent interface to OCS2. Several MPC instances solve the same problem concurrently, each on its own thread.
+ * The starts of the solves are staggered in time, such that a new policy is published every (solve time / number of instances)
+ * instead of every solve time. Each solve starts from the latest observation and is warm-started from the finished solution with the
+ * newest start time. The MRT side only accepts a policy if its start time is newer than the one of the last published policy.
+ *
+ * Every instance needs its own solver and ReferenceManager, since they are used concurrently. The thread budget of an instance is set
+ * through the settings of its solver (e.g. the number of threads of the DDP or SQP solver), and the priority of the thread which runs
+ * the instance is set through the constructor.
+ */
+class MPC_Pipeline_Interface final : public MRT_BASE {
+ public:
+  /**
+   * Constructor
+   * @param [in] mpcInstances: The MPC instances to be used. They should solve the same problem with their own solver and ReferenceManager.
+   * @param [in] threadPriorities: The priority of the thread of each instance. If empty, the priority is not changed.
+   */
+  explicit MPC_Pipeline_Interface(std::vector<MPC_BASE*> mpcInstances, std::vector<int> threadPriorities = {});
+
+  /** Destructor. Stops the pipeline. */
+  ~MPC_Pipeline_Interface() override;
+
+  /** Stops the pipeline, resets all MPC instances and sets the target trajectories. */
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
+
+  void setCurrentObservation(const SystemObservation& currentObservation) override;
+
+  /** Sets the target trajectories of all instances. The instances share the same copy. */
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories);
+
+  /** Gets the ReferenceManager of an instance. */
+  ReferenceManagerInterface& getReferenceManager(size_t instance);
+
+  /** Number of MPC instances. */
+  size_t getNumInstances() const { return mpcInstances_.size(); }
+
+  /** Starts the threads of the MPC instances. The pipeline waits for a first observation. */
+  void start();
+
+  /** Stops the threads of the MPC instances. Blocks until the running solves are finished. */
+  void stop();
+
+  /** Whether the pipeline is running. */
+  bool isRunning() const { return isRunning_; }
+
+  /** Average duration of a solve, over all instances [ms]. */
+  scalar_t getAverageSolveTimeInMilliseconds() const;
+
+  /** Number of published policies and of finished solves which were dropped since a newer policy was already published. */
+  size_t getNumPublishedPolicies() const { return numPublished_; }
+  size_t getNumDroppedPolicies() const { return numDropped_; }
+
+ private:
+  /** The loop run by the thread of an instance. */
+  void instanceWorker(size_t instance);
+
+  /** Publishes the solution of an instance if it is newer than the last published policy. */
+  void publish(size_t instance, const SystemObservation& mpcInitObservation);
+
+  std::vector<MPC_BASE*> mpcInstances_;
+  std::vector<int> threadPriorities_;
+  std::vector<std::thread> workers_;
+  std::atomic_bool isRunning_{false};
+
+  std::vector<benchmark::RepeatedTimer> solveTimers_;  // One per instance, only used by the thread of the instance
+
+  // Scheduling of the starts. Protected by scheduleMutex_.
+  mutable std::mutex scheduleMutex_;
+  std::condition_variable scheduleCondition_;
+  size_t nextInstance_ = 0;
+  std::chrono::steady_clock::time_point nextStartTime_;
+  scalar_t lastStartedObservationTime_;
+  SystemObservation currentObservation_;
+  bool observationReceived_ = false;
+  bool solveStarted_ = false;
+  bool solveFinished_ = false;
+  scalar_t totalSolveTimeInMilliseconds_ = 0.0;
+  size_t numSolves_ = 0;
+
+  // Publishing. Protected by publishMutex_.
+  std::mutex publishMutex_;
+  scalar_t lastPublishedStartTime_;
+  std::shared_ptr<const PrimalSolution> latestSolutionPtr_;  // Warm start for the next solves
+  std::atomic<size_t> numPublished_{0};
+  std::atomic<size_t> numDropped_{0};
+};
+
+}  // namespace ocs2
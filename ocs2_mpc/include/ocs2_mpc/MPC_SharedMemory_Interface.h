@@ -0,0 +1,91 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/PolicySerialization.h"
+#include "ocs2_mpc/SharedMemoryBuffer.h"
+
+namespace ocs2 {
+
+/**
+ * The MPC side of a ROS independent transport to an MRT_SharedMemory_Interface in another process on the same machine. The observations
+ * of the MRT are read from shared memory, the MPC is run on them and the policies are published in the binary policy format of
+ * PolicySerialization.h. This class creates the shared memory buffers "<name>_policy", "<name>_observation" and "<name>_reset", so it
+ * has to be constructed before the MRT.
+ */
+class MPC_SharedMemory_Interface {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] mpc: The underlying MPC class to be used.
+   * @param [in] name: The name of the transport, shared with the MRT.
+   * @param [in] gainEncoding: The encoding of the feedback gains in the policy messages.
+   * @param [in] policyCapacity: The maximum size of a policy message in bytes, see policy_serialization::getPolicySize().
+   * @param [in] observationCapacity: The maximum size of an observation or reset message in bytes.
+   */
+  MPC_SharedMemory_Interface(MPC_BASE& mpc, const std::string& name,
+                             policy_serialization::GainEncoding gainEncoding = policy_serialization::GainEncoding::Double,
+                             size_t policyCapacity = 16 * 1024 * 1024, size_t observationCapacity = 1024 * 1024);
+
+  /**
+   * Handles the reset requests of the MRT, then runs the MPC on the latest observation if there is a new one and publishes the policy.
+   *
+   * @return True if a new policy was published.
+   */
+  bool spinOnce();
+
+  /** Reads the latest observation of the MRT. Returns false if there is no new observation. */
+  bool readObservation(SystemObservation& observation);
+
+  /** Publishes a policy to the MRT, tagged with the generation of the last handled reset request. */
+  void publishPolicy(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performance);
+
+ private:
+  MPC_BASE& mpc_;
+  const policy_serialization::GainEncoding gainEncoding_;
+
+  SharedMemoryBuffer policyBuffer_;
+  SharedMemoryBuffer observationBuffer_;
+  SharedMemoryBuffer resetBuffer_;
+
+  uint64_t observationSequenceNumber_ = 0;
+  uint64_t resetSequenceNumber_ = 0;
+  uint64_t resetGeneration_ = 0;  // generation of the last handled reset request
+  std::vector<char> message_;
+  SystemObservation observation_;
+  TargetTrajectories resetTargetTrajectories_;
+};
+
+}  // namespace ocs2
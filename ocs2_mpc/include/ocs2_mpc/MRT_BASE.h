@@ -162,7 +162,21 @@ class MRT_BASE {
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
+  /**
+   * Moves an immutable solution snapshot (see SolverBase::getPrimalSolutionSnapshot) to the buffer. The snapshot is shared without a
+   * copy, unless MRT observers are registered: since they modify the solution, they get a private copy of it.
+   */
+  void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::shared_ptr<const PrimalSolution> primalSolutionPtr,
+                    std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
+
  private:
+  /**
+   * Swaps the given data with the buffer. The modifiable solution is either the same object as the solution, or null if the solution is
+   * a shared snapshot.
+   */
+  void swapToBuffer(std::unique_ptr<CommandData>& commandDataPtr, std::shared_ptr<const PrimalSolution>& primalSolutionPtr,
+                    std::shared_ptr<PrimalSolution>& modifiablePrimalSolutionPtr, std::unique_ptr<PerformanceIndex>& performanceIndicesPtr);
+
   /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
@@ -176,8 +190,10 @@ class MRT_BASE {
   // variables related to the MPC output
   std::unique_ptr<CommandData> activeCommandPtr_;
   std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
+  std::shared_ptr<const PrimalSolution> activePrimalSolutionPtr_;
+  std::shared_ptr<const PrimalSolution> bufferPrimalSolutionPtr_;
+  std::shared_ptr<PrimalSolution> activeModifiablePrimalSolutionPtr_;  // null if the active solution is a shared snapshot
+  std::shared_ptr<PrimalSolution> bufferModifiablePrimalSolutionPtr_;  // null if the buffered solution is a shared snapshot
   std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
   std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
 
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ocs2_mpc/MRT_BASE.h"
+#include "ocs2_mpc/SharedMemoryBuffer.h"
+
+namespace ocs2 {
+
+/**
+ * The MRT side of a ROS independent transport to an MPC_SharedMemory_Interface in another process on the same machine. The observations
+ * are written to shared memory and the policies are read from it. The shared memory buffers are created by the MPC side, which has to be
+ * constructed first.
+ */
+class MRT_SharedMemory_Interface final : public MRT_BASE {
+ public:
+  /**
+   * Constructor
+   * @param [in] name: The name of the transport, shared with the MPC.
+   */
+  explicit MRT_SharedMemory_Interface(const std::string& name);
+
+  ~MRT_SharedMemory_Interface() override = default;
+
+  /**
+   * Requests the MPC to reset. The request is handled by the MPC before its next observation, the method does not wait for it. The
+   * policies that the MPC computed before handling the request are discarded by spinMRT().
+   *
+   * @param [in] initTargetTrajectories: The initial desired cost trajectories.
+   */
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override;
+
+  void setCurrentObservation(const SystemObservation& currentObservation) override;
+
+  /**
+   * Checks for a new policy of the MPC and moves it to the buffer. Call updatePolicy() to make it active.
+   *
+   * @return True if a new policy was received. False if there is no new policy or it predates the last reset request.
+   */
+  bool spinMRT();
+
+ private:
+  SharedMemoryBuffer policyBuffer_;
+  SharedMemoryBuffer observationBuffer_;
+  SharedMemoryBuffer resetBuffer_;
+
+  uint64_t policySequenceNumber_ = 0;
+  uint64_t resetGeneration_ = 0;  // number of reset requests so far
+  std::vector<char> policyMessage_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,210 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+namespace policy_serialization {
+
+/**
+ * The binary policy format is a contiguous message for the transport of a policy between processes on the same machine (see
+ * MPC_SharedMemory_Interface). It starts with a fixed-size header followed by the arrays it describes. Every array starts at a multiple
+ * of 8 bytes and is stored in column-major order, such that a message placed in memory aligned to 8 bytes (e.g. std::vector, mmap)
+ * can be read in place. The scalars are stored in the native byte order.
+ */
+constexpr uint32_t magicNumber = 0x5053434f;  // "OCSP"
+constexpr uint32_t formatVersion = 2;
+
+/** The encoding of the feedback gains of a linear controller */
+enum class GainEncoding : uint32_t {
+  /** All gains in double precision */
+  Double = 0,
+  /**
+   * The first gain in double precision, followed by the single precision differences to the previous decoded gain. Halves the size of
+   * the gains. Since the differences are taken to the decoded gains, the rounding errors do not accumulate along the horizon.
+   */
+  DeltaFloat = 1,
+};
+
+/** Location of an array: offset in bytes from the start of the message, and the number of rows and columns. */
+struct ArrayDescriptor {
+  uint64_t offset = 0;
+  uint64_t rows = 0;
+  uint64_t cols = 0;
+};
+
+/** Header of a policy message. Column i of the trajectory arrays is the value at node i. */
+struct PolicyHeader {
+  uint32_t magic = magicNumber;
+  uint32_t version = formatVersion;
+  uint64_t size = 0;            // size of the message in bytes
+  uint64_t resetGeneration = 0;  // reset generation of the MPC that computed the policy, see ObservationHeader
+  uint32_t controllerType = 0;  // ControllerType, UNKNOWN if the solution has no controller
+  uint32_t gainEncoding = 0;    // GainEncoding
+  PerformanceIndex performance;
+
+  // CommandData
+  uint64_t observationMode = 0;
+  scalar_t observationTime = 0.0;
+  ArrayDescriptor observationState;  // scalar_t
+  ArrayDescriptor observationInput;  // scalar_t
+  ArrayDescriptor targetTime;        // scalar_t
+  ArrayDescriptor targetState;       // scalar_t
+  ArrayDescriptor targetInput;       // scalar_t
+
+  // PrimalSolution
+  ArrayDescriptor time;              // scalar_t
+  ArrayDescriptor state;             // scalar_t
+  ArrayDescriptor input;             // scalar_t
+  ArrayDescriptor postEventIndices;  // uint64_t
+  ArrayDescriptor eventTimes;        // scalar_t
+  ArrayDescriptor modeSequence;      // uint64_t
+
+  // Controller
+  ArrayDescriptor controllerTime;       // scalar_t
+  ArrayDescriptor controllerBias;       // scalar_t, the feedforward input of a FeedforwardController
+  ArrayDescriptor controllerGain;       // scalar_t, (inputDim * stateDim) x (numGains or 1 for GainEncoding::DeltaFloat)
+  ArrayDescriptor controllerGainDelta;  // float, (inputDim * stateDim) x (numGains - 1), only for GainEncoding::DeltaFloat
+};
+
+/** Header of an observation message, sent from the MRT to the MPC. */
+struct ObservationHeader {
+  uint32_t magic = magicNumber;
+  uint32_t version = formatVersion;
+  uint64_t size = 0;            // size of the message in bytes
+  uint64_t resetRequested = 0;  // whether the MPC should be reset with the target trajectories of the message
+  uint64_t resetGeneration = 0;  // number of reset requests of the MRT so far, including this one
+  uint64_t observationMode = 0;
+  scalar_t observationTime = 0.0;
+  ArrayDescriptor observationState;  // scalar_t
+  ArrayDescriptor observationInput;  // scalar_t
+  ArrayDescriptor targetTime;        // scalar_t
+  ArrayDescriptor targetState;       // scalar_t
+  ArrayDescriptor targetInput;       // scalar_t
+};
+
+/** Gets the size in bytes of the policy message. */
+size_t getPolicySize(const CommandData& command, const PrimalSolution& primalSolution, GainEncoding gainEncoding = GainEncoding::Double);
+
+/**
+ * Writes the policy message to the buffer. Only FeedforwardController and LinearController are supported.
+ *
+ * @param [in] command : The command data of the policy.
+ * @param [in] primalSolution : The policy.
+ * @param [in] performance : The performance indices of the policy.
+ * @param [in] gainEncoding : The encoding of the gains of a LinearController.
+ * @param [out] buffer : The message. Must be aligned to 8 bytes.
+ * @param [in] capacity : The size of the buffer, see getPolicySize().
+ * @param [in] resetGeneration : The reset generation of the MPC, see PolicyHeader::resetGeneration.
+ * @return The size of the message.
+ */
+size_t serializePolicy(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performance,
+                       GainEncoding gainEncoding, char* buffer, size_t capacity, uint64_t resetGeneration = 0);
+
+/** Writes the policy message to the buffer, which is resized to the message. */
+void serializePolicy(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performance,
+                     GainEncoding gainEncoding, std::vector<char>& buffer, uint64_t resetGeneration = 0);
+
+/**
+ * Reads a policy message in place. The message is validated on construction, an exception is thrown if it is malformed. The data is not
+ * copied and has to outlive the view.
+ */
+class PolicyView {
+ public:
+  PolicyView(const char* data, size_t size);
+
+  const PolicyHeader& getHeader() const { return *headerPtr_; }
+
+  /** The time trajectory of the primal solution */
+  Eigen::Map<const vector_t> getTimeTrajectory() const;
+
+  /** The state trajectory of the primal solution: column i is the state at node i */
+  Eigen::Map<const matrix_t> getStateTrajectory() const;
+
+  /** The input trajectory of the primal solution: column i is the input at node i */
+  Eigen::Map<const matrix_t> getInputTrajectory() const;
+
+  /** Copies the command data. The memory of the given object is reused if the sizes match. */
+  void getCommand(CommandData& command) const;
+
+  /** Copies the primal solution and decodes its controller. The memory of the given object is reused if the sizes match. */
+  void getPrimalSolution(PrimalSolution& primalSolution) const;
+
+  const PerformanceIndex& getPerformanceIndex() const { return getHeader().performance; }
+
+ private:
+  template <typename T>
+  const T* getArray(const ArrayDescriptor& descriptor) const {
+    return reinterpret_cast<const T*>(data_ + descriptor.offset);
+  }
+
+  const char* data_;
+  const PolicyHeader* headerPtr_;
+};
+
+/** Gets the size in bytes of the observation message. */
+size_t getObservationSize(const SystemObservation& observation, const TargetTrajectories* resetTargetTrajectoriesPtr);
+
+/**
+ * Writes the observation message to the buffer.
+ *
+ * @param [in] observation : The current observation.
+ * @param [in] resetTargetTrajectoriesPtr : If not null, requests a reset of the MPC with these target trajectories.
+ * @param [out] buffer : The message. Must be aligned to 8 bytes.
+ * @param [in] capacity : The size of the buffer, see getObservationSize().
+ * @param [in] resetGeneration : The number of reset requests so far, including this one. Only used with a reset request.
+ * @return The size of the message.
+ */
+size_t serializeObservation(const SystemObservation& observation, const TargetTrajectories* resetTargetTrajectoriesPtr, char* buffer,
+                            size_t capacity, uint64_t resetGeneration = 0);
+
+/**
+ * Reads an observation message. Throws an exception if the message is malformed.
+ *
+ * @param [in] data : The message. Must be aligned to 8 bytes.
+ * @param [in] size : The size of the message.
+ * @param [out] observation : The observation.
+ * @param [out] resetTargetTrajectories : The target trajectories of a reset request.
+ * @param [out] resetGenerationPtr : If not null, the reset generation of a reset request.
+ * @return Whether a reset of the MPC is requested.
+ */
+bool deserializeObservation(const char* data, size_t size, SystemObservation& observation, TargetTrajectories& resetTargetTrajectories,
+                            uint64_t* resetGenerationPtr = nullptr);
+
+}  // namespace policy_serialization
+}  // namespace ocs2
@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * A message buffer in POSIX shared memory for the transport of messages between processes on the same machine. It holds the latest
+ * message of a single writer, which is written in place. Readers copy the latest message out. The buffer is protected by a sequence
+ * counter (seqlock) which is odd while a message is written: a reader repeats its copy if the counter changed in between, up to a
+ * bounded number of attempts. Neither the writer nor the readers ever block.
+ */
+class SharedMemoryBuffer {
+ public:
+  /**
+   * Creates the buffer. A previous buffer with the same name is replaced. The buffer is removed from the system by the destructor.
+   *
+   * @param [in] name : The name of the shared memory object.
+   * @param [in] capacity : The maximum size of a message in bytes.
+   */
+  SharedMemoryBuffer(const std::string& name, size_t capacity);
+
+  /**
+   * Opens an existing buffer, created by another process.
+   *
+   * @param [in] name : The name of the shared memory object.
+   */
+  explicit SharedMemoryBuffer(const std::string& name);
+
+  ~SharedMemoryBuffer();
+
+  SharedMemoryBuffer(const SharedMemoryBuffer&) = delete;
+  SharedMemoryBuffer& operator=(const SharedMemoryBuffer&) = delete;
+
+  /** The maximum size of a message in bytes */
+  size_t getCapacity() const;
+
+  /**
+   * Writes a message in place. There must be a single writer.
+   *
+   * @param [in] size : The size of the message in bytes.
+   * @param [in] writeMessage : Writes the message to the given memory of the buffer, which is aligned to 64 bytes. It should not throw.
+   */
+  void write(size_t size, const std::function<void(char*)>& writeMessage);
+
+  /**
+   * Copies the latest message if it is newer than the last read one.
+   *
+   * @param [in, out] sequenceNumber : The sequence number of the last read message (initially 0), updated on a new message.
+   * @param [out] message : The copy of the message.
+   * @param [in] maxNumAttempts : The maximum number of attempts to get a consistent copy, e.g. while the writer is in the middle of a
+   * message or if it died while writing one.
+   * @return whether a new message was copied. False if there is no new message or no consistent copy within maxNumAttempts.
+   */
+  bool read(uint64_t& sequenceNumber, std::vector<char>& message, size_t maxNumAttempts = 1000) const;
+
+ private:
+  struct Control;
+
+  void map(int fileDescriptor, size_t size);
+
+  std::string name_;
+  bool isOwner_;
+  void* memoryPtr_ = nullptr;
+  size_t memorySize_ = 0;
+  Control* controlPtr_ = nullptr;
+  char* dataPtr_ = nullptr;
+};
+
+}  // namespace ocs2
@@ -51,8 +51,24 @@ void MPC_BASE::reset() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
-  // check if the current time exceeds the solver final limit
-  if (!initRun_ && currentTime >= getSolverPtr()->getFinalTime()) {
+  return runImpl(currentTime, currentState, nullptr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState, const PrimalSolution& initialGuess) {
+  return runImpl(currentTime, currentState, &initialGuess);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::runImpl(scalar_t currentTime, const vector_t& currentState, const PrimalSolution* initialGuessPtr) {
+  const bool useInitialGuess = initialGuessPtr != nullptr && !initialGuessPtr->timeTrajectory_.empty() && !mpcSettings_.coldStart_;
+
+  // check if the current time exceeds the solver final limit. With an initial guess, the previous solution of this instance is not used.
+  if (!initRun_ && !useInitialGuess && currentTime >= getSolverPtr()->getFinalTime()) {
     std::cerr << "WARNING: The MPC time-horizon is smaller than the MPC starting time.\n";
     std::cerr << "currentTime: " << currentTime << "\t Controller finalTime: " << getSolverPtr()->getFinalTime() << '\n';
     return false;
@@ -72,7 +88,11 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   }
 
   // calculate the MPC policy
-  calculateController(currentTime, currentState, finalTime);
+  if (useInitialGuess) {
+    calculateController(currentTime, currentState, finalTime, *initialGuessPtr);
+  } else {
+    calculateController(currentTime, currentState, finalTime);
+  }
 
   // set initRun flag to false
   initRun_ = false;
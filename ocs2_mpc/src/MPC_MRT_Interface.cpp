@@ -117,11 +117,10 @@ void MPC_MRT_Interface::advanceMpc() {
 /******************************************************************************************************/
 void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
   // policy
-  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
-  mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
+  auto primalSolutionPtr = mpc_.getSolverPtr()->getPrimalSolutionSnapshot(finalTime);
 
   // command
   auto commandPtr = std::make_unique<CommandData>();
@@ -0,0 +1,278 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_Pipeline_Interface.h"
+
+#include <limits>
+
+#include <ocs2_core/thread_support/SetThreadPriority.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Pipeline_Interface::MPC_Pipeline_Interface(std::vector<MPC_BASE*> mpcInstances, std::vector<int> threadPriorities)
+    : mpcInstances_(std::move(mpcInstances)), threadPriorities_(std::move(threadPriorities)), solveTimers_(mpcInstances_.size()) {
+  if (mpcInstances_.empty()) {
+    throw std::runtime_error("[MPC_Pipeline_Interface] At least one MPC instance is required!");
+  }
+  if (!threadPriorities_.empty() && threadPriorities_.size() != mpcInstances_.size()) {
+    throw std::runtime_error("[MPC_Pipeline_Interface] The number of thread priorities should match the number of MPC instances!");
+  }
+  for (size_t i = 0; i < mpcInstances_.size(); ++i) {
+    if (mpcInstances_[i] == nullptr) {
+      throw std::runtime_error("[MPC_Pipeline_Interface] MPC instance cannot be a nullptr!");
+    }
+    for (size_t j = 0; j < i; ++j) {
+      if (mpcInstances_[i]->getSolverPtr() == mpcInstances_[j]->getSolverPtr() ||
+          &mpcInstances_[i]->getSolverPtr()->getReferenceManager() == &mpcInstances_[j]->getSolverPtr()->getReferenceManager()) {
+        throw std::runtime_error("[MPC_Pipeline_Interface] Each MPC instance needs its own solver and ReferenceManager!");
+      }
+    }
+  }
+
+  lastStartedObservationTime_ = std::numeric_limits<scalar_t>::lowest();
+  lastPublishedStartTime_ = std::numeric_limits<scalar_t>::lowest();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Pipeline_Interface::~MPC_Pipeline_Interface() {
+  stop();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
+  stop();
+
+  for (auto* mpcPtr : mpcInstances_) {
+    mpcPtr->reset();
+  }
+  setTargetTrajectories(initTargetTrajectories);
+
+  {
+    std::lock_guard<std::mutex> lock(scheduleMutex_);
+    nextInstance_ = 0;
+    lastStartedObservationTime_ = std::numeric_limits<scalar_t>::lowest();
+    observationReceived_ = false;
+    solveStarted_ = false;
+    solveFinished_ = false;
+    totalSolveTimeInMilliseconds_ = 0.0;
+    numSolves_ = 0;
+  }
+  {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    lastPublishedStartTime_ = std::numeric_limits<scalar_t>::lowest();
+    latestSolutionPtr_.reset();
+  }
+  for (auto& timer : solveTimers_) {
+    timer.reset();
+  }
+  numPublished_ = 0;
+  numDropped_ = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  {
+    std::lock_guard<std::mutex> lock(scheduleMutex_);
+    currentObservation_ = currentObservation;
+    observationReceived_ = true;
+  }
+  scheduleCondition_.notify_all();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::setTargetTrajectories(const TargetTrajectories& targetTrajectories) {
+  const auto targetTrajectoriesPtr = std::make_shared<const TargetTrajectories>(targetTrajectories);
+  for (auto* mpcPtr : mpcInstances_) {
+    mpcPtr->getSolverPtr()->getReferenceManager().setTargetTrajectoriesSnapshot(targetTrajectoriesPtr);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ReferenceManagerInterface& MPC_Pipeline_Interface::getReferenceManager(size_t instance) {
+  return mpcInstances_.at(instance)->getSolverPtr()->getReferenceManager();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::start() {
+  if (isRunning_) {
+    return;
+  }
+
+  isRunning_ = true;
+  workers_.reserve(mpcInstances_.size());
+  for (size_t i = 0; i < mpcInstances_.size(); ++i) {
+    workers_.emplace_back([this, i]() { instanceWorker(i); });
+    if (!threadPriorities_.empty()) {
+      setThreadPriority(threadPriorities_[i], workers_.back());
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::stop() {
+  {
+    std::lock_guard<std::mutex> lock(scheduleMutex_);
+    isRunning_ = false;
+  }
+  scheduleCondition_.notify_all();
+
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t MPC_Pipeline_Interface::getAverageSolveTimeInMilliseconds() const {
+  std::lock_guard<std::mutex> lock(scheduleMutex_);
+  return (numSolves_ > 0) ? totalSolveTimeInMilliseconds_ / numSolves_ : 0.0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::instanceWorker(size_t instance) {
+  const auto numInstances = mpcInstances_.size();
+  auto& mpc = *mpcInstances_[instance];
+  auto& solveTimer = solveTimers_[instance];
+
+  while (isRunning_) {
+    SystemObservation observation;
+    {
+      std::unique_lock<std::mutex> lock(scheduleMutex_);
+
+      // Wait for the turn of this instance and for an observation which is newer than the last started solve. Until the first solve
+      // has finished, the other instances wait, since they would not have a warm start.
+      scheduleCondition_.wait(lock, [&]() {
+        const bool isTurn = nextInstance_ == instance && (!solveStarted_ || solveFinished_);
+        const bool hasNewObservation = observationReceived_ && currentObservation_.time > lastStartedObservationTime_;
+        return !isRunning_ || (isTurn && hasNewObservation);
+      });
+
+      // Stagger the start with respect to the previous instance
+      while (isRunning_ && std::chrono::steady_clock::now() < nextStartTime_) {
+        scheduleCondition_.wait_until(lock, nextStartTime_);
+      }
+      if (!isRunning_) {
+        break;
+      }
+
+      observation = currentObservation_;
+      lastStartedObservationTime_ = observation.time;
+      solveStarted_ = true;
+      nextInstance_ = (instance + 1) % numInstances;
+      const scalar_t averageSolveTime = (numSolves_ > 0) ? totalSolveTimeInMilliseconds_ / numSolves_ : 0.0;
+      nextStartTime_ = std::chrono::steady_clock::now() +
+                       std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<scalar_t, std::milli>(averageSolveTime / static_cast<scalar_t>(numInstances)));
+    }
+    scheduleCondition_.notify_all();
+
+    // Warm start from the newest finished solution
+    std::shared_ptr<const PrimalSolution> initialGuessPtr;
+    {
+      std::lock_guard<std::mutex> lock(publishMutex_);
+      initialGuessPtr = latestSolutionPtr_;
+    }
+
+    solveTimer.startTimer();
+    const bool isUpdated = (initialGuessPtr != nullptr) ? mpc.run(observation.time, observation.state, *initialGuessPtr)
+                                                        : mpc.run(observation.time, observation.state);
+    solveTimer.endTimer();
+
+    if (isUpdated) {
+      publish(instance, observation);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(scheduleMutex_);
+      solveFinished_ = true;
+      totalSolveTimeInMilliseconds_ += solveTimer.getLastIntervalInMilliseconds();
+      ++numSolves_;
+    }
+    scheduleCondition_.notify_all();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline_Interface::publish(size_t instance, const SystemObservation& mpcInitObservation) {
+  const auto& mpc = *mpcInstances_[instance];
+  const auto& solver = *mpc.getSolverPtr();
+
+  // The solution over the whole horizon is kept for warm starting
+  auto solutionPtr = solver.getPrimalSolutionSnapshot(solver.getFinalTime());
+
+  // policy
+  auto primalSolutionPtr = (mpc.settings().solutionTimeWindow_ < 0)
+                               ? solutionPtr
+                               : solver.getPrimalSolutionSnapshot(mpcInitObservation.time + mpc.settings().solutionTimeWindow_);
+
+  // command
+  auto commandPtr = std::make_unique<CommandData>();
+  commandPtr->mpcInitObservation_ = mpcInitObservation;
+  commandPtr->mpcTargetTrajectories_ = solver.getReferenceManager().getTargetTrajectories();
+
+  // performance indices
+  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>(solver.getPerformanceIndeces());
+
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  if (mpcInitObservation.time > lastPublishedStartTime_) {
+    lastPublishedStartTime_ = mpcInitObservation.time;
+    latestSolutionPtr_ = std::move(solutionPtr);
+    this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+    ++numPublished_;
+  } else {
+    ++numDropped_;
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_SharedMemory_Interface.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_SharedMemory_Interface::MPC_SharedMemory_Interface(MPC_BASE& mpc, const std::string& name,
+                                                       policy_serialization::GainEncoding gainEncoding, size_t policyCapacity,
+                                                       size_t observationCapacity)
+    : mpc_(mpc),
+      gainEncoding_(gainEncoding),
+      policyBuffer_(name + "_policy", policyCapacity),
+      observationBuffer_(name + "_observation", observationCapacity),
+      resetBuffer_(name + "_reset", observationCapacity) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_SharedMemory_Interface::spinOnce() {
+  if (!readObservation(observation_)) {
+    return false;
+  }
+
+  // The MRT writes a reset request before the next observation: it is visible once that observation is.
+  if (resetBuffer_.read(resetSequenceNumber_, message_)) {
+    SystemObservation unused;
+    policy_serialization::deserializeObservation(message_.data(), message_.size(), unused, resetTargetTrajectories_, &resetGeneration_);
+    mpc_.reset();
+    mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(resetTargetTrajectories_);
+  }
+
+  if (!mpc_.run(observation_.time, observation_.state)) {
+    return false;
+  }
+
+  // policy
+  const auto& solver = *mpc_.getSolverPtr();
+  const scalar_t finalTime =
+      (mpc_.settings().solutionTimeWindow_ < 0) ? solver.getFinalTime() : observation_.time + mpc_.settings().solutionTimeWindow_;
+  const auto primalSolutionPtr = solver.getPrimalSolutionSnapshot(finalTime);
+
+  // command
+  CommandData command;
+  command.mpcInitObservation_ = observation_;
+  command.mpcTargetTrajectories_ = solver.getReferenceManager().getTargetTrajectories();
+
+  publishPolicy(command, *primalSolutionPtr, solver.getPerformanceIndeces());
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_SharedMemory_Interface::readObservation(SystemObservation& observation) {
+  if (!observationBuffer_.read(observationSequenceNumber_, message_)) {
+    return false;
+  }
+  policy_serialization::deserializeObservation(message_.data(), message_.size(), observation, resetTargetTrajectories_);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_SharedMemory_Interface::publishPolicy(const CommandData& command, const PrimalSolution& primalSolution,
+                                               const PerformanceIndex& performance) {
+  const size_t size = policy_serialization::getPolicySize(command, primalSolution, gainEncoding_);
+  policyBuffer_.write(size, [&](char* data) {
+    policy_serialization::serializePolicy(command, primalSolution, performance, gainEncoding_, data, size, resetGeneration_);
+  });
+}
+
+}  // namespace ocs2
@@ -54,6 +54,8 @@ void MRT_BASE::reset() {
   bufferCommandPtr_.reset();
   activePrimalSolutionPtr_.reset();
   bufferPrimalSolutionPtr_.reset();
+  activeModifiablePrimalSolutionPtr_.reset();
+  bufferModifiablePrimalSolutionPtr_.reset();
   activePerformanceIndicesPtr_.reset();
   bufferPerformanceIndicesPtr_.reset();
 }
@@ -141,13 +143,15 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  // the active solution can be shared with the solver, the rollout writes to a copy of the mode schedule
+  ModeSchedule modeSchedule = activePrimalSolutionPtr_->modeSchedule_;
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(), modeSchedule, timeTrajectory,
+                   postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = modeSchedule.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
@@ -161,10 +165,18 @@ bool MRT_BASE::updatePolicy() {
       // update the active solution from buffer
       activeCommandPtr_.swap(bufferCommandPtr_);
       activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
+      activeModifiablePrimalSolutionPtr_.swap(bufferModifiablePrimalSolutionPtr_);
       activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
       newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
 
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
+      if (!observerPtrArray_.empty()) {
+        // a shared snapshot buffered before the observers were added
+        if (activeModifiablePrimalSolutionPtr_ == nullptr) {
+          activeModifiablePrimalSolutionPtr_ = std::make_shared<PrimalSolution>(*activePrimalSolutionPtr_);
+          activePrimalSolutionPtr_ = activeModifiablePrimalSolutionPtr_;
+        }
+        modifyActiveSolution(*activeCommandPtr_, *activeModifiablePrimalSolutionPtr_);
+      }
       return true;
     } else {
       return false;  // No policy update: the buffer contains nothing new.
@@ -184,14 +196,43 @@ bool MRT_BASE::updatePolicy() {
 /******************************************************************************************************/
 void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                             std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
-  if (commandDataPtr == nullptr) {
-    throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
+  if (primalSolutionPtr == nullptr) {
+    throw std::runtime_error("[MRT_BASE::moveToBuffer] primalSolutionPtr cannot be a null pointer!");
   }
 
+  std::shared_ptr<PrimalSolution> modifiablePrimalSolutionPtr(std::move(primalSolutionPtr));
+  std::shared_ptr<const PrimalSolution> sharedPrimalSolutionPtr = modifiablePrimalSolutionPtr;
+  swapToBuffer(commandDataPtr, sharedPrimalSolutionPtr, modifiablePrimalSolutionPtr, performanceIndicesPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::shared_ptr<const PrimalSolution> primalSolutionPtr,
+                            std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
   if (primalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::moveToBuffer] primalSolutionPtr cannot be a null pointer!");
   }
 
+  // the observers modify the solution, which requires a private copy of the snapshot
+  std::shared_ptr<PrimalSolution> modifiablePrimalSolutionPtr;
+  if (!observerPtrArray_.empty()) {
+    modifiablePrimalSolutionPtr = std::make_shared<PrimalSolution>(*primalSolutionPtr);
+    primalSolutionPtr = modifiablePrimalSolutionPtr;
+  }
+  swapToBuffer(commandDataPtr, primalSolutionPtr, modifiablePrimalSolutionPtr, performanceIndicesPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::swapToBuffer(std::unique_ptr<CommandData>& commandDataPtr, std::shared_ptr<const PrimalSolution>& primalSolutionPtr,
+                            std::shared_ptr<PrimalSolution>& modifiablePrimalSolutionPtr,
+                            std::unique_ptr<PerformanceIndex>& performanceIndicesPtr) {
+  if (commandDataPtr == nullptr) {
+    throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
+  }
+
   if (performanceIndicesPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
@@ -200,10 +241,13 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
   // use swap such that the old objects are destroyed after releasing the lock.
   bufferCommandPtr_.swap(commandDataPtr);
   bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
+  bufferModifiablePrimalSolutionPtr_.swap(modifiablePrimalSolutionPtr);
   bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  if (bufferModifiablePrimalSolutionPtr_ != nullptr) {
+    modifyBufferedSolution(*bufferCommandPtr_, *bufferModifiablePrimalSolutionPtr_);
+  }
 
   newPolicyInBuffer_ = true;
   policyReceivedEver_ = true;
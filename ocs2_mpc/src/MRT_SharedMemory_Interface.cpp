@@ -0,0 +1,86 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MRT_SharedMemory_Interface.h"
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MRT_SharedMemory_Interface::MRT_SharedMemory_Interface(const std::string& name)
+    : policyBuffer_(name + "_policy"), observationBuffer_(name + "_observation"), resetBuffer_(name + "_reset") {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
+  this->reset();
+  ++resetGeneration_;
+
+  const SystemObservation noObservation;
+  const size_t size = policy_serialization::getObservationSize(noObservation, &initTargetTrajectories);
+  resetBuffer_.write(size, [&](char* data) {
+    policy_serialization::serializeObservation(noObservation, &initTargetTrajectories, data, size, resetGeneration_);
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_SharedMemory_Interface::setCurrentObservation(const SystemObservation& currentObservation) {
+  const size_t size = policy_serialization::getObservationSize(currentObservation, nullptr);
+  observationBuffer_.write(size, [&](char* data) { policy_serialization::serializeObservation(currentObservation, nullptr, data, size); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MRT_SharedMemory_Interface::spinMRT() {
+  if (!policyBuffer_.read(policySequenceNumber_, policyMessage_)) {
+    return false;
+  }
+
+  const policy_serialization::PolicyView policy(policyMessage_.data(), policyMessage_.size());
+  if (policy.getHeader().resetGeneration != resetGeneration_) {
+    return false;  // computed before the last reset request was handled
+  }
+  auto commandPtr = std::make_unique<CommandData>();
+  policy.getCommand(*commandPtr);
+  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+  policy.getPrimalSolution(*primalSolutionPtr);
+  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>(policy.getPerformanceIndex());
+
+  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  return true;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,592 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+namespace ocs2 {
+namespace policy_serialization {
+
+static_assert(std::is_trivially_copyable<PolicyHeader>::value, "The policy header is copied as raw memory.");
+static_assert(std::is_trivially_copyable<ObservationHeader>::value, "The observation header is copied as raw memory.");
+
+namespace {
+
+using float_matrix_t = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+
+constexpr size_t alignment = 8;
+
+size_t alignSize(size_t size) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+/** Places the arrays of a message one after the other, behind the header. */
+class Layout {
+ public:
+  explicit Layout(size_t headerSize) : size_(alignSize(headerSize)) {}
+
+  ArrayDescriptor add(size_t rows, size_t cols, size_t scalarSize) {
+    ArrayDescriptor descriptor;
+    descriptor.offset = size_;
+    descriptor.rows = rows;
+    descriptor.cols = cols;
+    size_ += alignSize(rows * cols * scalarSize);
+    return descriptor;
+  }
+
+  ArrayDescriptor addVector(const vector_t& vector) { return add(vector.size(), 1, sizeof(scalar_t)); }
+
+  template <typename T>
+  ArrayDescriptor addArray(const std::vector<T>& array) {
+    return add(array.size(), 1, sizeof(typename std::conditional<std::is_floating_point<T>::value, scalar_t, uint64_t>::type));
+  }
+
+  ArrayDescriptor addVectors(const vector_array_t& trajectory) {
+    const Eigen::Index rows = trajectory.empty() ? 0 : trajectory.front().size();
+    for (const auto& vector : trajectory) {
+      if (vector.size() != rows) {
+        throw std::runtime_error("[policy_serialization] The vectors of a trajectory must have the same size!");
+      }
+    }
+    return add(rows, trajectory.size(), sizeof(scalar_t));
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  size_t size_;
+};
+
+/** Adds the controller gains, flattened to (inputDim * stateDim) x numGains. */
+void addGains(const matrix_array_t& gains, GainEncoding gainEncoding, Layout& layout, PolicyHeader& header) {
+  const Eigen::Index rows = gains.empty() ? 0 : gains.front().rows();
+  const Eigen::Index cols = gains.empty() ? 0 : gains.front().cols();
+  for (const auto& gain : gains) {
+    if (gain.rows() != rows || gain.cols() != cols) {
+      throw std::runtime_error("[policy_serialization] The gains of a controller must have the same size!");
+    }
+  }
+
+  header.gainEncoding = static_cast<uint32_t>(gainEncoding);
+  switch (gainEncoding) {
+    case GainEncoding::Double:
+      header.controllerGain = layout.add(rows * cols, gains.size(), sizeof(scalar_t));
+      break;
+    case GainEncoding::DeltaFloat:
+      header.controllerGain = layout.add(rows * cols, std::min<size_t>(gains.size(), 1), sizeof(scalar_t));
+      header.controllerGainDelta = layout.add(rows * cols, gains.empty() ? 0 : gains.size() - 1, sizeof(float));
+      break;
+    default:
+      throw std::runtime_error("[policy_serialization] Unknown gain encoding!");
+  }
+}
+
+PolicyHeader getPolicyLayout(const CommandData& command, const PrimalSolution& primalSolution, GainEncoding gainEncoding) {
+  Layout layout(sizeof(PolicyHeader));
+  PolicyHeader header;
+
+  header.observationState = layout.addVector(command.mpcInitObservation_.state);
+  header.observationInput = layout.addVector(command.mpcInitObservation_.input);
+  header.targetTime = layout.addArray(command.mpcTargetTrajectories_.timeTrajectory);
+  header.targetState = layout.addVectors(command.mpcTargetTrajectories_.stateTrajectory);
+  header.targetInput = layout.addVectors(command.mpcTargetTrajectories_.inputTrajectory);
+
+  header.time = layout.addArray(primalSolution.timeTrajectory_);
+  header.state = layout.addVectors(primalSolution.stateTrajectory_);
+  header.input = layout.addVectors(primalSolution.inputTrajectory_);
+  header.postEventIndices = layout.addArray(primalSolution.postEventIndices_);
+  header.eventTimes = layout.addArray(primalSolution.modeSchedule_.eventTimes);
+  header.modeSequence = layout.addArray(primalSolution.modeSchedule_.modeSequence);
+
+  const auto* controllerPtr = primalSolution.controllerPtr_.get();
+  header.controllerType = static_cast<uint32_t>(controllerPtr != nullptr ? controllerPtr->getType() : ControllerType::UNKNOWN);
+  if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr)) {
+    header.controllerTime = layout.addArray(feedforwardControllerPtr->timeStamp_);
+    header.controllerBias = layout.addVectors(feedforwardControllerPtr->uffArray_);
+  } else if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr)) {
+    header.controllerTime = layout.addArray(linearControllerPtr->timeStamp_);
+    header.controllerBias = layout.addVectors(linearControllerPtr->biasArray_);
+    addGains(linearControllerPtr->gainArray_, gainEncoding, layout, header);
+  } else if (controllerPtr != nullptr) {
+    throw std::runtime_error("[policy_serialization] Only FeedforwardController and LinearController are supported!");
+  }
+
+  header.size = layout.size();
+  return header;
+}
+
+ObservationHeader getObservationLayout(const SystemObservation& observation, const TargetTrajectories* resetTargetTrajectoriesPtr) {
+  Layout layout(sizeof(ObservationHeader));
+  ObservationHeader header;
+
+  header.observationState = layout.addVector(observation.state);
+  header.observationInput = layout.addVector(observation.input);
+  if (resetTargetTrajectoriesPtr != nullptr) {
+    header.resetRequested = 1;
+    header.targetTime = layout.addArray(resetTargetTrajectoriesPtr->timeTrajectory);
+    header.targetState = layout.addVectors(resetTargetTrajectoriesPtr->stateTrajectory);
+    header.targetInput = layout.addVectors(resetTargetTrajectoriesPtr->inputTrajectory);
+  }
+
+  header.size = layout.size();
+  return header;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+T* getArray(char* buffer, const ArrayDescriptor& descriptor) {
+  return reinterpret_cast<T*>(buffer + descriptor.offset);
+}
+
+template <typename T>
+const T* getArray(const char* buffer, const ArrayDescriptor& descriptor) {
+  return reinterpret_cast<const T*>(buffer + descriptor.offset);
+}
+
+void checkBuffer(const char* buffer, size_t capacity, size_t size) {
+  if (reinterpret_cast<uintptr_t>(buffer) % alignment != 0) {
+    throw std::runtime_error("[policy_serialization] The buffer must be aligned to 8 bytes!");
+  }
+  if (capacity < size) {
+    throw std::runtime_error("[policy_serialization] The buffer of " + std::to_string(capacity) +
+                             " bytes is too small for the message of " + std::to_string(size) + " bytes!");
+  }
+}
+
+void writeScalars(const scalar_array_t& array, const ArrayDescriptor& descriptor, char* buffer) {
+  std::copy(array.begin(), array.end(), getArray<scalar_t>(buffer, descriptor));
+}
+
+void writeIndices(const size_array_t& array, const ArrayDescriptor& descriptor, char* buffer) {
+  std::copy(array.begin(), array.end(), getArray<uint64_t>(buffer, descriptor));
+}
+
+void writeVector(const vector_t& vector, const ArrayDescriptor& descriptor, char* buffer) {
+  Eigen::Map<vector_t>(getArray<scalar_t>(buffer, descriptor), descriptor.rows) = vector;
+}
+
+void writeVectors(const vector_array_t& trajectory, const ArrayDescriptor& descriptor, char* buffer) {
+  Eigen::Map<matrix_t> matrix(getArray<scalar_t>(buffer, descriptor), descriptor.rows, descriptor.cols);
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    matrix.col(i) = trajectory[i];
+  }
+}
+
+void writeGains(const matrix_array_t& gains, const PolicyHeader& header, char* buffer) {
+  if (gains.empty()) {
+    return;
+  }
+  const auto rows = gains.front().rows();
+  const auto cols = gains.front().cols();
+  const auto size = rows * cols;
+
+  auto* gainPtr = getArray<scalar_t>(buffer, header.controllerGain);
+  if (static_cast<GainEncoding>(header.gainEncoding) == GainEncoding::Double) {
+    for (size_t i = 0; i < gains.size(); ++i) {
+      Eigen::Map<matrix_t>(gainPtr + i * size, rows, cols) = gains[i];
+    }
+  } else {
+    Eigen::Map<matrix_t> decodedGain(gainPtr, rows, cols);
+    decodedGain = gains.front();
+    matrix_t previousGain = decodedGain;
+    auto* deltaPtr = getArray<float>(buffer, header.controllerGainDelta);
+    for (size_t i = 1; i < gains.size(); ++i) {
+      Eigen::Map<float_matrix_t> delta(deltaPtr + (i - 1) * size, rows, cols);
+      delta = (gains[i] - previousGain).cast<float>();
+      previousGain += delta.cast<scalar_t>();  // the same operation as the decoding
+    }
+  }
+}
+
+void writeTargetTrajectories(const TargetTrajectories& targetTrajectories, const ArrayDescriptor& timeDescriptor,
+                             const ArrayDescriptor& stateDescriptor, const ArrayDescriptor& inputDescriptor, char* buffer) {
+  writeScalars(targetTrajectories.timeTrajectory, timeDescriptor, buffer);
+  writeVectors(targetTrajectories.stateTrajectory, stateDescriptor, buffer);
+  writeVectors(targetTrajectories.inputTrajectory, inputDescriptor, buffer);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Header>
+const Header& checkHeader(const char* data, size_t size) {
+  if (reinterpret_cast<uintptr_t>(data) % alignment != 0) {
+    throw std::runtime_error("[policy_serialization] The message must be aligned to 8 bytes!");
+  }
+  if (size < sizeof(Header)) {
+    throw std::runtime_error("[policy_serialization] The message is smaller than its header!");
+  }
+  const auto& header = *reinterpret_cast<const Header*>(data);
+  if (header.magic != magicNumber) {
+    throw std::runtime_error("[policy_serialization] The message is not an OCS2 policy message!");
+  }
+  if (header.version != formatVersion) {
+    throw std::runtime_error("[policy_serialization] Unsupported format version " + std::to_string(header.version) + "!");
+  }
+  if (header.size > size) {
+    throw std::runtime_error("[policy_serialization] The message is truncated!");
+  }
+  return header;
+}
+
+void checkArray(const ArrayDescriptor& descriptor, size_t scalarSize, size_t size) {
+  if (descriptor.offset % alignment != 0 || descriptor.offset > size) {
+    throw std::runtime_error("[policy_serialization] Invalid array offset!");
+  }
+  const size_t available = (size - descriptor.offset) / scalarSize;
+  if (descriptor.rows != 0 && descriptor.cols > available / descriptor.rows) {
+    throw std::runtime_error("[policy_serialization] An array exceeds the message!");
+  }
+}
+
+void checkCols(const ArrayDescriptor& descriptor, size_t cols) {
+  if (descriptor.cols != cols) {
+    throw std::runtime_error("[policy_serialization] Inconsistent trajectory lengths!");
+  }
+}
+
+void readScalars(const char* data, const ArrayDescriptor& descriptor, scalar_array_t& array) {
+  const auto* begin = getArray<scalar_t>(data, descriptor);
+  array.assign(begin, begin + descriptor.rows * descriptor.cols);
+}
+
+void readIndices(const char* data, const ArrayDescriptor& descriptor, size_array_t& array) {
+  const auto* begin = getArray<uint64_t>(data, descriptor);
+  array.assign(begin, begin + descriptor.rows * descriptor.cols);
+}
+
+void readVector(const char* data, const ArrayDescriptor& descriptor, vector_t& vector) {
+  vector = Eigen::Map<const vector_t>(getArray<scalar_t>(data, descriptor), descriptor.rows);
+}
+
+void readVectors(const char* data, const ArrayDescriptor& descriptor, vector_array_t& trajectory) {
+  const auto* begin = getArray<scalar_t>(data, descriptor);
+  trajectory.resize(descriptor.cols);
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    trajectory[i] = Eigen::Map<const vector_t>(begin + i * descriptor.rows, descriptor.rows);
+  }
+}
+
+void readGains(const char* data, const PolicyHeader& header, matrix_array_t& gains) {
+  const size_t inputDim = header.controllerBias.rows;
+  const size_t stateDim = inputDim > 0 ? header.controllerGain.rows / inputDim : 0;
+  const size_t size = inputDim * stateDim;
+
+  const auto* gainPtr = getArray<scalar_t>(data, header.controllerGain);
+  if (static_cast<GainEncoding>(header.gainEncoding) == GainEncoding::Double) {
+    gains.resize(header.controllerGain.cols);
+    for (size_t i = 0; i < gains.size(); ++i) {
+      gains[i] = Eigen::Map<const matrix_t>(gainPtr + i * size, inputDim, stateDim);
+    }
+  } else {
+    gains.resize(header.controllerGain.cols + header.controllerGainDelta.cols);
+    if (!gains.empty()) {
+      gains.front() = Eigen::Map<const matrix_t>(gainPtr, inputDim, stateDim);
+    }
+    const auto* deltaPtr = getArray<float>(data, header.controllerGainDelta);
+    for (size_t i = 1; i < gains.size(); ++i) {
+      gains[i] = gains[i - 1];
+      gains[i] += Eigen::Map<const float_matrix_t>(deltaPtr + (i - 1) * size, inputDim, stateDim).cast<scalar_t>();
+    }
+  }
+}
+
+void readTargetTrajectories(const char* data, const ArrayDescriptor& timeDescriptor, const ArrayDescriptor& stateDescriptor,
+                            const ArrayDescriptor& inputDescriptor, TargetTrajectories& targetTrajectories) {
+  readScalars(data, timeDescriptor, targetTrajectories.timeTrajectory);
+  readVectors(data, stateDescriptor, targetTrajectories.stateTrajectory);
+  readVectors(data, inputDescriptor, targetTrajectories.inputTrajectory);
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getPolicySize(const CommandData& command, const PrimalSolution& primalSolution, GainEncoding gainEncoding) {
+  return getPolicyLayout(command, primalSolution, gainEncoding).size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t serializePolicy(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performance,
+                       GainEncoding gainEncoding, char* buffer, size_t capacity, uint64_t resetGeneration) {
+  auto header = getPolicyLayout(command, primalSolution, gainEncoding);
+  checkBuffer(buffer, capacity, header.size);
+  header.resetGeneration = resetGeneration;
+  header.performance = performance;
+  header.observationMode = command.mpcInitObservation_.mode;
+  header.observationTime = command.mpcInitObservation_.time;
+  std::memcpy(buffer, &header, sizeof(PolicyHeader));
+
+  writeVector(command.mpcInitObservation_.state, header.observationState, buffer);
+  writeVector(command.mpcInitObservation_.input, header.observationInput, buffer);
+  writeTargetTrajectories(command.mpcTargetTrajectories_, header.targetTime, header.targetState, header.targetInput, buffer);
+
+  writeScalars(primalSolution.timeTrajectory_, header.time, buffer);
+  writeVectors(primalSolution.stateTrajectory_, header.state, buffer);
+  writeVectors(primalSolution.inputTrajectory_, header.input, buffer);
+  writeIndices(primalSolution.postEventIndices_, header.postEventIndices, buffer);
+  writeScalars(primalSolution.modeSchedule_.eventTimes, header.eventTimes, buffer);
+  writeIndices(primalSolution.modeSchedule_.modeSequence, header.modeSequence, buffer);
+
+  const auto* controllerPtr = primalSolution.controllerPtr_.get();
+  if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(controllerPtr)) {
+    writeScalars(feedforwardControllerPtr->timeStamp_, header.controllerTime, buffer);
+    writeVectors(feedforwardControllerPtr->uffArray_, header.controllerBias, buffer);
+  } else if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(controllerPtr)) {
+    writeScalars(linearControllerPtr->timeStamp_, header.controllerTime, buffer);
+    writeVectors(linearControllerPtr->biasArray_, header.controllerBias, buffer);
+    writeGains(linearControllerPtr->gainArray_, header, buffer);
+  }
+
+  return header.size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void serializePolicy(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performance,
+                     GainEncoding gainEncoding, std::vector<char>& buffer, uint64_t resetGeneration) {
+  buffer.resize(getPolicySize(command, primalSolution, gainEncoding));
+  serializePolicy(command, primalSolution, performance, gainEncoding, buffer.data(), buffer.size(), resetGeneration);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyView::PolicyView(const char* data, size_t size) : data_(data), headerPtr_(&checkHeader<PolicyHeader>(data, size)) {
+  const auto& header = getHeader();
+  for (const auto* descriptorPtr : {&header.observationState, &header.observationInput, &header.targetTime, &header.targetState,
+                                    &header.targetInput, &header.time, &header.state, &header.input, &header.eventTimes,
+                                    &header.controllerTime, &header.controllerBias, &header.controllerGain}) {
+    checkArray(*descriptorPtr, sizeof(scalar_t), header.size);
+  }
+  checkArray(header.postEventIndices, sizeof(uint64_t), header.size);
+  checkArray(header.modeSequence, sizeof(uint64_t), header.size);
+  checkArray(header.controllerGainDelta, sizeof(float), header.size);
+
+  // The time, event and index arrays are single columns
+  for (const auto* descriptorPtr :
+       {&header.targetTime, &header.time, &header.postEventIndices, &header.eventTimes, &header.modeSequence}) {
+    checkCols(*descriptorPtr, 1);
+  }
+  checkCols(header.state, header.time.rows);
+  checkCols(header.input, header.time.rows);
+  checkCols(header.targetState, header.targetTime.rows);
+  if (header.targetInput.cols > 0) {
+    checkCols(header.targetInput, header.targetTime.rows);
+  }
+  checkCols(header.controllerBias, header.controllerTime.rows);
+  if (header.modeSequence.rows != header.eventTimes.rows + 1) {
+    throw std::runtime_error("[policy_serialization] The mode sequence does not match the event times!");
+  }
+
+  // The post event indices point into the time trajectory, in increasing order
+  const auto* postEventIndices = getArray<uint64_t>(header.postEventIndices);
+  const size_t numPostEventIndices = header.postEventIndices.rows * header.postEventIndices.cols;
+  for (size_t i = 0; i < numPostEventIndices; ++i) {
+    if (postEventIndices[i] > header.time.rows || (i > 0 && postEventIndices[i] < postEventIndices[i - 1])) {
+      throw std::runtime_error("[policy_serialization] Invalid post event indices!");
+    }
+  }
+
+  switch (static_cast<ControllerType>(header.controllerType)) {
+    case ControllerType::UNKNOWN:
+    case ControllerType::FEEDFORWARD:
+      break;
+    case ControllerType::LINEAR: {
+      const size_t inputDim = header.controllerBias.rows;
+      if (inputDim > 0 && header.controllerGain.rows % inputDim != 0) {
+        throw std::runtime_error("[policy_serialization] The gains do not match the input dimension!");
+      }
+      const auto gainEncoding = static_cast<GainEncoding>(header.gainEncoding);
+      if (gainEncoding == GainEncoding::Double) {
+        checkCols(header.controllerGain, header.controllerTime.rows);
+      } else if (gainEncoding == GainEncoding::DeltaFloat) {
+        checkCols(header.controllerGain, std::min<size_t>(header.controllerTime.rows, 1));
+        checkCols(header.controllerGainDelta, header.controllerTime.rows - header.controllerGain.cols);
+        if (header.controllerGainDelta.rows != header.controllerGain.rows) {
+          throw std::runtime_error("[policy_serialization] The gain differences do not match the gains!");
+        }
+      } else {
+        throw std::runtime_error("[policy_serialization] Unknown gain encoding!");
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("[policy_serialization] Unsupported controller type!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Eigen::Map<const vector_t> PolicyView::getTimeTrajectory() const {
+  const auto& descriptor = getHeader().time;
+  return {getArray<scalar_t>(descriptor), static_cast<Eigen::Index>(descriptor.rows)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Eigen::Map<const matrix_t> PolicyView::getStateTrajectory() const {
+  const auto& descriptor = getHeader().state;
+  return {getArray<scalar_t>(descriptor), static_cast<Eigen::Index>(descriptor.rows), static_cast<Eigen::Index>(descriptor.cols)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Eigen::Map<const matrix_t> PolicyView::getInputTrajectory() const {
+  const auto& descriptor = getHeader().input;
+  return {getArray<scalar_t>(descriptor), static_cast<Eigen::Index>(descriptor.rows), static_cast<Eigen::Index>(descriptor.cols)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyView::getCommand(CommandData& command) const {
+  const auto& header = getHeader();
+  command.mpcInitObservation_.mode = header.observationMode;
+  command.mpcInitObservation_.time = header.observationTime;
+  readVector(data_, header.observationState, command.mpcInitObservation_.state);
+  readVector(data_, header.observationInput, command.mpcInitObservation_.input);
+  readTargetTrajectories(data_, header.targetTime, header.targetState, header.targetInput, command.mpcTargetTrajectories_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyView::getPrimalSolution(PrimalSolution& primalSolution) const {
+  const auto& header = getHeader();
+  readScalars(data_, header.time, primalSolution.timeTrajectory_);
+  readVectors(data_, header.state, primalSolution.stateTrajectory_);
+  readVectors(data_, header.input, primalSolution.inputTrajectory_);
+  readIndices(data_, header.postEventIndices, primalSolution.postEventIndices_);
+  readScalars(data_, header.eventTimes, primalSolution.modeSchedule_.eventTimes);
+  readIndices(data_, header.modeSequence, primalSolution.modeSchedule_.modeSequence);
+
+  // the controller is reused if it has the right type
+  switch (static_cast<ControllerType>(header.controllerType)) {
+    case ControllerType::FEEDFORWARD: {
+      auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolution.controllerPtr_.get());
+      if (controllerPtr == nullptr) {
+        controllerPtr = new FeedforwardController();
+        primalSolution.controllerPtr_.reset(controllerPtr);
+      }
+      readScalars(data_, header.controllerTime, controllerPtr->timeStamp_);
+      readVectors(data_, header.controllerBias, controllerPtr->uffArray_);
+      break;
+    }
+    case ControllerType::LINEAR: {
+      auto* controllerPtr = dynamic_cast<LinearController*>(primalSolution.controllerPtr_.get());
+      if (controllerPtr == nullptr) {
+        controllerPtr = new LinearController();
+        primalSolution.controllerPtr_.reset(controllerPtr);
+      }
+      readScalars(data_, header.controllerTime, controllerPtr->timeStamp_);
+      readVectors(data_, header.controllerBias, controllerPtr->biasArray_);
+      controllerPtr->deltaBiasArray_.clear();
+      readGains(data_, header, controllerPtr->gainArray_);
+      break;
+    }
+    default:
+      primalSolution.controllerPtr_.reset();
+      break;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getObservationSize(const SystemObservation& observation, const TargetTrajectories* resetTargetTrajectoriesPtr) {
+  return getObservationLayout(observation, resetTargetTrajectoriesPtr).size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t serializeObservation(const SystemObservation& observation, const TargetTrajectories* resetTargetTrajectoriesPtr, char* buffer,
+                            size_t capacity, uint64_t resetGeneration) {
+  auto header = getObservationLayout(observation, resetTargetTrajectoriesPtr);
+  checkBuffer(buffer, capacity, header.size);
+  if (resetTargetTrajectoriesPtr != nullptr) {
+    header.resetGeneration = resetGeneration;
+  }
+  header.observationMode = observation.mode;
+  header.observationTime = observation.time;
+  std::memcpy(buffer, &header, sizeof(ObservationHeader));
+
+  writeVector(observation.state, header.observationState, buffer);
+  writeVector(observation.input, header.observationInput, buffer);
+  if (resetTargetTrajectoriesPtr != nullptr) {
+    writeTargetTrajectories(*resetTargetTrajectoriesPtr, header.targetTime, header.targetState, header.targetInput, buffer);
+  }
+
+  return header.size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool deserializeObservation(const char* data, size_t size, SystemObservation& observation, TargetTrajectories& resetTargetTrajectories,
+                            uint64_t* resetGenerationPtr) {
+  const auto& header = checkHeader<ObservationHeader>(data, size);
+  for (const auto* descriptorPtr :
+       {&header.observationState, &header.observationInput, &header.targetTime, &header.targetState, &header.targetInput}) {
+    checkArray(*descriptorPtr, sizeof(scalar_t), header.size);
+  }
+  checkCols(header.targetState, header.targetTime.rows);
+
+  observation.mode = header.observationMode;
+  observation.time = header.observationTime;
+  readVector(data, header.observationState, observation.state);
+  readVector(data, header.observationInput, observation.input);
+  if (header.resetRequested != 0) {
+    readTargetTrajectories(data, header.targetTime, header.targetState, header.targetInput, resetTargetTrajectories);
+    if (resetGenerationPtr != nullptr) {
+      *resetGenerationPtr = header.resetGeneration;
+    }
+  }
+  return header.resetRequested != 0;
+}
+
+}  // namespace policy_serialization
+}  // namespace ocs2
@@ -0,0 +1,203 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/SharedMemoryBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ocs2 {
+
+/** The control block at the start of the shared memory, followed by the message */
+struct SharedMemoryBuffer::Control {
+  static constexpr uint64_t magicNumber = 0x4f43533253484d42;  // "OCS2SHMB"
+  static constexpr size_t dataOffset = 64;
+
+  std::atomic<uint64_t> magic;
+  uint64_t capacity;
+  std::atomic<uint64_t> sequenceNumber;  // odd while a message is written
+  std::atomic<uint64_t> messageSize;
+};
+
+constexpr uint64_t SharedMemoryBuffer::Control::magicNumber;
+constexpr size_t SharedMemoryBuffer::Control::dataOffset;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The atomics in shared memory have to be lock-free.");
+
+namespace {
+
+std::string getObjectName(const std::string& name) {
+  return (!name.empty() && name.front() == '/') ? name : "/" + name;
+}
+
+std::runtime_error systemError(const std::string& what, const std::string& name) {
+  return std::runtime_error("[SharedMemoryBuffer] " + what + " '" + name + "' failed: " + std::strerror(errno));
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryBuffer::SharedMemoryBuffer(const std::string& name, size_t capacity) : name_(getObjectName(name)), isOwner_(true) {
+  static_assert(sizeof(Control) <= Control::dataOffset, "The control block overlaps the data.");
+
+  shm_unlink(name_.c_str());
+  const int fileDescriptor = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fileDescriptor < 0) {
+    throw systemError("Creating", name_);
+  }
+  const size_t size = Control::dataOffset + capacity;
+  if (ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0) {
+    close(fileDescriptor);
+    shm_unlink(name_.c_str());
+    throw systemError("Resizing", name_);
+  }
+  map(fileDescriptor, size);
+
+  controlPtr_ = new (memoryPtr_) Control;
+  controlPtr_->capacity = capacity;
+  controlPtr_->sequenceNumber.store(0, std::memory_order_relaxed);
+  controlPtr_->messageSize.store(0, std::memory_order_relaxed);
+  controlPtr_->magic.store(Control::magicNumber, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryBuffer::SharedMemoryBuffer(const std::string& name) : name_(getObjectName(name)), isOwner_(false) {
+  const int fileDescriptor = shm_open(name_.c_str(), O_RDWR, 0600);
+  if (fileDescriptor < 0) {
+    throw systemError("Opening", name_);
+  }
+  struct stat status;
+  if (fstat(fileDescriptor, &status) != 0 || static_cast<size_t>(status.st_size) < Control::dataOffset) {
+    close(fileDescriptor);
+    throw std::runtime_error("[SharedMemoryBuffer] '" + name_ + "' is not a SharedMemoryBuffer!");
+  }
+  map(fileDescriptor, status.st_size);
+
+  controlPtr_ = reinterpret_cast<Control*>(memoryPtr_);
+  if (controlPtr_->magic.load(std::memory_order_acquire) != Control::magicNumber ||
+      Control::dataOffset + controlPtr_->capacity > memorySize_) {
+    munmap(memoryPtr_, memorySize_);
+    throw std::runtime_error("[SharedMemoryBuffer] '" + name_ + "' is not a SharedMemoryBuffer!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryBuffer::~SharedMemoryBuffer() {
+  munmap(memoryPtr_, memorySize_);
+  if (isOwner_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryBuffer::map(int fileDescriptor, size_t size) {
+  memoryPtr_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+  close(fileDescriptor);  // the mapping stays valid
+  if (memoryPtr_ == MAP_FAILED) {
+    if (isOwner_) {
+      shm_unlink(name_.c_str());
+    }
+    throw systemError("Mapping", name_);
+  }
+  memorySize_ = size;
+  dataPtr_ = reinterpret_cast<char*>(memoryPtr_) + Control::dataOffset;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SharedMemoryBuffer::getCapacity() const {
+  return controlPtr_->capacity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryBuffer::write(size_t size, const std::function<void(char*)>& writeMessage) {
+  if (size > getCapacity()) {
+    throw std::runtime_error("[SharedMemoryBuffer] The message of " + std::to_string(size) + " bytes exceeds the capacity of '" + name_ +
+                             "' (" + std::to_string(getCapacity()) + " bytes)!");
+  }
+
+  const auto sequenceNumber = controlPtr_->sequenceNumber.load(std::memory_order_relaxed);
+  controlPtr_->sequenceNumber.store(sequenceNumber + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);  // the odd number is visible before the data changes
+
+  writeMessage(dataPtr_);
+  controlPtr_->messageSize.store(size, std::memory_order_relaxed);
+
+  controlPtr_->sequenceNumber.store(sequenceNumber + 2, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryBuffer::read(uint64_t& sequenceNumber, std::vector<char>& message, size_t maxNumAttempts) const {
+  for (size_t attempt = 0; attempt < maxNumAttempts; ++attempt) {
+    const auto sequenceBefore = controlPtr_->sequenceNumber.load(std::memory_order_acquire);
+    if (sequenceBefore == sequenceNumber) {
+      return false;
+    }
+    if (sequenceBefore % 2 == 1) {
+      std::this_thread::yield();  // a message is being written
+      continue;
+    }
+
+    const auto size = std::min<size_t>(controlPtr_->messageSize.load(std::memory_order_relaxed), getCapacity());
+    message.resize(size);
+    std::memcpy(message.data(), dataPtr_, size);
+
+    std::atomic_thread_fence(std::memory_order_acquire);  // the copy completes before the counter is checked again
+    if (controlPtr_->sequenceNumber.load(std::memory_order_relaxed) == sequenceBefore) {
+      sequenceNumber = sequenceBefore;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace ocs2
@@ -0,0 +1,378 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_mpc/MPC_SharedMemory_Interface.h"
+#include "ocs2_mpc/MRT_SharedMemory_Interface.h"
+#include "ocs2_mpc/PolicySerialization.h"
+
+using namespace ocs2;
+using namespace ocs2::policy_serialization;
+
+namespace {
+
+/** A random policy with smoothly varying gains, as for a legged robot with 24 states and inputs */
+PrimalSolution getRandomPolicy(size_t numNodes, size_t stateDim, size_t inputDim, bool withFeedback) {
+  PrimalSolution primalSolution;
+  const matrix_t gainBase = matrix_t::Random(inputDim, stateDim);
+  const matrix_t gainRate = matrix_t::Random(inputDim, stateDim);
+  vector_array_t bias;
+  matrix_array_t gains;
+  for (size_t i = 0; i < numNodes; ++i) {
+    primalSolution.timeTrajectory_.push_back(0.01 * i);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    bias.push_back(vector_t::Random(inputDim));
+    gains.push_back(gainBase + 0.01 * i * gainRate + 1e-3 * matrix_t::Random(inputDim, stateDim));
+  }
+  primalSolution.postEventIndices_ = {numNodes / 2};
+  primalSolution.modeSchedule_ = ModeSchedule({primalSolution.timeTrajectory_[numNodes / 2]}, {3, 12});
+  if (withFeedback) {
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, std::move(bias), std::move(gains)));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+  return primalSolution;
+}
+
+CommandData getRandomCommand(size_t stateDim, size_t inputDim) {
+  CommandData command;
+  command.mpcInitObservation_.mode = 3;
+  command.mpcInitObservation_.time = 0.5;
+  command.mpcInitObservation_.state = vector_t::Random(stateDim);
+  command.mpcInitObservation_.input = vector_t::Random(inputDim);
+  command.mpcTargetTrajectories_ = TargetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+                                                      {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+  return command;
+}
+
+bool isEqual(const PrimalSolution& lhs, const PrimalSolution& rhs, scalar_t gainTolerance = 0.0) {
+  if (lhs.timeTrajectory_ != rhs.timeTrajectory_ || lhs.postEventIndices_ != rhs.postEventIndices_ ||
+      lhs.modeSchedule_.eventTimes != rhs.modeSchedule_.eventTimes || lhs.modeSchedule_.modeSequence != rhs.modeSchedule_.modeSequence ||
+      lhs.stateTrajectory_ != rhs.stateTrajectory_ || lhs.inputTrajectory_ != rhs.inputTrajectory_) {
+    return false;
+  }
+  if (lhs.controllerPtr_->getType() != rhs.controllerPtr_->getType()) {
+    return false;
+  }
+  if (lhs.controllerPtr_->getType() == ControllerType::FEEDFORWARD) {
+    const auto& lhsController = static_cast<const FeedforwardController&>(*lhs.controllerPtr_);
+    const auto& rhsController = static_cast<const FeedforwardController&>(*rhs.controllerPtr_);
+    return lhsController.timeStamp_ == rhsController.timeStamp_ && lhsController.uffArray_ == rhsController.uffArray_;
+  }
+  const auto& lhsController = static_cast<const LinearController&>(*lhs.controllerPtr_);
+  const auto& rhsController = static_cast<const LinearController&>(*rhs.controllerPtr_);
+  if (lhsController.timeStamp_ != rhsController.timeStamp_ || lhsController.biasArray_ != rhsController.biasArray_ ||
+      lhsController.gainArray_.size() != rhsController.gainArray_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhsController.gainArray_.size(); ++i) {
+    if ((lhsController.gainArray_[i] - rhsController.gainArray_[i]).lpNorm<Eigen::Infinity>() > gainTolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+scalar_t getMonotonicTime() {
+  return std::chrono::duration<scalar_t>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class DummyMpc final : public MPC_BASE {
+ public:
+  DummyMpc() : MPC_BASE(mpc::Settings()) {}
+  SolverBase* getSolverPtr() override { return nullptr; }
+  const SolverBase* getSolverPtr() const override { return nullptr; }
+
+ private:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {}
+};
+
+constexpr size_t numNodes = 100;
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 24;
+
+}  // namespace
+
+TEST(testPolicySerialization, roundTrip) {
+  const auto command = getRandomCommand(stateDim, inputDim);
+  PerformanceIndex performance;
+  performance.cost = 1.0;
+  performance.dynamicsViolationSSE = 2.0;
+
+  for (bool withFeedback : {false, true}) {
+    const auto policy = getRandomPolicy(numNodes, stateDim, inputDim, withFeedback);
+    std::vector<char> message;
+    serializePolicy(command, policy, performance, GainEncoding::Double, message);
+    ASSERT_EQ(message.size(), getPolicySize(command, policy));
+
+    const PolicyView view(message.data(), message.size());
+    PrimalSolution receivedPolicy;
+    view.getPrimalSolution(receivedPolicy);
+    EXPECT_TRUE(isEqual(policy, receivedPolicy));
+
+    CommandData receivedCommand;
+    view.getCommand(receivedCommand);
+    EXPECT_EQ(receivedCommand.mpcInitObservation_.mode, command.mpcInitObservation_.mode);
+    EXPECT_EQ(receivedCommand.mpcInitObservation_.time, command.mpcInitObservation_.time);
+    EXPECT_EQ(receivedCommand.mpcInitObservation_.state, command.mpcInitObservation_.state);
+    EXPECT_EQ(receivedCommand.mpcInitObservation_.input, command.mpcInitObservation_.input);
+    EXPECT_EQ(receivedCommand.mpcTargetTrajectories_, command.mpcTargetTrajectories_);
+    EXPECT_TRUE(view.getPerformanceIndex().isApprox(performance, 0.0));
+
+    // in place access
+    for (size_t i = 0; i < numNodes; ++i) {
+      EXPECT_EQ(view.getTimeTrajectory()(i), policy.timeTrajectory_[i]);
+      EXPECT_EQ(view.getStateTrajectory().col(i), policy.stateTrajectory_[i]);
+      EXPECT_EQ(view.getInputTrajectory().col(i), policy.inputTrajectory_[i]);
+    }
+    EXPECT_GE(reinterpret_cast<const char*>(view.getStateTrajectory().data()), message.data());
+    EXPECT_LT(reinterpret_cast<const char*>(view.getStateTrajectory().data()), message.data() + message.size());
+
+    // the memory of the received policy is reused
+    const auto* stateData = receivedPolicy.stateTrajectory_.front().data();
+    view.getPrimalSolution(receivedPolicy);
+    EXPECT_EQ(receivedPolicy.stateTrajectory_.front().data(), stateData);
+  }
+}
+
+TEST(testPolicySerialization, deltaEncodedGains) {
+  const auto command = getRandomCommand(stateDim, inputDim);
+  const auto policy = getRandomPolicy(numNodes, stateDim, inputDim, true);
+  std::vector<char> doubleMessage, deltaMessage;
+  serializePolicy(command, policy, PerformanceIndex(), GainEncoding::Double, doubleMessage);
+  serializePolicy(command, policy, PerformanceIndex(), GainEncoding::DeltaFloat, deltaMessage);
+
+  PrimalSolution receivedPolicy;
+  PolicyView(deltaMessage.data(), deltaMessage.size()).getPrimalSolution(receivedPolicy);
+  EXPECT_FALSE(isEqual(policy, receivedPolicy));
+  // the rounding errors of the differences do not accumulate along the horizon
+  EXPECT_TRUE(isEqual(policy, receivedPolicy, 1e-7));
+
+  const size_t gainSize = numNodes * inputDim * stateDim * sizeof(scalar_t);
+  EXPECT_NEAR(static_cast<scalar_t>(doubleMessage.size() - deltaMessage.size()), 0.5 * gainSize, 0.01 * gainSize);
+  std::cerr << "[testPolicySerialization] Policy message size with " << numNodes << " nodes, " << stateDim << " states and " << inputDim
+            << " inputs: " << doubleMessage.size() << " bytes (double gains), " << deltaMessage.size() << " bytes (delta encoded gains)\n";
+}
+
+TEST(testPolicySerialization, malformedMessage) {
+  const auto command = getRandomCommand(stateDim, inputDim);
+  const auto policy = getRandomPolicy(numNodes, stateDim, inputDim, true);
+  std::vector<char> message;
+  serializePolicy(command, policy, PerformanceIndex(), GainEncoding::DeltaFloat, message);
+
+  // truncated
+  EXPECT_ANY_THROW(PolicyView(message.data(), message.size() - 8));
+  EXPECT_ANY_THROW(PolicyView(message.data(), sizeof(PolicyHeader) - 8));
+
+  // wrong version
+  auto wrongVersion = message;
+  reinterpret_cast<PolicyHeader*>(wrongVersion.data())->version = formatVersion + 1;
+  EXPECT_ANY_THROW(PolicyView(wrongVersion.data(), wrongVersion.size()));
+
+  // array outside of the message
+  auto wrongOffset = message;
+  reinterpret_cast<PolicyHeader*>(wrongOffset.data())->controllerGainDelta.offset = message.size();
+  EXPECT_ANY_THROW(PolicyView(wrongOffset.data(), wrongOffset.size()));
+
+  // post event index outside of the time trajectory
+  auto wrongPostEventIndex = message;
+  const auto& postEventIndices = reinterpret_cast<const PolicyHeader*>(message.data())->postEventIndices;
+  reinterpret_cast<uint64_t*>(wrongPostEventIndex.data() + postEventIndices.offset)[0] = numNodes + 1;
+  EXPECT_ANY_THROW(PolicyView(wrongPostEventIndex.data(), wrongPostEventIndex.size()));
+
+  // mode sequence that does not match the event times
+  auto wrongModeSequence = message;
+  reinterpret_cast<PolicyHeader*>(wrongModeSequence.data())->modeSequence.rows -= 1;
+  EXPECT_ANY_THROW(PolicyView(wrongModeSequence.data(), wrongModeSequence.size()));
+
+  // time trajectory that is not a single column
+  auto wrongTimeColumns = message;
+  auto& time = reinterpret_cast<PolicyHeader*>(wrongTimeColumns.data())->time;
+  time.rows /= 2;
+  time.cols = 2;
+  EXPECT_ANY_THROW(PolicyView(wrongTimeColumns.data(), wrongTimeColumns.size()));
+
+  // target input trajectory that does not match the target times
+  auto wrongTargetInput = message;
+  reinterpret_cast<PolicyHeader*>(wrongTargetInput.data())->targetInput.cols -= 1;
+  EXPECT_ANY_THROW(PolicyView(wrongTargetInput.data(), wrongTargetInput.size()));
+
+  // too small buffer
+  EXPECT_ANY_THROW(serializePolicy(command, policy, PerformanceIndex(), GainEncoding::Double, message.data(), message.size()));
+}
+
+TEST(testPolicySerialization, observation) {
+  SystemObservation observation;
+  observation.mode = 2;
+  observation.time = 1.5;
+  observation.state = vector_t::Random(stateDim);
+  observation.input = vector_t::Random(inputDim);
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(stateDim)}, {vector_t::Random(inputDim)});
+
+  for (const auto* targetTrajectoriesPtr : {static_cast<const TargetTrajectories*>(nullptr), &targetTrajectories}) {
+    std::vector<char> message(getObservationSize(observation, targetTrajectoriesPtr));
+    serializeObservation(observation, targetTrajectoriesPtr, message.data(), message.size(), 7);
+
+    SystemObservation receivedObservation;
+    TargetTrajectories receivedTargetTrajectories;
+    uint64_t resetGeneration = 0;
+    const bool resetRequested =
+        deserializeObservation(message.data(), message.size(), receivedObservation, receivedTargetTrajectories, &resetGeneration);
+    EXPECT_EQ(resetRequested, targetTrajectoriesPtr != nullptr);
+    EXPECT_EQ(receivedObservation.mode, observation.mode);
+    EXPECT_EQ(receivedObservation.time, observation.time);
+    EXPECT_EQ(receivedObservation.state, observation.state);
+    EXPECT_EQ(receivedObservation.input, observation.input);
+    if (resetRequested) {
+      EXPECT_EQ(receivedTargetTrajectories, targetTrajectories);
+      EXPECT_EQ(resetGeneration, 7);
+    }
+  }
+}
+
+TEST(testSharedMemoryTransport, interruptedWrite) {
+  SharedMemoryBuffer buffer("ocs2_test_shared_memory_interrupted_" + std::to_string(getpid()), 64);
+  uint64_t sequenceNumber = 0;
+  std::vector<char> message;
+  buffer.write(8, [](char* data) { std::fill(data, data + 8, 1); });
+  ASSERT_TRUE(buffer.read(sequenceNumber, message));
+
+  // A writer that stops in the middle of a message, e.g. because its process died: the read gives up instead of spinning forever
+  EXPECT_ANY_THROW(buffer.write(8, [](char* data) { throw std::runtime_error("interrupted"); }));
+  EXPECT_FALSE(buffer.read(sequenceNumber, message));
+}
+
+TEST(testSharedMemoryTransport, policiesBeforeReset) {
+  const std::string name = "ocs2_test_shared_memory_reset_" + std::to_string(getpid());
+  DummyMpc mpc;
+  MPC_SharedMemory_Interface mpcInterface(mpc, name);
+  MRT_SharedMemory_Interface mrt(name);
+
+  const auto command = getRandomCommand(stateDim, inputDim);
+  const auto policy = getRandomPolicy(numNodes, stateDim, inputDim, true);
+  mpcInterface.publishPolicy(command, policy, PerformanceIndex());
+  ASSERT_TRUE(mrt.spinMRT());
+
+  // The policy published before the MPC handled the reset request is discarded
+  mrt.resetMpcNode(command.mpcTargetTrajectories_);
+  mpcInterface.publishPolicy(command, policy, PerformanceIndex());
+  ASSERT_FALSE(mrt.spinMRT());
+
+  // A policy of the MPC after the reset, written as the MPC does once it has handled the request
+  SharedMemoryBuffer policyBuffer(name + "_policy");
+  std::vector<char> message;
+  serializePolicy(command, policy, PerformanceIndex(), GainEncoding::Double, message, 1);
+  policyBuffer.write(message.size(), [&](char* data) { std::copy(message.begin(), message.end(), data); });
+  ASSERT_TRUE(mrt.spinMRT());
+}
+
+/**
+ * The MPC side publishes policies to an MRT in a child process, which checks them and acknowledges each one with an observation. The
+ * observation carries the publish-to-receive latency measured by the MRT.
+ */
+TEST(testSharedMemoryTransport, twoProcesses) {
+  constexpr size_t numPolicies = 200;
+  constexpr scalar_t timeout = 10.0;
+  const std::string name = "ocs2_test_shared_memory_" + std::to_string(getpid());
+
+  DummyMpc mpc;
+  MPC_SharedMemory_Interface mpcInterface(mpc, name);
+
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    int status = 0;
+    try {
+      MRT_SharedMemory_Interface mrt(name);
+      for (size_t i = 0; i < numPolicies && status == 0; ++i) {
+        const scalar_t startTime = getMonotonicTime();
+        while (!mrt.spinMRT()) {
+          if (getMonotonicTime() - startTime > timeout) {
+            _exit(2);
+          }
+        }
+        mrt.updatePolicy();
+        const scalar_t receiveLatency = getMonotonicTime() - mrt.getCommand().mpcInitObservation_.time;
+
+        std::srand(i);
+        if (!isEqual(mrt.getPolicy(), getRandomPolicy(numNodes, stateDim, inputDim, true))) {
+          status = 3;
+        }
+
+        SystemObservation acknowledgement;
+        acknowledgement.time = i;
+        acknowledgement.state = vector_t::Constant(1, receiveLatency);
+        mrt.setCurrentObservation(acknowledgement);
+      }
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << "\n";
+      status = 1;
+    }
+    _exit(status);
+  }
+
+  std::vector<scalar_t> latencies;
+  CommandData command = getRandomCommand(stateDim, inputDim);
+  SystemObservation acknowledgement;
+  for (size_t i = 0; i < numPolicies; ++i) {
+    std::srand(i);
+    const auto policy = getRandomPolicy(numNodes, stateDim, inputDim, true);
+    command.mpcInitObservation_.time = getMonotonicTime();
+    mpcInterface.publishPolicy(command, policy, PerformanceIndex());
+
+    const scalar_t startTime = getMonotonicTime();
+    while (!mpcInterface.readObservation(acknowledgement) || acknowledgement.time != i) {
+      ASSERT_LT(getMonotonicTime() - startTime, timeout) << "No acknowledgement of the MRT";
+    }
+    latencies.push_back(acknowledgement.state(0));
+  }
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  ASSERT_TRUE(WIFEXITED(status)) << "The MRT process was terminated by signal " << WTERMSIG(status);
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cerr << "[testSharedMemoryTransport] Publish to receive latency over " << numPolicies << " policies: p50 = "
+            << 1e6 * latencies[latencies.size() / 2] << " [us], p99 = " << 1e6 * latencies[latencies.size() * 99 / 100]
+            << " [us], max = " << 1e6 * latencies.back() << " [us]\n";
+}
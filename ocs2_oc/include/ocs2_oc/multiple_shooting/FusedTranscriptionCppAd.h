@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/constraint/StateInputConstraintCppAd.h>
+#include <ocs2_core/cost/StateInputCostCppAd.h>
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+
+#include "ocs2_oc/multiple_shooting/Transcription.h"
+#include "ocs2_oc/oc_problem/OptimalControlProblem.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Computes the multiple shooting transcription of an intermediate node with a single generated CppAD model for all CppAD terms.
+ *
+ * On construction, the CppAD based terms of the problem are taken out of a copy of the problem and traced together into one model:
+ * - the discretized dynamics, if the dynamics derive from SystemDynamicsBaseAD and have no flow map parameters,
+ * - the StateInputCostCppAd terms of the cost and the soft constraint collections,
+ * - the StateInputConstraintCppAd terms of the state-input equality and inequality constraint collections.
+ * Subexpressions that are shared between these terms (e.g. kinematics) are evaluated once per node for the values and once for the
+ * Jacobians. The model is of first order, with one output per cost term such that inactive cost terms are left out of the sum. The
+ * Hessian of the cost comes from a second model with only the sum of the active cost terms as output, so no second order derivatives
+ * are generated for the dynamics and the constraints.
+ * The remaining terms are evaluated through their collections as in setupIntermediateNode(). The resulting transcription is the same
+ * as the one of setupIntermediateNode(), including the order of the constraint terms.
+ */
+class FusedTranscriptionCppAd {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] stateDim : State dimension.
+   * @param [in] inputDim : Input dimension.
+   * @param [in] optimalControlProblem : Definition of the optimal control problem. A copy is stored.
+   * @param [in] integratorType : Dynamics discretization, it is traced into the model for EULER, RK2, and RK4. The implicit and adaptive
+   *                              schemes are evaluated with the sensitivity discretizer.
+   * @param [in] modelName : Prefix of the names of the generated model libraries. A hash of the dimensions, the integrator, and the
+   *                         fused terms is appended, such that different problems do not share a library.
+   * @param [in] modelFolder : Folder where the model library files are saved.
+   * @param [in] recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param [in] verbose : Print information.
+   */
+  FusedTranscriptionCppAd(size_t stateDim, size_t inputDim, const OptimalControlProblem& optimalControlProblem,
+                          SensitivityIntegratorType integratorType, const std::string& modelName,
+                          const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = false, bool verbose = true);
+
+  /** Copy constructor. The model library is loaded, not regenerated. */
+  FusedTranscriptionCppAd(const FusedTranscriptionCppAd& other);
+
+  ~FusedTranscriptionCppAd() = default;
+  FusedTranscriptionCppAd& operator=(const FusedTranscriptionCppAd&) = delete;
+
+  /**
+   * Compute the multiple shooting transcription for a single intermediate node. Equivalent to setupIntermediateNode().
+   *
+   * @param t : Start of the discrete interval
+   * @param dt : Duration of the interval
+   * @param x : State at start of the interval
+   * @param x_next : State at the end of the interval
+   * @param u : Input, taken to be constant across the interval.
+   * @return multiple shooting transcription for this node.
+   */
+  Transcription setupIntermediateNode(scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+
+  /**
+   * The problem with the terms that are not fused. Its target trajectories pointer should be updated in the same way as the one of
+   * the original problem.
+   */
+  OptimalControlProblem& getRemainderProblem() { return remainderProblem_; }
+
+  /** Whether the dynamics are part of the fused model. */
+  bool isDynamicsFused() const { return fuseDynamics_; }
+
+  /** Number of cost and constraint terms in the fused model. */
+  size_t getNumFusedTerms() const {
+    return fusedCosts_.size() + fusedEqualityConstraints_.terms.size() + fusedInequalityConstraints_.terms.size();
+  }
+
+ private:
+  /** Position of an original constraint term: either in the fused model or in the remainder collection. */
+  struct ConstraintSlot {
+    bool isFused;
+    size_t index;
+  };
+
+  /** Fused constraint terms of one collection, with their traced sizes and first output row in the model. */
+  struct FusedConstraints {
+    std::vector<std::unique_ptr<StateInputConstraintCppAd>> terms;
+    size_array_t sizes;
+    size_array_t outputOffsets;
+    std::vector<ConstraintSlot> slots;
+  };
+
+  /** Takes the fused terms out of the remainder problem. Returns the names of the fused terms. */
+  std::vector<std::string> extractFusedTerms();
+  void createModels(const std::string& modelName, const std::vector<std::string>& fusedTermNames, const std::string& modelFolder,
+                    bool recompileLibraries, bool verbose);
+  /** Discretizes the flow map with the explicit Runge-Kutta scheme of the sensitivity discretizer of the same type. */
+  static ad_vector_t discretizeFlowMap(const SystemDynamicsBaseAD& dynamics, SensitivityIntegratorType integratorType, ad_scalar_t t,
+                                       ad_scalar_t dt, const ad_vector_t& x, const ad_vector_t& u);
+  ad_vector_t fusedFunction(const ad_vector_t& stateInput, const ad_vector_t& parameters) const;
+  ad_scalar_t costFunction(const ad_vector_t& stateInput, const ad_vector_t& parameters) const;
+  vector_t getParameters(scalar_t t, scalar_t dt) const;
+  bool isCostActive(const vector_t& parameters, size_t costIndex) const { return parameters(2 + costIndex) > 0.5; }
+
+  /** Merges the fused constraint rows and the remainder collection into the transcription constraints, in the original term order. */
+  void assembleConstraints(scalar_t t, const vector_t& x, const vector_t& u, const FusedConstraints& fusedConstraints,
+                           const StateInputConstraintCollection& remainderConstraints, const vector_t& fusedValue,
+                           const matrix_t& fusedJacobian, size_array_t& termsSize, VectorFunctionLinearApproximation& constraints) const;
+
+  size_t stateDim_;
+  size_t inputDim_;
+  SensitivityIntegratorType integratorType_;
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  OptimalControlProblem remainderProblem_;
+
+  bool fuseDynamics_ = false;
+  std::vector<std::unique_ptr<StateInputCostCppAd>> fusedCosts_;
+  FusedConstraints fusedEqualityConstraints_;
+  FusedConstraints fusedInequalityConstraints_;
+
+  size_t costOutputOffset_ = 0;  // output row of the first cost term
+  size_t numOutputs_ = 0;
+  size_t numParameters_ = 0;
+  std::unique_ptr<CppAdInterface> adInterfacePtr_;            // first order model of all fused terms
+  std::unique_ptr<CppAdInterface> costHessianInterfacePtr_;  // second order model of the sum of the active cost terms
+};
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 
+#include "ocs2_oc/oc_data/FlatMetrics.h"
 #include "ocs2_oc/oc_data/PerformanceIndex.h"
 #include "ocs2_oc/oc_data/PrimalSolution.h"
 #include "ocs2_oc/oc_data/ProblemMetrics.h"
@@ -111,5 +112,14 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
  */
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics);
 
+/**
+ * Constructs a ProblemMetrics from the flat metrics of the horizon.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] metrics: The flat metrics.
+ * @return The ProblemMetrics.
+ */
+ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, const FlatMetrics& metrics);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
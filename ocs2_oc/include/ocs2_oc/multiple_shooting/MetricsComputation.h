@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/model_data/Metrics.h>
 
+#include "ocs2_oc/oc_data/FlatMetrics.h"
+
 #include "ocs2_oc/multiple_shooting/Transcription.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
 
@@ -93,5 +95,94 @@ Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar
  */
 Metrics computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * Get the term sizes of the Metrics of an intermediate node.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Start of the discrete interval
+ * @param nextStateDim : Dimension of the state at the end of the interval
+ * @return The term sizes of the Metrics of an intermediate node.
+ */
+MetricsSize getIntermediateMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t, size_t nextStateDim);
+
+/**
+ * Get the term sizes of the Metrics of an event node.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the event node
+ * @param nextStateDim : Dimension of the post-event state
+ * @return The term sizes of the Metrics of an event node.
+ */
+MetricsSize getEventMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t, size_t nextStateDim);
+
+/**
+ * Get the term sizes of the Metrics of the terminal node.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the terminal node
+ * @return The term sizes of the Metrics of the terminal node.
+ */
+MetricsSize getTerminalMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t);
+
+/**
+ * Write the Metrics of a single intermediate node into node i of metrics. Its layout should match getIntermediateMetricsSize().
+ * @param transcription: multiple shooting transcription for an intermediate node.
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeMetrics(const Transcription& transcription, FlatMetrics& metrics, size_t i);
+
+/**
+ * Write the Metrics of the event node into node i of metrics. Its layout should match getEventMetricsSize().
+ * @param transcription: multiple shooting transcription for event node.
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeMetrics(const EventTranscription& transcription, FlatMetrics& metrics, size_t i);
+
+/**
+ * Write the Metrics of the terminal node into node i of metrics. Its layout should match getTerminalMetricsSize().
+ * @param transcription: multiple shooting transcription for terminal node.
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeMetrics(const TerminalTranscription& transcription, FlatMetrics& metrics, size_t i);
+
+/**
+ * Compute the Metrics of a single intermediate node and write it into node i of metrics. The constraint values are written directly
+ * into the flat buffers. The layout of node i should match getIntermediateMetricsSize().
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param discretizer : Integrator to use for creating the discrete dynamics.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
+                                const vector_t& x, const vector_t& x_next, const vector_t& u, FlatMetrics& metrics, size_t i);
+
+/**
+ * Compute the Metrics of the event node and write it into node i of metrics. The layout of node i should match getEventMetricsSize().
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the event node
+ * @param x : Pre-event state
+ * @param x_next : Post-event state
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                         FlatMetrics& metrics, size_t i);
+
+/**
+ * Compute the Metrics of the terminal node and write it into node i of metrics. The layout of node i should match
+ * getTerminalMetricsSize().
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the terminal node
+ * @param x : Terminal state
+ * @param metrics : The flat metrics of the horizon.
+ * @param i : The node index.
+ */
+void computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, FlatMetrics& metrics, size_t i);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <Eigen/LU>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Projection of the state-input equality constraints C*x + D*u + e = 0 that exploits the sparsity of D. It returns
+ *  u = Pu * \tilde{u} + Px * x + Pe
+ * such that the constraints are satisfied for any \tilde{u}, like LinearAlgebra::luConstraintProjection.
+ *
+ * Rows of D with a single nonzero (e.g. zero contact forces of swing legs) fix an input and are eliminated with a division. The other
+ * rows (e.g. foot velocities of stance legs) are solved for a set of basic inputs among the inputs that are not fixed, with the LU
+ * decomposition of the square block of D on these rows and basic inputs. The remaining inputs parameterize the null-space.
+ *
+ * This pattern is computed once per key (e.g. the mode) and reused as long as D has the same structure and the basis is well
+ * conditioned. If no well conditioned basis is found, the projection falls back to LinearAlgebra::luConstraintProjection. Each pattern
+ * keeps a workspace of its size, such that the computation does not allocate memory once all keys are seen and the output has the right
+ * size. Use one instance per thread.
+ */
+class StructuredConstraintProjection {
+ public:
+  /**
+   * Computes the constraint projection.
+   *
+   * @param [in] constraint : C = dfdx, D = dfdu, e = f. D should have full row rank.
+   * @param [in] patternKey : Key under which the pattern of D is cached, e.g. the mode of the node.
+   * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+   * @param [out] pseudoInverse : If not nullptr, left pseudo-inverse of D^T such that Px = -pseudoInverse^T * C, Pe = -pseudoInverse^T * e.
+   */
+  void compute(const VectorFunctionLinearApproximation& constraint, size_t patternKey, VectorFunctionLinearApproximation& projection,
+               matrix_t* pseudoInverse = nullptr);
+
+  /** Number of times a pattern was computed instead of taken from the cache. */
+  size_t getNumPatternUpdates() const { return numPatternUpdates_; }
+
+  /** Number of times no well conditioned basis was found and LinearAlgebra::luConstraintProjection was used instead. */
+  size_t getNumDenseFallbacks() const { return numDenseFallbacks_; }
+
+ private:
+  struct Pattern {
+    Eigen::Index numInputs = 0;
+    std::vector<Eigen::Index> selectionRows;   // Constraint rows with a single nonzero in D
+    std::vector<Eigen::Index> fixedInputs;     // Input fixed by each selection row
+    std::vector<Eigen::Index> denseRows;       // Other constraint rows
+    std::vector<Eigen::Index> basicInputs;     // Inputs solved for with the dense rows, one per dense row
+    std::vector<Eigen::Index> nonBasicInputs;  // Inputs that parameterize the null-space
+
+    // Workspace
+    matrix_t basis;                         // D on the dense rows and basic inputs
+    Eigen::PartialPivLU<matrix_t> basisLu;  // Decomposition of the basis
+    matrix_t denseRhs;                      // [C_dense + D_dense,fixed * Px_fixed, e_dense + D_dense,fixed * Pe_fixed, D_dense,nonBasic]
+    matrix_t denseSolution;                 // inv(basis) * denseRhs
+    matrix_t basisInverse;                  // inv(basis), only computed for the pseudo-inverse
+  };
+
+  /** Finds the selection rows of D and chooses the basic inputs with a full pivoting LU decomposition. */
+  static Pattern computePattern(const matrix_t& D);
+
+  /** Checks that D has the structure of the pattern, i.e. the selection rows of the pattern have a single nonzero. */
+  static bool hasPattern(const matrix_t& D, const Pattern& pattern);
+
+  /** Decomposes the basis of the dense rows, returns false if it is close to singular. */
+  static bool factorizeBasis(const matrix_t& D, Pattern& pattern);
+
+  std::unordered_map<size_t, Pattern> patternCache_;
+  size_t numPatternUpdates_ = 0;
+  size_t numDenseFallbacks_ = 0;
+
+};
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
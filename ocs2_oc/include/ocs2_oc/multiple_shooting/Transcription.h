@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
 #include "ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h"
+#include "ocs2_oc/multiple_shooting/StructuredConstraintProjection.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
 
 namespace ocs2 {
@@ -86,6 +87,18 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
  */
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier = false);
 
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription, with a projection that exploits
+ * the sparsity pattern of the constraints and caches it across nodes and iterations.
+ *
+ * @param transcription : Transcription for a single intermediate node
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ * @param structuredProjection : Projection kernel with its pattern cache and workspace, one per thread.
+ * @param patternKey : Key under which the constraint pattern is cached, typically the mode of the node.
+ */
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier,
+                          StructuredConstraintProjection& structuredProjection, size_t patternKey);
+
 /**
  * Results of the transcription at a terminal node
  */
@@ -0,0 +1,131 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/Metrics.h>
+
+#include "ocs2_oc/oc_data/PerformanceIndex.h"
+
+namespace ocs2 {
+
+/** The sizes of the terms of the Metrics of a node. An inactive constraint term has size zero. */
+struct MetricsSize {
+  size_t dynamicsViolation = 0;
+  size_array_t stateEqConstraint;
+  size_array_t stateInputEqConstraint;
+  size_array_t stateIneqConstraint;
+  size_array_t stateInputIneqConstraint;
+};
+
+bool operator==(const MetricsSize& lhs, const MetricsSize& rhs);
+inline bool operator!=(const MetricsSize& lhs, const MetricsSize& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * Stores the Metrics of all nodes of a horizon in flat buffers: each field (e.g. all state equality constraints of the horizon) is
+ * one contiguous vector. The layout is set once per problem structure by setLayout(). Afterwards the nodes are written in place,
+ * e.g. by multiple_shooting::computeIntermediateMetrics(..., FlatMetrics&, i), which can be called concurrently for distinct nodes.
+ *
+ * The Lagrangian terms of the Metrics are not stored, since the multiple shooting solvers do not use them.
+ */
+class FlatMetrics {
+ public:
+  enum class Field : size_t {
+    DynamicsViolation = 0,
+    StateEqConstraint,
+    StateInputEqConstraint,
+    StateIneqConstraint,
+    StateInputIneqConstraint,
+  };
+  static constexpr size_t numFields = 5;
+
+  using segment_t = Eigen::VectorBlock<vector_t>;
+  using const_segment_t = Eigen::VectorBlock<const vector_t>;
+
+  /** Number of nodes. */
+  size_t size() const { return costs_.size(); }
+
+  /**
+   * Sets the layout of the nodes. Nothing is done if the layout is unchanged, otherwise the buffers are resized. The values are left
+   * uninitialized.
+   */
+  void setLayout(const std::vector<MetricsSize>& sizes);
+
+  /** Gets the term sizes of node i. */
+  const MetricsSize& getSizes(size_t i) const { return sizes_[i]; }
+
+  /** Clears the content and the layout. */
+  void clear();
+
+  /** Exchanges the content of FlatMetrics */
+  void swap(FlatMetrics& other);
+
+  /** The cost of node i. */
+  scalar_t& cost(size_t i) { return costs_[i]; }
+  scalar_t cost(size_t i) const { return costs_[i]; }
+
+  /** The stacked values of a field of node i. */
+  segment_t values(Field field, size_t i) {
+    const auto& offsets = nodeOffsets_[static_cast<size_t>(field)];
+    return fields_[static_cast<size_t>(field)].segment(offsets[i], offsets[i + 1] - offsets[i]);
+  }
+  const_segment_t values(Field field, size_t i) const {
+    const auto& offsets = nodeOffsets_[static_cast<size_t>(field)];
+    return fields_[static_cast<size_t>(field)].segment(offsets[i], offsets[i + 1] - offsets[i]);
+  }
+
+  /** The values of a single constraint term of node i. An inactive term has an empty segment. */
+  const_segment_t termValues(Field field, size_t i, size_t term) const;
+
+  /** Gets node i as Metrics. The inactive constraint terms are empty vectors and the Lagrangian terms are empty. */
+  Metrics getMetrics(size_t i) const;
+
+ private:
+  const size_array_t& getTermSizes(Field field, size_t i) const;
+
+  std::vector<MetricsSize> sizes_;
+  vector_t costs_;
+  // The values of each field, stacked over all nodes
+  std::array<vector_t, numFields> fields_;
+  // The start of each node in fields_. It has size()+1 entries.
+  std::array<size_array_t, numFields> nodeOffsets_;
+};
+
+/** Computes the PerformanceIndex of node i. Equivalent to toPerformanceIndex(metrics.getMetrics(i)). */
+PerformanceIndex toPerformanceIndex(const FlatMetrics& metrics, size_t i);
+
+/** Computes the PerformanceIndex of node i, scaled by dt. Equivalent to toPerformanceIndex(metrics.getMetrics(i), dt). */
+PerformanceIndex toPerformanceIndex(const FlatMetrics& metrics, size_t i, scalar_t dt);
+
+}  // namespace ocs2
@@ -0,0 +1,70 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+
+namespace ocs2 {
+
+/**
+ * Recycles the PrimalSolution objects that a solver publishes as immutable, reference-counted snapshots. A snapshot is handed out as
+ * std::shared_ptr<const PrimalSolution> and can be held by any number of consumers (e.g. the MRT buffers) without a copy. Once all the
+ * consumers have released it, acquire() returns it again to the solver such that the object and its control block are reused.
+ *
+ * acquire() and the release of the snapshots can happen on different threads. The pool itself is not thread-safe and is meant to be
+ * owned by one solver.
+ */
+class PrimalSolutionPool {
+ public:
+  /**
+   * Constructor
+   * @param [in] maxSize : The maximum number of recycled solutions. If all of them are still in use, acquire() allocates a new one that
+   *                       is not recycled.
+   */
+  explicit PrimalSolutionPool(size_t maxSize = 4);
+
+  /**
+   * Returns a solution which is not referenced by anyone else. Its content is the one of a previously released solution (or empty).
+   * The solution can be modified until it is shared as a snapshot.
+   */
+  std::shared_ptr<PrimalSolution> acquire();
+
+  /** Number of solutions owned by the pool */
+  size_t size() const { return solutions_.size(); }
+
+ private:
+  size_t maxSize_;
+  std::vector<std::shared_ptr<PrimalSolution>> solutions_;
+};
+
+}  // namespace ocs2
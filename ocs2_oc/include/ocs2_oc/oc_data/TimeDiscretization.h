@@ -92,6 +92,15 @@ scalar_array_t toTime(const std::vector<AnnotatedTime>& annotatedTime);
  */
 scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTime);
 
+/**
+ * Extracts the times at which the nodes of a multiple-shooting transcription are evaluated: the event time for pre-event nodes and
+ * getIntervalStart() for all other nodes.
+ *
+ * @param annotatedTime : Annotated time trajectory.
+ * @return The node evaluation times.
+ */
+scalar_array_t toNodeTime(const std::vector<AnnotatedTime>& annotatedTime);
+
 /**
  * Extracts the array of indices indicating the post-event times from the annotated time trajectory.
  *
@@ -29,9 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <Eigen/Sparse>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_oc/oc_problem/OcpSize.h"
 
@@ -89,6 +92,8 @@ void getConstraintMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::
  * @param[in] constraints: Linear approximation of the constraints over the time horizon. Pass nullptr if there is no constraints.
  * @param[in] scalingVectorsPtr: Vector representatoin for the identity parts of the dynamics inside the constraint matrix. After scaling,
  *                               they become arbitrary diagonal matrices. Pass nullptr to get them filled with identity matrices.
+ * @note The sparsity pattern is recomputed on every call. For repeated assembly of the same problem size use KktSparsityPattern.
+ *
  * @param[out] G: The jacobian of the concatenated constraints w.r.t. Z.
  * @param[out] g: The concatenated constraints value.
  */
@@ -136,12 +141,116 @@ void getCostMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::vector
  * @param[in] ocpSize: The size of optimal control problem.
  * @param[in] x0: The initial state.
  * @param[in] cost: Quadratic approximation of the cost over the time horizon.
+ * @note The sparsity pattern is recomputed on every call. For repeated assembly of the same problem size use KktSparsityPattern.
+ *
  * @param[out] H: The concatenated hessian matrix w.r.t. Z.
  * @param[out] h: The concatenated jacobian vector w.r.t. Z.
  */
 void getCostMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                          Eigen::SparseMatrix<scalar_t>& H, vector_t& h);
 
+/**
+ * The symbolic structure of the sparse KKT matrices G and H of getConstraintMatrixSparse() and getCostMatrixSparse(). The structure only
+ * depends on the OcpSize. It is therefore computed once, together with the slots of each node block in the compressed storage, and the
+ * matrices of later calls are assembled by copying the values of the nodes into their slots.
+ *
+ * Unlike getConstraintMatrixSparse() and getCostMatrixSparse(), all entries of the dense blocks are structural, i.e., zeros are stored
+ * explicitly, and the identity (scaling) blocks of the dynamics only store their diagonal.
+ *
+ * The output matrices are expected to be either empty or assembled by a previous call to the same pattern. Only their size and column
+ * pointers are compared with the pattern before the values are overwritten.
+ */
+class KktSparsityPattern {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] ocpSize: The size of optimal control problem.
+   * @param[in] withConstraints: Whether the general equality constraints are part of G.
+   */
+  KktSparsityPattern(const OcpSize& ocpSize, bool withConstraints);
+
+  /** Whether the pattern was created for this problem size and constraints configuration. */
+  bool isCompatible(const OcpSize& ocpSize, bool withConstraints) const {
+    return withConstraints == withConstraints_ && ocpSize == ocpSize_;
+  }
+
+  const OcpSize& getOcpSize() const { return ocpSize_; }
+  bool hasConstraints() const { return withConstraints_; }
+  int getNumDecisionVariables() const { return static_cast<int>(costPattern_.cols()); }
+  int getNumConstraints() const { return static_cast<int>(constraintPattern_.rows()); }
+
+  /**
+   * Assembles G and g, see getConstraintMatrixSparse() for their definition.
+   *
+   * @param[in] x0: The initial state.
+   * @param[in] dynamics: Linear approximation of the dynamics over the time horizon.
+   * @param[in] constraints: Linear approximation of the constraints over the time horizon. Must be nullptr iff the pattern is without
+   *                         constraints.
+   * @param[in] scalingVectorsPtr: The diagonals of the identity parts of the dynamics. Pass nullptr to fill them with ones.
+   * @param[in, out] G: The jacobian of the concatenated constraints w.r.t. Z.
+   * @param[out] g: The concatenated constraints value.
+   */
+  void getConstraintMatrix(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                           const std::vector<VectorFunctionLinearApproximation>* constraintsPtr, const vector_array_t* scalingVectorsPtr,
+                           Eigen::SparseMatrix<scalar_t>& G, vector_t& g) const;
+
+  /** Same as getConstraintMatrix() with the nodes distributed over the threads of the pool. */
+  void getConstraintMatrixInParallel(ThreadPool& threadPool, const vector_t& x0,
+                                     const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
+                                     const vector_array_t* scalingVectorsPtr, Eigen::SparseMatrix<scalar_t>& G, vector_t& g) const;
+
+  /**
+   * Assembles H and h, see getCostMatrixSparse() for their definition.
+   *
+   * @param[in] x0: The initial state.
+   * @param[in] cost: Quadratic approximation of the cost over the time horizon.
+   * @param[in, out] H: The concatenated hessian matrix w.r.t. Z.
+   * @param[out] h: The concatenated jacobian vector w.r.t. Z.
+   */
+  void getCostMatrix(const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost, Eigen::SparseMatrix<scalar_t>& H,
+                     vector_t& h) const;
+
+  /** Same as getCostMatrix() with the nodes distributed over the threads of the pool. */
+  void getCostMatrixInParallel(ThreadPool& threadPool, const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                               Eigen::SparseMatrix<scalar_t>& H, vector_t& h) const;
+
+ private:
+  /** The slots of a block in the value array of the compressed matrix. */
+  struct BlockSlots {
+    int rows = 0;
+    bool isDiagonal = false;
+    std::vector<int> columnSlots;  // slot of the first entry of each column of the block
+  };
+
+  /** The blocks of node k. Blocks which are not part of the node are left empty. */
+  struct NodeSlots {
+    int dynamicsRow = 0;    // first row of the dynamics of node k in G
+    int constraintRow = 0;  // first row of the general constraints of node k in G
+    int stateCol = 0;       // first column of x_{k} in Z (x_{0} is not part of Z)
+    int inputCol = 0;       // first column of u_{k} in Z
+    BlockSlots A, B, I, C, D;
+    BlockSlots Q, P, Pt, R;
+  };
+
+  void checkInputs(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                   const std::vector<VectorFunctionLinearApproximation>* constraintsPtr, const vector_array_t* scalingVectorsPtr) const;
+
+  void setConstraintNode(int k, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                         const std::vector<VectorFunctionLinearApproximation>* constraintsPtr, const vector_array_t* scalingVectorsPtr,
+                         scalar_t* values, vector_t& g) const;
+
+  void setCostNode(int k, const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost, scalar_t* values,
+                   vector_t& h) const;
+
+  OcpSize ocpSize_;
+  bool withConstraints_;
+  Eigen::SparseMatrix<scalar_t> constraintPattern_;
+  Eigen::SparseMatrix<scalar_t> costPattern_;
+  std::vector<NodeSlots> nodes_;
+};
+
 /**
  * Deserializes the stacked solution to state-input trajecotries. Note that the initial state is not part of the stacked solution.
  *
@@ -190,6 +190,16 @@ class SolverBase {
    */
   PrimalSolution primalSolution(scalar_t finalTime) const;
 
+  /**
+   * @brief Returns the optimized policy data as an immutable snapshot which can be shared with the consumers (e.g. the MRT) without a
+   * copy. The snapshot remains valid and unchanged after the next run of the solver. The default implementation copies the solution
+   * by getPrimalSolution().
+   *
+   * @param [in] finalTime: The final time.
+   * @return: The primal problem's solution.
+   */
+  virtual std::shared_ptr<const PrimalSolution> getPrimalSolutionSnapshot(scalar_t finalTime) const;
+
   /**
    * @brief Returns the optimized dual solution.
    *
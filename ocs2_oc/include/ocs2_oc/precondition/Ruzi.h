@@ -29,9 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <vector>
+
 #include <Eigen/Sparse>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/CacheLinePadded.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_oc/oc_problem/OcpSize.h"
@@ -145,6 +148,24 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
 void kktMatrixInPlace(int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h, Eigen::SparseMatrix<scalar_t>& G, vector_t& g,
                       vector_t& DOut, vector_t& EOut, scalar_t& cOut);
 
+/**
+ * Same as kktMatrixInPlace() above, with the scaling factors decomposed for each time step as in ocpDataInPlaceInParallel(). This allows
+ * to pre-condition the sparse KKT matrices directly after their assembly, e.g., with a KktSparsityPattern, instead of the node data.
+ * G must only contain the dynamics constraints.
+ *
+ * @param [in] ocpSize : The size of the oc problem.
+ * @param [in] iteration : Number of iterations.
+ * @param [in, out] H : The hessian matrix of the total cost.
+ * @param [in, out] h : The jacobian vector of the total cost.
+ * @param [in, out] G : The jacobian matrix of the constarinst.
+ * @param [in, out] g : The constraints vector.
+ * @param [out] DOut : The matrix D decomposed for each time step.
+ * @param [out] EOut : The matrix E decomposed for each time step.
+ * @param [out] cOut : Scaling factor c.
+ */
+void kktMatrixInPlace(const OcpSize& ocpSize, int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h,
+                      Eigen::SparseMatrix<scalar_t>& G, vector_t& g, vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut);
+
 /**
  * Scales the dynamics and cost array in place and construct scaling vector array from the given scaling factors E, D and c.
  *
@@ -172,5 +193,81 @@ void scaleOcpData(const OcpSize& ocpSize, const vector_t& D, const vector_t& E,
  */
 void descaleSolution(const vector_array_t& D, vector_array_t& xTrajectory, vector_array_t& uTrajectory);
 
+/**
+ * The modified Ruzi equilibration of ocpDataInPlaceInParallel() as a reusable object which keeps its workspaces between calls.
+ *
+ * Compared to ocpDataInPlaceInParallel(), the data of each node is only traversed once per iteration: the scaling of a node is fused with
+ * the computation of the norms that the next iteration needs. The scaling of the cost by c is deferred and merged into the scaling of the
+ * next iteration. The reductions over the nodes are accumulated per worker and merged after each parallel pass. The iterations stop
+ * early once all the entries of the new scaling factors D and E are within the tolerance of one, i.e., the data is equilibrated.
+ */
+class RuziPreconditioner {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] maxNumIterations : The maximum number of iterations.
+   * @param [in] tolerance : The iterations stop if max(|D - 1|, |E - 1|) of an iteration is below the tolerance. With a tolerance of
+   *                         zero, maxNumIterations iterations are run as in ocpDataInPlaceInParallel().
+   */
+  explicit RuziPreconditioner(int maxNumIterations, scalar_t tolerance = 0.0);
+
+  /**
+   * Calculates the pre-conditioning factors D, E, and c, and scales the dynamics and cost data in place and in parallel. The arguments
+   * and the outputs are the same as ocpDataInPlaceInParallel().
+   *
+   * @param [in] threadPool : The external thread pool.
+   * @param [in] x0 : The initial state.
+   * @param [in] ocpSize : The size of the oc problem.
+   * @param [in, out] dynamics : The dynamics array of all time points.
+   * @param [in, out] cost : The cost array of all time points.
+   * @param [out] DOut : The matrix D decomposed for each time step.
+   * @param [out] EOut : The matrix E decomposed for each time step.
+   * @param [out] scalingVectors : The diagonals of the identity parts of the dynamics constraints after scaling.
+   * @param [out] cOut : Scaling factor c.
+   */
+  void precondition(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize,
+                    std::vector<VectorFunctionLinearApproximation>& dynamics, std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                    vector_array_t& DOut, vector_array_t& EOut, vector_array_t& scalingVectors, scalar_t& cOut);
+
+  /** The number of iterations of the last call to precondition(). */
+  int getNumIterations() const { return numIterations_; }
+
+ private:
+  /** Accumulators of a worker */
+  struct WorkerReduction {
+    scalar_t infNormOfh;
+    scalar_t sumOfInfNormOfH;
+    scalar_t maxDeviation;
+  };
+
+  void resizeWorkspace(const OcpSize& ocpSize, size_t numWorkers);
+
+  /** Computes D and E of node k from the norms. Returns max(|D - 1|, |E - 1|) of the node. */
+  scalar_t computeScalingFactors(int k, scalar_t gamma, const vector_array_t& scalingVectors);
+
+  /** Scales the data of node k with D, E, and gamma, and accumulates the scaling factors. */
+  void scaleNode(int k, scalar_t gamma, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                 std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                 vector_array_t& scalingVectors) const;
+
+  /** Computes the norms of node k for the next iteration and accumulates the norms of the cost for gamma. */
+  void computeNorms(int k, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                    const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors,
+                    WorkerReduction& reduction);
+
+  const int maxNumIterations_;
+  const scalar_t tolerance_;
+  int numIterations_ = 0;
+
+  // Workspace. Same layout as DOut and EOut, i.e., D_[2k] for u_{k} and D_[2k+1] for x_{k+1}.
+  vector_array_t D_;
+  vector_array_t E_;
+  vector_array_t costColNorms_;      // inf-norms of the columns of H, same layout as D_
+  vector_array_t dynamicsColNorms_;  // inf-norms of the columns of the dynamics blocks [-A, -B] of G, same layout as D_
+  vector_array_t dynamicsRowNorms_;  // inf-norms of the rows of the dynamics blocks [-A, -B, I] of G, same layout as E_
+  std::vector<CacheLinePadded<WorkerReduction>> reductions_;  // one per worker, padded to avoid false sharing
+};
+
 }  // namespace precondition
 }  // namespace ocs2
\ No newline at end of file
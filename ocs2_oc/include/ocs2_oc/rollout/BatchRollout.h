@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/rollout/RolloutBase.h"
+
+namespace ocs2 {
+
+/**
+ * The trajectories of a batch of rollouts on a shared time grid. The states (inputs) of all rollouts at the time node k are stored
+ * in the columns [k * batchSize, (k + 1) * batchSize) of stateTrajectories (inputTrajectories).
+ */
+struct BatchRolloutTrajectories {
+  size_t batchSize = 0;
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  matrix_t stateTrajectories;
+  matrix_t inputTrajectories;
+
+  /** The states of all rollouts at the time node k, one state per column. */
+  matrix_t::ConstColsBlockXpr states(size_t k) const { return stateTrajectories.middleCols(k * batchSize, batchSize); }
+
+  /** The inputs of all rollouts at the time node k, one input per column. */
+  matrix_t::ConstColsBlockXpr inputs(size_t k) const { return inputTrajectories.middleCols(k * batchSize, batchSize); }
+
+  /** The state trajectory of the rollout i. */
+  vector_array_t getStateTrajectory(size_t i) const;
+
+  /** The input trajectory of the rollout i. */
+  vector_array_t getInputTrajectory(size_t i) const;
+};
+
+/**
+ * This class integrates a batch of initial states in lock-step with one shared controller. The batch is split into chunks, one per
+ * thread, and each chunk is integrated as one ODE whose flow map evaluates the controller with ControllerBase::computeInputBatch and
+ * the dynamics with ControlledSystemBase::computeFlowMapBatch. All rollouts share the same time grid, the mode schedule is time-triggered.
+ *
+ * Only the fixed time-step integrators (EULER_OCS2, MIDPOINT_OCS2, RK4_OCS2) are supported such that the time grid does not depend on
+ * the states. With these integrators, a batch of size one gives the same result as TimeTriggeredRollout.
+ */
+class BatchRollout : public RolloutBase {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] systemDynamics: The system dynamics for forward rollout.
+   * @param [in] rolloutSettings: The rollout settings.
+   * @param [in] numThreads: The number of threads, including the calling thread.
+   * @param [in] threadPriority: The priority of the worker threads.
+   */
+  BatchRollout(const ControlledSystemBase& systemDynamics, rollout::Settings rolloutSettings, size_t numThreads = 1,
+               int threadPriority = 50);
+
+  ~BatchRollout() override;
+  BatchRollout(const BatchRollout&) = delete;
+  BatchRollout& operator=(const BatchRollout&) = delete;
+  BatchRollout* clone() const override;
+
+  /**
+   * Forward integrates a batch of initial states with the given controller in time period [initTime, finalTime].
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initStates: The initial states of the batch.
+   * @param [in] finalTime: The final time.
+   * @param [in] controller: The control policy shared by all rollouts. Each thread evaluates its own clone.
+   * @param [in] modeSchedule: Defines the sequence of modes and the associated event times.
+   * @param [out] trajectories: The trajectories of the batch.
+   */
+  void runBatch(scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime, const ControllerBase& controller,
+                const ModeSchedule& modeSchedule, BatchRolloutTrajectories& trajectories);
+
+  vector_t run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
+               scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
+               vector_array_t& inputTrajectory) override;
+
+ private:
+  class BatchFlowMap;
+  struct Worker;
+
+  /** Integrates the chunk of the given worker. */
+  void runWorker(Worker& worker, scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime,
+                 const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray);
+
+  const size_t numThreads_;
+  const int threadPriority_;
+  ThreadPool threadPool_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic_size_t nextWorkerId_{0};
+};
+
+}  // namespace ocs2
@@ -51,7 +51,7 @@ struct Settings {
   size_t maxNumStepsPerSecond = 10000;
   /** The integration time step used in the fixed time-step rollout methods */
   scalar_t timeStep = 1e-2;
-  /** Rollout integration scheme type */
+  /** Rollout integration scheme type. The fixed time-step types (EULER_OCS2, MIDPOINT_OCS2, RK4_OCS2) integrate with timeStep. */
   IntegratorType integratorType = IntegratorType::ODE45;
 
   /** Whether to check that the rollout is numerically stable */
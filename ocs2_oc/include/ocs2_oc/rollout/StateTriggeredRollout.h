@@ -34,14 +34,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
 #include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/RungeKuttaFixedStep.h>
 #include <ocs2_core/integration/StateTriggeredEventHandler.h>
 
 #include "ocs2_oc/rollout/RolloutBase.h"
+#include "ocs2_oc/rollout/RootFinder.h"
 
 namespace ocs2 {
 
 /**
  * This class is an interface class for forward rollout of the system dynamics.
+ *
+ * With the fixed-step Runge-Kutta integrators (EULER_OCS2, MIDPOINT_OCS2, RK4_OCS2), an event is located on the dense output of the
+ * step in which the guard surface is crossed. The other integrators integrate again to each query point of the root finding.
  */
 class StateTriggeredRollout : public RolloutBase {
  public:
@@ -69,12 +74,20 @@ class StateTriggeredRollout : public RolloutBase {
                vector_array_t& inputTrajectory) override;
 
  private:
+  /**
+   * Locates the event within the last step of the integrator on its dense output. The last element of the trajectories, which is
+   * past the guard surface, is replaced by the located event.
+   */
+  void locateEventOnDenseOutput(size_t eventID, RootFinder& rootFinder, scalar_array_t& timeTrajectory,
+                                vector_array_t& stateTrajectory) const;
+
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
 
   std::shared_ptr<StateTriggeredEventHandler> systemEventHandlersPtr_;
 
   std::unique_ptr<IntegratorBase> dynamicsIntegratorPtr_;
+  const RungeKuttaFixedStep* denseOutputIntegratorPtr_ = nullptr;  // Not owned, set if dynamicsIntegratorPtr_ provides dense output.
 };
 
 }  // namespace ocs2
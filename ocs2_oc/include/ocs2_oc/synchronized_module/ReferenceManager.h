@@ -29,7 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include "ocs2_core/thread_support/BufferedValue.h"
+#include "ocs2_core/thread_support/SharedBufferedValue.h"
 #include "ocs2_oc/synchronized_module/ReferenceManagerInterface.h"
 
 namespace ocs2 {
@@ -37,6 +37,10 @@ namespace ocs2 {
 /**
  * Implements the reference manager with a thread-safe buffer for setting and getting the references.
  * A protected virtual interface is provided to modify the references before each solver run.
+ *
+ * The references are stored as reference-counted snapshots. Setting a snapshot and activating it in preSolverRun() are pointer swaps,
+ * and the active references are only copied when they are modified while being shared (copy-on-write). Derived classes that never
+ * modify the references opt out of the copy through modifiesReferences().
  */
 class ReferenceManager : public ReferenceManagerInterface {
  public:
@@ -50,6 +54,10 @@ class ReferenceManager : public ReferenceManagerInterface {
   const ModeSchedule& getModeSchedule() const override { return modeSchedule_.get(); }
   void setModeSchedule(const ModeSchedule& modeSchedule) override { modeSchedule_.setBuffer(modeSchedule); }
   void setModeSchedule(ModeSchedule&& modeSchedule) override { modeSchedule_.setBuffer(std::move(modeSchedule)); }
+  std::shared_ptr<const ModeSchedule> getModeScheduleSnapshot() const override { return modeSchedule_.getSnapshot(); }
+  void setModeScheduleSnapshot(std::shared_ptr<const ModeSchedule> modeSchedulePtr) override {
+    modeSchedule_.setBuffer(std::move(modeSchedulePtr));
+  }
 
   const TargetTrajectories& getTargetTrajectories() const override { return targetTrajectories_.get(); }
   void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
@@ -58,6 +66,10 @@ class ReferenceManager : public ReferenceManagerInterface {
   void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
     return targetTrajectories_.setBuffer(std::move(targetTrajectories));
   }
+  std::shared_ptr<const TargetTrajectories> getTargetTrajectoriesSnapshot() const override { return targetTrajectories_.getSnapshot(); }
+  void setTargetTrajectoriesSnapshot(std::shared_ptr<const TargetTrajectories> targetTrajectoriesPtr) override {
+    targetTrajectories_.setBuffer(std::move(targetTrajectoriesPtr));
+  }
 
  protected:
   /**
@@ -70,13 +82,21 @@ class ReferenceManager : public ReferenceManagerInterface {
    * TargetTrajectories is already updated by the set value.
    * @param [in, out] modeSchedule : The updated ModeSchedule. If setModeSchedule() has been called before, modeSchedule is
    * already updated by the set value.
+   *
+   * @note The references passed here are copied first if they are shared with a snapshot (copy-on-write).
    */
   virtual void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                                 ModeSchedule& modeSchedule) {}
 
+  /**
+   * Whether modifyReferences() has to be called before each solver run. Derived classes that never modify the references can return
+   * false, then the active references are not copied on the solver thread and the snapshots are used as they are.
+   */
+  virtual bool modifiesReferences() const { return true; }
+
  private:
-  BufferedValue<ModeSchedule> modeSchedule_;
-  BufferedValue<TargetTrajectories> targetTrajectories_;
+  SharedBufferedValue<ModeSchedule> modeSchedule_;
+  SharedBufferedValue<TargetTrajectories> targetTrajectories_;
 };
 
 }  // namespace ocs2
@@ -55,6 +55,10 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
   const ModeSchedule& getModeSchedule() const override { return referenceManagerPtr_->getModeSchedule(); }
   void setModeSchedule(const ModeSchedule& modeSchedule) override { referenceManagerPtr_->setModeSchedule(modeSchedule); }
   void setModeSchedule(ModeSchedule&& modeSchedule) override { referenceManagerPtr_->setModeSchedule(std::move(modeSchedule)); }
+  std::shared_ptr<const ModeSchedule> getModeScheduleSnapshot() const override { return referenceManagerPtr_->getModeScheduleSnapshot(); }
+  void setModeScheduleSnapshot(std::shared_ptr<const ModeSchedule> modeSchedulePtr) override {
+    referenceManagerPtr_->setModeScheduleSnapshot(std::move(modeSchedulePtr));
+  }
 
   const TargetTrajectories& getTargetTrajectories() const override { return referenceManagerPtr_->getTargetTrajectories(); }
   void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
@@ -63,6 +67,12 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
   void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
     referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
   }
+  std::shared_ptr<const TargetTrajectories> getTargetTrajectoriesSnapshot() const override {
+    return referenceManagerPtr_->getTargetTrajectoriesSnapshot();
+  }
+  void setTargetTrajectoriesSnapshot(std::shared_ptr<const TargetTrajectories> targetTrajectoriesPtr) override {
+    referenceManagerPtr_->setTargetTrajectoriesSnapshot(std::move(targetTrajectoriesPtr));
+  }
 
  protected:
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
@@ -76,6 +78,18 @@ class ReferenceManagerInterface {
    */
   virtual void setModeSchedule(ModeSchedule&& modeSchedule) = 0;
 
+  /** Returns a shared immutable snapshot of the active ModeSchedule. The default implementation copies the active ModeSchedule. */
+  virtual std::shared_ptr<const ModeSchedule> getModeScheduleSnapshot() const {
+    return std::make_shared<const ModeSchedule>(getModeSchedule());
+  }
+
+  /**
+   * Sets a shared immutable snapshot of the ModeSchedule to the buffer. The buffer will move to active ModeSchedule once preSolverRun()
+   * is called. The default implementation copies the snapshot.
+   * @note: This method must be thread safe.
+   */
+  virtual void setModeScheduleSnapshot(std::shared_ptr<const ModeSchedule> modeSchedulePtr) { setModeSchedule(*modeSchedulePtr); }
+
   /** Returns a const reference to the active TargetTrajectories. */
   virtual const TargetTrajectories& getTargetTrajectories() const = 0;
 
@@ -90,6 +104,23 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Returns a shared immutable snapshot of the active TargetTrajectories. The default implementation copies the active
+   * TargetTrajectories.
+   */
+  virtual std::shared_ptr<const TargetTrajectories> getTargetTrajectoriesSnapshot() const {
+    return std::make_shared<const TargetTrajectories>(getTargetTrajectories());
+  }
+
+  /**
+   * Sets a shared immutable snapshot of the TargetTrajectories to the buffer. The buffer will move to active TargetTrajectories once
+   * preSolverRun() is called. The default implementation copies the snapshot.
+   * @note: This method must be thread safe.
+   */
+  virtual void setTargetTrajectoriesSnapshot(std::shared_ptr<const TargetTrajectories> targetTrajectoriesPtr) {
+    setTargetTrajectories(*targetTrajectoriesPtr);
+  }
 };
 
 }  // namespace ocs2
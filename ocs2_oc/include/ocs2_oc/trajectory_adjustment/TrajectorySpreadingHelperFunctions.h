@@ -141,4 +141,26 @@ inline TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeS
   return status;
 }
 
+/**
+ * Adjusts a primal solution based on the last changes in mode schedule using a TrajectorySpreading strategy. The old solution is left
+ * untouched, e.g. when it is shared as an immutable snapshot.
+ * Note: PrimalSolution::controllerPtr_ will not be copied.
+ *
+ * @param [in] oldModeSchedule: The old mode schedule associated to the trajectories which should be adjusted.
+ * @param [in] newModeSchedule: The new mode schedule that should be adapted to.
+ * @param [in] oldPrimalSolution: The primal solution that is associated with the old mode schedule.
+ * @param [out] newPrimalSolution: The updated primal solution that is associated with the new mode schedule.
+ * @returns the status of the devised trajectory spreading strategy.
+ */
+inline TrajectorySpreading::Status trajectorySpread(const ModeSchedule& oldModeSchedule, const ModeSchedule& newModeSchedule,
+                                                    const PrimalSolution& oldPrimalSolution, PrimalSolution& newPrimalSolution) {
+  newPrimalSolution.timeTrajectory_ = oldPrimalSolution.timeTrajectory_;
+  newPrimalSolution.stateTrajectory_ = oldPrimalSolution.stateTrajectory_;
+  newPrimalSolution.inputTrajectory_ = oldPrimalSolution.inputTrajectory_;
+  newPrimalSolution.postEventIndices_ = oldPrimalSolution.postEventIndices_;
+  newPrimalSolution.modeSchedule_ = oldPrimalSolution.modeSchedule_;
+  newPrimalSolution.controllerPtr_.reset();
+  return trajectorySpread(oldModeSchedule, newModeSchedule, newPrimalSolution);
+}
+
 }  // namespace ocs2
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
 
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Profiler.h>
 
 namespace ocs2 {
 
@@ -42,7 +43,10 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
                                const MultiplierCollection& multipliers, ModelData& modelData) {
   auto& preComputation = *problem.preComputationPtr;
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics + Request::Approximation;
-  preComputation.request(request, time, state, input);
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request");
+    preComputation.request(request, time, state, input);
+  }
 
   modelData.time = time;
   modelData.stateDim = state.rows();
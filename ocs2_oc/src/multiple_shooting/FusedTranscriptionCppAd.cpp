@@ -0,0 +1,490 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/FusedTranscriptionCppAd.h"
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+
+#include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+
+/** Moves the StateInputConstraintCppAd terms out of the collection and records the original term order and the fused term names. */
+template <typename Terms, typename Slots>
+void extractConstraintTerms(StateInputConstraintCollection& collection, Terms& fusedTerms, Slots& slots,
+                            std::vector<std::string>& fusedTermNames) {
+  size_t remainderIndex = 0;
+  for (const auto& name : collection.getTermNames()) {
+    if (dynamic_cast<StateInputConstraintCppAd*>(&collection.get(name)) != nullptr) {
+      auto termPtr = collection.extract(name);
+      fusedTerms.emplace_back(static_cast<StateInputConstraintCppAd*>(termPtr.release()));
+      slots.push_back({true, fusedTerms.size() - 1});
+      fusedTermNames.push_back(name);
+    } else {
+      slots.push_back({false, remainderIndex++});
+    }
+  }
+}
+
+/** Moves the StateInputCostCppAd terms out of the collection and records the fused term names. */
+void extractCostTerms(StateInputCostCollection& collection, std::vector<std::unique_ptr<StateInputCostCppAd>>& fusedTerms,
+                      std::vector<std::string>& fusedTermNames) {
+  for (const auto& name : collection.getTermNames()) {
+    if (dynamic_cast<StateInputCostCppAd*>(&collection.get(name)) != nullptr) {
+      auto termPtr = collection.extract(name);
+      fusedTerms.emplace_back(static_cast<StateInputCostCppAd*>(termPtr.release()));
+      fusedTermNames.push_back(name);
+    }
+  }
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedTranscriptionCppAd::FusedTranscriptionCppAd(size_t stateDim, size_t inputDim, const OptimalControlProblem& optimalControlProblem,
+                                                 SensitivityIntegratorType integratorType, const std::string& modelName,
+                                                 const std::string& modelFolder, bool recompileLibraries, bool verbose)
+    : stateDim_(stateDim),
+      inputDim_(inputDim),
+      integratorType_(integratorType),
+      sensitivityDiscretizer_(selectDynamicsSensitivityDiscretization(integratorType)),
+      remainderProblem_(optimalControlProblem) {
+  const auto fusedTermNames = extractFusedTerms();
+  if (fuseDynamics_ || getNumFusedTerms() > 0) {
+    createModels(modelName, fusedTermNames, modelFolder, recompileLibraries, verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedTranscriptionCppAd::FusedTranscriptionCppAd(const FusedTranscriptionCppAd& other)
+    : stateDim_(other.stateDim_),
+      inputDim_(other.inputDim_),
+      integratorType_(other.integratorType_),
+      sensitivityDiscretizer_(other.sensitivityDiscretizer_),
+      remainderProblem_(other.remainderProblem_),
+      fuseDynamics_(other.fuseDynamics_),
+      costOutputOffset_(other.costOutputOffset_),
+      numOutputs_(other.numOutputs_),
+      numParameters_(other.numParameters_) {
+  fusedCosts_.reserve(other.fusedCosts_.size());
+  for (const auto& term : other.fusedCosts_) {
+    fusedCosts_.emplace_back(static_cast<StateInputCostCppAd*>(term->clone()));
+  }
+
+  auto copyConstraints = [](const FusedConstraints& from, FusedConstraints& to) {
+    to.terms.reserve(from.terms.size());
+    for (const auto& term : from.terms) {
+      to.terms.emplace_back(static_cast<StateInputConstraintCppAd*>(term->clone()));
+    }
+    to.sizes = from.sizes;
+    to.outputOffsets = from.outputOffsets;
+    to.slots = from.slots;
+  };
+  copyConstraints(other.fusedEqualityConstraints_, fusedEqualityConstraints_);
+  copyConstraints(other.fusedInequalityConstraints_, fusedInequalityConstraints_);
+
+  if (other.adInterfacePtr_ != nullptr) {
+    adInterfacePtr_.reset(new CppAdInterface(*other.adInterfacePtr_));
+  }
+  if (other.costHessianInterfacePtr_ != nullptr) {
+    costHessianInterfacePtr_.reset(new CppAdInterface(*other.costHessianInterfacePtr_));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::string> FusedTranscriptionCppAd::extractFusedTerms() {
+  // Dynamics: only parameter free flow maps with an explicit scheme can be traced
+  const auto* dynamicsAdPtr = dynamic_cast<const SystemDynamicsBaseAD*>(remainderProblem_.dynamicsPtr.get());
+  const bool isExplicitScheme = integratorType_ == SensitivityIntegratorType::EULER || integratorType_ == SensitivityIntegratorType::RK2 ||
+                                integratorType_ == SensitivityIntegratorType::RK4;
+  fuseDynamics_ = isExplicitScheme && dynamicsAdPtr != nullptr && dynamicsAdPtr->getFlowMapParameterDim() == 0;
+
+  std::vector<std::string> fusedTermNames;
+  extractCostTerms(*remainderProblem_.costPtr, fusedCosts_, fusedTermNames);
+  extractCostTerms(*remainderProblem_.softConstraintPtr, fusedCosts_, fusedTermNames);
+  extractConstraintTerms(*remainderProblem_.equalityConstraintPtr, fusedEqualityConstraints_.terms, fusedEqualityConstraints_.slots,
+                         fusedTermNames);
+  extractConstraintTerms(*remainderProblem_.inequalityConstraintPtr, fusedInequalityConstraints_.terms,
+                         fusedInequalityConstraints_.slots, fusedTermNames);
+  return fusedTermNames;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FusedTranscriptionCppAd::createModels(const std::string& modelName, const std::vector<std::string>& fusedTermNames,
+                                           const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  // Parameters: [t, dt, cost activity weights, cost parameters, equality parameters, inequality parameters]
+  numParameters_ = 2 + fusedCosts_.size();
+  for (const auto& term : fusedCosts_) {
+    numParameters_ += term->getNumParameters();
+  }
+  for (const auto* constraints : {&fusedEqualityConstraints_, &fusedInequalityConstraints_}) {
+    for (const auto& term : constraints->terms) {
+      numParameters_ += term->getNumParameters();
+    }
+  }
+
+  // Outputs: [x_next, cost terms, equality constraints, inequality constraints]. Constraint sizes are found by evaluating the terms once.
+  numOutputs_ = fuseDynamics_ ? stateDim_ : 0;
+  costOutputOffset_ = numOutputs_;
+  numOutputs_ += fusedCosts_.size();
+  const ad_vector_t zeroState = ad_vector_t::Zero(stateDim_);
+  const ad_vector_t zeroInput = ad_vector_t::Zero(inputDim_);
+  for (auto* constraints : {&fusedEqualityConstraints_, &fusedInequalityConstraints_}) {
+    constraints->sizes.clear();
+    constraints->outputOffsets.clear();
+    for (const auto& term : constraints->terms) {
+      const ad_vector_t zeroParameters = ad_vector_t::Zero(term->getNumParameters());
+      const size_t numConstraints = term->traceConstraintFunction(ad_scalar_t(0.0), zeroState, zeroInput, zeroParameters).size();
+      constraints->sizes.push_back(numConstraints);
+      constraints->outputOffsets.push_back(numOutputs_);
+      numOutputs_ += numConstraints;
+    }
+  }
+
+  // Name the libraries after everything that changes the generated code
+  std::stringstream signature;
+  signature << stateDim_ << '_' << inputDim_ << '_' << static_cast<int>(integratorType_) << '_' << fuseDynamics_ << '_' << numParameters_
+            << '_' << numOutputs_;
+  for (const auto& name : fusedTermNames) {
+    signature << '_' << name;
+  }
+  std::stringstream modelNameStream;
+  modelNameStream << modelName << '_' << std::hex << std::hash<std::string>{}(signature.str());
+  const std::string uniqueModelName = modelNameStream.str();
+
+  auto createModel = [&](CppAdInterface& adInterface, CppAdInterface::ApproximationOrder order) {
+    if (recompileLibraries) {
+      adInterface.createModels(order, verbose);
+    } else {
+      adInterface.loadModelsIfAvailable(order, verbose);
+    }
+  };
+
+  auto fusedFunction = [this](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) { y = this->fusedFunction(x, p); };
+  adInterfacePtr_.reset(new CppAdInterface(fusedFunction, stateDim_ + inputDim_, numParameters_, uniqueModelName, modelFolder));
+  createModel(*adInterfacePtr_, CppAdInterface::ApproximationOrder::First);
+
+  if (!fusedCosts_.empty()) {
+    auto costFunction = [this](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+      y = ad_vector_t::Constant(1, this->costFunction(x, p));
+    };
+    costHessianInterfacePtr_.reset(
+        new CppAdInterface(costFunction, stateDim_ + inputDim_, numParameters_, uniqueModelName + "_cost_hessian", modelFolder));
+    createModel(*costHessianInterfacePtr_, CppAdInterface::ApproximationOrder::Second);
+  }
+
+  if (verbose) {
+    std::cerr << "[FusedTranscriptionCppAd] Fused model '" << uniqueModelName << "': dynamics " << (fuseDynamics_ ? "fused" : "not fused")
+              << ", " << fusedCosts_.size() << " cost terms, " << fusedEqualityConstraints_.terms.size() << " equality constraint terms, "
+              << fusedInequalityConstraints_.terms.size() << " inequality constraint terms.\n";
+  }
+}
+
+/******************************************************************************************************/
+ad_vector_t FusedTranscriptionCppAd::discretizeFlowMap(const SystemDynamicsBaseAD& dynamics, SensitivityIntegratorType integratorType,
+                                                       ad_scalar_t t, ad_scalar_t dt, const ad_vector_t& x, const ad_vector_t& u) {
+  const ad_vector_t p(0);
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER: {
+      return x + dt * dynamics.traceFlowMap(t, x, u, p);
+    }
+    case SensitivityIntegratorType::RK2: {
+      const ad_vector_t k1 = dynamics.traceFlowMap(t, x, u, p);
+      const ad_vector_t k2 = dynamics.traceFlowMap(t + dt, x + dt * k1, u, p);
+      return x + (0.5 * dt) * (k1 + k2);
+    }
+    case SensitivityIntegratorType::RK4: {
+      const ad_scalar_t dt_halve = 0.5 * dt;
+      const ad_vector_t k1 = dynamics.traceFlowMap(t, x, u, p);
+      const ad_vector_t k2 = dynamics.traceFlowMap(t + dt_halve, x + dt_halve * k1, u, p);
+      const ad_vector_t k3 = dynamics.traceFlowMap(t + dt_halve, x + dt_halve * k2, u, p);
+      const ad_vector_t k4 = dynamics.traceFlowMap(t + dt, x + dt * k3, u, p);
+      return x + (dt / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+    }
+    default:
+      throw std::runtime_error("[FusedTranscriptionCppAd] Unknown integrator type.");
+  }
+}
+
+/******************************************************************************************************/
+ad_vector_t FusedTranscriptionCppAd::fusedFunction(const ad_vector_t& stateInput, const ad_vector_t& parameters) const {
+  const ad_vector_t state = stateInput.head(stateDim_);
+  const ad_vector_t input = stateInput.tail(inputDim_);
+  const ad_scalar_t time = parameters(0);
+  const ad_scalar_t dt = parameters(1);
+  size_t parameterIndex = 2 + fusedCosts_.size();
+
+  ad_vector_t y(numOutputs_);
+  if (fuseDynamics_) {
+    const auto& dynamics = static_cast<const SystemDynamicsBaseAD&>(*remainderProblem_.dynamicsPtr);
+    y.head(stateDim_) = discretizeFlowMap(dynamics, integratorType_, time, dt, state, input);
+  }
+
+  for (size_t i = 0; i < fusedCosts_.size(); ++i) {
+    const size_t numTermParameters = fusedCosts_[i]->getNumParameters();
+    const ad_vector_t termParameters = parameters.segment(parameterIndex, numTermParameters);
+    y(costOutputOffset_ + i) = fusedCosts_[i]->traceCostFunction(time, state, input, termParameters);
+    parameterIndex += numTermParameters;
+  }
+
+  for (const auto* constraints : {&fusedEqualityConstraints_, &fusedInequalityConstraints_}) {
+    for (size_t i = 0; i < constraints->terms.size(); ++i) {
+      const size_t numTermParameters = constraints->terms[i]->getNumParameters();
+      const ad_vector_t termParameters = parameters.segment(parameterIndex, numTermParameters);
+      y.segment(constraints->outputOffsets[i], constraints->sizes[i]) =
+          constraints->terms[i]->traceConstraintFunction(time, state, input, termParameters);
+      parameterIndex += numTermParameters;
+    }
+  }
+
+  return y;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ad_scalar_t FusedTranscriptionCppAd::costFunction(const ad_vector_t& stateInput, const ad_vector_t& parameters) const {
+  const ad_vector_t state = stateInput.head(stateDim_);
+  const ad_vector_t input = stateInput.tail(inputDim_);
+  const ad_scalar_t time = parameters(0);
+  size_t parameterIndex = 2 + fusedCosts_.size();
+
+  // Inactive terms are selected out instead of weighted with zero, such that their values (possibly not finite) do not propagate.
+  ad_scalar_t cost(0.0);
+  for (size_t i = 0; i < fusedCosts_.size(); ++i) {
+    const size_t numTermParameters = fusedCosts_[i]->getNumParameters();
+    const ad_vector_t termParameters = parameters.segment(parameterIndex, numTermParameters);
+    const ad_scalar_t termCost = fusedCosts_[i]->traceCostFunction(time, state, input, termParameters);
+    cost += CppAD::CondExpGt(parameters(2 + i), ad_scalar_t(0.5), termCost, ad_scalar_t(0.0));
+    parameterIndex += numTermParameters;
+  }
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FusedTranscriptionCppAd::getParameters(scalar_t t, scalar_t dt) const {
+  const auto& targetTrajectories = *remainderProblem_.targetTrajectoriesPtr;
+  const auto& preComputation = *remainderProblem_.preComputationPtr;
+
+  vector_t parameters(numParameters_);
+  parameters(0) = t;
+  parameters(1) = dt;
+  size_t parameterIndex = 2 + fusedCosts_.size();
+
+  for (size_t i = 0; i < fusedCosts_.size(); ++i) {
+    const auto& term = *fusedCosts_[i];
+    const bool isActive = term.isActive(t);
+    parameters(2 + i) = isActive ? 1.0 : 0.0;
+    const size_t numTermParameters = term.getNumParameters();
+    if (isActive) {
+      parameters.segment(parameterIndex, numTermParameters) = term.getParameters(t, targetTrajectories, preComputation);
+    } else {
+      parameters.segment(parameterIndex, numTermParameters).setZero();
+    }
+    parameterIndex += numTermParameters;
+  }
+
+  for (const auto* constraints : {&fusedEqualityConstraints_, &fusedInequalityConstraints_}) {
+    for (const auto& termPtr : constraints->terms) {
+      const size_t numTermParameters = termPtr->getNumParameters();
+      if (termPtr->isActive(t)) {
+        parameters.segment(parameterIndex, numTermParameters) = termPtr->getParameters(t, preComputation);
+      } else {
+        parameters.segment(parameterIndex, numTermParameters).setZero();
+      }
+      parameterIndex += numTermParameters;
+    }
+  }
+
+  return parameters;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Transcription FusedTranscriptionCppAd::setupIntermediateNode(scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next,
+                                                             const vector_t& u) {
+  // Results and short-hand notation
+  Transcription transcription;
+  auto& cost = transcription.cost;
+  auto& dynamics = transcription.dynamics;
+  auto& constraintsSize = transcription.constraintsSize;
+  auto& problem = remainderProblem_;
+
+  // Precomputation, also provides the parameters of the fused terms
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
+  problem.preComputationPtr->request(request, t, x, u);
+
+  // Fused model: values and jacobians of all fused terms, and the hessian of the active cost terms
+  vector_t parameters;
+  vector_t fusedValue;
+  matrix_t fusedJacobian;
+  matrix_t fusedCostHessian;
+  if (adInterfacePtr_ != nullptr) {
+    vector_t stateInput(x.size() + u.size());
+    stateInput << x, u;
+    parameters = getParameters(t, dt);
+    fusedValue = adInterfacePtr_->getFunctionValue(stateInput, parameters);
+    fusedJacobian = adInterfacePtr_->getJacobian(stateInput, parameters);
+    if (costHessianInterfacePtr_ != nullptr) {
+      fusedCostHessian = costHessianInterfacePtr_->getHessian(0, stateInput, parameters);
+    }
+  }
+
+  // Dynamics
+  if (fuseDynamics_) {
+    dynamics.f = fusedValue.head(stateDim_) - x_next;
+    dynamics.dfdx = fusedJacobian.topLeftCorner(stateDim_, stateDim_);
+    dynamics.dfdu = fusedJacobian.topRightCorner(stateDim_, inputDim_);
+  } else {
+    dynamics = sensitivityDiscretizer_(*problem.dynamicsPtr, t, x, u, dt);
+    dynamics.f -= x_next;
+  }
+
+  // Costs: Approximate the integral with forward euler
+  cost = approximateCost(problem, t, x, u);
+  if (!fusedCosts_.empty()) {
+    for (size_t i = 0; i < fusedCosts_.size(); ++i) {
+      if (isCostActive(parameters, i)) {
+        const size_t row = costOutputOffset_ + i;
+        cost.f += fusedValue(row);
+        cost.dfdx += fusedJacobian.block(row, 0, 1, stateDim_).transpose();
+        cost.dfdu += fusedJacobian.block(row, stateDim_, 1, inputDim_).transpose();
+      }
+    }
+    cost.dfdxx += fusedCostHessian.topLeftCorner(stateDim_, stateDim_);
+    cost.dfdux += fusedCostHessian.bottomLeftCorner(inputDim_, stateDim_);
+    cost.dfduu += fusedCostHessian.bottomRightCorner(inputDim_, inputDim_);
+  }
+  cost *= dt;
+
+  // State equality constraints
+  if (!problem.stateEqualityConstraintPtr->empty()) {
+    constraintsSize.stateEq = problem.stateEqualityConstraintPtr->getTermsSize(t);
+    transcription.stateEqConstraints = problem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *problem.preComputationPtr);
+  }
+
+  // State-input equality constraints
+  if (!fusedEqualityConstraints_.slots.empty()) {
+    assembleConstraints(t, x, u, fusedEqualityConstraints_, *problem.equalityConstraintPtr, fusedValue, fusedJacobian,
+                        constraintsSize.stateInputEq, transcription.stateInputEqConstraints);
+  }
+
+  // State inequality constraints.
+  if (!problem.stateInequalityConstraintPtr->empty()) {
+    constraintsSize.stateIneq = problem.stateInequalityConstraintPtr->getTermsSize(t);
+    transcription.stateIneqConstraints = problem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *problem.preComputationPtr);
+  }
+
+  // State-input inequality constraints.
+  if (!fusedInequalityConstraints_.slots.empty()) {
+    assembleConstraints(t, x, u, fusedInequalityConstraints_, *problem.inequalityConstraintPtr, fusedValue, fusedJacobian,
+                        constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints);
+  }
+
+  return transcription;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FusedTranscriptionCppAd::assembleConstraints(scalar_t t, const vector_t& x, const vector_t& u,
+                                                  const FusedConstraints& fusedConstraints,
+                                                  const StateInputConstraintCollection& remainderConstraints, const vector_t& fusedValue,
+                                                  const matrix_t& fusedJacobian, size_array_t& termsSize,
+                                                  VectorFunctionLinearApproximation& constraints) const {
+  const auto& slots = fusedConstraints.slots;
+
+  // Remainder terms in their collection order
+  size_array_t remainderSize;
+  VectorFunctionLinearApproximation remainderApproximation;
+  if (!remainderConstraints.empty()) {
+    remainderSize = remainderConstraints.getTermsSize(t);
+    remainderApproximation = remainderConstraints.getLinearApproximation(t, x, u, *remainderProblem_.preComputationPtr);
+  }
+  size_array_t remainderOffsets(remainderSize.size(), 0);
+  for (size_t i = 1; i < remainderSize.size(); ++i) {
+    remainderOffsets[i] = remainderOffsets[i - 1] + remainderSize[i - 1];
+  }
+
+  // Sizes in the original term order
+  termsSize.resize(slots.size());
+  for (size_t i = 0; i < slots.size(); ++i) {
+    if (slots[i].isFused) {
+      termsSize[i] = fusedConstraints.terms[slots[i].index]->isActive(t) ? fusedConstraints.sizes[slots[i].index] : 0;
+    } else {
+      termsSize[i] = remainderSize[slots[i].index];
+    }
+  }
+  const size_t numConstraints = std::accumulate(termsSize.begin(), termsSize.end(), size_t(0));
+
+  // Stack the active terms
+  constraints = VectorFunctionLinearApproximation(numConstraints, stateDim_, inputDim_);
+  size_t row = 0;
+  for (size_t i = 0; i < slots.size(); ++i) {
+    const size_t nc = termsSize[i];
+    if (nc == 0) {
+      continue;
+    }
+    if (slots[i].isFused) {
+      const size_t offset = fusedConstraints.outputOffsets[slots[i].index];
+      constraints.f.segment(row, nc) = fusedValue.segment(offset, nc);
+      constraints.dfdx.middleRows(row, nc) = fusedJacobian.block(offset, 0, nc, stateDim_);
+      constraints.dfdu.middleRows(row, nc) = fusedJacobian.block(offset, stateDim_, nc, inputDim_);
+    } else {
+      const size_t offset = remainderOffsets[slots[i].index];
+      constraints.f.segment(row, nc) = remainderApproximation.f.segment(offset, nc);
+      constraints.dfdx.middleRows(row, nc) = remainderApproximation.dfdx.middleRows(offset, nc);
+      constraints.dfdu.middleRows(row, nc) = remainderApproximation.dfdu.middleRows(offset, nc);
+    }
+    row += nc;
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
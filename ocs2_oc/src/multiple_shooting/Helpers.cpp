@@ -143,5 +143,29 @@ ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vec
   return problemMetrics;
 }
 
+ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, const FlatMetrics& metrics) {
+  assert(time.size() > 1);
+  assert(metrics.size() == time.size());
+
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // resize
+  ProblemMetrics problemMetrics;
+  problemMetrics.intermediates.reserve(N);
+  problemMetrics.preJumps.reserve(N / 10);  // the size is just a guess
+  problemMetrics.final = metrics.getMetrics(N);
+
+  for (int i = 0; i < N; ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      problemMetrics.preJumps.push_back(metrics.getMetrics(i));
+    } else {
+      problemMetrics.intermediates.push_back(metrics.getMetrics(i));
+    }
+  }
+
+  return problemMetrics;
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
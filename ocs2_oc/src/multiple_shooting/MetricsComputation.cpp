@@ -29,11 +29,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/MetricsComputation.h"
 
+#include <ocs2_core/misc/Profiler.h>
+
 #include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
 
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Copies a stacked vector into a flat metrics segment of the same size. */
+template <typename Derived>
+void copyToSegment(const Eigen::MatrixBase<Derived>& value, FlatMetrics::segment_t segment) {
+  if (value.size() != segment.size()) {
+    throw std::runtime_error("[multiple_shooting::computeMetrics] The metrics layout does not match the problem!");
+  }
+  segment = value;
+}
+}  // unnamed namespace
+
 Metrics computeMetrics(const Transcription& transcription) {
   const auto& constraintsSize = transcription.constraintsSize;
 
@@ -101,7 +114,10 @@ Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem,
 
   // Precomputation
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
-  optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request");
+    optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  }
 
   // Compute metrics
   auto metrics = computeIntermediateMetrics(optimalControlProblem, t, x, u, std::move(dynamicsViolation));
@@ -130,5 +146,154 @@ Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar
   return computePreJumpMetrics(optimalControlProblem, t, x, std::move(dynamicsViolation));
 }
 
+MetricsSize getIntermediateMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t, size_t nextStateDim) {
+  MetricsSize metricsSize;
+  metricsSize.dynamicsViolation = nextStateDim;
+  if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
+    metricsSize.stateEqConstraint = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
+  }
+  if (!optimalControlProblem.equalityConstraintPtr->empty()) {
+    metricsSize.stateInputEqConstraint = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
+  }
+  if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
+    metricsSize.stateIneqConstraint = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
+  }
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    metricsSize.stateInputIneqConstraint = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
+  }
+  return metricsSize;
+}
+
+MetricsSize getEventMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t, size_t nextStateDim) {
+  MetricsSize metricsSize;
+  metricsSize.dynamicsViolation = nextStateDim;
+  if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
+    metricsSize.stateEqConstraint = optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t);
+  }
+  if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
+    metricsSize.stateIneqConstraint = optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t);
+  }
+  return metricsSize;
+}
+
+MetricsSize getTerminalMetricsSize(const OptimalControlProblem& optimalControlProblem, scalar_t t) {
+  MetricsSize metricsSize;
+  if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
+    metricsSize.stateEqConstraint = optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t);
+  }
+  if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
+    metricsSize.stateIneqConstraint = optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t);
+  }
+  return metricsSize;
+}
+
+void computeMetrics(const Transcription& transcription, FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+  metrics.cost(i) = transcription.cost.f;
+  copyToSegment(transcription.dynamics.f, metrics.values(Field::DynamicsViolation, i));
+  copyToSegment(transcription.stateEqConstraints.f, metrics.values(Field::StateEqConstraint, i));
+  copyToSegment(transcription.stateInputEqConstraints.f, metrics.values(Field::StateInputEqConstraint, i));
+  copyToSegment(transcription.stateIneqConstraints.f, metrics.values(Field::StateIneqConstraint, i));
+  copyToSegment(transcription.stateInputIneqConstraints.f, metrics.values(Field::StateInputIneqConstraint, i));
+}
+
+void computeMetrics(const EventTranscription& transcription, FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+  metrics.cost(i) = transcription.cost.f;
+  copyToSegment(transcription.dynamics.f, metrics.values(Field::DynamicsViolation, i));
+  copyToSegment(transcription.eqConstraints.f, metrics.values(Field::StateEqConstraint, i));
+  copyToSegment(transcription.ineqConstraints.f, metrics.values(Field::StateIneqConstraint, i));
+}
+
+void computeMetrics(const TerminalTranscription& transcription, FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+  metrics.cost(i) = transcription.cost.f;
+  copyToSegment(transcription.eqConstraints.f, metrics.values(Field::StateEqConstraint, i));
+  copyToSegment(transcription.ineqConstraints.f, metrics.values(Field::StateIneqConstraint, i));
+}
+
+void computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
+                                const vector_t& x, const vector_t& x_next, const vector_t& u, FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+
+  // Dynamics
+  copyToSegment(discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt) - x_next, metrics.values(Field::DynamicsViolation, i));
+
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request");
+    optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  }
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Cost
+  metrics.cost(i) = dt * computeCost(optimalControlProblem, t, x, u);
+
+  // Equality constraints
+  if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
+    optimalControlProblem.stateEqualityConstraintPtr->getStackedValue(t, x, preComputation, metrics.values(Field::StateEqConstraint, i));
+  }
+  if (!optimalControlProblem.equalityConstraintPtr->empty()) {
+    optimalControlProblem.equalityConstraintPtr->getStackedValue(t, x, u, preComputation, metrics.values(Field::StateInputEqConstraint, i));
+  }
+
+  // Inequality constraints
+  if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
+    optimalControlProblem.stateInequalityConstraintPtr->getStackedValue(t, x, preComputation,
+                                                                        metrics.values(Field::StateIneqConstraint, i));
+  }
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    optimalControlProblem.inequalityConstraintPtr->getStackedValue(t, x, u, preComputation,
+                                                                   metrics.values(Field::StateInputIneqConstraint, i));
+  }
+}
+
+void computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                         FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics;
+  optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Dynamics
+  copyToSegment(optimalControlProblem.dynamicsPtr->computeJumpMap(t, x) - x_next, metrics.values(Field::DynamicsViolation, i));
+
+  // Cost
+  metrics.cost(i) = computeEventCost(optimalControlProblem, t, x);
+
+  // Constraints
+  if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
+    optimalControlProblem.preJumpEqualityConstraintPtr->getStackedValue(t, x, preComputation, metrics.values(Field::StateEqConstraint, i));
+  }
+  if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
+    optimalControlProblem.preJumpInequalityConstraintPtr->getStackedValue(t, x, preComputation,
+                                                                          metrics.values(Field::StateIneqConstraint, i));
+  }
+}
+
+void computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Cost
+  metrics.cost(i) = computeFinalCost(optimalControlProblem, t, x);
+
+  // Constraints
+  if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
+    optimalControlProblem.finalEqualityConstraintPtr->getStackedValue(t, x, preComputation, metrics.values(Field::StateEqConstraint, i));
+  }
+  if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
+    optimalControlProblem.finalInequalityConstraintPtr->getStackedValue(t, x, preComputation,
+                                                                        metrics.values(Field::StateIneqConstraint, i));
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,253 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/StructuredConstraintProjection.h"
+
+#include <algorithm>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+// Below this ratio between the smallest and largest pivot of the basis, the basic inputs of a cached pattern are chosen again.
+constexpr scalar_t minBasisPivotRatio = 1e-6;
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StructuredConstraintProjection::compute(const VectorFunctionLinearApproximation& constraint, size_t patternKey,
+                                             VectorFunctionLinearApproximation& projection, matrix_t* pseudoInverse) {
+  const auto& C = constraint.dfdx;
+  const auto& D = constraint.dfdu;
+  const auto& e = constraint.f;
+  const auto numStates = C.cols();
+  const auto numInputs = D.cols();
+
+  // Pattern: take it from the cache while D has the same structure and the basis is well conditioned
+  auto patternIt = patternCache_.find(patternKey);
+  if (patternIt == patternCache_.end() || !hasPattern(D, patternIt->second) || !factorizeBasis(D, patternIt->second)) {
+    patternIt = patternCache_.insert({patternKey, Pattern()}).first;
+    patternIt->second = computePattern(D);
+    ++numPatternUpdates_;
+    if (!factorizeBasis(D, patternIt->second)) {
+      // No well conditioned basis, e.g. badly scaled or rank deficient D: fall back to the dense projection for this node
+      patternCache_.erase(patternIt);
+      ++numDenseFallbacks_;
+      auto luProjection = LinearAlgebra::luConstraintProjection(constraint, pseudoInverse != nullptr);
+      projection = std::move(luProjection.first);
+      if (pseudoInverse != nullptr) {
+        *pseudoInverse = std::move(luProjection.second);
+      }
+      return;
+    }
+  }
+  auto& pattern = patternIt->second;
+  const auto numSelection = pattern.selectionRows.size();
+  const auto numDense = pattern.denseRows.size();
+  const auto numNonBasic = static_cast<Eigen::Index>(pattern.nonBasicInputs.size());
+
+  projection.dfdx.setZero(numInputs, numStates);
+  projection.dfdu.setZero(numInputs, numNonBasic);
+  projection.f.setZero(numInputs);
+
+  // Selection rows: D(r, j) * u(j) = -C(r, :) * x - e(r)
+  for (size_t k = 0; k < numSelection; ++k) {
+    const auto r = pattern.selectionRows[k];
+    const auto j = pattern.fixedInputs[k];
+    const scalar_t inverseDiagonal = 1.0 / D(r, j);
+    projection.dfdx.row(j) = -inverseDiagonal * C.row(r);
+    projection.f(j) = -inverseDiagonal * e(r);
+  }
+
+  // Dense rows: basis * u_basic = -(C + D_fixed * Px_fixed) * x - (e + D_fixed * Pe_fixed) - D_nonBasic * \tilde{u}
+  for (Eigen::Index k = 0; k < numNonBasic; ++k) {
+    projection.dfdu(pattern.nonBasicInputs[k], k) = 1.0;
+  }
+  if (numDense > 0) {
+    pattern.denseRhs.resize(numDense, numStates + 1 + numNonBasic);
+    for (size_t a = 0; a < numDense; ++a) {
+      const auto r = pattern.denseRows[a];
+      pattern.denseRhs.row(a).head(numStates) = C.row(r);
+      pattern.denseRhs(a, numStates) = e(r);
+      for (size_t k = 0; k < numSelection; ++k) {
+        const auto j = pattern.fixedInputs[k];
+        if (D(r, j) != 0.0) {
+          pattern.denseRhs.row(a).head(numStates) += D(r, j) * projection.dfdx.row(j);
+          pattern.denseRhs(a, numStates) += D(r, j) * projection.f(j);
+        }
+      }
+      for (Eigen::Index k = 0; k < numNonBasic; ++k) {
+        pattern.denseRhs(a, numStates + 1 + k) = D(r, pattern.nonBasicInputs[k]);
+      }
+    }
+    pattern.denseSolution = pattern.basisLu.solve(pattern.denseRhs);
+
+    for (size_t b = 0; b < numDense; ++b) {
+      const auto i = pattern.basicInputs[b];
+      projection.dfdx.row(i) = -pattern.denseSolution.row(b).head(numStates);
+      projection.f(i) = -pattern.denseSolution(b, numStates);
+      projection.dfdu.row(i) = -pattern.denseSolution.row(b).tail(numNonBasic);
+    }
+  }
+
+  // Left pseudo-inverse of D^T, the transpose of the right inverse of D that maps [C, e] to -[Px, Pe]
+  if (pseudoInverse != nullptr) {
+    pseudoInverse->setZero(D.rows(), numInputs);
+    if (numDense > 0) {
+      pattern.basisInverse = pattern.basisLu.inverse();
+    }
+    for (size_t k = 0; k < numSelection; ++k) {
+      const auto r = pattern.selectionRows[k];
+      const auto j = pattern.fixedInputs[k];
+      const scalar_t inverseDiagonal = 1.0 / D(r, j);
+      (*pseudoInverse)(r, j) = inverseDiagonal;
+      for (size_t a = 0; a < numDense; ++a) {
+        const scalar_t coupling = D(pattern.denseRows[a], j);
+        if (coupling != 0.0) {
+          for (size_t b = 0; b < numDense; ++b) {
+            (*pseudoInverse)(r, pattern.basicInputs[b]) -= inverseDiagonal * coupling * pattern.basisInverse(b, a);
+          }
+        }
+      }
+    }
+    for (size_t a = 0; a < numDense; ++a) {
+      for (size_t b = 0; b < numDense; ++b) {
+        (*pseudoInverse)(pattern.denseRows[a], pattern.basicInputs[b]) = pattern.basisInverse(b, a);
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto StructuredConstraintProjection::computePattern(const matrix_t& D) -> Pattern {
+  Pattern pattern;
+  pattern.numInputs = D.cols();
+
+  // Selection rows, each fixing a different input
+  std::vector<bool> isFixed(D.cols(), false);
+  for (Eigen::Index r = 0; r < D.rows(); ++r) {
+    Eigen::Index numNonZeros = 0;
+    Eigen::Index nonZeroIndex = 0;
+    for (Eigen::Index j = 0; j < D.cols(); ++j) {
+      if (D(r, j) != 0.0) {
+        ++numNonZeros;
+        nonZeroIndex = j;
+      }
+    }
+    if (numNonZeros == 1 && !isFixed[nonZeroIndex]) {
+      isFixed[nonZeroIndex] = true;
+      pattern.selectionRows.push_back(r);
+      pattern.fixedInputs.push_back(nonZeroIndex);
+    } else {
+      pattern.denseRows.push_back(r);
+    }
+  }
+
+  std::vector<Eigen::Index> freeInputs;
+  for (Eigen::Index j = 0; j < D.cols(); ++j) {
+    if (!isFixed[j]) {
+      freeInputs.push_back(j);
+    }
+  }
+
+  // Basic inputs: the first pivot columns of a full pivoting LU decomposition of the dense rows on the free inputs
+  const auto numDense = pattern.denseRows.size();
+  if (numDense > 0) {
+    matrix_t denseBlock(numDense, freeInputs.size());
+    for (size_t a = 0; a < numDense; ++a) {
+      for (size_t k = 0; k < freeInputs.size(); ++k) {
+        denseBlock(a, k) = D(pattern.denseRows[a], freeInputs[k]);
+      }
+    }
+    const Eigen::FullPivLU<matrix_t> lu(denseBlock);
+    std::vector<bool> isBasic(freeInputs.size(), false);
+    for (size_t b = 0; b < std::min(numDense, freeInputs.size()); ++b) {
+      const auto k = lu.permutationQ().indices()(b);
+      isBasic[k] = true;
+      pattern.basicInputs.push_back(freeInputs[k]);
+    }
+    for (size_t k = 0; k < freeInputs.size(); ++k) {
+      if (!isBasic[k]) {
+        pattern.nonBasicInputs.push_back(freeInputs[k]);
+      }
+    }
+  } else {
+    pattern.nonBasicInputs = std::move(freeInputs);
+  }
+
+  if (pattern.basicInputs.size() != numDense) {
+    throw std::runtime_error("[StructuredConstraintProjection] The state-input equality constraints have more rows than inputs.");
+  }
+  return pattern;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StructuredConstraintProjection::hasPattern(const matrix_t& D, const Pattern& pattern) {
+  if (D.cols() != pattern.numInputs || D.rows() != static_cast<Eigen::Index>(pattern.selectionRows.size() + pattern.denseRows.size())) {
+    return false;
+  }
+  for (size_t k = 0; k < pattern.selectionRows.size(); ++k) {
+    const auto r = pattern.selectionRows[k];
+    const auto j = pattern.fixedInputs[k];
+    if (D(r, j) == 0.0 || (D.row(r).head(j).array() != 0.0).any() || (D.row(r).tail(D.cols() - j - 1).array() != 0.0).any()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StructuredConstraintProjection::factorizeBasis(const matrix_t& D, Pattern& pattern) {
+  const auto numDense = pattern.denseRows.size();
+  if (numDense == 0) {
+    return true;
+  }
+
+  pattern.basis.resize(numDense, numDense);
+  for (size_t a = 0; a < numDense; ++a) {
+    for (size_t b = 0; b < numDense; ++b) {
+      pattern.basis(a, b) = D(pattern.denseRows[a], pattern.basicInputs[b]);
+    }
+  }
+  pattern.basisLu.compute(pattern.basis);
+  const auto pivots = pattern.basisLu.matrixLU().diagonal().cwiseAbs();
+  return pivots.minCoeff() > minBasisPivotRatio * pivots.maxCoeff();
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/multiple_shooting/Transcription.h"
 
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Profiler.h>
 
 #include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 #include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
@@ -37,6 +38,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Adapts dynamics, cost, and state-input inequality constraints to the projected input u = Pu * \tilde{u} + Px * x + Pe */
+void applyProjection(Transcription& transcription) {
+  const auto& projection = transcription.constraintsProjection;
+  changeOfInputVariables(transcription.dynamics, projection.dfdu, projection.dfdx, projection.f);
+  changeOfInputVariables(transcription.cost, projection.dfdu, projection.dfdx, projection.f);
+  if (transcription.stateInputIneqConstraints.f.size() > 0) {
+    changeOfInputVariables(transcription.stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
+  }
+}
+}  // namespace
+
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
   // Results and short-hand notation
@@ -56,7 +69,10 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 
   // Precomputation for other terms
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
-  optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  {
+    OCS2_PROFILE_ZONE("PreComputation::request");
+    optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  }
 
   // Costs: Approximate the integral with forward euler
   cost = approximateCost(optimalControlProblem, t, x, u);
@@ -94,31 +110,44 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
-  auto& cost = transcription.cost;
-  auto& dynamics = transcription.dynamics;
   auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
-  auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
   auto& projection = transcription.constraintsProjection;
   auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
 
   if (stateInputEqConstraints.f.size() > 0) {
-    // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
+    // Projection stored instead of constraint. LU is faster than QR, see ocs2_constraint_projection_benchmark in ocs2_benchmarks.
     if (extractProjectionMultiplier) {
       matrix_t constraintPseudoInverse;
       std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
-      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
+      projectionMultiplierCoefficients.compute(transcription.cost, transcription.dynamics, projection, constraintPseudoInverse);
     } else {
       projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
       projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
     }
     stateInputEqConstraints = VectorFunctionLinearApproximation();
 
-    // Adapt dynamics, cost, and state-input inequality constraints
-    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
-    if (stateInputIneqConstraints.f.size() > 0) {
-      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
+    applyProjection(transcription);
+  }
+}
+
+void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier,
+                          StructuredConstraintProjection& structuredProjection, size_t patternKey) {
+  auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  auto& projection = transcription.constraintsProjection;
+  auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
+
+  if (stateInputEqConstraints.f.size() > 0) {
+    if (extractProjectionMultiplier) {
+      matrix_t constraintPseudoInverse;
+      structuredProjection.compute(stateInputEqConstraints, patternKey, projection, &constraintPseudoInverse);
+      projectionMultiplierCoefficients.compute(transcription.cost, transcription.dynamics, projection, constraintPseudoInverse);
+    } else {
+      structuredProjection.compute(stateInputEqConstraints, patternKey, projection);
+      projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
     }
+    stateInputEqConstraints = VectorFunctionLinearApproximation();
+
+    applyProjection(transcription);
   }
 }
 
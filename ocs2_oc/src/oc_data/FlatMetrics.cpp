@@ -0,0 +1,194 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_data/FlatMetrics.h"
+
+#include <numeric>
+
+namespace ocs2 {
+
+namespace {
+size_t sum(const size_array_t& termsSize) {
+  return std::accumulate(termsSize.cbegin(), termsSize.cend(), size_t(0));
+}
+
+size_t getNumValues(FlatMetrics::Field field, const MetricsSize& s) {
+  switch (field) {
+    case FlatMetrics::Field::DynamicsViolation:
+      return s.dynamicsViolation;
+    case FlatMetrics::Field::StateEqConstraint:
+      return sum(s.stateEqConstraint);
+    case FlatMetrics::Field::StateInputEqConstraint:
+      return sum(s.stateInputEqConstraint);
+    case FlatMetrics::Field::StateIneqConstraint:
+      return sum(s.stateIneqConstraint);
+    case FlatMetrics::Field::StateInputIneqConstraint:
+      return sum(s.stateInputIneqConstraint);
+    default:
+      throw std::runtime_error("[FlatMetrics] Unknown field!");
+  }
+}
+
+vector_array_t toConstraintArray(const FlatMetrics& metrics, FlatMetrics::Field field, size_t i, size_t numTerms) {
+  vector_array_t constraintArray(numTerms);
+  for (size_t term = 0; term < numTerms; ++term) {
+    constraintArray[term] = metrics.termValues(field, i, term);
+  }
+  return constraintArray;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool operator==(const MetricsSize& lhs, const MetricsSize& rhs) {
+  return lhs.dynamicsViolation == rhs.dynamicsViolation && lhs.stateEqConstraint == rhs.stateEqConstraint &&
+         lhs.stateInputEqConstraint == rhs.stateInputEqConstraint && lhs.stateIneqConstraint == rhs.stateIneqConstraint &&
+         lhs.stateInputIneqConstraint == rhs.stateInputIneqConstraint;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FlatMetrics::setLayout(const std::vector<MetricsSize>& sizes) {
+  if (sizes == sizes_) {
+    return;
+  }
+
+  sizes_ = sizes;
+  costs_.resize(sizes_.size());
+  for (size_t f = 0; f < numFields; ++f) {
+    auto& offsets = nodeOffsets_[f];
+    offsets.resize(sizes_.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < sizes_.size(); ++i) {
+      offsets[i + 1] = offsets[i] + getNumValues(static_cast<Field>(f), sizes_[i]);
+    }
+    fields_[f].resize(offsets.back());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FlatMetrics::clear() {
+  sizes_.clear();
+  costs_.resize(0);
+  for (size_t f = 0; f < numFields; ++f) {
+    fields_[f].resize(0);
+    nodeOffsets_[f].clear();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FlatMetrics::swap(FlatMetrics& other) {
+  sizes_.swap(other.sizes_);
+  costs_.swap(other.costs_);
+  for (size_t f = 0; f < numFields; ++f) {
+    fields_[f].swap(other.fields_[f]);
+    nodeOffsets_[f].swap(other.nodeOffsets_[f]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const size_array_t& FlatMetrics::getTermSizes(Field field, size_t i) const {
+  switch (field) {
+    case Field::StateEqConstraint:
+      return sizes_[i].stateEqConstraint;
+    case Field::StateInputEqConstraint:
+      return sizes_[i].stateInputEqConstraint;
+    case Field::StateIneqConstraint:
+      return sizes_[i].stateIneqConstraint;
+    case Field::StateInputIneqConstraint:
+      return sizes_[i].stateInputIneqConstraint;
+    default:
+      throw std::runtime_error("[FlatMetrics::getTermSizes] The field has no terms!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FlatMetrics::const_segment_t FlatMetrics::termValues(Field field, size_t i, size_t term) const {
+  const auto& termsSize = getTermSizes(field, i);
+  const size_t termStart = std::accumulate(termsSize.cbegin(), termsSize.cbegin() + term, nodeOffsets_[static_cast<size_t>(field)][i]);
+  return fields_[static_cast<size_t>(field)].segment(termStart, termsSize[term]);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Metrics FlatMetrics::getMetrics(size_t i) const {
+  const auto& s = sizes_[i];
+
+  Metrics metrics;
+  metrics.cost = costs_[i];
+  metrics.dynamicsViolation = values(Field::DynamicsViolation, i);
+  metrics.stateEqConstraint = toConstraintArray(*this, Field::StateEqConstraint, i, s.stateEqConstraint.size());
+  metrics.stateInputEqConstraint = toConstraintArray(*this, Field::StateInputEqConstraint, i, s.stateInputEqConstraint.size());
+  metrics.stateIneqConstraint = toConstraintArray(*this, Field::StateIneqConstraint, i, s.stateIneqConstraint.size());
+  metrics.stateInputIneqConstraint = toConstraintArray(*this, Field::StateInputIneqConstraint, i, s.stateInputIneqConstraint.size());
+  return metrics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex toPerformanceIndex(const FlatMetrics& metrics, size_t i) {
+  using Field = FlatMetrics::Field;
+  PerformanceIndex performanceIndex;
+  performanceIndex.merit = 0.0;  // left for the solver to fill
+  performanceIndex.cost = metrics.cost(i);
+  performanceIndex.dualFeasibilitiesSSE = 0.0;  // left for the solver to fill
+  performanceIndex.dynamicsViolationSSE = metrics.values(Field::DynamicsViolation, i).squaredNorm();
+  performanceIndex.equalityConstraintsSSE =
+      metrics.values(Field::StateEqConstraint, i).squaredNorm() + metrics.values(Field::StateInputEqConstraint, i).squaredNorm();
+  performanceIndex.inequalityConstraintsSSE = metrics.values(Field::StateIneqConstraint, i).cwiseMin(0.0).squaredNorm() +
+                                              metrics.values(Field::StateInputIneqConstraint, i).cwiseMin(0.0).squaredNorm();
+  return performanceIndex;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex toPerformanceIndex(const FlatMetrics& metrics, size_t i, scalar_t dt) {
+  auto performanceIndex = toPerformanceIndex(metrics, i);
+  //  performanceIndex.cost *= dt  no need since it is already considered in multiple_shooting::computeIntermediateMetrics()
+  performanceIndex.dualFeasibilitiesSSE *= dt;
+  performanceIndex.dynamicsViolationSSE *= dt;
+  performanceIndex.equalityConstraintsSSE *= dt;
+  performanceIndex.inequalityConstraintsSSE *= dt;
+  return performanceIndex;
+}
+
+}  // namespace ocs2
@@ -140,6 +140,15 @@ scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTi
   return timeTrajectory;
 }
 
+scalar_array_t toNodeTime(const std::vector<AnnotatedTime>& annotatedTime) {
+  scalar_array_t timeTrajectory;
+  timeTrajectory.reserve(annotatedTime.size());
+  for (const auto& t : annotatedTime) {
+    timeTrajectory.push_back(t.event == AnnotatedTime::Event::PreEvent ? t.time : getIntervalStart(t));
+  }
+  return timeTrajectory;
+}
+
 size_array_t toPostEventIndices(const std::vector<AnnotatedTime>& annotatedTime) {
   size_array_t postEventIndices;
   for (size_t i = 0; i < annotatedTime.size(); i++) {
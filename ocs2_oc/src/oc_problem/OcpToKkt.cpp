@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_problem/OcpToKkt.h"
 
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 
 namespace ocs2 {
@@ -46,6 +48,37 @@ int getNumDynamicsConstraints(const OcpSize& ocpSize) {
 int getNumGeneralEqualityConstraints(const OcpSize& ocpSize) {
   return std::accumulate(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), (int)0);
 }
+
+/** Copies the values of a dense block into its slots, see KktSparsityPattern::BlockSlots. */
+template <typename Slots, typename Derived>
+void setDenseBlock(const Slots& slots, const Eigen::MatrixBase<Derived>& mat, scalar_t* values) {
+  if (slots.rows == 0 || slots.columnSlots.empty()) {
+    return;
+  }
+  assert(mat.rows() == slots.rows && mat.cols() == slots.columnSlots.size());
+  for (int j = 0; j < mat.cols(); j++) {
+    Eigen::Map<vector_t>(values + slots.columnSlots[j], slots.rows) = mat.col(j);
+  }
+}
+
+/** Copies the diagonal into its slots. Pass nullptr to fill the diagonal with ones. */
+template <typename Slots>
+void setDiagonalBlock(const Slots& slots, const vector_t* diagonalPtr, scalar_t* values) {
+  assert(diagonalPtr == nullptr || diagonalPtr->size() == slots.columnSlots.size());
+  for (int j = 0; j < slots.columnSlots.size(); j++) {
+    values[slots.columnSlots[j]] = (diagonalPtr == nullptr) ? 1.0 : (*diagonalPtr)(j);
+  }
+}
+
+/** Gives the matrix the structure of the pattern, unless it already has it. */
+void setStructure(const Eigen::SparseMatrix<scalar_t>& pattern, Eigen::SparseMatrix<scalar_t>& mat) {
+  const bool hasStructure = mat.rows() == pattern.rows() && mat.cols() == pattern.cols() && mat.isCompressed() &&
+                            mat.nonZeros() == pattern.nonZeros() &&
+                            std::equal(pattern.outerIndexPtr(), pattern.outerIndexPtr() + pattern.outerSize() + 1, mat.outerIndexPtr());
+  if (!hasStructure) {
+    mat = pattern;
+  }
+}
 }  // namespace
 
 void getConstraintMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
@@ -407,6 +440,262 @@ void getCostMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const std::
   assert(H.nonZeros() <= nnz);
 }
 
+KktSparsityPattern::KktSparsityPattern(const OcpSize& ocpSize, bool withConstraints)
+    : ocpSize_(ocpSize), withConstraints_(withConstraints) {
+  const int N = ocpSize.numStages;
+  if (N < 1) {
+    throw std::runtime_error("[KktSparsityPattern] The number of stages cannot be less than 1.");
+  }
+
+  // Offsets of the nodes in G and Z
+  nodes_.resize(N + 1);
+  int numDynamicsRows = 0;
+  int numCols = 0;
+  for (int k = 0; k <= N; ++k) {
+    auto& node = nodes_[k];
+    node.dynamicsRow = numDynamicsRows;
+    node.stateCol = numCols;
+    if (k > 0) {
+      numCols += ocpSize.numStates[k];
+    }
+    node.inputCol = numCols;
+    numCols += ocpSize.numInputs[k];
+    if (k < N) {
+      numDynamicsRows += ocpSize.numStates[k + 1];
+    }
+  }
+  int numRows = numDynamicsRows;
+  for (int k = 0; k <= N; ++k) {
+    nodes_[k].constraintRow = numRows;
+    if (withConstraints) {
+      numRows += ocpSize.numIneqConstraints[k];
+    }
+  }
+
+  // Blocks of the matrices
+  struct Block {
+    BlockSlots* slotsPtr;
+    int row;
+    int col;
+    int rows;
+    int cols;
+    bool isDiagonal;
+  };
+  std::vector<Block> constraintBlocks, costBlocks;
+  for (int k = 0; k <= N; ++k) {
+    auto& node = nodes_[k];
+    const int nx_k = (k > 0) ? ocpSize.numStates[k] : 0;
+    const int nu_k = ocpSize.numInputs[k];
+
+    // Add [-A, -B, I]
+    if (k < N) {
+      const int nx_next = ocpSize.numStates[k + 1];
+      constraintBlocks.push_back({&node.A, node.dynamicsRow, node.stateCol, nx_next, nx_k, false});
+      constraintBlocks.push_back({&node.B, node.dynamicsRow, node.inputCol, nx_next, nu_k, false});
+      constraintBlocks.push_back({&node.I, node.dynamicsRow, nodes_[k + 1].stateCol, nx_next, nx_next, true});
+    }
+
+    // Add [C, D, 0]
+    const int nc_k = ocpSize.numIneqConstraints[k];
+    if (withConstraints && nc_k > 0) {
+      constraintBlocks.push_back({&node.C, node.constraintRow, node.stateCol, nc_k, nx_k, false});
+      constraintBlocks.push_back({&node.D, node.constraintRow, node.inputCol, nc_k, nu_k, false});
+    }
+
+    // Add [ Q, P'
+    //       P, R ]
+    costBlocks.push_back({&node.Q, node.stateCol, node.stateCol, nx_k, nx_k, false});
+    costBlocks.push_back({&node.Pt, node.stateCol, node.inputCol, nx_k, nu_k, false});
+    costBlocks.push_back({&node.P, node.inputCol, node.stateCol, nu_k, nx_k, false});
+    costBlocks.push_back({&node.R, node.inputCol, node.inputCol, nu_k, nu_k, false});
+  }
+
+  // Compressed structure and the slots of each block. The rows of a block are contiguous inside each column.
+  auto createPattern = [](int rows, int cols, const std::vector<Block>& blocks, Eigen::SparseMatrix<scalar_t>& pattern) {
+    std::vector<Eigen::Triplet<scalar_t>> tripletList;
+    for (const auto& block : blocks) {
+      for (int j = 0; j < block.cols; j++) {
+        if (block.isDiagonal) {
+          tripletList.emplace_back(block.row + j, block.col + j, 0.0);
+        } else {
+          for (int i = 0; i < block.rows; i++) {
+            tripletList.emplace_back(block.row + i, block.col + j, 0.0);
+          }
+        }
+      }
+    }
+    pattern.resize(rows, cols);
+    pattern.setFromTriplets(tripletList.begin(), tripletList.end());
+    pattern.makeCompressed();
+
+    for (const auto& block : blocks) {
+      auto& slots = *block.slotsPtr;
+      slots.rows = block.isDiagonal ? 1 : block.rows;
+      slots.isDiagonal = block.isDiagonal;
+      slots.columnSlots.resize(block.rows > 0 ? block.cols : 0);
+      for (int j = 0; j < slots.columnSlots.size(); j++) {
+        const int* columnBegin = pattern.innerIndexPtr() + pattern.outerIndexPtr()[block.col + j];
+        const int* columnEnd = pattern.innerIndexPtr() + pattern.outerIndexPtr()[block.col + j + 1];
+        const int firstRow = block.isDiagonal ? block.row + j : block.row;
+        slots.columnSlots[j] = static_cast<int>(std::lower_bound(columnBegin, columnEnd, firstRow) - pattern.innerIndexPtr());
+      }
+    }
+  };
+  createPattern(numRows, numCols, constraintBlocks, constraintPattern_);
+  createPattern(numCols, numCols, costBlocks, costPattern_);
+}
+
+void KktSparsityPattern::getConstraintMatrix(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                             const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
+                                             const vector_array_t* scalingVectorsPtr, Eigen::SparseMatrix<scalar_t>& G,
+                                             vector_t& g) const {
+  checkInputs(dynamics, constraintsPtr, scalingVectorsPtr);
+  setStructure(constraintPattern_, G);
+  g.resize(constraintPattern_.rows());
+  for (int k = 0; k <= ocpSize_.numStages; ++k) {
+    setConstraintNode(k, x0, dynamics, constraintsPtr, scalingVectorsPtr, G.valuePtr(), g);
+  }
+}
+
+void KktSparsityPattern::getConstraintMatrixInParallel(ThreadPool& threadPool, const vector_t& x0,
+                                                       const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                       const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
+                                                       const vector_array_t* scalingVectorsPtr, Eigen::SparseMatrix<scalar_t>& G,
+                                                       vector_t& g) const {
+  checkInputs(dynamics, constraintsPtr, scalingVectorsPtr);
+  setStructure(constraintPattern_, G);
+  g.resize(constraintPattern_.rows());
+
+  std::atomic_int timeIndex{0};
+  auto task = [&](int workerId) {
+    int k;
+    while ((k = timeIndex++) <= ocpSize_.numStages) {
+      setConstraintNode(k, x0, dynamics, constraintsPtr, scalingVectorsPtr, G.valuePtr(), g);
+    }
+  };
+  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+}
+
+void KktSparsityPattern::getCostMatrix(const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                       Eigen::SparseMatrix<scalar_t>& H, vector_t& h) const {
+  if (cost.size() < ocpSize_.numStages + 1) {
+    throw std::runtime_error("[KktSparsityPattern] The size of cost doesn't match the number of nodes.");
+  }
+  setStructure(costPattern_, H);
+  h.resize(costPattern_.rows());
+  for (int k = 0; k <= ocpSize_.numStages; ++k) {
+    setCostNode(k, x0, cost, H.valuePtr(), h);
+  }
+}
+
+void KktSparsityPattern::getCostMatrixInParallel(ThreadPool& threadPool, const vector_t& x0,
+                                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                                 Eigen::SparseMatrix<scalar_t>& H, vector_t& h) const {
+  if (cost.size() < ocpSize_.numStages + 1) {
+    throw std::runtime_error("[KktSparsityPattern] The size of cost doesn't match the number of nodes.");
+  }
+  setStructure(costPattern_, H);
+  h.resize(costPattern_.rows());
+
+  std::atomic_int timeIndex{0};
+  auto task = [&](int workerId) {
+    int k;
+    while ((k = timeIndex++) <= ocpSize_.numStages) {
+      setCostNode(k, x0, cost, H.valuePtr(), h);
+    }
+  };
+  threadPool.runParallel(std::move(task), threadPool.numThreads() + 1U);
+}
+
+void KktSparsityPattern::checkInputs(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
+                                     const vector_array_t* scalingVectorsPtr) const {
+  const int N = ocpSize_.numStages;
+  if (dynamics.size() < N) {
+    throw std::runtime_error("[KktSparsityPattern] The size of dynamics doesn't match the number of stages.");
+  }
+  if ((constraintsPtr != nullptr) != withConstraints_) {
+    throw std::runtime_error("[KktSparsityPattern] The constraints must be passed iff the pattern was created with constraints.");
+  }
+  if (constraintsPtr != nullptr && constraintsPtr->size() < N + 1) {
+    throw std::runtime_error("[KktSparsityPattern] The size of constraints doesn't match the number of nodes.");
+  }
+  if (scalingVectorsPtr != nullptr && scalingVectorsPtr->size() != N) {
+    throw std::runtime_error("[KktSparsityPattern] The size of scalingVectors doesn't match the number of stage.");
+  }
+}
+
+void KktSparsityPattern::setConstraintNode(int k, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                           const std::vector<VectorFunctionLinearApproximation>* constraintsPtr,
+                                           const vector_array_t* scalingVectorsPtr, scalar_t* values, vector_t& g) const {
+  const auto& node = nodes_[k];
+
+  if (k < ocpSize_.numStages) {
+    const auto& dynamics_k = dynamics[k];
+    const int nx_next = ocpSize_.numStates[k + 1];
+
+    // Add [-A, -B, I]. The initial state is not a decision variable, see getConstraintMatrixSparse().
+    setDenseBlock(node.A, -dynamics_k.dfdx, values);
+    setDenseBlock(node.B, -dynamics_k.dfdu, values);
+    setDiagonalBlock(node.I, (scalingVectorsPtr == nullptr) ? nullptr : &(*scalingVectorsPtr)[k], values);
+
+    // Add [b]
+    g.segment(node.dynamicsRow, nx_next) = dynamics_k.f;
+    if (k == 0) {
+      g.segment(node.dynamicsRow, nx_next).noalias() += dynamics_k.dfdx * x0;
+    }
+  }
+
+  const int nc_k = ocpSize_.numIneqConstraints[k];
+  if (withConstraints_ && nc_k > 0) {
+    const auto& constraints_k = (*constraintsPtr)[k];
+
+    // Add [C, D, 0]
+    if (k > 0) {
+      setDenseBlock(node.C, constraints_k.dfdx, values);
+    }
+    setDenseBlock(node.D, constraints_k.dfdu, values);
+
+    // Add [-e]
+    g.segment(node.constraintRow, nc_k) = -constraints_k.f;
+    if (k == 0) {
+      g.segment(node.constraintRow, nc_k).noalias() -= constraints_k.dfdx * x0;
+    }
+  }
+}
+
+void KktSparsityPattern::setCostNode(int k, const vector_t& x0, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                     scalar_t* values, vector_t& h) const {
+  const auto& node = nodes_[k];
+  const auto& cost_k = cost[k];
+  const int nx_k = (k > 0) ? ocpSize_.numStates[k] : 0;
+  const int nu_k = ocpSize_.numInputs[k];
+
+  // Add [ Q, P'
+  //       P, R ]
+  if (nx_k > 0) {
+    setDenseBlock(node.Q, cost_k.dfdxx, values);
+  }
+  if (nu_k > 0) {
+    if (nx_k > 0) {
+      setDenseBlock(node.Pt, cost_k.dfdux.transpose(), values);
+      setDenseBlock(node.P, cost_k.dfdux, values);
+    }
+    setDenseBlock(node.R, cost_k.dfduu, values);
+  }
+
+  // Add [ q, r]. Elimination of initial state requires cost adaptation at k = 0.
+  if (nx_k > 0) {
+    h.segment(node.stateCol, nx_k) = cost_k.dfdx;
+  }
+  if (nu_k > 0) {
+    h.segment(node.inputCol, nu_k) = cost_k.dfdu;
+    if (k == 0) {
+      h.segment(node.inputCol, nu_k).noalias() += cost_k.dfdux * x0;
+    }
+  }
+}
+
 void toOcpSolution(const OcpSize& ocpSize, const vector_t& stackedSolution, const vector_t x0, vector_array_t& xTrajectory,
                    vector_array_t& uTrajectory) {
   const int N = ocpSize.numStages;
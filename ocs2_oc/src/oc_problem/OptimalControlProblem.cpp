@@ -66,7 +66,13 @@ OptimalControlProblem::OptimalControlProblem()
       finalInequalityLagrangianPtr(new StateAugmentedLagrangianCollection),
       /* Misc. */
       preComputationPtr(new PreComputation),
-      targetTrajectoriesPtr(nullptr) {}
+      targetTrajectoriesPtr(nullptr) {
+  // Profiling zones of the terms, the copies keep the prefixes
+  costPtr->setProfilingPrefix("cost/");
+  softConstraintPtr->setProfilingPrefix("softConstraint/");
+  equalityConstraintPtr->setProfilingPrefix("equalityConstraint/");
+  inequalityConstraintPtr->setProfilingPrefix("inequalityConstraint/");
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
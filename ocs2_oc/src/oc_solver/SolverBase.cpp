@@ -79,6 +79,15 @@ PrimalSolution SolverBase::primalSolution(scalar_t finalTime) const {
   return primalSolution;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<const PrimalSolution> SolverBase::getPrimalSolutionSnapshot(scalar_t finalTime) const {
+  auto primalSolutionPtr = std::make_shared<PrimalSolution>();
+  getPrimalSolution(finalTime, primalSolutionPtr.get());
+  return primalSolutionPtr;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -205,6 +205,37 @@ void scaleMatrixInPlace(const vector_t& rowScale, const vector_t& colScale, Eige
   }
 }
 
+/** Scales the rows and columns of the block and multiplies it with a factor in a single pass. Pass nullptr to not scale rows or cols. */
+template <typename T>
+void scaleBlockInPlace(const vector_t* rowScale, const vector_t* colScale, scalar_t factor, Eigen::MatrixBase<T>& mat) {
+  for (int j = 0; j < mat.cols(); j++) {
+    const scalar_t colFactor = (colScale != nullptr) ? factor * (*colScale)(j) : factor;
+    if (rowScale != nullptr) {
+      mat.col(j).array() *= colFactor * rowScale->array();
+    } else if (colFactor != 1.0) {
+      mat.col(j) *= colFactor;
+    }
+  }
+}
+
+/** norms = max(norms, inf-norms of the columns of mat) */
+template <typename T>
+void maxInfNormCols(const Eigen::MatrixBase<T>& mat, vector_t& norms) {
+  if (mat.rows() > 0) {
+    for (int j = 0; j < mat.cols(); j++) {
+      norms(j) = std::max(norms(j), mat.col(j).template lpNorm<Eigen::Infinity>());
+    }
+  }
+}
+
+/** norms = max(norms, inf-norms of the rows of mat) */
+template <typename T>
+void maxInfNormRows(const Eigen::MatrixBase<T>& mat, vector_t& norms) {
+  for (int j = 0; j < mat.cols(); j++) {
+    norms = norms.cwiseMax(mat.col(j).cwiseAbs());
+  }
+}
+
 }  // anonymous namespace
 
 void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
@@ -302,6 +333,267 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
   }
 }
 
+RuziPreconditioner::RuziPreconditioner(int maxNumIterations, scalar_t tolerance)
+    : maxNumIterations_(maxNumIterations), tolerance_(tolerance) {}
+
+void RuziPreconditioner::precondition(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize,
+                                      std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                      std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                                      vector_array_t& scalingVectors, scalar_t& cOut) {
+  const int N = ocpSize.numStages;
+  if (N < 1) {
+    throw std::runtime_error("[RuziPreconditioner::precondition] The number of stages cannot be less than 1.");
+  }
+
+  // Init output
+  cOut = 1.0;
+  DOut.resize(2 * N);
+  EOut.resize(N);
+  scalingVectors.resize(N);
+  for (int i = 0; i < N; i++) {
+    DOut[2 * i].setOnes(ocpSize.numInputs[i]);
+    DOut[2 * i + 1].setOnes(ocpSize.numStates[i + 1]);
+    EOut[i].setOnes(ocpSize.numStates[i + 1]);
+    scalingVectors[i].setOnes(ocpSize.numStates[i + 1]);
+  }
+
+  const auto numDecisionVariables = std::accumulate(ocpSize.numInputs.begin(), ocpSize.numInputs.end(), 0) +
+                                    std::accumulate(std::next(ocpSize.numStates.begin()), ocpSize.numStates.end(), 0);
+  const size_t numWorkers = threadPool.numThreads() + 1U;
+  resizeWorkspace(ocpSize, numWorkers);
+  numIterations_ = 0;
+
+  auto resetReductions = [this]() {
+    for (auto& reduction : reductions_) {
+      reduction.value.infNormOfh = 0.0;
+      reduction.value.sumOfInfNormOfH = 0.0;
+      reduction.value.maxDeviation = 0.0;
+    }
+  };
+
+  // Norms of the original data
+  std::atomic_int timeIndex{0};
+  auto computeInitialNorms = [&](int workerId) {
+    int k;
+    while ((k = timeIndex++) <= N) {
+      computeNorms(k, x0, dynamics, cost, scalingVectors, reductions_[workerId].value);
+    }
+  };
+  resetReductions();
+  threadPool.runParallel(std::move(computeInitialNorms), numWorkers);
+
+  // The scaling of the cost by gamma is deferred to the next pass over the data
+  scalar_t gamma = 1.0;
+  for (int i = 0; i < maxNumIterations_; i++) {
+    // compute D and E
+    timeIndex = 0;
+    auto computeScaling = [&](int workerId) {
+      scalar_t workerMaxDeviation = 0.0;
+      int k;
+      while ((k = timeIndex++) <= N) {
+        workerMaxDeviation = std::max(workerMaxDeviation, computeScalingFactors(k, gamma, scalingVectors));
+      }
+      reductions_[workerId].value.maxDeviation = std::max(reductions_[workerId].value.maxDeviation, workerMaxDeviation);
+    };
+    resetReductions();
+    threadPool.runParallel(std::move(computeScaling), numWorkers);
+
+    scalar_t maxDeviation = 0.0;
+    for (const auto& reduction : reductions_) {
+      maxDeviation = std::max(maxDeviation, reduction.value.maxDeviation);
+    }
+    if (maxDeviation < tolerance_) {
+      break;
+    }
+
+    // scale the data and compute the norms of the next iteration
+    timeIndex = 0;
+    auto scaleAndComputeNorms = [&](int workerId) {
+      int k;
+      while ((k = timeIndex++) <= N) {
+        scaleNode(k, gamma, dynamics, cost, DOut, EOut, scalingVectors);
+        computeNorms(k, x0, dynamics, cost, scalingVectors, reductions_[workerId].value);
+      }
+    };
+    resetReductions();
+    threadPool.runParallel(std::move(scaleAndComputeNorms), numWorkers);
+
+    scalar_t infNormOfh = 0.0;
+    scalar_t sumOfInfNormOfH = 0.0;
+    for (const auto& reduction : reductions_) {
+      infNormOfh = std::max(infNormOfh, reduction.value.infNormOfh);
+      sumOfInfNormOfH += reduction.value.sumOfInfNormOfH;
+    }
+    const auto averageOfInfNormOfH = sumOfInfNormOfH / static_cast<scalar_t>(numDecisionVariables);
+    gamma = 1.0 / limitScaling(std::max(averageOfInfNormOfH, infNormOfh));
+
+    // compute cOut
+    cOut *= gamma;
+    numIterations_++;
+  }
+
+  // scale cost with the gamma of the last iteration
+  if (gamma != 1.0) {
+    timeIndex = 0;
+    auto scaleCost = [&](int workerId) {
+      int k;
+      while ((k = timeIndex++) <= N) {
+        cost[k].dfdxx *= gamma;
+        cost[k].dfduu *= gamma;
+        cost[k].dfdux *= gamma;
+        cost[k].dfdx *= gamma;
+        cost[k].dfdu *= gamma;
+      }
+    };
+    threadPool.runParallel(std::move(scaleCost), numWorkers);
+  }
+}
+
+void RuziPreconditioner::resizeWorkspace(const OcpSize& ocpSize, size_t numWorkers) {
+  const int N = ocpSize.numStages;
+  D_.resize(2 * N);
+  E_.resize(N);
+  costColNorms_.resize(2 * N);
+  dynamicsColNorms_.resize(2 * N);
+  dynamicsRowNorms_.resize(N);
+  for (int i = 0; i < N; i++) {
+    const int nu_i = ocpSize.numInputs[i];
+    const int nx_next = ocpSize.numStates[i + 1];
+    D_[2 * i].resize(nu_i);
+    D_[2 * i + 1].resize(nx_next);
+    E_[i].resize(nx_next);
+    costColNorms_[2 * i].setZero(nu_i);
+    costColNorms_[2 * i + 1].setZero(nx_next);
+    dynamicsColNorms_[2 * i].setZero(nu_i);
+    dynamicsColNorms_[2 * i + 1].setZero(nx_next);
+    dynamicsRowNorms_[i].setZero(nx_next);
+  }
+  reductions_.resize(numWorkers);
+}
+
+scalar_t RuziPreconditioner::computeScalingFactors(int k, scalar_t gamma, const vector_array_t& scalingVectors) {
+  // scaling = 1 / sqrt(norms) and returns max(|scaling - 1|)
+  auto invSqrt = [](const auto& norms, vector_t& scaling) -> scalar_t {
+    scaling.array() = norms.unaryExpr(std::ref(limitScaling)).sqrt().inverse();
+    return (scaling.size() > 0) ? (scaling.array() - 1.0).abs().maxCoeff() : 0.0;
+  };
+
+  const int N = static_cast<int>(E_.size());
+  scalar_t maxDeviation = 0.0;
+
+  // u_{k}
+  if (k < N) {
+    const auto norms = (gamma * costColNorms_[2 * k].array()).max(dynamicsColNorms_[2 * k].array());
+    maxDeviation = std::max(maxDeviation, invSqrt(norms, D_[2 * k]));
+  }
+  // x_{k}, including the identity part of the dynamics of k - 1
+  if (k > 0) {
+    const auto norms =
+        (gamma * costColNorms_[2 * k - 1].array()).max(dynamicsColNorms_[2 * k - 1].array()).max(scalingVectors[k - 1].array().abs());
+    maxDeviation = std::max(maxDeviation, invSqrt(norms, D_[2 * k - 1]));
+  }
+  // rows of the dynamics of k
+  if (k < N) {
+    maxDeviation = std::max(maxDeviation, invSqrt(dynamicsRowNorms_[k].array(), E_[k]));
+  }
+  return maxDeviation;
+}
+
+void RuziPreconditioner::scaleNode(int k, scalar_t gamma, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                                   vector_array_t& scalingVectors) const {
+  const int N = static_cast<int>(E_.size());
+  const vector_t* DxPtr = (k > 0) ? &D_[2 * k - 1] : nullptr;
+  const vector_t* DuPtr = (k < N && D_[2 * k].size() > 0) ? &D_[2 * k] : nullptr;
+
+  // cost. The initial state is not a decision variable, its terms are only scaled by gamma.
+  auto& cost_k = cost[k];
+  scaleBlockInPlace(DxPtr, nullptr, gamma, cost_k.dfdx);
+  scaleBlockInPlace(DxPtr, DxPtr, gamma, cost_k.dfdxx);
+  if (DuPtr != nullptr) {
+    scaleBlockInPlace(DuPtr, nullptr, gamma, cost_k.dfdu);
+    scaleBlockInPlace(DuPtr, DuPtr, gamma, cost_k.dfduu);
+    scaleBlockInPlace(DuPtr, DxPtr, gamma, cost_k.dfdux);
+  } else if (gamma != 1.0) {
+    cost_k.dfdu *= gamma;
+    cost_k.dfduu *= gamma;
+    cost_k.dfdux *= gamma;
+  }
+
+  // constraints
+  if (k < N) {
+    auto& dynamics_k = dynamics[k];
+    scaleBlockInPlace(&E_[k], nullptr, 1.0, dynamics_k.f);
+    scaleBlockInPlace(&E_[k], DxPtr, 1.0, dynamics_k.dfdx);
+    if (DuPtr != nullptr) {
+      scaleBlockInPlace(&E_[k], DuPtr, 1.0, dynamics_k.dfdu);
+    }
+    scalingVectors[k].array() *= E_[k].array() * D_[2 * k + 1].array();
+    EOut[k].array() *= E_[k].array();
+    DOut[2 * k].array() *= D_[2 * k].array();
+  }
+  if (k > 0) {
+    DOut[2 * k - 1].array() *= D_[2 * k - 1].array();
+  }
+}
+
+void RuziPreconditioner::computeNorms(int k, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                      const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors,
+                                      WorkerReduction& reduction) {
+  const int N = static_cast<int>(E_.size());
+  const auto& cost_k = cost[k];
+
+  // cost
+  scalar_t sumOfInfNormOfH = 0.0;
+  if (k < N) {
+    auto& inputNorms = costColNorms_[2 * k];
+    inputNorms.setZero();
+    if (k > 0) {
+      maxInfNormCols(cost_k.dfdux.transpose(), inputNorms);
+    }
+    maxInfNormCols(cost_k.dfduu, inputNorms);
+    sumOfInfNormOfH += inputNorms.sum();
+  }
+  if (k > 0) {
+    auto& stateNorms = costColNorms_[2 * k - 1];
+    stateNorms.setZero();
+    maxInfNormCols(cost_k.dfdxx, stateNorms);
+    maxInfNormCols(cost_k.dfdux, stateNorms);
+    sumOfInfNormOfH += stateNorms.sum();
+  }
+  reduction.sumOfInfNormOfH += sumOfInfNormOfH;
+
+  scalar_t infNormOfh = 0.0;
+  if (k == 0) {
+    if (cost_k.dfdu.size() > 0) {
+      infNormOfh = (cost_k.dfdu + cost_k.dfdux * x0).lpNorm<Eigen::Infinity>();
+    }
+  } else {
+    if (cost_k.dfdx.size() > 0) {
+      infNormOfh = std::max(infNormOfh, cost_k.dfdx.lpNorm<Eigen::Infinity>());
+    }
+    if (cost_k.dfdu.size() > 0) {
+      infNormOfh = std::max(infNormOfh, cost_k.dfdu.lpNorm<Eigen::Infinity>());
+    }
+  }
+  reduction.infNormOfh = std::max(reduction.infNormOfh, infNormOfh);
+
+  // constraints
+  if (k < N) {
+    const auto& dynamics_k = dynamics[k];
+    auto& rowNorms = dynamicsRowNorms_[k];
+    rowNorms = scalingVectors[k].cwiseAbs();
+    maxInfNormRows(dynamics_k.dfdu, rowNorms);
+    dynamicsColNorms_[2 * k].setZero();
+    maxInfNormCols(dynamics_k.dfdu, dynamicsColNorms_[2 * k]);
+    if (k > 0) {
+      maxInfNormRows(dynamics_k.dfdx, rowNorms);
+      dynamicsColNorms_[2 * k - 1].setZero();
+      maxInfNormCols(dynamics_k.dfdx, dynamicsColNorms_[2 * k - 1]);
+    }
+  }
+}
+
 void kktMatrixInPlace(int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h, Eigen::SparseMatrix<scalar_t>& G, vector_t& g,
                       vector_t& DOut, vector_t& EOut, scalar_t& cOut) {
   const int nz = H.rows();
@@ -352,6 +644,35 @@ void kktMatrixInPlace(int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t&
   }
 }
 
+void kktMatrixInPlace(const OcpSize& ocpSize, int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h,
+                      Eigen::SparseMatrix<scalar_t>& G, vector_t& g, vector_array_t& DOut, vector_array_t& EOut, scalar_t& cOut) {
+  const int N = ocpSize.numStages;
+  if (N < 1) {
+    throw std::runtime_error("[precondition::kktMatrixInPlace] The number of stages cannot be less than 1.");
+  }
+  const auto numDynamicsConstraints = std::accumulate(std::next(ocpSize.numStates.begin()), ocpSize.numStates.end(), 0);
+  if (G.rows() != numDynamicsConstraints) {
+    throw std::runtime_error("[precondition::kktMatrixInPlace] G must only contain the dynamics constraints.");
+  }
+
+  vector_t D, E;
+  kktMatrixInPlace(iteration, H, h, G, g, D, E, cOut);
+
+  DOut.resize(2 * N);
+  EOut.resize(N);
+  int currRow = 0;
+  int currCol = 0;
+  for (int k = 0; k < N; k++) {
+    const int nu_k = ocpSize.numInputs[k];
+    const int nx_next = ocpSize.numStates[k + 1];
+    DOut[2 * k] = D.segment(currCol, nu_k);
+    DOut[2 * k + 1] = D.segment(currCol + nu_k, nx_next);
+    EOut[k] = E.segment(currRow, nx_next);
+    currCol += nu_k + nx_next;
+    currRow += nx_next;
+  }
+}
+
 void scaleOcpData(const OcpSize& ocpSize, const vector_t& D, const vector_t& E, const scalar_t c,
                   std::vector<VectorFunctionLinearApproximation>& dynamics, std::vector<ScalarFunctionQuadraticApproximation>& cost,
                   std::vector<vector_t>& scalingVectors) {
@@ -0,0 +1,298 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/rollout/BatchRollout.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/**
+ * The flow map of a chunk of the batch. The state of this ODE is the column-major stacking of the states of the chunk.
+ */
+class BatchRollout::BatchFlowMap final : public OdeBase {
+ public:
+  explicit BatchFlowMap(ControlledSystemBase& systemDynamics) : systemDynamics_(systemDynamics) {}
+
+  void setBatch(ControllerBase* controllerPtr, int stateDim, int batchSize) {
+    controllerPtr_ = controllerPtr;
+    stateDim_ = stateDim;
+    batchSize_ = batchSize;
+  }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override {
+    states_ = Eigen::Map<const matrix_t>(x.data(), stateDim_, batchSize_);
+    controllerPtr_->computeInputBatch(t, states_, inputs_);
+    systemDynamics_.computeFlowMapBatch(t, states_, inputs_, stateDerivatives_);
+    return Eigen::Map<const vector_t>(stateDerivatives_.data(), stateDerivatives_.size());
+  }
+
+ private:
+  ControlledSystemBase& systemDynamics_;
+  ControllerBase* controllerPtr_ = nullptr;
+  int stateDim_ = 0;
+  int batchSize_ = 0;
+
+  matrix_t states_;
+  matrix_t inputs_;
+  matrix_t stateDerivatives_;
+};
+
+/**
+ * The resources of one thread. The worker integrates the rollouts [firstIndex, firstIndex + batchSize) of the batch.
+ */
+struct BatchRollout::Worker {
+  Worker(const ControlledSystemBase& systemDynamics, IntegratorType integratorType)
+      : systemDynamicsPtr(systemDynamics.clone()),
+        flowMap(*systemDynamicsPtr),
+        eventHandlerPtr(new SystemEventHandler),
+        integratorPtr(newIntegrator(integratorType, eventHandlerPtr)) {}
+
+  std::unique_ptr<ControlledSystemBase> systemDynamicsPtr;
+  BatchFlowMap flowMap;
+  std::shared_ptr<SystemEventHandler> eventHandlerPtr;
+  std::unique_ptr<IntegratorBase> integratorPtr;
+  std::unique_ptr<ControllerBase> controllerPtr;
+
+  size_t firstIndex = 0;
+  size_t batchSize = 0;
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stackedStateTrajectory;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_array_t BatchRolloutTrajectories::getStateTrajectory(size_t i) const {
+  vector_array_t stateTrajectory(timeTrajectory.size());
+  for (size_t k = 0; k < timeTrajectory.size(); k++) {
+    stateTrajectory[k] = stateTrajectories.col(k * batchSize + i);
+  }
+  return stateTrajectory;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_array_t BatchRolloutTrajectories::getInputTrajectory(size_t i) const {
+  vector_array_t inputTrajectory(inputTrajectories.cols() > 0 ? timeTrajectory.size() : 0);
+  for (size_t k = 0; k < inputTrajectory.size(); k++) {
+    inputTrajectory[k] = inputTrajectories.col(k * batchSize + i);
+  }
+  return inputTrajectory;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout::BatchRollout(const ControlledSystemBase& systemDynamics, rollout::Settings rolloutSettings, size_t numThreads,
+                           int threadPriority)
+    : RolloutBase(std::move(rolloutSettings)),
+      numThreads_(std::max<size_t>(numThreads, 1)),
+      threadPriority_(threadPriority),
+      threadPool_(numThreads_ - 1, threadPriority) {
+  const auto integratorType = this->settings().integratorType;
+  if (integratorType != IntegratorType::EULER_OCS2 && integratorType != IntegratorType::MIDPOINT_OCS2 &&
+      integratorType != IntegratorType::RK4_OCS2) {
+    throw std::runtime_error("[BatchRollout] Only the fixed time-step integrators EULER_OCS2, MIDPOINT_OCS2, and RK4_OCS2 are supported!");
+  }
+
+  workers_.reserve(numThreads_);
+  for (size_t i = 0; i < numThreads_; i++) {
+    workers_.emplace_back(new Worker(systemDynamics, integratorType));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout::~BatchRollout() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout* BatchRollout::clone() const {
+  return new BatchRollout(*workers_.front()->systemDynamicsPtr, this->settings(), numThreads_, threadPriority_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::runBatch(scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime, const ControllerBase& controller,
+                            const ModeSchedule& modeSchedule, BatchRolloutTrajectories& trajectories) {
+  if (initTime > finalTime) {
+    throw std::runtime_error("[BatchRollout::runBatch] The initial time should be less-equal to the final time!");
+  }
+  if (initStates.empty()) {
+    throw std::runtime_error("[BatchRollout::runBatch] The batch is empty!");
+  }
+
+  // extract sub-systems
+  const auto timeIntervalArray = findActiveModesTimeInterval(initTime, finalTime, modeSchedule.eventTimes);
+
+  // split the batch into one chunk per worker
+  const size_t batchSize = initStates.size();
+  const size_t chunkSize = (batchSize + numThreads_ - 1) / numThreads_;
+  for (size_t i = 0; i < numThreads_; i++) {
+    auto& worker = *workers_[i];
+    worker.firstIndex = std::min(i * chunkSize, batchSize);
+    worker.batchSize = std::min(chunkSize, batchSize - worker.firstIndex);
+    if (worker.batchSize > 0) {
+      worker.controllerPtr.reset(controller.clone());
+    }
+  }
+
+  // integrate the chunks in parallel
+  nextWorkerId_ = 0;
+  auto integrateTask = [&](int) {
+    auto& worker = *workers_[nextWorkerId_++];
+    runWorker(worker, initTime, initStates, finalTime, timeIntervalArray);
+  };
+  threadPool_.runParallel(integrateTask, numThreads_);
+
+  // all chunks share the time grid of the first one
+  const auto& firstWorker = *workers_.front();
+  for (const auto& workerPtr : workers_) {
+    if (workerPtr->batchSize > 0 && workerPtr->timeTrajectory.size() != firstWorker.timeTrajectory.size()) {
+      throw std::runtime_error("[BatchRollout::runBatch] The rollouts of the batch have different time grids!");
+    }
+  }
+
+  const size_t stateDim = initStates.front().size();
+  const size_t numTimes = firstWorker.timeTrajectory.size();
+  trajectories.batchSize = batchSize;
+  trajectories.timeTrajectory = firstWorker.timeTrajectory;
+  trajectories.postEventIndices = firstWorker.postEventIndices;
+  trajectories.stateTrajectories.resize(stateDim, numTimes * batchSize);
+  if (this->settings().reconstructInputTrajectory) {
+    const vector_t input = firstWorker.controllerPtr->computeInput(trajectories.timeTrajectory.front(), initStates.front());
+    trajectories.inputTrajectories.resize(input.size(), numTimes * batchSize);
+  } else {
+    trajectories.inputTrajectories.resize(0, 0);
+  }
+
+  // fill the trajectories in parallel
+  nextWorkerId_ = 0;
+  auto fillTask = [&](int) {
+    auto& worker = *workers_[nextWorkerId_++];
+    const int chunkSize = worker.batchSize;
+    matrix_t states;
+    matrix_t inputs;
+    for (size_t k = 0; k < numTimes && chunkSize > 0; k++) {
+      states = Eigen::Map<const matrix_t>(worker.stackedStateTrajectory[k].data(), stateDim, chunkSize);
+      trajectories.stateTrajectories.middleCols(k * batchSize + worker.firstIndex, chunkSize) = states;
+      if (this->settings().reconstructInputTrajectory) {
+        worker.controllerPtr->computeInputBatch(trajectories.timeTrajectory[k], states, inputs);
+        trajectories.inputTrajectories.middleCols(k * batchSize + worker.firstIndex, chunkSize) = inputs;
+      }
+    }
+  };
+  threadPool_.runParallel(fillTask, numThreads_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::runWorker(Worker& worker, scalar_t initTime, const vector_array_t& initStates, scalar_t finalTime,
+                             const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray) {
+  worker.timeTrajectory.clear();
+  worker.postEventIndices.clear();
+  worker.stackedStateTrajectory.clear();
+  if (worker.batchSize == 0) {
+    return;
+  }
+
+  const int stateDim = initStates[worker.firstIndex].size();
+  const int chunkSize = worker.batchSize;
+  const int numSubsystems = timeIntervalArray.size();
+  const int numEvents = numSubsystems - 1;
+
+  // max number of steps for integration
+  const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(1.0, finalTime - initTime));
+
+  // stack the initial states of the chunk
+  vector_t beginState(stateDim * chunkSize);
+  for (int i = 0; i < chunkSize; i++) {
+    beginState.segment(i * stateDim, stateDim) = initStates[worker.firstIndex + i];
+  }
+
+  worker.flowMap.setBatch(worker.controllerPtr.get(), stateDim, chunkSize);
+  worker.flowMap.resetNumFunctionCalls();
+  worker.eventHandlerPtr->reset();
+
+  for (int i = 0; i < numSubsystems; i++) {
+    if (timeIntervalArray[i].first < timeIntervalArray[i].second) {
+      Observer observer(&worker.stackedStateTrajectory, &worker.timeTrajectory);  // concatenate trajectory
+      worker.integratorPtr->integrateAdaptive(worker.flowMap, observer, beginState, timeIntervalArray[i].first, timeIntervalArray[i].second,
+                                              this->settings().timeStep, this->settings().absTolODE, this->settings().relTolODE,
+                                              maxNumSteps);
+    } else {
+      worker.timeTrajectory.push_back(timeIntervalArray[i].second);
+      worker.stackedStateTrajectory.push_back(beginState);
+    }
+
+    // a jump has taken place
+    if (i < numEvents) {
+      worker.postEventIndices.push_back(worker.stackedStateTrajectory.size());
+      const scalar_t eventTime = worker.timeTrajectory.back();
+      const vector_t& preEventState = worker.stackedStateTrajectory.back();
+      for (int j = 0; j < chunkSize; j++) {
+        beginState.segment(j * stateDim, stateDim) =
+            worker.systemDynamicsPtr->computeJumpMap(eventTime, preEventState.segment(j * stateDim, stateDim));
+      }
+    }
+  }  // end of i loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t BatchRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller,
+                           ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
+                           vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  if (controller == nullptr) {
+    throw std::runtime_error("[BatchRollout::run] Controller is not set!");
+  }
+
+  BatchRolloutTrajectories trajectories;
+  runBatch(initTime, {initState}, finalTime, *controller, modeSchedule, trajectories);
+
+  stateTrajectory = trajectories.getStateTrajectory(0);
+  inputTrajectory = trajectories.getInputTrajectory(0);
+  timeTrajectory.swap(trajectories.timeTrajectory);
+  postEventIndices.swap(trajectories.postEventIndices);
+
+  // check for the numerical stability
+  this->checkNumericalStability(*controller, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+
+  return stateTrajectory.back();
+}
+
+}  // namespace ocs2
@@ -38,8 +38,8 @@ namespace ocs2 {
 namespace rollout {
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   Settings settings;
 
@@ -30,7 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/rollout/StateTriggeredRollout.h"
 
 #include <ocs2_core/control/StateBasedLinearController.h>
-#include <ocs2_oc/rollout/RootFinder.h>
+#include <ocs2_core/misc/Numerics.h>
 
 namespace ocs2 {
 
@@ -43,6 +43,7 @@ StateTriggeredRollout::StateTriggeredRollout(const ControlledSystemBase& systemD
       systemEventHandlersPtr_(new StateTriggeredEventHandler(this->settings().timeStep)) {
   // construct dynamicsIntegratorsPtr
   dynamicsIntegratorPtr_ = std::move(newIntegrator(this->settings().integratorType, systemEventHandlersPtr_));
+  denseOutputIntegratorPtr_ = dynamic_cast<const RungeKuttaFixedStep*>(dynamicsIntegratorPtr_.get());
 }
 
 /******************************************************************************************************/
@@ -110,6 +111,18 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
       eventID = e;
       triggered = true;
     }
+
+    // locate the event within the last step without integrating again, if the crossing was detected at the end of a step
+    bool locatedOnDenseOutput = false;
+    if (triggered && denseOutputIntegratorPtr_ != nullptr && timeTrajectory.size() > 1 && timeTrajectory.back() > t0) {
+      const auto lastStep = denseOutputIntegratorPtr_->getLastStepInterval();
+      const auto lastIndex = timeTrajectory.size() - 1;
+      if (numerics::almost_eq(lastStep.first, timeTrajectory[lastIndex - 1]) &&
+          numerics::almost_eq(lastStep.second, timeTrajectory[lastIndex])) {
+        locateEventOnDenseOutput(eventID, rootFinder, timeTrajectory, stateTrajectory);
+        locatedOnDenseOutput = true;
+      }
+    }
     // calculate guard surface value of last query state and time
     const scalar_t queryTime = timeTrajectory.back();
     const vector_t queryState = stateTrajectory.back();
@@ -119,7 +132,7 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
     // accuracy conditions on the obtained query guard and width of time window
     const bool guardAccuracyCondition = std::fabs(queryGuard) < this->settings().absTolODE;
     const bool timeAccuracyCondition = std::fabs(t1 - t0) < this->settings().absTolODE;
-    const bool accuracyCondition = guardAccuracyCondition || timeAccuracyCondition;
+    const bool accuracyCondition = locatedOnDenseOutput || guardAccuracyCondition || timeAccuracyCondition;
     // condition to check whether max number of iterations has not been reached, to prevent an infinite loop
     const bool maxNumIterationsReached = singleEventIterations >= this->settings().maxSingleEventIterations;
 
@@ -198,4 +211,31 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateTriggeredRollout::locateEventOnDenseOutput(size_t eventID, RootFinder& rootFinder, scalar_array_t& timeTrajectory,
+                                                     vector_array_t& stateTrajectory) const {
+  const auto lastIndex = timeTrajectory.size() - 1;
+  const scalar_t timeBefore = timeTrajectory[lastIndex - 1];
+  const scalar_t guardBefore = systemDynamicsPtr_->computeGuardSurfaces(timeBefore, stateTrajectory[lastIndex - 1])[eventID];
+  scalar_t queryTime = timeTrajectory[lastIndex];
+  scalar_t queryGuard = systemDynamicsPtr_->computeGuardSurfaces(queryTime, stateTrajectory[lastIndex])[eventID];
+  rootFinder.setInitBracket(timeBefore, queryTime, guardBefore, queryGuard);
+
+  vector_t queryState;
+  for (int i = 0; i < this->settings().maxSingleEventIterations; i++) {
+    queryTime = rootFinder.getNewQuery();
+    denseOutputIntegratorPtr_->getDenseOutput(queryTime, queryState);
+    queryGuard = systemDynamicsPtr_->computeGuardSurfaces(queryTime, queryState)[eventID];
+    if (std::fabs(queryGuard) < this->settings().absTolODE) {
+      break;
+    }
+    rootFinder.updateBracket(queryTime, queryGuard);
+  }
+
+  timeTrajectory[lastIndex] = queryTime;
+  stateTrajectory[lastIndex] = std::move(queryState);
+}
+
 }  // namespace ocs2
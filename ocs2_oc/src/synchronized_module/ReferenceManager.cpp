@@ -43,7 +43,10 @@ ReferenceManager::ReferenceManager(TargetTrajectories initialTargetTrajectories,
 void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
   targetTrajectories_.updateFromBuffer();
   modeSchedule_.updateFromBuffer();
-  modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+  // Skipping the no-op modifyReferences() avoids the copy-on-write of shared snapshots
+  if (modifiesReferences()) {
+    modifyReferences(initTime, finalTime, initState, targetTrajectories_.getMutable(), modeSchedule_.getMutable());
+  }
 }
 
 }  // namespace ocs2
@@ -0,0 +1,242 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/constraint/StateInputConstraintCppAd.h>
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+
+#include <ocs2_oc/multiple_shooting/FusedTranscriptionCppAd.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+
+#include "ocs2_oc/test/circular_kinematics.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+
+class NonlinearSystemAd final : public SystemDynamicsBaseAD {
+ public:
+  NonlinearSystemAd() { initialize(2, 2, "fused_transcription_dynamics", "/tmp/ocs2_test_fused", true, false); }
+  NonlinearSystemAd* clone() const override { return new NonlinearSystemAd(*this); }
+
+  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                            const ad_vector_t& parameters) const override {
+    ad_vector_t dxdt(2);
+    dxdt << input(0) + sin(state(1)), input(1) * state(0) - 0.1 * time;
+    return dxdt;
+  }
+};
+
+/** Same flow map with the time offset as a parameter, parameterized flow maps are left to the remainder problem. */
+class ParameterizedNonlinearSystemAd final : public SystemDynamicsBaseAD {
+ public:
+  ParameterizedNonlinearSystemAd() { initialize(2, 2, "fused_transcription_parameterized_dynamics", "/tmp/ocs2_test_fused", true, false); }
+  ParameterizedNonlinearSystemAd* clone() const override { return new ParameterizedNonlinearSystemAd(*this); }
+
+  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                            const ad_vector_t& parameters) const override {
+    ad_vector_t dxdt(2);
+    dxdt << input(0) + sin(state(1)), input(1) * state(0) - parameters(0) * time;
+    return dxdt;
+  }
+  vector_t getFlowMapParameters(scalar_t time, const PreComputation& /* preComputation */) const override {
+    return vector_t::Constant(1, 0.1);
+  }
+  size_t getNumFlowMapParameters() const override { return 1; }
+};
+
+class CircularKinematicsConstraintsAd final : public StateInputConstraintCppAd {
+ public:
+  CircularKinematicsConstraintsAd() : StateInputConstraintCppAd(ConstraintOrder::Linear) {
+    initialize(2, 2, 0, "fused_transcription_constraint", "/tmp/ocs2_test_fused", true, false);
+  }
+  CircularKinematicsConstraintsAd* clone() const override { return new CircularKinematicsConstraintsAd(*this); }
+  size_t getNumConstraints(scalar_t time) const override { return 2; }
+
+  ad_vector_t constraintFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                                 const ad_vector_t& parameters) const override {
+    ad_vector_t e(2);
+    e << state.dot(input), state.squaredNorm() - 1.0;
+    return e;
+  }
+};
+
+/** A cost term that is never active and not finite, it should not affect the transcription. */
+class InactiveNonFiniteCostAd final : public StateInputCostCppAd {
+ public:
+  InactiveNonFiniteCostAd() { initialize(2, 2, 0, "fused_transcription_inactive_cost", "/tmp/ocs2_test_fused", true, false); }
+  InactiveNonFiniteCostAd* clone() const override { return new InactiveNonFiniteCostAd(*this); }
+  bool isActive(scalar_t time) const override { return false; }
+
+ protected:
+  ad_scalar_t costFunction(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                           const ad_vector_t& parameters) const override {
+    return sqrt(-1.0 - state.squaredNorm()) + input.sum();
+  }
+};
+
+void compareTranscriptions(const multiple_shooting::Transcription& lhs, const multiple_shooting::Transcription& rhs) {
+  constexpr scalar_t tol = 1e-9;
+  ASSERT_NEAR(lhs.cost.f, rhs.cost.f, tol);
+  ASSERT_TRUE(lhs.cost.dfdx.isApprox(rhs.cost.dfdx, tol));
+  ASSERT_TRUE(lhs.cost.dfdu.isApprox(rhs.cost.dfdu, tol));
+  ASSERT_TRUE(lhs.cost.dfdxx.isApprox(rhs.cost.dfdxx, tol));
+  ASSERT_TRUE(lhs.cost.dfdux.isApprox(rhs.cost.dfdux, tol));
+  ASSERT_TRUE(lhs.cost.dfduu.isApprox(rhs.cost.dfduu, tol));
+  ASSERT_TRUE(lhs.dynamics.f.isApprox(rhs.dynamics.f, tol));
+  ASSERT_TRUE(lhs.dynamics.dfdx.isApprox(rhs.dynamics.dfdx, tol));
+  ASSERT_TRUE(lhs.dynamics.dfdu.isApprox(rhs.dynamics.dfdu, tol));
+
+  const std::vector<std::pair<const VectorFunctionLinearApproximation*, const VectorFunctionLinearApproximation*>> constraints{
+      {&lhs.stateEqConstraints, &rhs.stateEqConstraints},
+      {&lhs.stateInputEqConstraints, &rhs.stateInputEqConstraints},
+      {&lhs.stateIneqConstraints, &rhs.stateIneqConstraints},
+      {&lhs.stateInputIneqConstraints, &rhs.stateInputIneqConstraints}};
+  for (const auto& pair : constraints) {
+    ASSERT_EQ(pair.first->f.size(), pair.second->f.size());
+    ASSERT_TRUE(pair.first->f.isApprox(pair.second->f, tol));
+    ASSERT_TRUE(pair.first->dfdx.isApprox(pair.second->dfdx, tol));
+    ASSERT_TRUE(pair.first->dfdu.isApprox(pair.second->dfdu, tol));
+  }
+
+  ASSERT_EQ(lhs.constraintsSize.stateEq, rhs.constraintsSize.stateEq);
+  ASSERT_EQ(lhs.constraintsSize.stateInputEq, rhs.constraintsSize.stateInputEq);
+  ASSERT_EQ(lhs.constraintsSize.stateIneq, rhs.constraintsSize.stateIneq);
+  ASSERT_EQ(lhs.constraintsSize.stateInputIneq, rhs.constraintsSize.stateInputIneq);
+}
+
+/** Mix of CppAD and regular terms, with the CppAD constraints in between the regular ones to check the constraint order. */
+OptimalControlProblem createProblem() {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new NonlinearSystemAd());
+
+  problem.costPtr->add("circularCost", std::make_unique<CircularKinematicsCost>("/tmp/ocs2_test_fused"));
+  problem.costPtr->add("quadraticCost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.softConstraintPtr->add("softCost", std::make_unique<CircularKinematicsCost>("/tmp/ocs2_test_fused"));
+  problem.softConstraintPtr->add("inactiveCost", std::make_unique<InactiveNonFiniteCostAd>());
+
+  problem.equalityConstraintPtr->add("equalityConstraint0", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+  problem.equalityConstraintPtr->add("circularConstraint", std::make_unique<CircularKinematicsConstraintsAd>());
+  problem.equalityConstraintPtr->add("equalityConstraint1", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+  problem.stateEqualityConstraintPtr->add("stateEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+
+  problem.inequalityConstraintPtr->add("circularConstraint", std::make_unique<CircularKinematicsConstraintsAd>());
+  problem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+  problem.stateInequalityConstraintPtr->add("stateInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 4)));
+
+  return problem;
+}
+
+}  // namespace
+
+TEST(test_fused_transcription, equalToTranscription) {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)});
+
+  OptimalControlProblem problem = createProblem();
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  for (const auto integratorType : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(integratorType);
+    multiple_shooting::FusedTranscriptionCppAd fusedTranscription(nx, nu, problem, integratorType, "fused_transcription",
+                                                                  "/tmp/ocs2_test_fused", true, false);
+    ASSERT_TRUE(fusedTranscription.isDynamicsFused());
+    ASSERT_EQ(fusedTranscription.getNumFusedTerms(), 5);
+    fusedTranscription.getRemainderProblem().targetTrajectoriesPtr = &targetTrajectories;
+
+    // A copy should give the same result
+    multiple_shooting::FusedTranscriptionCppAd fusedTranscriptionCopy(fusedTranscription);
+
+    const scalar_t t = 0.5;
+    const scalar_t dt = 0.1;
+    for (int i = 0; i < 5; ++i) {
+      const vector_t x = vector_t::Random(nx);
+      const vector_t x_next = vector_t::Random(nx);
+      const vector_t u = vector_t::Random(nu);
+      const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+      compareTranscriptions(fusedTranscription.setupIntermediateNode(t, dt, x, x_next, u), transcription);
+      compareTranscriptions(fusedTranscriptionCopy.setupIntermediateNode(t, dt, x, x_next, u), transcription);
+    }
+  }
+}
+
+TEST(test_fused_transcription, withoutCppAdTerms) {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)});
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new CircularKinematicsSystem());
+  problem.costPtr->add("quadraticCost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  multiple_shooting::FusedTranscriptionCppAd fusedTranscription(nx, nu, problem, SensitivityIntegratorType::RK4,
+                                                                "fused_transcription_empty", "/tmp/ocs2_test_fused", true, false);
+  ASSERT_FALSE(fusedTranscription.isDynamicsFused());
+  ASSERT_EQ(fusedTranscription.getNumFusedTerms(), 0);
+  fusedTranscription.getRemainderProblem().targetTrajectoriesPtr = &targetTrajectories;
+
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, 0.0, 0.1, x, x_next, u);
+  compareTranscriptions(fusedTranscription.setupIntermediateNode(0.0, 0.1, x, x_next, u), transcription);
+}
+
+TEST(test_fused_transcription, parameterizedDynamics) {
+  constexpr int nx = 2;
+  constexpr int nu = 2;
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)});
+
+  OptimalControlProblem problem = createProblem();
+  problem.dynamicsPtr.reset(new ParameterizedNonlinearSystemAd());
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  multiple_shooting::FusedTranscriptionCppAd fusedTranscription(nx, nu, problem, SensitivityIntegratorType::RK4,
+                                                                "fused_transcription_parameterized", "/tmp/ocs2_test_fused", true, false);
+  ASSERT_FALSE(fusedTranscription.isDynamicsFused());
+  ASSERT_EQ(fusedTranscription.getNumFusedTerms(), 5);
+  fusedTranscription.getRemainderProblem().targetTrajectoriesPtr = &targetTrajectories;
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+  compareTranscriptions(fusedTranscription.setupIntermediateNode(t, dt, x, x_next, u), transcription);
+}
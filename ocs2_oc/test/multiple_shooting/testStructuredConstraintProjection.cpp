@@ -0,0 +1,178 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+
+#include "ocs2_oc/multiple_shooting/StructuredConstraintProjection.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t numLegs = 4;
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 6 * numLegs;  // contact forces and joint velocities
+
+/**
+ * Constraints with the structure of a legged robot: zero contact forces and the vertical foot velocity for swing legs, zero foot velocity
+ * for stance legs. The foot velocities depend on the base velocity in the state and on the joint velocities of the leg.
+ */
+VectorFunctionLinearApproximation getLeggedConstraints(size_t mode) {
+  size_t numConstraints = 0;
+  for (size_t leg = 0; leg < numLegs; ++leg) {
+    const bool inContact = (mode >> leg) & 1;
+    numConstraints += inContact ? 3 : 4;
+  }
+
+  VectorFunctionLinearApproximation constraint = VectorFunctionLinearApproximation::Zero(numConstraints, stateDim, inputDim);
+  size_t row = 0;
+  for (size_t leg = 0; leg < numLegs; ++leg) {
+    const bool inContact = (mode >> leg) & 1;
+    const size_t forceIndex = 3 * leg;
+    const size_t jointIndex = 3 * numLegs + 3 * leg;
+    if (!inContact) {
+      constraint.dfdu.block<3, 3>(row, forceIndex).setIdentity();
+      row += 3;
+    }
+    const size_t numVelocityRows = inContact ? 3 : 1;
+    constraint.dfdx.middleRows(row, numVelocityRows).setRandom();
+    constraint.dfdu.block(row, jointIndex, numVelocityRows, 3) =
+        matrix_t::Identity(3, 3).bottomRows(numVelocityRows) + 0.3 * matrix_t::Random(numVelocityRows, 3);
+    constraint.f.segment(row, numVelocityRows).setRandom();
+    row += numVelocityRows;
+  }
+  return constraint;
+}
+
+void checkProjection(const VectorFunctionLinearApproximation& constraint, const VectorFunctionLinearApproximation& projection,
+                     const matrix_t& pseudoInverse) {
+  constexpr scalar_t tol = 1e-9;
+  const auto numConstraints = constraint.f.size();
+
+  // range of Pu is in null-space of D and spans it
+  ASSERT_EQ(projection.dfdu.cols(), inputDim - numConstraints);
+  ASSERT_TRUE((constraint.dfdu * projection.dfdu).isZero(tol));
+  ASSERT_EQ(LinearAlgebra::rank(projection.dfdu), inputDim - numConstraints);
+
+  // D * Px cancels the C term, D * Pe cancels the e term
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero(tol));
+  ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero(tol));
+
+  // pseudo-inverse
+  ASSERT_TRUE((pseudoInverse * constraint.dfdu.transpose()).isIdentity(tol));
+  ASSERT_TRUE((pseudoInverse.transpose() * constraint.dfdx).isApprox(-projection.dfdx, tol));
+  ASSERT_TRUE((pseudoInverse.transpose() * constraint.f).isApprox(-projection.f, tol));
+}
+
+}  // namespace
+
+TEST(test_structured_projection, leggedConstraints) {
+  multiple_shooting::StructuredConstraintProjection structuredProjection;
+  VectorFunctionLinearApproximation projection;
+  matrix_t pseudoInverse;
+
+  constexpr size_t numModes = 1 << numLegs;
+  for (size_t mode = 0; mode < numModes; ++mode) {
+    for (int i = 0; i < 3; ++i) {
+      const auto constraint = getLeggedConstraints(mode);
+      structuredProjection.compute(constraint, mode, projection, &pseudoInverse);
+      checkProjection(constraint, projection, pseudoInverse);
+    }
+  }
+  // The pattern is computed once per mode
+  ASSERT_EQ(structuredProjection.getNumPatternUpdates(), numModes);
+}
+
+TEST(test_structured_projection, denseConstraints) {
+  constexpr size_t numConstraints = 10;
+  multiple_shooting::StructuredConstraintProjection structuredProjection;
+  VectorFunctionLinearApproximation projection;
+  matrix_t pseudoInverse;
+
+  const auto constraint = getRandomConstraints(stateDim, inputDim, numConstraints);
+  structuredProjection.compute(constraint, 0, projection, &pseudoInverse);
+  checkProjection(constraint, projection, pseudoInverse);
+}
+
+TEST(test_structured_projection, patternChange) {
+  multiple_shooting::StructuredConstraintProjection structuredProjection;
+  VectorFunctionLinearApproximation projection;
+  matrix_t pseudoInverse;
+
+  // Same key with a different structure, e.g. when the mode numbering changes
+  for (size_t mode : {0, 15, 5}) {
+    const auto constraint = getLeggedConstraints(mode);
+    structuredProjection.compute(constraint, 0, projection, &pseudoInverse);
+    checkProjection(constraint, projection, pseudoInverse);
+  }
+  ASSERT_EQ(structuredProjection.getNumPatternUpdates(), 3);
+
+  // Basis that becomes singular. All legs in swing, the largest entry of a vertical foot velocity row is chosen as basic input.
+  auto constraint = getLeggedConstraints(0);
+  const auto lastRow = constraint.f.size() - 1;
+  const auto lastJoint = inputDim - 1;
+  constraint.dfdu.row(lastRow).tail<3>() << 0.1, 0.1, 1.0;
+  structuredProjection.compute(constraint, 1, projection, &pseudoInverse);
+  checkProjection(constraint, projection, pseudoInverse);
+  ASSERT_EQ(structuredProjection.getNumPatternUpdates(), 4);
+
+  constraint.dfdu(lastRow, lastJoint) = 0.0;
+  structuredProjection.compute(constraint, 1, projection, &pseudoInverse);
+  checkProjection(constraint, projection, pseudoInverse);
+  ASSERT_EQ(structuredProjection.getNumPatternUpdates(), 5);
+}
+
+TEST(test_structured_projection, denseFallback) {
+  multiple_shooting::StructuredConstraintProjection structuredProjection;
+  VectorFunctionLinearApproximation projection;
+  matrix_t pseudoInverse;
+
+  // A badly scaled velocity row of a stance leg, there is no well conditioned basis
+  auto constraint = getLeggedConstraints(15);
+  constexpr scalar_t scaling = 1e-8;
+  constraint.dfdx.row(0) *= scaling;
+  constraint.dfdu.row(0) *= scaling;
+  constraint.f(0) *= scaling;
+
+  for (int i = 0; i < 2; ++i) {
+    structuredProjection.compute(constraint, 0, projection, &pseudoInverse);
+    checkProjection(constraint, projection, pseudoInverse);
+  }
+  ASSERT_EQ(structuredProjection.getNumDenseFallbacks(), 2);
+
+  // The pattern is computed again once the basis is well conditioned
+  constraint = getLeggedConstraints(15);
+  structuredProjection.compute(constraint, 0, projection, &pseudoInverse);
+  checkProjection(constraint, projection, pseudoInverse);
+  ASSERT_EQ(structuredProjection.getNumDenseFallbacks(), 2);
+  ASSERT_EQ(structuredProjection.getNumPatternUpdates(), 3);
+}
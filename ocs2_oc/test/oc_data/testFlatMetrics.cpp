@@ -0,0 +1,196 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+#include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+#include <ocs2_oc/oc_data/FlatMetrics.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+class FlatMetricsTest : public testing::Test {
+ protected:
+  static constexpr int nx = 3;
+  static constexpr int nu = 2;
+
+  FlatMetricsTest()
+      : targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)}),
+        discretizer(selectDynamicsDiscretization(SensitivityIntegratorType::RK4)),
+        sensitivityDiscretizer(selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4)) {
+    // dynamics
+    const auto dynamics = getRandomDynamics(nx, nu);
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(dynamics.dfdx, dynamics.dfdu, matrix_t::Random(nx, nx)));
+
+    // costs
+    problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+    problem.preJumpCostPtr->add("eventCost", getOcs2StateCost(getRandomCost(nx, 0)));
+    problem.finalCostPtr->add("finalCost", getOcs2StateCost(getRandomCost(nx, 0)));
+
+    // intermediate constraints, with several terms per collection
+    problem.equalityConstraintPtr->add("equalityConstraint0", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+    problem.equalityConstraintPtr->add("equalityConstraint1", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+    problem.stateEqualityConstraintPtr->add("stateEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+    problem.inequalityConstraintPtr->add("inequalityConstraint0", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+    problem.inequalityConstraintPtr->add("inequalityConstraint1", getOcs2Constraints(getRandomConstraints(nx, nu, 2)));
+    problem.stateInequalityConstraintPtr->add("stateInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 4)));
+
+    // event and final constraints
+    problem.preJumpEqualityConstraintPtr->add("preJumpEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 2)));
+    problem.preJumpInequalityConstraintPtr->add("preJumpInequalityConstraint",
+                                                getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 3)));
+    problem.finalEqualityConstraintPtr->add("finalEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+    problem.finalInequalityConstraintPtr->add("finalInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 2)));
+
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    // time discretization with an event at t = 0.2
+    time = {AnnotatedTime(0.0), AnnotatedTime(0.1), AnnotatedTime(0.2, AnnotatedTime::Event::PreEvent),
+            AnnotatedTime(0.2, AnnotatedTime::Event::PostEvent), AnnotatedTime(0.3)};
+    N = static_cast<int>(time.size()) - 1;
+    for (int i = 0; i <= N; ++i) {
+      x.push_back(vector_t::Random(nx));
+      u.push_back(vector_t::Random(nu));
+    }
+
+    std::vector<MetricsSize> sizes(N + 1);
+    for (int i = 0; i < N; ++i) {
+      sizes[i] = isEvent(i) ? multiple_shooting::getEventMetricsSize(problem, time[i].time, nx)
+                            : multiple_shooting::getIntermediateMetricsSize(problem, getIntervalStart(time[i]), nx);
+    }
+    sizes[N] = multiple_shooting::getTerminalMetricsSize(problem, getIntervalStart(time[N]));
+    flatMetrics.setLayout(sizes);
+  }
+
+  bool isEvent(int i) const { return time[i].event == AnnotatedTime::Event::PreEvent; }
+
+  scalar_t getDt(int i) const { return getIntervalDuration(time[i], time[i + 1]); }
+
+  OptimalControlProblem problem;
+  TargetTrajectories targetTrajectories;
+  DynamicsDiscretizer discretizer;
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer;
+
+  std::vector<AnnotatedTime> time;
+  int N;
+  vector_array_t x;
+  vector_array_t u;
+  FlatMetrics flatMetrics;
+};
+
+constexpr int FlatMetricsTest::nx;
+constexpr int FlatMetricsTest::nu;
+
+TEST_F(FlatMetricsTest, computeMetrics) {
+  std::vector<Metrics> metrics(N + 1);
+  for (int i = 0; i < N; ++i) {
+    if (isEvent(i)) {
+      metrics[i] = multiple_shooting::computeEventMetrics(problem, time[i].time, x[i], x[i + 1]);
+      multiple_shooting::computeEventMetrics(problem, time[i].time, x[i], x[i + 1], flatMetrics, i);
+    } else {
+      const scalar_t ti = getIntervalStart(time[i]);
+      metrics[i] = multiple_shooting::computeIntermediateMetrics(problem, discretizer, ti, getDt(i), x[i], x[i + 1], u[i]);
+      multiple_shooting::computeIntermediateMetrics(problem, discretizer, ti, getDt(i), x[i], x[i + 1], u[i], flatMetrics, i);
+    }
+  }
+  metrics[N] = multiple_shooting::computeTerminalMetrics(problem, getIntervalStart(time[N]), x[N]);
+  multiple_shooting::computeTerminalMetrics(problem, getIntervalStart(time[N]), x[N], flatMetrics, N);
+
+  ASSERT_EQ(flatMetrics.size(), N + 1);
+  for (int i = 0; i <= N; ++i) {
+    EXPECT_TRUE(flatMetrics.getMetrics(i).isApprox(metrics[i], 1e-12)) << "node " << i;
+    const bool isIntermediate = i < N && !isEvent(i);
+    const auto performanceIndex = isIntermediate ? toPerformanceIndex(metrics[i], getDt(i)) : toPerformanceIndex(metrics[i]);
+    const auto flatPerformanceIndex = isIntermediate ? toPerformanceIndex(flatMetrics, i, getDt(i)) : toPerformanceIndex(flatMetrics, i);
+    EXPECT_TRUE(flatPerformanceIndex.isApprox(performanceIndex, 1e-12)) << "node " << i;
+  }
+
+  // term access
+  const auto& inequality = metrics[0].stateInputIneqConstraint;
+  ASSERT_EQ(inequality.size(), 2);
+  EXPECT_TRUE(flatMetrics.termValues(FlatMetrics::Field::StateInputIneqConstraint, 0, 0).isApprox(inequality[0]));
+  EXPECT_TRUE(flatMetrics.termValues(FlatMetrics::Field::StateInputIneqConstraint, 0, 1).isApprox(inequality[1]));
+
+  // ProblemMetrics
+  const auto problemMetrics = multiple_shooting::toProblemMetrics(time, std::move(metrics));
+  const auto flatProblemMetrics = multiple_shooting::toProblemMetrics(time, flatMetrics);
+  ASSERT_EQ(flatProblemMetrics.intermediates.size(), problemMetrics.intermediates.size());
+  ASSERT_EQ(flatProblemMetrics.preJumps.size(), problemMetrics.preJumps.size());
+  for (size_t k = 0; k < problemMetrics.intermediates.size(); ++k) {
+    EXPECT_TRUE(flatProblemMetrics.intermediates[k].isApprox(problemMetrics.intermediates[k], 1e-12));
+  }
+  for (size_t k = 0; k < problemMetrics.preJumps.size(); ++k) {
+    EXPECT_TRUE(flatProblemMetrics.preJumps[k].isApprox(problemMetrics.preJumps[k], 1e-12));
+  }
+  EXPECT_TRUE(flatProblemMetrics.final.isApprox(problemMetrics.final, 1e-12));
+}
+
+TEST_F(FlatMetricsTest, transcription) {
+  for (int i = 0; i < N; ++i) {
+    if (isEvent(i)) {
+      const auto transcription = multiple_shooting::setupEventNode(problem, time[i].time, x[i], x[i + 1]);
+      multiple_shooting::computeMetrics(transcription, flatMetrics, i);
+      EXPECT_TRUE(flatMetrics.getMetrics(i).isApprox(multiple_shooting::computeMetrics(transcription), 1e-12)) << "node " << i;
+    } else {
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getDt(i);
+      const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, ti, dt, x[i], x[i + 1], u[i]);
+      multiple_shooting::computeMetrics(transcription, flatMetrics, i);
+      EXPECT_TRUE(flatMetrics.getMetrics(i).isApprox(multiple_shooting::computeMetrics(transcription), 1e-12)) << "node " << i;
+    }
+  }
+  const auto transcription = multiple_shooting::setupTerminalNode(problem, getIntervalStart(time[N]), x[N]);
+  multiple_shooting::computeMetrics(transcription, flatMetrics, N);
+  EXPECT_TRUE(flatMetrics.getMetrics(N).isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+}
+
+TEST_F(FlatMetricsTest, layoutMismatch) {
+  // terminal and event nodes do not fit into the layout of an intermediate node
+  const scalar_t t = getIntervalStart(time[0]);
+  const auto transcription = multiple_shooting::setupTerminalNode(problem, t, x[0]);
+  EXPECT_THROW(multiple_shooting::computeMetrics(transcription, flatMetrics, 0), std::runtime_error);
+  EXPECT_THROW(multiple_shooting::computeEventMetrics(problem, t, x[0], x[1], flatMetrics, 0), std::runtime_error);
+}
+
+TEST_F(FlatMetricsTest, swapAndClear) {
+  FlatMetrics other;
+  other.swap(flatMetrics);
+  EXPECT_EQ(flatMetrics.size(), 0);
+  ASSERT_EQ(other.size(), N + 1);
+  EXPECT_EQ(other.values(FlatMetrics::Field::DynamicsViolation, 0).size(), nx);
+  EXPECT_EQ(other.values(FlatMetrics::Field::StateInputIneqConstraint, 0).size(), 5);
+  EXPECT_EQ(other.values(FlatMetrics::Field::StateInputIneqConstraint, 2).size(), 0);  // event node
+  EXPECT_EQ(other.values(FlatMetrics::Field::StateIneqConstraint, 2).size(), 3);
+
+  other.clear();
+  EXPECT_EQ(other.size(), 0);
+}
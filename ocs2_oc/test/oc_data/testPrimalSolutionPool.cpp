@@ -0,0 +1,72 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/oc_data/PrimalSolutionPool.h"
+
+using namespace ocs2;
+
+TEST(testPrimalSolutionPool, recycleReleasedSolutions) {
+  PrimalSolutionPool pool(2);
+
+  std::shared_ptr<const PrimalSolution> first = pool.acquire();
+  std::shared_ptr<const PrimalSolution> second = pool.acquire();
+  ASSERT_NE(first.get(), second.get());
+  ASSERT_EQ(pool.size(), 2);
+
+  // All solutions are in use, a new one is allocated and not kept by the pool
+  std::shared_ptr<const PrimalSolution> third = pool.acquire();
+  ASSERT_NE(third.get(), first.get());
+  ASSERT_NE(third.get(), second.get());
+  ASSERT_EQ(pool.size(), 2);
+
+  // Released solutions are returned with their content
+  const auto* secondAddress = second.get();
+  second.reset();
+  auto recycled = pool.acquire();
+  ASSERT_EQ(recycled.get(), secondAddress);
+}
+
+TEST(testPrimalSolutionPool, keepContent) {
+  PrimalSolutionPool pool(1);
+
+  auto solution = pool.acquire();
+  solution->timeTrajectory_ = {0.0, 1.0};
+  solution->stateTrajectory_ = {vector_t::Ones(3), vector_t::Zero(3)};
+  const auto* stateData = solution->stateTrajectory_.front().data();
+  solution.reset();
+
+  // The memory of the previous solution is reused
+  auto recycled = pool.acquire();
+  ASSERT_EQ(recycled->timeTrajectory_.size(), 2);
+  ASSERT_EQ(recycled->stateTrajectory_.front().data(), stateData);
+  recycled->stateTrajectory_.front() = vector_t::Zero(3);
+  ASSERT_EQ(recycled->stateTrajectory_.front().data(), stateData);
+}
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/thread_support/ThreadPool.h>
+
 #include "ocs2_oc/oc_problem/OcpSize.h"
 #include "ocs2_oc/oc_problem/OcpToKkt.h"
 
@@ -92,3 +94,95 @@ TEST_F(OcpToKktTest, sparseCostApproximation) {
   EXPECT_TRUE(costApproximation.dfdxx.isApprox(H.toDense()));
   EXPECT_TRUE(costApproximation.dfdx.isApprox(h));
 }
+
+TEST_F(OcpToKktTest, sparsityPatternConstraintsApproximation) {
+  ocs2::vector_array_t scalingVectors(N_);
+  for (auto& v : scalingVectors) {
+    v = ocs2::vector_t::Random(nx_);
+  }
+  ocs2::VectorFunctionLinearApproximation constraintsApproximation;
+  ocs2::getConstraintMatrix(ocpSize_, x0, dynamicsArray, &constraintsArray, &scalingVectors, constraintsApproximation);
+
+  const ocs2::KktSparsityPattern pattern(ocpSize_, true);
+  Eigen::SparseMatrix<ocs2::scalar_t> G;
+  ocs2::vector_t g;
+  pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, &scalingVectors, G, g);
+
+  EXPECT_EQ(pattern.getNumConstraints(), constraintsApproximation.dfdx.rows());
+  EXPECT_EQ(pattern.getNumDecisionVariables(), constraintsApproximation.dfdx.cols());
+  EXPECT_TRUE(constraintsApproximation.dfdx.isApprox(G.toDense()));
+  EXPECT_TRUE(constraintsApproximation.f.isApprox(g));
+
+  // Without constraints and scaling
+  ocs2::getConstraintMatrix(ocpSize_, x0, dynamicsArray, nullptr, nullptr, constraintsApproximation);
+  const ocs2::KktSparsityPattern dynamicsPattern(ocpSize_, false);
+  dynamicsPattern.getConstraintMatrix(x0, dynamicsArray, nullptr, nullptr, G, g);
+
+  EXPECT_TRUE(constraintsApproximation.dfdx.isApprox(G.toDense()));
+  EXPECT_TRUE(constraintsApproximation.f.isApprox(g));
+  EXPECT_ANY_THROW(dynamicsPattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, G, g));
+}
+
+TEST_F(OcpToKktTest, sparsityPatternCostApproximation) {
+  ocs2::ScalarFunctionQuadraticApproximation costApproximation;
+  ocs2::getCostMatrix(ocpSize_, x0, costArray, costApproximation);
+
+  const ocs2::KktSparsityPattern pattern(ocpSize_, true);
+  Eigen::SparseMatrix<ocs2::scalar_t> H;
+  ocs2::vector_t h;
+  pattern.getCostMatrix(x0, costArray, H, h);
+
+  EXPECT_TRUE(costApproximation.dfdxx.isApprox(H.toDense()));
+  EXPECT_TRUE(costApproximation.dfdx.isApprox(h));
+}
+
+TEST_F(OcpToKktTest, sparsityPatternReuse) {
+  const ocs2::KktSparsityPattern pattern(ocpSize_, true);
+  Eigen::SparseMatrix<ocs2::scalar_t> G, H;
+  ocs2::vector_t g, h;
+  pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, G, g);
+  pattern.getCostMatrix(x0, costArray, H, h);
+  const auto* GValuePtr = G.valuePtr();
+  const auto* HValuePtr = H.valuePtr();
+
+  // New data of the same size is written into the same storage
+  for (int i = 0; i < N_; i++) {
+    dynamicsArray[i] = ocs2::getRandomDynamics(nx_, nu_);
+    costArray[i] = ocs2::getRandomCost(nx_, nu_);
+    constraintsArray[i] = ocs2::getRandomConstraints(nx_, nu_, nc_);
+  }
+  pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, G, g);
+  pattern.getCostMatrix(x0, costArray, H, h);
+  EXPECT_EQ(G.valuePtr(), GValuePtr);
+  EXPECT_EQ(H.valuePtr(), HValuePtr);
+
+  Eigen::SparseMatrix<ocs2::scalar_t> G_ref, H_ref;
+  ocs2::vector_t g_ref, h_ref;
+  ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamicsArray, &constraintsArray, nullptr, G_ref, g_ref);
+  ocs2::getCostMatrixSparse(ocpSize_, x0, costArray, H_ref, h_ref);
+  EXPECT_TRUE(G_ref.toDense().isApprox(G.toDense()));
+  EXPECT_TRUE(g_ref.isApprox(g));
+  EXPECT_TRUE(H_ref.toDense().isApprox(H.toDense()));
+  EXPECT_TRUE(h_ref.isApprox(h));
+
+  // A matrix with a different structure is overwritten with the pattern
+  pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, H, h);
+  EXPECT_TRUE(G.toDense().isApprox(H.toDense()));
+}
+
+TEST_F(OcpToKktTest, sparsityPatternInParallel) {
+  ocs2::ThreadPool threadPool(3, 50);
+  const ocs2::KktSparsityPattern pattern(ocpSize_, true);
+
+  Eigen::SparseMatrix<ocs2::scalar_t> G, G_parallel, H, H_parallel;
+  ocs2::vector_t g, g_parallel, h, h_parallel;
+  pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, G, g);
+  pattern.getConstraintMatrixInParallel(threadPool, x0, dynamicsArray, &constraintsArray, nullptr, G_parallel, g_parallel);
+  pattern.getCostMatrix(x0, costArray, H, h);
+  pattern.getCostMatrixInParallel(threadPool, x0, costArray, H_parallel, h_parallel);
+
+  EXPECT_TRUE(G.toDense().isApprox(G_parallel.toDense()));
+  EXPECT_TRUE(g.isApprox(g_parallel));
+  EXPECT_TRUE(H.toDense().isApprox(H_parallel.toDense()));
+  EXPECT_TRUE(h.isApprox(h_parallel));
+}
@@ -187,6 +187,136 @@ TEST_F(PreconditionTest, ocpDataInPlaceInParallel) {
   EXPECT_TRUE(g_ref.isApprox(g_scaledData));  // g
 }
 
+TEST_F(PreconditionTest, kktMatrixInPlaceOfSparsityPattern) {
+  // Generate reference
+  ocs2::vector_t D_ref, E_ref;
+  ocs2::scalar_t c_ref;
+  Eigen::SparseMatrix<ocs2::scalar_t> H_ref, G_ref;
+  ocs2::vector_t h_ref, g_ref;
+  ocs2::getCostMatrixSparse(ocpSize_, x0, costArray, H_ref, h_ref);
+  ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamicsArray, nullptr, nullptr, G_ref, g_ref);
+  ocs2::precondition::kktMatrixInPlace(5, H_ref, h_ref, G_ref, g_ref, D_ref, E_ref, c_ref);
+
+  // Test start
+  const ocs2::KktSparsityPattern pattern(ocpSize_, false);
+  Eigen::SparseMatrix<ocs2::scalar_t> H, G;
+  ocs2::vector_t h, g;
+  pattern.getCostMatrix(x0, costArray, H, h);
+  pattern.getConstraintMatrix(x0, dynamicsArray, nullptr, nullptr, G, g);
+
+  ocs2::vector_array_t D_array, E_array;
+  ocs2::scalar_t c;
+  ocs2::precondition::kktMatrixInPlace(ocpSize_, 5, H, h, G, g, D_array, E_array, c);
+
+  ASSERT_EQ(D_array.size(), 2 * N_);
+  ASSERT_EQ(E_array.size(), N_);
+  ocs2::vector_t D_stacked(D_ref.rows()), E_stacked(E_ref.rows());
+  int curRow = 0;
+  for (auto& v : D_array) {
+    D_stacked.segment(curRow, v.size()) = v;
+    curRow += v.size();
+  }
+  curRow = 0;
+  for (auto& v : E_array) {
+    E_stacked.segment(curRow, v.size()) = v;
+    curRow += v.size();
+  }
+
+  EXPECT_TRUE(D_stacked.isApprox(D_ref));
+  EXPECT_TRUE(E_stacked.isApprox(E_ref));
+  EXPECT_DOUBLE_EQ(c, c_ref);
+  EXPECT_TRUE(H_ref.toDense().isApprox(H.toDense()));  // H
+  EXPECT_TRUE(h_ref.isApprox(h));                      // h
+  EXPECT_TRUE(G_ref.toDense().isApprox(G.toDense()));  // G
+  EXPECT_TRUE(g_ref.isApprox(g));                      // g
+}
+
+TEST_F(PreconditionTest, ruziPreconditioner) {
+  ocs2::ThreadPool threadPool(5, 99);
+
+  // Generate reference
+  auto dynamicsArray_ref = dynamicsArray;
+  auto costArray_ref = costArray;
+  ocs2::vector_array_t D_ref, E_ref, scalingVectors_ref;
+  ocs2::scalar_t c_ref;
+  ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 5, dynamicsArray_ref, costArray_ref, D_ref, E_ref,
+                                               scalingVectors_ref, c_ref);
+
+  // Test start
+  ocs2::precondition::RuziPreconditioner preconditioner(5);
+  ocs2::vector_array_t D, E, scalingVectors;
+  ocs2::scalar_t c;
+  preconditioner.precondition(threadPool, x0, ocpSize_, dynamicsArray, costArray, D, E, scalingVectors, c);
+
+  EXPECT_EQ(preconditioner.getNumIterations(), 5);
+  EXPECT_DOUBLE_EQ(c, c_ref);
+  for (int i = 0; i < N_; i++) {
+    EXPECT_TRUE(D[2 * i].isApprox(D_ref[2 * i]));
+    EXPECT_TRUE(D[2 * i + 1].isApprox(D_ref[2 * i + 1]));
+    EXPECT_TRUE(E[i].isApprox(E_ref[i]));
+    EXPECT_TRUE(scalingVectors[i].isApprox(scalingVectors_ref[i]));
+    EXPECT_TRUE(dynamicsArray[i].dfdx.isApprox(dynamicsArray_ref[i].dfdx));
+    EXPECT_TRUE(dynamicsArray[i].dfdu.isApprox(dynamicsArray_ref[i].dfdu));
+    EXPECT_TRUE(dynamicsArray[i].f.isApprox(dynamicsArray_ref[i].f));
+  }
+  for (int i = 0; i <= N_; i++) {
+    EXPECT_TRUE(costArray[i].dfdxx.isApprox(costArray_ref[i].dfdxx));
+    EXPECT_TRUE(costArray[i].dfdux.isApprox(costArray_ref[i].dfdux));
+    EXPECT_TRUE(costArray[i].dfduu.isApprox(costArray_ref[i].dfduu));
+    EXPECT_TRUE(costArray[i].dfdx.isApprox(costArray_ref[i].dfdx));
+    EXPECT_TRUE(costArray[i].dfdu.isApprox(costArray_ref[i].dfdu));
+  }
+}
+
+TEST_F(PreconditionTest, ruziPreconditionerEarlyStop) {
+  ocs2::ThreadPool threadPool(5, 99);
+  constexpr int maxNumIterations = 100;
+  ocs2::precondition::RuziPreconditioner preconditioner(maxNumIterations, 1e-3);
+
+  auto dynamicsArray_scaled = dynamicsArray;
+  auto costArray_scaled = costArray;
+  ocs2::vector_array_t D, E, scalingVectors;
+  ocs2::scalar_t c;
+  preconditioner.precondition(threadPool, x0, ocpSize_, dynamicsArray_scaled, costArray_scaled, D, E, scalingVectors, c);
+  EXPECT_GT(preconditioner.getNumIterations(), 0);
+  EXPECT_LT(preconditioner.getNumIterations(), maxNumIterations);
+
+  // The scaled data should be the original data scaled with D, E, and c
+  ocs2::vector_t D_stacked(numDecisionVariables_), E_stacked(numConstraints_);
+  int curRow = 0;
+  for (auto& v : D) {
+    D_stacked.segment(curRow, v.size()) = v;
+    curRow += v.size();
+  }
+  curRow = 0;
+  for (auto& v : E) {
+    E_stacked.segment(curRow, v.size()) = v;
+    curRow += v.size();
+  }
+  auto dynamicsArray_ref = dynamicsArray;
+  auto costArray_ref = costArray;
+  ocs2::vector_array_t scalingVectors_ref;
+  ocs2::precondition::scaleOcpData(ocpSize_, D_stacked, E_stacked, c, dynamicsArray_ref, costArray_ref, scalingVectors_ref);
+
+  Eigen::SparseMatrix<ocs2::scalar_t> H, H_ref, G, G_ref;
+  ocs2::vector_t h, h_ref, g, g_ref;
+  ocs2::getCostMatrixSparse(ocpSize_, x0, costArray_scaled, H, h);
+  ocs2::getCostMatrixSparse(ocpSize_, x0, costArray_ref, H_ref, h_ref);
+  ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamicsArray_scaled, nullptr, &scalingVectors, G, g);
+  ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamicsArray_ref, nullptr, &scalingVectors_ref, G_ref, g_ref);
+  EXPECT_TRUE(H_ref.isApprox(H));  // H
+  EXPECT_TRUE(h_ref.isApprox(h));  // h
+  EXPECT_TRUE(G_ref.isApprox(G));  // G
+  EXPECT_TRUE(g_ref.isApprox(g));  // g
+
+  // The workspace is reused
+  const auto numIterations = preconditioner.getNumIterations();
+  ocs2::scalar_t c_reused;
+  preconditioner.precondition(threadPool, x0, ocpSize_, dynamicsArray, costArray, D, E, scalingVectors, c_reused);
+  EXPECT_EQ(preconditioner.getNumIterations(), numIterations);
+  EXPECT_DOUBLE_EQ(c_reused, c);
+}
+
 TEST_F(PreconditionTest, descaleSolution) {
   ocs2::vector_array_t D(2 * N_);
   ocs2::vector_t DStacked(numDecisionVariables_);
@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include "ocs2_oc/test/EXP1.h"
+
+using namespace ocs2;
+
+namespace {
+
+rollout::Settings getRolloutSettings() {
+  rollout::Settings settings;
+  settings.timeStep = 1e-2;
+  settings.integratorType = IntegratorType::RK4_OCS2;
+  settings.maxNumStepsPerSecond = 10000;
+  return settings;
+}
+
+LinearController getRandomController(scalar_t initTime, scalar_t finalTime, size_t nx, size_t nu) {
+  constexpr size_t numNodes = 10;
+  scalar_array_t timeStamp(numNodes);
+  vector_array_t bias(numNodes);
+  matrix_array_t gain(numNodes);
+  for (size_t k = 0; k < numNodes; k++) {
+    timeStamp[k] = initTime + (finalTime - initTime) * k / (numNodes - 1);
+    bias[k] = vector_t::Random(nu);
+    gain[k] = -0.5 * matrix_t::Random(nu, nx).cwiseAbs();
+  }
+  return LinearController(timeStamp, bias, gain);
+}
+
+/** Compares each rollout of the batch with a TimeTriggeredRollout */
+void compareWithTimeTriggeredRollout(const ControlledSystemBase& systemDynamics, const ModeSchedule& modeSchedule, size_t numThreads) {
+  constexpr size_t batchSize = 7;
+  constexpr scalar_t initTime = 0.0;
+  constexpr scalar_t finalTime = 3.0;
+  const size_t nx = 2;
+  const size_t nu = 1;
+
+  auto controller = getRandomController(initTime, finalTime, nx, nu);
+  vector_array_t initStates(batchSize);
+  for (auto& x : initStates) {
+    x = vector_t::Random(nx);
+  }
+
+  BatchRollout batchRollout(systemDynamics, getRolloutSettings(), numThreads);
+  BatchRolloutTrajectories trajectories;
+  batchRollout.runBatch(initTime, initStates, finalTime, controller, modeSchedule, trajectories);
+  ASSERT_EQ(trajectories.batchSize, batchSize);
+  ASSERT_EQ(trajectories.stateTrajectories.cols(), batchSize * trajectories.timeTrajectory.size());
+  ASSERT_EQ(trajectories.inputTrajectories.cols(), batchSize * trajectories.timeTrajectory.size());
+
+  TimeTriggeredRollout rollout(systemDynamics, getRolloutSettings());
+  for (size_t i = 0; i < batchSize; i++) {
+    auto modeScheduleCopy = modeSchedule;
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    rollout.run(initTime, initStates[i], finalTime, &controller, modeScheduleCopy, timeTrajectory, postEventIndices, stateTrajectory,
+                inputTrajectory);
+
+    ASSERT_EQ(trajectories.timeTrajectory, timeTrajectory);
+    ASSERT_EQ(trajectories.postEventIndices, postEventIndices);
+    const auto batchStateTrajectory = trajectories.getStateTrajectory(i);
+    const auto batchInputTrajectory = trajectories.getInputTrajectory(i);
+    for (size_t k = 0; k < timeTrajectory.size(); k++) {
+      EXPECT_TRUE(batchStateTrajectory[k].isApprox(stateTrajectory[k], 1e-12)) << "rollout: " << i << ", time: " << timeTrajectory[k];
+      EXPECT_TRUE(batchInputTrajectory[k].isApprox(inputTrajectory[k], 1e-12)) << "rollout: " << i << ", time: " << timeTrajectory[k];
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BatchRollout, linearSystem) {
+  const matrix_t A = (matrix_t(2, 2) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(2, 1) << 1.0, 0.0).finished();
+  const matrix_t G = (matrix_t(2, 2) << 1.0, 0.0, 0.0, -1.0).finished();
+  LinearSystemDynamics systemDynamics(A, B, G);
+  const ModeSchedule modeSchedule({1.0, 2.0, 2.0}, {0, 1, 2, 3});
+
+  for (size_t numThreads : {1, 3}) {
+    compareWithTimeTriggeredRollout(systemDynamics, modeSchedule, numThreads);
+  }
+}
+
+TEST(BatchRollout, switchedSystem) {
+  const scalar_array_t eventTimes{0.2262, 1.0176};
+  const std::vector<size_t> modeSequence{0, 1, 2};
+  const auto referenceManagerPtr = getExp1ReferenceManager(eventTimes, modeSequence);
+  EXP1_System systemDynamics(referenceManagerPtr);
+
+  for (size_t numThreads : {1, 3}) {
+    compareWithTimeTriggeredRollout(systemDynamics, referenceManagerPtr->getModeSchedule(), numThreads);
+  }
+}
+
+TEST(BatchRollout, unsupportedIntegrator) {
+  LinearSystemDynamics systemDynamics(matrix_t::Identity(2, 2), matrix_t::Identity(2, 1));
+  auto settings = getRolloutSettings();
+  settings.integratorType = IntegratorType::ODE45;
+  EXPECT_ANY_THROW(BatchRollout(systemDynamics, settings));
+}
@@ -302,3 +302,63 @@ TEST(StateRolloutTests, runHybridDynamics) {
     EXPECT_NEAR(eventTestTimes[i], modeSchedule.eventTimes[i], 1e-6);
   }
 }
+
+/*
+ *     Test 4 for StateTriggeredRollout
+ *     The bouncing ball of test 1 with the fixed-step RK4 integrator of OCS2, the events are located on its dense output.
+ *
+ *     The following tests are implemented and performed:
+ *       - No penetration of Guard Surfaces.
+ *       - Event times compared to the rollout with the RK4 integrator of boost::odeint, which integrates again to locate the events.
+ */
+TEST(StateRolloutTests, rolloutTestBallDynamicsDenseOutput) {
+  const size_t nx = 2;
+  const size_t nu = 1;
+  const scalar_t t0 = 0;
+  const scalar_t t1 = 10;
+  vector_t initState(nx);
+  initState << 1, 0;
+  ocs2::LinearController control(scalar_array_t{t0}, vector_array_t{vector_t::Zero(nu)}, matrix_array_t{matrix_t::Zero(nu, nx)});
+  ocs2::ballDyn dynamics;
+
+  ocs2::rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-10;
+  rolloutSettings.relTolODE = 1e-7;
+  rolloutSettings.timeStep = 1e-3;
+
+  std::vector<scalar_array_t> timeTrajectories;
+  std::vector<size_array_t> postEventIndices;
+  std::vector<vector_array_t> stateTrajectories;
+  std::vector<ocs2::ModeSchedule> modeSchedules;
+  for (const auto integratorType : {ocs2::IntegratorType::RK4, ocs2::IntegratorType::RK4_OCS2}) {
+    rolloutSettings.integratorType = integratorType;
+    ocs2::StateTriggeredRollout rollout(dynamics, rolloutSettings);
+    timeTrajectories.emplace_back();
+    postEventIndices.emplace_back();
+    stateTrajectories.emplace_back();
+    modeSchedules.emplace_back();
+    vector_array_t inputTrajectory;
+    rollout.run(t0, initState, t1, &control, modeSchedules.back(), timeTrajectories.back(), postEventIndices.back(),
+                stateTrajectories.back(), inputTrajectory);
+  }
+
+  // No penetration of the guard surfaces
+  const auto& stateTrajectory = stateTrajectories.back();
+  ASSERT_FALSE(postEventIndices.back().empty());
+  for (int i = 0; i < stateTrajectory.size(); i++) {
+    EXPECT_GT(stateTrajectory[i][0], -1e-6);
+    if (i > postEventIndices.back()[0]) {
+      EXPECT_GT(-stateTrajectory[i][0] + 0.5, -1e-6);
+    }
+  }
+
+  // Same events as the boost::odeint rollout
+  const auto& eventTestTimes = modeSchedules.front().eventTimes;
+  const auto& modeSchedule = modeSchedules.back();
+  ASSERT_EQ(eventTestTimes.size(), modeSchedule.eventTimes.size());
+  ASSERT_EQ(modeSchedules.front().modeSequence, modeSchedule.modeSequence);
+  for (int i = 0; i < eventTestTimes.size(); i++) {
+    EXPECT_NEAR(timeTrajectories.back()[postEventIndices.back()[i] - 1], eventTestTimes[i], 1e-9);
+    EXPECT_NEAR(eventTestTimes[i], modeSchedule.eventTimes[i], 1e-9);
+  }
+}
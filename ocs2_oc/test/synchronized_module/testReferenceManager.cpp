@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/oc_data/TimeDiscretization.h"
+#include "ocs2_oc/synchronized_module/ReferenceManager.h"
+
+using namespace ocs2;
+
+namespace {
+
+TargetTrajectories getRandomTargetTrajectories(size_t numPoints, scalar_t initTime, scalar_t finalTime, size_t stateDim, size_t inputDim) {
+  TargetTrajectories targetTrajectories(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    targetTrajectories.timeTrajectory[i] = initTime + (finalTime - initTime) * i / (numPoints - 1);
+    targetTrajectories.stateTrajectory[i] = vector_t::Random(stateDim);
+    targetTrajectories.inputTrajectory[i] = vector_t::Random(inputDim);
+  }
+  return targetTrajectories;
+}
+
+/** Modifies the target in every solver run */
+class ModifyingReferenceManager : public ReferenceManager {
+ public:
+  using ReferenceManager::ReferenceManager;
+
+ private:
+  void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
+                        ModeSchedule& modeSchedule) override {
+    targetTrajectories.stateTrajectory.front() = initState;
+  }
+};
+
+/** Never modifies the references, so the snapshots are activated without a copy */
+class FixedReferenceManager : public ReferenceManager {
+ public:
+  using ReferenceManager::ReferenceManager;
+
+ private:
+  bool modifiesReferences() const override { return false; }
+};
+
+}  // unnamed namespace
+
+TEST(testReferenceManager, snapshots) {
+  const vector_t initState = vector_t::Zero(2);
+  FixedReferenceManager referenceManager;
+
+  // A snapshot is activated without a copy
+  const auto snapshot = std::make_shared<const TargetTrajectories>(getRandomTargetTrajectories(10, 0.0, 1.0, 2, 1));
+  referenceManager.setTargetTrajectoriesSnapshot(snapshot);
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  ASSERT_EQ(&referenceManager.getTargetTrajectories(), snapshot.get());
+  ASSERT_EQ(referenceManager.getTargetTrajectoriesSnapshot(), snapshot);
+
+  const auto modeSchedule = std::make_shared<const ModeSchedule>(scalar_array_t{0.5}, size_array_t{0, 1});
+  referenceManager.setModeScheduleSnapshot(modeSchedule);
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  ASSERT_EQ(&referenceManager.getModeSchedule(), modeSchedule.get());
+
+  // The values set by copy or move are still supported
+  referenceManager.setTargetTrajectories(*snapshot);
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  ASSERT_NE(&referenceManager.getTargetTrajectories(), snapshot.get());
+  ASSERT_TRUE(referenceManager.getTargetTrajectories() == *snapshot);
+}
+
+TEST(testReferenceManager, copyOnWrite) {
+  const vector_t initState = vector_t::Ones(2);
+  ModifyingReferenceManager referenceManager;
+
+  // The snapshot is copied before it is modified
+  const auto snapshot = std::make_shared<const TargetTrajectories>(getRandomTargetTrajectories(10, 0.0, 1.0, 2, 1));
+  const auto originalSnapshot = *snapshot;
+  referenceManager.setTargetTrajectoriesSnapshot(snapshot);
+  referenceManager.preSolverRun(0.0, 1.0, initState);
+  ASSERT_TRUE(*snapshot == originalSnapshot);
+  ASSERT_TRUE(referenceManager.getTargetTrajectories().stateTrajectory.front() == initState);
+
+  // The active value is owned and not shared anymore, so it is modified in place
+  const auto* activeTargetTrajectories = &referenceManager.getTargetTrajectories();
+  referenceManager.preSolverRun(0.0, 1.0, 2.0 * initState);
+  ASSERT_EQ(&referenceManager.getTargetTrajectories(), activeTargetTrajectories);
+  ASSERT_TRUE(referenceManager.getTargetTrajectories().stateTrajectory.front() == 2.0 * initState);
+
+  // A snapshot handed out by the reference manager is not affected by later modifications
+  const auto activeSnapshot = referenceManager.getTargetTrajectoriesSnapshot();
+  referenceManager.preSolverRun(0.0, 1.0, 3.0 * initState);
+  ASSERT_TRUE(activeSnapshot->stateTrajectory.front() == 2.0 * initState);
+  ASSERT_TRUE(referenceManager.getTargetTrajectories().stateTrajectory.front() == 3.0 * initState);
+}
+
+TEST(testReferenceManager, sampleTargetTrajectories) {
+  const scalar_t initTime = 0.1;
+  const scalar_t finalTime = 1.1;
+  const auto targetTrajectories = getRandomTargetTrajectories(1000, 0.0, 2.0, 4, 2);
+  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, 0.01, {0.3, 0.55});
+  const auto nodeTime = toNodeTime(timeDiscretization);
+
+  TargetTrajectories sampledTargetTrajectories;
+  sampleTargetTrajectories(targetTrajectories, nodeTime, sampledTargetTrajectories);
+  ASSERT_EQ(sampledTargetTrajectories.size(), timeDiscretization.size());
+
+  // The sampled target is exact at the node times
+  for (const auto t : nodeTime) {
+    ASSERT_TRUE(sampledTargetTrajectories.getDesiredState(t) == targetTrajectories.getDesiredState(t));
+    ASSERT_TRUE(sampledTargetTrajectories.getDesiredInput(t) == targetTrajectories.getDesiredInput(t));
+  }
+
+  // Target without input
+  const TargetTrajectories stateTargetTrajectories(targetTrajectories.timeTrajectory, targetTrajectories.stateTrajectory);
+  sampleTargetTrajectories(stateTargetTrajectories, nodeTime, sampledTargetTrajectories);
+  ASSERT_TRUE(sampledTargetTrajectories.inputTrajectory.empty());
+  ASSERT_THROW(sampleTargetTrajectories(TargetTrajectories(), nodeTime, sampledTargetTrajectories), std::runtime_error);
+}
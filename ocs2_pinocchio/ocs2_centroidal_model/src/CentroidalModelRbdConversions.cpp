@@ -234,8 +234,8 @@ void CentroidalModelRbdConversions::loadSettings(const std::string& fileName, co
     std::cerr << "#### =============================================================================" << std::endl;
   }
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::getPropertyTree(fileName);
+  const auto& pt = *ptPtr;
   const std::string centroidalModelRbdConversionsFieldName = fieldName + ".centroidal_model_rbd_conversions";
 
   std::vector<scalar_t> pGainsVec, dGainsVec;
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include <ocs2_sphere_approximation/SphereApproximation.h>
+#include <ocs2_sphere_approximation/SphereTree.h>
 
 #include <hpp/fcl/collision_data.h>
 
@@ -80,6 +81,15 @@ class PinocchioSphereInterface final {
    */
   std::vector<vector3_t> computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface) const;
 
+  /** Compute the poses of the sphere trees in world frame, see getSphereTrees().
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @return An array of the poses of the parent joint of each collision link.
+   */
+  std::vector<SphereTree::Pose> computeSphereTreePosesInWorldFrame(const PinocchioInterface& pinocchioInterface) const;
+
   /** Get the array of the collision links approximated with spheres */
   const std::vector<std::string>& getCollisionLinks() const { return collisionLinks_; };
 
@@ -112,6 +122,14 @@ class PinocchioSphereInterface final {
     return sphereApproximations_[approxId].getSphereCentersToObjectCenter();
   };
 
+  /** Get the sphere tree of each collision link. The spheres are expressed in the frame of the parent joint of the link.
+   * The sphere indices of the tree of link i are relative to getSphereTreeFirstSphereIndices()[i] in computeSphereCentersInWorldFrame().
+   */
+  const std::vector<SphereTree>& getSphereTrees() const { return sphereTrees_; }
+
+  /** Get the index of the first sphere of each collision link in computeSphereCentersInWorldFrame() */
+  const size_array_t& getSphereTreeFirstSphereIndices() const { return sphereTreeFirstSphereIndices_; }
+
   /** Access the pinocchio geometry model */
   pinocchio::GeometryModel& getGeometryModel() { return *geometryModelPtr_; }
   const pinocchio::GeometryModel& getGeometryModel() const { return *geometryModelPtr_; }
@@ -119,6 +137,7 @@ class PinocchioSphereInterface final {
  private:
   // Construction helpers
   void buildGeomFromPinocchioInterface(const PinocchioInterface& pinocchioInterface, pinocchio::GeometryModel& geomModel);
+  void buildSphereTrees();
 
   std::unique_ptr<pinocchio::GeometryModel> geometryModelPtr_;
 
@@ -131,6 +150,11 @@ class PinocchioSphereInterface final {
   size_array_t numSpheres_;
   size_array_t geomObjIds_;
   scalar_array_t sphereRadii_;
+
+  // Sphere tree of each collision link
+  std::vector<SphereTree> sphereTrees_;
+  size_array_t sphereTreeParentJoints_;
+  size_array_t sphereTreeFirstSphereIndices_;
 };
 
 }  // namespace ocs2
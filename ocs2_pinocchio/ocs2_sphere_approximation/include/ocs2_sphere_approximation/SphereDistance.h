@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <limits>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_robotic_tools/common/RotationTransformsBatch.h>
+
+#include "ocs2_sphere_approximation/SphereTree.h"
+
+namespace ocs2 {
+
+/**
+ * Batched distance kernels for collision spheres.
+ *
+ * Sphere centers are stored as 3xN arrays with contiguous coordinates, such that the distances to a batch of spheres are computed with
+ * vectorized operations. Distances are measured between the sphere surfaces and are negative for penetrating spheres.
+ */
+namespace sphere_distance {
+
+/** Read-only views on 3xN positions and N radii, such that contiguous blocks of the sphere tree arrays can be passed without a copy. */
+using positions_ref_t = Eigen::Ref<const batch_array_t<scalar_t, 3>>;
+using radii_ref_t = Eigen::Ref<const vector_t>;
+
+/** Signed distance field evaluated for a batch of 3xN positions, returns the N distances. Must be 1-Lipschitz, e.g. a Euclidean SDF. */
+using sdf_function_t = std::function<vector_t(const batch_array_t<scalar_t, 3>&)>;
+
+/** Result of a minimum distance query. The sphere indices refer to the order of the spheres passed to the SphereTree constructor. */
+struct DistanceResult {
+  scalar_t distance = std::numeric_limits<scalar_t>::max();
+  size_t sphereIndexA = 0;
+  size_t sphereIndexB = 0;
+};
+
+/**
+ * Transforms a batch of positions.
+ * @param [in] pose : transform from the local frame to the world frame.
+ * @param [in] positions : 3xN positions in the local frame.
+ * @return 3xN positions in the world frame.
+ */
+batch_array_t<scalar_t, 3> transformPositions(const SphereTree::Pose& pose, const batch_array_t<scalar_t, 3>& positions);
+
+/**
+ * Computes the distances between all pairs of spheres of two sets.
+ * @return distances(i, j) = |centersA_i - centersB_j| - radiiA_i - radiiB_j
+ */
+matrix_t computeSphereSphereDistances(const positions_ref_t& centersA, const radii_ref_t& radiiA,
+                                      const positions_ref_t& centersB, const radii_ref_t& radiiB);
+
+/**
+ * Computes the distances of a set of spheres to the zero level set of a signed distance field.
+ * @return distances(i) = sdf(centers_i) - radii_i
+ */
+vector_t computeSphereSdfDistances(const batch_array_t<scalar_t, 3>& centers, const vector_t& radii, const sdf_function_t& sdf);
+
+/**
+ * Computes the minimum distance between the spheres of two trees. Node pairs whose bounding spheres are further apart than the best
+ * distance found so far are skipped. Equal to the minimum of computeSphereSphereDistances over all spheres.
+ */
+DistanceResult computeMinimumDistance(const SphereTree& treeA, const SphereTree::Pose& poseA, const SphereTree& treeB,
+                                      const SphereTree::Pose& poseB);
+
+/**
+ * Computes the minimum distance between the spheres of a tree and a signed distance field. The tree is traversed level by level and the
+ * SDF is evaluated in one batch per level. Equal to the minimum of computeSphereSdfDistances over all spheres. sphereIndexB is unused.
+ */
+DistanceResult computeMinimumSdfDistance(const SphereTree& tree, const SphereTree::Pose& pose, const sdf_function_t& sdf);
+
+}  // namespace sphere_distance
+}  // namespace ocs2
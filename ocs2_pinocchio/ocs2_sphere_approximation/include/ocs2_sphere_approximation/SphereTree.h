@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_robotic_tools/common/RotationTransformsBatch.h>
+
+namespace ocs2 {
+
+/**
+ * Bounding sphere hierarchy over the collision spheres of a link.
+ *
+ * The tree is built top-down by splitting the spheres at the median of the longest axis of their bounding box. Every node stores a sphere
+ * that encloses all spheres below it, and the spheres of a node are stored contiguously, such that the leaf spheres of a node can be
+ * passed in one batch to the distance kernels of SphereDistance.h. Distance queries descend the tree and skip all nodes whose bounding
+ * sphere is further away than the best distance found so far.
+ *
+ * The tree is built once from the sphere approximation and can be written to and read from a file, so it does not have to be rebuilt on
+ * every start-up.
+ */
+class SphereTree {
+ public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
+
+  /** Node of the tree. Spheres [firstSphere, firstSphere + numSpheres) are below this node. */
+  struct Node {
+    vector3_t center;
+    scalar_t radius;
+    int firstSphere;
+    int numSpheres;
+    int leftChild;  // -1 for a leaf node
+    int rightChild;
+
+    bool isLeaf() const { return leftChild < 0; }
+  };
+
+  /** Rigid transform of the tree frame to the world frame */
+  struct Pose {
+    matrix3_t rotation;
+    vector3_t translation;
+  };
+
+  /** Default constructor creates an empty tree */
+  SphereTree() = default;
+
+  /** Constructor
+   * @param [in] sphereCenters : sphere centers in the frame of the tree
+   * @param [in] sphereRadii : sphere radii
+   * @param [in] maxSpheresPerLeaf : maximum number of spheres in a leaf node
+   */
+  SphereTree(const std::vector<vector3_t>& sphereCenters, const scalar_array_t& sphereRadii, size_t maxSpheresPerLeaf = 4);
+
+  /** Loads a tree that was written with save(). Throws std::runtime_error if the file is not a valid sphere tree. */
+  static SphereTree load(const std::string& filePath);
+
+  /** Writes the tree to a binary file */
+  void save(const std::string& filePath) const;
+
+  /** Get the nodes. The root node is the first node. */
+  const std::vector<Node>& getNodes() const { return nodes_; }
+
+  /** Get the centers of the node spheres, stored as 3xN with contiguous coordinates */
+  const batch_array_t<scalar_t, 3>& getNodeCenters() const { return nodeCenters_; }
+
+  /** Get the number of spheres */
+  size_t getNumSpheres() const { return sphereIndices_.size(); }
+
+  /** Get the sphere centers in tree order, stored as 3xN with contiguous coordinates */
+  const batch_array_t<scalar_t, 3>& getSphereCenters() const { return sphereCenters_; }
+
+  /** Get the sphere radii in tree order */
+  const vector_t& getSphereRadii() const { return sphereRadii_; }
+
+  /** Get the index of each sphere, in tree order, in the array passed to the constructor */
+  const size_array_t& getSphereIndices() const { return sphereIndices_; }
+
+ private:
+  int buildNode(int firstSphere, int numSpheres, size_t maxSpheresPerLeaf, std::vector<vector3_t>& centers, scalar_array_t& radii);
+  void updateNodeCenters();
+
+  std::vector<Node> nodes_;
+  batch_array_t<scalar_t, 3> nodeCenters_;
+  batch_array_t<scalar_t, 3> sphereCenters_;
+  vector_t sphereRadii_;
+  size_array_t sphereIndices_;
+};
+
+}  // namespace ocs2
@@ -72,6 +72,8 @@ PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioInterface& pin
       sphereRadii_.push_back(sphereApprox.getSphereRadius());
     }
   }
+
+  buildSphereTrees();
 }
 
 /******************************************************************************************************/
@@ -91,7 +93,10 @@ PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioSphereInterfac
       numSpheresInTotal_(rhs.numSpheresInTotal_),
       numSpheres_(rhs.numSpheres_),
       geomObjIds_(rhs.geomObjIds_),
-      sphereRadii_(rhs.sphereRadii_) {}
+      sphereRadii_(rhs.sphereRadii_),
+      sphereTrees_(rhs.sphereTrees_),
+      sphereTreeParentJoints_(rhs.sphereTreeParentJoints_),
+      sphereTreeFirstSphereIndices_(rhs.sphereTreeFirstSphereIndices_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -119,6 +124,31 @@ void PinocchioSphereInterface::buildGeomFromPinocchioInterface(const PinocchioIn
   pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioSphereInterface::buildSphereTrees() {
+  // The primitive shapes are added link by link, so the spheres of a link are contiguous.
+  size_t primitiveShapeId = 0;
+  size_t sphereId = 0;
+  for (const auto& link : collisionLinks_) {
+    size_t parentJoint = 0;
+    std::vector<vector3_t> sphereCentersInJointFrame;
+    scalar_array_t sphereRadii;
+    sphereTreeFirstSphereIndices_.push_back(sphereId);
+    for (; primitiveShapeId < numPrimitiveShapes_ && collisionLinkOfEachPrimitiveShape_[primitiveShapeId] == link; primitiveShapeId++) {
+      const pinocchio::GeometryObject& object = geometryModelPtr_->geometryObjects[geomObjIds_[primitiveShapeId]];
+      parentJoint = object.parentJoint;
+      for (const auto& sphereCenter : sphereApproximations_[primitiveShapeId].getSphereCentersToObjectCenter()) {
+        sphereCentersInJointFrame.emplace_back(object.placement.translation() + object.placement.rotation() * sphereCenter);
+        sphereRadii.push_back(sphereRadii_[sphereId++]);
+      }
+    }
+    sphereTrees_.emplace_back(sphereCentersInJointFrame, sphereRadii);
+    sphereTreeParentJoints_.push_back(parentJoint);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -143,4 +173,19 @@ auto PinocchioSphereInterface::computeSphereCentersInWorldFrame(const PinocchioI
   return sphereCentersInWorldFrame;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<SphereTree::Pose> PinocchioSphereInterface::computeSphereTreePosesInWorldFrame(
+    const PinocchioInterface& pinocchioInterface) const {
+  const auto& data = pinocchioInterface.getData();
+  std::vector<SphereTree::Pose> poses(sphereTrees_.size());
+  for (size_t i = 0; i < sphereTrees_.size(); i++) {
+    const auto& jointPlacement = data.oMi[sphereTreeParentJoints_[i]];
+    poses[i].rotation = jointPlacement.rotation();
+    poses[i].translation = jointPlacement.translation();
+  }
+  return poses;
+}
+
 }  // namespace ocs2
@@ -0,0 +1,218 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sphere_approximation/SphereDistance.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+namespace sphere_distance {
+
+namespace {
+batch_array_t<scalar_t, 3> getColumns(const batch_array_t<scalar_t, 3>& positions, const std::vector<int>& indices) {
+  batch_array_t<scalar_t, 3> columns(3, indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    columns.col(i) = positions.col(indices[i]);
+  }
+  return columns;
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+batch_array_t<scalar_t, 3> transformPositions(const SphereTree::Pose& pose, const batch_array_t<scalar_t, 3>& positions) {
+  const auto& R = pose.rotation;
+  batch_array_t<scalar_t, 3> positionsInWorld(3, positions.cols());
+  for (int i = 0; i < 3; i++) {
+    positionsInWorld.row(i) = R(i, 0) * positions.row(0) + R(i, 1) * positions.row(1) + R(i, 2) * positions.row(2) + pose.translation(i);
+  }
+  return positionsInWorld;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t computeSphereSphereDistances(const positions_ref_t& centersA, const radii_ref_t& radiiA,
+                                      const positions_ref_t& centersB, const radii_ref_t& radiiB) {
+  // Column j holds the distances of all spheres of A to sphere j of B, such that the inner loop runs over contiguous memory.
+  matrix_t distances(centersA.cols(), centersB.cols());
+  for (Eigen::Index j = 0; j < centersB.cols(); j++) {
+    distances.col(j) = ((centersA.row(0) - centersB(0, j)).square() + (centersA.row(1) - centersB(1, j)).square() +
+                        (centersA.row(2) - centersB(2, j)).square())
+                           .sqrt()
+                           .matrix()
+                           .transpose() -
+                       radiiA - vector_t::Constant(radiiA.size(), radiiB(j));
+  }
+  return distances;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t computeSphereSdfDistances(const batch_array_t<scalar_t, 3>& centers, const vector_t& radii, const sdf_function_t& sdf) {
+  return sdf(centers) - radii;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DistanceResult computeMinimumDistance(const SphereTree& treeA, const SphereTree::Pose& poseA, const SphereTree& treeB,
+                                      const SphereTree::Pose& poseB) {
+  DistanceResult result;
+  const auto& nodesA = treeA.getNodes();
+  const auto& nodesB = treeB.getNodes();
+  if (nodesA.empty() || nodesB.empty()) {
+    return result;
+  }
+
+  const batch_array_t<scalar_t, 3> nodeCentersA = transformPositions(poseA, treeA.getNodeCenters());
+  const batch_array_t<scalar_t, 3> nodeCentersB = transformPositions(poseB, treeB.getNodeCenters());
+  const batch_array_t<scalar_t, 3> sphereCentersA = transformPositions(poseA, treeA.getSphereCenters());
+  const batch_array_t<scalar_t, 3> sphereCentersB = transformPositions(poseB, treeB.getSphereCenters());
+
+  auto nodeDistance = [&](int a, int b) {
+    return (nodeCentersA.col(a) - nodeCentersB.col(b)).matrix().norm() - nodesA[a].radius - nodesB[b].radius;
+  };
+
+  struct NodePair {
+    int a;
+    int b;
+    scalar_t lowerBound;
+  };
+  std::vector<NodePair> stack;
+  stack.push_back({0, 0, nodeDistance(0, 0)});
+  while (!stack.empty()) {
+    const NodePair pair = stack.back();
+    stack.pop_back();
+    if (pair.lowerBound >= result.distance) {
+      continue;
+    }
+
+    const auto& nodeA = nodesA[pair.a];
+    const auto& nodeB = nodesB[pair.b];
+    if (nodeA.isLeaf() && nodeB.isLeaf()) {
+      const matrix_t distances =
+          computeSphereSphereDistances(sphereCentersA.middleCols(nodeA.firstSphere, nodeA.numSpheres),
+                                       treeA.getSphereRadii().segment(nodeA.firstSphere, nodeA.numSpheres),
+                                       sphereCentersB.middleCols(nodeB.firstSphere, nodeB.numSpheres),
+                                       treeB.getSphereRadii().segment(nodeB.firstSphere, nodeB.numSpheres));
+      Eigen::Index i, j;
+      const scalar_t minDistance = distances.minCoeff(&i, &j);
+      if (minDistance < result.distance) {
+        result.distance = minDistance;
+        result.sphereIndexA = treeA.getSphereIndices()[nodeA.firstSphere + i];
+        result.sphereIndexB = treeB.getSphereIndices()[nodeB.firstSphere + j];
+      }
+      continue;
+    }
+
+    // Descend into the larger node. The closer child is pushed last, such that it is processed first.
+    NodePair first, second;
+    if (nodeB.isLeaf() || (!nodeA.isLeaf() && nodeA.radius >= nodeB.radius)) {
+      first = {nodeA.leftChild, pair.b, nodeDistance(nodeA.leftChild, pair.b)};
+      second = {nodeA.rightChild, pair.b, nodeDistance(nodeA.rightChild, pair.b)};
+    } else {
+      first = {pair.a, nodeB.leftChild, nodeDistance(pair.a, nodeB.leftChild)};
+      second = {pair.a, nodeB.rightChild, nodeDistance(pair.a, nodeB.rightChild)};
+    }
+    if (first.lowerBound < second.lowerBound) {
+      std::swap(first, second);
+    }
+    stack.push_back(first);
+    stack.push_back(second);
+  }
+
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DistanceResult computeMinimumSdfDistance(const SphereTree& tree, const SphereTree::Pose& pose, const sdf_function_t& sdf) {
+  DistanceResult result;
+  const auto& nodes = tree.getNodes();
+  if (nodes.empty()) {
+    return result;
+  }
+
+  const batch_array_t<scalar_t, 3> nodeCenters = transformPositions(pose, tree.getNodeCenters());
+  const batch_array_t<scalar_t, 3> sphereCenters = transformPositions(pose, tree.getSphereCenters());
+
+  // Since the SDF is 1-Lipschitz, the spheres below a node are at a distance in [sdf(center) - radius, sdf(center) + radius].
+  scalar_t upperBound = std::numeric_limits<scalar_t>::max();
+  std::vector<int> level{0};
+  std::vector<int> nextLevel;
+  std::vector<int> leafSpheres;
+  while (!level.empty()) {
+    const vector_t nodeSdf = sdf(getColumns(nodeCenters, level));
+    for (size_t i = 0; i < level.size(); i++) {
+      upperBound = std::min(upperBound, nodeSdf[i] + nodes[level[i]].radius);
+    }
+
+    nextLevel.clear();
+    leafSpheres.clear();
+    for (size_t i = 0; i < level.size(); i++) {
+      const auto& node = nodes[level[i]];
+      if (nodeSdf[i] - node.radius > upperBound) {
+        continue;
+      }
+      if (node.isLeaf()) {
+        for (int s = node.firstSphere; s < node.firstSphere + node.numSpheres; s++) {
+          leafSpheres.push_back(s);
+        }
+      } else {
+        nextLevel.push_back(node.leftChild);
+        nextLevel.push_back(node.rightChild);
+      }
+    }
+
+    if (!leafSpheres.empty()) {
+      vector_t leafRadii(leafSpheres.size());
+      for (size_t i = 0; i < leafSpheres.size(); i++) {
+        leafRadii[i] = tree.getSphereRadii()[leafSpheres[i]];
+      }
+      const vector_t distances = computeSphereSdfDistances(getColumns(sphereCenters, leafSpheres), leafRadii, sdf);
+      Eigen::Index i;
+      const scalar_t minDistance = distances.minCoeff(&i);
+      if (minDistance < result.distance) {
+        result.distance = minDistance;
+        result.sphereIndexA = tree.getSphereIndices()[leafSpheres[i]];
+      }
+      upperBound = std::min(upperBound, minDistance);
+    }
+    std::swap(level, nextLevel);
+  }
+
+  return result;
+}
+
+}  // namespace sphere_distance
+}  // namespace ocs2
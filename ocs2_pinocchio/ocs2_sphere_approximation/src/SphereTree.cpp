@@ -0,0 +1,276 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sphere_approximation/SphereTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace ocs2 {
+
+namespace {
+constexpr char fileIdentifier[] = "ocs2_sphere_tree";
+constexpr uint32_t fileVersion = 1;
+
+template <typename T>
+void write(std::ofstream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read(std::ifstream& stream) {
+  T value;
+  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereTree::SphereTree(const std::vector<vector3_t>& sphereCenters, const scalar_array_t& sphereRadii, size_t maxSpheresPerLeaf) {
+  if (sphereCenters.size() != sphereRadii.size()) {
+    throw std::runtime_error("[SphereTree] The number of sphere centers and radii must be equal!");
+  }
+  if (maxSpheresPerLeaf == 0) {
+    throw std::runtime_error("[SphereTree] maxSpheresPerLeaf must be larger than 0!");
+  }
+
+  const size_t numSpheres = sphereCenters.size();
+  sphereIndices_.resize(numSpheres);
+  std::iota(sphereIndices_.begin(), sphereIndices_.end(), 0);
+  if (numSpheres == 0) {
+    nodeCenters_.resize(3, 0);
+    sphereCenters_.resize(3, 0);
+    sphereRadii_.resize(0);
+    return;
+  }
+
+  // A binary tree with at least one sphere per leaf has less than 2 * numSpheres nodes
+  nodes_.reserve(2 * numSpheres);
+  std::vector<vector3_t> centers = sphereCenters;
+  scalar_array_t radii = sphereRadii;
+  buildNode(0, static_cast<int>(numSpheres), maxSpheresPerLeaf, centers, radii);
+
+  sphereCenters_.resize(3, numSpheres);
+  sphereRadii_.resize(numSpheres);
+  for (size_t i = 0; i < numSpheres; i++) {
+    sphereCenters_.col(i) = centers[i];
+    sphereRadii_[i] = radii[i];
+  }
+  updateNodeCenters();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int SphereTree::buildNode(int firstSphere, int numSpheres, size_t maxSpheresPerLeaf, std::vector<vector3_t>& centers,
+                          scalar_array_t& radii) {
+  // Bounding box of the spheres
+  vector3_t boxMin = vector3_t::Constant(std::numeric_limits<scalar_t>::max());
+  vector3_t boxMax = vector3_t::Constant(std::numeric_limits<scalar_t>::lowest());
+  for (int i = firstSphere; i < firstSphere + numSpheres; i++) {
+    boxMin = boxMin.cwiseMin(centers[i] - vector3_t::Constant(radii[i]));
+    boxMax = boxMax.cwiseMax(centers[i] + vector3_t::Constant(radii[i]));
+  }
+
+  Node node;
+  node.center = 0.5 * (boxMin + boxMax);
+  node.radius = 0.0;
+  for (int i = firstSphere; i < firstSphere + numSpheres; i++) {
+    node.radius = std::max(node.radius, (centers[i] - node.center).norm() + radii[i]);
+  }
+  node.firstSphere = firstSphere;
+  node.numSpheres = numSpheres;
+  node.leftChild = -1;
+  node.rightChild = -1;
+
+  const int nodeIndex = static_cast<int>(nodes_.size());
+  nodes_.push_back(node);
+  if (numSpheres <= static_cast<int>(maxSpheresPerLeaf)) {
+    return nodeIndex;
+  }
+
+  // Split at the median along the longest axis of the bounding box. Centers, radii, and indices are permuted together.
+  int axis;
+  (boxMax - boxMin).maxCoeff(&axis);
+  std::vector<int> order(numSpheres);
+  std::iota(order.begin(), order.end(), firstSphere);
+  const int numLeft = numSpheres / 2;
+  std::nth_element(order.begin(), order.begin() + numLeft, order.end(),
+                   [&](int lhs, int rhs) { return centers[lhs][axis] < centers[rhs][axis]; });
+
+  const std::vector<vector3_t> centersCopy(centers.begin() + firstSphere, centers.begin() + firstSphere + numSpheres);
+  const scalar_array_t radiiCopy(radii.begin() + firstSphere, radii.begin() + firstSphere + numSpheres);
+  const size_array_t indicesCopy(sphereIndices_.begin() + firstSphere, sphereIndices_.begin() + firstSphere + numSpheres);
+  for (int i = 0; i < numSpheres; i++) {
+    centers[firstSphere + i] = centersCopy[order[i] - firstSphere];
+    radii[firstSphere + i] = radiiCopy[order[i] - firstSphere];
+    sphereIndices_[firstSphere + i] = indicesCopy[order[i] - firstSphere];
+  }
+
+  const int leftChild = buildNode(firstSphere, numLeft, maxSpheresPerLeaf, centers, radii);
+  const int rightChild = buildNode(firstSphere + numLeft, numSpheres - numLeft, maxSpheresPerLeaf, centers, radii);
+  nodes_[nodeIndex].leftChild = leftChild;
+  nodes_[nodeIndex].rightChild = rightChild;
+  return nodeIndex;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereTree::save(const std::string& filePath) const {
+  std::ofstream stream(filePath, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[SphereTree] Could not open file for writing: " + filePath);
+  }
+
+  stream.write(fileIdentifier, sizeof(fileIdentifier));
+  write(stream, fileVersion);
+
+  write(stream, static_cast<uint64_t>(nodes_.size()));
+  for (const auto& node : nodes_) {
+    stream.write(reinterpret_cast<const char*>(node.center.data()), 3 * sizeof(scalar_t));
+    write(stream, node.radius);
+    write(stream, static_cast<int32_t>(node.firstSphere));
+    write(stream, static_cast<int32_t>(node.numSpheres));
+    write(stream, static_cast<int32_t>(node.leftChild));
+    write(stream, static_cast<int32_t>(node.rightChild));
+  }
+
+  write(stream, static_cast<uint64_t>(getNumSpheres()));
+  stream.write(reinterpret_cast<const char*>(sphereCenters_.data()), sphereCenters_.size() * sizeof(scalar_t));
+  stream.write(reinterpret_cast<const char*>(sphereRadii_.data()), sphereRadii_.size() * sizeof(scalar_t));
+  for (const auto index : sphereIndices_) {
+    write(stream, static_cast<uint64_t>(index));
+  }
+
+  if (!stream) {
+    throw std::runtime_error("[SphereTree] Failed to write file: " + filePath);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereTree SphereTree::load(const std::string& filePath) {
+  std::ifstream stream(filePath, std::ios::binary);
+  if (!stream) {
+    throw std::runtime_error("[SphereTree] Could not open file for reading: " + filePath);
+  }
+
+  char identifier[sizeof(fileIdentifier)];
+  stream.read(identifier, sizeof(identifier));
+  if (!stream || !std::equal(identifier, identifier + sizeof(identifier), fileIdentifier)) {
+    throw std::runtime_error("[SphereTree] Not a sphere tree file: " + filePath);
+  }
+  if (read<uint32_t>(stream) != fileVersion) {
+    throw std::runtime_error("[SphereTree] Unsupported file version: " + filePath);
+  }
+
+  // Sizes are checked against the remaining bytes of the file before anything is allocated
+  const auto headerEnd = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  const auto numRemainingBytes = static_cast<uint64_t>(stream.tellg() - headerEnd);
+  stream.seekg(headerEnd);
+  const auto checkFile = [&](bool condition, const std::string& message) {
+    if (!condition) {
+      throw std::runtime_error("[SphereTree] Invalid sphere tree file, " + message + ": " + filePath);
+    }
+  };
+  constexpr uint64_t nodeBytes = 4 * sizeof(scalar_t) + 4 * sizeof(int32_t);
+  constexpr uint64_t sphereBytes = 4 * sizeof(scalar_t) + sizeof(uint64_t);
+
+  SphereTree tree;
+  const auto numNodes = read<uint64_t>(stream);
+  checkFile(stream && numNodes <= numRemainingBytes / nodeBytes, "number of nodes exceeds the file size");
+  tree.nodes_.resize(numNodes);
+  for (auto& node : tree.nodes_) {
+    stream.read(reinterpret_cast<char*>(node.center.data()), 3 * sizeof(scalar_t));
+    node.radius = read<scalar_t>(stream);
+    node.firstSphere = read<int32_t>(stream);
+    node.numSpheres = read<int32_t>(stream);
+    node.leftChild = read<int32_t>(stream);
+    node.rightChild = read<int32_t>(stream);
+  }
+
+  const auto numSpheres = read<uint64_t>(stream);
+  checkFile(stream && numSpheres <= (numRemainingBytes - numNodes * nodeBytes) / sphereBytes, "number of spheres exceeds the file size");
+  tree.sphereCenters_.resize(3, numSpheres);
+  tree.sphereRadii_.resize(numSpheres);
+  tree.sphereIndices_.resize(numSpheres);
+  stream.read(reinterpret_cast<char*>(tree.sphereCenters_.data()), tree.sphereCenters_.size() * sizeof(scalar_t));
+  stream.read(reinterpret_cast<char*>(tree.sphereRadii_.data()), tree.sphereRadii_.size() * sizeof(scalar_t));
+  for (auto& index : tree.sphereIndices_) {
+    index = read<uint64_t>(stream);
+  }
+
+  if (!stream) {
+    throw std::runtime_error("[SphereTree] Failed to read file: " + filePath);
+  }
+
+  // Content
+  checkFile(tree.nodes_.empty() == (numSpheres == 0), "nodes without spheres or spheres without nodes");
+  checkFile(tree.sphereCenters_.allFinite(), "sphere centers are not finite");
+  checkFile(tree.sphereRadii_.allFinite() && (tree.sphereRadii_.array() >= 0.0).all(), "negative or non-finite sphere radius");
+  for (const auto index : tree.sphereIndices_) {
+    checkFile(index < numSpheres, "sphere index out of range");
+  }
+  const auto numSpheresInt = static_cast<int64_t>(numSpheres);
+  for (size_t i = 0; i < tree.nodes_.size(); i++) {
+    const auto& node = tree.nodes_[i];
+    checkFile(node.center.allFinite() && std::isfinite(node.radius) && node.radius >= 0.0, "negative or non-finite node radius");
+    checkFile(node.firstSphere >= 0 && node.numSpheres > 0 && node.firstSphere + int64_t(node.numSpheres) <= numSpheresInt,
+              "node spheres out of range");
+    if (!node.isLeaf()) {
+      // Children are stored after their parent, which also excludes cycles
+      const auto isChild = [&](int child) { return child > static_cast<int64_t>(i) && child < static_cast<int64_t>(tree.nodes_.size()); };
+      checkFile(isChild(node.leftChild) && isChild(node.rightChild), "child node out of range");
+    }
+  }
+
+  tree.updateNodeCenters();
+  return tree;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereTree::updateNodeCenters() {
+  nodeCenters_.resize(3, nodes_.size());
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    nodeCenters_.col(i) = nodes_[i].center;
+  }
+}
+
+}  // namespace ocs2
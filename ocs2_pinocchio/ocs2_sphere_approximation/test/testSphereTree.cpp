@@ -0,0 +1,251 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+
+#include <ocs2_pinocchio_interface/urdf.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_self_collision/PinocchioGeometryInterface.h>
+#include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
+#include <ocs2_sphere_approximation/SphereDistance.h>
+#include <ocs2_sphere_approximation/SphereTree.h>
+
+using namespace ocs2;
+using vector3_t = SphereTree::vector3_t;
+
+namespace {
+
+struct RandomSpheres {
+  std::vector<vector3_t> centers;
+  scalar_array_t radii;
+};
+
+RandomSpheres getRandomSpheres(size_t numSpheres, std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> positionDistribution(-0.5, 0.5);
+  std::uniform_real_distribution<scalar_t> radiusDistribution(0.01, 0.05);
+  RandomSpheres spheres;
+  for (size_t i = 0; i < numSpheres; i++) {
+    spheres.centers.emplace_back(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+    spheres.radii.push_back(radiusDistribution(generator));
+  }
+  return spheres;
+}
+
+SphereTree::Pose getRandomPose(std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> positionDistribution(-1.0, 1.0);
+  std::uniform_real_distribution<scalar_t> quaternionDistribution(-1.0, 1.0);
+  const Eigen::Quaternion<scalar_t> q(quaternionDistribution(generator), quaternionDistribution(generator),
+                                      quaternionDistribution(generator), quaternionDistribution(generator));
+  return {q.normalized().toRotationMatrix(),
+          vector3_t(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator))};
+}
+
+/** Euclidean signed distance to the union of a ground plane and a spherical obstacle */
+vector_t sdf(const batch_array_t<scalar_t, 3>& positions) {
+  const vector3_t obstacleCenter(0.3, 0.2, 0.1);
+  const scalar_t obstacleRadius = 0.2;
+  const scalar_t groundHeight = -0.4;
+  const auto obstacleDistance = ((positions.row(0) - obstacleCenter.x()).square() + (positions.row(1) - obstacleCenter.y()).square() +
+                                 (positions.row(2) - obstacleCenter.z()).square())
+                                    .sqrt() -
+                                obstacleRadius;
+  return obstacleDistance.min(positions.row(2) - groundHeight).matrix().transpose();
+}
+
+batch_array_t<scalar_t, 3> toBatch(const std::vector<vector3_t>& positions) {
+  batch_array_t<scalar_t, 3> batch(3, positions.size());
+  for (size_t i = 0; i < positions.size(); i++) {
+    batch.col(i) = positions[i];
+  }
+  return batch;
+}
+
+}  // namespace
+
+TEST(TestSphereTree, construction) {
+  std::mt19937 generator(0);
+  const auto spheres = getRandomSpheres(100, generator);
+  const SphereTree tree(spheres.centers, spheres.radii, 4);
+
+  // Every node encloses its spheres, and the spheres are a permutation of the input
+  for (const auto& node : tree.getNodes()) {
+    if (!node.isLeaf()) {
+      const auto& nodes = tree.getNodes();
+      ASSERT_EQ(node.numSpheres, nodes[node.leftChild].numSpheres + nodes[node.rightChild].numSpheres);
+    }
+    ASSERT_TRUE(!node.isLeaf() || node.numSpheres <= 4);
+    for (int i = node.firstSphere; i < node.firstSphere + node.numSpheres; i++) {
+      const vector3_t center = tree.getSphereCenters().col(i);
+      ASSERT_LE((center - node.center).norm() + tree.getSphereRadii()[i], node.radius + 1e-12);
+    }
+  }
+  for (size_t i = 0; i < tree.getNumSpheres(); i++) {
+    const size_t index = tree.getSphereIndices()[i];
+    ASSERT_TRUE(spheres.centers[index].isApprox(tree.getSphereCenters().col(i).matrix()));
+    ASSERT_DOUBLE_EQ(spheres.radii[index], tree.getSphereRadii()[i]);
+  }
+}
+
+TEST(TestSphereTree, saveAndLoad) {
+  std::mt19937 generator(1);
+  const auto spheres = getRandomSpheres(50, generator);
+  const SphereTree tree(spheres.centers, spheres.radii);
+  const std::string filePath = "/tmp/ocs2_test_sphere_tree.bin";
+  tree.save(filePath);
+  const SphereTree loadedTree = SphereTree::load(filePath);
+  std::remove(filePath.c_str());
+
+  ASSERT_EQ(loadedTree.getNodes().size(), tree.getNodes().size());
+  for (size_t i = 0; i < tree.getNodes().size(); i++) {
+    ASSERT_TRUE(loadedTree.getNodes()[i].center.isApprox(tree.getNodes()[i].center));
+    ASSERT_EQ(loadedTree.getNodes()[i].leftChild, tree.getNodes()[i].leftChild);
+  }
+  ASSERT_TRUE(loadedTree.getSphereCenters().isApprox(tree.getSphereCenters()));
+  ASSERT_TRUE(loadedTree.getSphereRadii().isApprox(tree.getSphereRadii()));
+  ASSERT_EQ(loadedTree.getSphereIndices(), tree.getSphereIndices());
+  ASSERT_THROW(SphereTree::load("/tmp/ocs2_non_existing_sphere_tree.bin"), std::runtime_error);
+}
+
+TEST(TestSphereTree, loadInvalidFile) {
+  std::mt19937 generator(2);
+  const auto spheres = getRandomSpheres(20, generator);
+  const SphereTree tree(spheres.centers, spheres.radii);
+  const std::string filePath = "/tmp/ocs2_test_invalid_sphere_tree.bin";
+
+  // File layout: identifier and version, number of nodes, nodes, number of spheres, centers, radii, indices
+  constexpr std::streamoff numNodesOffset = sizeof("ocs2_sphere_tree") + sizeof(uint32_t);
+  constexpr std::streamoff nodeBytes = 4 * sizeof(scalar_t) + 4 * sizeof(int32_t);
+  const std::streamoff numSpheresOffset = numNodesOffset + sizeof(uint64_t) + tree.getNodes().size() * nodeBytes;
+  const std::streamoff radiiOffset = numSpheresOffset + sizeof(uint64_t) + 3 * tree.getNumSpheres() * sizeof(scalar_t);
+
+  const auto saveCorrupted = [&](std::streamoff offset, auto value) {
+    tree.save(filePath);
+    std::fstream stream(filePath, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekp(offset);
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  saveCorrupted(numNodesOffset, std::numeric_limits<uint64_t>::max());
+  EXPECT_THROW(SphereTree::load(filePath), std::runtime_error);
+  saveCorrupted(numSpheresOffset, uint64_t(1) << 40);
+  EXPECT_THROW(SphereTree::load(filePath), std::runtime_error);
+  saveCorrupted(radiiOffset, scalar_t(-0.1));
+  EXPECT_THROW(SphereTree::load(filePath), std::runtime_error);
+  saveCorrupted(numNodesOffset + sizeof(uint64_t) + 3 * sizeof(scalar_t), scalar_t(-0.1));  // root radius
+  EXPECT_THROW(SphereTree::load(filePath), std::runtime_error);
+  saveCorrupted(numNodesOffset + sizeof(uint64_t) + 4 * sizeof(scalar_t) + 2 * sizeof(int32_t), int32_t(0));  // root as its own child
+  EXPECT_THROW(SphereTree::load(filePath), std::runtime_error);
+  std::remove(filePath.c_str());
+}
+
+TEST(TestSphereTree, minimumDistanceEqualToBruteForce) {
+  std::mt19937 generator(2);
+  for (size_t numSpheres : {1, 10, 100, 300}) {
+    const auto spheresA = getRandomSpheres(numSpheres, generator);
+    const auto spheresB = getRandomSpheres(2 * numSpheres, generator);
+    const SphereTree treeA(spheresA.centers, spheresA.radii);
+    const SphereTree treeB(spheresB.centers, spheresB.radii);
+
+    for (int k = 0; k < 20; k++) {
+      const auto poseA = getRandomPose(generator);
+      const auto poseB = getRandomPose(generator);
+      const auto centersA = sphere_distance::transformPositions(poseA, toBatch(spheresA.centers));
+      const auto centersB = sphere_distance::transformPositions(poseB, toBatch(spheresB.centers));
+      const vector_t radiiA = Eigen::Map<const vector_t>(spheresA.radii.data(), numSpheres);
+      const vector_t radiiB = Eigen::Map<const vector_t>(spheresB.radii.data(), 2 * numSpheres);
+
+      // Sphere - sphere
+      Eigen::Index i, j;
+      const scalar_t expectedDistance = sphere_distance::computeSphereSphereDistances(centersA, radiiA, centersB, radiiB).minCoeff(&i, &j);
+      const auto result = sphere_distance::computeMinimumDistance(treeA, poseA, treeB, poseB);
+      ASSERT_NEAR(result.distance, expectedDistance, 1e-12);
+      ASSERT_EQ(result.sphereIndexA, i);
+      ASSERT_EQ(result.sphereIndexB, j);
+
+      // Sphere - SDF
+      const scalar_t expectedSdfDistance = sphere_distance::computeSphereSdfDistances(centersA, radiiA, sdf).minCoeff(&i);
+      const auto sdfResult = sphere_distance::computeMinimumSdfDistance(treeA, poseA, sdf);
+      ASSERT_NEAR(sdfResult.distance, expectedSdfDistance, 1e-12);
+      ASSERT_EQ(sdfResult.sphereIndexA, i);
+    }
+  }
+}
+
+TEST(TestSphereTree, accuracyAgainstMeshDistance) {
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+  const PinocchioInterface pinocchioInterface = getPinocchioInterfaceFromUrdfFile(urdfFile);
+  const std::vector<std::string> collisionLinks{"ARM", "SHOULDER", "FOREARM", "WRIST_1"};
+  const std::vector<scalar_t> maxExcesses{0.02, 0.02, 0.02, 0.02};
+  const PinocchioSphereInterface sphereInterface(pinocchioInterface, collisionLinks, maxExcesses, 0.7);
+
+  // Non-adjacent link pairs
+  const std::vector<std::pair<size_t, size_t>> linkPairs{{0, 2}, {0, 3}, {1, 3}};
+  std::vector<PinocchioGeometryInterface> geometryInterfaces;
+  for (const auto& linkPair : linkPairs) {
+    geometryInterfaces.emplace_back(pinocchioInterface, std::vector<std::pair<std::string, std::string>>{
+                                                            {collisionLinks[linkPair.first], collisionLinks[linkPair.second]}});
+  }
+
+  PinocchioInterface pinocchioInterfaceCopy = pinocchioInterface;
+  const auto& model = pinocchioInterfaceCopy.getModel();
+  auto& data = pinocchioInterfaceCopy.getData();
+
+  for (int k = 0; k < 100; k++) {
+    const vector_t q = M_PI * vector_t::Random(model.nq);
+    pinocchio::forwardKinematics(model, data, q);
+
+    for (size_t p = 0; p < linkPairs.size(); p++) {
+      scalar_t meshDistance = std::numeric_limits<scalar_t>::max();
+      for (const auto& result : geometryInterfaces[p].computeDistances(pinocchioInterfaceCopy)) {
+        meshDistance = std::min(meshDistance, result.min_distance);
+      }
+
+      const auto poses = sphereInterface.computeSphereTreePosesInWorldFrame(pinocchioInterfaceCopy);
+      const auto& trees = sphereInterface.getSphereTrees();
+      const size_t a = linkPairs[p].first;
+      const size_t b = linkPairs[p].second;
+      const scalar_t sphereDistance = sphere_distance::computeMinimumDistance(trees[a], poses[a], trees[b], poses[b]).distance;
+
+      // The spheres enclose the primitives with at most maxExcess, so the sphere distance is a bounded underestimate.
+      if (meshDistance > 0.0) {
+        EXPECT_LE(sphereDistance, meshDistance + 1e-6);
+        EXPECT_GE(sphereDistance, meshDistance - maxExcesses[a] - maxExcesses[b] - 1e-6);
+      }
+    }
+  }
+}
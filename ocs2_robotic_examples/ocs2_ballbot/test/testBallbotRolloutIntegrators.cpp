@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+
+using namespace ocs2;
+
+TEST(Ballbot, RolloutIntegrators) {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  ballbot::BallbotInterface interface(taskFile, libFolder);
+  const auto& dynamics = *interface.getOptimalControlProblem().dynamicsPtr;
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 5.0;
+  const vector_t initState = interface.getInitialState();
+  const scalar_array_t controllerTimes{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Zero(ballbot::INPUT_DIM));
+  const matrix_array_t k(2, -0.1 * matrix_t::Ones(ballbot::INPUT_DIM, ballbot::STATE_DIM));
+  LinearController controller(controllerTimes, uff, k);
+
+  auto settings = rollout::loadSettings(taskFile, "rollout", false);
+  vector_t referenceFinalState;
+  for (const auto integratorType : {IntegratorType::RK4, IntegratorType::RK4_OCS2}) {
+    settings.integratorType = integratorType;
+    TimeTriggeredRollout rollout(dynamics, settings);
+
+    ModeSchedule modeSchedule;
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    const vector_t finalState = rollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                                            stateTrajectory, inputTrajectory);
+
+    if (integratorType == IntegratorType::RK4) {
+      referenceFinalState = finalState;
+    } else {
+      EXPECT_TRUE(finalState.isApprox(referenceFinalState, 1e-9));
+    }
+  }
+}
+
+TEST(Ballbot, BatchRollout) {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  ballbot::BallbotInterface interface(taskFile, libFolder);
+  const auto& dynamics = *interface.getOptimalControlProblem().dynamicsPtr;
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 5.0;
+  const scalar_array_t controllerTimes{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Zero(ballbot::INPUT_DIM));
+  const matrix_array_t k(2, -0.1 * matrix_t::Ones(ballbot::INPUT_DIM, ballbot::STATE_DIM));
+  LinearController controller(controllerTimes, uff, k);
+  ModeSchedule modeSchedule;
+
+  // perturbed initial states
+  constexpr size_t batchSize = 10;
+  vector_array_t initStates(batchSize, interface.getInitialState());
+  for (auto& x : initStates) {
+    x += 0.05 * vector_t::Random(ballbot::STATE_DIM);
+  }
+
+  auto settings = rollout::loadSettings(taskFile, "rollout", false);
+  settings.integratorType = IntegratorType::RK4_OCS2;
+
+  TimeTriggeredRollout rollout(dynamics, settings);
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  for (const auto& x : initStates) {
+    rollout.run(initTime, x, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+  }
+
+  for (size_t numThreads : {1, 4}) {
+    BatchRollout batchRollout(dynamics, settings, numThreads);
+    BatchRolloutTrajectories trajectories;
+    batchRollout.runBatch(initTime, initStates, finalTime, controller, modeSchedule, trajectories);
+    EXPECT_TRUE(trajectories.getStateTrajectory(batchSize - 1).back().isApprox(stateTrajectory.back(), 1e-9));
+  }
+}
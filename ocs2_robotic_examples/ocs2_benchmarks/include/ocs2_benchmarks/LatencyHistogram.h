@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace benchmark {
+
+/** Summary of a latency distribution. All values are in milliseconds. */
+struct LatencyStatistics {
+  size_t count = 0;
+  scalar_t mean = 0.0;
+  scalar_t median = 0.0;
+  scalar_t percentile90 = 0.0;
+  scalar_t percentile99 = 0.0;
+  scalar_t max = 0.0;
+};
+
+/**
+ * Collects all latency samples of a measurement such that the full distribution, and not only the average, can be reported.
+ */
+class LatencyHistogram {
+ public:
+  /** Adds a sample in milliseconds. */
+  void addSample(scalar_t latency) { samples_.push_back(latency); }
+
+  /** Removes all samples. */
+  void clear() { samples_.clear(); }
+
+  /** Gets the number of samples. */
+  size_t size() const { return samples_.size(); }
+
+  /** Gets the recorded samples in the order they were added. */
+  const scalar_array_t& getSamples() const { return samples_; }
+
+  /**
+   * Gets the nearest-rank percentile of the samples.
+   * @param [in] percentile: in the range [0, 100].
+   * @return latency in milliseconds, zero if there are no samples.
+   */
+  scalar_t getPercentile(scalar_t percentile) const;
+
+  /** Gets the count, mean, median, 90th and 99th percentile and the maximum of the samples. */
+  LatencyStatistics getStatistics() const;
+
+ private:
+  scalar_array_t samples_;
+};
+
+}  // namespace benchmark
+}  // namespace ocs2
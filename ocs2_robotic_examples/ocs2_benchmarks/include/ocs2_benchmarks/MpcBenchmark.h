@@ -0,0 +1,133 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/SystemObservation.h>
+
+#include "ocs2_benchmarks/LatencyHistogram.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+/** The solvers that an MPC benchmark can be run with. */
+enum class MpcSolver { DDP, SQP, IPM };
+
+/** Gets the name of the solver. */
+std::string toString(MpcSolver solver);
+
+/** Gets the solver from its name. Throws if the name is unknown. */
+MpcSolver fromString(const std::string& name);
+
+/**
+ * A segment of the scripted benchmark scenario. The target trajectories of the phase are set at its start.
+ */
+struct MpcBenchmarkPhase {
+  std::string name;
+  scalar_t duration;
+  /** Gets the target trajectories of the phase given the observation at the start of the phase. */
+  std::function<TargetTrajectories(const SystemObservation&)> getTargetTrajectories;
+};
+
+/**
+ * A robotic example prepared for the MPC benchmark. The robot interface is owned by the getMpc function such that all MPC instances
+ * created by it share the same problem definition.
+ */
+struct MpcBenchmarkProblem {
+  std::string name;
+  SystemObservation initialObservation;
+  TargetTrajectories initialTargetTrajectories;
+  /** Period between two observations, i.e. the inverse of the MPC frequency. */
+  scalar_t timeStep;
+  std::vector<MpcBenchmarkPhase> phases;
+  /** Creates an MPC with the problem and reference manager of the example. Returns nullptr if the solver is not supported. */
+  std::function<std::unique_ptr<MPC_BASE>(MpcSolver)> getMpc;
+};
+
+/** The latency distribution of one operation during one phase of the scenario. */
+struct MpcBenchmarkMeasurement {
+  std::string phase;
+  std::string operation;
+  LatencyStatistics statistics;
+};
+
+/** The measurements of one problem and solver combination. */
+struct MpcBenchmarkResult {
+  std::string problem;
+  MpcSolver solver;
+  std::vector<MpcBenchmarkMeasurement> measurements;
+};
+
+/**
+ * Runs the scripted scenario of the problem through the MPC_MRT_Interface. The observations are generated by evaluating the policy at
+ * the next sampling time, such that the benchmark is deterministic and runs headless. Per phase, the latency of advanceMpc() and
+ * updatePolicy() are recorded. The first MPC iteration is a cold start and recorded as its own phase, "firstSolve".
+ *
+ * @param [in] problem: The benchmark problem.
+ * @param [in] solver: The solver to use.
+ * @return The latency statistics per phase and operation.
+ */
+MpcBenchmarkResult runMpcBenchmark(const MpcBenchmarkProblem& problem, MpcSolver solver);
+
+/**
+ * Writes the results as CSV with one row per problem, solver, phase and operation. Latencies are in milliseconds.
+ * Columns: problem,solver,phase,operation,count,mean,p50,p90,p99,max
+ */
+void writeResults(std::ostream& stream, const std::vector<MpcBenchmarkResult>& results);
+
+/** Writes the results as CSV to a file. Throws if the file can not be opened. */
+void writeResults(const std::string& filePath, const std::vector<MpcBenchmarkResult>& results);
+
+/** Loads results that were written with writeResults. Throws if the file can not be opened or a row is malformed. */
+std::vector<MpcBenchmarkResult> loadResults(const std::string& filePath);
+
+/**
+ * Compares the results against a baseline, e.g. of a previous commit, and prints the relative change of the median and the 99th
+ * percentile of each measurement.
+ *
+ * @param [in] baseline: The reference results.
+ * @param [in] results: The new results.
+ * @param [in] tolerance: Allowed relative increase of the median and the 99th percentile.
+ * @param [out] stream: The report.
+ * @return false if a measurement of the baseline regressed by more than the tolerance or is missing in the new results.
+ */
+bool compareResults(const std::vector<MpcBenchmarkResult>& baseline, const std::vector<MpcBenchmarkResult>& results, scalar_t tolerance,
+                    std::ostream& stream);
+
+}  // namespace benchmark
+}  // namespace ocs2
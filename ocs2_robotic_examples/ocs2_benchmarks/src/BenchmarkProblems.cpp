@@ -0,0 +1,346 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <ocs2_ddp/DDP_Settings.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_ipm/IpmMpc.h>
+#include <ocs2_ipm/IpmSettings.h>
+#include <ocs2_mpc/MPC_Settings.h>
+#include <ocs2_sqp/SqpMpc.h>
+#include <ocs2_sqp/SqpSettings.h>
+
+#include <ocs2_robotic_assets/package_path.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+#include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_cartpole/package_path.h>
+#include <ocs2_double_integrator/DoubleIntegratorInterface.h>
+#include <ocs2_double_integrator/package_path.h>
+#include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_legged_robot/gait/MotionPhaseDefinition.h>
+#include <ocs2_legged_robot/package_path.h>
+#include <ocs2_mobile_manipulator/MobileManipulatorInterface.h>
+#include <ocs2_mobile_manipulator/package_path.h>
+#include <ocs2_quadrotor/QuadrotorInterface.h>
+#include <ocs2_quadrotor/package_path.h>
+
+#include <ocs2_anymal_mpc/AnymalInterface.h>
+#include <ocs2_quadruped_interface/QuadrupedMpc.h>
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+
+constexpr scalar_t initTime = 0.0;
+
+struct SolverSettings {
+  mpc::Settings mpcSettings;
+  ddp::Settings ddpSettings;
+  sqp::Settings sqpSettings;
+  ipm::Settings ipmSettings;
+};
+
+/** Loads the settings of all solvers from the task file, fields that are not present keep their default. Printing is disabled. */
+SolverSettings loadSolverSettings(const std::string& taskFile) {
+  SolverSettings settings;
+  settings.mpcSettings = mpc::loadSettings(taskFile, "mpc", false);
+  settings.ddpSettings = ddp::loadSettings(taskFile, "ddp", false);
+  settings.sqpSettings = sqp::loadSettings(taskFile, "sqp", false);
+  settings.ipmSettings = ipm::loadSettings(taskFile, "ipm", false);
+  return settings;
+}
+
+void disablePrinting(SolverSettings& settings) {
+  settings.mpcSettings.debugPrint_ = false;
+  settings.ddpSettings.displayInfo_ = false;
+  settings.ddpSettings.displayShortSummary_ = false;
+  settings.sqpSettings.printSolverStatus = false;
+  settings.sqpSettings.printSolverStatistics = false;
+  settings.sqpSettings.printLinesearch = false;
+  settings.ipmSettings.printSolverStatus = false;
+  settings.ipmSettings.printSolverStatistics = false;
+  settings.ipmSettings.printLinesearch = false;
+}
+
+/** Creates the MPC of a robotic example. The interface is captured such that it lives as long as the factory. */
+template <typename Interface>
+std::function<std::unique_ptr<MPC_BASE>(MpcSolver)> getMpcFactory(std::shared_ptr<Interface> interfacePtr, SolverSettings settings) {
+  disablePrinting(settings);
+  return [interfacePtr, settings](MpcSolver solver) {
+    const auto& interface = *interfacePtr;
+    std::unique_ptr<MPC_BASE> mpcPtr;
+    switch (solver) {
+      case MpcSolver::DDP:
+        mpcPtr.reset(new GaussNewtonDDP_MPC(settings.mpcSettings, settings.ddpSettings, interface.getRollout(),
+                                            interface.getOptimalControlProblem(), interface.getInitializer()));
+        break;
+      case MpcSolver::SQP:
+        mpcPtr.reset(
+            new SqpMpc(settings.mpcSettings, settings.sqpSettings, interface.getOptimalControlProblem(), interface.getInitializer()));
+        break;
+      case MpcSolver::IPM:
+        mpcPtr.reset(
+            new IpmMpc(settings.mpcSettings, settings.ipmSettings, interface.getOptimalControlProblem(), interface.getInitializer()));
+        break;
+    }
+    mpcPtr->getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+    return mpcPtr;
+  };
+}
+
+/** Default scenario: track the initial target, step the target, and return to the initial target. */
+MpcBenchmarkProblem getProblem(std::string name, const vector_t& initialState, size_t inputDim, size_t initialMode,
+                               const vector_t& initialTargetState, const vector_t& stepTargetState, const mpc::Settings& mpcSettings) {
+  auto constantTarget = [](TargetTrajectories targetTrajectories) {
+    return [targetTrajectories](const SystemObservation&) { return targetTrajectories; };
+  };
+
+  MpcBenchmarkProblem problem;
+  problem.name = std::move(name);
+  problem.initialObservation.time = initTime;
+  problem.initialObservation.state = initialState;
+  problem.initialObservation.input = vector_t::Zero(inputDim);
+  problem.initialObservation.mode = initialMode;
+  problem.initialTargetTrajectories = TargetTrajectories({initTime}, {initialTargetState}, {vector_t::Zero(inputDim)});
+  problem.timeStep = (mpcSettings.mpcDesiredFrequency_ > 0.0) ? 1.0 / mpcSettings.mpcDesiredFrequency_ : 0.01;
+
+  const TargetTrajectories stepTargetTrajectories({initTime}, {stepTargetState}, {vector_t::Zero(inputDim)});
+  problem.phases.push_back({"tracking", 1.0, nullptr});
+  problem.phases.push_back({"targetChange", 2.0, constantTarget(stepTargetTrajectories)});
+  problem.phases.push_back({"targetReturn", 2.0, constantTarget(problem.initialTargetTrajectories)});
+  return problem;
+}
+
+MpcBenchmarkProblem getDoubleIntegratorProblem() {
+  const std::string taskFile = double_integrator::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = double_integrator::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<double_integrator::DoubleIntegratorInterface>(taskFile, libFolder, false);
+  const auto settings = loadSolverSettings(taskFile);
+
+  const vector_t& target = interfacePtr->getInitialTarget();
+  vector_t stepTarget = target;
+  stepTarget(0) += 1.0;
+  auto problem = getProblem("double_integrator", interfacePtr->getInitialState(), double_integrator::INPUT_DIM, 0, target, stepTarget,
+                            settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getCartPoleProblem() {
+  const std::string taskFile = cartpole::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = cartpole::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<cartpole::CartPoleInterface>(taskFile, libFolder, false);
+  const auto settings = loadSolverSettings(taskFile);
+
+  // The cart moves while the pole is kept upright.
+  const vector_t& target = interfacePtr->getInitialTarget();
+  vector_t stepTarget = target;
+  stepTarget(1) += 0.5;
+  auto problem =
+      getProblem("cartpole", interfacePtr->getInitialState(), cartpole::INPUT_DIM, 0, target, stepTarget, settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getBallbotProblem() {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<ballbot::BallbotInterface>(taskFile, libFolder);
+  const auto settings = loadSolverSettings(taskFile);
+
+  const vector_t& initialState = interfacePtr->getInitialState();
+  vector_t stepTarget = initialState;
+  stepTarget(0) += 1.0;
+  auto problem = getProblem("ballbot", initialState, ballbot::INPUT_DIM, 0, initialState, stepTarget, settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getQuadrotorProblem() {
+  const std::string taskFile = quadrotor::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = quadrotor::getPath() + "/auto_generated";
+  auto interfacePtr = std::make_shared<quadrotor::QuadrotorInterface>(taskFile, libFolder);
+  const auto settings = loadSolverSettings(taskFile);
+
+  const vector_t& initialState = interfacePtr->getInitialState();
+  vector_t stepTarget = initialState;
+  stepTarget(0) += 1.0;
+  stepTarget(2) += 1.0;
+  auto problem = getProblem("quadrotor", initialState, quadrotor::INPUT_DIM, 0, initialState, stepTarget, settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getLeggedRobotProblem() {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  auto interfacePtr = std::make_shared<legged_robot::LeggedRobotInterface>(taskFile, urdfFile, referenceFile);
+  const auto settings = loadSolverSettings(taskFile);
+
+  // The base moves forward. The base position follows the centroidal momentum in the centroidal state.
+  const vector_t& initialState = interfacePtr->getInitialState();
+  vector_t stepTarget = initialState;
+  stepTarget(6) += 0.3;
+  auto problem = getProblem("legged_robot", initialState, interfacePtr->getCentroidalModelInfo().inputDim, legged_robot::ModeNumber::STANCE,
+                            initialState, stepTarget, settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getMobileManipulatorProblem(const std::string& robotName) {
+  struct MobileManipulatorVariant {
+    std::string taskFile;
+    std::string libFolder;
+    std::string urdfFile;
+    Eigen::Vector3d goalPosition;
+  };
+  const std::vector<std::pair<std::string, MobileManipulatorVariant>> variants{
+      {"franka", {"franka/task.info", "franka", "franka/urdf/panda.urdf", {0.4, 0.1, 0.5}}},
+      {"kinova_j2n6", {"kinova/task_j2n6.info", "kinova/j2n6", "kinova/urdf/j2n6s300.urdf", {0.2, 0.2, 0.6}}},
+      {"kinova_j2n7", {"kinova/task_j2n7.info", "kinova/j2n7", "kinova/urdf/j2n7s300.urdf", {0.2, 0.2, 0.6}}},
+      {"mabi_mobile", {"mabi_mobile/task.info", "mabi_mobile", "mabi_mobile/urdf/mabi_mobile.urdf", {-0.5, -0.8, 0.6}}},
+      {"pr2", {"pr2/task.info", "pr2", "pr2/urdf/pr2.urdf", {-0.5, -0.8, 0.6}}},
+      {"ridgeback_ur5", {"ridgeback_ur5/task.info", "ridgeback_ur5", "ridgeback_ur5/urdf/ridgeback_ur5.urdf", {-0.5, -0.8, 0.6}}},
+  };
+  const auto it = std::find_if(variants.begin(), variants.end(), [&](const auto& v) { return v.first == robotName; });
+  if (it == variants.end()) {
+    throw std::runtime_error("[getMobileManipulatorProblem] Unknown robot: " + robotName);
+  }
+  const auto& variant = it->second;
+
+  const std::string taskFile = mobile_manipulator::getPath() + "/config/" + variant.taskFile;
+  const std::string libFolder = mobile_manipulator::getPath() + "/auto_generated/" + variant.libFolder;
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/" + variant.urdfFile;
+  auto interfacePtr = std::make_shared<mobile_manipulator::MobileManipulatorInterface>(taskFile, libFolder, urdfFile);
+  const auto settings = loadSolverSettings(taskFile);
+
+  // The target is the end-effector pose: position and quaternion coefficients.
+  const Eigen::Vector4d goalOrientation = Eigen::Quaterniond(0.33, 0.0, 0.0, 0.95).normalized().coeffs();
+  const vector_t target = (vector_t(7) << variant.goalPosition, goalOrientation).finished();
+  vector_t stepTarget = target;
+  stepTarget.head<3>() += Eigen::Vector3d(0.1, -0.1, 0.1);
+  auto problem = getProblem("mobile_manipulator_" + robotName, interfacePtr->getInitialState(),
+                            interfacePtr->getManipulatorModelInfo().inputDim, 0, target, stepTarget, settings.mpcSettings);
+  problem.getMpc = getMpcFactory(std::move(interfacePtr), settings);
+  return problem;
+}
+
+MpcBenchmarkProblem getAnymalProblem() {
+  const std::string configName = "c_series";
+  std::shared_ptr<switched_model::QuadrupedInterface> interfacePtr =
+      anymal::getAnymalInterface(anymal::getUrdfString(anymal::AnymalModel::Camel), anymal::getConfigFolder(configName));
+
+  // The multiple shooting solvers share their settings file.
+  auto settings = loadSolverSettings(anymal::getTaskFilePath(configName));
+  const std::string multipleShootingFile = anymal::getConfigFolder(configName) + "/multiple_shooting.info";
+  settings.sqpSettings = sqp::loadSettings(multipleShootingFile, "multiple_shooting", false);
+  settings.ipmSettings = ipm::loadSettings(multipleShootingFile, "multiple_shooting", false);
+  disablePrinting(settings);
+
+  // The base moves forward, the base position follows the base orientation in the state.
+  const vector_t initialState = interfacePtr->getInitialState();
+  vector_t stepTarget = initialState;
+  stepTarget(3) += 0.3;
+  auto problem = getProblem("anymal_c", initialState, switched_model::INPUT_DIM, switched_model::ModeNumber::STANCE, initialState,
+                            stepTarget, settings.mpcSettings);
+
+  // The quadruped problem requires its synchronized modules, which are set by the quadruped MPC factories.
+  problem.getMpc = [interfacePtr, settings](MpcSolver solver) {
+    switch (solver) {
+      case MpcSolver::DDP:
+        return switched_model::getDdpMpc(*interfacePtr, settings.mpcSettings, settings.ddpSettings);
+      case MpcSolver::SQP:
+        return switched_model::getSqpMpc(*interfacePtr, settings.mpcSettings, settings.sqpSettings);
+      case MpcSolver::IPM: {
+        std::unique_ptr<MPC_BASE> mpcPtr(new IpmMpc(settings.mpcSettings, settings.ipmSettings, interfacePtr->getOptimalControlProblem(),
+                                                    interfacePtr->getInitializer()));
+        mpcPtr->getSolverPtr()->setReferenceManager(interfacePtr->getReferenceManagerPtr());
+        mpcPtr->getSolverPtr()->setSynchronizedModules(interfacePtr->getSynchronizedModules());
+        return mpcPtr;
+      }
+    }
+    return std::unique_ptr<MPC_BASE>();
+  };
+  return problem;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::string> getBenchmarkProblemNames() {
+  return {"double_integrator",
+          "cartpole",
+          "ballbot",
+          "quadrotor",
+          "legged_robot",
+          "mobile_manipulator_franka",
+          "mobile_manipulator_kinova_j2n6",
+          "mobile_manipulator_kinova_j2n7",
+          "mobile_manipulator_mabi_mobile",
+          "mobile_manipulator_pr2",
+          "mobile_manipulator_ridgeback_ur5",
+          "anymal_c"};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcBenchmarkProblem getBenchmarkProblem(const std::string& name) {
+  const std::string mobileManipulatorPrefix = "mobile_manipulator_";
+  if (name == "double_integrator") {
+    return getDoubleIntegratorProblem();
+  } else if (name == "cartpole") {
+    return getCartPoleProblem();
+  } else if (name == "ballbot") {
+    return getBallbotProblem();
+  } else if (name == "quadrotor") {
+    return getQuadrotorProblem();
+  } else if (name == "legged_robot") {
+    return getLeggedRobotProblem();
+  } else if (name.compare(0, mobileManipulatorPrefix.size(), mobileManipulatorPrefix) == 0) {
+    return getMobileManipulatorProblem(name.substr(mobileManipulatorPrefix.size()));
+  } else if (name == "anymal_c") {
+    return getAnymalProblem();
+  } else {
+    throw std::runtime_error("[getBenchmarkProblem] Unknown problem: " + name);
+  }
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
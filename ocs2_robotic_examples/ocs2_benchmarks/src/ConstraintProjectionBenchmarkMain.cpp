@@ -0,0 +1,162 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_oc/multiple_shooting/StructuredConstraintProjection.h>
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t numLegs = 4;
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 6 * numLegs;  // contact forces and joint velocities
+
+/**
+ * Constraints with the structure of a legged robot: zero contact forces and the vertical foot velocity for swing legs, zero foot velocity
+ * for stance legs. The foot velocities depend on the base velocity in the state and on the joint velocities of the leg.
+ */
+VectorFunctionLinearApproximation getLeggedConstraints(size_t mode) {
+  size_t numConstraints = 0;
+  for (size_t leg = 0; leg < numLegs; ++leg) {
+    const bool inContact = (mode >> leg) & 1;
+    numConstraints += inContact ? 3 : 4;
+  }
+
+  VectorFunctionLinearApproximation constraint = VectorFunctionLinearApproximation::Zero(numConstraints, stateDim, inputDim);
+  size_t row = 0;
+  for (size_t leg = 0; leg < numLegs; ++leg) {
+    const bool inContact = (mode >> leg) & 1;
+    const size_t forceIndex = 3 * leg;
+    const size_t jointIndex = 3 * numLegs + 3 * leg;
+    if (!inContact) {
+      constraint.dfdu.block<3, 3>(row, forceIndex).setIdentity();
+      row += 3;
+    }
+    const size_t numVelocityRows = inContact ? 3 : 1;
+    constraint.dfdx.middleRows(row, numVelocityRows).setRandom();
+    constraint.dfdu.block(row, jointIndex, numVelocityRows, 3) =
+        matrix_t::Identity(3, 3).bottomRows(numVelocityRows) + 0.3 * matrix_t::Random(numVelocityRows, 3);
+    constraint.f.segment(row, numVelocityRows).setRandom();
+    row += numVelocityRows;
+  }
+  return constraint;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_constraint_projection_benchmark [options]\n"
+            << "  --numNodes <n>     number of nodes of the horizon (default: 100)\n"
+            << "  --numRepeats <n>   number of repetitions (default: 50)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the projection of the state-input equality constraints of a horizon with legged robot constraints: dense LU, dense QR (with
+ * the pseudo-inverse), and multiple_shooting::StructuredConstraintProjection with and without the pseudo-inverse. The mode changes
+ * every 10 nodes. The mean time per horizon is printed.
+ */
+int main(int argc, char* argv[]) {
+  int numNodes = 100;
+  int numRepeats = 50;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numNodes") {
+      numNodes = std::max(std::stoi(value), 1);
+    } else if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  constexpr size_t numModes = 1 << numLegs;
+  std::vector<VectorFunctionLinearApproximation> constraints;
+  std::vector<size_t> modes;
+  for (int i = 0; i < numNodes; ++i) {
+    modes.push_back((i / 10) % numModes);
+    constraints.push_back(getLeggedConstraints(modes.back()));
+  }
+
+  benchmark::RepeatedTimer luTimer;
+  benchmark::RepeatedTimer qrTimer;
+  benchmark::RepeatedTimer structuredTimer;
+  benchmark::RepeatedTimer structuredPseudoInverseTimer;
+  multiple_shooting::StructuredConstraintProjection structuredProjection;
+  std::vector<VectorFunctionLinearApproximation> projections(numNodes);
+  std::vector<matrix_t> pseudoInverses(numNodes);
+
+  for (int k = 0; k < numRepeats; ++k) {
+    luTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      projections[i] = LinearAlgebra::luConstraintProjection(constraints[i]).first;
+    }
+    luTimer.endTimer();
+
+    qrTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      std::tie(projections[i], pseudoInverses[i]) = LinearAlgebra::qrConstraintProjection(constraints[i]);
+    }
+    qrTimer.endTimer();
+
+    structuredTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      structuredProjection.compute(constraints[i], modes[i], projections[i]);
+    }
+    structuredTimer.endTimer();
+
+    structuredPseudoInverseTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      structuredProjection.compute(constraints[i], modes[i], projections[i], &pseudoInverses[i]);
+    }
+    structuredPseudoInverseTimer.endTimer();
+  }
+
+  std::cout << "Projection of " << numNodes << " nodes with legged robot constraints:\n";
+  std::cout << "  LU:                               " << luTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  QR (with pseudo-inverse):         " << qrTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Structured:                       " << structuredTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Structured (with pseudo-inverse): " << structuredPseudoInverseTimer.getAverageInMilliseconds() << " [ms]\n";
+
+  return 0;
+}
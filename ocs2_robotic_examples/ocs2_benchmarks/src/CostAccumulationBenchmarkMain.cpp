@@ -0,0 +1,195 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/constraint/StateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/penalties/Penalties.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a legged robot
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 12;
+
+/** Quadratic cost that uses the default StateInputCost::accumulateQuadraticApproximation() */
+class SimpleQuadraticCost final : public StateInputCost {
+ public:
+  SimpleQuadraticCost(matrix_t Q, matrix_t R) : Q_(std::move(Q)), R_(std::move(R)) {}
+  SimpleQuadraticCost* clone() const override { return new SimpleQuadraticCost(*this); }
+
+  scalar_t getValue(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories&, const PreComputation&) const override {
+    return 0.5 * x.dot(Q_ * x) + 0.5 * u.dot(R_ * u);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const TargetTrajectories&, const PreComputation&) const override {
+    ScalarFunctionQuadraticApproximation quadraticApproximation;
+    quadraticApproximation.f = 0.5 * x.dot(Q_ * x) + 0.5 * u.dot(R_ * u);
+    quadraticApproximation.dfdx = Q_ * x;
+    quadraticApproximation.dfdu = R_ * u;
+    quadraticApproximation.dfdxx = Q_;
+    quadraticApproximation.dfduu = R_;
+    quadraticApproximation.dfdux.setZero(u.rows(), x.rows());
+    return quadraticApproximation;
+  }
+
+ private:
+  matrix_t Q_;
+  matrix_t R_;
+};
+
+class RandomLinearConstraint final : public StateInputConstraint {
+ public:
+  explicit RandomLinearConstraint(size_t numConstraints)
+      : StateInputConstraint(ConstraintOrder::Linear),
+        linearApproximation_(VectorFunctionLinearApproximation::Zero(numConstraints, stateDim, inputDim)) {
+    linearApproximation_.f.setRandom();
+    linearApproximation_.dfdx.setRandom();
+    linearApproximation_.dfdu.setRandom();
+  }
+  RandomLinearConstraint* clone() const override { return new RandomLinearConstraint(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return linearApproximation_.f.size(); }
+  vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation&) const override {
+    return linearApproximation_.f;
+  }
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const PreComputation&) const override {
+    return linearApproximation_;
+  }
+
+ private:
+  VectorFunctionLinearApproximation linearApproximation_;
+};
+
+/** Adds a quadratic cost, a soft constraint, a soft box constraint and a term with the default accumulation */
+void addCostTerms(StateInputCostCollection& costCollection) {
+  matrix_t Q = matrix_t::Random(stateDim, stateDim);
+  matrix_t R = matrix_t::Random(inputDim, inputDim);
+  const matrix_t P = matrix_t::Random(inputDim, stateDim);
+  Q = (Q + Q.transpose()).eval();
+  R = (R + R.transpose()).eval();
+
+  std::vector<StateInputSoftBoxConstraint::BoxConstraint> stateBoxConstraints(stateDim / 2);
+  for (size_t i = 0; i < stateBoxConstraints.size(); ++i) {
+    stateBoxConstraints[i].index = 2 * i;
+    stateBoxConstraints[i].lowerBound = -0.5;
+    stateBoxConstraints[i].upperBound = 0.5;
+    stateBoxConstraints[i].penaltyPtr.reset(new RelaxedBarrierPenalty({0.1, 0.1}));
+  }
+  std::vector<StateInputSoftBoxConstraint::BoxConstraint> inputBoxConstraints(1);
+  inputBoxConstraints[0].index = inputDim - 1;
+  inputBoxConstraints[0].lowerBound = -0.2;
+  inputBoxConstraints[0].penaltyPtr.reset(new RelaxedBarrierPenalty({0.1, 0.1}));
+
+  costCollection.add("quadratic", std::make_unique<QuadraticStateInputCost>(Q, R, P));
+  auto penaltyPtr = std::make_unique<RelaxedBarrierPenalty>(RelaxedBarrierPenalty::Config{1.0, 0.1});
+  costCollection.add("soft constraint",
+                     std::make_unique<StateInputSoftConstraint>(std::make_unique<RandomLinearConstraint>(6), std::move(penaltyPtr)));
+  costCollection.add("box constraint",
+                     std::make_unique<StateInputSoftBoxConstraint>(std::move(stateBoxConstraints), std::move(inputBoxConstraints)));
+  costCollection.add("default accumulate", std::make_unique<SimpleQuadraticCost>(Q, R));
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_cost_accumulation_benchmark [options]\n"
+            << "  --numRepeats <n>   number of repetitions (default: 10000)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the quadratic approximation of a cost collection accumulated in place by StateInputCostCollection with the sum of the
+ * approximations returned by the terms. The mean times are printed.
+ */
+int main(int argc, char* argv[]) {
+  int numRepeats = 10000;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  StateInputCostCollection costCollection;
+  addCostTerms(costCollection);
+  const std::vector<std::string> termNames = costCollection.getTermNames();
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  const TargetTrajectories targetTrajectories({t}, {vector_t::Random(stateDim)}, {vector_t::Random(inputDim)});
+  const PreComputation preComputation;
+
+  benchmark::RepeatedTimer sumTimer;
+  benchmark::RepeatedTimer accumulateTimer;
+  scalar_t sumCost = 0.0;
+  scalar_t accumulateCost = 0.0;
+  for (int k = 0; k < numRepeats; ++k) {
+    sumTimer.startTimer();
+    auto sum = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+    for (const auto& name : termNames) {
+      sum += costCollection.get(name).getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    }
+    sumCost += sum.f;
+    sumTimer.endTimer();
+
+    accumulateTimer.startTimer();
+    accumulateCost += costCollection.getQuadraticApproximation(t, x, u, targetTrajectories, preComputation).f;
+    accumulateTimer.endTimer();
+  }
+
+  std::cout << "Quadratic approximation of a cost collection with " << termNames.size() << " terms (nx = " << stateDim
+            << ", nu = " << inputDim << "):\n";
+  std::cout << "  Sum of term approximations: " << 1e3 * sumTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  Accumulate in place:        " << 1e3 * accumulateTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  Total cost (sum, accumulate): (" << sumCost << ", " << accumulateCost << ")\n";
+
+  return 0;
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/integration/SensitivityIntegratorImpl.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+using namespace ocs2;
+using namespace benchmark;
+
+namespace {
+
+/** Number of RK4 substeps of the reference discretization. */
+constexpr size_t numReferenceSubsteps = 256;
+
+std::vector<std::string> split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_discretization_benchmark [options]\n"
+            << "  --problems <a,b,...>     subset of the problems (default: all)\n"
+            << "  --timeSteps <a,b,...>    discretization time steps in [s] (default: 0.005,0.01,0.02,0.05)\n"
+            << "  --maxNumNodes <n>        maximum number of sampled nodes of the solution (default: 20)\n";
+}
+
+/** A node of the solution at which the discretizations are evaluated. */
+struct SampleNode {
+  scalar_t time;
+  vector_t state;
+  vector_t input;
+};
+
+/** Solves the MPC problem once from the initial observation and samples nodes of the optimized trajectories. */
+std::vector<SampleNode> getSampleNodes(const MpcBenchmarkProblem& problem, MPC_BASE& mpc, size_t maxNumNodes) {
+  auto& solver = *mpc.getSolverPtr();
+  solver.getReferenceManager().setTargetTrajectories(problem.initialTargetTrajectories);
+  mpc.run(problem.initialObservation.time, problem.initialObservation.state);
+
+  const auto primalSolution = solver.getPrimalSolutionSnapshot(solver.getFinalTime());
+  const size_t numNodes = primalSolution->timeTrajectory_.size();
+  const size_t stride = std::max<size_t>(numNodes / maxNumNodes, 1);
+
+  std::vector<SampleNode> nodes;
+  for (size_t i = 0; i < numNodes && nodes.size() < maxNumNodes; i += stride) {
+    nodes.push_back({primalSolution->timeTrajectory_[i], primalSolution->stateTrajectory_[i], primalSolution->inputTrajectory_[i]});
+  }
+  return nodes;
+}
+
+/** Relative error of a matrix with respect to a reference. */
+scalar_t relativeError(const matrix_t& value, const matrix_t& reference) {
+  return (value - reference).lpNorm<Eigen::Infinity>() / std::max(reference.lpNorm<Eigen::Infinity>(), 1.0);
+}
+
+}  // namespace
+
+/**
+ * Measures the accuracy versus cost of the sensitivity discretizations on the robotic examples. The discretizations are evaluated at
+ * nodes of the MPC solution from the initial observation and compared against RK4 with many substeps. Per problem, scheme, and time
+ * step, the worst relative error of the flow and of its state sensitivity over the nodes and the mean evaluation time are printed.
+ */
+int main(int argc, char* argv[]) {
+  std::vector<std::string> problemNames = getBenchmarkProblemNames();
+  std::vector<scalar_t> timeSteps{0.005, 0.01, 0.02, 0.05};
+  size_t maxNumNodes = 20;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--problems") {
+      problemNames = split(value);
+    } else if (option == "--timeSteps") {
+      timeSteps.clear();
+      for (const auto& timeStep : split(value)) {
+        timeSteps.push_back(std::stod(timeStep));
+      }
+    } else if (option == "--maxNumNodes") {
+      maxNumNodes = std::max(std::stoul(value), 1UL);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const std::vector<SensitivityIntegratorType> integratorTypes{SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2,
+                                                               SensitivityIntegratorType::RK4, SensitivityIntegratorType::IMPLICIT_MIDPOINT,
+                                                               SensitivityIntegratorType::RK4_ADAPTIVE};
+
+  std::cout << "problem, integrator, dt [s], flow error, sensitivity error, time [us]\n";
+  for (const auto& problemName : problemNames) {
+    std::unique_ptr<SystemDynamicsBase> systemPtr;
+    std::vector<SampleNode> nodes;
+    try {
+      const auto problem = getBenchmarkProblem(problemName);
+      const auto mpcPtr = problem.getMpc(MpcSolver::SQP);
+      if (mpcPtr == nullptr) {
+        throw std::runtime_error("SQP is not supported.");
+      }
+      nodes = getSampleNodes(problem, *mpcPtr, maxNumNodes);
+      systemPtr.reset(mpcPtr->getSolverPtr()->getOptimalControlProblem().dynamicsPtr->clone());
+    } catch (const std::exception& e) {
+      std::cerr << "[ocs2_discretization_benchmark] Could not build " << problemName << ": " << e.what() << "\n";
+      continue;
+    }
+
+    for (const auto dt : timeSteps) {
+      std::vector<VectorFunctionLinearApproximation> references;
+      references.reserve(nodes.size());
+      for (const auto& node : nodes) {
+        references.push_back(rk4SubstepSensitivityDiscretization(*systemPtr, node.time, node.state, node.input, dt, numReferenceSubsteps));
+      }
+
+      for (const auto integratorType : integratorTypes) {
+        const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(integratorType);
+        scalar_t flowError = 0.0;
+        scalar_t sensitivityError = 0.0;
+        scalar_t totalTime = 0.0;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+          const auto start = std::chrono::steady_clock::now();
+          const auto discretization = sensitivityDiscretizer(*systemPtr, nodes[i].time, nodes[i].state, nodes[i].input, dt);
+          const auto finish = std::chrono::steady_clock::now();
+          totalTime += std::chrono::duration<scalar_t, std::micro>(finish - start).count();
+          flowError = std::max(flowError, relativeError(discretization.f, references[i].f));
+          sensitivityError = std::max(sensitivityError, relativeError(discretization.dfdx, references[i].dfdx));
+        }
+        std::cout << problemName << ", " << sensitivity_integrator::toString(integratorType) << ", " << dt << ", " << flowError << ", "
+                  << sensitivityError << ", " << totalTime / nodes.size() << std::endl;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Time grid with random steps and repeated time points at events, as in the trajectories of a solver. */
+scalar_array_t getTimeGridWithEvents(size_t numSteps, std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> stepDistribution(0.001, 0.02);
+  std::bernoulli_distribution eventDistribution(0.1);
+  scalar_array_t time{0.0};
+  for (size_t i = 1; i < numSteps; i++) {
+    if (eventDistribution(generator)) {
+      time.push_back(time.back());
+    }
+    time.push_back(time.back() + stepDistribution(generator));
+  }
+  return time;
+}
+
+/** Looks up all queries with the given function and returns the mean time of a query in nanoseconds. */
+template <typename LookUp>
+scalar_t timeQueries(const scalar_array_t& queries, LookUp&& lookUp, scalar_t& checksum) {
+  benchmark::RepeatedTimer timer;
+  timer.startTimer();
+  for (const auto query : queries) {
+    const auto indexAlpha = lookUp(query);
+    checksum += indexAlpha.first + indexAlpha.second;
+  }
+  timer.endTimer();
+  return 1e6 * timer.getTotalInMilliseconds() / queries.size();
+}
+
+std::vector<size_t> split(const std::string& list) {
+  std::vector<size_t> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(std::stoul(item));
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_interpolation_benchmark [options]\n"
+            << "  --numSteps <a,b,...>   sizes of the time grids (default: 20,100,1000)\n"
+            << "  --numQueries <n>       number of queries per grid (default: 100000)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the time segment lookup of LinearInterpolation by binary search with the bucket table (including its construction) and the
+ * cursor, for monotone queries as issued by an integrator and random queries as issued by policy evaluations.
+ */
+int main(int argc, char* argv[]) {
+  std::vector<size_t> numStepsList{20, 100, 1000};
+  int numQueries = 100000;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numSteps") {
+      numStepsList = split(value);
+    } else if (option == "--numQueries") {
+      numQueries = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::mt19937 generator(1);
+  for (const auto numSteps : numStepsList) {
+    const auto time = getTimeGridWithEvents(numSteps, generator);
+
+    scalar_array_t monotoneQueries(numQueries);
+    for (int i = 0; i < numQueries; i++) {
+      monotoneQueries[i] = time.front() + (time.back() - time.front()) * static_cast<scalar_t>(i) / numQueries;
+    }
+    scalar_array_t randomQueries = monotoneQueries;
+    std::shuffle(randomQueries.begin(), randomQueries.end(), generator);
+
+    std::cout << "Time grid with " << time.size() << " points:\n";
+    for (const auto* queriesPtr : {&monotoneQueries, &randomQueries}) {
+      scalar_t binarySearchSum = 0.0;
+      scalar_t tableSum = 0.0;
+      scalar_t cursorSum = 0.0;
+
+      const auto binarySearchTime =
+          timeQueries(*queriesPtr, [&](scalar_t query) { return LinearInterpolation::timeSegment(query, time); }, binarySearchSum);
+
+      benchmark::RepeatedTimer tableConstructionTimer;
+      tableConstructionTimer.startTimer();
+      const LinearInterpolation::TimeSegmentTable table(time);
+      tableConstructionTimer.endTimer();
+      const auto tableTime = timeQueries(*queriesPtr, [&](scalar_t query) { return table.timeSegment(query); }, tableSum);
+
+      LinearInterpolation::TimeSegmentCursor cursor(time);
+      const auto cursorTime = timeQueries(*queriesPtr, [&](scalar_t query) { return cursor.timeSegment(query); }, cursorSum);
+
+      std::cout << "  " << (queriesPtr == &monotoneQueries ? "monotone" : "random") << " queries:\n";
+      std::cout << "    binary search: " << binarySearchTime << " [ns/query]\n";
+      std::cout << "    table:         " << tableTime << " [ns/query] + " << 1e3 * tableConstructionTimer.getTotalInMilliseconds()
+                << " [us] construction\n";
+      std::cout << "    cursor:        " << cursorTime << " [ns/query]\n";
+      if (tableSum != binarySearchSum || cursorSum != binarySearchSum) {
+        std::cerr << "    The lookups are not equivalent!\n";
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,193 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ipm/IpmHelpers.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a node of a legged robot with friction cone constraints
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 24;
+constexpr size_t numConstraints = 20;
+constexpr scalar_t barrierParam = 0.1;
+constexpr scalar_t marginRate = 0.995;
+
+vector_t getRandomPositiveVector(size_t n) {
+  return vector_t::Random(n).cwiseAbs() + vector_t::Constant(n, 0.01);
+}
+
+/** The condensation before the workspace: separate dual feasibility products and temporaries allocated per call. */
+void condenseWithTemporaries(const vector_t& slack, const vector_t& dual, const VectorFunctionLinearApproximation& ineqConstraint,
+                             ScalarFunctionQuadraticApproximation& lagrangian) {
+  lagrangian.dfdx.noalias() -= ineqConstraint.dfdx.transpose() * dual;
+  lagrangian.dfdu.noalias() -= ineqConstraint.dfdu.transpose() * dual;
+
+  const vector_t condensingLinearCoeff = (dual.array() * ineqConstraint.f.array() - barrierParam) / slack.array();
+  const vector_t condensingQuadraticCoeff = dual.cwiseQuotient(slack);
+
+  lagrangian.dfdx.noalias() += ineqConstraint.dfdx.transpose() * condensingLinearCoeff;
+  const matrix_t condensingQuadraticCoeff_dfdx = condensingQuadraticCoeff.asDiagonal() * ineqConstraint.dfdx;
+  lagrangian.dfdxx.noalias() += ineqConstraint.dfdx.transpose() * condensingQuadraticCoeff_dfdx;
+
+  lagrangian.dfdu.noalias() += ineqConstraint.dfdu.transpose() * condensingLinearCoeff;
+  const matrix_t condensingQuadraticCoeff_dfdu = condensingQuadraticCoeff.asDiagonal() * ineqConstraint.dfdu;
+  lagrangian.dfduu.noalias() += ineqConstraint.dfdu.transpose() * condensingQuadraticCoeff_dfdu;
+  lagrangian.dfdux.noalias() += ineqConstraint.dfdu.transpose() * condensingQuadraticCoeff_dfdx;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_ipm_directions_benchmark [options]\n"
+            << "  --numNodes <n>     number of nodes of the horizon (default: 100)\n"
+            << "  --numRepeats <n>   number of repetitions (default: 100)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the per-node kernels of the IPM solver over a horizon:
+ * - the condensation of the inequality constraints with temporaries allocated per call, and ipm::condenseIneqConstraints() with a
+ *   reused ipm::CondensingWorkspace;
+ * - the retrieval of the slack and dual directions with the fraction-to-boundary step sizes: the separate
+ *   ipm::retrieveSlackDirection(), ipm::retrieveDualDirection() and ipm::fractionToBoundaryStepSize() calls, and the fused
+ *   ipm::retrieveSlackDualDirections().
+ * The mean time per horizon is printed.
+ */
+int main(int argc, char* argv[]) {
+  int numNodes = 100;
+  int numRepeats = 100;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numNodes") {
+      numNodes = std::max(std::stoi(value), 1);
+    } else if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::vector<VectorFunctionLinearApproximation> constraints;
+  std::vector<ScalarFunctionQuadraticApproximation> lagrangians;
+  vector_array_t dx, du, slack, dual;
+  for (int i = 0; i < numNodes; ++i) {
+    VectorFunctionLinearApproximation constraint(numConstraints, stateDim, inputDim);
+    constraint.f.setRandom();
+    constraint.dfdx.setRandom();
+    constraint.dfdu.setRandom();
+    constraints.push_back(std::move(constraint));
+    lagrangians.push_back(ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim));
+    dx.push_back(vector_t::Random(stateDim));
+    du.push_back(vector_t::Random(inputDim));
+    slack.push_back(getRandomPositiveVector(numConstraints));
+    dual.push_back(getRandomPositiveVector(numConstraints));
+  }
+
+  benchmark::RepeatedTimer temporariesTimer;
+  benchmark::RepeatedTimer workspaceTimer;
+  std::vector<ScalarFunctionQuadraticApproximation> condensed(lagrangians);
+  ipm::CondensingWorkspace workspace;
+  scalar_t maxCondensingError = 0.0;
+
+  for (int k = 0; k < numRepeats; ++k) {
+    condensed = lagrangians;
+    temporariesTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      condenseWithTemporaries(slack[i], dual[i], constraints[i], condensed[i]);
+    }
+    temporariesTimer.endTimer();
+    const auto withTemporaries = condensed;
+
+    condensed = lagrangians;
+    workspaceTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      ipm::condenseIneqConstraints(barrierParam, slack[i], dual[i], constraints[i], condensed[i], workspace);
+    }
+    workspaceTimer.endTimer();
+
+    for (int i = 0; i < numNodes; ++i) {
+      maxCondensingError = std::max(maxCondensingError, (condensed[i].dfdxx - withTemporaries[i].dfdxx).lpNorm<Eigen::Infinity>());
+      maxCondensingError = std::max(maxCondensingError, (condensed[i].dfdu - withTemporaries[i].dfdu).lpNorm<Eigen::Infinity>());
+    }
+  }
+
+  benchmark::RepeatedTimer separateTimer;
+  benchmark::RepeatedTimer fusedTimer;
+  vector_array_t slackDirections(numNodes);
+  vector_array_t dualDirections(numNodes);
+  scalar_t primalStepSize = 1.0;
+  scalar_t dualStepSize = 1.0;
+  ipm::StepSizes stepSizes;
+
+  for (int k = 0; k < numRepeats; ++k) {
+    separateTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      slackDirections[i] = ipm::retrieveSlackDirection(constraints[i], dx[i], du[i], barrierParam, slack[i]);
+      dualDirections[i] = ipm::retrieveDualDirection(barrierParam, slack[i], dual[i], slackDirections[i]);
+      primalStepSize = std::min(primalStepSize, ipm::fractionToBoundaryStepSize(slack[i], slackDirections[i], marginRate));
+      dualStepSize = std::min(dualStepSize, ipm::fractionToBoundaryStepSize(dual[i], dualDirections[i], marginRate));
+    }
+    separateTimer.endTimer();
+
+    fusedTimer.startTimer();
+    for (int i = 0; i < numNodes; ++i) {
+      ipm::retrieveSlackDualDirections(constraints[i], dx[i], &du[i], barrierParam, slack[i], dual[i], marginRate, slackDirections[i],
+                                       dualDirections[i], stepSizes);
+    }
+    fusedTimer.endTimer();
+  }
+
+  std::cout << "Condensation of " << numNodes << " nodes (nx = " << stateDim << ", nu = " << inputDim << ", nc = " << numConstraints
+            << "):\n";
+  std::cout << "  Temporaries: " << temporariesTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Workspace:   " << workspaceTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Max difference: " << maxCondensingError << "\n";
+  std::cout << "Slack and dual directions of " << numNodes << " nodes (nx = " << stateDim << ", nu = " << inputDim
+            << ", nc = " << numConstraints << "):\n";
+  std::cout << "  Separate: " << separateTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Fused:    " << fusedTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Step sizes (primal, dual): separate (" << primalStepSize << ", " << dualStepSize << "), fused (" << stepSizes.primal
+            << ", " << stepSizes.dual << ")\n";
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+scalar_t nearestRank(const scalar_array_t& sortedSamples, scalar_t percentile) {
+  const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedSamples.size()));
+  return sortedSamples[std::min(std::max(rank, size_t(1)), sortedSamples.size()) - 1];
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyHistogram::getPercentile(scalar_t percentile) const {
+  if (samples_.empty()) {
+    return 0.0;
+  }
+  scalar_array_t sortedSamples = samples_;
+  std::sort(sortedSamples.begin(), sortedSamples.end());
+  return nearestRank(sortedSamples, percentile);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LatencyStatistics LatencyHistogram::getStatistics() const {
+  LatencyStatistics statistics;
+  if (samples_.empty()) {
+    return statistics;
+  }
+
+  scalar_array_t sortedSamples = samples_;
+  std::sort(sortedSamples.begin(), sortedSamples.end());
+
+  statistics.count = sortedSamples.size();
+  statistics.mean = std::accumulate(sortedSamples.begin(), sortedSamples.end(), 0.0) / sortedSamples.size();
+  statistics.median = nearestRank(sortedSamples, 50.0);
+  statistics.percentile90 = nearestRank(sortedSamples, 90.0);
+  statistics.percentile99 = nearestRank(sortedSamples, 99.0);
+  statistics.max = sortedSamples.back();
+  return statistics;
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,202 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/oc_data/FlatMetrics.h>
+#include <ocs2_oc/oc_data/TimeDiscretization.h>
+
+using namespace ocs2;
+
+namespace {
+
+size_t numAllocations = 0;
+
+}  // namespace
+
+#ifdef __GLIBC__
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size) {
+  ++numAllocations;
+  return __libc_malloc(size);
+}
+#endif
+
+namespace {
+
+matrix_t getRandomPositiveDefinite(int n) {
+  const matrix_t A = matrix_t::Random(n, n);
+  return A * A.transpose() + matrix_t::Identity(n, n);
+}
+
+/** A legged robot like problem: two state-input equality terms, two state-input inequality terms and a state inequality term. */
+OptimalControlProblem createProblem(int nx, int nu) {
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new LinearSystemDynamics(matrix_t::Random(nx, nx), matrix_t::Random(nx, nu)));
+  problem.costPtr->add("cost", std::make_unique<QuadraticStateInputCost>(getRandomPositiveDefinite(nx), getRandomPositiveDefinite(nu)));
+  problem.finalCostPtr->add("finalCost", std::make_unique<QuadraticStateCost>(getRandomPositiveDefinite(nx)));
+  for (const std::string name : {"equality0", "equality1"}) {
+    problem.equalityConstraintPtr->add(
+        name, std::make_unique<LinearStateInputConstraint>(vector_t::Random(3), matrix_t::Random(3, nx), matrix_t::Random(3, nu)));
+  }
+  for (const std::string name : {"inequality0", "inequality1"}) {
+    problem.inequalityConstraintPtr->add(
+        name, std::make_unique<LinearStateInputConstraint>(vector_t::Random(8), matrix_t::Random(8, nx), matrix_t::Random(8, nu)));
+  }
+  problem.stateInequalityConstraintPtr->add("stateInequality",
+                                            std::make_unique<LinearStateConstraint>(vector_t::Random(4), matrix_t::Random(4, nx)));
+  return problem;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_linesearch_metrics_benchmark [options]\n"
+            << "  --numNodes <n>    number of intermediate nodes (default: 100)\n"
+            << "  --stateDim <n>    state dimension (default: 24)\n"
+            << "  --inputDim <n>    input dimension (default: 12)\n"
+            << "  --numTrials <n>   number of linesearch trials (default: 200)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares a linesearch trial of SqpSolver::computePerformance() that stores the metrics in a freshly allocated array of Metrics,
+ * as before, with one that writes them in place into the reused FlatMetrics buffers. Reports the time and the number of heap
+ * allocations per trial. The allocation count is only available with glibc.
+ */
+int main(int argc, char* argv[]) {
+  int numNodes = 100;
+  int stateDim = 24;
+  int inputDim = 12;
+  int numTrials = 200;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numNodes") {
+      numNodes = std::max(std::stoi(value), 1);
+    } else if (option == "--stateDim") {
+      stateDim = std::max(std::stoi(value), 1);
+    } else if (option == "--inputDim") {
+      inputDim = std::max(std::stoi(value), 1);
+    } else if (option == "--numTrials") {
+      numTrials = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  auto problem = createProblem(stateDim, inputDim);
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(stateDim)}, {vector_t::Zero(inputDim)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+  auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+
+  const int N = numNodes;
+  const auto time = timeDiscretizationWithEvents(0.0, 0.01 * N, 0.01, {});
+  vector_array_t x(N + 1);
+  vector_array_t u(N);
+  std::generate(x.begin(), x.end(), [&]() { return vector_t::Random(stateDim); });
+  std::generate(u.begin(), u.end(), [&]() { return vector_t::Random(inputDim); });
+
+  std::vector<MetricsSize> sizes(N + 1);
+  for (int i = 0; i < N; ++i) {
+    sizes[i] = multiple_shooting::getIntermediateMetricsSize(problem, getIntervalStart(time[i]), stateDim);
+  }
+  sizes[N] = multiple_shooting::getTerminalMetricsSize(problem, getIntervalStart(time[N]));
+
+  // Array of Metrics: a new array per trial that is moved into the current metrics on acceptance
+  std::vector<Metrics> metrics(N + 1);
+  benchmark::RepeatedTimer arrayTimer;
+  const size_t arrayAllocationsStart = numAllocations;
+  for (int k = 0; k < numTrials; ++k) {
+    arrayTimer.startTimer();
+    std::vector<Metrics> trialMetrics(N + 1);
+    PerformanceIndex performance;
+    for (int i = 0; i < N; ++i) {
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      trialMetrics[i] = multiple_shooting::computeIntermediateMetrics(problem, discretizer, ti, dt, x[i], x[i + 1], u[i]);
+      performance += toPerformanceIndex(trialMetrics[i], dt);
+    }
+    trialMetrics[N] = multiple_shooting::computeTerminalMetrics(problem, getIntervalStart(time[N]), x[N]);
+    performance += toPerformanceIndex(trialMetrics[N]);
+    metrics = std::move(trialMetrics);
+    arrayTimer.endTimer();
+  }
+  const size_t arrayAllocations = numAllocations - arrayAllocationsStart;
+
+  // FlatMetrics: the trial buffers are swapped with the current ones on acceptance
+  FlatMetrics flatMetrics;
+  FlatMetrics flatTrialMetrics;
+  flatMetrics.setLayout(sizes);
+  flatTrialMetrics.setLayout(sizes);
+  benchmark::RepeatedTimer flatTimer;
+  const size_t flatAllocationsStart = numAllocations;
+  for (int k = 0; k < numTrials; ++k) {
+    flatTimer.startTimer();
+    PerformanceIndex performance;
+    for (int i = 0; i < N; ++i) {
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      multiple_shooting::computeIntermediateMetrics(problem, discretizer, ti, dt, x[i], x[i + 1], u[i], flatTrialMetrics, i);
+      performance += toPerformanceIndex(flatTrialMetrics, i, dt);
+    }
+    multiple_shooting::computeTerminalMetrics(problem, getIntervalStart(time[N]), x[N], flatTrialMetrics, N);
+    performance += toPerformanceIndex(flatTrialMetrics, N);
+    flatMetrics.swap(flatTrialMetrics);
+    flatTimer.endTimer();
+  }
+  const size_t flatAllocations = numAllocations - flatAllocationsStart;
+
+  std::cout << "Linesearch trial with " << N << " nodes, state dimension " << stateDim << " and input dimension " << inputDim << ":\n";
+  std::cout << "  time [ms]:           Metrics array " << arrayTimer.getAverageInMilliseconds() << ", FlatMetrics "
+            << flatTimer.getAverageInMilliseconds() << "\n";
+#ifdef __GLIBC__
+  std::cout << "  heap allocations:    Metrics array " << arrayAllocations / numTrials << ", FlatMetrics " << flatAllocations / numTrials
+            << "\n";
+#endif
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <ocs2_core/loopshaping/LoopshapingAugmentation.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a legged robot
+constexpr size_t sysStateDim = 24;
+constexpr size_t filterDim = 24;
+
+ScalarFunctionQuadraticApproximation getRandomSystemApproximation(size_t stateDim, size_t inputDim) {
+  ScalarFunctionQuadraticApproximation L;
+  L.f = 1.0;
+  L.dfdx.setRandom(stateDim);
+  L.dfdu.setRandom(inputDim);
+  const matrix_t H = matrix_t::Random(stateDim + inputDim, stateDim + inputDim);
+  const matrix_t HtH = H.transpose() * H;
+  L.dfdxx = HtH.topLeftCorner(stateDim, stateDim);
+  L.dfdux = HtH.bottomLeftCorner(inputDim, stateDim);
+  L.dfduu = HtH.bottomRightCorner(inputDim, inputDim);
+  return L;
+}
+
+/** Transforms the approximation with the dense map T from the augmented state and input to the system state and input. */
+ScalarFunctionQuadraticApproximation denseEliminatePatternApproximation(const LoopshapingDefinition& loopshapingDefinition,
+                                                                        const ScalarFunctionQuadraticApproximation& L_system) {
+  const auto& filter = loopshapingDefinition.getInputFilter();
+  const size_t sysInputDim = L_system.dfdu.rows();
+  const size_t stateDim = sysStateDim + filter.getNumStates();
+  const size_t inputDim = filter.getNumInputs();
+
+  // [x_system; u_system] = T * [x; u]
+  matrix_t T = matrix_t::Zero(sysStateDim + sysInputDim, stateDim + inputDim);
+  T.topLeftCorner(sysStateDim, sysStateDim).setIdentity();
+  T.bottomRightCorner(sysInputDim, filter.getNumStates() + inputDim) = filter.getCD();
+
+  vector_t g_system(sysStateDim + sysInputDim);
+  g_system << L_system.dfdx, L_system.dfdu;
+  matrix_t H_system(sysStateDim + sysInputDim, sysStateDim + sysInputDim);
+  H_system << L_system.dfdxx, L_system.dfdux.transpose(), L_system.dfdux, L_system.dfduu;
+
+  const vector_t g = T.transpose() * g_system;
+  const matrix_t H = T.transpose() * H_system * T;
+
+  ScalarFunctionQuadraticApproximation L;
+  L.f = L_system.f;
+  L.dfdx = g.head(stateDim);
+  L.dfdu = g.tail(inputDim);
+  L.dfdxx = H.topLeftCorner(stateDim, stateDim);
+  L.dfdux = H.bottomLeftCorner(inputDim, stateDim);
+  L.dfduu = H.bottomRightCorner(inputDim, inputDim);
+  return L;
+}
+
+/** First order filter of the size used by the quadruped loopshaping MPC. */
+std::shared_ptr<LoopshapingDefinition> getQuadrupedSizedDefinition(bool diagonal) {
+  matrix_t A = -50.0 * matrix_t::Identity(filterDim, filterDim);
+  matrix_t B = matrix_t::Identity(filterDim, filterDim);
+  matrix_t C = 10.0 * matrix_t::Identity(filterDim, filterDim);
+  matrix_t D = 0.5 * matrix_t::Identity(filterDim, filterDim);
+  if (!diagonal) {
+    C += 0.1 * matrix_t::Random(filterDim, filterDim);
+    D += 0.1 * matrix_t::Random(filterDim, filterDim);
+  }
+  return std::make_shared<LoopshapingDefinition>(LoopshapingType::eliminatepattern, Filter(A, B, C, D));
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_loopshaping_benchmark [options]\n"
+            << "  --numNodes <n>   number of approximations per filter (default: 1000)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the structured eliminate-pattern transformation of a quadratic cost approximation in LoopshapingAugmentation with the dense
+ * transformation T' * H * T, for a diagonal and a dense filter. The mean times per node are printed.
+ */
+int main(int argc, char* argv[]) {
+  int numNodes = 1000;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numNodes") {
+      numNodes = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::cout << "Eliminate-pattern quadratic approximation (system nx = " << sysStateDim << ", filter nx = " << filterDim << "):\n";
+  for (const bool diagonal : {true, false}) {
+    const auto loopshapingDefinition = getQuadrupedSizedDefinition(diagonal);
+    const auto L_system = getRandomSystemApproximation(sysStateDim, loopshapingDefinition->getInputFilter().getNumOutputs());
+
+    benchmark::RepeatedTimer structuredTimer;
+    benchmark::RepeatedTimer denseTimer;
+    scalar_t maxError = 0.0;
+    for (int k = 0; k < numNodes; ++k) {
+      structuredTimer.startTimer();
+      ScalarFunctionQuadraticApproximation L;
+      L.f = L_system.f;
+      loopshaping_augmentation::eliminatePatternQuadraticApproximation(*loopshapingDefinition, L_system, L);
+      structuredTimer.endTimer();
+
+      denseTimer.startTimer();
+      const auto L_dense = denseEliminatePatternApproximation(*loopshapingDefinition, L_system);
+      denseTimer.endTimer();
+
+      maxError = std::max(maxError, (L.dfdxx - L_dense.dfdxx).lpNorm<Eigen::Infinity>());
+    }
+
+    std::cout << "  " << (diagonal ? "diagonal" : "dense") << " filter:\n";
+    std::cout << "    structured: " << 1e3 * structuredTimer.getAverageInMilliseconds() << " [us/node]\n";
+    std::cout << "    dense:      " << 1e3 * denseTimer.getAverageInMilliseconds() << " [us/node]\n";
+    std::cout << "    max error:  " << maxError << "\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,256 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+
+namespace ocs2 {
+namespace benchmark {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(MpcSolver solver) {
+  switch (solver) {
+    case MpcSolver::DDP:
+      return "DDP";
+    case MpcSolver::SQP:
+      return "SQP";
+    case MpcSolver::IPM:
+      return "IPM";
+  }
+  throw std::runtime_error("[toString] Unknown MpcSolver");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcSolver fromString(const std::string& name) {
+  for (const auto solver : {MpcSolver::DDP, MpcSolver::SQP, MpcSolver::IPM}) {
+    if (toString(solver) == name) {
+      return solver;
+    }
+  }
+  throw std::runtime_error("[fromString] Unknown MpcSolver: " + name);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcBenchmarkResult runMpcBenchmark(const MpcBenchmarkProblem& problem, MpcSolver solver) {
+  auto mpcPtr = problem.getMpc(solver);
+  if (mpcPtr == nullptr) {
+    throw std::runtime_error("[runMpcBenchmark] " + problem.name + " does not support " + toString(solver));
+  }
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+  mpcInterface.resetMpcNode(problem.initialTargetTrajectories);
+
+  // One histogram per phase for advanceMpc() and updatePolicy()
+  std::vector<std::string> phaseNames{"firstSolve"};
+  for (const auto& phase : problem.phases) {
+    phaseNames.push_back(phase.name);
+  }
+  std::vector<LatencyHistogram> advanceMpcLatencies(phaseNames.size());
+  std::vector<LatencyHistogram> updatePolicyLatencies(phaseNames.size());
+
+  RepeatedTimer timer;
+  SystemObservation observation = problem.initialObservation;
+  vector_t optimalState, optimalInput;
+
+  // Runs one MPC iteration and moves the observation forward along the policy
+  auto step = [&](size_t phaseIndex) {
+    mpcInterface.setCurrentObservation(observation);
+
+    timer.startTimer();
+    mpcInterface.advanceMpc();
+    timer.endTimer();
+    advanceMpcLatencies[phaseIndex].addSample(timer.getLastIntervalInMilliseconds());
+
+    if (!mpcInterface.initialPolicyReceived()) {
+      throw std::runtime_error("[runMpcBenchmark] " + problem.name + " with " + toString(solver) + " did not return a policy");
+    }
+
+    timer.startTimer();
+    mpcInterface.updatePolicy();
+    timer.endTimer();
+    updatePolicyLatencies[phaseIndex].addSample(timer.getLastIntervalInMilliseconds());
+
+    observation.time += problem.timeStep;
+    mpcInterface.evaluatePolicy(observation.time, observation.state, optimalState, optimalInput, observation.mode);
+    observation.state = optimalState;
+    observation.input = optimalInput;
+  };
+
+  step(0);
+  for (size_t i = 0; i < problem.phases.size(); ++i) {
+    const auto& phase = problem.phases[i];
+    if (phase.getTargetTrajectories) {
+      mpcInterface.getReferenceManager().setTargetTrajectories(phase.getTargetTrajectories(observation));
+    }
+    const auto numSteps = std::max(static_cast<int>(std::round(phase.duration / problem.timeStep)), 1);
+    for (int j = 0; j < numSteps; ++j) {
+      step(i + 1);
+    }
+  }
+
+  MpcBenchmarkResult result;
+  result.problem = problem.name;
+  result.solver = solver;
+  for (size_t i = 0; i < phaseNames.size(); ++i) {
+    result.measurements.push_back({phaseNames[i], "advanceMpc", advanceMpcLatencies[i].getStatistics()});
+    result.measurements.push_back({phaseNames[i], "updatePolicy", updatePolicyLatencies[i].getStatistics()});
+  }
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeResults(std::ostream& stream, const std::vector<MpcBenchmarkResult>& results) {
+  stream << "problem,solver,phase,operation,count,mean,p50,p90,p99,max\n";
+  stream << std::setprecision(6);
+  for (const auto& result : results) {
+    for (const auto& measurement : result.measurements) {
+      const auto& s = measurement.statistics;
+      stream << result.problem << ',' << toString(result.solver) << ',' << measurement.phase << ',' << measurement.operation << ','
+             << s.count << ',' << s.mean << ',' << s.median << ',' << s.percentile90 << ',' << s.percentile99 << ',' << s.max << '\n';
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeResults(const std::string& filePath, const std::vector<MpcBenchmarkResult>& results) {
+  std::ofstream file(filePath);
+  if (!file) {
+    throw std::runtime_error("[writeResults] Could not open " + filePath);
+  }
+  writeResults(file, results);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<MpcBenchmarkResult> loadResults(const std::string& filePath) {
+  std::ifstream file(filePath);
+  if (!file) {
+    throw std::runtime_error("[loadResults] Could not open " + filePath);
+  }
+
+  std::vector<MpcBenchmarkResult> results;
+  std::string line;
+  std::getline(file, line);  // header
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields;
+    std::stringstream lineStream(line);
+    std::string field;
+    while (std::getline(lineStream, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() != 10) {
+      throw std::runtime_error("[loadResults] Malformed row in " + filePath + ": " + line);
+    }
+
+    const auto solver = fromString(fields[1]);
+    if (results.empty() || results.back().problem != fields[0] || results.back().solver != solver) {
+      results.push_back({fields[0], solver, {}});
+    }
+    MpcBenchmarkMeasurement measurement{fields[2], fields[3], {}};
+    measurement.statistics.count = std::stoul(fields[4]);
+    measurement.statistics.mean = std::stod(fields[5]);
+    measurement.statistics.median = std::stod(fields[6]);
+    measurement.statistics.percentile90 = std::stod(fields[7]);
+    measurement.statistics.percentile99 = std::stod(fields[8]);
+    measurement.statistics.max = std::stod(fields[9]);
+    results.back().measurements.push_back(std::move(measurement));
+  }
+  return results;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool compareResults(const std::vector<MpcBenchmarkResult>& baseline, const std::vector<MpcBenchmarkResult>& results, scalar_t tolerance,
+                    std::ostream& stream) {
+  auto findMeasurement = [&](const MpcBenchmarkResult& reference, const MpcBenchmarkMeasurement& referenceMeasurement) {
+    const MpcBenchmarkMeasurement* measurementPtr = nullptr;
+    for (const auto& result : results) {
+      if (result.problem == reference.problem && result.solver == reference.solver) {
+        for (const auto& measurement : result.measurements) {
+          if (measurement.phase == referenceMeasurement.phase && measurement.operation == referenceMeasurement.operation) {
+            measurementPtr = &measurement;
+          }
+        }
+      }
+    }
+    return measurementPtr;
+  };
+
+  auto relativeChange = [](scalar_t reference, scalar_t value) { return reference > 0.0 ? value / reference - 1.0 : 0.0; };
+
+  bool passed = true;
+  stream << std::fixed << std::setprecision(1);
+  for (const auto& reference : baseline) {
+    for (const auto& referenceMeasurement : reference.measurements) {
+      const std::string name =
+          reference.problem + "/" + toString(reference.solver) + "/" + referenceMeasurement.phase + "/" + referenceMeasurement.operation;
+      const auto* measurementPtr = findMeasurement(reference, referenceMeasurement);
+      if (measurementPtr == nullptr) {
+        stream << "[MISSING]    " << name << '\n';
+        passed = false;
+        continue;
+      }
+
+      const scalar_t medianChange = relativeChange(referenceMeasurement.statistics.median, measurementPtr->statistics.median);
+      const scalar_t percentile99Change =
+          relativeChange(referenceMeasurement.statistics.percentile99, measurementPtr->statistics.percentile99);
+      const bool regressed = medianChange > tolerance || percentile99Change > tolerance;
+      passed = passed && !regressed;
+      stream << (regressed ? "[REGRESSION] " : "[OK]         ") << name << "\tp50: " << 100.0 * medianChange
+             << "%\tp99: " << 100.0 * percentile99Change << "%\n";
+    }
+  }
+  return passed;
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+using namespace ocs2;
+using namespace benchmark;
+
+namespace {
+
+std::vector<std::string> split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_mpc_benchmark [options]\n"
+            << "  --output <file>       CSV file for the results (default: mpc_benchmark.csv)\n"
+            << "  --baseline <file>     results of a previous run to compare against\n"
+            << "  --tolerance <value>   allowed relative increase of p50 and p99 with respect to the baseline (default: 0.1)\n"
+            << "  --problems <a,b,...>  subset of the problems (default: all)\n"
+            << "  --solvers <a,b,...>   subset of DDP,SQP,IPM (default: all)\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string outputFile = "mpc_benchmark.csv";
+  std::string baselineFile;
+  scalar_t tolerance = 0.1;
+  std::vector<std::string> problemNames = getBenchmarkProblemNames();
+  std::vector<MpcSolver> solvers{MpcSolver::DDP, MpcSolver::SQP, MpcSolver::IPM};
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--output") {
+      outputFile = value;
+    } else if (option == "--baseline") {
+      baselineFile = value;
+    } else if (option == "--tolerance") {
+      tolerance = std::stod(value);
+    } else if (option == "--problems") {
+      problemNames = split(value);
+    } else if (option == "--solvers") {
+      solvers.clear();
+      for (const auto& name : split(value)) {
+        solvers.push_back(fromString(name));
+      }
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::vector<MpcBenchmarkResult> results;
+  for (const auto& problemName : problemNames) {
+    MpcBenchmarkProblem problem;
+    try {
+      problem = getBenchmarkProblem(problemName);
+    } catch (const std::exception& e) {
+      std::cerr << "[ocs2_mpc_benchmark] Could not build " << problemName << ": " << e.what() << "\n";
+      continue;
+    }
+    for (const auto solver : solvers) {
+      std::cerr << "[ocs2_mpc_benchmark] " << problemName << " with " << toString(solver) << "\n";
+      try {
+        results.push_back(runMpcBenchmark(problem, solver));
+      } catch (const std::exception& e) {
+        // A failing combination is reported and missing in the results, which the comparison flags.
+        std::cerr << "[ocs2_mpc_benchmark] Failed: " << e.what() << "\n";
+        continue;
+      }
+      for (const auto& measurement : results.back().measurements) {
+        const auto& s = measurement.statistics;
+        std::cerr << "\t" << measurement.phase << "/" << measurement.operation << "\tp50: " << s.median << " [ms]\tp90: " << s.percentile90
+                  << " [ms]\tp99: " << s.percentile99 << " [ms]\tmax: " << s.max << " [ms]\n";
+      }
+    }
+  }
+
+  writeResults(outputFile, results);
+  std::cerr << "[ocs2_mpc_benchmark] Results written to " << outputFile << "\n";
+
+  if (!baselineFile.empty()) {
+    const bool passed = compareResults(loadResults(baselineFile), results, tolerance, std::cout);
+    return passed ? 0 : 1;
+  }
+  return 0;
+}
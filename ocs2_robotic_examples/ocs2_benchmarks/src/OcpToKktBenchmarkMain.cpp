@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/oc_problem/OcpToKkt.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a legged robot with a horizon of 1s discretized at 0.015s
+constexpr int numStages = 66;
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 24;
+constexpr size_t numConstraints = 12;
+
+/** Runs the assembly numRepeats times after a warm up and returns the mean time in microseconds. */
+template <typename Assemble>
+scalar_t timeAssembly(int numRepeats, Assemble&& assemble) {
+  assemble();
+  benchmark::RepeatedTimer timer;
+  for (int i = 0; i < numRepeats; i++) {
+    timer.startTimer();
+    assemble();
+    timer.endTimer();
+  }
+  return 1e3 * timer.getAverageInMilliseconds();
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_ocp_to_kkt_benchmark [options]\n"
+            << "  --numRepeats <n>   number of assemblies (default: 20)\n"
+            << "  --numThreads <n>   number of threads of the parallel scatter, including the calling thread (default: 4)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the assembly of the sparse KKT constraint and cost matrices from triplets with the scatter into the precomputed
+ * KktSparsityPattern, serial and in parallel. The mean times are printed.
+ */
+int main(int argc, char* argv[]) {
+  int numRepeats = 20;
+  int numThreads = 4;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else if (option == "--numThreads") {
+      numThreads = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  srand(0);
+  const vector_t x0 = vector_t::Random(stateDim);
+  std::vector<VectorFunctionLinearApproximation> dynamicsArray, constraintsArray;
+  std::vector<ScalarFunctionQuadraticApproximation> costArray;
+  for (int i = 0; i < numStages; i++) {
+    dynamicsArray.push_back(getRandomDynamics(stateDim, inputDim));
+    costArray.push_back(getRandomCost(stateDim, inputDim));
+    constraintsArray.push_back(getRandomConstraints(stateDim, inputDim, numConstraints));
+  }
+  costArray.push_back(getRandomCost(stateDim, 0));
+  constraintsArray.push_back(getRandomConstraints(stateDim, 0, numConstraints));
+  const auto ocpSize = extractSizesFromProblem(dynamicsArray, costArray, &constraintsArray);
+
+  Eigen::SparseMatrix<scalar_t> G, H;
+  vector_t g, h;
+  const auto tripletTime = timeAssembly(numRepeats, [&]() {
+    getConstraintMatrixSparse(ocpSize, x0, dynamicsArray, &constraintsArray, nullptr, G, g);
+    getCostMatrixSparse(ocpSize, x0, costArray, H, h);
+  });
+
+  benchmark::RepeatedTimer patternTimer;
+  patternTimer.startTimer();
+  const KktSparsityPattern pattern(ocpSize, true);
+  patternTimer.endTimer();
+
+  Eigen::SparseMatrix<scalar_t> G_pattern, H_pattern;
+  vector_t g_pattern, h_pattern;
+  const auto scatterTime = timeAssembly(numRepeats, [&]() {
+    pattern.getConstraintMatrix(x0, dynamicsArray, &constraintsArray, nullptr, G_pattern, g_pattern);
+    pattern.getCostMatrix(x0, costArray, H_pattern, h_pattern);
+  });
+
+  ThreadPool threadPool(numThreads - 1, 50);
+  const auto parallelScatterTime = timeAssembly(numRepeats, [&]() {
+    pattern.getConstraintMatrixInParallel(threadPool, x0, dynamicsArray, &constraintsArray, nullptr, G_pattern, g_pattern);
+    pattern.getCostMatrixInParallel(threadPool, x0, costArray, H_pattern, h_pattern);
+  });
+
+  const scalar_t maxError = std::max((G.toDense() - G_pattern.toDense()).lpNorm<Eigen::Infinity>(),
+                                     (H.toDense() - H_pattern.toDense()).lpNorm<Eigen::Infinity>());
+
+  std::cout << "Sparse KKT assembly (N = " << numStages << ", nx = " << stateDim << ", nu = " << inputDim << ", nc = " << numConstraints
+            << "):\n";
+  std::cout << "  triplets:            " << tripletTime << " [us]\n";
+  std::cout << "  symbolic pattern:    " << 1e3 * patternTimer.getTotalInMilliseconds() << " [us] (once)\n";
+  std::cout << "  scatter:             " << scatterTime << " [us]\n";
+  std::cout << "  scatter in parallel: " << parallelScatterTime << " [us] (" << numThreads << " threads)\n";
+  std::cout << "  max error:           " << maxError << "\n";
+
+  return 0;
+}
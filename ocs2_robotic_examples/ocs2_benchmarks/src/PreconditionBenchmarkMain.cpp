@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+#include <ocs2_oc/precondition/Ruzi.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a legged robot with a horizon of 1s discretized at 0.015s
+constexpr int numStages = 66;
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 24;
+
+/** Runs the preconditioning on copies of the problem data and returns the mean time in microseconds, excluding the copies. */
+template <typename Precondition>
+scalar_t timePreconditioning(int numRepeats, const std::vector<VectorFunctionLinearApproximation>& dynamicsArray,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& costArray, Precondition&& precondition) {
+  benchmark::RepeatedTimer timer;
+  for (int i = 0; i < numRepeats; i++) {
+    auto dynamicsArrayCopy = dynamicsArray;
+    auto costArrayCopy = costArray;
+    timer.startTimer();
+    precondition(dynamicsArrayCopy, costArrayCopy);
+    timer.endTimer();
+  }
+  return 1e3 * timer.getAverageInMilliseconds();
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_precondition_benchmark [options]\n"
+            << "  --numRepeats <n>      number of repetitions (default: 200)\n"
+            << "  --numIterations <n>   maximum number of Ruzi iterations (default: 5)\n"
+            << "  --tolerance <tol>     tolerance of the early stopping preconditioner (default: 0.1)\n"
+            << "  --numThreads <n>      number of threads, including the calling thread (default: 4)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares ocpDataInPlaceInParallel with the RuziPreconditioner, which reuses its workspace, with and without early stopping. The mean
+ * times are printed.
+ */
+int main(int argc, char* argv[]) {
+  int numRepeats = 200;
+  int numIterations = 5;
+  scalar_t tolerance = 0.1;
+  int numThreads = 4;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else if (option == "--numIterations") {
+      numIterations = std::max(std::stoi(value), 1);
+    } else if (option == "--tolerance") {
+      tolerance = std::stod(value);
+    } else if (option == "--numThreads") {
+      numThreads = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  srand(0);
+  const vector_t x0 = vector_t::Random(stateDim);
+  std::vector<VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ScalarFunctionQuadraticApproximation> costArray;
+  for (int i = 0; i < numStages; i++) {
+    dynamicsArray.push_back(getRandomDynamics(stateDim, inputDim));
+    costArray.push_back(getRandomCost(stateDim, inputDim));
+  }
+  costArray.push_back(getRandomCost(stateDim, 0));
+  const auto ocpSize = extractSizesFromProblem(dynamicsArray, costArray, nullptr);
+
+  ThreadPool threadPool(numThreads - 1, 50);
+  precondition::RuziPreconditioner preconditioner(numIterations);
+  precondition::RuziPreconditioner earlyStopPreconditioner(numIterations, tolerance);
+
+  vector_array_t D, E, scalingVectors;
+  scalar_t c;
+  const auto ocpDataTime = timePreconditioning(numRepeats, dynamicsArray, costArray, [&](auto& dynamics, auto& cost) {
+    precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize, numIterations, dynamics, cost, D, E, scalingVectors, c);
+  });
+  const auto preconditionerTime = timePreconditioning(numRepeats, dynamicsArray, costArray, [&](auto& dynamics, auto& cost) {
+    preconditioner.precondition(threadPool, x0, ocpSize, dynamics, cost, D, E, scalingVectors, c);
+  });
+  const auto earlyStopTime = timePreconditioning(numRepeats, dynamicsArray, costArray, [&](auto& dynamics, auto& cost) {
+    earlyStopPreconditioner.precondition(threadPool, x0, ocpSize, dynamics, cost, D, E, scalingVectors, c);
+  });
+
+  std::cout << "Ruzi preconditioning (N = " << numStages << ", nx = " << stateDim << ", nu = " << inputDim << ", " << numIterations
+            << " iterations, " << numThreads << " threads):\n";
+  std::cout << "  ocpDataInPlaceInParallel: " << ocpDataTime << " [us]\n";
+  std::cout << "  RuziPreconditioner:       " << preconditionerTime << " [us]\n";
+  std::cout << "  with tolerance " << tolerance << ":       " << earlyStopTime << " [us] (" << earlyStopPreconditioner.getNumIterations()
+            << " iterations)\n";
+
+  return 0;
+}
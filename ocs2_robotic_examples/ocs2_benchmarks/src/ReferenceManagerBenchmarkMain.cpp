@@ -0,0 +1,175 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+using namespace ocs2;
+
+namespace {
+
+// The size of a legged robot
+constexpr size_t stateDim = 24;
+constexpr size_t inputDim = 12;
+constexpr scalar_t initTime = 0.0;
+constexpr scalar_t finalTime = 1.0;
+
+/** Never modifies the references, so the snapshots are activated without a copy */
+class FixedReferenceManager : public ReferenceManager {
+ public:
+  using ReferenceManager::ReferenceManager;
+
+ private:
+  bool modifiesReferences() const override { return false; }
+};
+
+TargetTrajectories getRandomTargetTrajectories(size_t numPoints) {
+  TargetTrajectories targetTrajectories(numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    targetTrajectories.timeTrajectory[i] = initTime + (finalTime - initTime) * i / (numPoints - 1);
+    targetTrajectories.stateTrajectory[i] = vector_t::Random(stateDim);
+    targetTrajectories.inputTrajectory[i] = vector_t::Random(inputDim);
+  }
+  return targetTrajectories;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_reference_manager_benchmark [options]\n"
+            << "  --numPoints <n>    number of points of the target trajectories (default: 100000)\n"
+            << "  --numRepeats <n>   number of repetitions (default: 10)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the update of the references in ReferenceManager::preSolverRun() by copy and by snapshot, and the cost evaluation on the
+ * nodes of a multiple-shooting horizon with the original and the sampled target trajectories. The mean times are printed.
+ */
+int main(int argc, char* argv[]) {
+  int numPoints = 100000;
+  int numRepeats = 10;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numPoints") {
+      numPoints = std::max(std::stoi(value), 2);
+    } else if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const vector_t initState = vector_t::Zero(stateDim);
+  const auto targetTrajectories = getRandomTargetTrajectories(numPoints);
+
+  // Reference update. The snapshots are kept alive by the producer, as in a publisher that shares its latest message.
+  ReferenceManager referenceManager;
+  FixedReferenceManager fixedReferenceManager;
+  benchmark::RepeatedTimer copyTimer;
+  benchmark::RepeatedTimer snapshotTimer;
+  benchmark::RepeatedTimer fixedSnapshotTimer;
+  std::vector<std::shared_ptr<const TargetTrajectories>> snapshots;
+  for (int i = 0; i < numRepeats; i++) {
+    copyTimer.startTimer();
+    referenceManager.setTargetTrajectories(targetTrajectories);
+    referenceManager.preSolverRun(initTime, finalTime, initState);
+    copyTimer.endTimer();
+  }
+  for (int i = 0; i < numRepeats; i++) {
+    snapshots.push_back(std::make_shared<const TargetTrajectories>(targetTrajectories));
+    snapshotTimer.startTimer();
+    referenceManager.setTargetTrajectoriesSnapshot(snapshots.back());
+    referenceManager.preSolverRun(initTime, finalTime, initState);
+    snapshotTimer.endTimer();
+
+    fixedSnapshotTimer.startTimer();
+    fixedReferenceManager.setTargetTrajectoriesSnapshot(snapshots.back());
+    fixedReferenceManager.preSolverRun(initTime, finalTime, initState);
+    fixedSnapshotTimer.endTimer();
+  }
+
+  // Cost evaluation on the nodes of a multiple-shooting solver
+  const matrix_t Q = matrix_t::Identity(stateDim, stateDim);
+  const matrix_t R = matrix_t::Identity(inputDim, inputDim);
+  const QuadraticStateInputCost cost(Q, R);
+  const PreComputation preComputation;
+  const auto nodeTime = toNodeTime(timeDiscretizationWithEvents(initTime, finalTime, 0.01, {0.25, 0.5, 0.75}));
+  const vector_t state = vector_t::Random(stateDim);
+  const vector_t input = vector_t::Random(inputDim);
+
+  TargetTrajectories sampledTargetTrajectories;
+  benchmark::RepeatedTimer samplingTimer;
+  benchmark::RepeatedTimer originalCostTimer;
+  benchmark::RepeatedTimer sampledCostTimer;
+  scalar_t originalCost = 0.0;
+  scalar_t sampledCost = 0.0;
+  for (int i = 0; i < numRepeats; i++) {
+    samplingTimer.startTimer();
+    sampleTargetTrajectories(fixedReferenceManager.getTargetTrajectories(), nodeTime, sampledTargetTrajectories);
+    samplingTimer.endTimer();
+
+    originalCostTimer.startTimer();
+    for (const auto t : nodeTime) {
+      originalCost += cost.getQuadraticApproximation(t, state, input, fixedReferenceManager.getTargetTrajectories(), preComputation).f;
+    }
+    originalCostTimer.endTimer();
+
+    sampledCostTimer.startTimer();
+    for (const auto t : nodeTime) {
+      sampledCost += cost.getQuadraticApproximation(t, state, input, sampledTargetTrajectories, preComputation).f;
+    }
+    sampledCostTimer.endTimer();
+  }
+
+  std::cout << "Reference update of a target with " << numPoints << " points, cost evaluation on " << nodeTime.size() << " nodes:\n";
+  std::cout << "  Update by copy:                  " << copyTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Update by snapshot:              " << snapshotTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Update by snapshot (no modify):  " << fixedSnapshotTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Sampling:                        " << samplingTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Cost with original target:       " << originalCostTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Cost with sampled target:        " << sampledCostTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cout << "  Total cost (original, sampled):  (" << originalCost << ", " << sampledCost << ")\n";
+
+  return 0;
+}
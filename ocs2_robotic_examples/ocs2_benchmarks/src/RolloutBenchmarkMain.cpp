@@ -0,0 +1,351 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include <ocs2_robotic_assets/package_path.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/package_path.h>
+#include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_cartpole/package_path.h>
+#include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_legged_robot/package_path.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** A rollout of a robotic example with a fixed linear controller. */
+struct RolloutProblem {
+  std::string name;
+  std::unique_ptr<SystemDynamicsBase> dynamicsPtr;
+  rollout::Settings settings;
+  vector_t initState;
+  scalar_t initTime;
+  scalar_t finalTime;
+  LinearController controller;
+  ModeSchedule modeSchedule;
+};
+
+/** Stable linear system with random feedback gains */
+RolloutProblem getLinearProblem() {
+  constexpr size_t stateDim = 12;
+  constexpr size_t inputDim = 4;
+  RolloutProblem problem;
+  problem.name = "linear";
+  problem.dynamicsPtr.reset(new LinearSystemDynamics(-matrix_t::Identity(stateDim, stateDim) + 0.1 * matrix_t::Random(stateDim, stateDim),
+                                                     matrix_t::Random(stateDim, inputDim)));
+  problem.settings.timeStep = 1e-2;
+  problem.settings.maxNumStepsPerSecond = 10000;
+  problem.initState = vector_t::Random(stateDim);
+  problem.initTime = 0.0;
+  problem.finalTime = 5.0;
+  problem.controller = LinearController({problem.initTime, problem.finalTime}, vector_array_t(2, vector_t::Zero(inputDim)),
+                                        matrix_array_t(2, -0.5 * matrix_t::Random(inputDim, stateDim).cwiseAbs()));
+  return problem;
+}
+
+RolloutProblem getBallbotProblem() {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  ballbot::BallbotInterface interface(taskFile, libFolder);
+
+  RolloutProblem problem;
+  problem.name = "ballbot";
+  problem.dynamicsPtr.reset(interface.getOptimalControlProblem().dynamicsPtr->clone());
+  problem.settings = rollout::loadSettings(taskFile, "rollout", false);
+  problem.initState = interface.getInitialState();
+  problem.initTime = 0.0;
+  problem.finalTime = 5.0;
+  problem.controller = LinearController({problem.initTime, problem.finalTime}, vector_array_t(2, vector_t::Zero(ballbot::INPUT_DIM)),
+                                        matrix_array_t(2, -0.1 * matrix_t::Ones(ballbot::INPUT_DIM, ballbot::STATE_DIM)));
+  return problem;
+}
+
+RolloutProblem getCartpoleProblem() {
+  const std::string taskFile = cartpole::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = cartpole::getPath() + "/auto_generated";
+  cartpole::CartPoleInterface interface(taskFile, libFolder, false /*verbose*/);
+
+  RolloutProblem problem;
+  problem.name = "cartpole";
+  problem.dynamicsPtr.reset(interface.getOptimalControlProblem().dynamicsPtr->clone());
+  problem.settings = rollout::loadSettings(taskFile, "rollout", false);
+  problem.initState = interface.getInitialState();
+  problem.initTime = 0.0;
+  problem.finalTime = 5.0;
+  problem.controller = LinearController({problem.initTime, problem.finalTime}, vector_array_t(2, vector_t::Zero(cartpole::INPUT_DIM)),
+                                        matrix_array_t(2, -0.1 * matrix_t::Ones(cartpole::INPUT_DIM, cartpole::STATE_DIM)));
+  return problem;
+}
+
+/** Standing with the weight compensating contact forces */
+RolloutProblem getLeggedRobotProblem() {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  legged_robot::LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+  const auto& info = interface.getCentroidalModelInfo();
+
+  RolloutProblem problem;
+  problem.name = "legged_robot";
+  problem.dynamicsPtr.reset(interface.getOptimalControlProblem().dynamicsPtr->clone());
+  problem.settings = interface.rolloutSettings();
+  problem.initState = interface.getInitialState();
+  problem.initTime = 0.0;
+  problem.finalTime = 1.0;
+  problem.modeSchedule = interface.getSwitchedModelReferenceManagerPtr()->getModeSchedule();
+
+  std::unique_ptr<Initializer> initializerPtr(interface.getInitializer().clone());
+  vector_t input, nextState;
+  initializerPtr->compute(problem.initTime, problem.initState, problem.finalTime, input, nextState);
+  problem.controller = LinearController({problem.initTime, problem.finalTime}, vector_array_t(2, input),
+                                        matrix_array_t(2, matrix_t::Zero(info.inputDim, info.stateDim)));
+  return problem;
+}
+
+RolloutProblem getRolloutProblem(const std::string& name) {
+  if (name == "linear") {
+    return getLinearProblem();
+  } else if (name == "ballbot") {
+    return getBallbotProblem();
+  } else if (name == "cartpole") {
+    return getCartpoleProblem();
+  } else if (name == "legged_robot") {
+    return getLeggedRobotProblem();
+  } else {
+    throw std::runtime_error("[getRolloutProblem] Unknown problem: " + name);
+  }
+}
+
+/**
+ * Rolls out the problem with the boost::odeint integrators ODE45 and RK4, and with the fixed-step RK4_OCS2. Prints the mean time of a
+ * rollout and the deviation of the final state from the RK4 rollout.
+ */
+void benchmarkIntegrators(RolloutProblem& problem, int numRuns) {
+  std::cout << "Rollout of " << problem.name << " over " << problem.finalTime - problem.initTime << " [s] with time step "
+            << problem.settings.timeStep << " [s]:\n";
+
+  vector_t referenceFinalState;
+  for (const auto integratorType : {IntegratorType::RK4, IntegratorType::RK4_OCS2, IntegratorType::ODE45}) {
+    auto settings = problem.settings;
+    settings.integratorType = integratorType;
+    TimeTriggeredRollout rollout(*problem.dynamicsPtr, settings);
+
+    benchmark::RepeatedTimer timer;
+    vector_t finalState;
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    for (int i = 0; i < numRuns; i++) {
+      auto modeSchedule = problem.modeSchedule;
+      timer.startTimer();
+      finalState = rollout.run(problem.initTime, problem.initState, problem.finalTime, &problem.controller, modeSchedule, timeTrajectory,
+                               postEventIndices, stateTrajectory, inputTrajectory);
+      timer.endTimer();
+    }
+
+    if (integratorType == IntegratorType::RK4) {
+      referenceFinalState = finalState;
+    }
+    std::cout << "  " << integrator_type::toString(integratorType) << ": " << timer.getAverageInMilliseconds()
+              << " [ms], final state deviation from RK4: " << (finalState - referenceFinalState).lpNorm<Eigen::Infinity>() << "\n";
+  }
+}
+
+/**
+ * Rolls out a batch of perturbed initial states one after the other with TimeTriggeredRollout and in lock-step with BatchRollout.
+ * Prints the throughput of each and the deviation of the final states of the last rollout.
+ */
+void benchmarkBatchRollout(RolloutProblem& problem, size_t batchSize, const std::vector<size_t>& numThreadsList) {
+  auto settings = problem.settings;
+  settings.integratorType = IntegratorType::RK4_OCS2;
+  std::cout << "Batch of " << batchSize << " rollouts of " << problem.name << ":\n";
+
+  vector_array_t initStates(batchSize, problem.initState);
+  for (auto& x : initStates) {
+    x += 0.05 * vector_t::Random(x.size());
+  }
+
+  TimeTriggeredRollout rollout(*problem.dynamicsPtr, settings);
+  benchmark::RepeatedTimer serialTimer;
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  serialTimer.startTimer();
+  for (const auto& x : initStates) {
+    auto modeSchedule = problem.modeSchedule;
+    rollout.run(problem.initTime, x, problem.finalTime, &problem.controller, modeSchedule, timeTrajectory, postEventIndices,
+                stateTrajectory, inputTrajectory);
+  }
+  serialTimer.endTimer();
+  std::cout << "  serial TimeTriggeredRollout: " << batchSize / (1e-3 * serialTimer.getTotalInMilliseconds()) << " [rollouts/s]\n";
+
+  for (const auto numThreads : numThreadsList) {
+    BatchRollout batchRollout(*problem.dynamicsPtr, settings, numThreads);
+    BatchRolloutTrajectories trajectories;
+    benchmark::RepeatedTimer batchTimer;
+    batchTimer.startTimer();
+    batchRollout.runBatch(problem.initTime, initStates, problem.finalTime, problem.controller, problem.modeSchedule, trajectories);
+    batchTimer.endTimer();
+    const vector_t finalStateDeviation = trajectories.getStateTrajectory(batchSize - 1).back() - stateTrajectory.back();
+    std::cout << "  BatchRollout with " << numThreads << " threads: " << batchSize / (1e-3 * batchTimer.getTotalInMilliseconds())
+              << " [rollouts/s], final state deviation: " << finalStateDeviation.lpNorm<Eigen::Infinity>() << "\n";
+  }
+}
+
+/**
+ * Solves the legged robot problem with SLQ for each number of rollout partitions and prints the mean time of a DDP iteration.
+ */
+void benchmarkDdpRolloutPartitions(const std::vector<size_t>& numRolloutPartitionsList, int numRuns) {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  legged_robot::LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+  const auto& info = interface.getCentroidalModelInfo();
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = interface.getInitialState();
+  interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({initTime}, {initState}, {vector_t::Zero(info.inputDim)}));
+
+  std::cout << "SLQ of legged_robot over " << finalTime - initTime << " [s]:\n";
+  for (const auto numRolloutPartitions : numRolloutPartitionsList) {
+    auto ddpSettings = interface.ddpSettings();
+    ddpSettings.numRolloutPartitions_ = numRolloutPartitions;
+    ddpSettings.displayInfo_ = false;
+    ddpSettings.displayShortSummary_ = false;
+    SLQ ddp(ddpSettings, interface.getRollout(), interface.getOptimalControlProblem(), interface.getInitializer());
+    ddp.setReferenceManager(interface.getReferenceManagerPtr());
+
+    benchmark::RepeatedTimer timer;
+    size_t numIterations = 0;
+    for (int i = 0; i < numRuns; i++) {
+      timer.startTimer();
+      ddp.run(initTime, initState, finalTime);
+      timer.endTimer();
+      numIterations += ddp.getNumIterations();
+    }
+    std::cout << "  " << numRolloutPartitions << " rollout partitions with " << ddpSettings.nThreads_
+              << " threads: " << timer.getTotalInMilliseconds() / std::max(numIterations, size_t(1))
+              << " [ms/iteration], cost: " << ddp.getPerformanceIndeces().cost << "\n";
+  }
+}
+
+std::vector<std::string> split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_rollout_benchmark [options]\n"
+            << "  --problems <a,b,...>   subset of the problems linear, ballbot, cartpole, legged_robot (default: all)\n"
+            << "  --numRuns <n>          number of rollouts per integrator (default: 20)\n"
+            << "  --batchSize <n>        number of rollouts in the batch (default: 1000)\n"
+            << "  --numThreads <a,b,...> thread counts of BatchRollout (default: 1,4)\n"
+            << "  --rolloutPartitions <a,b,...>\n"
+            << "                         rollout partitions of SLQ on legged_robot (default: 1,8)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the rollout time of the boost::odeint integrators with the fixed-step Runge-Kutta integrator of OCS2 on the robotic
+ * examples, and the throughput of BatchRollout with serial rollouts. For the legged robot, it also times SLQ iterations with different
+ * numbers of rollout partitions.
+ */
+int main(int argc, char* argv[]) {
+  std::vector<std::string> problemNames{"linear", "ballbot", "cartpole", "legged_robot"};
+  int numRuns = 20;
+  size_t batchSize = 1000;
+  std::vector<size_t> numThreadsList{1, 4};
+  std::vector<size_t> numRolloutPartitionsList{1, 8};
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--problems") {
+      problemNames = split(value);
+    } else if (option == "--numRuns") {
+      numRuns = std::max(std::stoi(value), 1);
+    } else if (option == "--batchSize") {
+      batchSize = std::max(std::stoi(value), 1);
+    } else if (option == "--numThreads") {
+      numThreadsList.clear();
+      for (const auto& numThreads : split(value)) {
+        numThreadsList.push_back(std::max(std::stoi(numThreads), 1));
+      }
+    } else if (option == "--rolloutPartitions") {
+      numRolloutPartitionsList.clear();
+      for (const auto& numRolloutPartitions : split(value)) {
+        numRolloutPartitionsList.push_back(std::max(std::stoi(numRolloutPartitions), 1));
+      }
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  for (const auto& name : problemNames) {
+    auto problem = getRolloutProblem(name);
+    benchmarkIntegrators(problem, numRuns);
+    benchmarkBatchRollout(problem, batchSize, numThreadsList);
+  }
+
+  if (std::find(problemNames.begin(), problemNames.end(), "legged_robot") != problemNames.end()) {
+    benchmarkDdpRolloutPartitions(numRolloutPartitionsList, numRuns);
+  }
+
+  return 0;
+}
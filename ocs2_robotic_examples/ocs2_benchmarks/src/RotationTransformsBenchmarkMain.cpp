@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_robotic_tools/common/RotationDerivativesTransforms.h>
+#include <ocs2_robotic_tools/common/RotationTransforms.h>
+#include <ocs2_robotic_tools/common/RotationTransformsBatch.h>
+
+using namespace ocs2;
+
+namespace {
+
+using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
+
+batch_array_t<scalar_t, 9> getRandomRotationMatrices(int batchSize) {
+  batch_array_t<scalar_t, 9> R(9, batchSize);
+  for (int i = 0; i < batchSize; ++i) {
+    const matrix3_t rotationMatrix = Eigen::Quaternion<scalar_t>::UnitRandom().toRotationMatrix();
+    R.col(i) = Eigen::Map<const Eigen::Matrix<scalar_t, 9, 1>>(rotationMatrix.data());
+  }
+  return R;
+}
+
+matrix3_t getMatrix(const batch_array_t<scalar_t, 9>& R, int i) {
+  return Eigen::Map<const matrix3_t>(Eigen::Matrix<scalar_t, 9, 1>(R.col(i)).data());
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_rotation_transforms_benchmark [options]\n"
+            << "  --batchSize <n>    number of rotations in the batch (default: 1000)\n"
+            << "  --numRepeats <n>   number of repetitions (default: 100)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the rotation error in world between ZYX Euler angles and reference rotation matrices, evaluated rotation by rotation with
+ * RotationTransforms and for the whole batch with RotationTransformsBatch. The mean times are printed.
+ */
+int main(int argc, char* argv[]) {
+  int batchSize = 1000;
+  int numRepeats = 100;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--batchSize") {
+      batchSize = std::max(std::stoi(value), 1);
+    } else if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const batch_array_t<scalar_t, 3> eulerAngles = M_PI * batch_array_t<scalar_t, 3>::Random(3, batchSize);
+  const auto Rref = getRandomRotationMatrices(batchSize);
+
+  benchmark::RepeatedTimer scalarTimer;
+  benchmark::RepeatedTimer batchTimer;
+  scalar_t scalarSum = 0.0;
+  scalar_t batchSum = 0.0;
+  for (int k = 0; k < numRepeats; ++k) {
+    scalarTimer.startTimer();
+    for (int i = 0; i < batchSize; ++i) {
+      const vector3_t euler = eulerAngles.col(i);
+      scalarSum += rotationErrorInWorld(getRotationMatrixFromZyxEulerAngles(euler), getMatrix(Rref, i)).sum();
+    }
+    scalarTimer.endTimer();
+
+    batchTimer.startTimer();
+    batchSum += rotationErrorInWorldBatch<scalar_t>(getRotationMatrixFromZyxEulerAnglesBatch<scalar_t>(eulerAngles), Rref).sum();
+    batchTimer.endTimer();
+  }
+
+  std::cout << "Rotation error in world of " << batchSize << " ZYX Euler angles:\n";
+  std::cout << "  scalar: " << 1e3 * scalarTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  batch:  " << 1e3 * batchTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  sum of errors (scalar, batch): (" << scalarSum << ", " << batchSum << ")\n";
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_self_collision/PinocchioGeometryInterface.h>
+#include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
+#include <ocs2_sphere_approximation/SphereDistance.h>
+#include <ocs2_sphere_approximation/SphereTree.h>
+
+using namespace ocs2;
+
+namespace {
+
+using vector3_t = SphereTree::vector3_t;
+
+struct RandomSpheres {
+  std::vector<vector3_t> centers;
+  scalar_array_t radii;
+};
+
+RandomSpheres getRandomSpheres(size_t numSpheres, std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> positionDistribution(-0.5, 0.5);
+  std::uniform_real_distribution<scalar_t> radiusDistribution(0.01, 0.05);
+  RandomSpheres spheres;
+  for (size_t i = 0; i < numSpheres; i++) {
+    spheres.centers.emplace_back(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+    spheres.radii.push_back(radiusDistribution(generator));
+  }
+  return spheres;
+}
+
+SphereTree::Pose getRandomPose(std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> positionDistribution(-1.0, 1.0);
+  std::uniform_real_distribution<scalar_t> quaternionDistribution(-1.0, 1.0);
+  const Eigen::Quaternion<scalar_t> q(quaternionDistribution(generator), quaternionDistribution(generator),
+                                      quaternionDistribution(generator), quaternionDistribution(generator));
+  return {q.normalized().toRotationMatrix(),
+          vector3_t(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator))};
+}
+
+batch_array_t<scalar_t, 3> toBatch(const std::vector<vector3_t>& positions) {
+  batch_array_t<scalar_t, 3> batch(3, positions.size());
+  for (size_t i = 0; i < positions.size(); i++) {
+    batch.col(i) = positions[i];
+  }
+  return batch;
+}
+
+/** Minimum distance between two random sphere sets with the sphere trees and by brute force over all sphere pairs. */
+void benchmarkTreeAgainstBruteForce(const std::vector<size_t>& numSpheresList, int numPoses) {
+  std::mt19937 generator(3);
+  std::cout << "Minimum distance between two sphere sets:\n";
+  for (const auto numSpheres : numSpheresList) {
+    const auto spheresA = getRandomSpheres(numSpheres, generator);
+    const auto spheresB = getRandomSpheres(numSpheres, generator);
+    const SphereTree treeA(spheresA.centers, spheresA.radii);
+    const SphereTree treeB(spheresB.centers, spheresB.radii);
+    const vector_t radiiA = Eigen::Map<const vector_t>(spheresA.radii.data(), numSpheres);
+    const vector_t radiiB = Eigen::Map<const vector_t>(spheresB.radii.data(), numSpheres);
+
+    benchmark::RepeatedTimer bruteForceTimer;
+    benchmark::RepeatedTimer treeTimer;
+    scalar_t maxError = 0.0;
+    for (int k = 0; k < numPoses; k++) {
+      const auto poseA = getRandomPose(generator);
+      const auto poseB = getRandomPose(generator);
+
+      bruteForceTimer.startTimer();
+      const auto centersA = sphere_distance::transformPositions(poseA, toBatch(spheresA.centers));
+      const auto centersB = sphere_distance::transformPositions(poseB, toBatch(spheresB.centers));
+      const scalar_t bruteForceDistance = sphere_distance::computeSphereSphereDistances(centersA, radiiA, centersB, radiiB).minCoeff();
+      bruteForceTimer.endTimer();
+
+      treeTimer.startTimer();
+      const auto result = sphere_distance::computeMinimumDistance(treeA, poseA, treeB, poseB);
+      treeTimer.endTimer();
+
+      maxError = std::max(maxError, std::abs(result.distance - bruteForceDistance));
+    }
+    std::cout << "  " << numSpheres << " spheres per set:\n";
+    std::cout << "    brute force: " << 1e3 * bruteForceTimer.getAverageInMilliseconds() << " [us]\n";
+    std::cout << "    sphere tree: " << 1e3 * treeTimer.getAverageInMilliseconds() << " [us]\n";
+    std::cout << "    max error:   " << maxError << "\n";
+  }
+}
+
+/** Distance between non-adjacent links of the mobile manipulator with the collision meshes and with the sphere trees. */
+void benchmarkTreeAgainstMesh(int numPoses) {
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+  const PinocchioInterface pinocchioInterface = getPinocchioInterfaceFromUrdfFile(urdfFile);
+  const std::vector<std::string> collisionLinks{"ARM", "SHOULDER", "FOREARM", "WRIST_1"};
+  const std::vector<scalar_t> maxExcesses{0.02, 0.02, 0.02, 0.02};
+  const PinocchioSphereInterface sphereInterface(pinocchioInterface, collisionLinks, maxExcesses, 0.7);
+
+  const std::vector<std::pair<size_t, size_t>> linkPairs{{0, 2}, {0, 3}, {1, 3}};
+  std::vector<PinocchioGeometryInterface> geometryInterfaces;
+  for (const auto& linkPair : linkPairs) {
+    geometryInterfaces.emplace_back(pinocchioInterface, std::vector<std::pair<std::string, std::string>>{
+                                                            {collisionLinks[linkPair.first], collisionLinks[linkPair.second]}});
+  }
+
+  PinocchioInterface pinocchioInterfaceCopy = pinocchioInterface;
+  const auto& model = pinocchioInterfaceCopy.getModel();
+  auto& data = pinocchioInterfaceCopy.getData();
+
+  benchmark::RepeatedTimer meshTimer;
+  benchmark::RepeatedTimer sphereTimer;
+  scalar_t maxError = 0.0;
+  for (int k = 0; k < numPoses; k++) {
+    const vector_t q = M_PI * vector_t::Random(model.nq);
+    pinocchio::forwardKinematics(model, data, q);
+
+    for (size_t p = 0; p < linkPairs.size(); p++) {
+      meshTimer.startTimer();
+      scalar_t meshDistance = std::numeric_limits<scalar_t>::max();
+      for (const auto& result : geometryInterfaces[p].computeDistances(pinocchioInterfaceCopy)) {
+        meshDistance = std::min(meshDistance, result.min_distance);
+      }
+      meshTimer.endTimer();
+
+      sphereTimer.startTimer();
+      const auto poses = sphereInterface.computeSphereTreePosesInWorldFrame(pinocchioInterfaceCopy);
+      const auto& trees = sphereInterface.getSphereTrees();
+      const size_t a = linkPairs[p].first;
+      const size_t b = linkPairs[p].second;
+      const scalar_t sphereDistance = sphere_distance::computeMinimumDistance(trees[a], poses[a], trees[b], poses[b]).distance;
+      sphereTimer.endTimer();
+
+      if (meshDistance > 0.0) {
+        maxError = std::max(maxError, meshDistance - sphereDistance);
+      }
+    }
+  }
+  std::cout << "Link pair distance of the mobile manipulator:\n";
+  std::cout << "  collision mesh: " << 1e3 * meshTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  sphere tree:    " << 1e3 * sphereTimer.getAverageInMilliseconds() << " [us]\n";
+  std::cout << "  max error:      " << maxError << " [m]\n";
+}
+
+std::vector<size_t> split(const std::string& list) {
+  std::vector<size_t> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(std::stoul(item));
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_sphere_distance_benchmark [options]\n"
+            << "  --numSpheres <a,b,...>   sphere set sizes (default: 10,30,100,300)\n"
+            << "  --numPoses <n>           number of random poses (default: 100)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the minimum distance query of SphereTree with the brute force over all sphere pairs, and with the distance of the collision
+ * meshes of the mobile manipulator links. The mean times and the largest deviations are printed.
+ */
+int main(int argc, char* argv[]) {
+  std::vector<size_t> numSpheresList{10, 30, 100, 300};
+  int numPoses = 100;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numSpheres") {
+      numSpheresList = split(value);
+    } else if (option == "--numPoses") {
+      numPoses = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  benchmarkTreeAgainstBruteForce(numSpheresList, numPoses);
+  benchmarkTreeAgainstMesh(numPoses);
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/LoadData.h>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+using namespace ocs2;
+using namespace benchmark;
+
+namespace {
+
+std::vector<std::string> split(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_startup_benchmark [options]\n"
+            << "  --problems <a,b,...>  subset of the problems (default: all)\n"
+            << "  --repetitions <n>     number of timed constructions per problem (default: 5)\n";
+}
+
+/** Constructs the interface of the problem and loads the solver settings, returns the elapsed time in [ms]. */
+scalar_t timeStartup(const std::string& problemName) {
+  const auto start = std::chrono::steady_clock::now();
+  getBenchmarkProblem(problemName);
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<scalar_t, std::milli>(finish - start).count();
+}
+
+}  // namespace
+
+/**
+ * Measures the start-up time of the robotic examples, i.e., the construction of their interface and the loading of the solver settings.
+ * Each construction is timed with an empty cache of parsed configuration files and with the files already parsed by the previous one.
+ */
+int main(int argc, char* argv[]) {
+  std::vector<std::string> problemNames = getBenchmarkProblemNames();
+  size_t repetitions = 5;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--problems") {
+      problemNames = split(value);
+    } else if (option == "--repetitions") {
+      repetitions = std::max(std::stoul(value), 1UL);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::cout << "problem, uncached mean [ms], uncached min [ms], cached mean [ms], cached min [ms]\n";
+  for (const auto& problemName : problemNames) {
+    std::vector<scalar_t> uncachedTimes, cachedTimes;
+    try {
+      // The first construction creates the code generated libraries if they do not exist yet.
+      getBenchmarkProblem(problemName);
+      for (size_t i = 0; i < repetitions; ++i) {
+        loadData::clearPropertyTreeCache();
+        uncachedTimes.push_back(timeStartup(problemName));
+        cachedTimes.push_back(timeStartup(problemName));
+      }
+    } catch (const std::exception& e) {
+      std::cerr << "[ocs2_startup_benchmark] Could not build " << problemName << ": " << e.what() << "\n";
+      continue;
+    }
+
+    auto mean = [](const std::vector<scalar_t>& times) { return std::accumulate(times.begin(), times.end(), 0.0) / times.size(); };
+    auto min = [](const std::vector<scalar_t>& times) { return *std::min_element(times.begin(), times.end()); };
+    std::cout << problemName << ", " << mean(uncachedTimes) << ", " << min(uncachedTimes) << ", " << mean(cachedTimes) << ", "
+              << min(cachedTimes) << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include <ocs2_anymal_mpc/AnymalInterface.h>
+#include <ocs2_switched_model_interface/core/MotionPhaseDefinition.h>
+#include <ocs2_switched_model_interface/foot_planner/SwingTrajectoryPlanner.h>
+#include <ocs2_switched_model_interface/terrain/PlanarTerrainModel.h>
+
+using namespace ocs2;
+
+namespace {
+
+constexpr scalar_t initTime = 0.0;
+constexpr scalar_t finalTime = 1.0;
+
+/** A trot that starts from stance and covers the horizon and the reference extension after it. */
+ModeSchedule getTrotModeSchedule(scalar_t endTime) {
+  constexpr scalar_t stanceTime = 0.2;
+  constexpr scalar_t swingTime = 0.3;
+  std::vector<scalar_t> eventTimes{stanceTime};
+  std::vector<size_t> modeSequence{switched_model::ModeNumber::STANCE, switched_model::ModeNumber::LF_RH};
+  while (eventTimes.back() < endTime) {
+    eventTimes.push_back(eventTimes.back() + swingTime);
+    modeSequence.push_back(modeSequence.back() == switched_model::ModeNumber::LF_RH ? switched_model::ModeNumber::RF_LH
+                                                                                     : switched_model::ModeNumber::LF_RH);
+  }
+  return {eventTimes, modeSequence};
+}
+
+/** Plans the swing motions numRepeats times and prints the average time of the planner stages. */
+void runPlanner(const switched_model::QuadrupedInterface& interface, switched_model::SwingTrajectoryPlannerSettings settings,
+                size_t nThreads, int numRepeats) {
+  settings.nThreads = nThreads;
+  switched_model::SwingTrajectoryPlanner planner(settings, interface.getKinematicModel(), interface.getInverseKinematicModelPtr());
+  planner.updateTerrain(std::make_unique<switched_model::PlanarTerrainModel>(switched_model::TerrainPlane()));
+
+  const vector_t initialState = interface.getInitialState();
+  vector_t stepTarget = initialState;
+  stepTarget(3) += 0.3;
+  const TargetTrajectories targetTrajectories({initTime, finalTime}, {initialState, stepTarget},
+                                              {vector_t::Zero(switched_model::INPUT_DIM), vector_t::Zero(switched_model::INPUT_DIM)});
+  const auto modeSchedule = getTrotModeSchedule(finalTime + settings.referenceExtensionAfterHorizon);
+  const switched_model::comkino_state_t currentState = initialState;
+
+  benchmark::RepeatedTimer plannerTimer;
+  for (int i = 0; i < numRepeats; i++) {
+    plannerTimer.startTimer();
+    planner.updateSwingMotions(initTime, finalTime, currentState, targetTrajectories, modeSchedule);
+    plannerTimer.endTimer();
+  }
+
+  std::cout << "nThreads: " << nThreads << "\tupdateSwingMotions: " << plannerTimer.getAverageInMilliseconds() << " [ms]";
+  std::cout << planner.getBenchmarkingInformation() << "\n";
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_swing_planner_benchmark [options]\n"
+            << "  --nThreads <n>     number of planner threads compared to the sequential planner (default: 4)\n"
+            << "  --numRepeats <n>   number of repetitions (default: 1000)\n";
+}
+
+}  // namespace
+
+/**
+ * Plans the swing motions of the anymal_c task for a trot on flat terrain, with the sequential planner and with the given number of
+ * planner threads. The mean time of updateSwingMotions and of the foothold selection, swing generation and inverse kinematics stages
+ * are printed.
+ */
+int main(int argc, char* argv[]) {
+  size_t nThreads = 4;
+  int numRepeats = 1000;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--nThreads") {
+      nThreads = std::max(std::stoi(value), 1);
+    } else if (option == "--numRepeats") {
+      numRepeats = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const std::string configName = "c_series";
+  const auto interfacePtr =
+      anymal::getAnymalInterface(anymal::getUrdfString(anymal::AnymalModel::Camel), anymal::getConfigFolder(configName));
+  const auto settings = switched_model::loadSwingTrajectorySettings(anymal::getTaskFilePath(configName), false);
+
+  runPlanner(*interfacePtr, settings, 1, numRepeats);
+  if (nThreads > 1) {
+    runPlanner(*interfacePtr, settings, nThreads, numRepeats);
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ddp/PackedValueFunctionTrajectory.h>
+
+using namespace ocs2;
+
+namespace {
+
+using value_function_array_t = std::vector<ScalarFunctionQuadraticApproximation>;
+
+value_function_array_t getRandomValueFunctionTrajectory(size_t numNodes, int stateDim) {
+  value_function_array_t valueFunctionTrajectory(numNodes);
+  for (auto& valueFunction : valueFunctionTrajectory) {
+    valueFunction.f = vector_t::Random(1)(0);
+    valueFunction.dfdx = vector_t::Random(stateDim);
+    const matrix_t A = matrix_t::Random(stateDim, stateDim);
+    valueFunction.dfdxx = A * A.transpose();
+  }
+  return valueFunctionTrajectory;
+}
+
+/** The interpolation of GaussNewtonDDP::getValueFunctionImpl, without the re-centering. */
+void interpolateDense(LinearInterpolation::index_alpha_t indexAlpha, const value_function_array_t& valueFunctionTrajectory,
+                      ScalarFunctionQuadraticApproximation& valueFunction) {
+  using Array = value_function_array_t;
+  valueFunction.f = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                     +[](const Array& vec, size_t ind) -> const scalar_t& { return vec[ind].f; });
+  valueFunction.dfdx = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                        +[](const Array& vec, size_t ind) -> const vector_t& { return vec[ind].dfdx; });
+  valueFunction.dfdxx = LinearInterpolation::interpolate(indexAlpha, valueFunctionTrajectory,
+                                                         +[](const Array& vec, size_t ind) -> const matrix_t& { return vec[ind].dfdxx; });
+}
+
+size_t denseMemoryInBytes(const value_function_array_t& valueFunctionTrajectory) {
+  size_t memory = valueFunctionTrajectory.capacity() * sizeof(ScalarFunctionQuadraticApproximation);
+  for (const auto& valueFunction : valueFunctionTrajectory) {
+    memory += (valueFunction.dfdx.size() + valueFunction.dfdxx.size()) * sizeof(scalar_t);
+  }
+  return memory;
+}
+
+void printUsage() {
+  std::cerr << "Usage: ocs2_value_function_cache_benchmark [options]\n"
+            << "  --numNodes <n>     number of nodes of the value function trajectory (default: 500)\n"
+            << "  --stateDim <n>     state dimension (default: 36)\n"
+            << "  --numQueries <n>   number of interpolation queries (default: 2000)\n";
+}
+
+}  // namespace
+
+/**
+ * Compares the memory, the packing time and the interpolation time of the value function cache of GaussNewtonDDP in the dense format
+ * and in the packed format of PackedValueFunctionTrajectory in double and single precision (ddp.compactValueFunctionCache and
+ * ddp.singlePrecisionValueFunctionCache).
+ */
+int main(int argc, char* argv[]) {
+  size_t numNodes = 500;
+  int stateDim = 36;
+  size_t numQueries = 2000;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string option(argv[i]);
+    if (i + 1 >= argc) {
+      printUsage();
+      return 1;
+    }
+    const std::string value(argv[++i]);
+    if (option == "--numNodes") {
+      numNodes = std::max(std::stoi(value), 2);
+    } else if (option == "--stateDim") {
+      stateDim = std::max(std::stoi(value), 1);
+    } else if (option == "--numQueries") {
+      numQueries = std::max(std::stoi(value), 1);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const auto valueFunctionTrajectory = getRandomValueFunctionTrajectory(numNodes, stateDim);
+  scalar_array_t timeTrajectory(numNodes);
+  for (size_t k = 0; k < numNodes; k++) {
+    timeTrajectory[k] = 0.01 * k;
+  }
+
+  PackedValueFunctionTrajectory packedDouble(false);
+  PackedValueFunctionTrajectory packedFloat(true);
+  benchmark::RepeatedTimer packDoubleTimer;
+  benchmark::RepeatedTimer packFloatTimer;
+  for (int i = 0; i < 10; i++) {
+    packDoubleTimer.startTimer();
+    packedDouble.pack(valueFunctionTrajectory);
+    packDoubleTimer.endTimer();
+    packFloatTimer.startTimer();
+    packedFloat.pack(valueFunctionTrajectory);
+    packFloatTimer.endTimer();
+  }
+
+  benchmark::RepeatedTimer denseTimer;
+  benchmark::RepeatedTimer packedDoubleTimer;
+  benchmark::RepeatedTimer packedFloatTimer;
+  ScalarFunctionQuadraticApproximation denseValueFunction;
+  ScalarFunctionQuadraticApproximation packedValueFunction;
+  scalar_t maxDoubleError = 0.0;
+  scalar_t maxFloatError = 0.0;
+  for (size_t i = 0; i < numQueries; i++) {
+    const scalar_t time = timeTrajectory.back() * static_cast<scalar_t>(i) / numQueries;
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, timeTrajectory);
+
+    denseTimer.startTimer();
+    interpolateDense(indexAlpha, valueFunctionTrajectory, denseValueFunction);
+    denseTimer.endTimer();
+
+    packedDoubleTimer.startTimer();
+    packedDouble.interpolate(indexAlpha, packedValueFunction);
+    packedDoubleTimer.endTimer();
+    maxDoubleError = std::max(maxDoubleError, (packedValueFunction.dfdxx - denseValueFunction.dfdxx).lpNorm<Eigen::Infinity>());
+
+    packedFloatTimer.startTimer();
+    packedFloat.interpolate(indexAlpha, packedValueFunction);
+    packedFloatTimer.endTimer();
+    maxFloatError = std::max(maxFloatError, (packedValueFunction.dfdxx - denseValueFunction.dfdxx).lpNorm<Eigen::Infinity>());
+  }
+
+  std::cout << "Value function trajectory with " << numNodes << " nodes and state dimension " << stateDim << ":\n";
+  std::cout << "  memory [kB]:        dense " << denseMemoryInBytes(valueFunctionTrajectory) / 1024 << ", packed double "
+            << packedDouble.memoryInBytes() / 1024 << ", packed float " << packedFloat.memoryInBytes() / 1024 << "\n";
+  std::cout << "  pack [ms]:          double " << packDoubleTimer.getAverageInMilliseconds() << ", float "
+            << packFloatTimer.getAverageInMilliseconds() << "\n";
+  std::cout << "  interpolate [us]:   dense " << 1e3 * denseTimer.getAverageInMilliseconds() << ", packed double "
+            << 1e3 * packedDoubleTimer.getAverageInMilliseconds() << ", packed float " << 1e3 * packedFloatTimer.getAverageInMilliseconds()
+            << "\n";
+  std::cout << "  max error of dfdxx: packed double " << maxDoubleError << ", packed float " << maxFloatError << "\n";
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+#include "ocs2_benchmarks/LatencyHistogram.h"
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+using namespace ocs2;
+using namespace benchmark;
+
+TEST(testLatencyHistogram, percentiles) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(histogram.getStatistics().count, 0);
+  ASSERT_DOUBLE_EQ(histogram.getPercentile(50.0), 0.0);
+
+  // Added in reverse order to check that the samples are sorted
+  for (int i = 100; i > 0; --i) {
+    histogram.addSample(static_cast<scalar_t>(i));
+  }
+
+  const auto statistics = histogram.getStatistics();
+  EXPECT_EQ(statistics.count, 100);
+  EXPECT_DOUBLE_EQ(statistics.mean, 50.5);
+  EXPECT_DOUBLE_EQ(statistics.median, 50.0);
+  EXPECT_DOUBLE_EQ(statistics.percentile90, 90.0);
+  EXPECT_DOUBLE_EQ(statistics.percentile99, 99.0);
+  EXPECT_DOUBLE_EQ(statistics.max, 100.0);
+  EXPECT_DOUBLE_EQ(histogram.getPercentile(0.0), 1.0);
+  EXPECT_DOUBLE_EQ(histogram.getPercentile(100.0), 100.0);
+}
+
+TEST(testMpcBenchmark, writeLoadAndCompare) {
+  LatencyStatistics statistics;
+  statistics.count = 10;
+  statistics.mean = 1.5;
+  statistics.median = 1.25;
+  statistics.percentile90 = 2.0;
+  statistics.percentile99 = 3.0;
+  statistics.max = 3.5;
+
+  std::vector<MpcBenchmarkResult> results(2);
+  results[0] = {"problemA", MpcSolver::DDP, {{"tracking", "advanceMpc", statistics}, {"tracking", "updatePolicy", statistics}}};
+  results[1] = {"problemB", MpcSolver::IPM, {{"targetChange", "advanceMpc", statistics}}};
+
+  const std::string filePath = "/tmp/ocs2_mpc_benchmark_test.csv";
+  writeResults(filePath, results);
+  const auto loadedResults = loadResults(filePath);
+  std::remove(filePath.c_str());
+
+  ASSERT_EQ(loadedResults.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(loadedResults[i].problem, results[i].problem);
+    EXPECT_EQ(loadedResults[i].solver, results[i].solver);
+    ASSERT_EQ(loadedResults[i].measurements.size(), results[i].measurements.size());
+    for (size_t j = 0; j < results[i].measurements.size(); ++j) {
+      const auto& loaded = loadedResults[i].measurements[j];
+      EXPECT_EQ(loaded.phase, results[i].measurements[j].phase);
+      EXPECT_EQ(loaded.operation, results[i].measurements[j].operation);
+      EXPECT_EQ(loaded.statistics.count, statistics.count);
+      EXPECT_DOUBLE_EQ(loaded.statistics.median, statistics.median);
+      EXPECT_DOUBLE_EQ(loaded.statistics.percentile99, statistics.percentile99);
+    }
+  }
+
+  std::stringstream report;
+  EXPECT_TRUE(compareResults(results, loadedResults, 0.1, report));
+
+  // Regression of the 99th percentile
+  auto regressedResults = results;
+  regressedResults[1].measurements[0].statistics.percentile99 *= 1.5;
+  EXPECT_FALSE(compareResults(results, regressedResults, 0.1, report));
+  EXPECT_TRUE(compareResults(results, regressedResults, 0.6, report));
+
+  // Missing measurement
+  regressedResults.pop_back();
+  EXPECT_FALSE(compareResults(results, regressedResults, 0.6, report));
+}
+
+TEST(testMpcBenchmark, doubleIntegrator) {
+  const auto problem = getBenchmarkProblem("double_integrator");
+  const auto result = runMpcBenchmark(problem, MpcSolver::DDP);
+
+  // firstSolve and the scripted phases, each with advanceMpc and updatePolicy
+  ASSERT_EQ(result.measurements.size(), 2 * (problem.phases.size() + 1));
+  EXPECT_EQ(result.measurements[0].phase, "firstSolve");
+  EXPECT_EQ(result.measurements[0].statistics.count, 1);
+  for (size_t i = 0; i < problem.phases.size(); ++i) {
+    const auto& measurement = result.measurements[2 * (i + 1)];
+    EXPECT_EQ(measurement.phase, problem.phases[i].name);
+    EXPECT_EQ(measurement.operation, "advanceMpc");
+    EXPECT_EQ(measurement.statistics.count, static_cast<size_t>(std::round(problem.phases[i].duration / problem.timeStep)));
+    EXPECT_LE(measurement.statistics.median, measurement.statistics.percentile99);
+    EXPECT_LE(measurement.statistics.percentile99, measurement.statistics.max);
+  }
+}
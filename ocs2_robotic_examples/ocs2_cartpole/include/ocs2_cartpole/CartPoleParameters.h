@@ -56,8 +56,8 @@ struct CartPoleParameters {
 
   /** Loads the Cart-Pole's parameters. */
   void loadSettings(const std::string& filename, const std::string& fieldName, bool verbose = true) {
-    boost::property_tree::ptree pt;
-    boost::property_tree::read_info(filename, pt);
+    const auto ptPtr = loadData::getPropertyTree(filename);
+    const auto& pt = *ptPtr;
     if (verbose) {
       std::cerr << "\n #### Cart-pole Parameters:";
       std::cerr << "\n #### =============================================================================\n";
@@ -35,10 +35,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include <ocs2_core/augmented_lagrangian/AugmentedLagrangian.h>
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/penalties/Penalties.h>
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
 #include <ocs2_oc/synchronized_module/SolverObserver.h>
 
 #include "ocs2_cartpole/CartPoleInterface.h"
@@ -241,3 +243,47 @@ INSTANTIATE_TEST_CASE_P(TestCaseCartpole, TestCartpole,
                                          testing::ValuesIn({PenaltyType::SlacknessSquaredHingePenalty,
                                                             PenaltyType::ModifiedRelaxedBarrierPenalty})),
                         testName);
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST(Cartpole, BatchRollout) {
+  const std::string taskFile = ocs2::cartpole::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ocs2::cartpole::getPath() + "/auto_generated";
+  CartPoleInterface cartPoleInterface(taskFile, libFolder, false /*verbose*/);
+  const auto& dynamics = *cartPoleInterface.getOptimalControlProblem().dynamicsPtr;
+
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 5.0;
+  const scalar_array_t controllerTimes{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Zero(INPUT_DIM));
+  const matrix_array_t k(2, -0.1 * matrix_t::Ones(INPUT_DIM, STATE_DIM));
+  LinearController controller(controllerTimes, uff, k);
+  ModeSchedule modeSchedule;
+
+  // perturbed initial states
+  constexpr size_t batchSize = 10;
+  vector_array_t initStates(batchSize, cartPoleInterface.getInitialState());
+  for (auto& x : initStates) {
+    x += 0.1 * vector_t::Random(STATE_DIM);
+  }
+
+  auto settings = rollout::loadSettings(taskFile, "rollout", false);
+  settings.integratorType = IntegratorType::RK4_OCS2;
+
+  TimeTriggeredRollout rollout(dynamics, settings);
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  for (const auto& x : initStates) {
+    rollout.run(initTime, x, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+  }
+
+  for (size_t numThreads : {1, 4}) {
+    BatchRollout batchRollout(dynamics, settings, numThreads);
+    BatchRolloutTrajectories trajectories;
+    batchRollout.runBatch(initTime, initStates, finalTime, controller, modeSchedule, trajectories);
+    EXPECT_TRUE(trajectories.getStateTrajectory(batchSize - 1).back().isApprox(stateTrajectory.back(), 1e-9));
+  }
+}
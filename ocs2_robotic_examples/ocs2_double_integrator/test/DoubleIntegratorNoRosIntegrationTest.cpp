@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ExecuteAndSleep.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MPC_Pipeline_Interface.h>
 
 using namespace ocs2;
 using namespace double_integrator;
@@ -208,4 +209,59 @@ TEST_F(DoubleIntegratorIntegrationTest, asynchronousTracking) {
 
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
+
+TEST_F(DoubleIntegratorIntegrationTest, pipelinedTracking) {
+  // Each instance needs its own solver and ReferenceManager
+  constexpr size_t numInstances = 2;
+  std::vector<std::unique_ptr<DoubleIntegratorInterface>> interfaces;
+  std::vector<std::unique_ptr<GaussNewtonDDP_MPC>> mpcInstances;
+  for (size_t i = 0; i < numInstances; ++i) {
+    const std::string taskFile = ocs2::double_integrator::getPath() + "/config/mpc/task.info";
+    const std::string libFolder = ocs2::double_integrator::getPath() + "/auto_generated";
+    interfaces.emplace_back(new DoubleIntegratorInterface(taskFile, libFolder, false));
+    auto& interface = *interfaces.back();
+    mpcInstances.emplace_back(new GaussNewtonDDP_MPC(interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(),
+                                                     interface.getOptimalControlProblem(), interface.getInitializer()));
+    mpcInstances.back()->getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  }
+  MPC_Pipeline_Interface mpcPipeline({mpcInstances[0].get(), mpcInstances[1].get()});
+  mpcPipeline.setTargetTrajectories(TargetTrajectories({initTime}, {goalState}, {vector_t::Zero(INPUT_DIM)}));
+
+  const scalar_t f_mrt = 100;
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+
+  // Wait for the first policy
+  mpcPipeline.setCurrentObservation(observation);
+  mpcPipeline.start();
+  while (!mpcPipeline.initialPolicyReceived()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // run MRT
+  scalar_t lastPolicyStartTime = initTime;
+  while (observation.time < finalTime) {
+    ocs2::executeAndSleep(
+        [&]() {
+          observation.time += 1.0 / f_mrt;
+
+          // Evaluate the policy, the start time of the published policies should never decrease
+          mpcPipeline.updatePolicy();
+          EXPECT_GE(mpcPipeline.getCommand().mpcInitObservation_.time, lastPolicyStartTime);
+          lastPolicyStartTime = mpcPipeline.getCommand().mpcInitObservation_.time;
+          mpcPipeline.evaluatePolicy(observation.time, vector_t::Zero(STATE_DIM), observation.state, observation.input, observation.mode);
+
+          // use optimal state for the next observation:
+          mpcPipeline.setCurrentObservation(observation);
+        },
+        f_mrt);
+  }
+
+  mpcPipeline.stop();
+  EXPECT_GT(mpcPipeline.getNumPublishedPolicies(), 0);
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
 #endif
@@ -294,8 +294,8 @@ std::unique_ptr<StateInputCost> LeggedRobotInterface::getBaseTrackingCost(const
 /******************************************************************************************************/
 std::pair<scalar_t, RelaxedBarrierPenalty::Config> LeggedRobotInterface::loadFrictionConeSettings(const std::string& taskFile,
                                                                                                   bool verbose) const {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(taskFile, pt);
+  const auto ptPtr = loadData::getPropertyTree(taskFile);
+  const auto& pt = *ptPtr;
   const std::string prefix = "frictionConeSoftConstraint.";
 
   scalar_t frictionCoefficient = 1.0;
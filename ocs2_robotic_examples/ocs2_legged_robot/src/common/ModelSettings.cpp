@@ -40,20 +40,19 @@ namespace legged_robot {
 ModelSettings loadModelSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
   ModelSettings modelSettings;
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  loadData::ConfigLoader loader(filename, fieldName, verbose);
 
   if (verbose) {
     std::cerr << "\n #### Legged Robot Model Settings:";
     std::cerr << "\n #### =============================================================================\n";
   }
 
-  loadData::loadPtreeValue(pt, modelSettings.positionErrorGain, fieldName + ".positionErrorGain", verbose);
-  loadData::loadPtreeValue(pt, modelSettings.phaseTransitionStanceTime, fieldName + ".phaseTransitionStanceTime", verbose);
+  loader.load("positionErrorGain", modelSettings.positionErrorGain);
+  loader.load("phaseTransitionStanceTime", modelSettings.phaseTransitionStanceTime);
 
-  loadData::loadPtreeValue(pt, modelSettings.verboseCppAd, fieldName + ".verboseCppAd", verbose);
-  loadData::loadPtreeValue(pt, modelSettings.recompileLibrariesCppAd, fieldName + ".recompileLibrariesCppAd", verbose);
-  loadData::loadPtreeValue(pt, modelSettings.modelFolderCppAd, fieldName + ".modelFolderCppAd", verbose);
+  loader.load("verboseCppAd", modelSettings.verboseCppAd);
+  loader.load("recompileLibrariesCppAd", modelSettings.recompileLibrariesCppAd);
+  loader.load("modelFolderCppAd", modelSettings.modelFolderCppAd);
 
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
@@ -222,8 +222,8 @@ scalar_t SwingTrajectoryPlanner::swingTrajectoryScaling(scalar_t startTime, scal
 /******************************************************************************************************/
 /******************************************************************************************************/
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(fileName, pt);
+  const auto ptPtr = loadData::getPropertyTree(fileName);
+  const auto& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### Swing Trajectory Config:";
@@ -0,0 +1,208 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <ocs2_core/thread_support/ExecuteAndSleep.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MPC_Pipeline_Interface.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+struct ControlLoopStatistics {
+  scalar_t meanPolicyDelay = 0.0;  // [ms]
+  scalar_t maxPolicyDelay = 0.0;   // [ms]
+  scalar_t meanTrackingError = 0.0;
+  scalar_t maxTrackingError = 0.0;
+};
+
+std::unique_ptr<LeggedRobotInterface> getLeggedRobotInterface() {
+  const std::string taskFile = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+  return std::make_unique<LeggedRobotInterface>(taskFile, urdfFile, referenceFile);
+}
+
+std::unique_ptr<GaussNewtonDDP_MPC> getMpc(const LeggedRobotInterface& interface, size_t nThreads) {
+  auto ddpSettings = interface.ddpSettings();
+  ddpSettings.nThreads_ = nThreads;
+  ddpSettings.displayInfo_ = false;
+  ddpSettings.displayShortSummary_ = false;
+  auto mpcPtr = std::make_unique<GaussNewtonDDP_MPC>(interface.mpcSettings(), std::move(ddpSettings), interface.getRollout(),
+                                                     interface.getOptimalControlProblem(), interface.getInitializer());
+  mpcPtr->getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+  return mpcPtr;
+}
+
+/**
+ * Runs a simulated real-time control loop at the MRT frequency of the task file. The plant is simulated by rolling out the latest policy
+ * from the measured state, and the base is pushed once by a velocity disturbance. The policy delay is the age of the observation which
+ * the active policy started from, and the tracking error is the distance between the simulated state and the state of the policy.
+ * startMpc is called once the initial observation is set.
+ */
+ControlLoopStatistics runControlLoop(MRT_BASE& mrt, const LeggedRobotInterface& interface, scalar_t duration,
+                                     const std::function<void()>& startMpc) {
+  const scalar_t f_mrt = interface.mpcSettings().mrtDesiredFrequency_;
+  const scalar_t initTime = 0.0;
+  const scalar_t disturbanceTime = 0.5 * duration;
+  const size_t inputDim = interface.getCentroidalModelInfo().inputDim;
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = interface.getInitialState();
+  observation.input.setZero(inputDim);
+  mrt.initRollout(&interface.getRollout());
+  mrt.setCurrentObservation(observation);
+  startMpc();
+  while (!mrt.initialPolicyReceived()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  ControlLoopStatistics statistics;
+  size_t numSamples = 0;
+  bool isDisturbed = false;
+  while (observation.time < initTime + duration) {
+    ocs2::executeAndSleep(
+        [&]() {
+          mrt.updatePolicy();
+
+          // Simulate the plant
+          vector_t nextState, policyState;
+          mrt.rolloutPolicy(observation.time, observation.state, 1.0 / f_mrt, nextState, observation.input, observation.mode);
+          observation.time += 1.0 / f_mrt;
+          observation.state = nextState;
+          if (!isDisturbed && observation.time >= disturbanceTime) {
+            observation.state(0) += 0.5;  // push along the x axis
+            isDisturbed = true;
+          }
+
+          // Statistics, the simulated time advances in real time
+          vector_t policyInput;
+          size_t policyMode;
+          mrt.evaluatePolicy(observation.time, observation.state, policyState, policyInput, policyMode);
+          const scalar_t policyDelay = 1e3 * (observation.time - mrt.getCommand().mpcInitObservation_.time);
+          const scalar_t trackingError = (observation.state - policyState).norm();
+          statistics.meanPolicyDelay += policyDelay;
+          statistics.maxPolicyDelay = std::max(statistics.maxPolicyDelay, policyDelay);
+          statistics.meanTrackingError += trackingError;
+          statistics.maxTrackingError = std::max(statistics.maxTrackingError, trackingError);
+          ++numSamples;
+
+          mrt.setCurrentObservation(observation);
+        },
+        f_mrt);
+  }
+
+  statistics.meanPolicyDelay /= numSamples;
+  statistics.meanTrackingError /= numSamples;
+  return statistics;
+}
+
+void printStatistics(const std::string& name, const ControlLoopStatistics& statistics) {
+  std::cout << "[LeggedRobotMpcPipeline] " << name << "\n"
+            << "\tpolicy delay: " << statistics.meanPolicyDelay << " (max " << statistics.maxPolicyDelay << ") [ms]\n"
+            << "\ttracking error: " << statistics.meanTrackingError << " (max " << statistics.maxTrackingError << ")\n";
+}
+
+}  // namespace
+
+#ifdef NDEBUG
+TEST(LeggedRobotMpcPipeline, PolicyDelayAndTrackingError) {
+  constexpr scalar_t duration = 3.0;
+  constexpr size_t numThreads = 4;
+  constexpr size_t numInstances = 2;
+
+  // Single solver with all threads, run as fast as possible in its own thread
+  ControlLoopStatistics singleSolverStatistics;
+  {
+    const auto interfacePtr = getLeggedRobotInterface();
+    const auto initState = interfacePtr->getInitialState();
+    interfacePtr->getReferenceManagerPtr()->setTargetTrajectories(
+        TargetTrajectories({0.0}, {initState}, {vector_t::Zero(interfacePtr->getCentroidalModelInfo().inputDim)}));
+    auto mpcPtr = getMpc(*interfacePtr, numThreads);
+    MPC_MRT_Interface mpcInterface(*mpcPtr);
+
+    std::atomic_bool mpcRunning{true};
+    std::thread mpcThread;
+    singleSolverStatistics = runControlLoop(mpcInterface, *interfacePtr, duration, [&]() {
+      mpcThread = std::thread([&]() {
+        while (mpcRunning) {
+          mpcInterface.advanceMpc();
+        }
+      });
+    });
+    mpcRunning = false;
+    mpcThread.join();
+  }
+
+  // Pipeline with the threads split over the instances
+  ControlLoopStatistics pipelineStatistics;
+  {
+    std::vector<std::unique_ptr<LeggedRobotInterface>> interfaces;
+    std::vector<std::unique_ptr<GaussNewtonDDP_MPC>> mpcInstances;
+    std::vector<MPC_BASE*> mpcPtrs;
+    for (size_t i = 0; i < numInstances; ++i) {
+      interfaces.push_back(getLeggedRobotInterface());
+      mpcInstances.push_back(getMpc(*interfaces.back(), numThreads / numInstances));
+      mpcPtrs.push_back(mpcInstances.back().get());
+    }
+    const auto initState = interfaces.front()->getInitialState();
+    MPC_Pipeline_Interface mpcPipeline(mpcPtrs);
+    mpcPipeline.setTargetTrajectories(
+        TargetTrajectories({0.0}, {initState}, {vector_t::Zero(interfaces.front()->getCentroidalModelInfo().inputDim)}));
+
+    pipelineStatistics = runControlLoop(mpcPipeline, *interfaces.front(), duration, [&]() { mpcPipeline.start(); });
+    mpcPipeline.stop();
+
+    EXPECT_GT(mpcPipeline.getNumPublishedPolicies(), 0);
+    std::cout << "[LeggedRobotMpcPipeline] pipeline solve time: " << mpcPipeline.getAverageSolveTimeInMilliseconds()
+              << " [ms], published: " << mpcPipeline.getNumPublishedPolicies() << ", dropped: " << mpcPipeline.getNumDroppedPolicies()
+              << "\n";
+  }
+
+  printStatistics("single solver, " + std::to_string(numThreads) + " threads", singleSolverStatistics);
+  printStatistics("pipeline, " + std::to_string(numInstances) + " x " + std::to_string(numThreads / numInstances) + " threads",
+                  pipelineStatistics);
+  EXPECT_LT(pipelineStatistics.maxTrackingError, 1.0);
+}
+#endif
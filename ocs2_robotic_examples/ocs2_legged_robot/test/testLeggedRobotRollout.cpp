@@ -0,0 +1,84 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+TEST(LeggedRobotRollout, RolloutIntegrators) {
+  const std::string taskFile = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+  const auto& dynamics = *interface.getOptimalControlProblem().dynamicsPtr;
+  const auto& info = interface.getCentroidalModelInfo();
+
+  // Standing with the weight compensating contact forces
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = interface.getInitialState();
+  std::unique_ptr<Initializer> initializerPtr(interface.getInitializer().clone());
+  vector_t input, nextState;
+  initializerPtr->compute(initTime, initState, finalTime, input, nextState);
+  const scalar_array_t controllerTimes{initTime, finalTime};
+  const vector_array_t uff(2, input);
+  const matrix_array_t k(2, matrix_t::Zero(info.inputDim, info.stateDim));
+  LinearController controller(controllerTimes, uff, k);
+
+  auto settings = interface.rolloutSettings();
+  vector_t referenceFinalState;
+  for (const auto integratorType : {IntegratorType::RK4, IntegratorType::RK4_OCS2}) {
+    settings.integratorType = integratorType;
+    TimeTriggeredRollout rollout(dynamics, settings);
+
+    auto modeSchedule = interface.getSwitchedModelReferenceManagerPtr()->getModeSchedule();
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    const vector_t finalState = rollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                                            stateTrajectory, inputTrajectory);
+
+    if (integratorType == IntegratorType::RK4) {
+      referenceFinalState = finalState;
+    } else {
+      EXPECT_TRUE(finalState.isApprox(referenceFinalState, 1e-9));
+    }
+  }
+}
@@ -187,8 +187,8 @@ ManipulatorModelInfo createManipulatorModelInfo(const PinocchioInterface& interf
 /******************************************************************************************************/
 /******************************************************************************************************/
 ManipulatorModelType loadManipulatorType(const std::string& configFilePath, const std::string& fieldName) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(configFilePath, pt);
+  const auto ptPtr = loadData::getPropertyTree(configFilePath);
+  const auto& pt = *ptPtr;
   const size_t type = pt.template get<size_t>(fieldName);
   return static_cast<ManipulatorModelType>(type);
 }
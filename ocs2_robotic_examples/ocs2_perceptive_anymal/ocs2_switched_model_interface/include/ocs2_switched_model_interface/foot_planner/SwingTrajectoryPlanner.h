@@ -5,7 +5,9 @@
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_switched_model_interface/core/InverseKinematicsModelBase.h"
 #include "ocs2_switched_model_interface/core/KinematicsModelBase.h"
@@ -41,6 +43,9 @@ struct SwingTrajectoryPlannerSettings {
   scalar_t maximumReferenceSampleTime = 0.05;     // if the reference trajectory has samples with longer intervals, it will be subsampled.
 
   bool swingTrajectoryFromReference = false;  // Flag to take the swing trajectory from the reference trajectory
+
+  size_t nThreads = 1;      // Number of threads (including the calling thread) to plan legs and terrain queries. 1 plans sequentially.
+  int threadPriority = 50;  // Priority of the planner worker threads, only used for nThreads > 1
 };
 
 SwingTrajectoryPlannerSettings loadSwingTrajectorySettings(const std::string& filename, bool verbose = true);
@@ -77,24 +82,47 @@ class SwingTrajectoryPlanner {
   // Read settings
   const SwingTrajectoryPlannerSettings& settings() const { return settings_; }
 
+  // Average timing of the planner stages, reported by the swing planner benchmark
+  std::string getBenchmarkingInformation() const;
+
  private:
+  /** Terrain query of a nominal foothold. Collected for all legs first, such that the queries can be evaluated in parallel. */
+  struct NominalFootholdQuery {
+    int leg;
+    size_t contactIndex;  // Index into nominalFootholdsPerLeg_[leg]
+    vector3_t referenceFootholdPositionInWorld;
+    std::function<scalar_t(const vector3_t&)> scoringFunction;
+    bool convexTerrain;  // Otherwise only the terrain plane is needed
+  };
+
+  // Runs task(workerId, i) for i in [0, N), on the planner threads if there are any and sequentially otherwise
+  void runParallel(int N, const std::function<void(int, int)>& task);
+
   void updateLastContact(int leg, scalar_t expectedLiftOff, const vector3_t& currentFootPosition, const TerrainModel& terrainModel);
 
   std::pair<std::vector<scalar_t>, std::vector<std::unique_ptr<FootPhase>>> generateSwingTrajectories(
       int leg, const std::vector<ContactTiming>& contactTimings, scalar_t finalTime) const;
 
   std::pair<std::vector<scalar_t>, std::vector<std::unique_ptr<FootPhase>>> extractSwingTrajectoriesFromReference(
-      int leg, const std::vector<ContactTiming>& contactTimings, scalar_t finalTime) const;
+      int leg, const std::vector<ContactTiming>& contactTimings, scalar_t finalTime,
+      const KinematicsModelBase<scalar_t>& kinematicsModel) const;
 
   std::vector<vector3_t> selectHeuristicFootholds(int leg, const std::vector<ContactTiming>& contactTimings,
                                                   const ocs2::TargetTrajectories& targetTrajectories, scalar_t initTime,
-                                                  const comkino_state_t& currentState, scalar_t finalTime) const;
+                                                  const comkino_state_t& currentState, scalar_t finalTime,
+                                                  const KinematicsModelBase<scalar_t>& kinematicsModel) const;
 
+  // Returns the nominal foothold terrain per contact. Terrain that requires a terrain query is left default and added to the queries.
   std::vector<ConvexTerrain> selectNominalFootholdTerrain(int leg, const std::vector<ContactTiming>& contactTimings,
                                                           const std::vector<vector3_t>& heuristicFootholds,
                                                           const ocs2::TargetTrajectories& targetTrajectories, scalar_t initTime,
                                                           const comkino_state_t& currentState, scalar_t finalTime,
-                                                          const TerrainModel& terrainModel) const;
+                                                          const KinematicsModelBase<scalar_t>& kinematicsModel,
+                                                          std::vector<NominalFootholdQuery>& queries) const;
+
+  // Evaluates the queries in order. The convex terrain queries go through the batch interface of the terrain model.
+  std::vector<ConvexTerrain> evaluateNominalFootholdQueries(const std::vector<const NominalFootholdQuery*>& queries,
+                                                            const TerrainModel& terrainModel) const;
 
   void applySwingMotionScaling(SwingPhase::SwingEvent& liftOff, SwingPhase::SwingEvent& touchDown,
                                SwingPhase::SwingProfile& swingProfile) const;
@@ -104,7 +132,8 @@ class SwingTrajectoryPlanner {
   // Apply IK to cartesian swing motion to update joint references
   void adaptJointReferencesWithInverseKinematics(scalar_t finalTime);
 
-  std::unique_ptr<ExternalSwingPhase> extractExternalSwingPhase(int leg, scalar_t liftOffTime, scalar_t touchDownTime) const;
+  std::unique_ptr<ExternalSwingPhase> extractExternalSwingPhase(int leg, scalar_t liftOffTime, scalar_t touchDownTime,
+                                                                const KinematicsModelBase<scalar_t>& kinematicsModel) const;
 
   SwingPhase::SwingProfile getDefaultSwingProfile() const;
 
@@ -115,8 +144,8 @@ class SwingTrajectoryPlanner {
   vector3_t filterFoothold(const vector3_t& newFoothold, const vector3_t& previousFoothold) const;
 
   SwingTrajectoryPlannerSettings settings_;
-  std::unique_ptr<KinematicsModelBase<scalar_t>> kinematicsModel_;
-  std::unique_ptr<InverseKinematicsModelBase> inverseKinematicsModelPtr_;
+  std::vector<std::unique_ptr<KinematicsModelBase<scalar_t>>> kinematicsModels_;      // one per worker
+  std::vector<std::unique_ptr<InverseKinematicsModelBase>> inverseKinematicsModels_;  // one per worker, empty without inverse kinematics
 
   feet_array_t<std::pair<scalar_t, TerrainPlane>> lastContacts_;
   feet_array_t<std::vector<std::unique_ptr<FootPhase>>> feetNormalTrajectories_;
@@ -127,6 +156,14 @@ class SwingTrajectoryPlanner {
   std::unique_ptr<TerrainModel> terrainModel_;
 
   ocs2::TargetTrajectories targetTrajectories_;
+
+  // Only created for nThreads > 1. The planner runs in the reference manager, which has no access to the solver threads.
+  std::unique_ptr<ocs2::ThreadPool> threadPoolPtr_;
+
+  // Benchmarking
+  ocs2::benchmark::RepeatedTimer footholdSelectionTimer_;
+  ocs2::benchmark::RepeatedTimer swingGenerationTimer_;
+  ocs2::benchmark::RepeatedTimer inverseKinematicsTimer_;
 };
 
 }  // namespace switched_model
@@ -41,6 +41,20 @@ class TerrainModel {
     return {getLocalTerrainAtPositionInWorldAlongGravity(positionInWorld, std::move(penaltyFunction)), {}};
   }
 
+  /// Batch version of getConvexTerrainAtPositionInWorld with one penalty function per query. Penalty functions need to return values >= 0
+  virtual std::vector<ConvexTerrain> getConvexTerrainAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+    if (positionsInWorld.size() != penaltyFunctions.size()) {
+      throw std::runtime_error("[TerrainModel] The number of positions and penalty functions must be equal");
+    }
+    std::vector<ConvexTerrain> convexTerrains;
+    convexTerrains.reserve(positionsInWorld.size());
+    for (size_t i = 0; i < positionsInWorld.size(); ++i) {
+      convexTerrains.push_back(getConvexTerrainAtPositionInWorld(positionsInWorld[i], penaltyFunctions[i]));
+    }
+    return convexTerrains;
+  }
+
   /** Returns the signed distance field for this terrain if one is available */
   virtual const SignedDistanceField* getSignedDistanceField() const { return nullptr; }
 
@@ -28,8 +28,8 @@ Algorithm fromAlgorithmName(std::string name) {
 ModelSettings loadModelSettings(const std::string& filename, bool verbose) {
   ModelSettings modelSettings;
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = ocs2::loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   const std::string prefix{"model_settings."};
 
@@ -100,8 +100,8 @@ ocs2::ad_vector_t MotionTrackingCost::costVectorFunction(ocs2::ad_scalar_t time,
 MotionTrackingCost::Weights loadWeightsFromFile(const std::string& filename, const std::string& fieldname, bool verbose) {
   MotionTrackingCost::Weights weights;
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = ocs2::loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### Tacking Cost Weights:" << std::endl;
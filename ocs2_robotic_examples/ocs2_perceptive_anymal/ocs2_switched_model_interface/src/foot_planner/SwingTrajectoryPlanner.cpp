@@ -4,6 +4,9 @@
 
 #include "ocs2_switched_model_interface/foot_planner/SwingTrajectoryPlanner.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/Lookup.h>
 
@@ -16,15 +19,65 @@ namespace switched_model {
 SwingTrajectoryPlanner::SwingTrajectoryPlanner(SwingTrajectoryPlannerSettings settings,
                                                const KinematicsModelBase<scalar_t>& kinematicsModel,
                                                const InverseKinematicsModelBase* inverseKinematicsModelPtr)
-    : settings_(std::move(settings)),
-      kinematicsModel_(kinematicsModel.clone()),
-      inverseKinematicsModelPtr_(nullptr),
-      terrainModel_(nullptr) {
-  if (inverseKinematicsModelPtr != nullptr) {
-    inverseKinematicsModelPtr_.reset(inverseKinematicsModelPtr->clone());
+    : settings_(std::move(settings)), terrainModel_(nullptr) {
+  if (settings_.nThreads > 1) {
+    threadPoolPtr_.reset(new ocs2::ThreadPool(settings_.nThreads - 1, settings_.threadPriority));
+  }
+
+  // The kinematics models are not thread safe. Clone them to have one for each worker.
+  const size_t numWorkers = std::max(settings_.nThreads, size_t(1));
+  for (size_t w = 0; w < numWorkers; w++) {
+    kinematicsModels_.emplace_back(kinematicsModel.clone());
+    if (inverseKinematicsModelPtr != nullptr) {
+      inverseKinematicsModels_.emplace_back(inverseKinematicsModelPtr->clone());
+    }
   }
 }
 
+std::string SwingTrajectoryPlanner::getBenchmarkingInformation() const {
+  const auto footholdSelectionTotal = footholdSelectionTimer_.getTotalInMilliseconds();
+  const auto swingGenerationTotal = swingGenerationTimer_.getTotalInMilliseconds();
+  const auto inverseKinematicsTotal = inverseKinematicsTimer_.getTotalInMilliseconds();
+
+  const auto benchmarkTotal = footholdSelectionTotal + swingGenerationTotal + inverseKinematicsTotal;
+
+  std::stringstream infoStream;
+  if (benchmarkTotal > 0.0) {
+    const scalar_t inPercent = 100.0;
+    infoStream << "\n########################################################################\n";
+    infoStream << "The benchmarking is computed over " << footholdSelectionTimer_.getNumTimedIntervals() << " updates. \n";
+    infoStream << "Swing Planner Benchmarking :\tAverage time [ms]   (% of total runtime)\n";
+    infoStream << "\tFoothold Selection :\t" << footholdSelectionTimer_.getAverageInMilliseconds() << " [ms] \t\t("
+               << footholdSelectionTotal / benchmarkTotal * inPercent << "%)\n";
+    infoStream << "\tSwing Generation   :\t" << swingGenerationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
+               << swingGenerationTotal / benchmarkTotal * inPercent << "%)\n";
+    if (inverseKinematicsTimer_.getNumTimedIntervals() > 0) {
+      infoStream << "\tInverse Kinematics :\t" << inverseKinematicsTimer_.getAverageInMilliseconds() << " [ms] \t\t("
+                 << inverseKinematicsTotal / benchmarkTotal * inPercent << "%)\n";
+    }
+  }
+  return infoStream.str();
+}
+
+void SwingTrajectoryPlanner::runParallel(int N, const std::function<void(int, int)>& task) {
+  if (!threadPoolPtr_) {
+    for (int i = 0; i < N; i++) {
+      task(0, i);
+    }
+    return;
+  }
+
+  std::atomic_int index{0};
+  auto parallelTask = [&](int workerId) {
+    int i = index++;
+    while (i < N) {
+      task(workerId, i);
+      i = index++;
+    }
+  };
+  threadPoolPtr_->runParallel(std::move(parallelTask), settings_.nThreads);
+}
+
 void SwingTrajectoryPlanner::updateTerrain(std::unique_ptr<TerrainModel> terrainModel) {
   terrainModel_ = std::move(terrainModel);
 }
@@ -53,9 +106,14 @@ void SwingTrajectoryPlanner::updateSwingMotions(scalar_t initTime, scalar_t fina
   const feet_array_t<std::vector<ContactTiming>> contactTimingsPerLeg = extractContactTimingsPerLeg(modeSchedule);
 
   const auto basePose = getBasePose(currentState);
-  const auto feetPositions = kinematicsModel_->feetPositionsInOriginFrame(basePose, getJointPositions(currentState));
-
-  for (int leg = 0; leg < NUM_CONTACT_POINTS; leg++) {
+  const auto feetPositions = kinematicsModels_.front()->feetPositionsInOriginFrame(basePose, getJointPositions(currentState));
+
+  // All per-leg tasks below only write to the data of their own leg and use the kinematics models of their worker, such that the result
+  // does not depend on the number of threads.
+  footholdSelectionTimer_.startTimer();
+  feet_array_t<std::vector<NominalFootholdQuery>> nominalFootholdQueriesPerLeg;
+  runParallel(NUM_CONTACT_POINTS, [&](int workerId, int leg) {
+    const auto& kinematicsModel = *kinematicsModels_[workerId];
     const auto& contactTimings = contactTimingsPerLeg[leg];
 
     // Update last contacts
@@ -76,24 +134,51 @@ void SwingTrajectoryPlanner::updateSwingMotions(scalar_t initTime, scalar_t fina
     }
 
     // Select heuristic footholds.
-    heuristicFootholdsPerLeg_[leg] = selectHeuristicFootholds(leg, contactTimings, targetTrajectories, initTime, currentState, finalTime);
+    heuristicFootholdsPerLeg_[leg] =
+        selectHeuristicFootholds(leg, contactTimings, targetTrajectories, initTime, currentState, finalTime, kinematicsModel);
 
-    // Select terrain constraints based on the heuristic footholds.
+    // Select terrain constraints based on the heuristic footholds. Terrain queries are collected and evaluated for all legs at once.
     nominalFootholdsPerLeg_[leg] = selectNominalFootholdTerrain(leg, contactTimings, heuristicFootholdsPerLeg_[leg], targetTrajectories,
-                                                                initTime, currentState, finalTime, *terrainModel_);
+                                                                initTime, currentState, finalTime, kinematicsModel,
+                                                                nominalFootholdQueriesPerLeg[leg]);
+  });
+
+  // Evaluate the terrain queries of all legs and contacts. Each worker evaluates a contiguous chunk of the queries as one batch.
+  std::vector<const NominalFootholdQuery*> nominalFootholdQueries;
+  for (const auto& legQueries : nominalFootholdQueriesPerLeg) {
+    for (const auto& query : legQueries) {
+      nominalFootholdQueries.push_back(&query);
+    }
+  }
+  const int numQueries = static_cast<int>(nominalFootholdQueries.size());
+  const int numChunks = std::min(static_cast<int>(kinematicsModels_.size()), numQueries);
+  runParallel(numChunks, [&](int, int chunk) {
+    const std::vector<const NominalFootholdQuery*> chunkQueries(nominalFootholdQueries.begin() + chunk * numQueries / numChunks,
+                                                                nominalFootholdQueries.begin() + (chunk + 1) * numQueries / numChunks);
+    auto convexTerrains = evaluateNominalFootholdQueries(chunkQueries, *terrainModel_);
+    for (size_t i = 0; i < chunkQueries.size(); ++i) {
+      nominalFootholdsPerLeg_[chunkQueries[i]->leg][chunkQueries[i]->contactIndex] = std::move(convexTerrains[i]);
+    }
+  });
+  footholdSelectionTimer_.endTimer();
 
-    // Create swing trajectories
+  // Create swing trajectories
+  swingGenerationTimer_.startTimer();
+  runParallel(NUM_CONTACT_POINTS, [&](int workerId, int leg) {
     if (settings_.swingTrajectoryFromReference) {
       std::tie(feetNormalTrajectoriesEvents_[leg], feetNormalTrajectories_[leg]) =
-          extractSwingTrajectoriesFromReference(leg, contactTimings, finalTime);
+          extractSwingTrajectoriesFromReference(leg, contactTimingsPerLeg[leg], finalTime, *kinematicsModels_[workerId]);
     } else {
       std::tie(feetNormalTrajectoriesEvents_[leg], feetNormalTrajectories_[leg]) =
-          generateSwingTrajectories(leg, contactTimings, finalTime);
+          generateSwingTrajectories(leg, contactTimingsPerLeg[leg], finalTime);
     }
-  }
+  });
+  swingGenerationTimer_.endTimer();
 
-  if (inverseKinematicsModelPtr_ && !settings_.swingTrajectoryFromReference) {
+  if (!inverseKinematicsModels_.empty() && !settings_.swingTrajectoryFromReference) {
+    inverseKinematicsTimer_.startTimer();
     adaptJointReferencesWithInverseKinematics(finalTime);
+    inverseKinematicsTimer_.endTimer();
   }
 }
 
@@ -168,7 +253,8 @@ auto SwingTrajectoryPlanner::generateSwingTrajectories(int leg, const std::vecto
 }
 
 std::pair<std::vector<scalar_t>, std::vector<std::unique_ptr<FootPhase>>> SwingTrajectoryPlanner::extractSwingTrajectoriesFromReference(
-    int leg, const std::vector<ContactTiming>& contactTimings, scalar_t finalTime) const {
+    int leg, const std::vector<ContactTiming>& contactTimings, scalar_t finalTime,
+    const KinematicsModelBase<scalar_t>& kinematicsModel) const {
   std::vector<scalar_t> eventTimes;
   std::vector<std::unique_ptr<FootPhase>> footPhases;
 
@@ -183,7 +269,7 @@ std::pair<std::vector<scalar_t>, std::vector<std::unique_ptr<FootPhase>>> SwingT
       }
     }();
 
-    footPhases.push_back(extractExternalSwingPhase(leg, liftOffTime, touchDownTime));
+    footPhases.push_back(extractExternalSwingPhase(leg, liftOffTime, touchDownTime, kinematicsModel));
   }
 
   // Loop through contact phases
@@ -219,7 +305,7 @@ std::pair<std::vector<scalar_t>, std::vector<std::unique_ptr<FootPhase>>> SwingT
     }();
 
     eventTimes.push_back(currentContactTiming.end);
-    footPhases.push_back(extractExternalSwingPhase(leg, liftOffTime, touchDownTime));
+    footPhases.push_back(extractExternalSwingPhase(leg, liftOffTime, touchDownTime, kinematicsModel));
   }
 
   return std::make_pair(eventTimes, std::move(footPhases));
@@ -246,8 +332,8 @@ void SwingTrajectoryPlanner::applySwingMotionScaling(SwingPhase::SwingEvent& lif
   }
 }
 
-std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwingPhase(int leg, scalar_t liftOffTime,
-                                                                                      scalar_t touchDownTime) const {
+std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwingPhase(
+    int leg, scalar_t liftOffTime, scalar_t touchDownTime, const KinematicsModelBase<scalar_t>& kinematicsModel) const {
   std::vector<scalar_t> time;
   std::vector<vector3_t> positions;
   std::vector<vector3_t> velocities;
@@ -260,8 +346,8 @@ std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwing
     const vector_t state = ocs2::LinearInterpolation::interpolate(liftoffIndex, targetTrajectories_.stateTrajectory);
     const vector_t input = ocs2::LinearInterpolation::interpolate(liftoffIndex, targetTrajectories_.inputTrajectory);
     time.push_back(liftOffTime);
-    positions.push_back(kinematicsModel_->footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
-    velocities.push_back(kinematicsModel_->footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
+    positions.push_back(kinematicsModel.footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
+    velocities.push_back(kinematicsModel.footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
                                                                      getJointPositions(state), getJointVelocities(input)));
   }
 
@@ -269,8 +355,8 @@ std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwing
   for (int k = liftoffIndex.first + 1; k < touchdownIndex.first; ++k) {
     const auto& state = targetTrajectories_.stateTrajectory[k];
     time.push_back(targetTrajectories_.timeTrajectory[k]);
-    positions.push_back(kinematicsModel_->footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
-    velocities.push_back(kinematicsModel_->footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
+    positions.push_back(kinematicsModel.footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
+    velocities.push_back(kinematicsModel.footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
                                                                      getJointPositions(state),
                                                                      getJointVelocities(targetTrajectories_.inputTrajectory[k])));
   }
@@ -280,8 +366,8 @@ std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwing
     const vector_t state = ocs2::LinearInterpolation::interpolate(touchdownIndex, targetTrajectories_.stateTrajectory);
     const vector_t input = ocs2::LinearInterpolation::interpolate(touchdownIndex, targetTrajectories_.inputTrajectory);
     time.push_back(touchDownTime);
-    positions.push_back(kinematicsModel_->footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
-    velocities.push_back(kinematicsModel_->footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
+    positions.push_back(kinematicsModel.footPositionInOriginFrame(leg, getBasePose(state), getJointPositions(state)));
+    velocities.push_back(kinematicsModel.footVelocityInOriginFrame(leg, getBasePose(state), getBaseLocalVelocities(state),
                                                                      getJointPositions(state), getJointVelocities(input)));
   }
 
@@ -291,7 +377,8 @@ std::unique_ptr<ExternalSwingPhase> SwingTrajectoryPlanner::extractExternalSwing
 std::vector<vector3_t> SwingTrajectoryPlanner::selectHeuristicFootholds(int leg, const std::vector<ContactTiming>& contactTimings,
                                                                         const ocs2::TargetTrajectories& targetTrajectories,
                                                                         scalar_t initTime, const comkino_state_t& currentState,
-                                                                        scalar_t finalTime) const {
+                                                                        scalar_t finalTime,
+                                                                        const KinematicsModelBase<scalar_t>& kinematicsModel) const {
   // Zmp preparation : measured state
   const auto initBasePose = getBasePose(currentState);
   const auto initBaseOrientation = getOrientation(initBasePose);
@@ -331,7 +418,7 @@ std::vector<vector3_t> SwingTrajectoryPlanner::selectHeuristicFootholds(int leg,
       const vector_t state = targetTrajectories.getDesiredState(middleContactTime);
       const auto desiredBasePose = getBasePose(state);
       const auto desiredJointPositions = getJointPositions(state);
-      vector3_t referenceFootholdPositionInWorld = kinematicsModel_->footPositionInOriginFrame(leg, desiredBasePose, desiredJointPositions);
+      vector3_t referenceFootholdPositionInWorld = kinematicsModel.footPositionInOriginFrame(leg, desiredBasePose, desiredJointPositions);
 
       // Add ZMP offset to the first upcoming foothold.
       if (contactCount == 0) {
@@ -357,7 +444,8 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
                                                                                 const ocs2::TargetTrajectories& targetTrajectories,
                                                                                 scalar_t initTime, const comkino_state_t& currentState,
                                                                                 scalar_t finalTime,
-                                                                                const TerrainModel& terrainModel) const {
+                                                                                const KinematicsModelBase<scalar_t>& kinematicsModel,
+                                                                                std::vector<NominalFootholdQuery>& queries) const {
   // Will increment the heuristic each time after selecting a nominalFootholdTerrain
   auto heuristicFootholdIt = heuristicFootholds.cbegin();
   std::vector<ConvexTerrain> nominalFootholdTerrain;
@@ -396,30 +484,25 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
 
         // Kinematic penalty
         const base_coordinate_t basePoseAtTouchdown = getBasePose(targetTrajectories.getDesiredState(contactPhase.start));
-        const auto hipPositionInWorldTouchdown = kinematicsModel_->legRootInOriginFrame(leg, basePoseAtTouchdown);
-        const auto hipOrientationInWorldTouchdown = kinematicsModel_->orientationLegRootToOriginFrame(leg, basePoseAtTouchdown);
+        const auto hipPositionInWorldTouchdown = kinematicsModel.legRootInOriginFrame(leg, basePoseAtTouchdown);
+        const auto hipOrientationInWorldTouchdown = kinematicsModel.orientationLegRootToOriginFrame(leg, basePoseAtTouchdown);
         const base_coordinate_t basePoseAtLiftoff = getBasePose(targetTrajectories.getDesiredState(contactEndTime));
-        const auto hipPositionInWorldLiftoff = kinematicsModel_->legRootInOriginFrame(leg, basePoseAtLiftoff);
-        const auto hipOrientationInWorldLiftoff = kinematicsModel_->orientationLegRootToOriginFrame(leg, basePoseAtLiftoff);
+        const auto hipPositionInWorldLiftoff = kinematicsModel.legRootInOriginFrame(leg, basePoseAtLiftoff);
+        const auto hipOrientationInWorldLiftoff = kinematicsModel.orientationLegRootToOriginFrame(leg, basePoseAtLiftoff);
         ApproximateKinematicsConfig config;
         config.kinematicPenaltyWeight = settings_.legOverExtensionPenalty;
         config.maxLegExtension = settings_.nominalLegExtension;
-        auto scoringFunction = [&](const vector3_t& footPositionInWorld) {
+        auto scoringFunction = [=](const vector3_t& footPositionInWorld) {
           return computeKinematicPenalty(footPositionInWorld, hipPositionInWorldTouchdown, hipOrientationInWorldTouchdown, config) +
                  computeKinematicPenalty(footPositionInWorld, hipPositionInWorldLiftoff, hipOrientationInWorldLiftoff, config);
         };
 
-        if (contactPhase.start < finalTime) {
-          ConvexTerrain convexTerrain = terrainModel.getConvexTerrainAtPositionInWorld(referenceFootholdPositionInWorld, scoringFunction);
-          nominalFootholdTerrain.push_back(convexTerrain);
-          ++heuristicFootholdIt;
-        } else {  // After the horizon -> we are only interested in the position and orientation
-          ConvexTerrain convexTerrain;
-          convexTerrain.plane =
-              terrainModel.getLocalTerrainAtPositionInWorldAlongGravity(referenceFootholdPositionInWorld, scoringFunction);
-          nominalFootholdTerrain.push_back(convexTerrain);
-          ++heuristicFootholdIt;
-        }
+        // After the horizon -> we are only interested in the position and orientation
+        const bool convexTerrain = contactPhase.start < finalTime;
+        queries.push_back(
+            {leg, nominalFootholdTerrain.size(), referenceFootholdPositionInWorld, std::move(scoringFunction), convexTerrain});
+        nominalFootholdTerrain.emplace_back();
+        ++heuristicFootholdIt;
       }
 
       // Can stop for this leg if we have processed one contact phase after (or extending across) the horizon
@@ -432,6 +515,35 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
   return nominalFootholdTerrain;
 }
 
+std::vector<ConvexTerrain> SwingTrajectoryPlanner::evaluateNominalFootholdQueries(const std::vector<const NominalFootholdQuery*>& queries,
+                                                                                  const TerrainModel& terrainModel) const {
+  std::vector<ConvexTerrain> convexTerrains(queries.size());
+
+  std::vector<size_t> convexQueryIndices;
+  std::vector<vector3_t> convexQueryPositions;
+  std::vector<std::function<scalar_t(const vector3_t&)>> convexQueryScoringFunctions;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const auto& query = *queries[i];
+    if (query.convexTerrain) {
+      convexQueryIndices.push_back(i);
+      convexQueryPositions.push_back(query.referenceFootholdPositionInWorld);
+      convexQueryScoringFunctions.push_back(query.scoringFunction);
+    } else {
+      convexTerrains[i].plane =
+          terrainModel.getLocalTerrainAtPositionInWorldAlongGravity(query.referenceFootholdPositionInWorld, query.scoringFunction);
+    }
+  }
+
+  if (!convexQueryIndices.empty()) {
+    auto batchConvexTerrains = terrainModel.getConvexTerrainAtPositionsInWorld(convexQueryPositions, convexQueryScoringFunctions);
+    for (size_t k = 0; k < convexQueryIndices.size(); ++k) {
+      convexTerrains[convexQueryIndices[k]] = std::move(batchConvexTerrains[k]);
+    }
+  }
+
+  return convexTerrains;
+}
+
 void SwingTrajectoryPlanner::subsampleReferenceTrajectory(const ocs2::TargetTrajectories& targetTrajectories, scalar_t initTime,
                                                           scalar_t finalTime) {
   if (targetTrajectories.empty()) {
@@ -439,10 +551,11 @@ void SwingTrajectoryPlanner::subsampleReferenceTrajectory(const ocs2::TargetTraj
   }
 
   targetTrajectories_.clear();
+  ocs2::LinearInterpolation::TimeSegmentCursor timeSegmentCursor(targetTrajectories.timeTrajectory);
 
   // Add first reference
   {
-    const auto initInterpIndex = ocs2::LinearInterpolation::timeSegment(initTime, targetTrajectories.timeTrajectory);
+    const auto initInterpIndex = timeSegmentCursor.timeSegment(initTime);
     targetTrajectories_.timeTrajectory.push_back(initTime);
     targetTrajectories_.stateTrajectory.push_back(
         ocs2::LinearInterpolation::interpolate(initInterpIndex, targetTrajectories.stateTrajectory));
@@ -466,7 +579,7 @@ void SwingTrajectoryPlanner::subsampleReferenceTrajectory(const ocs2::TargetTraj
     // Check if we need to add extra intermediate samples
     while (targetTrajectories_.timeTrajectory.back() + settings_.maximumReferenceSampleTime < targetTrajectories.timeTrajectory[k]) {
       const scalar_t t = targetTrajectories_.timeTrajectory.back() + settings_.maximumReferenceSampleTime;
-      const auto interpIndex = ocs2::LinearInterpolation::timeSegment(t, targetTrajectories.timeTrajectory);
+      const auto interpIndex = timeSegmentCursor.timeSegment(t);
 
       targetTrajectories_.timeTrajectory.push_back(t);
       targetTrajectories_.stateTrajectory.push_back(
@@ -485,7 +598,17 @@ void SwingTrajectoryPlanner::subsampleReferenceTrajectory(const ocs2::TargetTraj
 void SwingTrajectoryPlanner::adaptJointReferencesWithInverseKinematics(scalar_t finalTime) {
   const scalar_t damping = 0.01;  // Quite some damping on the IK to get well conditions references.
 
-  for (int k = 0; k < targetTrajectories_.timeTrajectory.size(); ++k) {
+  // Adapt all points up to and including the first point beyond the horizon.
+  const auto& timeTrajectory = targetTrajectories_.timeTrajectory;
+  const auto firstPointBeyondHorizon =
+      std::find_if(timeTrajectory.begin(), timeTrajectory.end(), [finalTime](scalar_t t) { return t > finalTime; });
+  const int numPoints = static_cast<int>(std::min(std::distance(timeTrajectory.begin(), firstPointBeyondHorizon) + 1,
+                                                  static_cast<std::ptrdiff_t>(timeTrajectory.size())));
+
+  // Each point is adapted independently
+  runParallel(numPoints, [&](int workerId, int k) {
+    const auto& kinematicsModel = *kinematicsModels_[workerId];
+    const auto& inverseKinematicsModel = *inverseKinematicsModels_[workerId];
     const scalar_t t = targetTrajectories_.timeTrajectory[k];
 
     const base_coordinate_t basePose = getBasePose(comkino_state_t(targetTrajectories_.stateTrajectory[k]));
@@ -501,28 +624,23 @@ void SwingTrajectoryPlanner::adaptJointReferencesWithInverseKinematics(scalar_t
 
       const size_t stateOffset = 2 * BASE_COORDINATE_SIZE + 3 * leg;
       targetTrajectories_.stateTrajectory[k].segment(stateOffset, 3) =
-          inverseKinematicsModelPtr_->getLimbJointPositionsFromPositionBaseToFootInBaseFrame(leg, positionBaseToFootInBaseFrame);
+          inverseKinematicsModel.getLimbJointPositionsFromPositionBaseToFootInBaseFrame(leg, positionBaseToFootInBaseFrame);
 
       // Joint velocities
       auto jointPositions = getJointPositions(targetTrajectories_.stateTrajectory[k]);
       auto baseTwistInBaseFrame = getBaseLocalVelocities(targetTrajectories_.stateTrajectory[k]);
 
-      const vector3_t b_baseToFoot = kinematicsModel_->positionBaseToFootInBaseFrame(leg, jointPositions);
+      const vector3_t b_baseToFoot = kinematicsModel.positionBaseToFootInBaseFrame(leg, jointPositions);
       const vector3_t footVelocityInBaseFrame = rotateVectorOriginToBase(footPhase.getVelocityInWorld(t), eulerXYZ);
       const vector3_t footRelativeVelocityInBaseFrame =
           footVelocityInBaseFrame - getLinearVelocity(baseTwistInBaseFrame) - getAngularVelocity(baseTwistInBaseFrame).cross(b_baseToFoot);
 
       const size_t inputOffset = 3 * NUM_CONTACT_POINTS + 3 * leg;
       targetTrajectories_.inputTrajectory[k].segment(inputOffset, 3) =
-          inverseKinematicsModelPtr_->getLimbVelocitiesFromFootVelocityRelativeToBaseInBaseFrame(
-              leg, footRelativeVelocityInBaseFrame, kinematicsModel_->baseToFootJacobianBlockInBaseFrame(leg, jointPositions), damping);
+          inverseKinematicsModel.getLimbVelocitiesFromFootVelocityRelativeToBaseInBaseFrame(
+              leg, footRelativeVelocityInBaseFrame, kinematicsModel.baseToFootJacobianBlockInBaseFrame(leg, jointPositions), damping);
     }
-
-    // Can stop adaptation as soon as we have processed a point beyond the horizon.
-    if (t > finalTime) {
-      break;
-    }
-  }
+  });
 }
 
 void SwingTrajectoryPlanner::updateLastContact(int leg, scalar_t expectedLiftOff, const vector3_t& currentFootPosition,
@@ -577,8 +695,8 @@ vector3_t SwingTrajectoryPlanner::filterFoothold(const vector3_t& newFoothold, c
 SwingTrajectoryPlannerSettings loadSwingTrajectorySettings(const std::string& filename, bool verbose) {
   SwingTrajectoryPlannerSettings settings{};
 
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = ocs2::loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   const std::string prefix{"model_settings.swing_trajectory_settings."};
 
@@ -603,6 +721,8 @@ SwingTrajectoryPlannerSettings loadSwingTrajectorySettings(const std::string& fi
   ocs2::loadData::loadPtreeValue(pt, settings.referenceExtensionAfterHorizon, prefix + "referenceExtensionAfterHorizon", verbose);
   ocs2::loadData::loadPtreeValue(pt, settings.maximumReferenceSampleTime, prefix + "maximumReferenceSampleTime", verbose);
   ocs2::loadData::loadPtreeValue(pt, settings.swingTrajectoryFromReference, prefix + "swingTrajectoryFromReference", verbose);
+  ocs2::loadData::loadPtreeValue(pt, settings.nThreads, prefix + "nThreads", verbose);
+  ocs2::loadData::loadPtreeValue(pt, settings.threadPriority, prefix + "threadPriority", verbose);
 
   if (verbose) {
     std::cerr << " #### ==================================================" << std::endl;
@@ -11,8 +11,8 @@
 namespace switched_model {
 
 TerrainPlane loadTerrainPlane(const std::string& filename, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = ocs2::loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   if (verbose) {
     std::cerr << "\n #### terrain plane:" << std::endl;
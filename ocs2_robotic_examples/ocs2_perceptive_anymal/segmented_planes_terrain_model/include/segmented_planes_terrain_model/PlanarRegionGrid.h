@@ -0,0 +1,101 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include <convex_plane_decomposition/PlanarRegion.h>
+#include <convex_plane_decomposition/SegmentedPlaneProjection.h>
+
+#include <ocs2_switched_model_interface/core/SwitchedModel.h>
+
+namespace switched_model {
+
+/**
+ * Uniform grid over the world frame bounding boxes of a set of planar regions.
+ *
+ * The grid is built once per terrain update and is used to prune the regions that have to be scored when projecting a point onto the
+ * terrain. Cells are visited in rings around the query point, and the exact projection is only evaluated for regions whose bounding box
+ * is closer than the best projection cost found so far. The result is identical to a brute force search over all regions.
+ *
+ * The grid only stores region indices and bounding boxes, the regions themselves are passed to the queries. It can therefore be copied
+ * and moved together with the container that owns the regions. The grid is immutable after construction and can be queried concurrently.
+ */
+class PlanarRegionGrid {
+ public:
+  using penalty_function_t = std::function<scalar_t(const vector3_t&)>;
+
+  /**
+   * Constructor
+   * @param [in] planarRegions : Regions to index.
+   * @param [in] cellSize : Edge length of the square grid cells [m].
+   */
+  explicit PlanarRegionGrid(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions, scalar_t cellSize = 0.5);
+
+  /**
+   * Finds the region with the lowest projection cost, i.e. the squared distance to the projection plus the penalty at the projection.
+   *
+   * @param [in] positionInWorld : Query position.
+   * @param [in] planarRegions : The regions the grid was constructed with, or an identical copy of them.
+   * @param [in] penaltyFunction : Penalty on the projected position. Needs to return values >= 0.
+   * @return The best projection, regionPtr points into planarRegions. regionPtr is nullptr if there are no regions.
+   */
+  convex_plane_decomposition::PlanarTerrainProjection getBestPlanarRegionAtPositionInWorld(
+      const vector3_t& positionInWorld, const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+      const penalty_function_t& penaltyFunction) const;
+
+  /**
+   * Batch version of getBestPlanarRegionAtPositionInWorld. The search buffers are shared between all queries.
+   *
+   * @param [in] positionsInWorld : Query positions.
+   * @param [in] planarRegions : The regions the grid was constructed with, or an identical copy of them.
+   * @param [in] penaltyFunctions : Penalty function for each query position. Needs to return values >= 0.
+   * @return The best projection for each query position.
+   */
+  std::vector<convex_plane_decomposition::PlanarTerrainProjection> getBestPlanarRegionsAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld, const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+      const std::vector<penalty_function_t>& penaltyFunctions) const;
+
+  /** Number of cells along the x and y direction of the world frame. */
+  std::pair<int, int> getNumCells() const { return {numCellsX_, numCellsY_}; }
+
+ private:
+  struct Candidate {
+    int regionIndex;
+    scalar_t squaredDistanceLowerBound;
+  };
+
+  /** Buffers used during a query. Regions are marked as visited by writing the current query id. */
+  struct SearchBuffers {
+    std::vector<size_t> visitedStamp;
+    std::vector<Candidate> candidates;
+    size_t queryId = 0;
+  };
+
+  convex_plane_decomposition::PlanarTerrainProjection search(const vector3_t& positionInWorld,
+                                                             const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+                                                             const penalty_function_t& penaltyFunction, SearchBuffers& buffers) const;
+
+  void checkPlanarRegions(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions) const;
+
+  /** Lower bound on the squared XY distance between the query and any cell outside the block [ix0, ix1] x [iy0, iy1]. */
+  scalar_t squaredDistanceOutsideBlock(const vector2_t& positionXY, int ix0, int ix1, int iy0, int iy1) const;
+
+  int cellIndexX(scalar_t x) const;
+  int cellIndexY(scalar_t y) const;
+
+  std::vector<Eigen::AlignedBox3d> regionBoxesInWorld_;
+
+  vector2_t gridOrigin_;
+  scalar_t cellSize_;
+  int numCellsX_;
+  int numCellsY_;
+
+  // Compressed cell -> region map: the regions overlapping cell c = ix + numCellsX_ * iy are in
+  // cellRegions_[cellOffsets_[c]] ... cellRegions_[cellOffsets_[c + 1] - 1]
+  std::vector<int> cellOffsets_;
+  std::vector<int> cellRegions_;
+};
+
+}  // namespace switched_model
@@ -8,6 +8,7 @@
 
 #include <convex_plane_decomposition/PlanarRegion.h>
 
+#include "segmented_planes_terrain_model/PlanarRegionGrid.h"
 #include "segmented_planes_terrain_model/SegmentedPlanesSignedDistanceField.h"
 
 namespace switched_model {
@@ -23,6 +24,10 @@ class SegmentedPlanesTerrainModel : public switched_model::TerrainModel {
   ConvexTerrain getConvexTerrainAtPositionInWorld(const vector3_t& positionInWorld,
                                                   std::function<scalar_t(const vector3_t&)> penaltyFunction) const override;
 
+  std::vector<ConvexTerrain> getConvexTerrainAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld,
+      const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const override;
+
   void createSignedDistanceBetween(const Eigen::Vector3d& minCoordinates, const Eigen::Vector3d& maxCoordinates);
 
   const SegmentedPlanesSignedDistanceField* getSignedDistanceField() const override { return signedDistanceField_.get(); }
@@ -34,7 +39,10 @@ class SegmentedPlanesTerrainModel : public switched_model::TerrainModel {
   const convex_plane_decomposition::PlanarTerrain& planarTerrain() const { return planarTerrain_; }
 
  private:
+  ConvexTerrain getConvexTerrainFromProjection(const convex_plane_decomposition::PlanarTerrainProjection& projection) const;
+
   const convex_plane_decomposition::PlanarTerrain planarTerrain_;
+  const PlanarRegionGrid planarRegionGrid_;
   std::unique_ptr<SegmentedPlanesSignedDistanceField> signedDistanceField_;
   const grid_map::Matrix* const elevationData_;
 };
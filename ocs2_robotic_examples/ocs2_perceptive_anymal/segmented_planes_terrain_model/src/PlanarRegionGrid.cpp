@@ -0,0 +1,245 @@
+#include "segmented_planes_terrain_model/PlanarRegionGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace switched_model {
+
+namespace {
+// Limits the memory footprint of the grid for sparse terrains that span a large area.
+constexpr int maxCellsPerDimension = 256;
+}  // namespace
+
+PlanarRegionGrid::PlanarRegionGrid(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions, scalar_t cellSize)
+    : gridOrigin_(vector2_t::Zero()), cellSize_(cellSize), numCellsX_(0), numCellsY_(0) {
+  if (cellSize <= 0.0) {
+    throw std::runtime_error("[PlanarRegionGrid] cellSize must be positive");
+  }
+
+  // World frame bounding box of each region. The regions are flat in their own frame, so the corners of the 2D bounding box span it.
+  regionBoxesInWorld_.reserve(planarRegions.size());
+  Eigen::AlignedBox2d gridBox;
+  for (const auto& region : planarRegions) {
+    const auto& bbox = region.bbox2d;
+    Eigen::AlignedBox3d boxInWorld;
+    for (const auto& corner : {vector3_t(bbox.xmin(), bbox.ymin(), 0.0), vector3_t(bbox.xmax(), bbox.ymin(), 0.0),
+                               vector3_t(bbox.xmin(), bbox.ymax(), 0.0), vector3_t(bbox.xmax(), bbox.ymax(), 0.0)}) {
+      boxInWorld.extend(region.transformPlaneToWorld * corner);
+    }
+    gridBox.extend(Eigen::AlignedBox2d(boxInWorld.min().head<2>(), boxInWorld.max().head<2>()));
+    regionBoxesInWorld_.push_back(boxInWorld);
+  }
+
+  if (planarRegions.empty()) {
+    return;
+  }
+
+  // Grid dimensions
+  const vector2_t gridSize = gridBox.sizes();
+  cellSize_ = std::max({cellSize, gridSize.x() / maxCellsPerDimension, gridSize.y() / maxCellsPerDimension});
+  gridOrigin_ = gridBox.min();
+  numCellsX_ = std::max(1, static_cast<int>(std::ceil(gridSize.x() / cellSize_)));
+  numCellsY_ = std::max(1, static_cast<int>(std::ceil(gridSize.y() / cellSize_)));
+  const int numCells = numCellsX_ * numCellsY_;
+
+  // Two passes over the regions: count the regions per cell, then fill the compressed map.
+  auto forEachOverlappingCell = [&](const Eigen::AlignedBox3d& box, const std::function<void(int)>& f) {
+    const int ix0 = cellIndexX(box.min().x());
+    const int ix1 = cellIndexX(box.max().x());
+    const int iy0 = cellIndexY(box.min().y());
+    const int iy1 = cellIndexY(box.max().y());
+    for (int iy = iy0; iy <= iy1; ++iy) {
+      for (int ix = ix0; ix <= ix1; ++ix) {
+        f(ix + numCellsX_ * iy);
+      }
+    }
+  };
+
+  cellOffsets_.assign(numCells + 1, 0);
+  for (const auto& box : regionBoxesInWorld_) {
+    forEachOverlappingCell(box, [&](int cell) { ++cellOffsets_[cell + 1]; });
+  }
+  for (int c = 0; c < numCells; ++c) {
+    cellOffsets_[c + 1] += cellOffsets_[c];
+  }
+
+  cellRegions_.resize(cellOffsets_.back());
+  std::vector<int> fillCount(numCells, 0);
+  for (int r = 0; r < static_cast<int>(regionBoxesInWorld_.size()); ++r) {
+    forEachOverlappingCell(regionBoxesInWorld_[r], [&](int cell) { cellRegions_[cellOffsets_[cell] + fillCount[cell]++] = r; });
+  }
+}
+
+convex_plane_decomposition::PlanarTerrainProjection PlanarRegionGrid::getBestPlanarRegionAtPositionInWorld(
+    const vector3_t& positionInWorld, const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+    const penalty_function_t& penaltyFunction) const {
+  checkPlanarRegions(planarRegions);
+  SearchBuffers buffers;
+  return search(positionInWorld, planarRegions, penaltyFunction, buffers);
+}
+
+std::vector<convex_plane_decomposition::PlanarTerrainProjection> PlanarRegionGrid::getBestPlanarRegionsAtPositionsInWorld(
+    const std::vector<vector3_t>& positionsInWorld, const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+    const std::vector<penalty_function_t>& penaltyFunctions) const {
+  if (positionsInWorld.size() != penaltyFunctions.size()) {
+    throw std::runtime_error("[PlanarRegionGrid] The number of positions and penalty functions must be equal");
+  }
+  checkPlanarRegions(planarRegions);
+
+  SearchBuffers buffers;
+  std::vector<convex_plane_decomposition::PlanarTerrainProjection> projections;
+  projections.reserve(positionsInWorld.size());
+  for (size_t i = 0; i < positionsInWorld.size(); ++i) {
+    projections.push_back(search(positionsInWorld[i], planarRegions, penaltyFunctions[i], buffers));
+  }
+  return projections;
+}
+
+convex_plane_decomposition::PlanarTerrainProjection PlanarRegionGrid::search(
+    const vector3_t& positionInWorld, const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+    const penalty_function_t& penaltyFunction, SearchBuffers& buffers) const {
+  convex_plane_decomposition::PlanarTerrainProjection projection;
+  projection.regionPtr = nullptr;
+  projection.cost = std::numeric_limits<scalar_t>::max();
+  if (planarRegions.empty()) {
+    return projection;
+  }
+
+  // Reset buffers
+  if (buffers.visitedStamp.size() != planarRegions.size()) {
+    buffers.visitedStamp.assign(planarRegions.size(), 0);
+    buffers.queryId = 0;
+  }
+  ++buffers.queryId;
+  auto& candidates = buffers.candidates;
+  candidates.clear();
+
+  auto evaluateRegion = [&](int regionIndex) {
+    const auto& region = planarRegions[regionIndex];
+    const vector3_t positionInTerrainFrame = region.transformPlaneToWorld.inverse() * positionInWorld;
+    const auto projectedPointInTerrainFrame = convex_plane_decomposition::projectToPlanarRegion(
+        convex_plane_decomposition::CgalPoint2d(positionInTerrainFrame.x(), positionInTerrainFrame.y()), region);
+    const vector3_t projectedPointInWorld =
+        region.transformPlaneToWorld * vector3_t(projectedPointInTerrainFrame.x(), projectedPointInTerrainFrame.y(), 0.0);
+    const scalar_t cost = (projectedPointInWorld - positionInWorld).squaredNorm() + penaltyFunction(projectedPointInWorld);
+    if (cost < projection.cost) {
+      projection.regionPtr = &region;
+      projection.positionInTerrainFrame = projectedPointInTerrainFrame;
+      projection.positionInWorld = projectedPointInWorld;
+      projection.cost = cost;
+    }
+  };
+
+  const vector2_t positionXY = positionInWorld.head<2>();
+  const int cx = cellIndexX(positionXY.x());
+  const int cy = cellIndexY(positionXY.y());
+  const int maxRing = std::max({cx, numCellsX_ - 1 - cx, cy, numCellsY_ - 1 - cy});
+
+  for (int ring = 0; ring <= maxRing; ++ring) {
+    const int ix0 = std::max(cx - ring, 0);
+    const int ix1 = std::min(cx + ring, numCellsX_ - 1);
+    const int iy0 = std::max(cy - ring, 0);
+    const int iy1 = std::min(cy + ring, numCellsY_ - 1);
+
+    // Collect the regions of the cells on this ring
+    auto collectCell = [&](int ix, int iy) {
+      const int cell = ix + numCellsX_ * iy;
+      for (int k = cellOffsets_[cell]; k < cellOffsets_[cell + 1]; ++k) {
+        const int regionIndex = cellRegions_[k];
+        if (buffers.visitedStamp[regionIndex] != buffers.queryId) {
+          buffers.visitedStamp[regionIndex] = buffers.queryId;
+          const scalar_t lowerBound = regionBoxesInWorld_[regionIndex].squaredExteriorDistance(positionInWorld);
+          if (lowerBound < projection.cost) {
+            candidates.push_back({regionIndex, lowerBound});
+          }
+        }
+      }
+    };
+    for (int iy = iy0; iy <= iy1; ++iy) {
+      if (std::abs(iy - cy) == ring) {  // Top and bottom row of the ring
+        for (int ix = ix0; ix <= ix1; ++ix) {
+          collectCell(ix, iy);
+        }
+      } else {  // Left and right column of the ring
+        if (cx - ring >= 0) {
+          collectCell(cx - ring, iy);
+        }
+        if (cx + ring < numCellsX_) {
+          collectCell(cx + ring, iy);
+        }
+      }
+    }
+
+    // Evaluate the candidates that are closer than any region that is not yet collected
+    const scalar_t unvisitedLowerBound = squaredDistanceOutsideBlock(positionXY, ix0, ix1, iy0, iy1);
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& lhs, const Candidate& rhs) { return lhs.squaredDistanceLowerBound < rhs.squaredDistanceLowerBound; });
+    auto candidateIt = candidates.begin();
+    for (; candidateIt != candidates.end() && candidateIt->squaredDistanceLowerBound <= unvisitedLowerBound; ++candidateIt) {
+      if (candidateIt->squaredDistanceLowerBound > projection.cost) {
+        candidateIt = candidates.end();  // Sorted, all remaining candidates are worse.
+        break;
+      }
+      evaluateRegion(candidateIt->regionIndex);
+    }
+    candidates.erase(candidates.begin(), candidateIt);
+
+    if (projection.cost <= unvisitedLowerBound) {
+      break;
+    }
+  }
+
+  // All cells are visited, evaluate what is left.
+  for (const auto& candidate : candidates) {
+    if (candidate.squaredDistanceLowerBound > projection.cost) {
+      break;
+    }
+    evaluateRegion(candidate.regionIndex);
+  }
+
+  return projection;
+}
+
+void PlanarRegionGrid::checkPlanarRegions(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions) const {
+  if (planarRegions.size() != regionBoxesInWorld_.size()) {
+    throw std::runtime_error("[PlanarRegionGrid] The number of regions differs from the regions the grid was constructed with");
+  }
+}
+
+scalar_t PlanarRegionGrid::squaredDistanceOutsideBlock(const vector2_t& positionXY, int ix0, int ix1, int iy0, int iy1) const {
+  const vector2_t blockMin = gridOrigin_ + cellSize_ * vector2_t(static_cast<scalar_t>(ix0), static_cast<scalar_t>(iy0));
+  const vector2_t blockMax = gridOrigin_ + cellSize_ * vector2_t(static_cast<scalar_t>(ix1 + 1), static_cast<scalar_t>(iy1 + 1));
+  const vector2_t gridMin = gridOrigin_;
+  const vector2_t gridMax = gridOrigin_ + cellSize_ * vector2_t(static_cast<scalar_t>(numCellsX_), static_cast<scalar_t>(numCellsY_));
+
+  scalar_t squaredDistance = std::numeric_limits<scalar_t>::max();
+  auto updateWithSlab = [&](const vector2_t& slabMin, const vector2_t& slabMax) {
+    squaredDistance = std::min(squaredDistance, Eigen::AlignedBox2d(slabMin, slabMax).squaredExteriorDistance(positionXY));
+  };
+  if (ix0 > 0) {
+    updateWithSlab(gridMin, {blockMin.x(), gridMax.y()});
+  }
+  if (ix1 < numCellsX_ - 1) {
+    updateWithSlab({blockMax.x(), gridMin.y()}, gridMax);
+  }
+  if (iy0 > 0) {
+    updateWithSlab({blockMin.x(), gridMin.y()}, {blockMax.x(), blockMin.y()});
+  }
+  if (iy1 < numCellsY_ - 1) {
+    updateWithSlab({blockMin.x(), blockMax.y()}, {blockMax.x(), gridMax.y()});
+  }
+  return squaredDistance;
+}
+
+int PlanarRegionGrid::cellIndexX(scalar_t x) const {
+  const int ix = static_cast<int>(std::floor((x - gridOrigin_.x()) / cellSize_));
+  return std::min(std::max(ix, 0), numCellsX_ - 1);
+}
+
+int PlanarRegionGrid::cellIndexY(scalar_t y) const {
+  const int iy = static_cast<int>(std::floor((y - gridOrigin_.y()) / cellSize_));
+  return std::min(std::max(iy, 0), numCellsY_ - 1);
+}
+
+}  // namespace switched_model
@@ -7,7 +7,6 @@
 #include <algorithm>
 
 #include <convex_plane_decomposition/ConvexRegionGrowing.h>
-#include <convex_plane_decomposition/SegmentedPlaneProjection.h>
 
 #include <grid_map_filters_rsl/lookup.hpp>
 
@@ -19,12 +18,14 @@ const std::string elevationLayerName = "elevation";
 
 SegmentedPlanesTerrainModel::SegmentedPlanesTerrainModel(convex_plane_decomposition::PlanarTerrain planarTerrain)
     : planarTerrain_(std::move(planarTerrain)),
+      planarRegionGrid_(planarTerrain_.planarRegions),
       signedDistanceField_(nullptr),
       elevationData_(&planarTerrain_.gridMap.get(elevationLayerName)) {}
 
 TerrainPlane SegmentedPlanesTerrainModel::getLocalTerrainAtPositionInWorldAlongGravity(
     const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
-  const auto projection = getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, std::move(penaltyFunction));
+  const auto projection =
+      planarRegionGrid_.getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, penaltyFunction);
   if (projection.regionPtr == nullptr) {
     throw std::runtime_error("[SegmentedPlanesTerrainModel] no region found");
   }
@@ -34,7 +35,25 @@ TerrainPlane SegmentedPlanesTerrainModel::getLocalTerrainAtPositionInWorldAlongG
 
 ConvexTerrain SegmentedPlanesTerrainModel::getConvexTerrainAtPositionInWorld(
     const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
-  const auto projection = getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, std::move(penaltyFunction));
+  return getConvexTerrainFromProjection(
+      planarRegionGrid_.getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, penaltyFunction));
+}
+
+std::vector<ConvexTerrain> SegmentedPlanesTerrainModel::getConvexTerrainAtPositionsInWorld(
+    const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+  const auto projections =
+      planarRegionGrid_.getBestPlanarRegionsAtPositionsInWorld(positionsInWorld, planarTerrain_.planarRegions, penaltyFunctions);
+
+  std::vector<ConvexTerrain> convexTerrains;
+  convexTerrains.reserve(projections.size());
+  for (const auto& projection : projections) {
+    convexTerrains.push_back(getConvexTerrainFromProjection(projection));
+  }
+  return convexTerrains;
+}
+
+ConvexTerrain SegmentedPlanesTerrainModel::getConvexTerrainFromProjection(
+    const convex_plane_decomposition::PlanarTerrainProjection& projection) const {
   if (projection.regionPtr == nullptr) {
     throw std::runtime_error("[SegmentedPlanesTerrainModel] no region found");
   }
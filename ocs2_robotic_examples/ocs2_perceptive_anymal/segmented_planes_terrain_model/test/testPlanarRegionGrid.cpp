@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include <convex_plane_decomposition/SegmentedPlaneProjection.h>
+
+#include "segmented_planes_terrain_model/PlanarRegionGrid.h"
+
+using namespace switched_model;
+
+namespace {
+
+/** Random rectangular regions with a small tilt, spread over a square area that grows with the number of regions. */
+std::vector<convex_plane_decomposition::PlanarRegion> getRandomTerrain(int numRegions, std::mt19937& generator) {
+  const scalar_t areaSize = 2.0 * std::sqrt(static_cast<scalar_t>(numRegions));
+  std::uniform_real_distribution<scalar_t> positionDistribution(-0.5 * areaSize, 0.5 * areaSize);
+  std::uniform_real_distribution<scalar_t> heightDistribution(-0.3, 0.3);
+  std::uniform_real_distribution<scalar_t> sizeDistribution(0.1, 1.0);
+  std::uniform_real_distribution<scalar_t> angleDistribution(-0.3, 0.3);
+
+  std::vector<convex_plane_decomposition::PlanarRegion> regions(numRegions);
+  for (auto& region : regions) {
+    const scalar_t halfX = sizeDistribution(generator);
+    const scalar_t halfY = sizeDistribution(generator);
+    convex_plane_decomposition::CgalPolygon2d rectangle;
+    rectangle.push_back({-halfX, -halfY});
+    rectangle.push_back({halfX, -halfY});
+    rectangle.push_back({halfX, halfY});
+    rectangle.push_back({-halfX, halfY});
+
+    region.boundaryWithInset.boundary = convex_plane_decomposition::CgalPolygonWithHoles2d(rectangle);
+    region.boundaryWithInset.insets.push_back(region.boundaryWithInset.boundary);
+    region.bbox2d = rectangle.bbox();
+
+    region.transformPlaneToWorld.setIdentity();
+    region.transformPlaneToWorld.translation() =
+        vector3_t(positionDistribution(generator), positionDistribution(generator), heightDistribution(generator));
+    region.transformPlaneToWorld.linear() = (Eigen::AngleAxisd(angleDistribution(generator), vector3_t::UnitZ()) *
+                                             Eigen::AngleAxisd(angleDistribution(generator), vector3_t::UnitX()))
+                                                .toRotationMatrix();
+  }
+  return regions;
+}
+
+std::vector<vector3_t> getRandomQueries(int numQueries, scalar_t areaSize, std::mt19937& generator) {
+  std::uniform_real_distribution<scalar_t> positionDistribution(-0.6 * areaSize, 0.6 * areaSize);
+  std::uniform_real_distribution<scalar_t> heightDistribution(-0.5, 0.5);
+  std::vector<vector3_t> queries;
+  for (int i = 0; i < numQueries; ++i) {
+    queries.emplace_back(positionDistribution(generator), positionDistribution(generator), heightDistribution(generator));
+  }
+  return queries;
+}
+
+}  // namespace
+
+TEST(TestPlanarRegionGrid, emptyTerrain) {
+  const std::vector<convex_plane_decomposition::PlanarRegion> regions;
+  const PlanarRegionGrid grid(regions);
+  const auto projection = grid.getBestPlanarRegionAtPositionInWorld(vector3_t::Zero(), regions, [](const vector3_t&) { return 0.0; });
+  ASSERT_EQ(projection.regionPtr, nullptr);
+}
+
+TEST(TestPlanarRegionGrid, equalToBruteForce) {
+  std::mt19937 generator(0);
+  auto penalty = [](const vector3_t& p) { return 0.1 * p.head<2>().squaredNorm(); };
+
+  for (int numRegions : {1, 10, 100, 1000}) {
+    const auto regions = getRandomTerrain(numRegions, generator);
+    const PlanarRegionGrid grid(regions, 0.5);
+    const auto queries = getRandomQueries(200, 2.0 * std::sqrt(numRegions), generator);
+
+    for (const auto& query : queries) {
+      const auto expected = convex_plane_decomposition::getBestPlanarRegionAtPositionInWorld(query, regions, penalty);
+      const auto projection = grid.getBestPlanarRegionAtPositionInWorld(query, regions, penalty);
+      ASSERT_DOUBLE_EQ(projection.cost, expected.cost);
+      ASSERT_TRUE(projection.positionInWorld.isApprox(expected.positionInWorld));
+    }
+
+    // Batch query
+    const std::vector<PlanarRegionGrid::penalty_function_t> penalties(queries.size(), penalty);
+    const auto projections = grid.getBestPlanarRegionsAtPositionsInWorld(queries, regions, penalties);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      ASSERT_DOUBLE_EQ(projections[i].cost, grid.getBestPlanarRegionAtPositionInWorld(queries[i], regions, penalty).cost);
+    }
+  }
+}
+
+TEST(TestPlanarRegionGrid, copyWithRegions) {
+  std::mt19937 generator(2);
+  auto penalty = [](const vector3_t& p) { return 0.1 * p.head<2>().squaredNorm(); };
+  const auto queries = getRandomQueries(50, 2.0 * std::sqrt(100.0), generator);
+
+  // The grid and the regions are copied from a terrain that goes out of scope, as in a copy of the owning terrain model.
+  std::unique_ptr<PlanarRegionGrid> gridCopy;
+  std::vector<convex_plane_decomposition::PlanarRegion> regionsCopy;
+  std::vector<scalar_t> expectedCosts;
+  {
+    const auto regions = getRandomTerrain(100, generator);
+    const PlanarRegionGrid grid(regions);
+    for (const auto& query : queries) {
+      expectedCosts.push_back(grid.getBestPlanarRegionAtPositionInWorld(query, regions, penalty).cost);
+    }
+    gridCopy.reset(new PlanarRegionGrid(grid));
+    regionsCopy = regions;
+  }
+
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const auto projection = gridCopy->getBestPlanarRegionAtPositionInWorld(queries[i], regionsCopy, penalty);
+    ASSERT_DOUBLE_EQ(projection.cost, expectedCosts[i]);
+    ASSERT_GE(projection.regionPtr, regionsCopy.data());
+    ASSERT_LT(projection.regionPtr, regionsCopy.data() + regionsCopy.size());
+  }
+
+  // Regions that do not match the grid are rejected
+  regionsCopy.pop_back();
+  ASSERT_THROW(gridCopy->getBestPlanarRegionAtPositionInWorld(queries.front(), regionsCopy, penalty), std::runtime_error);
+}
+
+TEST(TestPlanarRegionGrid, benchmark) {
+  std::mt19937 generator(1);
+  auto penalty = [](const vector3_t& p) { return 0.1 * p.head<2>().squaredNorm(); };
+  constexpr int numQueries = 1000;
+
+  for (int numRegions : {10, 30, 100, 300, 1000}) {
+    const auto regions = getRandomTerrain(numRegions, generator);
+    const auto queries = getRandomQueries(numQueries, 2.0 * std::sqrt(numRegions), generator);
+    ocs2::benchmark::RepeatedTimer bruteForceTimer;
+    ocs2::benchmark::RepeatedTimer buildTimer;
+    ocs2::benchmark::RepeatedTimer gridTimer;
+
+    scalar_t bruteForceCost = 0.0;
+    bruteForceTimer.startTimer();
+    for (const auto& query : queries) {
+      bruteForceCost += convex_plane_decomposition::getBestPlanarRegionAtPositionInWorld(query, regions, penalty).cost;
+    }
+    bruteForceTimer.endTimer();
+
+    buildTimer.startTimer();
+    const PlanarRegionGrid grid(regions);
+    buildTimer.endTimer();
+
+    scalar_t gridCost = 0.0;
+    gridTimer.startTimer();
+    for (const auto& query : queries) {
+      gridCost += grid.getBestPlanarRegionAtPositionInWorld(query, regions, penalty).cost;
+    }
+    gridTimer.endTimer();
+
+    ASSERT_NEAR(gridCost, bruteForceCost, 1e-6 * bruteForceCost);
+    std::cout << "[TestPlanarRegionGrid] regions: " << numRegions
+              << "\tbrute force: " << 1e3 * bruteForceTimer.getTotalInMilliseconds() / numQueries << " [us/query]"
+              << "\tgrid: " << 1e3 * gridTimer.getTotalInMilliseconds() / numQueries << " [us/query]"
+              << "\tgrid construction: " << buildTimer.getTotalInMilliseconds() << " [ms]\n";
+  }
+}
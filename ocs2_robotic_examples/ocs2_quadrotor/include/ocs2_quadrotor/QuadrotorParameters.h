@@ -52,8 +52,8 @@ struct QuadrotorParameters {
 
 inline QuadrotorParameters loadSettings(const std::string& filename, const std::string& fieldName = "QuadrotorParameters",
                                         bool verbose = true) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   QuadrotorParameters settings;
 
@@ -0,0 +1,491 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+
+#include <Eigen/Core>
+
+// CppAD
+#include <ocs2_core/automatic_differentiation/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Batch versions of the rotation kernels in RotationTransforms.h and RotationDerivativesTransforms.h.
+ *
+ * A batch of N elements is stored as a structure of arrays: row i of a batch array holds coefficient i of all N elements, such that
+ * each coefficient is contiguous in memory and Eigen can vectorize the element-wise operations.
+ * - Vectors are stored with their coefficients in order. Quaternions use the Eigen coefficient order [x, y, z, w].
+ * - 3x3 matrices are stored column-major, i.e. entry (r, c) is in row r + 3 * c.
+ *
+ * The kernels process the batch in blocks of batchBlockSize columns such that all intermediate results live on the stack and stay in
+ * cache. All kernels are branch free and can be used with scalar_t as well as with ad_scalar_t inside CppAD tapes.
+ */
+template <typename SCALAR_T, int ROWS>
+using batch_array_t = Eigen::Array<SCALAR_T, ROWS, Eigen::Dynamic, Eigen::RowMajor>;
+
+namespace batch_internal {
+
+constexpr int batchBlockSize = 32;
+
+template <typename SCALAR_T, int ROWS>
+using block_array_t = Eigen::Array<SCALAR_T, ROWS, Eigen::Dynamic, Eigen::RowMajor, ROWS, batchBlockSize>;
+
+template <typename SCALAR_T>
+using block_row_t = Eigen::Array<SCALAR_T, 1, Eigen::Dynamic, Eigen::RowMajor, 1, batchBlockSize>;
+
+/** Calls kernel(start, size) for consecutive blocks of at most batchBlockSize columns. */
+template <typename KERNEL>
+void forEachBlock(Eigen::Index numColumns, KERNEL&& kernel) {
+  for (Eigen::Index start = 0; start < numColumns; start += batchBlockSize) {
+    kernel(start, std::min<Eigen::Index>(batchBlockSize, numColumns - start));
+  }
+}
+
+/** Element-wise sine and cosine in a single pass, such that the compiler can fuse them into a sincos call. */
+template <typename SCALAR_T, typename Derived>
+void sinCos(const Eigen::ArrayBase<Derived>& angles, block_row_t<SCALAR_T>& s, block_row_t<SCALAR_T>& c) {
+  using std::cos;
+  using std::sin;
+  s.resize(angles.size());
+  c.resize(angles.size());
+  for (Eigen::Index i = 0; i < angles.size(); ++i) {
+    s[i] = sin(angles[i]);
+    c[i] = cos(angles[i]);
+  }
+}
+
+/** Element-wise CppAD::CondExpGt and CppAD::CondExpLt, such that the kernels can be taped. */
+template <typename SCALAR_T>
+struct CondExp {
+  using row_t = block_row_t<SCALAR_T>;
+  static row_t gt(const row_t& left, const row_t& right, const row_t& ifTrue, const row_t& ifFalse) {
+    row_t result(left.size());
+    for (Eigen::Index i = 0; i < left.size(); ++i) {
+      result[i] = CppAD::CondExpGt(left[i], right[i], ifTrue[i], ifFalse[i]);
+    }
+    return result;
+  }
+  static row_t lt(const row_t& left, const row_t& right, const row_t& ifTrue, const row_t& ifFalse) {
+    row_t result(left.size());
+    for (Eigen::Index i = 0; i < left.size(); ++i) {
+      result[i] = CppAD::CondExpLt(left[i], right[i], ifTrue[i], ifFalse[i]);
+    }
+    return result;
+  }
+  /** A taped function must contain all branches */
+  static bool anyLt(const row_t& /*left*/, const row_t& /*right*/) { return true; }
+};
+
+/** Vectorized select for scalar_t */
+template <>
+struct CondExp<scalar_t> {
+  using row_t = block_row_t<scalar_t>;
+  static row_t gt(const row_t& left, const row_t& right, const row_t& ifTrue, const row_t& ifFalse) {
+    return (left > right).select(ifTrue, ifFalse);
+  }
+  static row_t lt(const row_t& left, const row_t& right, const row_t& ifTrue, const row_t& ifFalse) {
+    return (left < right).select(ifTrue, ifFalse);
+  }
+  static bool anyLt(const row_t& left, const row_t& right) { return (left < right).any(); }
+};
+
+template <typename SCALAR_T>
+block_row_t<SCALAR_T> condExpGt(const block_row_t<SCALAR_T>& left, const block_row_t<SCALAR_T>& right,
+                                const block_row_t<SCALAR_T>& ifTrue, const block_row_t<SCALAR_T>& ifFalse) {
+  return CondExp<SCALAR_T>::gt(left, right, ifTrue, ifFalse);
+}
+
+template <typename SCALAR_T>
+block_row_t<SCALAR_T> condExpLt(const block_row_t<SCALAR_T>& left, const block_row_t<SCALAR_T>& right,
+                                const block_row_t<SCALAR_T>& ifTrue, const block_row_t<SCALAR_T>& ifFalse) {
+  return CondExp<SCALAR_T>::lt(left, right, ifTrue, ifFalse);
+}
+
+/** Block kernel of matrixToQuaternionBatch */
+template <typename SCALAR_T>
+block_array_t<SCALAR_T, 4> matrixToQuaternionBlock(const block_array_t<SCALAR_T, 9>& R) {
+  using row_t = block_row_t<SCALAR_T>;
+  const row_t r00 = R.row(0), r10 = R.row(1), r20 = R.row(2);
+  const row_t r01 = R.row(3), r11 = R.row(4), r21 = R.row(5);
+  const row_t r02 = R.row(6), r12 = R.row(7), r22 = R.row(8);
+  const row_t zero = row_t::Zero(R.cols());
+  const row_t minusR11 = -r11;
+
+  // Same case distinction as the CppAD specialization of matrixToQuaternion
+  auto select = [&](const row_t& a1, const row_t& b1, const row_t& a2, const row_t& b2) -> row_t {
+    return condExpLt<SCALAR_T>(r22, zero, condExpGt<SCALAR_T>(r00, r11, a1, b1), condExpLt<SCALAR_T>(r00, minusR11, a2, b2));
+  };
+  const row_t t = select(1 + r00 - r11 - r22, 1 - r00 + r11 - r22, 1 - r00 - r11 + r22, 1 + r00 + r11 + r22);
+  const row_t scaling = SCALAR_T(0.5) / t.sqrt();
+
+  block_array_t<SCALAR_T, 4> q(4, R.cols());
+  q.row(0) = scaling * select(t, r10 + r01, r02 + r20, r21 - r12);
+  q.row(1) = scaling * select(r10 + r01, t, r21 + r12, r02 - r20);
+  q.row(2) = scaling * select(r02 + r20, r21 + r12, t, r10 - r01);
+  q.row(3) = scaling * select(r21 - r12, r02 - r20, r10 - r01, t);
+  return q;
+}
+
+/** Block kernel of rotationMatrixToRotationVectorBatch */
+template <typename SCALAR_T>
+block_array_t<SCALAR_T, 3> rotationMatrixToRotationVectorBlock(const block_array_t<SCALAR_T, 9>& R) {
+  using row_t = block_row_t<SCALAR_T>;
+  const Eigen::Index n = R.cols();
+
+  const row_t trace = R.row(0) + R.row(4) + R.row(8);
+  block_array_t<SCALAR_T, 3> skewVector(3, n);
+  skewVector.row(0) = R.row(5) - R.row(7);
+  skewVector.row(1) = R.row(6) - R.row(2);
+  skewVector.row(2) = R.row(1) - R.row(3);
+
+  // Tolerance to select alternative solution near singularity
+  const SCALAR_T eps(1e-8);
+  const row_t smallAngleThreshold = row_t::Constant(n, SCALAR_T(3.0) - eps);   // select taylorExpansionSol if trace > 3 - eps
+  const row_t largeAngleThreshold = row_t::Constant(n, -SCALAR_T(1.0) + eps);  // select quaternionSol if trace < -1.0 + eps
+
+  // Clip trace away from singularities, to be used in branches that might result in NaN.
+  const row_t safeHighTrace = condExpGt<SCALAR_T>(trace, smallAngleThreshold, smallAngleThreshold, trace);
+  const row_t safeTrace = condExpGt<SCALAR_T>(safeHighTrace, largeAngleThreshold, safeHighTrace, largeAngleThreshold);
+
+  // Rotation close to zero -> taylor expansion. Normal rotation -> logarithmic map.
+  const row_t taylorExpansionScaling = SCALAR_T(0.75) - trace / SCALAR_T(12.0);
+  const row_t tmp = SCALAR_T(0.5) * (safeTrace - SCALAR_T(1.0));
+  const row_t normalScaling = SCALAR_T(0.5) * tmp.acos() / (SCALAR_T(1.0) - tmp * tmp).sqrt();
+
+  block_array_t<SCALAR_T, 3> rotationVector(3, n);
+  for (int i = 0; i < 3; ++i) {
+    rotationVector.row(i) =
+        condExpGt<SCALAR_T>(trace, smallAngleThreshold, taylorExpansionScaling * skewVector.row(i), normalScaling * skewVector.row(i));
+  }
+
+  // Quaternion solution, when close to pi. Correct sign to make qw positive. For scalar_t, skipped if no element of the block needs it.
+  if (CondExp<SCALAR_T>::anyLt(trace, largeAngleThreshold)) {
+    const block_array_t<SCALAR_T, 4> q = matrixToQuaternionBlock<SCALAR_T>(R);
+    const row_t zero = row_t::Zero(n);
+    const row_t qw = q.row(3);
+    const row_t qVecSign = condExpGt<SCALAR_T>(qw, zero, row_t::Ones(n), -row_t::Ones(n));
+    const row_t qVecNorm = SCALAR_T(0.5) * (SCALAR_T(3.0) - safeHighTrace).sqrt();
+    const row_t quaternionScaling = SCALAR_T(4.0) * (qVecNorm / (qVecSign * qw + SCALAR_T(1.0))).atan() * qVecSign / qVecNorm;
+    for (int i = 0; i < 3; ++i) {
+      rotationVector.row(i) = condExpGt<SCALAR_T>(trace, largeAngleThreshold, rotationVector.row(i), quaternionScaling * q.row(i));
+    }
+  }
+  return rotationVector;
+}
+
+}  // namespace batch_internal
+
+/**
+ * Batch version of quaternionDistance.
+ *
+ * @param [in] q: 4xN measured quaternions.
+ * @param [in] qRef: 4xN desired quaternions.
+ * @return 3xN quaternion distances.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> quaternionDistanceBatch(const batch_array_t<SCALAR_T, 4>& q, const batch_array_t<SCALAR_T, 4>& qRef) {
+  batch_array_t<SCALAR_T, 3> distance(3, q.cols());
+  distance.row(0) = q.row(3) * qRef.row(0) - qRef.row(3) * q.row(0) + q.row(1) * qRef.row(2) - q.row(2) * qRef.row(1);
+  distance.row(1) = q.row(3) * qRef.row(1) - qRef.row(3) * q.row(1) + q.row(2) * qRef.row(0) - q.row(0) * qRef.row(2);
+  distance.row(2) = q.row(3) * qRef.row(2) - qRef.row(3) * q.row(2) + q.row(0) * qRef.row(1) - q.row(1) * qRef.row(0);
+  return distance;
+}
+
+/**
+ * Batch version of getQuaternionFromEulerAnglesZyx.
+ *
+ * @param [in] eulerAnglesZyx: 3xN euler angles zyx.
+ * @return 4xN quaternions.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 4> getQuaternionFromEulerAnglesZyxBatch(const batch_array_t<SCALAR_T, 3>& eulerAnglesZyx) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 4> q(4, eulerAnglesZyx.cols());
+  batch_internal::forEachBlock(eulerAnglesZyx.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t sz, cz, sy, cy, sx, cx;
+    batch_internal::sinCos<SCALAR_T>(SCALAR_T(0.5) * eulerAnglesZyx.row(0).segment(start, n), sz, cz);
+    batch_internal::sinCos<SCALAR_T>(SCALAR_T(0.5) * eulerAnglesZyx.row(1).segment(start, n), sy, cy);
+    batch_internal::sinCos<SCALAR_T>(SCALAR_T(0.5) * eulerAnglesZyx.row(2).segment(start, n), sx, cx);
+    q.row(0).segment(start, n) = cz * cy * sx - sz * sy * cx;
+    q.row(1).segment(start, n) = cz * sy * cx + sz * cy * sx;
+    q.row(2).segment(start, n) = sz * cy * cx - cz * sy * sx;
+    q.row(3).segment(start, n) = cz * cy * cx + sz * sy * sx;
+  });
+  return q;
+}
+
+/**
+ * Batch version of getRotationMatrixFromZyxEulerAngles.
+ *
+ * @param [in] eulerAngles: 3xN euler angles zyx.
+ * @return 9xN rotation matrices.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 9> getRotationMatrixFromZyxEulerAnglesBatch(const batch_array_t<SCALAR_T, 3>& eulerAngles) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 9> rotationMatrix(9, eulerAngles.cols());
+  batch_internal::forEachBlock(eulerAngles.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t s1, c1, s2, c2, s3, c3;
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(0).segment(start, n), s1, c1);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(1).segment(start, n), s2, c2);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(2).segment(start, n), s3, c3);
+    const row_t s2s3 = s2 * s3;
+    const row_t s2c3 = s2 * c3;
+    rotationMatrix.row(0).segment(start, n) = c1 * c2;
+    rotationMatrix.row(1).segment(start, n) = s1 * c2;
+    rotationMatrix.row(2).segment(start, n) = -s2;
+    rotationMatrix.row(3).segment(start, n) = c1 * s2s3 - s1 * c3;
+    rotationMatrix.row(4).segment(start, n) = s1 * s2s3 + c1 * c3;
+    rotationMatrix.row(5).segment(start, n) = c2 * s3;
+    rotationMatrix.row(6).segment(start, n) = c1 * s2c3 + s1 * s3;
+    rotationMatrix.row(7).segment(start, n) = s1 * s2c3 - c1 * s3;
+    rotationMatrix.row(8).segment(start, n) = c2 * c3;
+  });
+  return rotationMatrix;
+}
+
+/**
+ * Batch version of matrixToQuaternion. Uses the branch free formulation of the CppAD specialization for all scalar types.
+ *
+ * @param [in] R: 9xN rotation matrices.
+ * @return 4xN quaternions.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 4> matrixToQuaternionBatch(const batch_array_t<SCALAR_T, 9>& R) {
+  batch_array_t<SCALAR_T, 4> q(4, R.cols());
+  batch_internal::forEachBlock(R.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    const batch_internal::block_array_t<SCALAR_T, 9> rotationMatrices = R.middleCols(start, n);
+    q.middleCols(start, n) = batch_internal::matrixToQuaternionBlock<SCALAR_T>(rotationMatrices);
+  });
+  return q;
+}
+
+/**
+ * Batch version of rotationMatrixToRotationVector.
+ *
+ * @param [in] rotationMatrix: 9xN rotation matrices.
+ * @return 3xN rotation vectors, theta * n.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> rotationMatrixToRotationVectorBatch(const batch_array_t<SCALAR_T, 9>& rotationMatrix) {
+  batch_array_t<SCALAR_T, 3> rotationVector(3, rotationMatrix.cols());
+  batch_internal::forEachBlock(rotationMatrix.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    const batch_internal::block_array_t<SCALAR_T, 9> rotationMatrices = rotationMatrix.middleCols(start, n);
+    rotationVector.middleCols(start, n) = batch_internal::rotationMatrixToRotationVectorBlock<SCALAR_T>(rotationMatrices);
+  });
+  return rotationVector;
+}
+
+/**
+ * Batch version of rotationErrorInWorld : error = lhs [-] rhs, expressed in world.
+ *
+ * @param [in] rotationMatrixLhs: 9xN rotations from lhs frame to world.
+ * @param [in] rotationMatrixRhs: 9xN rotations from rhs frame to world.
+ * @return 3xN rotation errors.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> rotationErrorInWorldBatch(const batch_array_t<SCALAR_T, 9>& rotationMatrixLhs,
+                                                     const batch_array_t<SCALAR_T, 9>& rotationMatrixRhs) {
+  batch_array_t<SCALAR_T, 3> rotationError(3, rotationMatrixLhs.cols());
+  batch_internal::forEachBlock(rotationMatrixLhs.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    // lhs * rhs^T : error(r, c) = sum_k lhs(r, k) * rhs(c, k)
+    batch_internal::block_array_t<SCALAR_T, 9> rotationErrorInWorld(9, n);
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        rotationErrorInWorld.row(r + 3 * c) =
+            rotationMatrixLhs.row(r).segment(start, n) * rotationMatrixRhs.row(c).segment(start, n) +
+            rotationMatrixLhs.row(r + 3).segment(start, n) * rotationMatrixRhs.row(c + 3).segment(start, n) +
+            rotationMatrixLhs.row(r + 6).segment(start, n) * rotationMatrixRhs.row(c + 6).segment(start, n);
+      }
+    }
+    rotationError.middleCols(start, n) = batch_internal::rotationMatrixToRotationVectorBlock<SCALAR_T>(rotationErrorInWorld);
+  });
+  return rotationError;
+}
+
+/**
+ * Batch version of rotationErrorInLocal : error = lhs [-] rhs, expressed in the local frame.
+ *
+ * @param [in] rotationMatrixLhs: 9xN rotations from lhs frame to world.
+ * @param [in] rotationMatrixRhs: 9xN rotations from rhs frame to world.
+ * @return 3xN rotation errors.
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> rotationErrorInLocalBatch(const batch_array_t<SCALAR_T, 9>& rotationMatrixLhs,
+                                                     const batch_array_t<SCALAR_T, 9>& rotationMatrixRhs) {
+  batch_array_t<SCALAR_T, 3> rotationError(3, rotationMatrixLhs.cols());
+  batch_internal::forEachBlock(rotationMatrixLhs.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    // rhs^T * lhs : error(r, c) = sum_k rhs(k, r) * lhs(k, c)
+    batch_internal::block_array_t<SCALAR_T, 9> rotationErrorInLocal(9, n);
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        rotationErrorInLocal.row(r + 3 * c) =
+            rotationMatrixRhs.row(3 * r).segment(start, n) * rotationMatrixLhs.row(3 * c).segment(start, n) +
+            rotationMatrixRhs.row(3 * r + 1).segment(start, n) * rotationMatrixLhs.row(3 * c + 1).segment(start, n) +
+            rotationMatrixRhs.row(3 * r + 2).segment(start, n) * rotationMatrixLhs.row(3 * c + 2).segment(start, n);
+      }
+    }
+    rotationError.middleCols(start, n) = batch_internal::rotationMatrixToRotationVectorBlock<SCALAR_T>(rotationErrorInLocal);
+  });
+  return rotationError;
+}
+
+/**
+ * Batch version of getGlobalAngularVelocityFromEulerAnglesZyxDerivatives.
+ *
+ * @param [in] eulerAngles: 3xN ZYX-Euler angles
+ * @param [in] derivativesEulerAngles: 3xN time-derivative of ZYX-Euler angles
+ * @return 3xN angular velocities expressed in world frame
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> getGlobalAngularVelocityFromEulerAnglesZyxDerivativesBatch(
+    const batch_array_t<SCALAR_T, 3>& eulerAngles, const batch_array_t<SCALAR_T, 3>& derivativesEulerAngles) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 3> angularVelocity(3, eulerAngles.cols());
+  batch_internal::forEachBlock(eulerAngles.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t sz, cz, sy, cy;
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(0).segment(start, n), sz, cz);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(1).segment(start, n), sy, cy);
+    const auto dz = derivativesEulerAngles.row(0).segment(start, n);
+    const auto dy = derivativesEulerAngles.row(1).segment(start, n);
+    const auto dx = derivativesEulerAngles.row(2).segment(start, n);
+    angularVelocity.row(0).segment(start, n) = -sz * dy + cy * cz * dx;
+    angularVelocity.row(1).segment(start, n) = cz * dy + cy * sz * dx;
+    angularVelocity.row(2).segment(start, n) = dz - sy * dx;
+  });
+  return angularVelocity;
+}
+
+/**
+ * Batch version of getEulerAnglesZyxDerivativesFromGlobalAngularVelocity. Singular for y = +- pi / 2.
+ *
+ * @param [in] eulerAngles: 3xN ZYX-Euler angles
+ * @param [in] angularVelocity: 3xN angular velocities expressed in world frame
+ * @return 3xN derivatives of ZYX-Euler angles
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> getEulerAnglesZyxDerivativesFromGlobalAngularVelocityBatch(const batch_array_t<SCALAR_T, 3>& eulerAngles,
+                                                                                      const batch_array_t<SCALAR_T, 3>& angularVelocity) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 3> derivativesEulerAngles(3, eulerAngles.cols());
+  batch_internal::forEachBlock(eulerAngles.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t sz, cz, sy, cy;
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(0).segment(start, n), sz, cz);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(1).segment(start, n), sy, cy);
+    const auto wx = angularVelocity.row(0).segment(start, n);
+    const auto wy = angularVelocity.row(1).segment(start, n);
+    const auto wz = angularVelocity.row(2).segment(start, n);
+    const row_t tmp = (cz * wx + sz * wy) / cy;
+    derivativesEulerAngles.row(0).segment(start, n) = sy * tmp + wz;
+    derivativesEulerAngles.row(1).segment(start, n) = -sz * wx + cz * wy;
+    derivativesEulerAngles.row(2).segment(start, n) = tmp;
+  });
+  return derivativesEulerAngles;
+}
+
+/**
+ * Batch version of getLocalAngularVelocityFromEulerAnglesZyxDerivatives.
+ *
+ * @param [in] eulerAngles: 3xN ZYX-Euler angles
+ * @param [in] derivativesEulerAngles: 3xN time-derivative of ZYX-Euler angles
+ * @return 3xN angular velocities expressed in local frame
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> getLocalAngularVelocityFromEulerAnglesZyxDerivativesBatch(
+    const batch_array_t<SCALAR_T, 3>& eulerAngles, const batch_array_t<SCALAR_T, 3>& derivativesEulerAngles) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 3> angularVelocity(3, eulerAngles.cols());
+  batch_internal::forEachBlock(eulerAngles.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t sy, cy, sx, cx;
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(1).segment(start, n), sy, cy);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(2).segment(start, n), sx, cx);
+    const auto dz = derivativesEulerAngles.row(0).segment(start, n);
+    const auto dy = derivativesEulerAngles.row(1).segment(start, n);
+    const auto dx = derivativesEulerAngles.row(2).segment(start, n);
+    angularVelocity.row(0).segment(start, n) = -sy * dz + dx;
+    angularVelocity.row(1).segment(start, n) = cy * sx * dz + cx * dy;
+    angularVelocity.row(2).segment(start, n) = cx * cy * dz - sx * dy;
+  });
+  return angularVelocity;
+}
+
+/**
+ * Batch version of getEulerAnglesZyxDerivativesFromLocalAngularVelocity. Singular for y = +- pi / 2.
+ *
+ * @param [in] eulerAngles: 3xN ZYX-Euler angles
+ * @param [in] angularVelocity: 3xN angular velocities expressed in local frame
+ * @return 3xN derivatives of ZYX-Euler angles
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 3> getEulerAnglesZyxDerivativesFromLocalAngularVelocityBatch(const batch_array_t<SCALAR_T, 3>& eulerAngles,
+                                                                                     const batch_array_t<SCALAR_T, 3>& angularVelocity) {
+  using row_t = batch_internal::block_row_t<SCALAR_T>;
+  batch_array_t<SCALAR_T, 3> derivativesEulerAngles(3, eulerAngles.cols());
+  batch_internal::forEachBlock(eulerAngles.cols(), [&](Eigen::Index start, Eigen::Index n) {
+    row_t sy, cy, sx, cx;
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(1).segment(start, n), sy, cy);
+    batch_internal::sinCos<SCALAR_T>(eulerAngles.row(2).segment(start, n), sx, cx);
+    const auto wx = angularVelocity.row(0).segment(start, n);
+    const auto wy = angularVelocity.row(1).segment(start, n);
+    const auto wz = angularVelocity.row(2).segment(start, n);
+    const row_t tmp = (sx * wy + cx * wz) / cy;
+    derivativesEulerAngles.row(0).segment(start, n) = tmp;
+    derivativesEulerAngles.row(1).segment(start, n) = cx * wy - sx * wz;
+    derivativesEulerAngles.row(2).segment(start, n) = wx + sy * tmp;
+  });
+  return derivativesEulerAngles;
+}
+
+/**
+ * Batch version of angularVelocityToQuaternionTimeDerivative, applied to an angular velocity.
+ *
+ * @param [in] q: 4xN orientation quaternions
+ * @param [in] angularVelocity: 3xN angular velocities
+ * @return 4xN quaternion time derivatives
+ */
+template <typename SCALAR_T>
+batch_array_t<SCALAR_T, 4> getQuaternionTimeDerivativeFromAngularVelocityBatch(const batch_array_t<SCALAR_T, 4>& q,
+                                                                               const batch_array_t<SCALAR_T, 3>& angularVelocity) {
+  const auto wx = angularVelocity.row(0);
+  const auto wy = angularVelocity.row(1);
+  const auto wz = angularVelocity.row(2);
+
+  // Robot Dynamics 2018, equation (2.97)
+  batch_array_t<SCALAR_T, 4> qDot(4, q.cols());
+  qDot.row(0) = SCALAR_T(0.5) * (q.row(3) * wx + q.row(2) * wy - q.row(1) * wz);
+  qDot.row(1) = SCALAR_T(0.5) * (-q.row(2) * wx + q.row(3) * wy + q.row(0) * wz);
+  qDot.row(2) = SCALAR_T(0.5) * (q.row(1) * wx - q.row(0) * wy + q.row(3) * wz);
+  qDot.row(3) = SCALAR_T(0.5) * (-q.row(0) * wx - q.row(1) * wy - q.row(2) * wz);
+  return qDot;
+}
+
+}  // namespace ocs2
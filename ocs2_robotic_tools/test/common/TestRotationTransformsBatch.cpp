@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_robotic_tools/common/AngularVelocityMapping.h>
+#include <ocs2_robotic_tools/common/RotationDerivativesTransforms.h>
+#include <ocs2_robotic_tools/common/RotationTransforms.h>
+#include <ocs2_robotic_tools/common/RotationTransformsBatch.h>
+
+using namespace ocs2;
+using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+using vector4_t = Eigen::Matrix<scalar_t, 4, 1>;
+using matrix3_t = Eigen::Matrix<scalar_t, 3, 3>;
+using Quaternion_t = Eigen::Quaternion<scalar_t>;
+
+namespace {
+constexpr int batchSize = 1000;
+constexpr scalar_t tolerance = 1e-9;
+
+/** Random rotations, including rotations close to zero and close to pi to cover all branches. */
+batch_array_t<scalar_t, 9> getRandomRotationMatrices() {
+  batch_array_t<scalar_t, 9> R(9, batchSize);
+  for (int i = 0; i < batchSize; ++i) {
+    matrix3_t rotationMatrix = Quaternion_t::UnitRandom().toRotationMatrix();
+    if (i % 10 == 1) {
+      rotationMatrix = Eigen::AngleAxis<scalar_t>(1e-9 * i, vector3_t::Random().normalized()).toRotationMatrix();
+    } else if (i % 10 == 2) {
+      rotationMatrix = Eigen::AngleAxis<scalar_t>(M_PI - 1e-9 * i, vector3_t::Random().normalized()).toRotationMatrix();
+    }
+    R.col(i) = Eigen::Map<const Eigen::Matrix<scalar_t, 9, 1>>(rotationMatrix.data());
+  }
+  return R;
+}
+
+matrix3_t getMatrix(const batch_array_t<scalar_t, 9>& R, int i) {
+  return Eigen::Map<const matrix3_t>(Eigen::Matrix<scalar_t, 9, 1>(R.col(i)).data());
+}
+}  // namespace
+
+TEST(RotationTransformsBatch, eulerAngles) {
+  const batch_array_t<scalar_t, 3> eulerAngles = M_PI * batch_array_t<scalar_t, 3>::Random(3, batchSize);
+  const batch_array_t<scalar_t, 3> derivatives = batch_array_t<scalar_t, 3>::Random(3, batchSize);
+
+  const auto R = getRotationMatrixFromZyxEulerAnglesBatch<scalar_t>(eulerAngles);
+  const auto q = getQuaternionFromEulerAnglesZyxBatch<scalar_t>(eulerAngles);
+  const auto globalAngularVelocity = getGlobalAngularVelocityFromEulerAnglesZyxDerivativesBatch<scalar_t>(eulerAngles, derivatives);
+  const auto localAngularVelocity = getLocalAngularVelocityFromEulerAnglesZyxDerivativesBatch<scalar_t>(eulerAngles, derivatives);
+  const auto globalInverse = getEulerAnglesZyxDerivativesFromGlobalAngularVelocityBatch<scalar_t>(eulerAngles, globalAngularVelocity);
+  const auto localInverse = getEulerAnglesZyxDerivativesFromLocalAngularVelocityBatch<scalar_t>(eulerAngles, localAngularVelocity);
+  const auto qDot = getQuaternionTimeDerivativeFromAngularVelocityBatch<scalar_t>(q, globalAngularVelocity);
+
+  for (int i = 0; i < batchSize; ++i) {
+    const vector3_t euler = eulerAngles.col(i);
+    const vector3_t dEuler = derivatives.col(i);
+    const Quaternion_t quaternion = getQuaternionFromEulerAnglesZyx(euler);
+    const vector3_t omegaGlobal = getGlobalAngularVelocityFromEulerAnglesZyxDerivatives(euler, dEuler);
+    const vector3_t omegaLocal = getLocalAngularVelocityFromEulerAnglesZyxDerivatives(euler, dEuler);
+
+    ASSERT_TRUE(getMatrix(R, i).isApprox(getRotationMatrixFromZyxEulerAngles(euler), tolerance));
+    ASSERT_TRUE(vector4_t(q.col(i)).isApprox(quaternion.coeffs(), tolerance));
+    ASSERT_TRUE(vector3_t(globalAngularVelocity.col(i)).isApprox(omegaGlobal, tolerance));
+    ASSERT_TRUE(vector3_t(localAngularVelocity.col(i)).isApprox(omegaLocal, tolerance));
+    ASSERT_TRUE(vector3_t(globalInverse.col(i)).isApprox(getEulerAnglesZyxDerivativesFromGlobalAngularVelocity(euler, omegaGlobal), 1e-6));
+    ASSERT_TRUE(vector3_t(localInverse.col(i)).isApprox(getEulerAnglesZyxDerivativesFromLocalAngularVelocity(euler, omegaLocal), 1e-6));
+    const vector4_t qDotExpected = angularVelocityToQuaternionTimeDerivative(quaternion) * omegaGlobal;
+    ASSERT_TRUE(vector4_t(qDot.col(i)).isApprox(qDotExpected, tolerance));
+  }
+}
+
+TEST(RotationTransformsBatch, rotationErrors) {
+  const auto R = getRandomRotationMatrices();
+  const auto Rref = getRandomRotationMatrices();
+  const batch_array_t<scalar_t, 4> q = matrixToQuaternionBatch<scalar_t>(R);
+  const batch_array_t<scalar_t, 4> qRef = matrixToQuaternionBatch<scalar_t>(Rref);
+
+  const auto quaternionDistances = quaternionDistanceBatch<scalar_t>(q, qRef);
+  const auto rotationVectors = rotationMatrixToRotationVectorBatch<scalar_t>(R);
+  const auto errorsInWorld = rotationErrorInWorldBatch<scalar_t>(R, Rref);
+  const auto errorsInLocal = rotationErrorInLocalBatch<scalar_t>(R, Rref);
+
+  for (int i = 0; i < batchSize; ++i) {
+    const matrix3_t rotationMatrix = getMatrix(R, i);
+    const matrix3_t rotationMatrixRef = getMatrix(Rref, i);
+    const Quaternion_t quaternion(vector4_t(q.col(i)));
+    const Quaternion_t quaternionRef(vector4_t(qRef.col(i)));
+
+    ASSERT_TRUE(quaternion.toRotationMatrix().isApprox(rotationMatrix, tolerance));
+    ASSERT_TRUE(vector3_t(quaternionDistances.col(i)).isApprox(quaternionDistance(quaternion, quaternionRef), tolerance));
+    ASSERT_TRUE(vector3_t(rotationVectors.col(i)).isApprox(rotationMatrixToRotationVector(rotationMatrix), 1e-6));
+    ASSERT_TRUE(vector3_t(errorsInWorld.col(i)).isApprox(rotationErrorInWorld(rotationMatrix, rotationMatrixRef), 1e-6));
+    ASSERT_TRUE(vector3_t(errorsInLocal.col(i)).isApprox(rotationErrorInLocal(rotationMatrix, rotationMatrixRef), 1e-6));
+  }
+}
+
+TEST(RotationTransformsBatch, rotationErrorCppAd) {
+  constexpr int adBatchSize = 8;
+  auto adFunction = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    const batch_array_t<ad_scalar_t, 3> eulerAngles = Eigen::Map<const batch_array_t<ad_scalar_t, 3>>(x.data(), 3, adBatchSize);
+    const batch_array_t<ad_scalar_t, 9> Rref = Eigen::Map<const batch_array_t<ad_scalar_t, 9>>(p.data(), 9, adBatchSize);
+    const auto R = getRotationMatrixFromZyxEulerAnglesBatch<ad_scalar_t>(eulerAngles);
+    const batch_array_t<ad_scalar_t, 3> error = rotationErrorInWorldBatch<ad_scalar_t>(R, Rref);
+    y = Eigen::Map<const ad_vector_t>(error.data(), error.size());
+  };
+  auto scalarFunction = [](const vector3_t& eulerAngles, const matrix3_t& Rref) -> vector3_t {
+    return rotationErrorInWorld(getRotationMatrixFromZyxEulerAngles(eulerAngles), Rref);
+  };
+
+  CppAdInterface adInterface(adFunction, 3 * adBatchSize, 9 * adBatchSize, "rotation_error_batch");
+  adInterface.createModels();
+
+  const auto Rref = getRandomRotationMatrices();
+  for (int k = 0; k < 100; ++k) {
+    const batch_array_t<scalar_t, 3> eulerAngles = M_PI * batch_array_t<scalar_t, 3>::Random(3, adBatchSize);
+    const batch_array_t<scalar_t, 9> RrefBatch = Rref.middleCols(k * adBatchSize, adBatchSize);
+    const vector_t x = Eigen::Map<const vector_t>(eulerAngles.data(), eulerAngles.size());
+    const vector_t p = Eigen::Map<const vector_t>(RrefBatch.data(), RrefBatch.size());
+
+    const vector_t y = adInterface.getFunctionValue(x, p);
+    const matrix_t jacobian = adInterface.getJacobian(x, p);
+
+    // The rows of the batch are stored contiguously: coefficient j of element i is at j * adBatchSize + i
+    for (int i = 0; i < adBatchSize; ++i) {
+      const vector3_t euler = eulerAngles.col(i);
+      const vector3_t expected = scalarFunction(euler, getMatrix(RrefBatch, i));
+      for (int j = 0; j < 3; ++j) {
+        ASSERT_NEAR(y(j * adBatchSize + i), expected(j), 1e-6);
+      }
+
+      // Finite difference check of the jacobian w.r.t. the euler angles of the same element
+      constexpr scalar_t eps = 1e-6;
+      for (int d = 0; d < 3; ++d) {
+        vector3_t eulerPerturbed = euler;
+        eulerPerturbed(d) += eps;
+        const vector3_t finiteDifference = (scalarFunction(eulerPerturbed, getMatrix(RrefBatch, i)) - expected) / eps;
+        for (int j = 0; j < 3; ++j) {
+          ASSERT_NEAR(jacobian(j * adBatchSize + i, d * adBatchSize + i), finiteDifference(j), 1e-3);
+        }
+      }
+    }
+  }
+}
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "hpipm_catkin/HpipmInterface.h"
 
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Profiler.h>
 
 extern "C" {
 #include <hpipm_d_ocp_qp.h>
@@ -535,6 +536,7 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
                                    vector_array_t& inputTrajectory, bool verbose) {
+  OCS2_PROFILE_ZONE("HpipmInterface::solve");
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
@@ -70,6 +70,18 @@ struct Settings {
 
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;          // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
+  bool structuredProjection = false;                 // Exploit and cache per mode the sparsity of D in the projection of Cx+Du+e
+
+  // Samples the target trajectories on the node times once per solve, so the costs look up their targets on the short time grid. This
+  // is exact as long as the costs only query the target at the node times, which holds for the costs evaluated by this solver.
+  bool sampleTargetTrajectories = false;
+
+  // Evaluates the dynamics and all CppAD cost and state-input constraint terms of a node with a single generated model, such that
+  // subexpressions that are shared between the terms are evaluated once. The model is generated by
+  // SqpSolver::initializeFusedTranscription(), which has to be called before the first run.
+  bool fuseCppAdTerms = false;
+  std::string fusedModelFolder = "/tmp/ocs2";  // Folder the fused model library is saved to
+  bool recompileFusedModel = false;            // true to always regenerate the fused model library
 
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
@@ -32,9 +32,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/CacheLinePadded.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/FusedTranscriptionCppAd.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/oc_data/FlatMetrics.h>
+#include <ocs2_oc/oc_data/PrimalSolutionPool.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -61,11 +65,22 @@ class SqpSolver : public SolverBase {
 
   ~SqpSolver() override;
 
+  /**
+   * Generates the fused CppAD model of the node transcription and copies it for each worker, see Settings::fuseCppAdTerms. The code
+   * generation can take long, therefore it is done once here and not in the MPC loop.
+   *
+   * @param [in] stateDim: State dimension.
+   * @param [in] inputDim: Input dimension.
+   */
+  void initializeFusedTranscription(size_t stateDim, size_t inputDim);
+
   void reset() override;
 
-  scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); };
+  scalar_t getFinalTime() const override { return primalSolutionPtr_->timeTrajectory_.back(); };
 
-  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = *primalSolutionPtr_; }
+
+  std::shared_ptr<const PrimalSolution> getPrimalSolutionSnapshot(scalar_t finalTime) const override { return primalSolutionPtr_; }
 
   const ProblemMetrics& getSolutionMetrics() const override { return problemMetrics_; }
 
@@ -103,12 +118,15 @@ class SqpSolver : public SolverBase {
   }
 
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {
-    // Copy all except the controller
-    primalSolution_.timeTrajectory_ = primalSolution.timeTrajectory_;
-    primalSolution_.stateTrajectory_ = primalSolution.stateTrajectory_;
-    primalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
-    primalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
-    primalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+    // Copy all except the controller. The last solution might be shared as a snapshot, therefore it is replaced and not modified.
+    auto primalSolutionPtr = primalSolutionPool_.acquire();
+    primalSolutionPtr->timeTrajectory_ = primalSolution.timeTrajectory_;
+    primalSolutionPtr->stateTrajectory_ = primalSolution.stateTrajectory_;
+    primalSolutionPtr->inputTrajectory_ = primalSolution.inputTrajectory_;
+    primalSolutionPtr->postEventIndices_ = primalSolution.postEventIndices_;
+    primalSolutionPtr->modeSchedule_ = primalSolution.modeSchedule_;
+    primalSolutionPtr->controllerPtr_.reset();
+    primalSolutionPtr_ = std::move(primalSolutionPtr);
     runImpl(initTime, initState, finalTime);
   }
 
@@ -118,13 +136,16 @@ class SqpSolver : public SolverBase {
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
+  /** Sets the layout of metrics_ and trialMetrics_ for the given time discretization and state trajectory */
+  void setMetricsLayout(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
+
   /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u, std::vector<Metrics>& metrics);
+                                            const vector_array_t& u, FlatMetrics& metrics);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+                                      const vector_array_t& u, FlatMetrics& metrics);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -143,7 +164,7 @@ class SqpSolver : public SolverBase {
   /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
   sqp::StepInfo takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization, const vector_t& initState,
                          const OcpSubproblemSolution& subproblemSolution, vector_array_t& x, vector_array_t& u,
-                         std::vector<Metrics>& metrics);
+                         FlatMetrics& metrics);
 
   /** Determine convergence after a step */
   sqp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const;
@@ -153,6 +174,9 @@ class SqpSolver : public SolverBase {
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
+  TargetTrajectories sampledTargetTrajectories_;  // see Settings::sampleTargetTrajectories
+  std::vector<std::unique_ptr<multiple_shooting::FusedTranscriptionCppAd>> fusedTranscriptions_;  // see Settings::fuseCppAdTerms
+  std::vector<multiple_shooting::StructuredConstraintProjection> structuredProjections_;          // see Settings::structuredProjection
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
 
@@ -162,8 +186,10 @@ class SqpSolver : public SolverBase {
   // Threading
   ThreadPool threadPool_;
 
-  // Solution
-  PrimalSolution primalSolution_;
+  // Solution. It is an immutable snapshot once the run is over, the next run writes to a recycled one of the pool.
+  std::shared_ptr<PrimalSolution> primalSolutionPtr_{std::make_shared<PrimalSolution>()};
+  PrimalSolutionPool primalSolutionPool_;
+  PrimalSolution warmStartSolution_;  // trajectory spread of the last solution
 
   // Value function in absolute state coordinates (without the constant value)
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
@@ -182,9 +208,13 @@ class SqpSolver : public SolverBase {
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
-  // The ProblemMetrics associated to primalSolution_
+  // The ProblemMetrics associated to primalSolutionPtr_
   ProblemMetrics problemMetrics_;
 
+  // Metrics of the current iterate and of the linesearch trial. They are swapped on step acceptance to reuse the buffers.
+  FlatMetrics metrics_;
+  FlatMetrics trialMetrics_;
+
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
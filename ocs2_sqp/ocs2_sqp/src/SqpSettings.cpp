@@ -38,8 +38,8 @@ namespace ocs2 {
 namespace sqp {
 
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
-  boost::property_tree::ptree pt;
-  boost::property_tree::read_info(filename, pt);
+  const auto ptPtr = loadData::getPropertyTree(filename);
+  const auto& pt = *ptPtr;
 
   Settings settings;
 
@@ -67,6 +67,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
   loadData::loadPtreeValue(pt, settings.extractProjectionMultiplier, fieldName + ".extractProjectionMultiplier", verbose);
+  loadData::loadPtreeValue(pt, settings.structuredProjection, fieldName + ".structuredProjection", verbose);
+  loadData::loadPtreeValue(pt, settings.sampleTargetTrajectories, fieldName + ".sampleTargetTrajectories", verbose);
+  loadData::loadPtreeValue(pt, settings.fuseCppAdTerms, fieldName + ".fuseCppAdTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.fusedModelFolder, fieldName + ".fusedModelFolder", verbose);
+  loadData::loadPtreeValue(pt, settings.recompileFusedModel, fieldName + ".recompileFusedModel", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
@@ -29,12 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
-#include <numeric>
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/misc/Profiler.h>
+
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -71,6 +73,7 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  structuredProjections_.resize(settings_.nThreads);
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
@@ -111,7 +114,8 @@ SqpSolver::~SqpSolver() {
 
 void SqpSolver::reset() {
   // Clear solution
-  primalSolution_ = PrimalSolution();
+  primalSolutionPtr_ = std::make_shared<PrimalSolution>();
+  warmStartSolution_.clear();
   valueFunction_.clear();
   performanceIndeces_.clear();
 
@@ -164,7 +168,7 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
     throw std::runtime_error("[SqpSolver] Value function is empty! Is createValueFunction true and did the solver run?");
   } else {
     // Interpolation
-    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_);
+    const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolutionPtr_->timeTrajectory_);
 
     ScalarFunctionQuadraticApproximation valueFunction;
     using T = std::vector<ocs2::ScalarFunctionQuadraticApproximation>;
@@ -181,6 +185,7 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
 }
 
 void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_PROFILE_ZONE("SqpSolver::runImpl");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -192,23 +197,40 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
 
   // Initialize references
+  const TargetTrajectories* targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
+  if (settings_.sampleTargetTrajectories) {
+    sampleTargetTrajectories(*targetTrajectoriesPtr, toNodeTime(timeDiscretization), sampledTargetTrajectories_);
+    targetTrajectoriesPtr = &sampledTargetTrajectories_;
+  }
   for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.targetTrajectoriesPtr = targetTrajectoriesPtr;
   }
 
-  // Trajectory spread of primalSolution_
-  if (!primalSolution_.timeTrajectory_.empty()) {
-    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
+  // Trajectory spread of the last solution. It might be shared as a snapshot, therefore it is spread to a copy.
+  if (!primalSolutionPtr_->timeTrajectory_.empty()) {
+    std::ignore = trajectorySpread(primalSolutionPtr_->modeSchedule_, this->getReferenceManager().getModeSchedule(), *primalSolutionPtr_,
+                                   warmStartSolution_);
+  } else {
+    warmStartSolution_.clear();
   }
 
   // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, warmStartSolution_, *initializerPtr_, x, u);
+
+  // Fused node model
+  if (settings_.fuseCppAdTerms) {
+    if (fusedTranscriptions_.empty()) {
+      throw std::runtime_error("[SqpSolver] fuseCppAdTerms is set, call initializeFusedTranscription() before running the solver.");
+    }
+    for (auto& fusedTranscription : fusedTranscriptions_) {
+      fusedTranscription->getRemainderProblem().targetTrajectoriesPtr = targetTrajectoriesPtr;
+    }
+  }
 
   // Bookkeeping
   performanceIndeces_.clear();
-  std::vector<Metrics> metrics;
+  setMetricsLayout(timeDiscretization, x);
 
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
@@ -218,7 +240,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     }
     // Make QP approximation
     linearQuadraticApproximationTimer_.startTimer();
-    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics);
+    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u, metrics_);
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
@@ -230,7 +252,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
     // Apply step
     linesearchTimer_.startTimer();
-    const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u, metrics);
+    const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u, metrics_);
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
     linesearchTimer_.endTimer();
 
@@ -261,8 +283,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   ++numProblems_;
 
   computeControllerTimer_.startTimer();
-  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
-  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
+  auto primalSolutionPtr = primalSolutionPool_.acquire();
+  *primalSolutionPtr = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  primalSolutionPtr_ = std::move(primalSolutionPtr);
+  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, metrics_);
   computeControllerTimer_.endTimer();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -278,6 +302,7 @@ void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
 }
 
 SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
+  OCS2_PROFILE_ZONE("SqpSolver::getOCPSolution");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -309,6 +334,7 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
 }
 
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
+  OCS2_PROFILE_ZONE("SqpSolver::extractValueFunction");
   if (settings_.createValueFunction) {
     valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
@@ -318,6 +344,19 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
   }
 }
 
+void SqpSolver::initializeFusedTranscription(size_t stateDim, size_t inputDim) {
+  if (!settings_.fuseCppAdTerms) {
+    throw std::runtime_error("[SqpSolver] initializeFusedTranscription() requires the fuseCppAdTerms setting.");
+  }
+  fusedTranscriptions_.clear();
+  fusedTranscriptions_.emplace_back(new multiple_shooting::FusedTranscriptionCppAd(
+      stateDim, inputDim, ocpDefinitions_.front(), settings_.integratorType, "sqp_fused_transcription", settings_.fusedModelFolder,
+      settings_.recompileFusedModel, settings_.printSolverStatistics));
+  for (size_t i = 1; i < ocpDefinitions_.size(); ++i) {
+    fusedTranscriptions_.emplace_back(new multiple_shooting::FusedTranscriptionCppAd(*fusedTranscriptions_.front()));
+  }
+}
+
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
@@ -333,12 +372,32 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
   }
 }
 
+void SqpSolver::setMetricsLayout(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
+  const auto& ocpDefinition = ocpDefinitions_.front();
+  const int N = static_cast<int>(time.size()) - 1;
+
+  std::vector<MetricsSize> sizes(N + 1);
+  for (int i = 0; i < N; ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      sizes[i] = multiple_shooting::getEventMetricsSize(ocpDefinition, time[i].time, x[i + 1].size());
+    } else {
+      sizes[i] = multiple_shooting::getIntermediateMetricsSize(ocpDefinition, getIntervalStart(time[i]), x[i + 1].size());
+    }
+  }
+  sizes[N] = multiple_shooting::getTerminalMetricsSize(ocpDefinition, getIntervalStart(time[N]));
+
+  metrics_.setLayout(sizes);
+  trialMetrics_.setLayout(sizes);
+}
+
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                     const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+                                                     const vector_array_t& x, const vector_array_t& u, FlatMetrics& metrics) {
+  OCS2_PROFILE_ZONE("SqpSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  std::vector<CacheLinePadded<PerformanceIndex>> performance(settings_.nThreads);
   cost_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
@@ -346,10 +405,10 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
-  metrics.resize(N + 1);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
+    OCS2_PROFILE_ZONE("SqpSolver::setupQuadraticSubproblem(worker)");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
@@ -359,7 +418,7 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        multiple_shooting::computeMetrics(result, metrics, i);
         workerPerformance += multiple_shooting::computePerformanceIndex(result);
         cost_[i] = std::move(result.cost);
         dynamics_[i] = std::move(result.dynamics);
@@ -372,10 +431,15 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        auto result = fusedTranscriptions_.empty()
+                          ? multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i])
+                          : fusedTranscriptions_[workerId]->setupIntermediateNode(ti, dt, x[i], x[i + 1], u[i]);
+        multiple_shooting::computeMetrics(result, metrics, i);
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
+        if (settings_.projectStateInputEqualityConstraints && settings_.structuredProjection) {
+          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier, structuredProjections_[workerId],
+                                                  modeSchedule.modeAtTime(ti));
+        } else if (settings_.projectStateInputEqualityConstraints) {
           multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
         }
         cost_[i] = std::move(result.cost);
@@ -393,7 +457,7 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
+      multiple_shooting::computeMetrics(result, metrics, i);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
@@ -401,31 +465,34 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     }
 
     // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
+    performance[workerId].value += workerPerformance;
   };
   runParallel(std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  metrics.values(FlatMetrics::Field::DynamicsViolation, 0) += initDynamicsViolation;
+  performance.front().value.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
 
   // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  PerformanceIndex totalPerformance = performance.front().value;
+  std::for_each(std::next(performance.begin()), performance.end(),
+                [&](const CacheLinePadded<PerformanceIndex>& p) { totalPerformance += p.value; });
   totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
 
   return totalPerformance;
 }
 
 PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+                                               const vector_array_t& u, FlatMetrics& metrics) {
+  OCS2_PROFILE_ZONE("SqpSolver::computePerformance");
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  std::vector<CacheLinePadded<PerformanceIndex>> performance(settings_.nThreads);
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
+    OCS2_PROFILE_ZONE("SqpSolver::computePerformance(worker)");
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
@@ -433,14 +500,14 @@ PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>&
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
+        multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1], metrics, i);
+        performance[workerId].value += toPerformanceIndex(metrics, i);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i], metrics, i);
+        performance[workerId].value += toPerformanceIndex(metrics, i, dt);
       }
 
       i = timeIndex++;
@@ -448,26 +515,29 @@ PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>&
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N], metrics, N);
+      performance[workerId].value += toPerformanceIndex(metrics, N);
     }
   };
   runParallel(std::move(parallelTask));
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  metrics.values(FlatMetrics::Field::DynamicsViolation, 0) += initDynamicsViolation;
+  performance.front().value.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
 
   // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  PerformanceIndex totalPerformance = performance.front().value;
+  std::for_each(std::next(performance.begin()), performance.end(),
+                [&](const CacheLinePadded<PerformanceIndex>& p) { totalPerformance += p.value; });
   totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
   return totalPerformance;
 }
 
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
-                                  vector_array_t& u, std::vector<Metrics>& metrics) {
+                                  vector_array_t& u, FlatMetrics& metrics) {
+  OCS2_PROFILE_ZONE("SqpSolver::takeStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -493,14 +563,13 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   scalar_t alpha = 1.0;
   vector_array_t xNew(x.size());
   vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
   do {
     // Compute step
     multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
     multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
+    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, trialMetrics_);
 
     // Step acceptance and record step type
     bool stepAccepted;
@@ -518,7 +587,7 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
     if (stepAccepted) {  // Return if step accepted
       x = std::move(xNew);
       u = std::move(uNew);
-      metrics = std::move(metricsNew);
+      metrics.swap(trialMetrics_);
 
       // Prepare step info
       sqp::StepInfo stepInfo;
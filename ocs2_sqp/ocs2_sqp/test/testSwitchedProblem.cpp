@@ -267,3 +267,53 @@ TEST(test_switched_problem, event_at_end) {
     t_check += dt_check;
   }
 }
+
+TEST(test_switched_problem, sampled_target_trajectories) {
+  constexpr int n = 3;
+  constexpr int m = 2;
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::scalar_t eventTime = 0.1875;
+  const double tol = 1e-9;
+
+  ocs2::OptimalControlProblem problem;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  problem.dynamicsPtr.reset(new ocs2::LinearSystemDynamics(dynamics.dfdx, dynamics.dfdu, ocs2::matrix_t::Random(n, n)));
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(ocs2::getRandomCost(n, m)));
+  problem.preJumpCostPtr->add("eventCost", ocs2::getOcs2StateCost(ocs2::getRandomCost(n, 0)));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(ocs2::getRandomCost(n, 0)));
+
+  // A long, time-varying target
+  constexpr size_t numTargetPoints = 1000;
+  ocs2::TargetTrajectories targetTrajectories(numTargetPoints);
+  for (size_t i = 0; i < numTargetPoints; i++) {
+    targetTrajectories.timeTrajectory[i] = startTime + (finalTime - startTime) * i / (numTargetPoints - 1);
+    targetTrajectories.stateTrajectory[i] = ocs2::vector_t::Random(n);
+    targetTrajectories.inputTrajectory[i] = ocs2::vector_t::Random(m);
+  }
+  const ocs2::ModeSchedule modeSchedule({eventTime}, {0, 1});
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  auto solve = [&](bool sampleTargetTrajectories) {
+    auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories, modeSchedule);
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.05;
+    settings.sqpIteration = 20;
+    settings.sampleTargetTrajectories = sampleTargetTrajectories;
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    solver.setReferenceManager(referenceManagerPtr);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+  const auto solution = solve(false);
+  const auto sampledSolution = solve(true);
+
+  // The costs are only evaluated at the node times, where the sampled target is exact.
+  ASSERT_NEAR(solution.second.back().merit, sampledSolution.second.back().merit, tol);
+  ASSERT_EQ(solution.first.timeTrajectory_.size(), sampledSolution.first.timeTrajectory_.size());
+  for (int i = 0; i < solution.first.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(solution.first.stateTrajectory_[i].isApprox(sampledSolution.first.stateTrajectory_[i], tol));
+    ASSERT_TRUE(solution.first.inputTrajectory_[i].isApprox(sampledSolution.first.inputTrajectory_[i], tol));
+  }
+}
@@ -160,3 +160,51 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, solutionSnapshot) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(ocs2::getRandomDynamics(n, m));
+  const auto costs = ocs2::getRandomCost(n, m);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = false;
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // The snapshot is the solution itself
+  solver.run(0.0, ocs2::vector_t::Ones(n), 1.0);
+  auto firstSnapshot = solver.getPrimalSolutionSnapshot(1.0);
+  const auto firstSolution = solver.primalSolution(1.0);
+
+  // A snapshot is not modified by the next runs
+  solver.run(0.1, ocs2::vector_t::Zero(n), 1.1);
+  const auto secondSnapshot = solver.getPrimalSolutionSnapshot(1.1);
+  ASSERT_NE(firstSnapshot.get(), secondSnapshot.get());
+  ASSERT_EQ(firstSnapshot->timeTrajectory_, firstSolution.timeTrajectory_);
+  for (int i = 0; i < firstSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(firstSnapshot->stateTrajectory_[i].isApprox(firstSolution.stateTrajectory_[i], tol));
+    ASSERT_TRUE(firstSnapshot->inputTrajectory_[i].isApprox(firstSolution.inputTrajectory_[i], tol));
+  }
+
+  // A released snapshot is recycled
+  const auto* firstSnapshotAddress = firstSnapshot.get();
+  firstSnapshot.reset();
+  solver.run(0.2, ocs2::vector_t::Ones(n), 1.2);
+  ASSERT_EQ(solver.getPrimalSolutionSnapshot(1.2).get(), firstSnapshotAddress);
+  ASSERT_DOUBLE_EQ(solver.getPrimalSolutionSnapshot(1.2)->timeTrajectory_.front(), 0.2);
+}